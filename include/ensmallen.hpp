@@ -21,8 +21,24 @@
   #define ARMA_USE_CXX11
 #endif
 
+// Optional allocation tracking has to install its Armadillo memory hooks
+// before Armadillo itself is included; see config.hpp for the switch.
+#include "ensmallen_bits/allocation_tracking.hpp"
+
+// Optional pluggable memory resources likewise install Armadillo memory
+// hooks; this include must stay after allocation_tracking.hpp so that the
+// routing hooks win when both switches are on.
+#include "ensmallen_bits/memory_resource.hpp"
+
 #include <armadillo>
 
+// Optional GPU matrix support: define ENS_USE_COOT before including
+// ensmallen.hpp (with Bandicoot installed) to allow coot::mat iterates in
+// the SGD family, with all optimizer state kept device-side.
+#ifdef ENS_USE_COOT
+  #include <bandicoot>
+#endif
+
 #if !defined(ARMA_USE_CXX11)
   // armadillo automatically enables ARMA_USE_CXX11
   // when a C++11/C++14/C++17/etc compiler is detected
@@ -63,25 +79,46 @@
 #include "ensmallen_bits/ens_version.hpp"
 #include "ensmallen_bits/log.hpp" // TODO: should move to another place
 
+#include "ensmallen_bits/utility/parallel_runtime.hpp"
 #include "ensmallen_bits/utility/any.hpp"
+#include "ensmallen_bits/utility/coarse_clock.hpp"
+#include "ensmallen_bits/utility/cancellation_token.hpp"
+#include "ensmallen_bits/utility/philox_generator.hpp"
+#include "ensmallen_bits/utility/packed_population.hpp"
+#include "ensmallen_bits/utility/halton_sequence.hpp"
+#include "ensmallen_bits/utility/kahan_sum.hpp"
+#include "ensmallen_bits/utility/workspace.hpp"
+#include "ensmallen_bits/utility/mmap_matrix.hpp"
+#include "ensmallen_bits/utility/fp16.hpp"
 #include "ensmallen_bits/utility/arma_traits.hpp"
+#include "ensmallen_bits/utility/population_evaluator.hpp"
+#include "ensmallen_bits/utility/progressive_subset.hpp"
+#include "ensmallen_bits/utility/stagnation_detector.hpp"
 #include "ensmallen_bits/utility/indicators/epsilon.hpp"
 #include "ensmallen_bits/utility/indicators/igd_plus.hpp"
+#include "ensmallen_bits/utility/indicators/hypervolume.hpp"
 
 // Contains traits, must be placed before report callback.
 #include "ensmallen_bits/function.hpp" // TODO: should move to function/
 
 // Callbacks.
+#include "ensmallen_bits/callbacks/async_logger.hpp"
 #include "ensmallen_bits/callbacks/callbacks.hpp"
+#include "ensmallen_bits/callbacks/cancellation_stop.hpp"
+#include "ensmallen_bits/callbacks/checkpoint.hpp"
+#include "ensmallen_bits/callbacks/deadline_stop.hpp"
 #include "ensmallen_bits/callbacks/early_stop_at_min_loss.hpp"
 #include "ensmallen_bits/callbacks/grad_clip_by_norm.hpp"
 #include "ensmallen_bits/callbacks/grad_clip_by_value.hpp"
 #include "ensmallen_bits/callbacks/print_loss.hpp"
+#include "ensmallen_bits/callbacks/profiler.hpp"
 #include "ensmallen_bits/callbacks/progress_bar.hpp"
 #include "ensmallen_bits/callbacks/query_front.hpp"
 #include "ensmallen_bits/callbacks/report.hpp"
+#include "ensmallen_bits/callbacks/smoothed_early_stop.hpp"
 #include "ensmallen_bits/callbacks/store_best_coordinates.hpp"
 #include "ensmallen_bits/callbacks/timer_stop.hpp"
+#include "ensmallen_bits/callbacks/trajectory_recorder.hpp"
 
 #include "ensmallen_bits/problems/problems.hpp" // TODO: should move to another place
 
@@ -95,38 +132,58 @@
 #include "ensmallen_bits/demon_sgd/demon_sgd.hpp"
 #include "ensmallen_bits/qhadam/qhadam.hpp"
 #include "ensmallen_bits/aug_lagrangian/aug_lagrangian.hpp"
+#include "ensmallen_bits/bayesopt/bayesopt.hpp"
 #include "ensmallen_bits/bigbatch_sgd/bigbatch_sgd.hpp"
 #include "ensmallen_bits/cmaes/cmaes.hpp"
 #include "ensmallen_bits/cmaes/active_cmaes.hpp"
+#include "ensmallen_bits/cmaes/cholesky_cmaes.hpp"
+#include "ensmallen_bits/cmaes/sep_cmaes.hpp"
+#include "ensmallen_bits/cmaes/ipop_cmaes.hpp"
 #include "ensmallen_bits/cd/cd.hpp"
 #include "ensmallen_bits/cne/cne.hpp"
 #include "ensmallen_bits/de/de.hpp"
+#include "ensmallen_bits/de/shade.hpp"
+#include "ensmallen_bits/distributed_sgd/distributed_sgd.hpp"
 #include "ensmallen_bits/eve/eve.hpp"
 #include "ensmallen_bits/ftml/ftml.hpp"
 
 #include "ensmallen_bits/fw/frank_wolfe.hpp"
+#include "ensmallen_bits/fw/stochastic_frank_wolfe.hpp"
 #include "ensmallen_bits/gradient_descent/gradient_descent.hpp"
+#include "ensmallen_bits/gradient_descent/agd.hpp"
 #include "ensmallen_bits/grid_search/grid_search.hpp"
+#include "ensmallen_bits/hybrid/hybrid_optimizer.hpp"
+#include "ensmallen_bits/hyperband/hyperband.hpp"
 #include "ensmallen_bits/iqn/iqn.hpp"
 #include "ensmallen_bits/katyusha/katyusha.hpp"
 #include "ensmallen_bits/lbfgs/lbfgs.hpp"
+#include "ensmallen_bits/lbfgs/lbfgs_b.hpp"
+#include "ensmallen_bits/line_search/wolfe_line_search.hpp"
+#include "ensmallen_bits/newton_cg/newton_cg.hpp"
+#include "ensmallen_bits/nonlinear_cg/nonlinear_cg.hpp"
 #include "ensmallen_bits/lookahead/lookahead.hpp"
 #include "ensmallen_bits/moead/moead.hpp"
+#include "ensmallen_bits/multi_start/multi_start.hpp"
 #include "ensmallen_bits/nsga2/nsga2.hpp"
+#include "ensmallen_bits/nsga2/steady_state_nsga2.hpp"
 #include "ensmallen_bits/padam/padam.hpp"
 #include "ensmallen_bits/parallel_sgd/parallel_sgd.hpp"
+#include "ensmallen_bits/parallel_sgd/local_sgd.hpp"
 #include "ensmallen_bits/pso/pso.hpp"
 #include "ensmallen_bits/rmsprop/rmsprop.hpp"
 
 #include "ensmallen_bits/sa/sa.hpp"
 #include "ensmallen_bits/sarah/sarah.hpp"
 #include "ensmallen_bits/sdp/sdp.hpp"
+#include "ensmallen_bits/sdp/sdp_structure.hpp"
 #include "ensmallen_bits/sdp/lrsdp.hpp"
 #include "ensmallen_bits/sdp/primal_dual.hpp"
 
 #include "ensmallen_bits/sgd/sgd.hpp"
 // TODO: this should probably be included in sgd.hpp
+#include "ensmallen_bits/sgd/update_policies/elementwise_update.hpp"
 #include "ensmallen_bits/sgd/update_policies/gradient_clipping.hpp"
+#include "ensmallen_bits/sgd/update_policies/gradient_norm_clipping.hpp"
 #include "ensmallen_bits/sgdr/sgdr.hpp"
 #include "ensmallen_bits/sgdr/snapshot_ensembles.hpp"
 #include "ensmallen_bits/sgdr/snapshot_sgdr.hpp"
@@ -138,4 +195,8 @@
 #include "ensmallen_bits/wn_grad/wn_grad.hpp"
 #include "ensmallen_bits/yogi/yogi.hpp"
 
+// Optional extern-template declarations for the common optimizer
+// configurations; a no-op unless ENS_USE_EXTERN_TEMPLATES is defined.
+#include "ensmallen_bits/extern_templates.hpp"
+
 #endif
@@ -141,6 +141,12 @@ class AdaBelief
   //! Get the second moment coefficient.
   double& Beta2() { return optimizer.UpdatePolicy().Beta2(); }
 
+  //! Get whether the moment estimates are stored in single precision.
+  bool MixedPrecision() const
+  { return optimizer.UpdatePolicy().MixedPrecision(); }
+  //! Modify whether the moment estimates are stored in single precision.
+  bool& MixedPrecision() { return optimizer.UpdatePolicy().MixedPrecision(); }
+
   //! Get the value for numerical stability.
   double Epsilon() const { return optimizer.UpdatePolicy().Epsilon(); }
   //! Modify the value used for numerical stability.
@@ -43,13 +43,20 @@ class AdaBeliefUpdate
    * @param epsilon A small constant for numerical stability.
    * @param beta1 The exponential decay rate for the 1st moment estimates.
    * @param beta2 The exponential decay rate for the 2nd moment estimates.
+   * @param mixedPrecision If true, store the moment estimates in single
+   *        precision while accumulating the moment recursions and the
+   *        parameter step in double; this halves the optimizer state memory
+   *        for double-precision models.  Only available for dense gradients;
+   *        sparse gradients keep full-precision moments.
    */
   AdaBeliefUpdate(const double epsilon = 1e-8,
                   const double beta1 = 0.9,
-                  const double beta2 = 0.999) :
+                  const double beta2 = 0.999,
+                  const bool mixedPrecision = false) :
     epsilon(epsilon),
     beta1(beta1),
-    beta2(beta2)
+    beta2(beta2),
+    mixedPrecision(mixedPrecision)
   {
     // Nothing to do.
   }
@@ -69,6 +76,11 @@ class AdaBeliefUpdate
   //! Modify the exponential decay rate for the 2nd moment estimates.
   double& Beta2() { return beta2; }
 
+  //! Get whether the moment estimates are stored in single precision.
+  bool MixedPrecision() const { return mixedPrecision; }
+  //! Modify whether the moment estimates are stored in single precision.
+  bool& MixedPrecision() { return mixedPrecision; }
+
   /**
    * The UpdatePolicyType policy classes must contain an internal 'Policy'
    * template class with two template arguments: MatType and GradType.  This is
@@ -91,8 +103,18 @@ class AdaBeliefUpdate
         parent(parent),
         iteration(0)
     {
-      m.zeros(rows, cols);
-      s.zeros(rows, cols);
+      // In the mixed-precision mode the moments live in the single-precision
+      // buffers instead; sparse gradients keep full-precision moments.
+      if (parent.mixedPrecision && !arma::is_arma_sparse_type<GradType>::value)
+      {
+        mF.zeros(rows, cols);
+        sF.zeros(rows, cols);
+      }
+      else
+      {
+        m.zeros(rows, cols);
+        s.zeros(rows, cols);
+      }
     }
 
     /**
@@ -109,21 +131,86 @@ class AdaBeliefUpdate
       // Increment the iteration counter variable.
       ++iteration;
 
+      const double biasCorrection1 = 1.0 - std::pow(parent.beta1, iteration);
+      const double biasCorrection2 = 1.0 - std::pow(parent.beta2, iteration);
+
+      if (parent.mixedPrecision &&
+          !arma::is_arma_sparse_type<GradType>::value)
+      {
+        MixedUpdate(iterate, stepSize, gradient, biasCorrection1,
+            biasCorrection2);
+        return;
+      }
+
       m *= parent.beta1;
       m += (1 - parent.beta1) * gradient;
 
       s *= parent.beta2;
       s += (1 - parent.beta2) * arma::pow(gradient - m, 2.0) + parent.epsilon;
 
-      const double biasCorrection1 = 1.0 - std::pow(parent.beta1, iteration);
-      const double biasCorrection2 = 1.0 - std::pow(parent.beta2, iteration);
-
       // And update the iterate.
       iterate -= ((m / biasCorrection1) * stepSize) / (arma::sqrt(s /
           biasCorrection2) + parent.epsilon);
     }
 
    private:
+    /**
+     * Mixed-precision update kernel for dense gradients: the moment
+     * estimates are read from and written back to the single-precision
+     * buffers, while the moment recursions and the parameter step are
+     * accumulated in double.
+     */
+    template<typename InGradType>
+    typename std::enable_if<arma::is_arma_type<InGradType>::value, void>::type
+    MixedUpdate(MatType& iterate,
+                const double stepSize,
+                const InGradType& gradient,
+                const double biasCorrection1,
+                const double biasCorrection2)
+    {
+      typedef typename MatType::elem_type ElemType;
+
+      const ElemType* g = gradient.memptr();
+      float* mMem = mF.memptr();
+      float* sMem = sF.memptr();
+      ElemType* itMem = iterate.memptr();
+
+      const size_t n = iterate.n_elem;
+      for (size_t j = 0; j < n; ++j)
+      {
+        const double gj = (double) g[j];
+        const double mj = parent.beta1 * mMem[j] +
+            (1 - parent.beta1) * gj;
+        const double diff = gj - mj;
+        const double sj = parent.beta2 * sMem[j] +
+            (1 - parent.beta2) * diff * diff + parent.epsilon;
+        mMem[j] = (float) mj;
+        sMem[j] = (float) sj;
+        itMem[j] -= (ElemType) (((mj / biasCorrection1) * stepSize) /
+            (std::sqrt(sj / biasCorrection2) + parent.epsilon));
+      }
+    }
+
+    //! Sparse gradients never reach the mixed-precision path at runtime;
+    //! this overload only exists so the dispatch above compiles.
+    template<typename InGradType>
+    typename std::enable_if<!arma::is_arma_type<InGradType>::value, void>::type
+    MixedUpdate(MatType& iterate,
+                const double stepSize,
+                const InGradType& gradient,
+                const double biasCorrection1,
+                const double biasCorrection2)
+    {
+      m *= parent.beta1;
+      m += (1 - parent.beta1) * gradient;
+
+      s *= parent.beta2;
+      s += (1 - parent.beta2) * arma::pow(gradient - m, 2.0) + parent.epsilon;
+
+      iterate -= ((m / biasCorrection1) * stepSize) / (arma::sqrt(s /
+          biasCorrection2) + parent.epsilon);
+    }
+
     //! Instantiated parent object.
     AdaBeliefUpdate& parent;
 
@@ -133,6 +220,12 @@ class AdaBeliefUpdate
     // The exponential moving average of squared gradient values.
     GradType s;
 
+    // Single-precision storage of m, used in the mixed-precision mode.
+    arma::Mat<float> mF;
+
+    // Single-precision storage of s, used in the mixed-precision mode.
+    arma::Mat<float> sF;
+
     // The number of iterations.
     size_t iteration;
   };
@@ -146,6 +239,9 @@ class AdaBeliefUpdate
 
   // The exponential decay rate for the 2nd moment estimates.
   double beta2;
+
+  // Whether the moment estimates are stored in single precision.
+  bool mixedPrecision;
 };
 
 } // namespace ens
@@ -13,6 +13,8 @@
 #ifndef ENSMALLEN_ADA_BOUND_UPDATE_HPP
 #define ENSMALLEN_ADA_BOUND_UPDATE_HPP
 
+#include <ensmallen_bits/sgd/update_policies/elementwise_update.hpp>
+
 namespace ens {
 
 /**
@@ -93,7 +95,7 @@ class AdaBoundUpdate
    * specific to an individual optimization.
    */
   template<typename MatType, typename GradType>
-  class Policy
+  class Policy : public ElementwiseUpdate<Policy<MatType, GradType>>
   {
    public:
     /**
@@ -105,7 +107,8 @@ class AdaBoundUpdate
      * @param cols Number of columns in the gradient matrix.
      */
     Policy(AdaBoundUpdate& parent, const size_t rows, const size_t cols) :
-        parent(parent), first(true), initialStepSize(0), iteration(0)
+        parent(parent), first(true), initialStepSize(0), iteration(0),
+        lower(0), upper(0)
     {
       m.zeros(rows, cols);
       v.zeros(rows, cols);
@@ -122,9 +125,6 @@ class AdaBoundUpdate
                 const double stepSize,
                 const GradType& gradient)
     {
-      // Convenience typedefs.
-      typedef typename MatType::elem_type ElemType;
-
       // Save the initial step size.
       if (first)
       {
@@ -135,24 +135,35 @@ class AdaBoundUpdate
       // Increment the iteration counter variable.
       ++iteration;
 
-      // Decay the first and second moment running average coefficient.
-      m *= parent.beta1;
-      m += (1 - parent.beta1) * gradient;
+      const double biasCorrection1 = 1.0 - std::pow(parent.beta1, iteration);
+      const double biasCorrection2 = 1.0 - std::pow(parent.beta2, iteration);
 
-      v *= parent.beta2;
-      v += (1 - parent.beta2) * (gradient % gradient);
+      const double fl = parent.finalLr * stepSize / initialStepSize;
+      lower = fl * (1.0 - 1.0 / (parent.gamma * iteration + 1));
+      upper = fl * (1.0 + 1.0 / (parent.gamma * iteration));
 
-      const ElemType biasCorrection1 = 1.0 - std::pow(parent.beta1, iteration);
-      const ElemType biasCorrection2 = 1.0 - std::pow(parent.beta2, iteration);
+      this->Elementwise(iterate,
+          stepSize * std::sqrt(biasCorrection2) / biasCorrection1, gradient,
+          m, v);
+    }
 
-      const ElemType fl = parent.finalLr * stepSize / initialStepSize;
-      const ElemType lower = fl * (1.0 - 1.0 / (parent.gamma * iteration + 1));
-      const ElemType upper = fl * (1.0 + 1.0 / (parent.gamma * iteration));
+    //! The per-element AdaBound rule; called by ElementwiseUpdate.  The bias
+    //! corrections are folded into the forwarded step scalar.
+    template<typename StateElemType>
+    double Apply(const double scaledStepSize,
+                 const double x,
+                 const double g,
+                 StateElemType& m,
+                 StateElemType& v)
+    {
+      // Decay the first and second moment running average coefficient.
+      m = (StateElemType) (parent.beta1 * m + (1 - parent.beta1) * g);
+      v = (StateElemType) (parent.beta2 * v + (1 - parent.beta2) * g * g);
 
-       // Applies bounds on actual learning rate.
-      iterate -= arma::clamp((stepSize *
-          std::sqrt(biasCorrection2) / biasCorrection1) / (arma::sqrt(v) +
-          parent.epsilon), lower, upper) % m;
+      // Applies bounds on actual learning rate.
+      const double rate = std::min(std::max(scaledStepSize /
+          (std::sqrt((double) v) + parent.epsilon), lower), upper);
+      return x - rate * m;
     }
 
    private:
@@ -173,6 +184,12 @@ class AdaBoundUpdate
 
     // The number of iterations.
     size_t iteration;
+
+    // The current lower learning rate bound; set by Update().
+    double lower;
+
+    // The current upper learning rate bound; set by Update().
+    double upper;
   };
 
  private:
@@ -13,6 +13,8 @@
 #ifndef ENSMALLEN_ADA_DELTA_ADA_DELTA_UPDATE_HPP
 #define ENSMALLEN_ADA_DELTA_ADA_DELTA_UPDATE_HPP
 
+#include <ensmallen_bits/sgd/update_policies/elementwise_update.hpp>
+
 namespace ens {
 
 /**
@@ -68,7 +70,7 @@ class AdaDeltaUpdate
    * specific to an individual optimization.
    */
   template<typename MatType, typename GradType>
-  class Policy
+  class Policy : public ElementwiseUpdate<Policy<MatType, GradType>>
   {
    public:
     /**
@@ -100,19 +102,30 @@ class AdaDeltaUpdate
     void Update(MatType& iterate,
                 const double stepSize,
                 const GradType& gradient)
+    {
+      this->Elementwise(iterate, stepSize, gradient, meanSquaredGradient,
+          meanSquaredGradientDx);
+    }
+
+    //! The per-element AdaDelta rule; called by ElementwiseUpdate.
+    template<typename StateElemType>
+    double Apply(const double stepSize,
+                 const double x,
+                 const double g,
+                 StateElemType& msg,
+                 StateElemType& msgDx)
     {
       // Accumulate gradient.
-      meanSquaredGradient *= parent.rho;
-      meanSquaredGradient += (1 - parent.rho) * (gradient % gradient);
-      GradType dx = arma::sqrt((meanSquaredGradientDx + parent.epsilon) /
-          (meanSquaredGradient + parent.epsilon)) % gradient;
+      msg = (StateElemType) (parent.rho * msg + (1 - parent.rho) * g * g);
+      const double dx = std::sqrt((msgDx + parent.epsilon) /
+          (msg + parent.epsilon)) * g;
 
       // Accumulate updates.
-      meanSquaredGradientDx *= parent.rho;
-      meanSquaredGradientDx += (1 - parent.rho) * (dx % dx);
+      msgDx = (StateElemType) (parent.rho * msgDx +
+          (1 - parent.rho) * dx * dx);
 
       // Apply update.
-      iterate -= (stepSize * dx);
+      return x - stepSize * dx;
     }
 
    private:
@@ -12,6 +12,8 @@
 #ifndef ENSMALLEN_ADA_GRAD_ADA_GRAD_UPDATE_HPP
 #define ENSMALLEN_ADA_GRAD_ADA_GRAD_UPDATE_HPP
 
+#include <ensmallen_bits/sgd/update_policies/elementwise_update.hpp>
+
 namespace ens {
 
 /**
@@ -61,7 +63,7 @@ class AdaGradUpdate
    * specific to an individual optimization.
    */
   template<typename MatType, typename GradType>
-  class Policy
+  class Policy : public ElementwiseUpdate<Policy<MatType, GradType>>
   {
    public:
     /**
@@ -95,9 +97,18 @@ class AdaGradUpdate
                 const double stepSize,
                 const GradType& gradient)
     {
-      squaredGradient += (gradient % gradient);
-      iterate -= (stepSize * gradient) / (arma::sqrt(squaredGradient) +
-          parent.epsilon);
+      this->Elementwise(iterate, stepSize, gradient, squaredGradient);
+    }
+
+    //! The per-element AdaGrad rule; called by ElementwiseUpdate.
+    template<typename StateElemType>
+    double Apply(const double stepSize,
+                 const double x,
+                 const double g,
+                 StateElemType& sq)
+    {
+      sq += (StateElemType) (g * g);
+      return x - stepSize * g / (std::sqrt((double) sq) + parent.epsilon);
     }
 
    private:
@@ -12,6 +12,8 @@
 #ifndef ENSMALLEN_ADA_SQRT_ADA_SQRT_UPDATE_HPP
 #define ENSMALLEN_ADA_SQRT_ADA_SQRT_UPDATE_HPP
 
+#include <ensmallen_bits/sgd/update_policies/elementwise_update.hpp>
+
 namespace ens {
 
 /**
@@ -56,7 +58,7 @@ class AdaSqrtUpdate
    * specific to an individual optimization.
    */
   template<typename MatType, typename GradType>
-  class Policy
+  class Policy : public ElementwiseUpdate<Policy<MatType, GradType>>
   {
    public:
     /**
@@ -93,10 +95,20 @@ class AdaSqrtUpdate
     {
       ++iteration;
 
-      squaredGradient += arma::square(gradient);
+      this->Elementwise(iterate, stepSize * std::sqrt(iteration), gradient,
+          squaredGradient);
+    }
 
-      iterate -= stepSize * std::sqrt(iteration) * gradient /
-          (squaredGradient + parent.epsilon);
+    //! The per-element AdaSqrt rule; called by ElementwiseUpdate.  The
+    //! sqrt(iteration) factor is folded into the forwarded step scalar.
+    template<typename StateElemType>
+    double Apply(const double scaledStepSize,
+                 const double x,
+                 const double g,
+                 StateElemType& sq)
+    {
+      sq += (StateElemType) (g * g);
+      return x - scaledStepSize * g / (sq + parent.epsilon);
     }
 
    private:
@@ -120,7 +120,8 @@ class AdamType
            typename MatType,
            typename GradType,
            typename... CallbackTypes>
-  typename std::enable_if<IsArmaType<GradType>::value,
+  typename std::enable_if<
+      IsArmaType<GradType>::value || IsCootType<GradType>::value,
       typename MatType::elem_type>::type
   Optimize(SeparableFunctionType& function,
            MatType& iterate,
@@ -169,6 +170,36 @@ class AdamType
   //! Modify the value used to initialise the mean squared gradient parameter.
   double& Epsilon() { return optimizer.UpdatePolicy().Epsilon(); }
 
+  //! Get whether the fused single-pass update kernel is used (only available
+  //! when the update rule supports it, e.g. AdamUpdate).
+  bool Fused() const { return optimizer.UpdatePolicy().Fused(); }
+  //! Modify whether the fused single-pass update kernel is used.
+  bool& Fused() { return optimizer.UpdatePolicy().Fused(); }
+
+  //! Get whether the moment estimates are stored in single precision (only
+  //! available when the update rule supports it, e.g. AdamUpdate).
+  bool MixedPrecision() const
+  { return optimizer.UpdatePolicy().MixedPrecision(); }
+  //! Modify whether the moment estimates are stored in single precision.
+  bool& MixedPrecision() { return optimizer.UpdatePolicy().MixedPrecision(); }
+
+  //! Get the decoupled weight decay coefficient (AdamW; 0 means no decay;
+  //! only available when the update rule supports it, e.g. AdamUpdate).
+  double WeightDecay() const { return optimizer.UpdatePolicy().WeightDecay(); }
+  //! Modify the decoupled weight decay coefficient.
+  double& WeightDecay() { return optimizer.UpdatePolicy().WeightDecay(); }
+
+  //! Get whether the moment estimates are stored in half precision.
+  bool HalfPrecision() const
+  { return optimizer.UpdatePolicy().HalfPrecision(); }
+  //! Modify whether the moment estimates are stored in half precision.
+  bool& HalfPrecision() { return optimizer.UpdatePolicy().HalfPrecision(); }
+
+  //! Get the loss scale used by the half-precision mode (1 means none).
+  double LossScale() const { return optimizer.UpdatePolicy().LossScale(); }
+  //! Modify the loss scale used by the half-precision mode.
+  double& LossScale() { return optimizer.UpdatePolicy().LossScale(); }
+
   //! Get the maximum number of iterations (0 indicates no limit).
   size_t MaxIterations() const { return optimizer.MaxIterations(); }
   //! Modify the maximum number of iterations (0 indicates no limit).
@@ -196,6 +227,22 @@ class AdamType
   //! are reset before Optimize call.
   bool& ResetPolicy() { return optimizer.ResetPolicy(); }
 
+  //! Write the instantiated update-policy state (the moment estimates and the
+  //! iteration counter) to the given stream; see SGD::SaveState().
+  template<typename MatType, typename GradType = MatType>
+  bool SaveState(std::ostream& stream)
+  {
+    return optimizer.template SaveState<MatType, GradType>(stream);
+  }
+
+  //! Restore the instantiated update-policy state from the given stream; see
+  //! SGD::LoadState().
+  template<typename MatType, typename GradType = MatType>
+  bool LoadState(std::istream& stream, const size_t rows, const size_t cols)
+  {
+    return optimizer.template LoadState<MatType, GradType>(stream, rows, cols);
+  }
+
  private:
   //! The Stochastic Gradient Descent object with Adam policy.
   SGD<UpdateRule> optimizer;
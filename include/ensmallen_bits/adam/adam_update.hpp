@@ -46,13 +46,53 @@ class AdamUpdate
    *        parameter.
    * @param beta1 The smoothing parameter.
    * @param beta2 The second moment coefficient.
+   * @param fused If true, use the single-pass fused update kernel that walks
+   *        the parameter memory once per step instead of once per moment
+   *        estimate; this helps when the update is memory-bandwidth bound.
+   *        Only available for dense CPU gradients; sparse gradients and GPU
+   *        matrices always use the expression-based update.
+   * @param mixedPrecision If true, store the moment estimates in single
+   *        precision while accumulating the moment recursions and the
+   *        parameter step in double; this halves the optimizer state memory
+   *        for double-precision models.  Only available for dense CPU
+   *        gradients; sparse gradients and GPU matrices keep full-precision
+   *        moments.
+   * @param halfPrecision If true, store the moment estimates as packed IEEE
+   *        binary16 bits, widened to full precision inside the update
+   *        kernel; this quarters (for double models) the optimizer state
+   *        memory and doubles the effective cache capacity of the update
+   *        relative to the single-precision mode.  Takes precedence over
+   *        mixedPrecision.  Only available for dense CPU gradients; sparse
+   *        gradients and GPU matrices keep full-precision moments.
+   * @param lossScale Scale factor applied to gradients before they enter
+   *        the half-precision moment buffers (the step divides it back
+   *        out), keeping small gradient contributions representable in
+   *        binary16.  Choose it so that lossScale * |g| and
+   *        lossScale * g^2 stay below 65504 for typical gradients; 1 means
+   *        no scaling.  Only used when halfPrecision is set.
+   * @param weightDecay Decoupled weight decay coefficient (AdamW); each step
+   *        additionally shrinks the parameters by stepSize * weightDecay,
+   *        applied directly to the iterate rather than through the gradient.
+   *        The decay is folded into the update kernels, so enabling it costs
+   *        no extra pass over the parameter memory.  With sparse gradients,
+   *        the decay is only applied to a coordinate when it is visited.
    */
   AdamUpdate(const double epsilon = 1e-8,
              const double beta1 = 0.9,
-             const double beta2 = 0.999) :
+             const double beta2 = 0.999,
+             const bool fused = false,
+             const bool mixedPrecision = false,
+             const double weightDecay = 0.0,
+             const bool halfPrecision = false,
+             const double lossScale = 1.0) :
     epsilon(epsilon),
     beta1(beta1),
-    beta2(beta2)
+    beta2(beta2),
+    fused(fused),
+    mixedPrecision(mixedPrecision),
+    weightDecay(weightDecay),
+    halfPrecision(halfPrecision),
+    lossScale(lossScale)
   {
     // Nothing to do.
   }
@@ -72,6 +112,31 @@ class AdamUpdate
   //! Modify the second moment coefficient.
   double& Beta2() { return beta2; }
 
+  //! Get whether the fused single-pass update kernel is used.
+  bool Fused() const { return fused; }
+  //! Modify whether the fused single-pass update kernel is used.
+  bool& Fused() { return fused; }
+
+  //! Get whether the moment estimates are stored in single precision.
+  bool MixedPrecision() const { return mixedPrecision; }
+  //! Modify whether the moment estimates are stored in single precision.
+  bool& MixedPrecision() { return mixedPrecision; }
+
+  //! Get the decoupled weight decay coefficient (0 means no decay).
+  double WeightDecay() const { return weightDecay; }
+  //! Modify the decoupled weight decay coefficient.
+  double& WeightDecay() { return weightDecay; }
+
+  //! Get whether the moment estimates are stored in half precision.
+  bool HalfPrecision() const { return halfPrecision; }
+  //! Modify whether the moment estimates are stored in half precision.
+  bool& HalfPrecision() { return halfPrecision; }
+
+  //! Get the loss scale used by the half-precision mode (1 means none).
+  double LossScale() const { return lossScale; }
+  //! Modify the loss scale used by the half-precision mode.
+  double& LossScale() { return lossScale; }
+
   /**
    * The UpdatePolicyType policy classes must contain an internal 'Policy'
    * template class with two template arguments: MatType and GradType.  This is
@@ -94,8 +159,31 @@ class AdamUpdate
         parent(parent),
         iteration(0)
     {
-      m.zeros(rows, cols);
-      v.zeros(rows, cols);
+      // In the half- and mixed-precision modes the moments live in the
+      // packed binary16 or single-precision buffers instead; sparse
+      // gradients keep full-precision moments, since the lazy update path
+      // needs them, and GPU matrices keep full-precision device-side
+      // moments, since the reduced-precision kernels walk host memory.
+      if (parent.halfPrecision && arma::is_arma_type<GradType>::value)
+      {
+        mH.zeros(rows, cols);
+        vH.zeros(rows, cols);
+      }
+      else if (parent.mixedPrecision && arma::is_arma_type<GradType>::value)
+      {
+        mF.zeros(rows, cols);
+        vF.zeros(rows, cols);
+      }
+      else
+      {
+        m.zeros(rows, cols);
+        v.zeros(rows, cols);
+      }
+
+      // The per-coordinate visit bookkeeping is only needed for the lazy
+      // sparse update path, so don't pay for it with dense gradients.
+      if (arma::is_arma_sparse_type<GradType>::value)
+        lastVisit.zeros(rows, cols);
     }
 
     /**
@@ -112,6 +200,37 @@ class AdamUpdate
       // Increment the iteration counter variable.
       ++iteration;
 
+      const double biasCorrection1 = 1.0 - std::pow(parent.beta1, iteration);
+      const double biasCorrection2 = 1.0 - std::pow(parent.beta2, iteration);
+
+      if (arma::is_arma_sparse_type<GradType>::value)
+      {
+        LazyUpdate(iterate, stepSize, gradient, biasCorrection1,
+            biasCorrection2);
+        return;
+      }
+
+      if (parent.halfPrecision)
+      {
+        HalfUpdate(iterate, stepSize, gradient, biasCorrection1,
+            biasCorrection2);
+        return;
+      }
+
+      if (parent.mixedPrecision)
+      {
+        MixedUpdate(iterate, stepSize, gradient, biasCorrection1,
+            biasCorrection2);
+        return;
+      }
+
+      if (parent.fused)
+      {
+        FusedUpdate(iterate, stepSize, gradient, biasCorrection1,
+            biasCorrection2);
+        return;
+      }
+
       // And update the iterate.
       m *= parent.beta1;
       m += (1 - parent.beta1) * gradient;
@@ -119,19 +238,328 @@ class AdamUpdate
       v *= parent.beta2;
       v += (1 - parent.beta2) * (gradient % gradient);
 
-      const double biasCorrection1 = 1.0 - std::pow(parent.beta1, iteration);
-      const double biasCorrection2 = 1.0 - std::pow(parent.beta2, iteration);
+      // Decoupled weight decay (AdamW): shrink the parameters directly,
+      // before the Adam step, instead of adding a decay term to the gradient.
+      if (parent.weightDecay != 0)
+      {
+        iterate *= (typename MatType::elem_type)
+            (1.0 - stepSize * parent.weightDecay);
+      }
 
       /**
-       * It should be noted that the term, m / (arma::sqrt(v) + eps), in the
+       * It should be noted that the term, m / (sqrt(v) + eps), in the
        * following expression is an approximation of the following actual term;
-       * m / (arma::sqrt(v) + (arma::sqrt(biasCorrection2) * eps).
+       * m / (sqrt(v) + (sqrt(biasCorrection2) * eps).
+       *
+       * (sqrt() is left unqualified so argument-dependent lookup picks the
+       * right namespace for both Armadillo and Bandicoot matrices.)
        */
       iterate -= (stepSize * std::sqrt(biasCorrection2) / biasCorrection1) *
-          m / (arma::sqrt(v) + parent.epsilon);
+          m / (sqrt(v) + parent.epsilon);
+    }
+
+    /**
+     * Write the optimizer state (the moment estimates, the iteration counter
+     * and the sparse-update bookkeeping) to the given stream in binary
+     * format.
+     */
+    void Serialize(std::ostream& stream) const
+    {
+      const arma::uword it = (arma::uword) iteration;
+      stream.write(reinterpret_cast<const char*>(&it), sizeof(it));
+      m.save(stream, arma::arma_binary);
+      v.save(stream, arma::arma_binary);
+      mF.save(stream, arma::arma_binary);
+      vF.save(stream, arma::arma_binary);
+      mH.save(stream, arma::arma_binary);
+      vH.save(stream, arma::arma_binary);
+      lastVisit.save(stream, arma::arma_binary);
+    }
+
+    /**
+     * Restore the optimizer state from the given stream, as written by
+     * Serialize().
+     */
+    void Deserialize(std::istream& stream)
+    {
+      arma::uword it = 0;
+      stream.read(reinterpret_cast<char*>(&it), sizeof(it));
+      iteration = (size_t) it;
+      m.load(stream, arma::arma_binary);
+      v.load(stream, arma::arma_binary);
+      mF.load(stream, arma::arma_binary);
+      vF.load(stream, arma::arma_binary);
+      mH.load(stream, arma::arma_binary);
+      vH.load(stream, arma::arma_binary);
+      lastVisit.load(stream, arma::arma_binary);
     }
 
    private:
+    /**
+     * Lazy update for sparse gradients: only coordinates with nonzero
+     * gradient entries are touched.  The moment decay a coordinate missed
+     * while it was skipped is caught up on access (beta1^k and beta2^k for k
+     * skipped steps); the parameter movement the decayed first moment would
+     * have produced during those steps is dropped, as in LazyAdam.  Step cost
+     * is proportional to the number of nonzeros instead of the model size,
+     * and the moment estimates stay as sparse as the visited set.
+     */
+    template<typename InGradType>
+    typename std::enable_if<arma::is_arma_sparse_type<InGradType>::value,
+        void>::type
+    LazyUpdate(MatType& iterate,
+               const double stepSize,
+               const InGradType& gradient,
+               const double biasCorrection1,
+               const double biasCorrection2)
+    {
+      typedef typename MatType::elem_type ElemType;
+
+      const ElemType b1 = (ElemType) parent.beta1;
+      const ElemType b2 = (ElemType) parent.beta2;
+      const ElemType eps = (ElemType) parent.epsilon;
+      const ElemType scale = (ElemType) (stepSize *
+          std::sqrt(biasCorrection2) / biasCorrection1);
+
+      typename InGradType::const_iterator it = gradient.begin();
+      for (; it != gradient.end(); ++it)
+      {
+        const size_t r = it.row();
+        const size_t c = it.col();
+        const ElemType gj = (ElemType) (*it);
+
+        // Decoupled weight decay is only applied when a coordinate is
+        // visited; decay for skipped steps is dropped, like the deferred
+        // first-moment movement.
+        if (parent.weightDecay != 0)
+          iterate(r, c) *= (ElemType) (1.0 - stepSize * parent.weightDecay);
+
+        // Catch up the moment decay for the steps this coordinate was
+        // skipped.
+        const size_t skipped = iteration - lastVisit(r, c) - 1;
+        ElemType mj = (ElemType) m(r, c);
+        ElemType vj = (ElemType) v(r, c);
+        if (skipped > 0)
+        {
+          mj *= (ElemType) std::pow(b1, (double) skipped);
+          vj *= (ElemType) std::pow(b2, (double) skipped);
+        }
+
+        mj = b1 * mj + (1 - b1) * gj;
+        vj = b2 * vj + (1 - b2) * gj * gj;
+
+        m(r, c) = mj;
+        v(r, c) = vj;
+        iterate(r, c) -= scale * mj / (std::sqrt(vj) + eps);
+        lastVisit(r, c) = iteration;
+      }
+    }
+
+    //! Dense gradients never reach the lazy path; keep the expression-based
+    //! update so the dispatch above compiles for every gradient type.
+    template<typename InGradType>
+    typename std::enable_if<!arma::is_arma_sparse_type<InGradType>::value,
+        void>::type
+    LazyUpdate(MatType& iterate,
+               const double stepSize,
+               const InGradType& gradient,
+               const double biasCorrection1,
+               const double biasCorrection2)
+    {
+      FusedUpdate(iterate, stepSize, gradient, biasCorrection1,
+          biasCorrection2);
+    }
+
+    /**
+     * Single-pass update kernel for dense gradients: one traversal of the
+     * parameter memory updates m, v, and the iterate together, instead of the
+     * three traversals taken by the separate Armadillo expressions above.
+     * The loop body is branch-free and contiguous, so compilers vectorize it
+     * with SIMD instructions at -O2/-O3.
+     */
+    template<typename InGradType>
+    typename std::enable_if<arma::is_arma_type<InGradType>::value, void>::type
+    FusedUpdate(MatType& iterate,
+                const double stepSize,
+                const InGradType& gradient,
+                const double biasCorrection1,
+                const double biasCorrection2)
+    {
+      typedef typename MatType::elem_type ElemType;
+
+      const ElemType b1 = (ElemType) parent.beta1;
+      const ElemType b2 = (ElemType) parent.beta2;
+      const ElemType eps = (ElemType) parent.epsilon;
+      const ElemType scale = (ElemType) (stepSize *
+          std::sqrt(biasCorrection2) / biasCorrection1);
+
+      // Decoupled weight decay (AdamW) folds into the same traversal; a
+      // decay factor of 1 leaves the update unchanged.
+      const ElemType decay = (ElemType)
+          (1.0 - stepSize * parent.weightDecay);
+
+      const ElemType* g = gradient.memptr();
+      ElemType* mMem = m.memptr();
+      ElemType* vMem = v.memptr();
+      ElemType* itMem = iterate.memptr();
+
+      const size_t n = iterate.n_elem;
+      for (size_t j = 0; j < n; ++j)
+      {
+        const ElemType gj = g[j];
+        mMem[j] = b1 * mMem[j] + (1 - b1) * gj;
+        vMem[j] = b2 * vMem[j] + (1 - b2) * gj * gj;
+        itMem[j] = decay * itMem[j] -
+            scale * mMem[j] / (std::sqrt(vMem[j]) + eps);
+      }
+    }
+
+    //! Sparse gradients and GPU matrices have no contiguous host memory to
+    //! walk, so fall back to the expression-based update (which stays
+    //! device-side for GPU types).
+    template<typename InGradType>
+    typename std::enable_if<!arma::is_arma_type<InGradType>::value, void>::type
+    FusedUpdate(MatType& iterate,
+                const double stepSize,
+                const InGradType& gradient,
+                const double biasCorrection1,
+                const double biasCorrection2)
+    {
+      m *= parent.beta1;
+      m += (1 - parent.beta1) * gradient;
+
+      v *= parent.beta2;
+      v += (1 - parent.beta2) * (gradient % gradient);
+
+      if (parent.weightDecay != 0)
+      {
+        iterate *= (typename MatType::elem_type)
+            (1.0 - stepSize * parent.weightDecay);
+      }
+
+      iterate -= (stepSize * std::sqrt(biasCorrection2) / biasCorrection1) *
+          m / (sqrt(v) + parent.epsilon);
+    }
+
+    /**
+     * Mixed-precision update kernel for dense gradients: like FusedUpdate(),
+     * but the moment estimates are read from and written back to the
+     * single-precision buffers, while the moment recursions and the
+     * parameter step are accumulated in double.
+     */
+    template<typename InGradType>
+    typename std::enable_if<arma::is_arma_type<InGradType>::value, void>::type
+    MixedUpdate(MatType& iterate,
+                const double stepSize,
+                const InGradType& gradient,
+                const double biasCorrection1,
+                const double biasCorrection2)
+    {
+      typedef typename MatType::elem_type ElemType;
+
+      const double scale = stepSize * std::sqrt(biasCorrection2) /
+          biasCorrection1;
+      const double decay = 1.0 - stepSize * parent.weightDecay;
+
+      const ElemType* g = gradient.memptr();
+      float* mMem = mF.memptr();
+      float* vMem = vF.memptr();
+      ElemType* itMem = iterate.memptr();
+
+      const size_t n = iterate.n_elem;
+      for (size_t j = 0; j < n; ++j)
+      {
+        const double gj = (double) g[j];
+        const double mj = parent.beta1 * mMem[j] +
+            (1 - parent.beta1) * gj;
+        const double vj = parent.beta2 * vMem[j] +
+            (1 - parent.beta2) * gj * gj;
+        mMem[j] = (float) mj;
+        vMem[j] = (float) vj;
+        itMem[j] = (ElemType) (decay * itMem[j] - scale * mj /
+            (std::sqrt(vj) + parent.epsilon));
+      }
+    }
+
+    //! Sparse gradients never reach the mixed-precision path at runtime, and
+    //! GPU matrices keep full-precision device-side moments; both fall back
+    //! to the expression-based update.
+    template<typename InGradType>
+    typename std::enable_if<!arma::is_arma_type<InGradType>::value, void>::type
+    MixedUpdate(MatType& iterate,
+                const double stepSize,
+                const InGradType& gradient,
+                const double biasCorrection1,
+                const double biasCorrection2)
+    {
+      FusedUpdate(iterate, stepSize, gradient, biasCorrection1,
+          biasCorrection2);
+    }
+
+    /**
+     * Half-precision update kernel for dense gradients: the moment estimates
+     * are stored as packed IEEE binary16 bits and widened to full precision
+     * for the moment recursions and the parameter step.  To keep small
+     * gradient contributions representable in binary16, the stored buffers
+     * carry the loss scale s: mH holds s * m and vH holds s * v, and the
+     * scale is divided back out of the step in closed form, so the update is
+     * exactly plain Adam up to the binary16 rounding of the moments.
+     */
+    template<typename InGradType>
+    typename std::enable_if<arma::is_arma_type<InGradType>::value, void>::type
+    HalfUpdate(MatType& iterate,
+               const double stepSize,
+               const InGradType& gradient,
+               const double biasCorrection1,
+               const double biasCorrection2)
+    {
+      typedef typename MatType::elem_type ElemType;
+
+      const double s = parent.lossScale;
+      const double sqrtS = std::sqrt(s);
+      const double scale = stepSize * std::sqrt(biasCorrection2) /
+          biasCorrection1;
+      const double decay = 1.0 - stepSize * parent.weightDecay;
+
+      const ElemType* g = gradient.memptr();
+      arma::u16* mMem = mH.memptr();
+      arma::u16* vMem = vH.memptr();
+      ElemType* itMem = iterate.memptr();
+
+      const size_t n = iterate.n_elem;
+      for (size_t j = 0; j < n; ++j)
+      {
+        const double gj = (double) g[j];
+        const double gs = s * gj;
+        // The stored recursions track s * m and s * v.
+        const double mj = parent.beta1 * (double) FromFp16(mMem[j]) +
+            (1 - parent.beta1) * gs;
+        const double vj = parent.beta2 * (double) FromFp16(vMem[j]) +
+            (1 - parent.beta2) * gs * gj;
+        mMem[j] = ToFp16((float) mj);
+        vMem[j] = ToFp16((float) vj);
+        // With mj = s * m and vj = s * v, the plain Adam step
+        // m / (sqrt(v) + eps) equals mj / (sqrt(s) * sqrt(vj) + s * eps).
+        itMem[j] = (ElemType) (decay * itMem[j] - scale * mj /
+            (sqrtS * std::sqrt(vj) + s * parent.epsilon));
+      }
+    }
+
+    //! Sparse gradients never reach the half-precision path at runtime, and
+    //! GPU matrices keep full-precision device-side moments; both fall back
+    //! to the expression-based update.
+    template<typename InGradType>
+    typename std::enable_if<!arma::is_arma_type<InGradType>::value, void>::type
+    HalfUpdate(MatType& iterate,
+               const double stepSize,
+               const InGradType& gradient,
+               const double biasCorrection1,
+               const double biasCorrection2)
+    {
+      FusedUpdate(iterate, stepSize, gradient, biasCorrection1,
+          biasCorrection2);
+    }
+
     // Instantiated parent object.
     AdamUpdate& parent;
 
@@ -141,6 +569,24 @@ class AdamUpdate
     // The exponential moving average of squared gradient values.
     GradType v;
 
+    // Single-precision storage of m, used in the mixed-precision mode.
+    arma::Mat<float> mF;
+
+    // Single-precision storage of v, used in the mixed-precision mode.
+    arma::Mat<float> vF;
+
+    // Packed binary16 storage of m (scaled by the loss scale), used in the
+    // half-precision mode.
+    arma::Mat<arma::u16> mH;
+
+    // Packed binary16 storage of v (scaled by the loss scale), used in the
+    // half-precision mode.
+    arma::Mat<arma::u16> vH;
+
+    // The iteration at which each coordinate was last visited (lazy sparse
+    // path only).
+    arma::Mat<arma::uword> lastVisit;
+
     // The number of iterations.
     size_t iteration;
   };
@@ -154,6 +600,21 @@ class AdamUpdate
 
   // The second moment coefficient.
   double beta2;
+
+  // Whether the fused single-pass update kernel is used.
+  bool fused;
+
+  // Whether the moment estimates are stored in single precision.
+  bool mixedPrecision;
+
+  // The decoupled weight decay coefficient (0 means no decay).
+  double weightDecay;
+
+  // Whether the moment estimates are stored in half precision.
+  bool halfPrecision;
+
+  // The loss scale used by the half-precision mode (1 means none).
+  double lossScale;
 };
 
 } // namespace ens
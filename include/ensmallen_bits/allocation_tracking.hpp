@@ -0,0 +1,86 @@
+/**
+ * @file allocation_tracking.hpp
+ * @author Marcus Edel
+ *
+ * Opt-in allocation tracking for the optimizer hot paths.  When
+ * ENS_TRACK_ALLOCATIONS is defined before ensmallen.hpp is included,
+ * Armadillo's memory allocation is routed through counting hooks, and the
+ * Report callback extends its summary with per-phase allocation statistics.
+ * This makes it possible to assert "zero allocations per iteration" in
+ * benchmark runs and to catch expression-template temporaries sneaking into
+ * update policies.
+ *
+ * This header must be included before <armadillo>, because the hooks are
+ * installed via Armadillo's ARMA_ALIEN_MEM_ALLOC_FUNCTION mechanism, which is
+ * read when Armadillo itself is compiled in.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_ALLOCATION_TRACKING_HPP
+#define ENSMALLEN_ALLOCATION_TRACKING_HPP
+
+#if defined(ENS_TRACK_ALLOCATIONS)
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+
+namespace ens {
+
+/**
+ * Process-wide allocation counters, filled in by the Armadillo memory hooks
+ * below.  The counters increase monotonically; interested callers (like the
+ * Report callback) snapshot them and report differences, so concurrent
+ * optimizations only ever over-count, never corrupt.
+ */
+class AllocationTracker
+{
+ public:
+  //! The number of Armadillo allocations since the process started.
+  static std::atomic<size_t>& Count()
+  {
+    static std::atomic<size_t> count(0);
+    return count;
+  }
+
+  //! The number of bytes allocated by Armadillo since the process started.
+  static std::atomic<size_t>& Bytes()
+  {
+    static std::atomic<size_t> bytes(0);
+    return bytes;
+  }
+
+  //! Record one allocation of the given size.
+  static void Record(const size_t nBytes)
+  {
+    ++Count();
+    Bytes() += nBytes;
+  }
+};
+
+} // namespace ens
+
+//! Counting replacement for Armadillo's memory allocation function.
+inline void* ens_track_alloc(const size_t nBytes)
+{
+  ens::AllocationTracker::Record(nBytes);
+  return std::malloc(nBytes);
+}
+
+//! Matching replacement for Armadillo's memory free function.
+inline void ens_track_free(void* mem, const size_t /* nBytes */)
+{
+  std::free(mem);
+}
+
+#undef ARMA_ALIEN_MEM_ALLOC_FUNCTION
+#undef ARMA_ALIEN_MEM_FREE_FUNCTION
+#define ARMA_ALIEN_MEM_ALLOC_FUNCTION ens_track_alloc
+#define ARMA_ALIEN_MEM_FREE_FUNCTION ens_track_free
+
+#endif // ENS_TRACK_ALLOCATIONS
+
+#endif
@@ -29,6 +29,11 @@ namespace ens {
  * of the methods (unfortunately, C++ specialization rules mean you have to
  * re-implement everything).
  *
+ * When ensmallen is built with OpenMP, the constraint terms of the objective
+ * and gradient are evaluated across threads, so EvaluateConstraint() and
+ * GradientConstraint() must be safe to call concurrently for different
+ * constraint indices.
+ *
  * @tparam LagrangianFunction Lagrangian function to be used.
  */
 template<typename LagrangianFunction>
@@ -58,16 +58,33 @@ typename MatType::elem_type AugLagrangianFunction<LagrangianFunction>::Evaluate(
   // First get the function's objective value.
   ElemType objective = function.Evaluate(coordinates);
 
-  // Now loop for each constraint.
-  for (size_t i = 0; i < function.NumConstraints(); ++i)
+  // The constraints are independent, so evaluate them in shards across
+  // threads with per-thread accumulation of the penalty terms.
+  const size_t numConstraints = function.NumConstraints();
+  const size_t numThreads = std::min(
+      ParallelRuntime::Get().RegionThreads(),
+      std::max(numConstraints, (size_t) 1));
+  arma::Col<ElemType> threadObjectives(numThreads, arma::fill::zeros);
+
+  ENS_PRAGMA_OMP_PARALLEL_FOR_THREADS((int) numThreads)
+  for (ptrdiff_t t = 0; t < (ptrdiff_t) numThreads; ++t)
   {
-    ElemType constraint = function.EvaluateConstraint(i, coordinates);
+    const size_t begin = (t * numConstraints) / numThreads;
+    const size_t end = ((t + 1) * numConstraints) / numThreads;
 
-    objective += (-lambda[i] * constraint) +
-        sigma * std::pow(constraint, 2) / 2;
+    ElemType localObjective = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+      const ElemType constraint = function.EvaluateConstraint(i, coordinates);
+
+      localObjective += (-lambda[i] * constraint) +
+          sigma * std::pow(constraint, 2) / 2;
+    }
+
+    threadObjectives(t) = localObjective;
   }
 
-  return objective;
+  return objective + arma::accu(threadObjectives);
 }
 
 // Evaluate the gradient of the AugLagrangianFunction at the given coordinates.
@@ -82,17 +99,38 @@ void AugLagrangianFunction<LagrangianFunction>::Gradient(
   gradient.zeros();
   function.Gradient(coordinates, gradient);
 
-  GradType constraintGradient; // Temporary for constraint gradients.
-  for (size_t i = 0; i < function.NumConstraints(); i++)
+  const size_t numConstraints = function.NumConstraints();
+  if (numConstraints == 0)
+    return;
+
+  // The constraints are independent, so compute their contributions in
+  // shards across threads, each accumulating into its own gradient buffer.
+  const size_t numThreads = std::min(
+      ParallelRuntime::Get().RegionThreads(), numConstraints);
+  std::vector<GradType> threadGradients(numThreads);
+
+  ENS_PRAGMA_OMP_PARALLEL_FOR_THREADS((int) numThreads)
+  for (ptrdiff_t t = 0; t < (ptrdiff_t) numThreads; ++t)
   {
-    function.GradientConstraint(i, coordinates, constraintGradient);
+    const size_t begin = (t * numConstraints) / numThreads;
+    const size_t end = ((t + 1) * numConstraints) / numThreads;
 
-    // Now calculate scaling factor and add to existing gradient.
-    GradType tmpGradient;
-    tmpGradient = (-lambda[i] + sigma *
-        function.EvaluateConstraint(i, coordinates)) * constraintGradient;
-    gradient += tmpGradient;
+    GradType& localGradient = threadGradients[t];
+    localGradient.zeros(gradient.n_rows, gradient.n_cols);
+
+    GradType constraintGradient; // Temporary for constraint gradients.
+    for (size_t i = begin; i < end; ++i)
+    {
+      function.GradientConstraint(i, coordinates, constraintGradient);
+
+      // Now calculate scaling factor and add to the local gradient.
+      localGradient += (-lambda[i] + sigma *
+          function.EvaluateConstraint(i, coordinates)) * constraintGradient;
+    }
   }
+
+  for (size_t t = 0; t < numThreads; ++t)
+    gradient += threadGradients[t];
 }
 
 // Get the initial point.
@@ -126,6 +126,17 @@ AugLagrangian::Optimize(
   Info << "Penalty is " << penalty << " (threshold " << penaltyThreshold
       << ")." << std::endl;
 
+  // Track the previous outer iteration's constraint violation so that the
+  // penalty growth can adapt to the observed progress.
+  ElemType lastPenalty = penalty;
+
+  // Carry the inner solver's L-BFGS memory pairs across outer iterations:
+  // the augmented Lagrangian changes slowly between them, so the curvature
+  // pairs from the previous subproblem remain useful, and reusing them cuts
+  // down the inner iteration count.  The user's setting is restored on exit.
+  const bool oldRetainMemory = lbfgs.RetainMemory();
+  lbfgs.RetainMemory() = true;
+
   // The odd comparison allows user to pass maxIterations = 0 (i.e. no limit on
   // number of iterations).
   size_t it;
@@ -152,6 +163,7 @@ AugLagrangian::Optimize(
       lambda = std::move(augfunc.Lambda());
       sigma = augfunc.Sigma();
 
+      lbfgs.RetainMemory() = oldRetainMemory;
       Callback::EndOptimization(*this, function, coordinates, callbacks...);
       return true;
     }
@@ -200,22 +212,41 @@ AugLagrangian::Optimize(
     }
     else
     {
-      // We multiply sigma by a constant value.
-      augfunc.Sigma() *= sigmaUpdateFactor;
+      // Adapt the penalty growth to the observed constraint violation: if
+      // the violation stagnated since the last outer iteration, apply the
+      // full growth factor, but if it is already shrinking, grow sigma more
+      // gently so the subproblems do not become needlessly ill-conditioned.
+      double growthFactor = sigmaUpdateFactor;
+      if (lastPenalty > 0 && penalty < lastPenalty)
+      {
+        growthFactor = std::max(std::sqrt(sigmaUpdateFactor),
+            sigmaUpdateFactor * (double) (penalty / lastPenalty));
+      }
+
+      augfunc.Sigma() *= growthFactor;
       Info << "Updated sigma to " << augfunc.Sigma() << "." << std::endl;
       if (augfunc.Sigma() >= std::numeric_limits<ElemType>::max() / 2.0)
       {
         Warn << "AugLagrangian::Optimize(): sigma too large for element type; "
             << "terminating." << std::endl;
+        lbfgs.RetainMemory() = oldRetainMemory;
         Callback::EndOptimization(*this, function, coordinates, callbacks...);
         return false;
       }
     }
 
+    lastPenalty = penalty;
+
     terminate |= Callback::StepTaken(*this, function, coordinates,
         callbacks...);
   }
 
+  // Store the multiplier and penalty parameter state even though we did not
+  // converge, so that a later optimization can be warm started from it.
+  lambda = std::move(augfunc.Lambda());
+  sigma = augfunc.Sigma();
+
+  lbfgs.RetainMemory() = oldRetainMemory;
   Callback::EndOptimization(*this, function, coordinates, callbacks...);
   return false;
 }
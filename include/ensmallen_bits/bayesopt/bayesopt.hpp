@@ -0,0 +1,190 @@
+/**
+ * @file bayesopt.hpp
+ * @author Marcus Edel
+ *
+ * Bayesian optimization with a Gaussian-process surrogate and the
+ * expected-improvement acquisition function.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_BAYESOPT_BAYESOPT_HPP
+#define ENSMALLEN_BAYESOPT_BAYESOPT_HPP
+
+#include <ensmallen_bits/lbfgs/lbfgs.hpp>
+
+namespace ens {
+
+/**
+ * Bayesian optimization is a sample-efficient strategy for the global
+ * optimization of expensive black-box functions.  A Gaussian-process
+ * surrogate with a squared-exponential kernel is fit to all evaluations made
+ * so far (the Cholesky factor of the kernel matrix is extended incrementally,
+ * one rank per evaluation), and each new evaluation point is chosen by
+ * maximizing the expected-improvement acquisition function over the search
+ * box with L-BFGS from random restarts.  Where population-based gradient-free
+ * optimizers spend thousands of evaluations, this typically needs tens, at
+ * the price of cubic surrogate cost in the number of evaluations---so it is
+ * only worthwhile when a single objective evaluation is expensive.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @article{Jones1998,
+ *   author  = {Jones, Donald R. and Schonlau, Matthias and
+ *              Welch, William J.},
+ *   title   = {Efficient Global Optimization of Expensive Black-Box
+ *              Functions},
+ *   journal = {Journal of Global Optimization},
+ *   volume  = {13},
+ *   pages   = {455--492},
+ *   year    = {1998}
+ * }
+ * @endcode
+ *
+ * BayesianOptimization can optimize arbitrary functions.  For more details,
+ * see the documentation on function types included with this distribution or
+ * on the ensmallen website.
+ */
+class BayesianOptimization
+{
+ public:
+  /**
+   * Construct the Bayesian optimization optimizer.  The defaults here are not
+   * necessarily good for the given problem, so it is suggested that the
+   * values used be tailored to the task at hand; in particular the search
+   * bounds and the kernel length scale should match the scale of the
+   * problem.
+   *
+   * @param numInitialPoints Number of uniformly sampled evaluations used to
+   *     seed the surrogate before the acquisition takes over.
+   * @param maxIterations Number of acquisition-driven evaluations after the
+   *     initial design (so the total evaluation budget is numInitialPoints +
+   *     maxIterations).
+   * @param lowerBound Lower bound of the search box, applied to every
+   *     dimension.
+   * @param upperBound Upper bound of the search box, applied to every
+   *     dimension.
+   * @param lengthScale Length scale of the squared-exponential kernel.
+   * @param signalVariance Signal variance of the squared-exponential kernel.
+   * @param noiseVariance Observation noise variance added to the kernel
+   *     diagonal; also keeps the Cholesky factorization well conditioned.
+   * @param explorationFactor Exploration margin of the expected-improvement
+   *     acquisition (often written xi); larger values favor exploration.
+   * @param numRestarts Number of random restarts for the L-BFGS maximization
+   *     of the acquisition function.
+   */
+  BayesianOptimization(const size_t numInitialPoints = 10,
+                       const size_t maxIterations = 50,
+                       const double lowerBound = -10.0,
+                       const double upperBound = 10.0,
+                       const double lengthScale = 1.0,
+                       const double signalVariance = 1.0,
+                       const double noiseVariance = 1e-6,
+                       const double explorationFactor = 0.01,
+                       const size_t numRestarts = 10);
+
+  /**
+   * Optimize the given function using Bayesian optimization. The given
+   * starting point will be modified to store the finishing point of the
+   * algorithm (the best evaluation made), and the best objective value is
+   * returned.  The starting point is used as the first point of the initial
+   * design.
+   *
+   * @tparam FunctionType Type of the function to be optimized.
+   * @tparam MatType Type of matrix to optimize.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to optimize.
+   * @param iterate Starting point (will be modified).
+   * @param callbacks Callback functions.
+   * @return Objective value of the final point.
+   */
+  template<typename FunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(FunctionType& function,
+                                       MatType& iterate,
+                                       CallbackTypes&&... callbacks);
+
+  //! Get the number of initial design points.
+  size_t NumInitialPoints() const { return numInitialPoints; }
+  //! Modify the number of initial design points.
+  size_t& NumInitialPoints() { return numInitialPoints; }
+
+  //! Get the number of acquisition-driven evaluations.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the number of acquisition-driven evaluations.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the lower bound of the search box.
+  double LowerBound() const { return lowerBound; }
+  //! Modify the lower bound of the search box.
+  double& LowerBound() { return lowerBound; }
+
+  //! Get the upper bound of the search box.
+  double UpperBound() const { return upperBound; }
+  //! Modify the upper bound of the search box.
+  double& UpperBound() { return upperBound; }
+
+  //! Get the kernel length scale.
+  double LengthScale() const { return lengthScale; }
+  //! Modify the kernel length scale.
+  double& LengthScale() { return lengthScale; }
+
+  //! Get the kernel signal variance.
+  double SignalVariance() const { return signalVariance; }
+  //! Modify the kernel signal variance.
+  double& SignalVariance() { return signalVariance; }
+
+  //! Get the observation noise variance.
+  double NoiseVariance() const { return noiseVariance; }
+  //! Modify the observation noise variance.
+  double& NoiseVariance() { return noiseVariance; }
+
+  //! Get the exploration margin of the acquisition.
+  double ExplorationFactor() const { return explorationFactor; }
+  //! Modify the exploration margin of the acquisition.
+  double& ExplorationFactor() { return explorationFactor; }
+
+  //! Get the number of acquisition restarts.
+  size_t NumRestarts() const { return numRestarts; }
+  //! Modify the number of acquisition restarts.
+  size_t& NumRestarts() { return numRestarts; }
+
+ private:
+  //! The number of initial design points.
+  size_t numInitialPoints;
+
+  //! The number of acquisition-driven evaluations.
+  size_t maxIterations;
+
+  //! The lower bound of the search box.
+  double lowerBound;
+
+  //! The upper bound of the search box.
+  double upperBound;
+
+  //! The length scale of the squared-exponential kernel.
+  double lengthScale;
+
+  //! The signal variance of the squared-exponential kernel.
+  double signalVariance;
+
+  //! The observation noise variance.
+  double noiseVariance;
+
+  //! The exploration margin of the expected-improvement acquisition.
+  double explorationFactor;
+
+  //! The number of random restarts for the acquisition maximization.
+  size_t numRestarts;
+};
+
+} // namespace ens
+
+// Include implementation.
+#include "bayesopt_impl.hpp"
+
+#endif
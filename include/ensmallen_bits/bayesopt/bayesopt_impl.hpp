@@ -0,0 +1,360 @@
+/**
+ * @file bayesopt_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of Bayesian optimization with a Gaussian-process surrogate.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_BAYESOPT_BAYESOPT_IMPL_HPP
+#define ENSMALLEN_BAYESOPT_BAYESOPT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "bayesopt.hpp"
+
+#include <ensmallen_bits/function.hpp>
+
+namespace ens {
+
+/**
+ * The negated expected-improvement acquisition over the current
+ * Gaussian-process posterior.  This is an internal helper of
+ * BayesianOptimization: L-BFGS minimizes this differentiable function to
+ * select the next evaluation point.
+ */
+template<typename ElemType>
+class BayesOptAcquisition
+{
+ public:
+  /**
+   * Construct the acquisition over the given posterior.  All matrix
+   * arguments are held by reference and must outlive this object.
+   *
+   * @param points The evaluated points, one per column.
+   * @param chol The lower Cholesky factor of the kernel matrix.
+   * @param alpha The surrogate weights, K^-1 (y - mean).
+   * @param meanObjective The mean of the observed objective values.
+   * @param bestObjective The best observed objective value.
+   * @param lengthScale Length scale of the squared-exponential kernel.
+   * @param signalVariance Signal variance of the squared-exponential kernel.
+   * @param explorationFactor Exploration margin of the acquisition.
+   */
+  BayesOptAcquisition(const arma::Mat<ElemType>& points,
+                      const arma::Mat<ElemType>& chol,
+                      const arma::Col<ElemType>& alpha,
+                      const double meanObjective,
+                      const double bestObjective,
+                      const double lengthScale,
+                      const double signalVariance,
+                      const double explorationFactor) :
+      points(points),
+      chol(chol),
+      alpha(alpha),
+      meanObjective(meanObjective),
+      bestObjective(bestObjective),
+      lengthScale(lengthScale),
+      signalVariance(signalVariance),
+      explorationFactor(explorationFactor)
+  { /* Nothing to do. */ }
+
+  //! Evaluate the negated expected improvement at the given point.
+  double Evaluate(const arma::Mat<ElemType>& x)
+  {
+    arma::Col<ElemType> kvec, v;
+    double mu, sigma;
+    Posterior(x, mu, sigma, kvec, v);
+
+    const double improvement = bestObjective - mu - explorationFactor;
+    const double z = improvement / sigma;
+    return -(improvement * NormalCdf(z) + sigma * NormalPdf(z));
+  }
+
+  //! Evaluate the gradient of the negated expected improvement.
+  void Gradient(const arma::Mat<ElemType>& x, arma::Mat<ElemType>& gradient)
+  {
+    arma::Col<ElemType> kvec, v;
+    double mu, sigma;
+    Posterior(x, mu, sigma, kvec, v);
+
+    // The kernel gradient with respect to the query point is
+    // dk_i/dx = k_i * (x_i - x) / lengthScale^2, so the posterior mean and
+    // variance gradients are dmu = sum_i alpha_i dk_i and
+    // dvar = -2 sum_i w_i dk_i with w = K^-1 kvec = L^-T v.
+    const arma::Col<ElemType> w =
+        arma::solve(arma::trimatu(chol.t()), v);
+
+    const arma::Col<ElemType> xv = arma::vectorise(x);
+    arma::Col<ElemType> dmu(xv.n_elem, arma::fill::zeros);
+    arma::Col<ElemType> dvar(xv.n_elem, arma::fill::zeros);
+    const double l2 = lengthScale * lengthScale;
+    for (size_t i = 0; i < points.n_cols; ++i)
+    {
+      const arma::Col<ElemType> dk =
+          (points.col(i) - xv) * (ElemType) (kvec(i) / l2);
+      dmu += alpha(i) * dk;
+      dvar -= 2 * w(i) * dk;
+    }
+
+    const double improvement = bestObjective - mu - explorationFactor;
+    const double z = improvement / sigma;
+
+    // dEI = -cdf(z) * dmu + pdf(z) * dsigma, with dsigma = dvar / (2 sigma).
+    gradient = (ElemType) NormalCdf(z) * dmu -
+        (ElemType) (NormalPdf(z) / (2 * sigma)) * dvar;
+  }
+
+ private:
+  //! Compute the posterior mean and standard deviation at the given point.
+  void Posterior(const arma::Mat<ElemType>& x,
+                 double& mu,
+                 double& sigma,
+                 arma::Col<ElemType>& kvec,
+                 arma::Col<ElemType>& v) const
+  {
+    const arma::Col<ElemType> xv = arma::vectorise(x);
+    const double l2 = lengthScale * lengthScale;
+
+    kvec.set_size(points.n_cols);
+    for (size_t i = 0; i < points.n_cols; ++i)
+    {
+      const double d2 = arma::accu(arma::square(points.col(i) - xv));
+      kvec(i) = (ElemType) (signalVariance * std::exp(-0.5 * d2 / l2));
+    }
+
+    v = arma::solve(arma::trimatl(chol), kvec);
+    mu = meanObjective + arma::dot(kvec, alpha);
+    sigma = std::sqrt(std::max(signalVariance - arma::dot(v, v), 1e-12));
+  }
+
+  //! The standard normal cumulative distribution function.
+  static double NormalCdf(const double z)
+  {
+    return 0.5 * std::erfc(-z / std::sqrt(2.0));
+  }
+
+  //! The standard normal probability density function.
+  static double NormalPdf(const double z)
+  {
+    return std::exp(-0.5 * z * z) / std::sqrt(2.0 * arma::datum::pi);
+  }
+
+  //! The evaluated points, one per column.
+  const arma::Mat<ElemType>& points;
+
+  //! The lower Cholesky factor of the kernel matrix.
+  const arma::Mat<ElemType>& chol;
+
+  //! The surrogate weights.
+  const arma::Col<ElemType>& alpha;
+
+  //! The mean of the observed objective values.
+  double meanObjective;
+
+  //! The best observed objective value.
+  double bestObjective;
+
+  //! The length scale of the squared-exponential kernel.
+  double lengthScale;
+
+  //! The signal variance of the squared-exponential kernel.
+  double signalVariance;
+
+  //! The exploration margin of the acquisition.
+  double explorationFactor;
+};
+
+inline BayesianOptimization::BayesianOptimization(
+    const size_t numInitialPoints,
+    const size_t maxIterations,
+    const double lowerBound,
+    const double upperBound,
+    const double lengthScale,
+    const double signalVariance,
+    const double noiseVariance,
+    const double explorationFactor,
+    const size_t numRestarts) :
+    numInitialPoints(numInitialPoints),
+    maxIterations(maxIterations),
+    lowerBound(lowerBound),
+    upperBound(upperBound),
+    lengthScale(lengthScale),
+    signalVariance(signalVariance),
+    noiseVariance(noiseVariance),
+    explorationFactor(explorationFactor),
+    numRestarts(numRestarts)
+{ /* Nothing to do here. */ }
+
+template<typename FunctionType,
+         typename MatType,
+         typename... CallbackTypes>
+typename MatType::elem_type BayesianOptimization::Optimize(
+    FunctionType& function,
+    MatType& iterateIn,
+    CallbackTypes&&... callbacks)
+{
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+
+  // Make sure that we have the methods that we need.
+  traits::CheckArbitraryFunctionTypeAPI<FunctionType, BaseMatType>();
+  RequireDenseFloatingPointType<BaseMatType>();
+
+  if (numInitialPoints == 0)
+  {
+    throw std::logic_error("BayesianOptimization::Optimize(): the initial "
+        "design needs at least one point!");
+  }
+
+  if (upperBound <= lowerBound)
+  {
+    throw std::logic_error("BayesianOptimization::Optimize(): the upper "
+        "bound must be greater than the lower bound!");
+  }
+
+  const size_t dims = iterate.n_elem;
+  const size_t capacity = numInitialPoints + maxIterations;
+
+  // All evaluated points (one per column), their objective values, and the
+  // lower Cholesky factor of the kernel matrix over them.  The factor is
+  // extended by one rank per evaluation instead of being refactorized.
+  arma::Mat<ElemType> points(dims, capacity);
+  arma::Col<ElemType> objectives(capacity);
+  arma::Mat<ElemType> chol(capacity, capacity, arma::fill::zeros);
+  size_t n = 0;
+
+  ElemType bestObjective = std::numeric_limits<ElemType>::max();
+  arma::Col<ElemType> bestPoint = arma::vectorise(iterate);
+
+  // Candidate in the shape the function expects.
+  BaseMatType candidate(iterate.n_rows, iterate.n_cols);
+
+  // Controls early termination of the optimization process.
+  bool terminate = false;
+
+  // Evaluate one point and extend the surrogate with the observation.
+  auto observe = [&](const arma::Col<ElemType>& x)
+  {
+    candidate = arma::reshape(x, iterate.n_rows, iterate.n_cols);
+    const ElemType objective = function.Evaluate(candidate);
+    terminate |= Callback::Evaluate(*this, function, candidate, objective,
+        callbacks...);
+
+    if (objective < bestObjective)
+    {
+      bestObjective = objective;
+      bestPoint = x;
+    }
+
+    // Rank-one extension of the Cholesky factor: solve L l = k, then the new
+    // diagonal entry is sqrt(k(x, x) + noise - l^T l).
+    if (n > 0)
+    {
+      arma::Col<ElemType> kvec(n);
+      const double l2 = lengthScale * lengthScale;
+      for (size_t i = 0; i < n; ++i)
+      {
+        const double d2 = arma::accu(arma::square(points.col(i) - x));
+        kvec(i) = (ElemType) (signalVariance * std::exp(-0.5 * d2 / l2));
+      }
+
+      const arma::Col<ElemType> lrow = arma::solve(
+          arma::trimatl(chol.submat(0, 0, n - 1, n - 1)), kvec);
+      chol(n, arma::span(0, n - 1)) = lrow.t();
+      chol(n, n) = (ElemType) std::sqrt(std::max(signalVariance +
+          noiseVariance - arma::dot(lrow, lrow), 1e-12));
+    }
+    else
+    {
+      chol(0, 0) = (ElemType) std::sqrt(signalVariance + noiseVariance);
+    }
+
+    points.col(n) = x;
+    objectives(n) = objective;
+    ++n;
+  };
+
+  Callback::BeginOptimization(*this, function, iterate, callbacks...);
+
+  // The initial design: the given starting point, then uniform samples from
+  // the search box.
+  observe(arma::vectorise(iterate));
+  for (size_t i = 1; i < numInitialPoints && !terminate; ++i)
+  {
+    observe(arma::Col<ElemType>(lowerBound + (upperBound - lowerBound) *
+        arma::randu<arma::Col<ElemType>>(dims)));
+  }
+
+  // The inner optimizer for the acquisition maximization; its evaluations
+  // only touch the surrogate, not the expensive objective.
+  L_BFGS acquisitionOptimizer;
+
+  for (size_t i = 0; i < maxIterations && !terminate; ++i)
+  {
+    // Refit the surrogate weights, alpha = K^-1 (y - mean), from the
+    // incrementally extended Cholesky factor.
+    const arma::Mat<ElemType> activePoints = points.cols(0, n - 1);
+    const arma::Mat<ElemType> activeChol = chol.submat(0, 0, n - 1, n - 1);
+    const double meanObjective =
+        (double) arma::mean(objectives.subvec(0, n - 1));
+    const arma::Col<ElemType> centered = objectives.subvec(0, n - 1) -
+        (ElemType) meanObjective;
+    const arma::Col<ElemType> alpha = arma::solve(
+        arma::trimatu(activeChol.t()),
+        arma::solve(arma::trimatl(activeChol), centered));
+
+    BayesOptAcquisition<ElemType> acquisition(activePoints, activeChol,
+        alpha, meanObjective, (double) bestObjective, lengthScale,
+        signalVariance, explorationFactor);
+
+    // Maximize the expected improvement (minimize its negation) with L-BFGS
+    // from random restarts; the first restart starts at the incumbent.
+    arma::Mat<ElemType> bestCandidate = bestPoint;
+    double bestAcquisition = std::numeric_limits<double>::max();
+    for (size_t restart = 0; restart <= numRestarts; ++restart)
+    {
+      arma::Mat<ElemType> start = (restart == 0) ? bestPoint :
+          arma::Mat<ElemType>(lowerBound + (upperBound - lowerBound) *
+          arma::randu<arma::Col<ElemType>>(dims));
+
+      acquisitionOptimizer.Optimize(acquisition, start);
+      start = arma::clamp(start, (ElemType) lowerBound,
+          (ElemType) upperBound);
+
+      const double value = acquisition.Evaluate(start);
+      if (value < bestAcquisition)
+      {
+        bestAcquisition = value;
+        bestCandidate = start;
+      }
+    }
+
+    // If no restart found positive expected improvement, fall back to a
+    // uniform exploration point.
+    if (!(bestAcquisition < 0))
+    {
+      bestCandidate = lowerBound + (upperBound - lowerBound) *
+          arma::randu<arma::Col<ElemType>>(dims);
+    }
+
+    observe(arma::vectorise(bestCandidate));
+
+    candidate = arma::reshape(bestPoint, iterate.n_rows, iterate.n_cols);
+    terminate |= Callback::StepTaken(*this, function, candidate,
+        callbacks...);
+  }
+
+  iterate = arma::reshape(bestPoint, iterate.n_rows, iterate.n_cols);
+
+  Callback::EndOptimization(*this, function, iterate, callbacks...);
+  return bestObjective;
+}
+
+} // namespace ens
+
+#endif
@@ -184,6 +184,14 @@ class BigBatchSGD
   //! Modify whether or not the actual objective is calculated.
   bool& ExactObjective() { return exactObjective; }
 
+  //! Get the squared norm of the current batch gradient estimate (updated
+  //! every iteration during optimization, for use by callbacks).
+  double GradientNorm() const { return gradientNorm; }
+
+  //! Get the sample variance of the current batch (updated every iteration
+  //! during optimization, for use by callbacks).
+  double SampleVariance() const { return sampleVariance; }
+
  private:
   //! The size of the current batch.
   size_t batchSize;
@@ -207,6 +215,12 @@ class BigBatchSGD
   //! Controls whether or not the actual Objective value is calculated.
   bool exactObjective;
 
+  //! The squared norm of the most recent batch gradient estimate.
+  double gradientNorm;
+
+  //! The sample variance of the most recent batch.
+  double sampleVariance;
+
   //! The update policy used to update the parameters in each iteration.
   UpdatePolicyType updatePolicy;
 
@@ -35,6 +35,8 @@ BigBatchSGD<UpdatePolicyType>::BigBatchSGD(
     tolerance(tolerance),
     shuffle(shuffle),
     exactObjective(exactObjective),
+    gradientNorm(0.0),
+    sampleVariance(0.0),
     updatePolicy(UpdatePolicyType())
 { /* Nothing to do. */ }
 
@@ -79,11 +81,12 @@ BigBatchSGD<UpdatePolicyType>::Optimize(
       InstUpdatePolicyType;
 
   if (!instUpdatePolicy.Has<InstUpdatePolicyType>())
-  {
-    instUpdatePolicy.Clean();
-    instUpdatePolicy.Set<InstUpdatePolicyType>(
-        new InstUpdatePolicyType(updatePolicy));
-  }
+    instUpdatePolicy.Emplace<InstUpdatePolicyType>(updatePolicy);
+
+  // Resolve the concrete policy type once, so the typeid check in As<T>()
+  // stays out of the hot loop below.
+  InstUpdatePolicyType& instUpdate =
+      instUpdatePolicy.As<InstUpdatePolicyType>();
 
   // Find the number of functions to use.
   const size_t numFunctions = f.NumFunctions();
@@ -191,12 +194,16 @@ BigBatchSGD<UpdatePolicyType>::Optimize(
       }
     }
 
+    // Publish the variance test statistics, so that callbacks (which receive
+    // a reference to this optimizer) can observe the batch growth decisions.
+    gradientNorm = gB;
+    sampleVariance = vB;
+
     if (terminate)
       break;
 
-    instUpdatePolicy.As<InstUpdatePolicyType>().Update(f, stepSize, iterate,
-        gradient, gB, vB, currentFunction, batchSize, effectiveBatchSize,
-        reset);
+    instUpdate.Update(f, stepSize, iterate, gradient, gB, vB,
+        currentFunction, batchSize, effectiveBatchSize, reset);
 
     // Update the iterate.
     iterate -= stepSize * gradient;
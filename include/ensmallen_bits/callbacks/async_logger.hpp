@@ -0,0 +1,145 @@
+/**
+ * @file async_logger.hpp
+ * @author Marcus Edel
+ *
+ * A background logger draining a lock-free single-producer single-consumer
+ * ring buffer, so callbacks can hand off terminal output without blocking the
+ * optimization thread.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_CALLBACKS_ASYNC_LOGGER_HPP
+#define ENSMALLEN_CALLBACKS_ASYNC_LOGGER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ens {
+
+/**
+ * The AsyncLogger writes messages to an output stream from a background
+ * thread.  Messages are handed off through a lock-free single-producer
+ * single-consumer ring buffer, so on the optimization thread an enqueue is
+ * just a string move and an atomic store---the actual stream writes (and the
+ * flushes, which can block on slow terminals or network file systems) happen
+ * on the logger thread.
+ *
+ * The single-producer contract matches how callbacks are invoked: all
+ * callback methods run on the optimization thread.  The destructor drains
+ * any remaining messages before joining the logger thread, so everything
+ * enqueued is written before the owning callback goes away.
+ */
+class AsyncLogger
+{
+ public:
+  /**
+   * Set up the logger and start the background thread.
+   *
+   * @param output Ostream which receives the drained messages.
+   * @param capacity Number of message slots in the ring buffer.
+   */
+  AsyncLogger(std::ostream& output, const size_t capacity = 1024) :
+      output(output),
+      buffer(capacity),
+      head(0),
+      tail(0),
+      done(false),
+      worker(&AsyncLogger::Drain, this)
+  { /* Nothing to do here. */ }
+
+  //! Drain any remaining messages and stop the background thread.
+  ~AsyncLogger()
+  {
+    done.store(true, std::memory_order_release);
+    worker.join();
+  }
+
+  // The worker thread holds a pointer to this object, so it may not move.
+  AsyncLogger(const AsyncLogger&) = delete;
+  AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+  /**
+   * Try to enqueue a message; returns false without blocking when the ring
+   * buffer is full.  Useful for transient output (like progress-bar frames
+   * that the next frame overwrites anyway), which is better dropped than
+   * waited for.
+   *
+   * @param message The message to enqueue.
+   */
+  bool TryEnqueue(std::string&& message)
+  {
+    const size_t t = tail.load(std::memory_order_relaxed);
+    if (t - head.load(std::memory_order_acquire) == buffer.size())
+      return false;
+
+    buffer[t % buffer.size()] = std::move(message);
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Enqueue a message, waiting for a free slot if the ring buffer is full;
+   * messages enqueued this way are never dropped.
+   *
+   * @param message The message to enqueue.
+   */
+  void Enqueue(std::string&& message)
+  {
+    while (!TryEnqueue(std::move(message)))
+      std::this_thread::yield();
+  }
+
+ private:
+  //! The background thread procedure: write queued messages to the stream,
+  //! flushing whenever the queue has been caught up with.
+  void Drain()
+  {
+    while (true)
+    {
+      const size_t h = head.load(std::memory_order_relaxed);
+      if (h == tail.load(std::memory_order_acquire))
+      {
+        if (done.load(std::memory_order_acquire))
+          break;
+
+        output.flush();
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        continue;
+      }
+
+      output << buffer[h % buffer.size()];
+      buffer[h % buffer.size()].clear();
+      head.store(h + 1, std::memory_order_release);
+    }
+
+    output.flush();
+  }
+
+  //! The output stream that all messages are written to.
+  std::ostream& output;
+
+  //! The ring buffer message slots.
+  std::vector<std::string> buffer;
+
+  //! Index of the next message to write (owned by the logger thread).
+  std::atomic<size_t> head;
+
+  //! Index of the next free slot (owned by the producer).
+  std::atomic<size_t> tail;
+
+  //! Set by the destructor to stop the logger thread.
+  std::atomic<bool> done;
+
+  //! The background logger thread.
+  std::thread worker;
+};
+
+} // namespace ens
+
+#endif
@@ -273,11 +273,14 @@ class Callback
            typename FunctionType,
            typename MatType,
            typename... CallbackTypes>
-  static bool Evaluate(OptimizerType& optimizer,
-                       FunctionType& function,
-                       const MatType& coordinates,
-                       const double objective,
-                       CallbackTypes&... callbacks)
+  static typename std::enable_if<callbacks::traits::AnyHasEvaluate<
+      OptimizerType, FunctionType, MatType, CallbackTypes...>::value,
+      bool>::type
+  Evaluate(OptimizerType& optimizer,
+           FunctionType& function,
+           const MatType& coordinates,
+           const double objective,
+           CallbackTypes&... callbacks)
   {
     // This will return immediately once a callback returns true.
     bool result = false;
@@ -288,6 +291,22 @@ class Callback
      return result;
   }
 
+  //! No callback in the pack implements Evaluate(), so the whole dispatch
+  //! compiles to an empty stub.
+  template<typename OptimizerType,
+           typename FunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  static typename std::enable_if<!callbacks::traits::AnyHasEvaluate<
+      OptimizerType, FunctionType, MatType, CallbackTypes...>::value,
+      bool>::type
+  Evaluate(OptimizerType& /* optimizer */,
+           FunctionType& /* function */,
+           const MatType& /* coordinates */,
+           const double /* objective */,
+           CallbackTypes&... /* callbacks */)
+  { return false; }
+
   /**
    * Invoke the EvaluateConstraint() callback if it exists.
    *
@@ -460,11 +479,14 @@ class Callback
            typename MatType,
            typename GradType,
            typename... CallbackTypes>
-  static bool Gradient(OptimizerType& optimizer,
-                       FunctionType& function,
-                       const MatType& coordinates,
-                       GradType& gradient,
-                       CallbackTypes&... callbacks)
+  static typename std::enable_if<callbacks::traits::AnyHasGradient<
+      OptimizerType, FunctionType, MatType, GradType, CallbackTypes...>::value,
+      bool>::type
+  Gradient(OptimizerType& optimizer,
+           FunctionType& function,
+           const MatType& coordinates,
+           GradType& gradient,
+           CallbackTypes&... callbacks)
   {
     // This will return immediately once a callback returns true.
     bool result = false;
@@ -474,6 +496,23 @@ class Callback
      return result;
   }
 
+  //! No callback in the pack implements Gradient(), so the whole dispatch
+  //! compiles to an empty stub.
+  template<typename OptimizerType,
+           typename FunctionType,
+           typename MatType,
+           typename GradType,
+           typename... CallbackTypes>
+  static typename std::enable_if<!callbacks::traits::AnyHasGradient<
+      OptimizerType, FunctionType, MatType, GradType, CallbackTypes...>::value,
+      bool>::type
+  Gradient(OptimizerType& /* optimizer */,
+           FunctionType& /* function */,
+           const MatType& /* coordinates */,
+           GradType& /* gradient */,
+           CallbackTypes&... /* callbacks */)
+  { return false; }
+
   /**
    * Invoke the GradientConstraint() callback if it exists.
    *
@@ -588,12 +627,19 @@ class Callback
            typename MatType,
            typename GradType,
            typename... CallbackTypes>
-  static bool EvaluateWithGradient(OptimizerType& optimizer,
-                                   FunctionType& function,
-                                   const MatType& coordinates,
-                                   const double objective,
-                                   GradType& gradient,
-                                   CallbackTypes&... callbacks)
+  static typename std::enable_if<
+      callbacks::traits::AnyHasEvaluate<
+          OptimizerType, FunctionType, MatType, CallbackTypes...>::value ||
+      callbacks::traits::AnyHasGradient<
+          OptimizerType, FunctionType, MatType, GradType,
+          CallbackTypes...>::value,
+      bool>::type
+  EvaluateWithGradient(OptimizerType& optimizer,
+                       FunctionType& function,
+                       const MatType& coordinates,
+                       const double objective,
+                       GradType& gradient,
+                       CallbackTypes&... callbacks)
   {
     // This will return immediately once a callback returns true.
     bool result = false;
@@ -608,6 +654,28 @@ class Callback
      return result;
   }
 
+  //! No callback in the pack implements Evaluate() or Gradient(), so the
+  //! whole dispatch compiles to an empty stub.
+  template<typename OptimizerType,
+           typename FunctionType,
+           typename MatType,
+           typename GradType,
+           typename... CallbackTypes>
+  static typename std::enable_if<
+      !callbacks::traits::AnyHasEvaluate<
+          OptimizerType, FunctionType, MatType, CallbackTypes...>::value &&
+      !callbacks::traits::AnyHasGradient<
+          OptimizerType, FunctionType, MatType, GradType,
+          CallbackTypes...>::value,
+      bool>::type
+  EvaluateWithGradient(OptimizerType& /* optimizer */,
+                       FunctionType& /* function */,
+                       const MatType& /* coordinates */,
+                       const double /* objective */,
+                       GradType& /* gradient */,
+                       CallbackTypes&... /* callbacks */)
+  { return false; }
+
   /**
    * Invoke the BeginEpoch() callback if it exists.
    *
@@ -682,12 +750,15 @@ class Callback
            typename FunctionType,
            typename MatType,
            typename... CallbackTypes>
-  static bool BeginEpoch(OptimizerType& optimizer,
-                         FunctionType& function,
-                         const MatType& coordinates,
-                         const size_t epoch,
-                         const double objective,
-                         CallbackTypes&... callbacks)
+  static typename std::enable_if<callbacks::traits::AnyHasBeginEpoch<
+      OptimizerType, FunctionType, MatType, CallbackTypes...>::value,
+      bool>::type
+  BeginEpoch(OptimizerType& optimizer,
+             FunctionType& function,
+             const MatType& coordinates,
+             const size_t epoch,
+             const double objective,
+             CallbackTypes&... callbacks)
   {
     // This will return immediately once a callback returns true.
     bool result = false;
@@ -699,6 +770,23 @@ class Callback
      return result;
   }
 
+  //! No callback in the pack implements BeginEpoch(), so the whole dispatch
+  //! compiles to an empty stub.
+  template<typename OptimizerType,
+           typename FunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  static typename std::enable_if<!callbacks::traits::AnyHasBeginEpoch<
+      OptimizerType, FunctionType, MatType, CallbackTypes...>::value,
+      bool>::type
+  BeginEpoch(OptimizerType& /* optimizer */,
+             FunctionType& /* function */,
+             const MatType& /* coordinates */,
+             const size_t /* epoch */,
+             const double /* objective */,
+             CallbackTypes&... /* callbacks */)
+  { return false; }
+
   /**
    * Invoke the EndEpoch() callback if it exists.
    *
@@ -772,12 +860,15 @@ class Callback
            typename FunctionType,
            typename MatType,
            typename... CallbackTypes>
-  static bool EndEpoch(OptimizerType& optimizer,
-                       FunctionType& function,
-                       const MatType& coordinates,
-                       const size_t epoch,
-                       const double objective,
-                       CallbackTypes&... callbacks)
+  static typename std::enable_if<callbacks::traits::AnyHasEndEpoch<
+      OptimizerType, FunctionType, MatType, CallbackTypes...>::value,
+      bool>::type
+  EndEpoch(OptimizerType& optimizer,
+           FunctionType& function,
+           const MatType& coordinates,
+           const size_t epoch,
+           const double objective,
+           CallbackTypes&... callbacks)
   {
     // This will return immediately once a callback returns true.
     bool result = false;
@@ -789,6 +880,23 @@ class Callback
      return result;
   }
 
+  //! No callback in the pack implements EndEpoch(), so the whole dispatch
+  //! compiles to an empty stub.
+  template<typename OptimizerType,
+           typename FunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  static typename std::enable_if<!callbacks::traits::AnyHasEndEpoch<
+      OptimizerType, FunctionType, MatType, CallbackTypes...>::value,
+      bool>::type
+  EndEpoch(OptimizerType& /* optimizer */,
+           FunctionType& /* function */,
+           const MatType& /* coordinates */,
+           const size_t /* epoch */,
+           const double /* objective */,
+           CallbackTypes&... /* callbacks */)
+  { return false; }
+
   /**
    * Invoke the StepTaken() callback if it exists.
    *
@@ -859,10 +967,13 @@ class Callback
            typename FunctionType,
            typename MatType,
            typename... CallbackTypes>
-  static bool StepTaken(OptimizerType& optimizer,
-                        FunctionType& function,
-                        MatType& coordinates,
-                        CallbackTypes&... callbacks)
+  static typename std::enable_if<callbacks::traits::AnyHasStepTaken<
+      OptimizerType, FunctionType, MatType, CallbackTypes...>::value,
+      bool>::type
+  StepTaken(OptimizerType& optimizer,
+            FunctionType& function,
+            MatType& coordinates,
+            CallbackTypes&... callbacks)
   {
     // This will return immediately once a callback returns true.
     bool result = false;
@@ -872,6 +983,21 @@ class Callback
      return result;
   }
 
+  //! No callback in the pack implements StepTaken(), so the whole dispatch
+  //! compiles to an empty stub.
+  template<typename OptimizerType,
+           typename FunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  static typename std::enable_if<!callbacks::traits::AnyHasStepTaken<
+      OptimizerType, FunctionType, MatType, CallbackTypes...>::value,
+      bool>::type
+  StepTaken(OptimizerType& /* optimizer */,
+            FunctionType& /* function */,
+            MatType& /* coordinates */,
+            CallbackTypes&... /* callbacks */)
+  { return false; }
+
  /**
   * Invoke the GenerationalStepTaken() callback if it exists.
   * Specialization for MultiObjective case.
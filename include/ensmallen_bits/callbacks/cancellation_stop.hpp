@@ -0,0 +1,172 @@
+/**
+ * @file cancellation_stop.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the cancellation stop callback function, which
+ * terminates the optimization when a shared cancellation token is cancelled.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_CALLBACKS_CANCELLATION_STOP_HPP
+#define ENSMALLEN_CALLBACKS_CANCELLATION_STOP_HPP
+
+#include <ensmallen_bits/utility/cancellation_token.hpp>
+
+namespace ens {
+
+/**
+ * Cancellation stop function: terminates the optimization once the given
+ * CancellationToken is cancelled, e.g. by an external scheduler on another
+ * thread reclaiming the core.  The token is polled from every evaluation,
+ * gradient, constraint, and step callback hook, so the optimization winds
+ * down within a handful of function evaluations, including from inner
+ * solvers that forward their callbacks (the L-BFGS line searches, the inner
+ * solver of AugLagrangian).  Each poll is a single relaxed atomic load.
+ *
+ * The optimizers honor termination only at points where the iterate is
+ * consistent, so the coordinates left behind by a cancelled Optimize() call
+ * are a valid (if unconverged) iterate.
+ */
+class CancellationStop
+{
+ public:
+  /**
+   * Set up the cancellation stop callback with the given token; the copy
+   * shares the token's flag, so cancelling any copy stops the optimization.
+   *
+   * @param token The cancellation token to poll.
+   */
+  CancellationStop(const CancellationToken& token) : token(token)
+  { /* Nothing to do here. */ }
+
+  //! Get the polled cancellation token.
+  const CancellationToken& Token() const { return token; }
+  //! Modify the polled cancellation token.
+  CancellationToken& Token() { return token; }
+
+  /**
+   * Callback function called at the beginning of a pass over the data.
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Starting point.
+   * @param epoch The index of the current epoch.
+   * @param objective Objective value of the current point.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  bool BeginEpoch(OptimizerType& /* optimizer */,
+                  FunctionType& /* function */,
+                  const MatType& /* coordinates */,
+                  const size_t /* epoch */,
+                  const double /* objective */)
+  {
+    return token.Cancelled();
+  }
+
+  /**
+   * Callback function called after any call to Evaluate().
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Current point.
+   * @param objective Objective value of the current point.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  bool Evaluate(OptimizerType& /* optimizer */,
+                FunctionType& /* function */,
+                const MatType& /* coordinates */,
+                const double /* objective */)
+  {
+    return token.Cancelled();
+  }
+
+  /**
+   * Callback function called after any call to EvaluateConstraint().
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Current point.
+   * @param constraint The index of the constraint.
+   * @param constraintValue Constraint value of the current point.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  bool EvaluateConstraint(OptimizerType& /* optimizer */,
+                          FunctionType& /* function */,
+                          const MatType& /* coordinates */,
+                          const size_t /* constraint */,
+                          const double /* constraintValue */)
+  {
+    return token.Cancelled();
+  }
+
+  /**
+   * Callback function called after any call to Gradient().
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Current point.
+   * @param gradient Matrix that holds the gradient.
+   */
+  template<typename OptimizerType,
+           typename FunctionType,
+           typename MatType,
+           typename GradType>
+  bool Gradient(OptimizerType& /* optimizer */,
+                FunctionType& /* function */,
+                const MatType& /* coordinates */,
+                const GradType& /* gradient */)
+  {
+    return token.Cancelled();
+  }
+
+  /**
+   * Callback function called at the end of each iteration.
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Current point.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  bool StepTaken(OptimizerType& /* optimizer */,
+                 FunctionType& /* function */,
+                 const MatType& /* coordinates */)
+  {
+    return token.Cancelled();
+  }
+
+  /**
+   * Callback function called at the end of each generation of a
+   * population-based optimizer.
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Current population.
+   * @param objectives The set of calculated objectives so far.
+   * @param frontIndices The indices of the members belonging to Pareto
+   *     fronts.
+   */
+  template<typename OptimizerType,
+           typename FunctionType,
+           typename MatType,
+           typename ObjectivesVecType,
+           typename IndicesType>
+  bool GenerationalStepTaken(OptimizerType& /* optimizer */,
+                             FunctionType& /* function */,
+                             const MatType& /* coordinates */,
+                             const ObjectivesVecType& /* objectives */,
+                             const IndicesType& /* frontIndices */)
+  {
+    return token.Cancelled();
+  }
+
+ private:
+  //! The polled cancellation token.
+  CancellationToken token;
+};
+
+} // namespace ens
+
+#endif
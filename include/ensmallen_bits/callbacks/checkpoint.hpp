@@ -0,0 +1,175 @@
+/**
+ * @file checkpoint.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the periodic checkpoint callback function.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_CALLBACKS_CHECKPOINT_HPP
+#define ENSMALLEN_CALLBACKS_CHECKPOINT_HPP
+
+#include <cstdio>
+#include <fstream>
+
+namespace ens {
+
+/**
+ * Periodic checkpointing, based on the EndEpoch callback function.
+ *
+ * Every interval epochs the current coordinates---and, for optimizers that
+ * support it (the SGD family through SGD::SaveState()), the instantiated
+ * update-policy state---are written to a compact binary file, so a run killed
+ * by preemption can be resumed from the last checkpoint instead of from
+ * scratch.  The file is written to a temporary name and renamed into place,
+ * so a checkpoint interrupted mid-write never replaces a complete one.
+ *
+ * To resume, load the checkpoint with Checkpoint::Load() and call Optimize()
+ * again with the restored coordinates; for SGD-family optimizers the restored
+ * update-policy state is picked up automatically (Load() sets ResetPolicy()
+ * to false through SGD::LoadState()).
+ */
+class Checkpoint
+{
+ public:
+  /**
+   * Set up the checkpoint callback class.
+   *
+   * @param file Name of the checkpoint file.
+   * @param interval Write a checkpoint every interval epochs.
+   */
+  Checkpoint(const std::string& file, const size_t interval = 1) :
+      file(file),
+      interval(interval)
+  { /* Nothing to do here. */ }
+
+  /**
+   * Callback function called at the end of a pass over the data.
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Starting point.
+   * @param epoch The index of the current epoch.
+   * @param objective Objective value of the current point.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  bool EndEpoch(OptimizerType& optimizer,
+                FunctionType& /* function */,
+                const MatType& coordinates,
+                const size_t epoch,
+                const double objective)
+  {
+    if (epoch % interval != 0)
+      return false;
+
+    const std::string tempFile = file + ".tmp";
+    {
+      std::ofstream stream(tempFile, std::ios::binary | std::ios::trunc);
+      if (!stream.is_open())
+      {
+        Warn << "Checkpoint: unable to open '" << tempFile << "' for writing;"
+            << " skipping checkpoint." << std::endl;
+        return false;
+      }
+
+      const arma::uword epochOut = (arma::uword) epoch;
+      stream.write(reinterpret_cast<const char*>(&epochOut),
+          sizeof(epochOut));
+      stream.write(reinterpret_cast<const char*>(&objective),
+          sizeof(objective));
+      coordinates.save(stream, arma::arma_binary);
+      SaveOptimizerState(optimizer, stream, coordinates, 0);
+    }
+
+    std::rename(tempFile.c_str(), file.c_str());
+    return false;
+  }
+
+  /**
+   * Load a checkpoint written by this callback: restores the coordinates,
+   * the epoch, the objective and---if the optimizer supports it---the
+   * update-policy state.  Returns false if the file cannot be read.
+   *
+   * @param file Name of the checkpoint file.
+   * @param optimizer The optimizer whose state is restored.
+   * @param coordinates Matrix which receives the checkpointed coordinates.
+   * @param epoch Receives the epoch the checkpoint was taken at.
+   * @param objective Receives the checkpointed objective.
+   */
+  template<typename OptimizerType, typename MatType>
+  static bool Load(const std::string& file,
+                   OptimizerType& optimizer,
+                   MatType& coordinates,
+                   size_t& epoch,
+                   double& objective)
+  {
+    std::ifstream stream(file, std::ios::binary);
+    if (!stream.is_open())
+      return false;
+
+    arma::uword epochIn = 0;
+    stream.read(reinterpret_cast<char*>(&epochIn), sizeof(epochIn));
+    epoch = (size_t) epochIn;
+    stream.read(reinterpret_cast<char*>(&objective), sizeof(objective));
+    if (!coordinates.load(stream, arma::arma_binary))
+      return false;
+
+    LoadOptimizerState(optimizer, stream, coordinates, 0);
+    return stream.good();
+  }
+
+ private:
+  //! Save the update-policy state for optimizers that implement SaveState();
+  //! resolved by overload rank, so everything else compiles to a no-op.
+  template<typename OptimizerType, typename MatType>
+  static auto SaveOptimizerState(OptimizerType& optimizer,
+                                 std::ostream& stream,
+                                 const MatType& /* coordinates */,
+                                 int)
+      -> decltype(optimizer.template SaveState<MatType>(stream), void())
+  {
+    optimizer.template SaveState<MatType>(stream);
+  }
+
+  //! No-op fallback for optimizers without SaveState().
+  template<typename OptimizerType, typename MatType>
+  static void SaveOptimizerState(OptimizerType& /* optimizer */,
+                                 std::ostream& /* stream */,
+                                 const MatType& /* coordinates */,
+                                 long)
+  { }
+
+  //! Restore the update-policy state for optimizers that implement
+  //! LoadState().
+  template<typename OptimizerType, typename MatType>
+  static auto LoadOptimizerState(OptimizerType& optimizer,
+                                 std::istream& stream,
+                                 const MatType& coordinates,
+                                 int)
+      -> decltype(optimizer.template LoadState<MatType>(stream, 0, 0), void())
+  {
+    optimizer.template LoadState<MatType>(stream, coordinates.n_rows,
+        coordinates.n_cols);
+  }
+
+  //! No-op fallback for optimizers without LoadState().
+  template<typename OptimizerType, typename MatType>
+  static void LoadOptimizerState(OptimizerType& /* optimizer */,
+                                 std::istream& /* stream */,
+                                 const MatType& /* coordinates */,
+                                 long)
+  { }
+
+  //! Name of the checkpoint file.
+  std::string file;
+
+  //! Write a checkpoint every interval epochs.
+  size_t interval;
+};
+
+} // namespace ens
+
+#endif
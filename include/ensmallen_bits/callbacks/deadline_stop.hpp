@@ -0,0 +1,158 @@
+/**
+ * @file deadline_stop.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the deadline stop callback function, which terminates
+ * the optimization at a wall-clock budget with adaptively-strided clock
+ * reads.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_CALLBACKS_DEADLINE_STOP_HPP
+#define ENSMALLEN_CALLBACKS_DEADLINE_STOP_HPP
+
+namespace ens {
+
+/**
+ * Deadline stop function: terminates the optimization once a wall-clock
+ * budget is spent.  In contrast to TimerStop, which only checks at epoch
+ * boundaries, DeadlineStop hooks the per-iteration StepTaken() callback and
+ * so bounds the runtime of any optimizer; and instead of reading the clock
+ * every iteration, it calibrates the per-iteration cost on the fly and only
+ * reads the clock every N iterations, with N chosen so that roughly one
+ * check happens per checkInterval seconds.  As the deadline approaches, the
+ * checks become denser (the stride always targets at most half of the
+ * remaining budget), so the overshoot past the deadline is on the order of
+ * one stride of iterations.
+ */
+class DeadlineStop
+{
+ public:
+  /**
+   * Set up the deadline stop callback with the given budget.
+   *
+   * @param duration The wall-clock budget in seconds.
+   * @param checkInterval Approximate time between clock reads, in seconds;
+   *     smaller values give tighter deadlines at slightly higher overhead.
+   */
+  DeadlineStop(const double duration, const double checkInterval = 0.25) :
+      duration(duration),
+      checkInterval(checkInterval),
+      stepsTotal(0),
+      stepsSinceCheck(0),
+      checkStride(1)
+  { /* Nothing to do here. */ }
+
+  /**
+   * Callback function called at the start of the optimization process.
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Starting point.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  void BeginOptimization(OptimizerType& /* optimizer */,
+                         FunctionType& /* function */,
+                         MatType& /* coordinates */)
+  {
+    timer.tic();
+    stepsTotal = 0;
+    stepsSinceCheck = 0;
+    checkStride = 1;
+  }
+
+  /**
+   * Callback function called at the end of each iteration.
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Current point.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  bool StepTaken(OptimizerType& /* optimizer */,
+                 FunctionType& /* function */,
+                 const MatType& /* coordinates */)
+  {
+    return Check();
+  }
+
+  /**
+   * Callback function called at the end of each generation of a
+   * population-based optimizer.
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Current population.
+   * @param objectives The set of calculated objectives so far.
+   * @param frontIndices The indices of the members belonging to Pareto
+   *     fronts.
+   */
+  template<typename OptimizerType,
+           typename FunctionType,
+           typename MatType,
+           typename ObjectivesVecType,
+           typename IndicesType>
+  bool GenerationalStepTaken(OptimizerType& /* optimizer */,
+                             FunctionType& /* function */,
+                             const MatType& /* coordinates */,
+                             const ObjectivesVecType& /* objectives */,
+                             const IndicesType& /* frontIndices */)
+  {
+    return Check();
+  }
+
+ private:
+  //! Count the iteration and read the clock if the stride is reached.
+  bool Check()
+  {
+    if (++stepsSinceCheck < checkStride)
+      return false;
+
+    stepsTotal += stepsSinceCheck;
+    stepsSinceCheck = 0;
+
+    const double elapsed = timer.toc();
+    const double remaining = duration - elapsed;
+    if (remaining <= 0)
+    {
+      Info << "DeadlineStop: wall-clock budget of " << duration
+          << "s spent; terminate optimization." << std::endl;
+      return true;
+    }
+
+    // Re-calibrate the stride from the measured per-iteration cost: aim the
+    // next clock read at checkInterval from now, but never further than
+    // half of the remaining budget.
+    const double perStep = elapsed / (double) stepsTotal;
+    const double target = std::min(checkInterval, remaining / 2);
+    checkStride = (perStep > 0) ?
+        std::max<size_t>(1, (size_t) (target / perStep)) : 1;
+
+    return false;
+  }
+
+  //! The wall-clock budget in seconds.
+  double duration;
+
+  //! Approximate time between clock reads, in seconds.
+  double checkInterval;
+
+  //! Number of iterations counted at the last clock read.
+  size_t stepsTotal;
+
+  //! Number of iterations since the last clock read.
+  size_t stepsSinceCheck;
+
+  //! Number of iterations between clock reads.
+  size_t checkStride;
+
+  //! Locally-stored timer object.
+  arma::wall_clock timer;
+};
+
+} // namespace ens
+
+#endif
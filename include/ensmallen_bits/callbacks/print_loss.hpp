@@ -12,10 +12,19 @@
 #ifndef ENSMALLEN_CALLBACKS_PRINT_LOSS_HPP
 #define ENSMALLEN_CALLBACKS_PRINT_LOSS_HPP
 
+#include "async_logger.hpp"
+
+#include <memory>
+#include <sstream>
+
 namespace ens {
 
 /**
  * Print loss function, based on the EndEpoch callback function.
+ *
+ * The loss lines are written by a background logger thread; the callback
+ * itself only formats the line and enqueues it, so the optimization thread
+ * never blocks on terminal or file I/O.
  */
 class PrintLoss
 {
@@ -25,7 +34,8 @@ class PrintLoss
    *
    * @param ostream Ostream which receives output from this object.
    */
-  PrintLoss(std::ostream& output = arma::get_cout_stream()) : output(output)
+  PrintLoss(std::ostream& output = arma::get_cout_stream()) :
+      logger(new AsyncLogger(output))
   { /* Nothing to do here. */ }
 
   /**
@@ -44,13 +54,15 @@ class PrintLoss
                 const size_t /* epoch */,
                 const double objective)
   {
-    output << objective << std::endl;
+    std::ostringstream line;
+    line << objective << '\n';
+    logger->Enqueue(line.str());
     return false;
   }
 
  private:
-  //! The output stream that all data is to be sent to; example: std::cout.
-  std::ostream& output;
+  //! Background logger that writes the enqueued lines to the output stream.
+  std::shared_ptr<AsyncLogger> logger;
 };
 
 } // namespace ens
@@ -0,0 +1,405 @@
+/**
+ * @file profiler.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the profiler callback function, which accumulates
+ * per-event timing histograms in memory with negligible overhead.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_CALLBACKS_PROFILER_HPP
+#define ENSMALLEN_CALLBACKS_PROFILER_HPP
+
+#include <chrono>
+
+#if defined(__linux__)
+  #include <linux/perf_event.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+  #include <cstring>
+#endif
+
+namespace ens {
+
+/**
+ * Profiler callback that records the time spent between optimizer events into
+ * fixed-size logarithmic histograms, entirely in memory.  Each event costs one
+ * clock read and one array increment (a few tens of nanoseconds), so the
+ * callback is safe to leave enabled in production; results are inspected
+ * after Optimize() returns.
+ *
+ * Since callbacks fire after the corresponding work is done, each histogram
+ * records the interval ending at its event: the Evaluate histogram covers the
+ * objective (and gradient, for fused EvaluateWithGradient) computation, and
+ * the StepTaken histogram covers the update-policy step.  Buckets hold counts
+ * of intervals with floor(log2(nanoseconds)) equal to the bucket index.
+ *
+ * On Linux, PerfCounters() additionally samples hardware performance
+ * counters (CPU cycles, backend-stalled cycles, and last-level cache misses)
+ * around the same intervals and aggregates the deltas per phase, so a
+ * deployed run can answer whether a phase is bandwidth- or latency-bound
+ * directly: a high stalled-cycle fraction together with a large miss volume
+ * points at memory bandwidth, a high stalled fraction with few misses at
+ * latency.  Opening the counters can fail (e.g. a restrictive
+ * perf_event_paranoid setting); in that case the profiler warns once and
+ * falls back to timing only.
+ */
+class Profiler
+{
+ public:
+  //! Number of histogram buckets; bucket i counts intervals in
+  //! [2^i, 2^(i+1)) nanoseconds.
+  static const size_t numBuckets = 64;
+
+  //! Per-phase aggregate of the sampled hardware events.
+  struct PerfSample
+  {
+    //! CPU cycles spent in the phase.
+    arma::uword cycles;
+    //! Cycles the backend was stalled (waiting on memory or execution
+    //! resources).
+    arma::uword stalledCycles;
+    //! Last-level cache misses; multiplied by the cache-line size this
+    //! estimates the bytes pulled from memory.
+    arma::uword cacheMisses;
+  };
+
+  /**
+   * Set up the profiler callback.
+   */
+  Profiler() : perfCounters(false), countersActive(false)
+  {
+    counterFds[0] = counterFds[1] = counterFds[2] = -1;
+    Reset();
+  }
+
+  /**
+   * Reset all histograms and counter aggregates to zero.
+   */
+  void Reset()
+  {
+    for (size_t i = 0; i < numBuckets; ++i)
+      evaluateHist[i] = gradientHist[i] = stepHist[i] = 0;
+    evaluations = gradients = steps = 0;
+    evaluatePerf = gradientPerf = stepPerf = PerfSample{ 0, 0, 0 };
+  }
+
+  /**
+   * Callback function called at the start of the optimization process.
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Starting point.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  void BeginOptimization(OptimizerType& /* optimizer */,
+                         FunctionType& /* function */,
+                         MatType& /* coordinates */)
+  {
+    if (perfCounters)
+      OpenCounters();
+    lastEvent = std::chrono::steady_clock::now();
+  }
+
+  /**
+   * Callback function called at the end of the optimization process; releases
+   * the hardware counters (if they were opened).
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Final point.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  void EndOptimization(OptimizerType& /* optimizer */,
+                       FunctionType& /* function */,
+                       MatType& /* coordinates */)
+  {
+    CloseCounters();
+  }
+
+  /**
+   * Callback function called after any call to Evaluate().
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Starting point.
+   * @param objective Objective value of the current point.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  void Evaluate(OptimizerType& /* optimizer */,
+                FunctionType& /* function */,
+                const MatType& /* coordinates */,
+                const double /* objective */)
+  {
+    Record(evaluateHist, evaluatePerf);
+    ++evaluations;
+  }
+
+  /**
+   * Callback function called after any call to Gradient().
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Starting point.
+   * @param gradient Matrix that holds the gradient.
+   */
+  template<typename OptimizerType,
+           typename FunctionType,
+           typename MatType,
+           typename GradType>
+  void Gradient(OptimizerType& /* optimizer */,
+                FunctionType& /* function */,
+                const MatType& /* coordinates */,
+                const GradType& /* gradient */)
+  {
+    Record(gradientHist, gradientPerf);
+    ++gradients;
+  }
+
+  /**
+   * Callback function called after any step is taken.
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Starting point.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  void StepTaken(OptimizerType& /* optimizer */,
+                 FunctionType& /* function */,
+                 const MatType& /* coordinates */)
+  {
+    Record(stepHist, stepPerf);
+    ++steps;
+  }
+
+  //! Get the histogram of intervals ending at Evaluate() events.
+  const arma::uword* EvaluateHistogram() const { return evaluateHist; }
+  //! Get the histogram of intervals ending at Gradient() events.
+  const arma::uword* GradientHistogram() const { return gradientHist; }
+  //! Get the histogram of intervals ending at StepTaken() events.
+  const arma::uword* StepHistogram() const { return stepHist; }
+
+  //! Get the number of recorded Evaluate() events.
+  arma::uword Evaluations() const { return evaluations; }
+  //! Get the number of recorded Gradient() events.
+  arma::uword Gradients() const { return gradients; }
+  //! Get the number of recorded StepTaken() events.
+  arma::uword Steps() const { return steps; }
+
+  //! Get whether hardware performance counters are sampled (Linux only).
+  bool PerfCounters() const { return perfCounters; }
+  //! Modify whether hardware performance counters are sampled (Linux only).
+  bool& PerfCounters() { return perfCounters; }
+
+  //! Get whether the counters were successfully opened for the current run.
+  bool PerfCountersActive() const { return countersActive; }
+
+  //! Get the counter aggregate for intervals ending at Evaluate() events.
+  const PerfSample& EvaluatePerf() const { return evaluatePerf; }
+  //! Get the counter aggregate for intervals ending at Gradient() events.
+  const PerfSample& GradientPerf() const { return gradientPerf; }
+  //! Get the counter aggregate for intervals ending at StepTaken() events.
+  const PerfSample& StepPerf() const { return stepPerf; }
+
+  /**
+   * Print a human-readable summary of the collected histograms.
+   *
+   * @param output Stream to print the summary to.
+   */
+  void Print(std::ostream& output) const
+  {
+    output << "Profiler summary (counts per power-of-two nanosecond bucket):"
+        << std::endl;
+    PrintHistogram(output, "evaluate", evaluateHist, evaluations);
+    PrintHistogram(output, "gradient", gradientHist, gradients);
+    PrintHistogram(output, "step", stepHist, steps);
+
+    if (evaluatePerf.cycles > 0 || gradientPerf.cycles > 0 ||
+        stepPerf.cycles > 0)
+    {
+      output << "Hardware counters (per phase):" << std::endl;
+      PrintPerf(output, "evaluate", evaluatePerf);
+      PrintPerf(output, "gradient", gradientPerf);
+      PrintPerf(output, "step", stepPerf);
+    }
+  }
+
+ private:
+  /**
+   * Record the interval since the previous event into the given histogram,
+   * and fold the hardware-counter deltas into the given phase aggregate.
+   */
+  void Record(arma::uword* histogram, PerfSample& perf)
+  {
+    const std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    arma::uword ns = (arma::uword)
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+        now - lastEvent).count();
+    lastEvent = now;
+
+    if (countersActive)
+    {
+      arma::uword values[3];
+      ReadCounters(values);
+      perf.cycles += values[0] - lastValues[0];
+      perf.stalledCycles += values[1] - lastValues[1];
+      perf.cacheMisses += values[2] - lastValues[2];
+      for (size_t i = 0; i < 3; ++i)
+        lastValues[i] = values[i];
+    }
+
+    // Find floor(log2(ns)); zero-length intervals land in bucket 0.
+    size_t bucket = 0;
+    while (ns >>= 1)
+      ++bucket;
+    ++histogram[bucket];
+  }
+
+  /**
+   * Open one counter per sampled hardware event.  Failures (an event not
+   * supported by the CPU, or perf access restricted by the kernel) leave the
+   * corresponding counter disabled; if none can be opened, the profiler
+   * warns once and keeps timing only.
+   */
+  void OpenCounters()
+  {
+#if defined(__linux__)
+    counterFds[0] = OpenCounter(PERF_COUNT_HW_CPU_CYCLES);
+    counterFds[1] = OpenCounter(PERF_COUNT_HW_STALLED_CYCLES_BACKEND);
+    counterFds[2] = OpenCounter(PERF_COUNT_HW_CACHE_MISSES);
+
+    countersActive = (counterFds[0] >= 0) || (counterFds[1] >= 0) ||
+        (counterFds[2] >= 0);
+    if (countersActive)
+      ReadCounters(lastValues);
+    else
+    {
+      Warn << "Profiler: hardware performance counters unavailable (check "
+          << "/proc/sys/kernel/perf_event_paranoid); timing only."
+          << std::endl;
+    }
+#else
+    Warn << "Profiler: hardware performance counters are only supported on "
+        << "Linux; timing only." << std::endl;
+#endif
+  }
+
+  //! Release the counters opened for the current run.
+  void CloseCounters()
+  {
+#if defined(__linux__)
+    for (size_t i = 0; i < 3; ++i)
+    {
+      if (counterFds[i] >= 0)
+        close(counterFds[i]);
+      counterFds[i] = -1;
+    }
+#endif
+    countersActive = false;
+  }
+
+  //! Read the current value of every open counter (0 for closed ones).
+  void ReadCounters(arma::uword* values)
+  {
+#if defined(__linux__)
+    for (size_t i = 0; i < 3; ++i)
+    {
+      long long value = 0;
+      if (counterFds[i] < 0 ||
+          read(counterFds[i], &value, sizeof(value)) != sizeof(value))
+        value = 0;
+      values[i] = (arma::uword) value;
+    }
+#else
+    values[0] = values[1] = values[2] = 0;
+#endif
+  }
+
+#if defined(__linux__)
+  //! Open one hardware counter for this process on any CPU; returns -1 if
+  //! the event is unavailable.
+  static int OpenCounter(const arma::uword config)
+  {
+    struct perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+  }
+#endif
+
+  //! Print one phase's counter aggregate, with the stalled-cycle fraction
+  //! and the byte volume estimated from the miss count (one cache line,
+  //! 64 bytes, per miss).
+  static void PrintPerf(std::ostream& output,
+                        const char* name,
+                        const PerfSample& perf)
+  {
+    output << "  " << name << ": " << perf.cycles << " cycles, "
+        << perf.stalledCycles << " stalled";
+    if (perf.cycles > 0)
+    {
+      output << " (" << (100 * perf.stalledCycles / perf.cycles) << "%)";
+    }
+    output << ", " << perf.cacheMisses << " cache misses (~"
+        << (64 * perf.cacheMisses) << " bytes)" << std::endl;
+  }
+
+  //! Print one histogram, skipping empty buckets.
+  static void PrintHistogram(std::ostream& output,
+                             const char* name,
+                             const arma::uword* histogram,
+                             const arma::uword total)
+  {
+    output << "  " << name << " (" << total << " events):" << std::endl;
+    for (size_t i = 0; i < numBuckets; ++i)
+    {
+      if (histogram[i] > 0)
+      {
+        output << "    [2^" << i << " ns, 2^" << (i + 1) << " ns): "
+            << histogram[i] << std::endl;
+      }
+    }
+  }
+
+  //! Histogram of intervals ending at Evaluate() events.
+  arma::uword evaluateHist[numBuckets];
+  //! Histogram of intervals ending at Gradient() events.
+  arma::uword gradientHist[numBuckets];
+  //! Histogram of intervals ending at StepTaken() events.
+  arma::uword stepHist[numBuckets];
+
+  //! Number of recorded events of each kind.
+  arma::uword evaluations;
+  arma::uword gradients;
+  arma::uword steps;
+
+  //! Time of the previous recorded event.
+  std::chrono::steady_clock::time_point lastEvent;
+
+  //! Whether hardware performance counters should be sampled.
+  bool perfCounters;
+  //! Whether the counters were successfully opened for the current run.
+  bool countersActive;
+  //! File descriptors of the open counters (-1 when closed).
+  int counterFds[3];
+  //! Counter values at the previous recorded event.
+  arma::uword lastValues[3];
+
+  //! Per-phase counter aggregates.
+  PerfSample evaluatePerf;
+  PerfSample gradientPerf;
+  PerfSample stepPerf;
+};
+
+} // namespace ens
+
+#endif
@@ -14,11 +14,27 @@
 
 #include <ensmallen_bits/function.hpp>
 
+#include "async_logger.hpp"
+
+#include <ensmallen_bits/utility/coarse_clock.hpp>
+
+#include <memory>
+#include <sstream>
+
 namespace ens {
 
 /**
  * A simple progress bar, based on the maximum number of optimizer iterations,
  * batch-size, number of functions and the StepTaken callback function.
+ *
+ * The bar is written by a background logger thread; the callbacks only format
+ * a frame and enqueue it, so the optimization thread never blocks on terminal
+ * or file I/O.  If the logger falls behind (for instance over a slow SSH
+ * session), intermediate frames---which the next frame overwrites anyway---are
+ * dropped instead of stalling the hot loop; epoch headers and the end-of-epoch
+ * summary are never dropped.  Step and epoch times for the ETA display are
+ * read from the process-wide CoarseClock, so per-step timing costs one
+ * relaxed atomic load instead of a clock syscall.
  */
 class ProgressBar
 {
@@ -33,15 +49,16 @@ class ProgressBar
   ProgressBar(const size_t widthIn = 70,
               std::ostream& output = arma::get_cout_stream()) :
       width(100.0 / widthIn),
-      output(output),
+      logger(new AsyncLogger(output)),
       objective(0),
       epochs(0),
       epochSize(0),
       step(1),
       steps(0),
       newEpoch(false),
-      epoch(1)
-
+      epoch(1),
+      stepTic(0),
+      epochTic(0)
   { /* Nothing to do here. */ }
 
   /**
@@ -85,7 +102,7 @@ class ProgressBar
     if (optimizer.MaxIterations() % function.NumFunctions() > 0)
       epochs++;
 
-    stepTimer.tic();
+    stepTic = CoarseClock::Get().Now();
   }
 
   /**
@@ -105,7 +122,7 @@ class ProgressBar
                   const double /* objective */)
   {
     // Start the timer.
-    epochTimer.tic();
+    epochTic = CoarseClock::Get().Now();
 
     // Reset epoch parameter.
     objective = 0;
@@ -132,39 +149,46 @@ class ProgressBar
   {
     if (newEpoch)
     {
-      output << "Epoch " << epoch;
+      std::ostringstream header;
+      header << "Epoch " << epoch;
       if (epochs > 0)
       {
-        output << "/" << epochs;
+        header << "/" << epochs;
       }
-      output << '\n';
+      header << '\n';
+      logger->Enqueue(header.str());
       newEpoch = false;
     }
 
+    std::ostringstream frame;
     const size_t progress = ((double) step / epochSize) * 100;
-    output << step++ << "/" << epochSize << " [";
+    frame << step++ << "/" << epochSize << " [";
     for (size_t i = 0; i < 100; i += width)
     {
       if (i < progress)
       {
-        output << "=";
+        frame << "=";
       }
       else if (i == progress)
       {
-        output << ">";
+        frame << ">";
       }
       else
       {
-        output << ".";
+        frame << ".";
       }
     }
 
-    output << "] " << progress << "% - ETA: " << (size_t) (stepTimer.toc() *
+    frame << "] " << progress << "% - ETA: " << (size_t)
+        ((CoarseClock::Get().Now() - stepTic) *
         (epochSize - step + 1)) % 60 << "s - loss: " <<
         objective / (double) step <<  "\r";
-    output.flush();
 
-    stepTimer.tic();
+    // Transient frame: if the logger has fallen behind, drop it rather than
+    // stall the optimization thread.
+    logger->TryEnqueue(frame.str());
+
+    stepTic = CoarseClock::Get().Now();
 
     return false;
   }
@@ -204,28 +228,29 @@ class ProgressBar
                 const size_t /* epoch */,
                 const double objective)
   {
+    std::ostringstream summary;
     const size_t progress = ((double) (step - 1) / epochSize) * 100;
-    output << step - 1 << "/" << epochSize << " [";
+    summary << step - 1 << "/" << epochSize << " [";
     for (size_t i = 0; i < 100; i += width)
     {
       if (i < progress)
       {
-        output << "=";
+        summary << "=";
       }
       else if (i == progress)
       {
-        output << ">";
+        summary << ">";
       }
       else
       {
-        output << ".";
+        summary << ".";
       }
     }
-    const double epochTimerElapsed = epochTimer.toc();
+    const double epochTimerElapsed = CoarseClock::Get().Now() - epochTic;
     const size_t stepTime = epochTimerElapsed / (double) epochSize * 1000;
-    output << "] " << progress << "% - " << epochTimerElapsed
+    summary << "] " << progress << "% - " << epochTimerElapsed
         << "s/epoch; " << stepTime << "ms/step; loss: " << objective  <<  "\n";
-    output.flush();
+    logger->Enqueue(summary.str());
     return false;
   }
 
@@ -233,8 +258,8 @@ class ProgressBar
   //! Length of a single step (1%).
   double width;
 
-  //! The output stream that all data is to be sent to; example: std::cout.
-  std::ostream& output;
+  //! Background logger that writes the enqueued frames to the output stream.
+  std::shared_ptr<AsyncLogger> logger;
 
   //! Objective over the current epoch.
   double objective;
@@ -257,11 +282,11 @@ class ProgressBar
   //! Locally-stored epoch.
   size_t epoch;
 
-  //! Locally-stored step timer object.
-  arma::wall_clock stepTimer;
+  //! Coarse-clock reading taken when the last step started.
+  double stepTic;
 
-  //! Locally-stored epoch timer object.
-  arma::wall_clock epochTimer;
+  //! Coarse-clock reading taken when the current epoch started.
+  double epochTic;
 };
 
 } // namespace ens
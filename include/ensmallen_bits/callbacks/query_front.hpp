@@ -16,12 +16,37 @@ namespace ens {
 
 /**
  * Query the current Pareto Front after every GenerationalStepTaken callback function.
+ *
+ * The current front is kept in double-buffered snapshot storage: each query
+ * assembles the front into a write buffer whose allocation is reused across
+ * generations, and then publishes it by swapping the buffers and bumping a
+ * generation counter.  Front() hands out a reference to the published buffer
+ * without copying, and it stays stable while the next snapshot is written,
+ * so live front monitoring does not add allocation churn to the generation
+ * loop.  Optionally, a history of all queried fronts can also be collected
+ * into a user-supplied array.
  */
 class QueryFront
 {
  public:
   /**
-   * Set up the query front callback class with the specified inputs.
+   * Set up the query front callback class; the queried fronts are only kept
+   * in the double-buffered snapshot storage (see Front() and Generation()).
+   *
+   * @param queryRate The frequency at which the Pareto Front is queried.
+   */
+  QueryFront(const size_t queryRate = 1) :
+      queryRate(queryRate),
+      paretoFrontArray(NULL),
+      genCounter(0),
+      activeBuffer(0),
+      snapshotGeneration(0)
+  { /* Nothing to do here */ }
+
+  /**
+   * Set up the query front callback class with the specified inputs.  In
+   * addition to the snapshot storage, every queried front is appended to the
+   * given array.
    *
    * @param queryRate The frequency at which the Pareto Front is queried.
    * @param paretoFrontArray A reference to a vector of cube to store the
@@ -30,8 +55,10 @@ class QueryFront
   QueryFront(const size_t queryRate,
              std::vector<arma::cube>& paretoFrontArray) :
       queryRate(queryRate),
-      paretoFrontArray(paretoFrontArray),
-      genCounter(0)
+      paretoFrontArray(&paretoFrontArray),
+      genCounter(0),
+      activeBuffer(0),
+      snapshotGeneration(0)
   { /* Nothing to do here */ }
 
   /**
@@ -54,34 +81,62 @@ class QueryFront
                              const ObjectivesVecType& objectives,
                              const IndicesType& frontIndices)
   {
-    arma::cube currentParetoFront{};
-
     if (genCounter % queryRate == 0)
     {
-      currentParetoFront.resize(objectives[0].n_rows, objectives[0].n_cols,
-          frontIndices[0].size());
+      // Assemble the snapshot into the write buffer; its allocation is
+      // reused unless the front shape changed since the last query.
+      arma::cube& writeBuffer = buffers[1 - activeBuffer];
+      if (writeBuffer.n_rows != objectives[0].n_rows ||
+          writeBuffer.n_cols != objectives[0].n_cols ||
+          writeBuffer.n_slices != frontIndices[0].size())
+      {
+        writeBuffer.set_size(objectives[0].n_rows, objectives[0].n_cols,
+            frontIndices[0].size());
+      }
+
       for (size_t solutionIdx = 0; solutionIdx < frontIndices[0].size();
           ++solutionIdx)
       {
-        currentParetoFront.slice(solutionIdx) = arma::conv_to<arma::mat>::from(
+        writeBuffer.slice(solutionIdx) = arma::conv_to<arma::mat>::from(
             objectives[frontIndices[0][solutionIdx]]);
       }
 
-      paretoFrontArray.emplace_back(std::move(currentParetoFront));
+      // Publish the snapshot: a reader holding the reference returned by
+      // Front() keeps the previous buffer, which is not written again until
+      // after the next publication.
+      activeBuffer = 1 - activeBuffer;
+      ++snapshotGeneration;
+
+      if (paretoFrontArray != NULL)
+        paretoFrontArray->push_back(buffers[activeBuffer]);
     }
 
     ++genCounter;
     return false;
   }
 
+  //! Get the most recently published front snapshot, without copying.  Empty
+  //! until the first query has been published.
+  const arma::cube& Front() const { return buffers[activeBuffer]; }
+
+  //! Get the number of snapshots published so far; a reader can poll this to
+  //! detect that Front() refers to a new snapshot.
+  size_t Generation() const { return snapshotGeneration; }
 
  private:
   //! The rate of query.
   size_t queryRate;
-  //! A reference to the array of pareto fronts.
-  std::vector<arma::cube>& paretoFrontArray;
+  //! A pointer to the optional array of Pareto fronts (may be NULL).
+  std::vector<arma::cube>* paretoFrontArray;
   //! A counter for the current generation.
   size_t genCounter;
+  //! Double-buffered snapshot storage; buffers[activeBuffer] holds the
+  //! published snapshot and the other buffer is written into.
+  arma::cube buffers[2];
+  //! Index of the published buffer.
+  size_t activeBuffer;
+  //! Number of snapshots published so far.
+  size_t snapshotGeneration;
 };
 
 } // namespace ens
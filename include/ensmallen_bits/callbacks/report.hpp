@@ -12,6 +12,7 @@
 #ifndef ENSMALLEN_CALLBACKS_REPORT_HPP
 #define ENSMALLEN_CALLBACKS_REPORT_HPP
 
+#include <ensmallen_bits/allocation_tracking.hpp>
 #include <ensmallen_bits/function.hpp>
 #include <iomanip>
 
@@ -19,6 +20,13 @@ namespace ens {
 
 /**
  * A simple optimization report.
+ *
+ * The per-iteration history backing the summary table is kept bounded: steps
+ * are sampled at an evenly spaced stride that doubles whenever the buffers
+ * would outgrow their capacity, and all single-value statistics (initial and
+ * final loss, maximum gradient norm, final step size and time) are tracked
+ * as streaming scalars.  The report therefore uses a fixed amount of memory
+ * regardless of the run length.
  */
 class Report
 {
@@ -31,13 +39,24 @@ class Report
    * @param outputIn Ostream which receives output from this object.
    * @param outputMatrixSizeIn The number of values to output for the function
    *     coordinates.
+   * @param historyCapacityIn Maximum number of evenly spaced history samples
+   *     kept for the summary table.
    */
   Report(const double iterationsPercentageIn = 0.1,
          std::ostream& outputIn = arma::get_cout_stream(),
-         const size_t outputMatrixSizeIn = 4) :
+         const size_t outputMatrixSizeIn = 4,
+         const size_t historyCapacityIn = 1000) :
       iterationsPercentage(iterationsPercentageIn),
       output(outputIn),
       outputMatrixSize(outputMatrixSizeIn),
+      historyCapacity(std::max(historyCapacityIn, (size_t) 2)),
+      sampleStride(1),
+      stepCount(0),
+      initialObjective(0),
+      finalObjective(0),
+      maxGradientNorm(0),
+      finalStepSize(0),
+      finalTime(0),
       objective(0),
       gradientNorm(0),
       hasGradient(false),
@@ -45,7 +64,16 @@ class Report
       gradientCalls(0),
       evaluateCalls(0),
       epochCalls(0)
-  { /* Nothing to do here. */ }
+  {
+#if defined(ENS_TRACK_ALLOCATIONS)
+    allocCount0 = allocBytes0 = 0;
+    allocCountMark = allocBytesMark = 0;
+    firstStepAllocCount = firstStepAllocBytes = 0;
+    laterStepAllocCount = laterStepAllocBytes = 0;
+    stepsWithAllocations = 0;
+    firstStepSeen = false;
+#endif
+  }
 
   /**
    * Callback function called at the begin of the optimization process.
@@ -61,6 +89,13 @@ class Report
   {
     initialCoordinates = coordinates;
     optimizationTimer.tic();
+
+#if defined(ENS_TRACK_ALLOCATIONS)
+    // Snapshot the process-wide allocation counters, so only allocations made
+    // during this optimization are reported.
+    allocCount0 = allocCountMark = AllocationTracker::Count();
+    allocBytes0 = allocBytesMark = AllocationTracker::Bytes();
+#endif
   }
 
   /**
@@ -115,7 +150,7 @@ class Report
 
     for (size_t i = 0; i < objectives.size(); i += iterationStep)
     {
-      PrettyPrintElement(i);
+      PrettyPrintElement(i * sampleStride);
       PrettyPrintElement(objectives[i]);
       PrettyPrintElement(
           i > 0 ? objectives[i - iterationStep] - objectives[i] : 0);
@@ -152,11 +187,11 @@ class Report
 
     // If we did not take any steps, at least fill what the initial objective
     // was.
-    const bool tookStep = (objectives.size() > 0);
-    if (objectives.size() == 0 && evaluateCalls > 0)
+    const bool tookStep = (stepCount > 0);
+    if (stepCount == 0 && evaluateCalls > 0)
     {
-      objectives.push_back(objective);
-      timings.push_back(optimizationTimer.toc());
+      initialObjective = finalObjective = objective;
+      finalTime = optimizationTimer.toc();
     }
     else if (evaluateCalls == 0)
     {
@@ -172,11 +207,11 @@ class Report
 
     output << "Loss:" << std::endl;
     PrettyPrintElement("Initial", 30);
-    output << objectives[0] << std::endl;
+    output << initialObjective << std::endl;
     PrettyPrintElement("Final", 30);
-    output << objectives[objectives.size() - 1] << std::endl;
+    output << finalObjective << std::endl;
     PrettyPrintElement("Change", 30);
-    output << objectives[0] - objectives[objectives.size() - 1] << std::endl;
+    output << initialObjective - finalObjective << std::endl;
 
     output << std::endl << "Optimizer:" << std::endl;
     std::stringstream optimizerStream;
@@ -188,7 +223,7 @@ class Report
 
     PrettyPrintElement("Iterations:", 30);
     if (tookStep)
-      output << objectives.size() << std::endl;
+      output << stepCount << std::endl;
     else
       output << "0 (No steps taken! Did the optimization fail?)" << std::endl;
 
@@ -204,14 +239,13 @@ class Report
       output << stepsizes.front() << std::endl;
 
       PrettyPrintElement("Final step size:", 30);
-      output << stepsizes.back() << std::endl;
+      output << finalStepSize << std::endl;
     }
 
-    if (hasGradient && gradientsNorm.size() > 0)
+    if (hasGradient && stepCount > 0)
     {
       PrettyPrintElement("Coordinates max. norm:", 30);
-      output << *std::max_element(std::begin(gradientsNorm),
-          std::end(gradientsNorm)) << std::endl;
+      output << maxGradientNorm << std::endl;
     }
 
     PrettyPrintElement("Evaluate calls:", 30);
@@ -223,8 +257,25 @@ class Report
       output << gradientCalls << std::endl;
     }
 
+#if defined(ENS_TRACK_ALLOCATIONS)
+    output << std::endl << "Allocations:" << std::endl;
+    PrettyPrintElement("Total (count / bytes):", 30);
+    output << (AllocationTracker::Count() - allocCount0) << " / "
+        << (AllocationTracker::Bytes() - allocBytes0) << std::endl;
+    PrettyPrintElement("First step (incl. setup):", 30);
+    output << firstStepAllocCount << " / " << firstStepAllocBytes << std::endl;
+    PrettyPrintElement("Later steps:", 30);
+    output << laterStepAllocCount << " / " << laterStepAllocBytes << std::endl;
+    if (stepCount > 1)
+    {
+      PrettyPrintElement("Steps with allocations:", 30);
+      output << stepsWithAllocations << " of " << (stepCount - 1)
+          << std::endl;
+    }
+#endif
+
     PrettyPrintElement("Time (in seconds):", 30);
-    output << timings[timings.size() - 1] << std::endl;
+    output << finalTime << std::endl;
 
     // Restore precision.
     output.precision(streamPrecision);
@@ -275,15 +326,12 @@ class Report
       timings.clear();
       gradientsNorm.clear();
       stepsizes.clear();
+      stepCount = 0;
+      sampleStride = 1;
+      maxGradientNorm = 0;
     }
 
-    objectives.push_back(objective);
-    timings.push_back(optimizationTimer.toc());
-
-    if (hasGradient)
-      gradientsNorm.push_back(gradientNorm);
-
-    SaveStepSize(optimizer);
+    RecordStep(optimizer, objective);
     return false;
   }
 
@@ -301,15 +349,31 @@ class Report
                  const MatType& /* coordinates */)
   {
     if (!hasEndEpoch)
+      RecordStep(optimizer, objective);
+
+#if defined(ENS_TRACK_ALLOCATIONS)
+    // Attribute the allocations since the last checkpoint to this step.  The
+    // first step also covers the optimizer's setup (buffer allocation etc.),
+    // so it is reported separately; a warm hot path should show zero
+    // allocations for every later step.
+    const size_t stepAllocCount = AllocationTracker::Count() - allocCountMark;
+    const size_t stepAllocBytes = AllocationTracker::Bytes() - allocBytesMark;
+    if (!firstStepSeen)
     {
-      objectives.push_back(objective);
-      timings.push_back(optimizationTimer.toc());
-
-      if (hasGradient)
-        gradientsNorm.push_back(gradientNorm);
-
-      SaveStepSize(optimizer);
+      firstStepAllocCount = stepAllocCount;
+      firstStepAllocBytes = stepAllocBytes;
+      firstStepSeen = true;
+    }
+    else
+    {
+      laterStepAllocCount += stepAllocCount;
+      laterStepAllocBytes += stepAllocBytes;
+      if (stepAllocCount > 0)
+        stepsWithAllocations++;
     }
+    allocCountMark += stepAllocCount;
+    allocBytesMark += stepAllocBytes;
+#endif
     return false;
   }
 
@@ -433,7 +497,7 @@ class Report
     stream << optimizer.MaxIterations() << std::endl;
 
     PrettyPrintElement(stream, "Reached maximum iterations:", 30);
-    stream << std::string(optimizer.MaxIterations() == objectives.size() ?
+    stream << std::string(optimizer.MaxIterations() == stepCount ?
         "true" : "false") << std::endl;
   }
 
@@ -568,6 +632,79 @@ class Report
       void>::type
   SaveStepSize(const OptimizerType& /* optimizer */) { }
 
+  /**
+   * Helper function to track the most recent step-size as a streaming value.
+   *
+   * @param optimizer The instantiated optimizer that implements StepSize().
+   */
+  template<typename OptimizerType>
+  typename std::enable_if<traits::HasStepSizeSignature<OptimizerType>::value,
+      void>::type
+  SaveFinalStepSize(const OptimizerType& optimizer)
+  {
+    finalStepSize = optimizer.StepSize();
+  }
+
+  template<typename OptimizerType>
+  typename std::enable_if<!traits::HasStepSizeSignature<OptimizerType>::value,
+      void>::type
+  SaveFinalStepSize(const OptimizerType& /* optimizer */) { }
+
+  /**
+   * Record one optimization step.  The streaming statistics are updated for
+   * every step; the table history only stores every sampleStride-th step,
+   * and whenever a buffer would outgrow historyCapacity, every other stored
+   * sample is dropped and the stride doubles.  The stored samples therefore
+   * stay evenly spaced over the whole run and the memory use is bounded
+   * regardless of the run length.
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param objectiveValue Objective value of the current step.
+   */
+  template<typename OptimizerType>
+  void RecordStep(const OptimizerType& optimizer, const double objectiveValue)
+  {
+    if (stepCount == 0)
+      initialObjective = objectiveValue;
+    finalObjective = objectiveValue;
+    finalTime = optimizationTimer.toc();
+    if (hasGradient)
+      maxGradientNorm = std::max(maxGradientNorm, gradientNorm);
+    SaveFinalStepSize(optimizer);
+
+    const bool sampled = (stepCount % sampleStride == 0);
+    ++stepCount;
+    if (!sampled)
+      return;
+
+    objectives.push_back(objectiveValue);
+    timings.push_back(finalTime);
+
+    if (hasGradient)
+      gradientsNorm.push_back(gradientNorm);
+
+    SaveStepSize(optimizer);
+
+    if (objectives.size() >= historyCapacity)
+    {
+      Decimate(objectives);
+      Decimate(timings);
+      Decimate(gradientsNorm);
+      Decimate(stepsizes);
+      sampleStride *= 2;
+    }
+  }
+
+  //! Drop every other element of the given history buffer, keeping the
+  //! samples at even positions.
+  static void Decimate(std::vector<double>& samples)
+  {
+    size_t kept = 0;
+    for (size_t i = 0; i < samples.size(); i += 2)
+      samples[kept++] = samples[i];
+    samples.resize(kept);
+  }
+
   //! The number of iterations to print in percent.
   double iterationsPercentage;
 
@@ -579,6 +716,23 @@ class Report
   //! The initial coordinates.
   arma::mat initialCoordinates;
 
+  //! Maximum number of history samples kept for the summary table.
+  size_t historyCapacity;
+
+  //! Every sampleStride-th step is recorded into the history buffers.
+  size_t sampleStride;
+
+  //! Total number of steps taken (the history is sampled, so the buffers do
+  //! not reflect this).
+  size_t stepCount;
+
+  //! Streaming statistics over all steps.
+  double initialObjective;
+  double finalObjective;
+  double maxGradientNorm;
+  double finalStepSize;
+  double finalTime;
+
   //! Gradient norm storage.
   std::vector<double> gradientsNorm;
 
@@ -612,6 +766,22 @@ class Report
   //! The number of BeginEpoch() calls.
   size_t epochCalls;
 
+#if defined(ENS_TRACK_ALLOCATIONS)
+  //! Allocation counter snapshots taken at the start of the optimization.
+  size_t allocCount0, allocBytes0;
+  //! Allocation counter checkpoints from the last step.
+  size_t allocCountMark, allocBytesMark;
+  //! Allocations attributed to the first step, which includes the
+  //! optimizer's setup.
+  size_t firstStepAllocCount, firstStepAllocBytes;
+  //! Allocations attributed to all later steps combined.
+  size_t laterStepAllocCount, laterStepAllocBytes;
+  //! The number of steps after the first that allocated at all.
+  size_t stepsWithAllocations;
+  //! Whether the first step has been seen yet.
+  bool firstStepSeen;
+#endif
+
   //! Locally-stored optimization step timer object.
   arma::wall_clock optimizationTimer;
 };
@@ -0,0 +1,191 @@
+/**
+ * @file smoothed_early_stop.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the smoothed early stopping callback function.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_CALLBACKS_SMOOTHED_EARLY_STOP_HPP
+#define ENSMALLEN_CALLBACKS_SMOOTHED_EARLY_STOP_HPP
+
+#include <functional>
+
+namespace ens {
+
+/**
+ * Early stopping on an exponential moving average of the loss.
+ *
+ * EarlyStopAtMinLoss compares raw epoch losses, so with noisy stochastic
+ * objectives a single lucky epoch postpones the stop and a single unlucky one
+ * can trigger it.  This callback smooths the loss with an exponential moving
+ * average before the comparison, requires a minimum improvement (minDelta)
+ * over the best smoothed loss to reset the patience counter, and can evaluate
+ * a user-supplied validation function on a fixed epoch schedule instead of
+ * the training objective.
+ */
+template<typename MatType = arma::mat>
+class SmoothedEarlyStopType
+{
+ public:
+  /**
+   * Set up the smoothed early stopping class, which tracks an exponential
+   * moving average of the training loss and stops the optimization process
+   * once it has not improved by at least minDelta for patience epochs.
+   *
+   * @param patience The number of epochs to wait after the minimum smoothed
+   *    loss has been reached (Default: 10).
+   * @param smoothing Weight of the newest loss in the moving average; 1 means
+   *    no smoothing (Default: 0.3).
+   * @param minDelta Minimum decrease of the smoothed loss that counts as an
+   *    improvement (Default: 0).
+   */
+  SmoothedEarlyStopType(const size_t patience = 10,
+                        const double smoothing = 0.3,
+                        const double minDelta = 0.0) :
+      callbackUsed(false),
+      patience(patience),
+      smoothing(smoothing),
+      minDelta(minDelta),
+      validationInterval(1),
+      smoothedObjective(0),
+      firstObjective(true),
+      bestObjective(std::numeric_limits<double>::max()),
+      steps(0)
+  { /* Nothing to do here */ }
+
+  /**
+   * Set up the smoothed early stopping class with a validation function; the
+   * function is evaluated every validationInterval epochs and its smoothed
+   * value is used for the stopping decision.
+   *
+   * @param func Callback to return the validation loss for the given
+   *    coordinates.
+   * @param patience The number of evaluations to wait after the minimum
+   *    smoothed loss has been reached (Default: 10).
+   * @param smoothing Weight of the newest loss in the moving average
+   *    (Default: 0.3).
+   * @param minDelta Minimum decrease of the smoothed loss that counts as an
+   *    improvement (Default: 0).
+   * @param validationInterval Evaluate the validation function only every
+   *    validationInterval epochs (Default: 1).
+   */
+  SmoothedEarlyStopType(std::function<double(const MatType&)> func,
+                        const size_t patience = 10,
+                        const double smoothing = 0.3,
+                        const double minDelta = 0.0,
+                        const size_t validationInterval = 1) :
+      callbackUsed(true),
+      patience(patience),
+      smoothing(smoothing),
+      minDelta(minDelta),
+      validationInterval(validationInterval),
+      smoothedObjective(0),
+      firstObjective(true),
+      bestObjective(std::numeric_limits<double>::max()),
+      steps(0),
+      localFunc(func)
+  { /* Nothing to do here */ }
+
+  /**
+   * Callback function called at the end of a pass over the data.
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Starting point.
+   * @param epoch The index of the current epoch.
+   * @param objective Objective value of the current point.
+   */
+  template<typename OptimizerType, typename FunctionType>
+  bool EndEpoch(OptimizerType& /* optimizer */,
+                FunctionType& /* function */,
+                const MatType& coordinates,
+                const size_t epoch,
+                double objective)
+  {
+    if (callbackUsed)
+    {
+      // Off-schedule epochs neither evaluate the validation function nor
+      // advance the patience counter.
+      if (epoch % validationInterval != 0)
+        return false;
+
+      objective = localFunc(coordinates);
+    }
+
+    // Fold the new loss into the moving average.
+    if (firstObjective)
+    {
+      smoothedObjective = objective;
+      firstObjective = false;
+    }
+    else
+    {
+      smoothedObjective += smoothing * (objective - smoothedObjective);
+    }
+
+    if (smoothedObjective < bestObjective - minDelta)
+    {
+      steps = 0;
+      bestObjective = smoothedObjective;
+      return false;
+    }
+
+    steps++;
+    if (steps >= patience)
+    {
+      Info << "Smoothed loss stopped improving; terminate optimization."
+          << std::endl;
+      return true;
+    }
+
+    return false;
+  }
+
+  //! Get the current smoothed objective.
+  double SmoothedObjective() const { return smoothedObjective; }
+
+  //! Get the best smoothed objective seen so far.
+  double BestObjective() const { return bestObjective; }
+
+ private:
+  //! False if the first constructor is called, true if the user passed a
+  //! lambda.
+  bool callbackUsed;
+
+  //! The number of epochs to wait before terminating the optimization process.
+  size_t patience;
+
+  //! Weight of the newest loss in the moving average.
+  double smoothing;
+
+  //! Minimum decrease of the smoothed loss that counts as an improvement.
+  double minDelta;
+
+  //! Evaluate the validation function only every validationInterval epochs.
+  size_t validationInterval;
+
+  //! Locally-stored smoothed objective.
+  double smoothedObjective;
+
+  //! True until the first loss has been folded into the moving average.
+  bool firstObjective;
+
+  //! Locally-stored best smoothed objective.
+  double bestObjective;
+
+  //! Locally-stored number of steps since the smoothed loss improved.
+  size_t steps;
+
+  //! Function to call at the end of the epoch.
+  std::function<double(const MatType&)> localFunc;
+};
+
+using SmoothedEarlyStop = SmoothedEarlyStopType<arma::mat>;
+
+} // namespace ens
+
+#endif
@@ -17,6 +17,13 @@ namespace ens {
 /**
  * Store best coordinates function, based on the Evaluate callback function.
  *
+ * During early optimization nearly every evaluation improves the objective,
+ * so copying the coordinates on every improvement can dominate the step time
+ * for large models.  The copy policy can therefore be relaxed: a relative
+ * improvement threshold skips copies for insignificant improvements, and a
+ * copy interval copies only every N-th significant improvement.  With the
+ * default settings every improvement is copied, as before.
+ *
  * @tparam MatType Type of the model coordinates (arma::colvec, arma::mat,
  *     arma::sp_mat or arma::cube).
  */
@@ -27,8 +34,19 @@ class StoreBestCoordinates
   /**
    * Set up the store best model class, which keeps the best-performing
    * coordinates and objective.
+   *
+   * @param relativeTolerance Minimum relative improvement over the stored
+   *     objective before the coordinates are copied again (0 copies on every
+   *     improvement).
+   * @param copyInterval Copy only every copyInterval-th significant
+   *     improvement (1 copies every significant improvement).
    */
-  StoreBestCoordinates() : bestObjective(std::numeric_limits<double>::max())
+  StoreBestCoordinates(const double relativeTolerance = 0.0,
+                       const size_t copyInterval = 1) :
+      relativeTolerance(relativeTolerance),
+      copyInterval(copyInterval),
+      bestObjective(std::numeric_limits<double>::max()),
+      improvements(0)
   { /* Nothing to do here. */ }
 
   /**
@@ -45,14 +63,47 @@ class StoreBestCoordinates
                 const MatType& coordinates,
                 const double objective)
   {
-    if (objective < bestObjective)
+    if (objective >= bestObjective)
+      return false;
+
+    // Always capture the first candidate, so BestCoordinates() is never
+    // empty.
+    if (bestObjective == std::numeric_limits<double>::max())
     {
       bestObjective = objective;
       bestCoordinates = coordinates;
+      return false;
     }
+
+    // Skip the copy if the improvement over the stored coordinates is not
+    // significant.
+    if ((bestObjective - objective) <
+        relativeTolerance * std::abs(bestObjective))
+      return false;
+
+    // Only every copyInterval-th significant improvement is copied.
+    if (++improvements % copyInterval != 0)
+      return false;
+
+    bestObjective = objective;
+    // If the dimensions have not changed, this assignment reuses the existing
+    // allocation, so repeated copies (and repeated Optimize() calls with the
+    // same model) do not reallocate.
+    bestCoordinates = coordinates;
     return false;
   }
 
+  /**
+   * Forget the stored objective so the callback can be reused for another
+   * Optimize() call; the coordinate buffer is kept, so tracking a model of
+   * the same size does not reallocate.
+   */
+  void Reset()
+  {
+    bestObjective = std::numeric_limits<double>::max();
+    improvements = 0;
+  }
+
   //! Get the best coordinates.
   ModelMatType const& BestCoordinates() const { return bestCoordinates; }
   //! Modify the best coordinates.
@@ -63,10 +114,29 @@ class StoreBestCoordinates
   //! Modify the best objective.
   double& BestObjective() { return bestObjective; }
 
+  //! Get the relative improvement required before a copy is made.
+  double RelativeTolerance() const { return relativeTolerance; }
+  //! Modify the relative improvement required before a copy is made.
+  double& RelativeTolerance() { return relativeTolerance; }
+
+  //! Get the number of significant improvements between copies.
+  size_t CopyInterval() const { return copyInterval; }
+  //! Modify the number of significant improvements between copies.
+  size_t& CopyInterval() { return copyInterval; }
+
  private:
+  //! Minimum relative improvement before the coordinates are copied again.
+  double relativeTolerance;
+
+  //! Copy only every copyInterval-th significant improvement.
+  size_t copyInterval;
+
   //! Locally-stored best objective.
   double bestObjective;
 
+  //! Number of significant improvements seen so far.
+  size_t improvements;
+
   //! Locally-stored best model coordinates.
   ModelMatType bestCoordinates;
 };
@@ -12,11 +12,17 @@
 #ifndef ENSMALLEN_CALLBACKS_TIMER_STOP_HPP
 #define ENSMALLEN_CALLBACKS_TIMER_STOP_HPP
 
+#include <ensmallen_bits/utility/coarse_clock.hpp>
+
 namespace ens {
 
 /**
  * Timer stop function, is based on the BeginOptimization callback function to
  * start the timer and the EndEpoch callback function to update the timer.
+ *
+ * The elapsed time is read from the process-wide CoarseClock, so each check
+ * costs one relaxed atomic load instead of a clock syscall; the timeout is
+ * therefore enforced at the clock's tick resolution (one millisecond).
  */
 class TimerStop
 {
@@ -26,7 +32,7 @@ class TimerStop
    *
    * @param durationIn The duration of the timer in seconds.
    */
-  TimerStop(const double durationIn) : duration(durationIn)
+  TimerStop(const double durationIn) : duration(durationIn), startTime(0)
   { /* Nothing to do here. */ }
 
   /**
@@ -42,7 +48,7 @@ class TimerStop
                          MatType& /* coordinates */)
   {
     // Start the timer.
-    timer.tic();
+    startTime = CoarseClock::Get().Now();
   }
 
   /**
@@ -61,7 +67,7 @@ class TimerStop
                 const size_t /* epoch */,
                 const double /* objective */)
   {
-    if (timer.toc() > duration)
+    if (CoarseClock::Get().Now() - startTime > duration)
     {
       Info << "Timer timeout reached; terminate optimization." << std::endl;
       return true;
@@ -74,8 +80,8 @@ class TimerStop
   //! The duration in seconds.
   double duration;
 
-  //! Locally-stored timer object.
-  arma::wall_clock timer;
+  //! Coarse-clock reading taken at the start of the optimization.
+  double startTime;
 };
 
 } // namespace ens
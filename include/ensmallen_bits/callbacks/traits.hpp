@@ -538,6 +538,60 @@ template<typename CallbackType,
         FunctionType, MatType, ObjectivesVecType, IndicesType>::
         template GenerationalStepTakenVoidForm>::value;
 };
+/**
+ * Compile-time OR over a pack of boolean values.
+ */
+template<bool... Values>
+struct StaticAny : std::false_type { };
+
+template<bool... Values>
+struct StaticAny<true, Values...> : std::true_type { };
+
+template<bool... Values>
+struct StaticAny<false, Values...> : StaticAny<Values...> { };
+
+//! These aggregate traits detect whether any callback in a pack implements a
+//! given event.  The Callback dispatchers use them to replace the whole
+//! dispatch with an empty inline stub when no callback cares about an event,
+//! so hot optimizer loops carry no callback machinery at all in that case.
+
+template<typename OptimizerType,
+         typename FunctionType,
+         typename MatType,
+         typename... CallbackTypes>
+struct AnyHasEvaluate : StaticAny<!HasEvaluateSignature<
+    CallbackTypes, OptimizerType, FunctionType, MatType>::hasNone...> { };
+
+template<typename OptimizerType,
+         typename FunctionType,
+         typename MatType,
+         typename GradType,
+         typename... CallbackTypes>
+struct AnyHasGradient : StaticAny<!HasGradientSignature<
+    CallbackTypes, OptimizerType, FunctionType, MatType,
+    GradType>::hasNone...> { };
+
+template<typename OptimizerType,
+         typename FunctionType,
+         typename MatType,
+         typename... CallbackTypes>
+struct AnyHasBeginEpoch : StaticAny<!HasBeginEpochSignature<
+    CallbackTypes, OptimizerType, FunctionType, MatType>::hasNone...> { };
+
+template<typename OptimizerType,
+         typename FunctionType,
+         typename MatType,
+         typename... CallbackTypes>
+struct AnyHasEndEpoch : StaticAny<!HasEndEpochSignature<
+    CallbackTypes, OptimizerType, FunctionType, MatType>::hasNone...> { };
+
+template<typename OptimizerType,
+         typename FunctionType,
+         typename MatType,
+         typename... CallbackTypes>
+struct AnyHasStepTaken : StaticAny<!HasStepTakenSignature<
+    CallbackTypes, OptimizerType, FunctionType, MatType>::hasNone...> { };
+
 } // namespace traits
 } // namespace callbacks
 } // namespace ens
@@ -0,0 +1,408 @@
+/**
+ * @file trajectory_recorder.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the trajectory recorder callback, which appends
+ * fixed-size binary records into a memory-mapped ring file on every step,
+ * for offline convergence analysis at full optimizer rate.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_CALLBACKS_TRAJECTORY_RECORDER_HPP
+#define ENSMALLEN_CALLBACKS_TRAJECTORY_RECORDER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+
+#if !defined(_WIN32)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <unistd.h>
+#endif
+
+namespace ens {
+
+/**
+ * Trajectory recorder callback that appends one fixed-size binary record per
+ * step (iteration, objective, step size, gradient norm, elapsed time) into a
+ * memory-mapped ring file.  Appending is a struct store and a counter
+ * increment into the mapping -- no formatting, no system calls, and no
+ * locking on the hot path (the optimizer is the only writer) -- so recording
+ * keeps up with millions of steps per second; the kernel writes dirty pages
+ * back in the background.  When the ring wraps, the oldest records are
+ * overwritten, so the file size is fixed up front.
+ *
+ * The recorded objective and gradient norm are those of the most recent
+ * Evaluate() / Gradient() event before each step, matching what the
+ * optimizer itself computed for that step.  Use TrajectoryReader to load a
+ * recorded file back in chronological order.
+ *
+ * On platforms without POSIX memory mapping the records are kept in an
+ * in-memory ring and written out at the end of the optimization, which
+ * preserves the interface and the file format but not the live-file
+ * property.
+ */
+class TrajectoryRecorder
+{
+ public:
+  //! One recorded step; the on-disk format is this struct, unpadded on all
+  //! supported platforms (five 8-byte fields).
+  struct Record
+  {
+    //! Step counter, starting at 1.
+    std::uint64_t iteration;
+    //! Objective of the most recent Evaluate() before the step.
+    double objective;
+    //! The optimizer's step size (0 if the optimizer has no StepSize()).
+    double stepSize;
+    //! Euclidean norm of the most recent gradient before the step.
+    double gradientNorm;
+    //! Seconds since the start of the optimization (steady clock).
+    double seconds;
+  };
+
+  //! The file header preceding the ring of records.
+  struct Header
+  {
+    //! Identifies the format ("ens_trj1").
+    std::uint64_t magic;
+    //! Number of record slots in the ring.
+    std::uint64_t capacity;
+    //! Total number of records ever appended; the ring holds the last
+    //! min(written, capacity) of them.
+    std::uint64_t written;
+  };
+
+  //! The expected header magic value ("ens_trj1", little-endian).
+  static const std::uint64_t formatMagic = 0x316A72745F736E65ull;
+
+  /**
+   * Set up the trajectory recorder callback.
+   *
+   * @param filename File to hold the ring of records (created or truncated
+   *     at the start of the optimization).
+   * @param capacity Number of record slots in the ring; once exceeded, the
+   *     oldest records are overwritten.
+   */
+  TrajectoryRecorder(const std::string& filename,
+                     const size_t capacity = 1048576) :
+      filename(filename),
+      capacity(capacity),
+      mapping(NULL),
+      mappingLength(0),
+      header(NULL),
+      records(NULL),
+      iteration(0),
+      lastObjective(0.0),
+      lastGradientNorm(0.0)
+  { /* Nothing to do here. */ }
+
+  //! The mapping is owned by this instance, so the class is not copyable.
+  TrajectoryRecorder(const TrajectoryRecorder&) = delete;
+  //! The mapping is owned by this instance, so the class is not assignable.
+  TrajectoryRecorder& operator=(const TrajectoryRecorder&) = delete;
+
+  //! Unmap the ring file if the optimization did not end cleanly.
+  ~TrajectoryRecorder()
+  {
+    Unmap();
+  }
+
+  /**
+   * Callback function called at the start of the optimization process;
+   * creates and maps the ring file.
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Starting point.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  void BeginOptimization(OptimizerType& /* optimizer */,
+                         FunctionType& /* function */,
+                         MatType& /* coordinates */)
+  {
+    Map();
+    iteration = 0;
+    lastObjective = 0.0;
+    lastGradientNorm = 0.0;
+    start = std::chrono::steady_clock::now();
+  }
+
+  /**
+   * Callback function called at the end of the optimization process; flushes
+   * and unmaps the ring file.
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Final point.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  void EndOptimization(OptimizerType& /* optimizer */,
+                       FunctionType& /* function */,
+                       MatType& /* coordinates */)
+  {
+    Unmap();
+  }
+
+  /**
+   * Callback function called after any call to Evaluate().
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Current point.
+   * @param objective Objective value of the current point.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  void Evaluate(OptimizerType& /* optimizer */,
+                FunctionType& /* function */,
+                const MatType& /* coordinates */,
+                const double objective)
+  {
+    lastObjective = objective;
+  }
+
+  /**
+   * Callback function called after any call to Gradient().
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Current point.
+   * @param gradient Matrix that holds the gradient.
+   */
+  template<typename OptimizerType,
+           typename FunctionType,
+           typename MatType,
+           typename GradType>
+  void Gradient(OptimizerType& /* optimizer */,
+                FunctionType& /* function */,
+                const MatType& /* coordinates */,
+                const GradType& gradient)
+  {
+    lastGradientNorm = (double) arma::norm(arma::vectorise(gradient), 2);
+  }
+
+  /**
+   * Callback function called after any step is taken; appends one record to
+   * the ring.
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Current point.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  void StepTaken(OptimizerType& optimizer,
+                 FunctionType& /* function */,
+                 const MatType& /* coordinates */)
+  {
+    Record record;
+    record.iteration = ++iteration;
+    record.objective = lastObjective;
+    record.stepSize = StepSizeOf(optimizer, 0);
+    record.gradientNorm = lastGradientNorm;
+    record.seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+#if !defined(_WIN32)
+    if (header == NULL)
+      return;
+
+    records[header->written % header->capacity] = record;
+    // Single writer: a plain increment is enough, and a concurrent reader
+    // sees at worst one in-flight slot.
+    ++header->written;
+#else
+    ring[written % capacity] = record;
+    ++written;
+#endif
+  }
+
+  //! Get the name of the ring file.
+  const std::string& Filename() const { return filename; }
+
+  //! Get the number of record slots in the ring.
+  size_t Capacity() const { return capacity; }
+
+ private:
+  //! Prefer the optimizer's StepSize() accessor when it has one...
+  template<typename OptimizerType>
+  static auto StepSizeOf(const OptimizerType& optimizer, int)
+      -> decltype((double) optimizer.StepSize())
+  {
+    return optimizer.StepSize();
+  }
+
+  //! ...and record zero for optimizers without a step size.
+  template<typename OptimizerType>
+  static double StepSizeOf(const OptimizerType& /* optimizer */, long)
+  {
+    return 0.0;
+  }
+
+  //! Create the ring file and map it into memory.
+  void Map()
+  {
+#if !defined(_WIN32)
+    Unmap();
+
+    const int fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+      throw std::runtime_error("TrajectoryRecorder: cannot open file '" +
+          filename + "'!");
+    }
+
+    mappingLength = sizeof(Header) + capacity * sizeof(Record);
+    if (ftruncate(fd, mappingLength) != 0)
+    {
+      close(fd);
+      throw std::runtime_error("TrajectoryRecorder: cannot size file '" +
+          filename + "'!");
+    }
+
+    mapping = mmap(NULL, mappingLength, PROT_READ | PROT_WRITE, MAP_SHARED,
+        fd, 0);
+    // The mapping keeps its own reference to the file.
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+      mapping = NULL;
+      throw std::runtime_error("TrajectoryRecorder: cannot map file '" +
+          filename + "'!");
+    }
+
+    header = (Header*) mapping;
+    records = (Record*) ((char*) mapping + sizeof(Header));
+    header->magic = formatMagic;
+    header->capacity = capacity;
+    header->written = 0;
+#else
+    ring.assign(capacity, Record());
+    written = 0;
+#endif
+  }
+
+  //! Flush and unmap the ring file (write it out, on the fallback path).
+  void Unmap()
+  {
+#if !defined(_WIN32)
+    if (mapping != NULL)
+    {
+      msync(mapping, mappingLength, MS_ASYNC);
+      munmap(mapping, mappingLength);
+    }
+    mapping = NULL;
+    header = NULL;
+    records = NULL;
+#else
+    if (!ring.empty())
+    {
+      std::ofstream stream(filename.c_str(), std::ios::binary);
+      Header header;
+      header.magic = formatMagic;
+      header.capacity = capacity;
+      header.written = written;
+      stream.write((const char*) &header, sizeof(Header));
+      stream.write((const char*) ring.data(), capacity * sizeof(Record));
+      ring.clear();
+    }
+#endif
+  }
+
+  //! The name of the ring file.
+  std::string filename;
+  //! The number of record slots in the ring.
+  size_t capacity;
+
+  //! The raw file mapping (NULL when not mapped).
+  void* mapping;
+  //! The length of the mapping in bytes.
+  size_t mappingLength;
+  //! The header at the start of the mapping.
+  Header* header;
+  //! The ring of records following the header.
+  Record* records;
+
+#if defined(_WIN32)
+  //! In-memory ring used on platforms without POSIX memory mapping.
+  std::vector<Record> ring;
+  //! Total number of records appended to the in-memory ring.
+  std::uint64_t written;
+#endif
+
+  //! Step counter.
+  std::uint64_t iteration;
+  //! Objective of the most recent Evaluate() event.
+  double lastObjective;
+  //! Norm of the most recent gradient.
+  double lastGradientNorm;
+  //! Time of the start of the optimization.
+  std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * Reader for files written by TrajectoryRecorder: loads the ring back into
+ * memory and presents the surviving records in chronological order.
+ */
+class TrajectoryReader
+{
+ public:
+  /**
+   * Load the given trajectory file.
+   *
+   * @param filename File written by TrajectoryRecorder.
+   */
+  TrajectoryReader(const std::string& filename) : totalWritten(0)
+  {
+    std::ifstream stream(filename.c_str(), std::ios::binary);
+    if (!stream.good())
+    {
+      throw std::runtime_error("TrajectoryReader: cannot open file '" +
+          filename + "'!");
+    }
+
+    TrajectoryRecorder::Header header;
+    stream.read((char*) &header, sizeof(header));
+    if ((size_t) stream.gcount() < sizeof(header) ||
+        header.magic != TrajectoryRecorder::formatMagic)
+    {
+      throw std::runtime_error("TrajectoryReader: file '" + filename +
+          "' is not a trajectory ring file!");
+    }
+
+    std::vector<TrajectoryRecorder::Record> ring(header.capacity);
+    stream.read((char*) ring.data(),
+        header.capacity * sizeof(TrajectoryRecorder::Record));
+
+    // The ring holds the last min(written, capacity) records; the oldest
+    // surviving record sits at slot (written - count) % capacity.
+    totalWritten = header.written;
+    const std::uint64_t count = std::min(header.written, header.capacity);
+    records.reserve(count);
+    for (std::uint64_t k = 0; k < count; ++k)
+      records.push_back(ring[(header.written - count + k) % header.capacity]);
+  }
+
+  //! Get the surviving records, oldest first.
+  const std::vector<TrajectoryRecorder::Record>& Records() const
+  {
+    return records;
+  }
+
+  //! Get the total number of records ever appended (including overwritten
+  //! ones).
+  std::uint64_t TotalWritten() const { return totalWritten; }
+
+ private:
+  //! The surviving records, oldest first.
+  std::vector<TrajectoryRecorder::Record> records;
+  //! The total number of records ever appended.
+  std::uint64_t totalWritten;
+};
+
+} // namespace ens
+
+#endif
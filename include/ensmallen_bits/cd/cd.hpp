@@ -15,6 +15,7 @@
 #include "descent_policies/cyclic_descent.hpp"
 #include "descent_policies/random_descent.hpp"
 #include "descent_policies/greedy_descent.hpp"
+#include "descent_policies/lazy_greedy_descent.hpp"
 
 namespace ens {
 
@@ -69,12 +70,18 @@ class CD
    *    reported and checked for convergence.
    * @param descentPolicy The policy to use for picking up the coordinate to
    *    descend on.
+   * @param blockSize Number of coordinates to select and update per
+   *    iteration.  When larger than 1, the block partials are all computed at
+   *    the current iterate before any coordinate is updated, and functions
+   *    providing a batched PartialGradient() overload (taking an arma::uvec
+   *    of feature indices) can share one residual pass across the block.
    */
   CD(const double stepSize = 0.01,
      const size_t maxIterations = 100000,
      const double tolerance = 1e-5,
      const size_t updateInterval = 1e3,
-     const DescentPolicyType descentPolicy = DescentPolicyType());
+     const DescentPolicyType descentPolicy = DescentPolicyType(),
+     const size_t blockSize = 1);
 
   /**
    * Optimize the given function using stochastic coordinate descent. The
@@ -138,6 +145,33 @@ class CD
   //! Modify the descent policy.
   DescentPolicyType& DescentPolicy() { return descentPolicy; }
 
+  //! Get the number of coordinates updated per iteration.
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of coordinates updated per iteration.
+  size_t& BlockSize() { return blockSize; }
+
+  //! Get whether shotgun-style parallel updates are enabled.
+  bool Shotgun() const { return shotgun; }
+  //! Modify whether shotgun-style parallel updates are enabled.  When
+  //! enabled (and BlockSize() is 1), every iteration runs one shotgun
+  //! round: ShotgunThreads() coordinates are chosen independently by
+  //! per-thread copies of the descent policy and updated concurrently,
+  //! with writes to the shared iterate made atomically (Bradley et al.,
+  //! "Parallel coordinate descent for L1-regularized loss minimization",
+  //! 2011).  Without OpenMP the rounds degenerate to sequential updates.
+  bool& Shotgun() { return shotgun; }
+
+  //! Get the number of concurrent updates per shotgun round (0 uses the
+  //! library-wide thread count).
+  size_t ShotgunThreads() const { return shotgunThreads; }
+  //! Modify the number of concurrent updates per shotgun round.
+  //! Convergence is only guaranteed up to a problem-dependent level of
+  //! parallelism (about NumFeatures() / rho for a data matrix whose Gram
+  //! matrix has spectral radius rho); callers with an estimate of rho
+  //! should set this accordingly, as the automatic default only caps the
+  //! round at the feature count.
+  size_t& ShotgunThreads() { return shotgunThreads; }
+
  private:
   //! The step size for each example.
   double stepSize;
@@ -153,6 +187,16 @@ class CD
 
   //! The descent policy used to pick the coordinates for the update.
   DescentPolicyType descentPolicy;
+
+  //! The number of coordinates selected and updated per iteration.
+  size_t blockSize;
+
+  //! Whether shotgun-style parallel updates are enabled.
+  bool shotgun;
+
+  //! The number of concurrent updates per shotgun round (0 uses the
+  //! library-wide thread count).
+  size_t shotgunThreads;
 };
 
 } // namespace ens
@@ -174,6 +218,7 @@ using SCD = CD<DescentPolicyType>;
 // Convenience typedefs.
 using RandomCD = CD<RandomDescent>;
 using GreedyCD = CD<GreedyDescent>;
+using LazyGreedyCD = CD<LazyGreedyDescent>;
 using CyclicCD = CD<CyclicDescent>;
 
 } // namespace ens
@@ -19,18 +19,91 @@
 
 namespace ens {
 
+// Utility function to compute the partial gradient of a block of coordinates.
+// If the function provides a batched PartialGradient() overload taking the
+// whole block, use it: the function can then share one pass over the data
+// (e.g. a vector of residuals) across all of the coordinates in the block.
+template<typename FunctionType, typename MatType, typename GradType>
+inline typename std::enable_if<
+    traits::HasPartialGradient<FunctionType,
+        traits::TypedForms<MatType, GradType>::template
+            BlockPartialGradientForm>::value ||
+    traits::HasPartialGradient<FunctionType,
+        traits::TypedForms<MatType, GradType>::template
+            BlockPartialGradientConstForm>::value, void>::type
+BlockPartialGradient(FunctionType& function,
+                     const MatType& iterate,
+                     const arma::uvec& block,
+                     GradType& gradient)
+{
+  function.PartialGradient(iterate, block, gradient);
+}
+
+// Otherwise, fall back to one PartialGradient() call per coordinate.
+template<typename FunctionType, typename MatType, typename GradType>
+inline typename std::enable_if<
+    !(traits::HasPartialGradient<FunctionType,
+        traits::TypedForms<MatType, GradType>::template
+            BlockPartialGradientForm>::value ||
+      traits::HasPartialGradient<FunctionType,
+        traits::TypedForms<MatType, GradType>::template
+            BlockPartialGradientConstForm>::value), void>::type
+BlockPartialGradient(FunctionType& function,
+                     const MatType& iterate,
+                     const arma::uvec& block,
+                     GradType& gradient)
+{
+  GradType featureGradient;
+  gradient.zeros(iterate.n_rows, iterate.n_cols);
+  for (size_t b = 0; b < block.n_elem; ++b)
+  {
+    function.PartialGradient(iterate, block(b), featureGradient);
+    gradient.col(block(b)) = featureGradient.col(block(b));
+  }
+}
+
+// Utility function to atomically update one element of a dense iterate
+// during a shotgun round.
+template<typename MatType>
+inline void ShotgunUpdateLocation(MatType& iterate,
+                                  const size_t row,
+                                  const size_t col,
+                                  const typename MatType::elem_type value)
+{
+  ENS_PRAGMA_OMP_ATOMIC
+  iterate(row, col) -= value;
+}
+
+// Updating a sparse iterate may mutate shared structure, so it takes a
+// critical section instead of an atomic element update.
+template<typename eT>
+inline void ShotgunUpdateLocation(arma::SpMat<eT>& iterate,
+                                  const size_t row,
+                                  const size_t col,
+                                  const eT value)
+{
+  ENS_PRAGMA_OMP_CRITICAL_NAMED
+  {
+    iterate(row, col) -= value;
+  }
+}
+
 template <typename DescentPolicyType>
 CD<DescentPolicyType>::CD(
     const double stepSize,
     const size_t maxIterations,
     const double tolerance,
     const size_t updateInterval,
-    const DescentPolicyType descentPolicy) :
+    const DescentPolicyType descentPolicy,
+    const size_t blockSize) :
     stepSize(stepSize),
     maxIterations(maxIterations),
     tolerance(tolerance),
     updateInterval(updateInterval),
-    descentPolicy(descentPolicy)
+    descentPolicy(descentPolicy),
+    blockSize(blockSize),
+    shotgun(false),
+    shotgunThreads(0)
 { /* Nothing to do */ }
 
 //! Optimize the function (minimize).
@@ -70,21 +143,102 @@ CD<DescentPolicyType>::Optimize(
   Callback::BeginOptimization(*this, function, iterate, callbacks...);
   for (size_t i = 1; i != maxIterations && !terminate; ++i)
   {
-    // Get the coordinate to descend on.
-    size_t featureIdx = descentPolicy.template DescentFeature<
-        ResolvableFunctionType, BaseMatType, BaseGradType>(i, iterate,
-        function);
+    if (blockSize > 1)
+    {
+      // Select a block of distinct coordinates; each slot advances the
+      // descent policy by one virtual iteration, so that a cyclic policy
+      // yields consecutive coordinates.
+      arma::uvec block(blockSize);
+      size_t numSelected = 0;
+      for (size_t b = 0; b < blockSize; ++b)
+      {
+        const size_t featureIdx = descentPolicy.template DescentFeature<
+            ResolvableFunctionType, BaseMatType, BaseGradType>(
+            (i - 1) * blockSize + b + 1, iterate, function);
 
-    // Get the partial gradient with respect to this feature.
-    function.PartialGradient(iterate, featureIdx, gradient);
+        bool duplicate = false;
+        for (size_t s = 0; s < numSelected; ++s)
+        {
+          if (block(s) == featureIdx)
+          {
+            duplicate = true;
+            break;
+          }
+        }
 
-    terminate |= Callback::Gradient(*this, function, iterate, overallObjective,
-        gradient, callbacks...);
-    if (terminate)
-      break;
+        if (!duplicate)
+          block(numSelected++) = featureIdx;
+      }
+      block.resize(numSelected);
+
+      // All of the block partials are computed at the current iterate before
+      // any coordinate is updated.
+      BlockPartialGradient(function, iterate, block, gradient);
+
+      terminate |= Callback::Gradient(*this, function, iterate,
+          overallObjective, gradient, callbacks...);
+      if (terminate)
+        break;
+
+      // Update the decision variable with the block partial gradient.
+      for (size_t b = 0; b < numSelected; ++b)
+        iterate.col(block(b)) -= stepSize * gradient.col(block(b));
+    }
+    else if (shotgun)
+    {
+      // One shotgun round: several coordinates are chosen independently by
+      // per-thread copies of the descent policy and updated concurrently,
+      // with writes to the shared iterate made atomically.  The
+      // per-coordinate Gradient() callbacks are skipped inside the round
+      // (they would run concurrently); StepTaken() is raised once per
+      // round below.
+      const size_t numFeatures = function.NumFeatures();
+      size_t threads = (shotgunThreads > 0) ? shotgunThreads :
+          ParallelRuntime::Get().RegionThreads();
+      if (threads > numFeatures)
+        threads = numFeatures;
+
+      ENS_PRAGMA_OMP_PARALLEL_FOR_THREADS((int) threads)
+      for (ptrdiff_t t = 0; t < (ptrdiff_t) threads; ++t)
+      {
+        // Per-thread descent-policy state and gradient buffer.
+        DescentPolicyType threadPolicy(descentPolicy);
+        BaseGradType threadGradient;
+
+        const size_t featureIdx = threadPolicy.template DescentFeature<
+            ResolvableFunctionType, BaseMatType, BaseGradType>(
+            (i - 1) * threads + (size_t) t + 1, iterate, function);
+
+        function.PartialGradient(iterate, featureIdx, threadGradient);
+
+        for (size_t r = 0; r < iterate.n_rows; ++r)
+        {
+          const ElemType delta = (ElemType) stepSize *
+              threadGradient(r, featureIdx);
+          if (delta != ElemType(0))
+            ShotgunUpdateLocation(iterate, r, featureIdx, delta);
+        }
+      }
+    }
+    else
+    {
+      // Get the coordinate to descend on.
+      size_t featureIdx = descentPolicy.template DescentFeature<
+          ResolvableFunctionType, BaseMatType, BaseGradType>(i, iterate,
+          function);
+
+      // Get the partial gradient with respect to this feature.
+      function.PartialGradient(iterate, featureIdx, gradient);
+
+      terminate |= Callback::Gradient(*this, function, iterate,
+          overallObjective, gradient, callbacks...);
+      if (terminate)
+        break;
+
+      // Update the decision variable with the partial gradient.
+      iterate.col(featureIdx) -= stepSize * gradient.col(featureIdx);
+    }
 
-    // Update the decision variable with the partial gradient.
-    iterate.col(featureIdx) -= stepSize * gradient.col(featureIdx);
     terminate |= Callback::StepTaken(*this, function, iterate, callbacks...);
 
     // Check for convergence.
@@ -0,0 +1,117 @@
+/**
+ * @file lazy_greedy_descent.hpp
+ * @author Shikhar Bhardwaj
+ *
+ * Lazy greedy descent policy for Coordinate Descent (CD).
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_SCD_DESCENT_POLICIES_LAZY_GREEDY_HPP
+#define ENSMALLEN_SCD_DESCENT_POLICIES_LAZY_GREEDY_HPP
+
+#include <queue>
+
+namespace ens {
+
+/**
+ * Lazy greedy descent policy for Coordinate Descent (CD). Like GreedyDescent,
+ * this descent scheme picks the coordinate with the largest gradient magnitude
+ * according to the Gauss-Southwell rule; but instead of recomputing every
+ * partial gradient on every call (O(d) per selection), it keeps per-coordinate
+ * gradient magnitude estimates in a max-heap and refreshes them lazily.  On
+ * each call, the top of the heap is recomputed at the current iterate; if it
+ * stays on top it is selected, otherwise it is pushed back with its refreshed
+ * value and the next candidate is examined.  When the estimates change slowly
+ * between iterations---as is typical when one coordinate update only affects
+ * the gradients of coordinates sharing data support with it---a selection
+ * touches only a few heap entries, so the cost is close to O(log d) instead
+ * of O(d).
+ *
+ * Note that this is an approximate Gauss-Southwell rule: a stale estimate may
+ * under-report a coordinate whose gradient has grown since its last refresh,
+ * so the selected coordinate is not guaranteed to be the exact maximizer.  Use
+ * GreedyDescent when the exact rule is required.
+ *
+ * For more information, refer to the following.
+ * @code
+ * @misc{Nutini2015,
+ *   author = {Julie Nutini and Mark Schmidt and Issam H.
+ *             Laradji and Michael Friedlander and Hoyt Koepke},
+ *   title  = {Coordinate Descent Converges Faster with the Gauss-Southwell Rule
+ *             Than Random Selection},
+ *   year   = {2015},
+ *   eprint = {arXiv:1506.00552}
+ * }
+ * @endcode
+ */
+class LazyGreedyDescent
+{
+ public:
+  /**
+   * Construct the lazy greedy descent policy.  The heap of gradient magnitude
+   * estimates is built on the first call to DescentFeature().
+   */
+  LazyGreedyDescent() { }
+
+  /**
+   * The DescentFeature method is used to get the descent coordinate for the
+   * current iteration.  Unlike the other descent policies this is stateful:
+   * the heap of gradient magnitude estimates persists between calls.
+   *
+   * @tparam ResolvableFunctionType The type of the function to be optimized.
+   * @param iteration The iteration number for which the feature is to be
+   *    obtained.
+   * @param iterate The current value of the decision variable.
+   * @param function The function to be optimized.
+   * @return The index of the coordinate to be descended.
+   */
+  template<typename ResolvableFunctionType, typename MatType, typename GradType>
+  size_t DescentFeature(const size_t iteration,
+                        const MatType& iterate,
+                        const ResolvableFunctionType& function)
+  {
+    // (Re-)build the heap if this is the first call or the function has
+    // changed size.  Every estimate starts at infinity, so each coordinate is
+    // refreshed before it can be selected; the very first selection therefore
+    // performs one full O(d) greedy pass, and later selections are lazy.
+    if (refreshedAt.size() != function.NumFeatures())
+    {
+      refreshedAt.assign(function.NumFeatures(), size_t(-1));
+      queue = std::priority_queue<std::pair<double, size_t>>();
+      for (size_t i = 0; i < function.NumFeatures(); ++i)
+        queue.emplace(std::numeric_limits<double>::max(), i);
+    }
+
+    // Refresh stale entries at the top of the heap until the top has been
+    // recomputed at the current iterate.  Each coordinate has exactly one
+    // entry in the heap at all times.
+    while (refreshedAt[queue.top().second] != iteration)
+    {
+      const size_t feature = queue.top().second;
+      queue.pop();
+
+      GradType fGrad;
+      function.PartialGradient(iterate, feature, fGrad);
+
+      refreshedAt[feature] = iteration;
+      queue.emplace(std::abs((double) arma::accu(fGrad)), feature);
+    }
+
+    return queue.top().second;
+  }
+
+ private:
+  //! Max-heap of (gradient magnitude estimate, coordinate) pairs; one entry
+  //! per coordinate.
+  std::priority_queue<std::pair<double, size_t>> queue;
+
+  //! The iteration at which each coordinate's estimate was last recomputed.
+  std::vector<size_t> refreshedAt;
+};
+
+} // namespace ens
+
+#endif
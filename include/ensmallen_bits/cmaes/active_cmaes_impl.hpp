@@ -277,37 +277,28 @@ typename MatType::elem_type ActiveCMAES<SelectionPolicyType,
     {
       C[idx1] = (1 - ccov) * C[idx0] + ccov *
           (pc[idx1] * pc[idx1].t());
-
-      for (size_t j = 0; j < mu; ++j)
-      {
-        C[idx1] = C[idx1] + beta * w *
-            pStep[idx(j)] * pStep[idx(j)].t();
-      }
-
-      for (size_t j = lambda - mu; j < lambda; ++j)
-      {
-        C[idx1] = C[idx1] - beta * w *
-            pStep[idx(j)] * pStep[idx(j)].t();
-      }
     }
     else
     {
       C[idx1] = (1 - ccov) * C[idx0] + ccov *
           (pc[idx1].t() * pc[idx1]);
+    }
 
-      for (size_t j = 0; j < mu; ++j)
-      {
-        C[idx1] = C[idx1] + beta * w *
-            pStep[idx(j)].t() * pStep[idx(j)];
-      }
-
-      for (size_t j = lambda - mu; j < lambda; ++j)
-      {
-        C[idx1] = C[idx1] - beta * w *
-            pStep[idx(j)].t() * pStep[idx(j)];
-      }
+    // Pack the selected and de-selected steps into contiguous matrices, so
+    // that the positive and negative weighted contributions each reduce to a
+    // single rank-mu (syrk) BLAS call instead of mu separate outer-product
+    // accumulations.
+    BaseMatType posStep(iterate.n_elem, mu);
+    BaseMatType negStep(iterate.n_elem, mu);
+    for (size_t j = 0; j < mu; ++j)
+    {
+      posStep.col(j) = arma::vectorise(pStep[idx(j)]);
+      negStep.col(j) = arma::vectorise(pStep[idx(lambda - mu + j)]);
     }
 
+    C[idx1] += beta * w * (posStep * posStep.t());
+    C[idx1] -= beta * w * (negStep * negStep.t());
+
     arma::eig_sym(eigval, eigvec, C[idx1]);
     const arma::uvec negativeEigval = arma::find(eigval < 0, 1);
     if (!negativeEigval.is_empty())
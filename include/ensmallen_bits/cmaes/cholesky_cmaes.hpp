@@ -0,0 +1,206 @@
+/**
+ * @file cholesky_cmaes.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the Cholesky-factor variant of the Covariance Matrix
+ * Adaptation Evolution Strategy, following O. Krause et al. in "CMA-ES with
+ * Optimal Covariance Update and Storage Complexity".
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_CMAES_CHOLESKY_CMAES_HPP
+#define ENSMALLEN_CMAES_CHOLESKY_CMAES_HPP
+
+#include "full_selection.hpp"
+#include "random_selection.hpp"
+#include "transformation_policies/empty_transformation.hpp"
+#include "transformation_policies/boundary_box_constraint.hpp"
+
+namespace ens {
+
+/**
+ * Cholesky-CMA-ES is a variant of the stochastic search algorithm
+ * CMA-ES - Covariance Matrix Adaptation Evolution Strategy.
+ * Instead of storing the covariance matrix and factorizing it every
+ * generation, it maintains the covariance's lower-triangular Cholesky factor
+ * directly, applying the rank-one and rank-mu adaptation terms as O(n^2)
+ * triangular factor updates.  This removes all O(n^3) linear algebra from
+ * the generation loop---sampling, the step-size update and the covariance
+ * adaptation are all at most O(lambda n^2)---which is a substantial win for
+ * mid-scale problems where the eigendecomposition dominates the generation
+ * cost.  As in the reference below, the conjugate evolution path is computed
+ * with the inverse factor rather than C^(-1/2), which does not change the
+ * asymptotic behavior of the algorithm.
+ *
+ * For more information, please refer to:
+ *
+ * @code
+ * @inproceedings{Krause2016,
+ *   author    = {Krause, Oswin and Arbon{\`e}s, D{\'i}dac R. and Igel,
+ *                Christian},
+ *   title     = {{CMA-ES} with Optimal Covariance Update and Storage
+ *                Complexity},
+ *   booktitle = {Advances in Neural Information Processing Systems 29},
+ *   year      = {2016},
+ *   pages     = {370--378}}
+ * @endcode
+ *
+ * Cholesky-CMA-ES can optimize separable functions.  For more details, see
+ * the documentation on function types included with this distribution or on
+ * the ensmallen website.
+ *
+ * @tparam SelectionPolicy The selection strategy used for the evaluation step.
+ * @tparam TransformationPolicy The transformation strategy used to
+ *       map decision variables to the desired domain during fitness evaluation
+ *       and termination. Use EmptyTransformation if the domain isn't bounded.
+ */
+template<typename SelectionPolicyType = FullSelection,
+         typename TransformationPolicyType = EmptyTransformation<>>
+class CholeskyCMAES
+{
+ public:
+  /**
+   * Construct the Cholesky-CMA-ES optimizer with the given function and
+   * parameters.  The defaults here are not necessarily good for the given
+   * problem, so it is suggested that the values used be tailored to the task
+   * at hand.  The maximum number of iterations refers to the maximum number
+   * of points that are processed (i.e., one iteration equals one point; one
+   * iteration does not equal one pass over the dataset).
+   *
+   * @param lambda The population size (0 use the default size).
+   * @param transformationPolicy Instantiated transformation policy used to
+   *     map the coordinates to the desired domain.
+   * @param batchSize Batch size to use for the objective calculation.
+   * @param maxIterations Maximum number of iterations allowed (0 means no
+   *     limit).
+   * @param tolerance Maximum absolute tolerance to terminate algorithm.
+   * @param selectionPolicy Instantiated selection policy used to calculate the
+   *     objective.
+   * @param stepSize Starting sigma/step size (will be modified).
+   */
+  CholeskyCMAES(
+      const size_t lambda = 0,
+      const TransformationPolicyType&
+          transformationPolicy = TransformationPolicyType(),
+      const size_t batchSize = 32,
+      const size_t maxIterations = 1000,
+      const double tolerance = 1e-5,
+      const SelectionPolicyType& selectionPolicy = SelectionPolicyType(),
+      double stepSize = 0);
+
+  /**
+   * Optimize the given function using Cholesky-CMA-ES. The given starting
+   * point will be modified to store the finishing point of the algorithm, and
+   * the final objective value is returned.
+   *
+   * @tparam SeparableFunctionType Type of the function to be optimized.
+   * @tparam MatType Type of matrix to optimize.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to optimize.
+   * @param iterate Starting point (will be modified).
+   * @param callbacks Callback functions.
+   * @return Objective value of the final point.
+   */
+  template<typename SeparableFunctionType,
+      typename MatType,
+      typename... CallbackTypes>
+      typename MatType::elem_type Optimize(
+          SeparableFunctionType& function,
+          MatType& iterate,
+          CallbackTypes&&... callbacks);
+
+  //! Get the population size.
+  size_t PopulationSize() const { return lambda; }
+  //! Modify the population size.
+  size_t& PopulationSize() { return lambda; }
+
+  //! Get the batch size.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the batch size.
+  size_t& BatchSize() { return batchSize; }
+
+  //! Get the maximum number of iterations (0 indicates no limit).
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of iterations (0 indicates no limit).
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the tolerance for termination.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance for termination.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the selection policy.
+  const SelectionPolicyType& SelectionPolicy() const { return selectionPolicy; }
+  //! Modify the selection policy.
+  SelectionPolicyType& SelectionPolicy() { return selectionPolicy; }
+
+  //! Get the transformation policy.
+  const TransformationPolicyType& TransformationPolicy() const
+  { return transformationPolicy; }
+  //! Modify the transformation policy.
+  TransformationPolicyType& TransformationPolicy()
+  { return transformationPolicy; }
+
+  //! Get the step size.
+  double StepSize() const
+  { return stepSize; }
+  //! Modify the step size.
+  double& StepSize()
+  { return stepSize; }
+
+ private:
+  /**
+   * Apply the rank-one update C' = C + v v^T directly to the
+   * lower-triangular Cholesky factor of C, in place, using the classic
+   * LINPACK sequence of Givens-style eliminations; this costs O(n^2) instead
+   * of the O(n^3) required to refactorize.  Any scaling of the update term
+   * is expected to be folded into v by the caller.
+   *
+   * @param factor Lower-triangular Cholesky factor (will be modified).
+   * @param v The update vector.
+   */
+  template<typename BaseMatType>
+  static void CholeskyUpdate(BaseMatType& factor,
+      const arma::Col<typename BaseMatType::elem_type>& v);
+
+  //! Population size.
+  size_t lambda;
+
+  //! The batch size for processing.
+  size_t batchSize;
+
+  //! The maximum number of allowed iterations.
+  size_t maxIterations;
+
+  //! The tolerance for termination.
+  double tolerance;
+
+  //! The selection policy used to calculate the objective.
+  SelectionPolicyType selectionPolicy;
+
+  //! The transformationPolicy used to map coordinates to the suitable domain
+  //! while evaluating fitness. This mapping is also done after optimization
+  //! has completed.
+  TransformationPolicyType transformationPolicy;
+
+  //! The step size.
+  double stepSize;
+};
+
+/**
+ * Convenient typedef for Cholesky-CMA-ES approximation.
+ */
+template<typename TransformationPolicyType = EmptyTransformation<>,
+         typename SelectionPolicyType = RandomSelection>
+using ApproxCholeskyCMAES =
+    CholeskyCMAES<SelectionPolicyType, TransformationPolicyType>;
+
+} // namespace ens
+
+// Include implementation.
+#include "cholesky_cmaes_impl.hpp"
+
+#endif
@@ -15,8 +15,13 @@
 #ifndef ENSMALLEN_CMAES_CMAES_HPP
 #define ENSMALLEN_CMAES_CMAES_HPP
 
+#include <ensmallen_bits/utility/stagnation_detector.hpp>
+
 #include "full_selection.hpp"
 #include "random_selection.hpp"
+#include "surrogate_selection.hpp"
+#include "racing_selection.hpp"
+#include "fidelity_selection.hpp"
 #include "transformation_policies/empty_transformation.hpp"
 #include "transformation_policies/boundary_box_constraint.hpp"
 
@@ -113,6 +118,15 @@ class CMAES
         const SelectionPolicyType& selectionPolicy = SelectionPolicyType(),
         double stepSize = 0);
 
+  /**
+   * Clean memory associated with the CMAES object.
+   */
+  ~CMAES()
+  {
+    askTellState.Clean();
+    warmStartState.Clean();
+  }
+
   /**
    * Optimize the given function using CMA-ES. The given starting point will be
    * modified to store the finishing point of the algorithm, and the final
@@ -133,11 +147,85 @@ class CMAES
           MatType& iterate,
           CallbackTypes&&... callbacks);
 
+  /**
+   * Initialize the ask/tell interface from the given starting point.  Instead
+   * of handing a function object to Optimize(), the caller drives the
+   * generation loop: Ask() returns the candidate population, the caller
+   * evaluates it however it likes (e.g. batched on a remote cluster), and
+   * Tell() advances the strategy state with the observed objective values.
+   * Termination is likewise under the caller's control.
+   *
+   * @param iterate Starting point; only its value and shape are used.
+   */
+  template<typename MatType>
+  void Initialize(const MatType& iterate);
+
+  /**
+   * Sample the next candidate population.  Each of the lambda columns of the
+   * returned matrix holds one vectorized candidate, already mapped through
+   * the transformation policy, ready for evaluation.  Initialize() must have
+   * been called first.
+   */
+  template<typename MatType>
+  MatType Ask();
+
+  /**
+   * Advance the strategy state with the objective values of the population
+   * returned by the preceding Ask() call, and return the best objective
+   * value observed so far.
+   *
+   * @param objectives Vector of lambda objective values, in the column order
+   *     of the population returned by Ask().
+   */
+  template<typename MatType>
+  typename MatType::elem_type Tell(const MatType& objectives);
+
+  /**
+   * Return the best candidate observed by the ask/tell interface so far, in
+   * the shape of the starting point and mapped through the transformation
+   * policy.
+   */
+  template<typename MatType>
+  MatType Best();
+
   //! Get the population size.
   size_t PopulationSize() const { return lambda; }
   //! Modify the population size.
   size_t& PopulationSize() { return lambda; }
 
+  //! Get whether the population is evaluated in parallel.
+  bool ParallelEvaluation() const { return parallelEvaluation; }
+  //! Modify whether the population is evaluated in parallel.  Since CMA-ES
+  //! generations are embarrassingly parallel, this helps greatly for
+  //! expensive objectives; the per-batch Evaluate callbacks are raised once
+  //! per candidate (after the parallel region) instead of once per batch.
+  //! This has no effect unless OpenMP is enabled.
+  bool& ParallelEvaluation() { return parallelEvaluation; }
+
+  //! Get the number of generations between covariance factorizations.
+  size_t EigenInterval() const { return eigenInterval; }
+  //! Modify the number of generations between covariance factorizations.
+  //! The Cholesky factor used for sampling and the eigendecomposition used
+  //! by the step-size update are only recomputed every eigenInterval
+  //! generations; in between, candidates are drawn from the slightly stale
+  //! factors.  This trades a little adaptation accuracy for skipping two
+  //! O(n^3) decompositions per intermediate generation, which pays off when
+  //! the objective is cheap relative to the problem dimension.  A value of 0
+  //! selects the standard lazy schedule of roughly n / (10 * lambda)
+  //! generations; the default of 1 factorizes every generation.
+  size_t& EigenInterval() { return eigenInterval; }
+
+  //! Get whether mirrored sampling is used.
+  bool MirroredSampling() const { return mirroredSampling; }
+  //! Modify whether mirrored sampling is used.  When enabled, the
+  //! population is drawn in antithetic pairs (+step, -step), and only the
+  //! better member of each pair takes part in the weighted recombination
+  //! (pairwise selection, Brockhoff et al., "Mirrored Sampling and
+  //! Sequential Selection for Evolution Strategies", PPSN 2010).  On smooth
+  //! objectives this extracts noticeably more progress per evaluation; the
+  //! number of evaluations per generation is unchanged.
+  bool& MirroredSampling() { return mirroredSampling; }
+
   //! Get the batch size.
   size_t BatchSize() const { return batchSize; }
   //! Modify the batch size.
@@ -153,6 +241,15 @@ class CMAES
   //! Modify the tolerance for termination.
   double& Tolerance() { return tolerance; }
 
+  //! Get the stagnation detector used for early termination.
+  const StagnationDetector& Stagnation() const { return stagnation; }
+  //! Modify the stagnation detector used for early termination.  Disabled
+  //! by default; it complements the Tolerance() check with a configurable
+  //! patience on the best-objective improvement and a floor on the step
+  //! size sigma, which stands in for the population diversity of the other
+  //! population optimizers.
+  StagnationDetector& Stagnation() { return stagnation; }
+
   //! Get the selection policy.
   const SelectionPolicyType& SelectionPolicy() const { return selectionPolicy; }
   //! Modify the selection policy.
@@ -172,10 +269,122 @@ class CMAES
   double& StepSize()
   { return stepSize; }
 
+  //! Get the scale of the search distribution at the end of the last
+  //! Optimize() call: the mean eigenvalue of the sampling covariance
+  //! sigma^2 * C, i.e. an isotropic estimate of the local inverse Hessian
+  //! scale.  This is the piece of distribution state worth carrying into a
+  //! local refinement phase (see HybridOptimizer); 0 until Optimize() has
+  //! run.
+  double DistributionScale() const { return distributionScale; }
+
+  //! Get whether the search distribution is retained across Optimize()
+  //! calls.
+  bool WarmStart() const { return warmStart; }
+  //! Modify whether warm starting is enabled.  When enabled, the covariance
+  //! and step size of the last Optimize() call (or a distribution injected
+  //! with SeedDistribution()) seed the next call, provided the problem
+  //! dimension still matches, instead of the identity covariance and the
+  //! configured initial step size; the evolution paths restart at zero.  On
+  //! nearly identical day-over-day problems this skips re-learning the
+  //! local curvature from scratch.
+  bool& WarmStart() { return warmStart; }
+
+  /**
+   * Inject a search distribution to seed the next Optimize() call with,
+   * e.g. one exported from a prior run with Covariance() and
+   * DistributionStepSize().  Implies WarmStart() = true.
+   *
+   * @param covariance The covariance matrix to seed with (n_elem rows and
+   *     columns, in the untransformed coordinate space).
+   * @param sigma The step size to seed with.
+   */
+  template<typename MatType>
+  void SeedDistribution(const MatType& covariance, const double sigma);
+
+  /**
+   * Return the covariance retained by the last warm-started Optimize() call
+   * (or injected with SeedDistribution()).  MatType must match the type
+   * optimized with; throws if no distribution is held.
+   */
+  template<typename MatType>
+  const typename MatTypeTraits<MatType>::BaseMatType& Covariance() const;
+
+  //! Return the retained step size (see Covariance()).
+  template<typename MatType>
+  typename MatType::elem_type DistributionStepSize() const;
+
  private:
+  /**
+   * The distribution state retained across warm-started Optimize() calls
+   * (see WarmStart()); the evolution paths are not carried over, since they
+   * accumulate momentum that is stale on a changed objective.
+   */
+  template<typename BaseMatType>
+  struct RetainedDistribution
+  {
+    //! Covariance and step size at the end of the last Optimize() call.
+    BaseMatType C;
+    typename BaseMatType::elem_type sigma;
+  };
+
+  /**
+   * Persistent state of the ask/tell interface.  Everything is kept in
+   * vectorized form (one column per candidate), so the original iterate
+   * shape is only needed to reshape results handed back to the caller.
+   */
+  template<typename BaseMatType>
+  struct AskTellState
+  {
+    typedef typename BaseMatType::elem_type ElemType;
+
+    //! Generation counter (starts at 1, matching Optimize()).
+    size_t i;
+    //! Shape of the starting point, for reshaping results.
+    size_t rows, cols;
+    //! Resolved population size and parent number.
+    size_t lambda, mu;
+    //! Recombination weights.
+    BaseMatType w;
+    //! Strategy constants (see Optimize() for their derivation).
+    double muEffective, cs, ds, enn, cc, h, c1, cmu;
+    //! Number of generations between covariance factorizations.
+    size_t factorInterval;
+    //! Distribution state; mPosition, ps and pc are vector-shaped.
+    BaseMatType mPosition, ps, pc;
+    ElemType sigma;
+    BaseMatType C, covLower, eigvec;
+    arma::Col<ElemType> eigval;
+    //! The sampled steps of the current generation, one column per candidate.
+    BaseMatType pStep;
+    //! Best candidate observed so far (untransformed, iterate-shaped).
+    BaseMatType best;
+    ElemType bestObjective;
+  };
+
   //! Population size.
   size_t lambda;
 
+  //! Whether the population is evaluated in parallel.
+  bool parallelEvaluation;
+
+  //! The number of generations between covariance factorizations (0 uses the
+  //! standard lazy schedule of roughly n / (10 * lambda) generations).
+  size_t eigenInterval;
+
+  //! Whether the population is drawn in antithetic (+step, -step) pairs.
+  bool mirroredSampling;
+
+  //! The mean eigenvalue of the sampling covariance sigma^2 * C at the end
+  //! of the last Optimize() call (0 before the first call).
+  double distributionScale;
+
+  //! Whether the search distribution is retained across Optimize() calls.
+  bool warmStart;
+
+  //! The retained or injected distribution; empty until a warm-started
+  //! Optimize() call finishes or SeedDistribution() is called.
+  Any warmStartState;
+
   //! The batch size for processing.
   size_t batchSize;
 
@@ -185,6 +394,9 @@ class CMAES
   //! The tolerance for termination.
   double tolerance;
 
+  //! The stagnation detector used for early termination.
+  StagnationDetector stagnation;
+
   //! The selection policy used to calculate the objective.
   SelectionPolicyType selectionPolicy;
 
@@ -195,6 +407,9 @@ class CMAES
 
   //! The step size.
   double stepSize;
+
+  //! The instantiated ask/tell state; empty until Initialize() is called.
+  Any askTellState;
 };
 
 /**
@@ -204,6 +419,15 @@ template<typename TransformationPolicyType = EmptyTransformation<>,
          typename SelectionPolicyType = RandomSelection>
 using ApproxCMAES = CMAES<SelectionPolicyType, TransformationPolicyType>;
 
+/**
+ * Convenient typedef for surrogate-assisted CMAES; most candidates are
+ * ranked on a cheap quadratic surrogate and only promising or control
+ * candidates reach the true objective (see surrogate_selection.hpp).
+ */
+template<typename TransformationPolicyType = EmptyTransformation<>,
+         typename SelectionPolicyType = SurrogateSelection>
+using SurrogateCMAES = CMAES<SelectionPolicyType, TransformationPolicyType>;
+
 } // namespace ens
 
 // Include implementation.
@@ -23,6 +23,39 @@
 
 namespace ens {
 
+/**
+ * Per-generation scratch of the CMA-ES generation loop, sized once from the
+ * problem dimension and the population size at the start of Optimize().
+ * Everything the loop previously allocated per generation -- the Gaussian
+ * sampling draw, the mirrored-ranking copy of the objectives, the
+ * preconditioner applied to the recombined step, the rank-one/rank-mu outer
+ * products, and the transformed-candidate buffer -- lives here, so
+ * steady-state generations perform no heap allocations.
+ */
+template<typename BaseMatType>
+struct CMAESWorkspace
+{
+  CMAESWorkspace(const size_t rows, const size_t cols, const size_t lambda) :
+      gaussian(rows, cols),
+      transformed(rows, cols),
+      selectionObjective(lambda, 1),
+      invCov(rows * cols, rows * cols),
+      outer(rows * cols, rows * cols)
+  { /* Nothing to do. */ }
+
+  //! Buffer for the standard-normal draw behind each sampled step.
+  BaseMatType gaussian;
+  //! Buffer for transformed candidates handed to the objective.
+  BaseMatType transformed;
+  //! Penalized objective copy used to rank mirrored pairs.
+  BaseMatType selectionObjective;
+  //! The step-size preconditioner eigvec * diag(1 / eigval) * eigvec^T,
+  //! rebuilt on the covariance factorization schedule.
+  BaseMatType invCov;
+  //! Buffer for the rank-one and rank-mu outer products.
+  BaseMatType outer;
+};
+
 template<typename SelectionPolicyType, typename TransformationPolicyType>
 CMAES<SelectionPolicyType, TransformationPolicyType>::CMAES(const size_t lambda,
                                   const TransformationPolicyType& 
@@ -38,7 +71,12 @@ CMAES<SelectionPolicyType, TransformationPolicyType>::CMAES(const size_t lambda,
     tolerance(tolerance),
     selectionPolicy(selectionPolicy),
     transformationPolicy(transformationPolicy),
-    stepSize(stepSizeIn)
+    stepSize(stepSizeIn),
+    parallelEvaluation(false),
+    eigenInterval(1),
+    mirroredSampling(false),
+    distributionScale(0),
+    warmStart(false)
 { /* Nothing to do. */ }
 
 template<typename SelectionPolicyType, typename TransformationPolicyType>
@@ -55,7 +93,12 @@ CMAES<SelectionPolicyType, TransformationPolicyType>::CMAES(const size_t lambda,
     maxIterations(maxIterations),
     tolerance(tolerance),
     selectionPolicy(selectionPolicy),
-    stepSize(stepSizeIn)
+    stepSize(stepSizeIn),
+    parallelEvaluation(false),
+    eigenInterval(1),
+    mirroredSampling(false),
+    distributionScale(0),
+    warmStart(false)
 {
   Warn << "This is a deprecated constructor and will be removed in a "
     "future version of ensmallen" << std::endl;
@@ -168,7 +211,25 @@ typename MatType::elem_type CMAES<SelectionPolicyType,
   std::vector<BaseMatType> C(2, BaseMatType(iterate.n_elem, iterate.n_elem));
   C[0].eye();
 
-  // Covariance matrix parameters.
+  // Resume from the retained or injected distribution when warm starting
+  // and the problem dimension still matches (see WarmStart()); the
+  // evolution paths restart at zero.
+  if (warmStart && warmStartState.Has<RetainedDistribution<BaseMatType>>())
+  {
+    const RetainedDistribution<BaseMatType>& retained =
+        warmStartState.As<RetainedDistribution<BaseMatType>>();
+    if (retained.C.n_rows == iterate.n_elem &&
+        retained.C.n_cols == iterate.n_elem && retained.sigma > 0)
+    {
+      C[0] = retained.C;
+      sigma(0) = retained.sigma;
+    }
+  }
+
+  // Covariance matrix parameters.  The Cholesky factor and the
+  // eigendecomposition persist across generations so that a lazy
+  // factorization schedule can reuse them.
+  BaseMatType covLower;
   arma::Col<ElemType> eigval; // TODO: might need a more general type.
   BaseMatType eigvec;
   BaseMatType eigvalZero(iterate.n_elem, 1); // eigvalZero is vector-shaped.
@@ -177,7 +238,13 @@ typename MatType::elem_type CMAES<SelectionPolicyType,
   // The current visitation order (sorted by population objectives).
   arma::uvec idx = arma::linspace<arma::uvec>(0, lambda - 1, lambda);
 
+  // Scratch buffers of the generation loop, allocated once here; the loop
+  // below performs no further heap allocations outside the scheduled
+  // covariance factorizations.
+  CMAESWorkspace<BaseMatType> ws(iterate.n_rows, iterate.n_cols, lambda);
+
   // Now iterate!
+  stagnation.Reset();
   Callback::BeginOptimization(*this, function, transformedIterate,
       callbacks...);
 
@@ -186,43 +253,122 @@ typename MatType::elem_type CMAES<SelectionPolicyType,
   size_t patience = 10 + (30 * iterate.n_elem / lambda) + 1;
   size_t steps = 0;
 
+  // Number of generations between covariance factorizations; 0 selects the
+  // standard lazy schedule of roughly n / (10 * lambda) generations.
+  const size_t factorInterval = (eigenInterval == 0) ?
+      std::max<size_t>(1, (size_t) (iterate.n_elem / (10.0 * lambda))) :
+      eigenInterval;
+
   for (size_t i = 1; (i != maxIterations) && !terminate; ++i)
   {
     // To keep track of where we are.
     const size_t idx0 = (i - 1) % 2;
     const size_t idx1 = i % 2;
 
-    // Perform Cholesky decomposition. If the matrix is not positive definite,
-    // add a small value and try again.
-    BaseMatType covLower;
-    while (!arma::chol(covLower, C[idx0], "lower"))
-      C[idx0].diag() += std::numeric_limits<ElemType>::epsilon();
+    // Refresh the covariance factorizations only on schedule; intermediate
+    // generations sample from (and update the step size with) the slightly
+    // stale factors, skipping two O(n^3) decompositions each.
+    if ((i - 1) % factorInterval == 0)
+    {
+      // Perform Cholesky decomposition. If the matrix is not positive
+      // definite, add a small value and try again.
+      while (!arma::chol(covLower, C[idx0], "lower"))
+        C[idx0].diag() += std::numeric_limits<ElemType>::epsilon();
+
+      arma::eig_sym(eigval, eigvec, C[idx0]);
 
-    arma::eig_sym(eigval, eigvec, C[idx0]);
+      // The step-size preconditioner only depends on the factorization, so
+      // it is rebuilt here and reused by the intermediate generations
+      // instead of re-multiplying the eigendecomposition every generation.
+      ws.invCov = eigvec * arma::diagmat(1 / eigval) * eigvec.t();
+    }
 
+    // Sample the population.  This stays serial even in parallel-evaluation
+    // mode, since the random number generator is not thread-safe.
     for (size_t j = 0; j < lambda; ++j)
     {
-      if (iterate.n_rows > iterate.n_cols)
+      if (mirroredSampling && (j % 2 == 1))
+      {
+        // The odd member of each pair is the mirror image of the even one.
+        pStep[idx(j)] = -pStep[idx(j - 1)];
+      }
+      else if (iterate.n_rows > iterate.n_cols)
       {
-        pStep[idx(j)] = covLower *
-          arma::randn<BaseMatType>(iterate.n_rows, iterate.n_cols);
+        ws.gaussian.randn();
+        pStep[idx(j)] = covLower * ws.gaussian;
       }
       else
       {
-        pStep[idx(j)] = arma::randn<BaseMatType>(iterate.n_rows, iterate.n_cols)
-          * covLower.t();
+        ws.gaussian.randn();
+        pStep[idx(j)] = ws.gaussian * covLower.t();
       }
 
       pPosition[idx(j)] = mPosition[idx0] + sigma(idx0) * pStep[idx(j)];
+    }
+
+    if (parallelEvaluation)
+    {
+      // Candidate evaluations are independent, so spread them over all
+      // threads.  Callbacks are not thread-safe, so the Evaluate events are
+      // raised serially afterwards, once per candidate.
+      // Use a signed index: some OpenMP implementations require it.
+      ENS_PRAGMA_OMP_PARALLEL_FOR
+      for (ptrdiff_t j = 0; j < (ptrdiff_t) lambda; ++j)
+      {
+        bool dummy = false;
+        pObjective(idx(j)) = selectionPolicy.Select(function, batchSize,
+            transformationPolicy.Transform(pPosition[idx(j)]), dummy);
+      }
 
-      // Calculate the objective function.
-      pObjective(idx(j)) = selectionPolicy.Select(function, batchSize,
-          transformationPolicy.Transform(pPosition[idx(j)]), terminate,
-          callbacks...);
+      for (size_t j = 0; j < lambda; ++j)
+      {
+        terminate |= Callback::Evaluate(*this, function,
+            transformationPolicy.Transform(pPosition[idx(j)]),
+            pObjective(idx(j)), callbacks...);
+      }
+    }
+    else
+    {
+      for (size_t j = 0; j < lambda; ++j)
+      {
+        // Calculate the objective function.
+        transformationPolicy.Transform(pPosition[idx(j)], ws.transformed);
+        pObjective(idx(j)) = selectionPolicy.Select(function, batchSize,
+            ws.transformed, terminate, callbacks...);
+      }
     }
 
-    // Sort population.
-    idx = arma::sort_index(pObjective);
+    // Sort population.  The ranking sorts idx in place, so no fresh index
+    // vector is allocated.
+    if (mirroredSampling)
+    {
+      // Pairwise selection: only the better member of each (+step, -step)
+      // pair may take part in recombination; the worse one would otherwise
+      // bias the step-length statistics, since its step is not independent
+      // of its twin's.  The ranking uses a penalized copy so that the true
+      // objective values stay available below.
+      ws.selectionObjective = pObjective;
+      for (size_t j = 0; j + 1 < lambda; j += 2)
+      {
+        const size_t worse = (pObjective(idx(j)) <= pObjective(idx(j + 1))) ?
+            idx(j + 1) : idx(j);
+        ws.selectionObjective(worse) = std::numeric_limits<ElemType>::max();
+      }
+
+      for (size_t j = 0; j < lambda; ++j)
+        idx(j) = j;
+      std::sort(idx.begin(), idx.end(),
+          [&ws](const arma::uword a, const arma::uword b)
+          { return ws.selectionObjective(a) < ws.selectionObjective(b); });
+    }
+    else
+    {
+      for (size_t j = 0; j < lambda; ++j)
+        idx(j) = j;
+      std::sort(idx.begin(), idx.end(),
+          [&pObjective](const arma::uword a, const arma::uword b)
+          { return pObjective(a) < pObjective(b); });
+    }
 
     step = w(0) * pStep[idx(0)];
     for (size_t j = 1; j < mu; ++j)
@@ -231,9 +377,9 @@ typename MatType::elem_type CMAES<SelectionPolicyType,
     mPosition[idx1] = mPosition[idx0] + sigma(idx0) * step;
 
     // Calculate the objective function.
+    transformationPolicy.Transform(mPosition[idx1], ws.transformed);
     currentObjective = selectionPolicy.Select(function, batchSize,
-        transformationPolicy.Transform(mPosition[idx1]), terminate,
-        callbacks...);
+        ws.transformed, terminate, callbacks...);
 
     // Update best parameters.
     if (currentObjective < overallObjective)
@@ -241,24 +387,18 @@ typename MatType::elem_type CMAES<SelectionPolicyType,
       overallObjective = currentObjective;
       iterate = mPosition[idx1];
 
-      transformedIterate = transformationPolicy.Transform(iterate);
+      transformationPolicy.Transform(iterate, transformedIterate);
       terminate |= Callback::StepTaken(*this, function,
         transformedIterate, callbacks...);
     }
 
     // Update Step Size.
     if (iterate.n_rows > iterate.n_cols)
-    {
-      ps[idx1] = (1 - cs) * ps[idx0] + std::sqrt(
-        cs * (2 - cs) * muEffective) *
-        eigvec * diagmat(1 / eigval) * eigvec.t() * step;
-    }
+      ps[idx1] = ws.invCov * step;
     else
-    {
-      ps[idx1] = (1 - cs) * ps[idx0] + std::sqrt(
-        cs * (2 - cs) * muEffective) * step *
-        eigvec * diagmat(1 / eigval) * eigvec.t();
-    }
+      ps[idx1] = step * ws.invCov;
+    ps[idx1] *= std::sqrt(cs * (2 - cs) * muEffective);
+    ps[idx1] += (1 - cs) * ps[idx0];
 
     const ElemType psNorm = arma::norm(ps[idx1]);
     sigma(idx1) = sigma(idx0) * std::exp(cs / ds * (psNorm / enn - 1));
@@ -280,63 +420,88 @@ typename MatType::elem_type CMAES<SelectionPolicyType,
       pc[idx1] = (1 - cc) * pc[idx0] + std::sqrt(cc * (2 - cc) *
         muEffective) * step;
 
+      // The rank-one outer product is written straight into C[idx1], which
+      // is then scaled and accumulated in place.
       if (iterate.n_rows > iterate.n_cols)
-      {
-        C[idx1] = (1 - c1 - cmu) * C[idx0] + c1 *
-          (pc[idx1] * pc[idx1].t());
-      }
+        C[idx1] = pc[idx1] * pc[idx1].t();
       else
-      {
-        C[idx1] = (1 - c1 - cmu) * C[idx0] + c1 *
-          (pc[idx1].t() * pc[idx1]);
-      }
+        C[idx1] = pc[idx1].t() * pc[idx1];
+      C[idx1] *= c1;
+      C[idx1] += (1 - c1 - cmu) * C[idx0];
     }
     else
     {
       pc[idx1] = (1 - cc) * pc[idx0];
 
       if (iterate.n_rows > iterate.n_cols)
-      {
-        C[idx1] = (1 - c1 - cmu) * C[idx0] + c1 * (pc[idx1] *
-          pc[idx1].t() + (cc * (2 - cc)) * C[idx0]);
-      }
+        C[idx1] = pc[idx1] * pc[idx1].t();
       else
-      {
-        C[idx1] = (1 - c1 - cmu) * C[idx0] + c1 *
-          (pc[idx1].t() * pc[idx1] + (cc * (2 - cc)) * C[idx0]);
-      }
+        C[idx1] = pc[idx1].t() * pc[idx1];
+      C[idx1] *= c1;
+      C[idx1] += (1 - c1 - cmu + c1 * cc * (2 - cc)) * C[idx0];
     }
 
+    // Rank-mu update; each outer product lands in the preallocated scratch
+    // buffer before being accumulated.
     if (iterate.n_rows > iterate.n_cols)
     {
       for (size_t j = 0; j < mu; ++j)
       {
-        C[idx1] = C[idx1] + cmu * w(j) *
-          pStep[idx(j)] * pStep[idx(j)].t();
+        ws.outer = pStep[idx(j)] * pStep[idx(j)].t();
+        C[idx1] += (cmu * w(j)) * ws.outer;
       }
     }
     else
     {
       for (size_t j = 0; j < mu; ++j)
       {
-        C[idx1] = C[idx1] + cmu * w(j) *
-          pStep[idx(j)].t() * pStep[idx(j)];
+        ws.outer = pStep[idx(j)].t() * pStep[idx(j)];
+        C[idx1] += (cmu * w(j)) * ws.outer;
       }
     }
 
-    arma::eig_sym(eigval, eigvec, C[idx1]);
-    const arma::uvec negativeEigval = arma::find(eigval < 0, 1);
-    if (!negativeEigval.is_empty())
+    // Record the scale of the search distribution (mean eigenvalue of the
+    // sampling covariance sigma^2 * C); this is the distribution state a
+    // subsequent local refinement phase can reuse (see DistributionScale()).
+    distributionScale = std::pow((double) sigma(idx1), 2) *
+        (double) arma::trace(C[idx1]) / (double) C[idx1].n_rows;
+
+    // Likewise retain the distribution itself, so the next warm-started
+    // call resumes from it (see WarmStart()).  This is kept up to date each
+    // generation because Optimize() has several termination paths.
+    if (warmStart)
     {
-      if (negativeEigval(0) == 0)
+      if (!warmStartState.Has<RetainedDistribution<BaseMatType>>())
       {
-        C[idx1].zeros();
+        warmStartState.Clean();
+        warmStartState.Set<RetainedDistribution<BaseMatType>>(
+            new RetainedDistribution<BaseMatType>());
       }
-      else
+      RetainedDistribution<BaseMatType>& retained =
+          warmStartState.As<RetainedDistribution<BaseMatType>>();
+      retained.C = C[idx1];
+      retained.sigma = sigma(idx1);
+    }
+
+    // The negative-eigenvalue repair needs its own eigendecomposition of the
+    // updated covariance, so it is only performed on generations whose
+    // covariance the next scheduled factorization will actually consume.
+    if (i % factorInterval == 0)
+    {
+      arma::eig_sym(eigval, eigvec, C[idx1]);
+      const arma::uvec negativeEigval = arma::find(eigval < 0, 1);
+      if (!negativeEigval.is_empty())
       {
-        C[idx1] = eigvec.cols(0, negativeEigval(0) - 1) *
-          arma::diagmat(eigval.subvec(0, negativeEigval(0) - 1)) *
-          eigvec.cols(0, negativeEigval(0) - 1).t();
+        if (negativeEigval(0) == 0)
+        {
+          C[idx1].zeros();
+        }
+        else
+        {
+          C[idx1] = eigvec.cols(0, negativeEigval(0) - 1) *
+            arma::diagmat(eigval.subvec(0, negativeEigval(0) - 1)) *
+            eigvec.cols(0, negativeEigval(0) - 1).t();
+        }
       }
     }
 
@@ -372,6 +537,21 @@ typename MatType::elem_type CMAES<SelectionPolicyType,
     steps++;
 
     lastObjective = overallObjective;
+
+    // Optional stagnation-based early termination (see Stagnation()); the
+    // step size stands in for the population diversity of the other
+    // population optimizers.
+    if (stagnation.Enabled() &&
+        stagnation.Stagnated((double) overallObjective,
+        (double) sigma(idx1)))
+    {
+      Info << "CMA-ES: stagnation detected at iteration " << i << "; "
+          << "terminating optimization." << std::endl;
+
+      iterate = transformationPolicy.Transform(iterate);
+      Callback::EndOptimization(*this, function, iterate, callbacks...);
+      return overallObjective;
+    }
   }
 
   iterate = transformationPolicy.Transform(iterate);
@@ -379,6 +559,264 @@ typename MatType::elem_type CMAES<SelectionPolicyType,
   return overallObjective;
 }
 
+//! Initialize the ask/tell interface.
+template<typename SelectionPolicyType, typename TransformationPolicyType>
+template<typename MatType>
+void CMAES<SelectionPolicyType, TransformationPolicyType>::Initialize(
+    const MatType& iterateIn)
+{
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef AskTellState<BaseMatType> StateType;
+
+  RequireDenseFloatingPointType<BaseMatType>();
+
+  const BaseMatType& iterate = (const BaseMatType&) iterateIn;
+
+  askTellState.Clean();
+  askTellState.Set<StateType>(new StateType());
+  StateType& state = askTellState.As<StateType>();
+
+  // The parameter derivations below mirror Optimize().
+  state.i = 1;
+  state.rows = iterate.n_rows;
+  state.cols = iterate.n_cols;
+  state.lambda = (lambda == 0) ?
+      (4 + std::round(3 * std::log(iterate.n_elem))) * 10 : lambda;
+  state.mu = std::round(state.lambda / 2);
+
+  state.w = std::log(state.mu + 0.5) - arma::log(
+      arma::linspace<BaseMatType>(0, state.mu - 1, state.mu) + 1.0);
+  state.w /= arma::accu(state.w);
+  state.muEffective = 1 / arma::accu(arma::pow(state.w, 2));
+
+  state.sigma = (stepSize == 0) ?
+      transformationPolicy.InitialStepSize() : stepSize;
+
+  state.cs = (state.muEffective + 2) /
+      (iterate.n_elem + state.muEffective + 5);
+  state.ds = 1 + state.cs + 2 * std::max(std::sqrt((state.muEffective - 1) /
+      (iterate.n_elem + 1)) - 1, 0.0);
+  state.enn = std::sqrt(iterate.n_elem) * (1.0 - 1.0 /
+      (4.0 * iterate.n_elem) + 1.0 / (21 * std::pow(iterate.n_elem, 2)));
+
+  state.cc = (4 + state.muEffective / iterate.n_elem) /
+      (4 + iterate.n_elem + 2 * state.muEffective / iterate.n_elem);
+  state.h = (1.4 + 2.0 / (iterate.n_elem + 1.0)) * state.enn;
+
+  state.c1 = 2 / (std::pow(iterate.n_elem + 1.3, 2) + state.muEffective);
+  const double alphaMu = 2;
+  state.cmu = std::min(1 - state.c1, alphaMu * (state.muEffective - 2 + 1 /
+      state.muEffective) / (std::pow(iterate.n_elem + 2, 2) +
+      alphaMu * state.muEffective / 2));
+
+  state.factorInterval = (eigenInterval == 0) ?
+      std::max<size_t>(1, (size_t) (iterate.n_elem / (10.0 * state.lambda))) :
+      eigenInterval;
+
+  state.mPosition = arma::vectorise(iterate);
+  state.ps.zeros(iterate.n_elem, 1);
+  state.pc.zeros(iterate.n_elem, 1);
+  state.C.eye(iterate.n_elem, iterate.n_elem);
+
+  state.best = iterate;
+  state.bestObjective = std::numeric_limits<ElemType>::max();
+}
+
+//! Sample the next candidate population.
+template<typename SelectionPolicyType, typename TransformationPolicyType>
+template<typename MatType>
+MatType CMAES<SelectionPolicyType, TransformationPolicyType>::Ask()
+{
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef AskTellState<BaseMatType> StateType;
+
+  if (!askTellState.Has<StateType>())
+    throw std::logic_error("CMAES::Ask(): call Initialize() first!");
+  StateType& state = askTellState.As<StateType>();
+
+  // Refresh the covariance factorizations on the configured schedule (see
+  // Optimize()).
+  if ((state.i - 1) % state.factorInterval == 0)
+  {
+    while (!arma::chol(state.covLower, state.C, "lower"))
+      state.C.diag() += std::numeric_limits<ElemType>::epsilon();
+
+    arma::eig_sym(state.eigval, state.eigvec, state.C);
+  }
+
+  // Sample the whole population with one batched product; each column is one
+  // candidate step.
+  state.pStep = state.covLower * arma::randn<BaseMatType>(
+      state.mPosition.n_elem, state.lambda);
+
+  BaseMatType population = state.sigma * state.pStep;
+  population.each_col() += state.mPosition;
+
+  // Hand the candidates back in the domain the objective is evaluated in.
+  for (size_t j = 0; j < state.lambda; ++j)
+  {
+    population.col(j) = arma::vectorise(transformationPolicy.Transform(
+        BaseMatType(arma::reshape(population.col(j), state.rows,
+        state.cols))));
+  }
+
+  return population;
+}
+
+//! Advance the strategy state with the observed objective values.
+template<typename SelectionPolicyType, typename TransformationPolicyType>
+template<typename MatType>
+typename MatType::elem_type CMAES<SelectionPolicyType,
+  TransformationPolicyType>::Tell(const MatType& objectivesIn)
+{
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef AskTellState<BaseMatType> StateType;
+
+  if (!askTellState.Has<StateType>())
+    throw std::logic_error("CMAES::Tell(): call Initialize() first!");
+  StateType& state = askTellState.As<StateType>();
+
+  const BaseMatType& objectives = (const BaseMatType&) objectivesIn;
+  if (objectives.n_elem != state.lambda)
+  {
+    throw std::logic_error("CMAES::Tell(): expected " +
+        std::to_string(state.lambda) + " objective values, got " +
+        std::to_string(objectives.n_elem) + "!");
+  }
+
+  const arma::uvec idx = arma::sort_index(objectives);
+
+  // Recombine the selected steps.
+  BaseMatType step = state.w(0) * state.pStep.col(idx(0));
+  for (size_t j = 1; j < state.mu; ++j)
+    step += state.w(j) * state.pStep.col(idx(j));
+
+  // Track the best candidate before the mean moves.
+  if (objectives(idx(0)) < state.bestObjective)
+  {
+    state.bestObjective = objectives(idx(0));
+    state.best = arma::reshape(state.mPosition +
+        state.sigma * state.pStep.col(idx(0)), state.rows, state.cols);
+  }
+
+  state.mPosition += state.sigma * step;
+
+  // Update step size.
+  state.ps = (1 - state.cs) * state.ps + std::sqrt(
+      state.cs * (2 - state.cs) * state.muEffective) *
+      state.eigvec * diagmat(1 / state.eigval) * state.eigvec.t() * step;
+
+  const ElemType psNorm = arma::norm(state.ps);
+  state.sigma *= std::exp(state.cs / state.ds * (psNorm / state.enn - 1));
+
+  // Update covariance matrix.
+  if ((psNorm / sqrt(1 - std::pow(1 - state.cs, 2 * state.i))) < state.h)
+  {
+    state.pc = (1 - state.cc) * state.pc + std::sqrt(state.cc *
+        (2 - state.cc) * state.muEffective) * step;
+
+    state.C = (1 - state.c1 - state.cmu) * state.C + state.c1 *
+        (state.pc * state.pc.t());
+  }
+  else
+  {
+    state.pc = (1 - state.cc) * state.pc;
+
+    state.C = (1 - state.c1 - state.cmu) * state.C + state.c1 *
+        (state.pc * state.pc.t() + (state.cc * (2 - state.cc)) * state.C);
+  }
+
+  // Apply the rank-mu term as one batched rank-k product over the selected
+  // steps, with the weights folded into the columns.
+  BaseMatType selected(state.mPosition.n_elem, state.mu);
+  for (size_t j = 0; j < state.mu; ++j)
+  {
+    selected.col(j) = std::sqrt(state.cmu * state.w(j)) *
+        state.pStep.col(idx(j));
+  }
+  state.C += selected * selected.t();
+
+  // Repair negative eigenvalues on generations whose covariance the next
+  // scheduled factorization will consume (see Optimize()).
+  if (state.i % state.factorInterval == 0)
+  {
+    arma::eig_sym(state.eigval, state.eigvec, state.C);
+    const arma::uvec negativeEigval = arma::find(state.eigval < 0, 1);
+    if (!negativeEigval.is_empty())
+    {
+      if (negativeEigval(0) == 0)
+      {
+        state.C.zeros();
+      }
+      else
+      {
+        state.C = state.eigvec.cols(0, negativeEigval(0) - 1) *
+            arma::diagmat(state.eigval.subvec(0, negativeEigval(0) - 1)) *
+            state.eigvec.cols(0, negativeEigval(0) - 1).t();
+      }
+    }
+  }
+
+  ++state.i;
+  return state.bestObjective;
+}
+
+//! Return the best candidate observed so far.
+template<typename SelectionPolicyType, typename TransformationPolicyType>
+template<typename MatType>
+MatType CMAES<SelectionPolicyType, TransformationPolicyType>::Best()
+{
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef AskTellState<BaseMatType> StateType;
+
+  if (!askTellState.Has<StateType>())
+    throw std::logic_error("CMAES::Best(): call Initialize() first!");
+
+  return transformationPolicy.Transform(askTellState.As<StateType>().best);
+}
+
+template<typename SelectionPolicyType, typename TransformationPolicyType>
+template<typename MatType>
+void CMAES<SelectionPolicyType, TransformationPolicyType>::SeedDistribution(
+    const MatType& covariance,
+    const double sigma)
+{
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+
+  warmStart = true;
+  warmStartState.Clean();
+  warmStartState.Set<RetainedDistribution<BaseMatType>>(
+      new RetainedDistribution<BaseMatType>());
+  RetainedDistribution<BaseMatType>& retained =
+      warmStartState.As<RetainedDistribution<BaseMatType>>();
+  retained.C = covariance;
+  retained.sigma = (typename BaseMatType::elem_type) sigma;
+}
+
+template<typename SelectionPolicyType, typename TransformationPolicyType>
+template<typename MatType>
+const typename MatTypeTraits<MatType>::BaseMatType&
+CMAES<SelectionPolicyType, TransformationPolicyType>::Covariance() const
+{
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+
+  return warmStartState.As<RetainedDistribution<BaseMatType>>().C;
+}
+
+template<typename SelectionPolicyType, typename TransformationPolicyType>
+template<typename MatType>
+typename MatType::elem_type
+CMAES<SelectionPolicyType, TransformationPolicyType>::DistributionStepSize()
+    const
+{
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+
+  return warmStartState.As<RetainedDistribution<BaseMatType>>().sigma;
+}
+
 } // namespace ens
 
 #endif
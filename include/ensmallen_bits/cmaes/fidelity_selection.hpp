@@ -0,0 +1,83 @@
+/**
+ * @file fidelity_selection.hpp
+ * @author Marcus Edel
+ *
+ * Fidelity-based selection strategy for use in the Evaluation step.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_CMAES_FIDELITY_SELECTION_HPP
+#define ENSMALLEN_CMAES_FIDELITY_SELECTION_HPP
+
+namespace ens {
+
+/**
+ * Score every candidate through the fidelity-parameterized evaluation
+ * contract Evaluate(coordinates, fidelity) (see fidelity_evaluate.hpp) at a
+ * configured fidelity, instead of paying for an exact evaluation.  CMA-ES
+ * only needs the rank ordering of each generation's candidates, so for
+ * objectives whose accuracy/cost tradeoff is exposed through the fidelity
+ * form (fewer simulation steps, data subsets), a fidelity that preserves the
+ * ranking evaluates far more candidates per compute-hour.
+ *
+ * Like RandomSelection, the returned objective values are estimates, so the
+ * single final function call at the end of the optimization (or a re-run
+ * with FullSelection) is needed for an exact objective.  Functions without
+ * the fidelity form fall back to their plain (exact) Evaluate().
+ */
+class FidelitySelection
+{
+ public:
+  /**
+   * Constructor for the fidelity selection strategy.
+   *
+   * @param fidelity The fidelity (in problem-defined units) spent on each
+   *     candidate evaluation (Default 1).
+   */
+  FidelitySelection(const size_t fidelity = 1) : fidelity(fidelity)
+  { /* Nothing to do here. */ }
+
+  //! Get the evaluation fidelity.
+  size_t Fidelity() const { return fidelity; }
+  //! Modify the evaluation fidelity.
+  size_t& Fidelity() { return fidelity; }
+
+  /**
+   * Calculate the objective function at the configured fidelity.
+   *
+   * @tparam FunctionType Type of the function to be evaluated.
+   * @param function Function to optimize.
+   * @param batchSize Batch size to use for each step (unused; the fidelity
+   *     form scores the candidate in one call).
+   * @param terminate Whether optimization should be terminated after this call.
+   * @param iterate starting point.
+   */
+  template<typename FunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  double Select(FunctionType& function,
+                const size_t /* batchSize */,
+                const MatType& iterate,
+                bool& terminate,
+                CallbackTypes&... callbacks)
+  {
+    const typename MatType::elem_type objective = EvaluateWithFidelity(
+        function, iterate, fidelity);
+
+    terminate |= Callback::Evaluate(*this, function, iterate, objective,
+        callbacks...);
+
+    return objective;
+  }
+
+ private:
+  //! The fidelity spent on each candidate evaluation.
+  size_t fidelity;
+};
+
+} // namespace ens
+
+#endif
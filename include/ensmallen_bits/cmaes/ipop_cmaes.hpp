@@ -0,0 +1,160 @@
+/**
+ * @file ipop_cmaes.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the IPOP/BIPOP restart wrapper for the Covariance Matrix
+ * Adaptation Evolution Strategy.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_CMAES_IPOP_CMAES_HPP
+#define ENSMALLEN_CMAES_IPOP_CMAES_HPP
+
+#include "cmaes.hpp"
+
+namespace ens {
+
+/**
+ * IPOP-CMA-ES is a restart strategy for CMA-ES on multimodal problems: each
+ * restart runs CMA-ES to stagnation and then restarts it with the population
+ * size multiplied by a constant factor, so that later restarts search more
+ * globally.  The BIPOP variant additionally interleaves a second regime of
+ * restarts with small, randomly drawn population sizes, balancing the
+ * evaluation budget between the two regimes.
+ *
+ * The wrapper drives the restarts through the ask/tell interface of the
+ * wrapped CMAES instance, so several restarts can be raced concurrently in
+ * lockstep generations: candidate evaluations share the OpenMP thread pool,
+ * and a racing run that trails the leader for too many consecutive
+ * generations is killed early and its slot given to the next restart of the
+ * schedule.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @inproceedings{Auger2005,
+ *   author    = {Auger, Anne and Hansen, Nikolaus},
+ *   title     = {A Restart {CMA} Evolution Strategy With Increasing
+ *                Population Size},
+ *   booktitle = {Proceedings of the IEEE Congress on Evolutionary
+ *                Computation (CEC)},
+ *   pages     = {1769--1776},
+ *   year      = {2005}
+ * }
+ * @endcode
+ *
+ * IPOPCMAES can optimize separable functions.  For more details, see the
+ * documentation on function types included with this distribution or on the
+ * ensmallen website.
+ *
+ * @tparam CMAESType The wrapped CMA-ES variant (its selection and
+ *     transformation policies carry over to every restart).
+ */
+template<typename CMAESType = CMAES<>>
+class IPOPCMAES
+{
+ public:
+  /**
+   * Construct the IPOP-CMA-ES optimizer.  The wrapped CMAES instance
+   * supplies the per-restart parameters: its population size is the size of
+   * the first restart (0 uses the CMA-ES default), its maximum number of
+   * iterations caps the generations of each restart, and its tolerance
+   * controls per-restart stagnation detection.
+   *
+   * @param cmaes Configured CMAES instance to restart.
+   * @param populationFactor Factor by which the population size grows with
+   *     each restart of the large regime.
+   * @param maxRestarts Maximum number of restarts.
+   * @param bipop If true, interleave small-population restarts with the
+   *     growing-population schedule (BIPOP-CMA-ES).
+   * @param raceSize Number of restarts raced concurrently in lockstep
+   *     generations (1 runs the restarts one after another).
+   * @param racePatience Number of consecutive generations a racing run may
+   *     trail the leader before it is killed early.
+   */
+  IPOPCMAES(const CMAESType& cmaes = CMAESType(),
+            const double populationFactor = 2,
+            const size_t maxRestarts = 9,
+            const bool bipop = false,
+            const size_t raceSize = 1,
+            const size_t racePatience = 20);
+
+  /**
+   * Optimize the given function with restarted CMA-ES. The given starting
+   * point will be modified to store the finishing point of the algorithm,
+   * and the best objective value over all restarts is returned.
+   *
+   * @tparam SeparableFunctionType Type of the function to be optimized.
+   * @tparam MatType Type of matrix to optimize.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to optimize.
+   * @param iterate Starting point (will be modified).
+   * @param callbacks Callback functions.
+   * @return Objective value of the final point.
+   */
+  template<typename SeparableFunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(SeparableFunctionType& function,
+                                       MatType& iterate,
+                                       CallbackTypes&&... callbacks);
+
+  //! Get the wrapped CMAES instance.
+  const CMAESType& BaseOptimizer() const { return cmaes; }
+  //! Modify the wrapped CMAES instance.
+  CMAESType& BaseOptimizer() { return cmaes; }
+
+  //! Get the population growth factor.
+  double PopulationFactor() const { return populationFactor; }
+  //! Modify the population growth factor.
+  double& PopulationFactor() { return populationFactor; }
+
+  //! Get the maximum number of restarts.
+  size_t MaxRestarts() const { return maxRestarts; }
+  //! Modify the maximum number of restarts.
+  size_t& MaxRestarts() { return maxRestarts; }
+
+  //! Get whether the BIPOP schedule is used.
+  bool BIPOP() const { return bipop; }
+  //! Modify whether the BIPOP schedule is used.
+  bool& BIPOP() { return bipop; }
+
+  //! Get the number of concurrently raced restarts.
+  size_t RaceSize() const { return raceSize; }
+  //! Modify the number of concurrently raced restarts.
+  size_t& RaceSize() { return raceSize; }
+
+  //! Get the racing patience in generations.
+  size_t RacePatience() const { return racePatience; }
+  //! Modify the racing patience in generations.
+  size_t& RacePatience() { return racePatience; }
+
+ private:
+  //! The wrapped CMAES instance; each restart starts from a copy of it.
+  CMAESType cmaes;
+
+  //! The population growth factor of the large regime.
+  double populationFactor;
+
+  //! The maximum number of restarts.
+  size_t maxRestarts;
+
+  //! Whether the BIPOP schedule is used.
+  bool bipop;
+
+  //! The number of concurrently raced restarts.
+  size_t raceSize;
+
+  //! The racing patience in generations.
+  size_t racePatience;
+};
+
+} // namespace ens
+
+// Include implementation.
+#include "ipop_cmaes_impl.hpp"
+
+#endif
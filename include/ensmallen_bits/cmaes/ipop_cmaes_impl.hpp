@@ -0,0 +1,262 @@
+/**
+ * @file ipop_cmaes_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the IPOP/BIPOP restart wrapper for the Covariance Matrix
+ * Adaptation Evolution Strategy.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_CMAES_IPOP_CMAES_IMPL_HPP
+#define ENSMALLEN_CMAES_IPOP_CMAES_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "ipop_cmaes.hpp"
+
+#include <ensmallen_bits/function.hpp>
+
+namespace ens {
+
+template<typename CMAESType>
+IPOPCMAES<CMAESType>::IPOPCMAES(const CMAESType& cmaes,
+                                const double populationFactor,
+                                const size_t maxRestarts,
+                                const bool bipop,
+                                const size_t raceSize,
+                                const size_t racePatience) :
+    cmaes(cmaes),
+    populationFactor(populationFactor),
+    maxRestarts(maxRestarts),
+    bipop(bipop),
+    raceSize(raceSize),
+    racePatience(racePatience)
+{ /* Nothing to do. */ }
+
+//! Optimize the function (minimize).
+template<typename CMAESType>
+template<typename SeparableFunctionType,
+         typename MatType,
+         typename... CallbackTypes>
+typename MatType::elem_type IPOPCMAES<CMAESType>::Optimize(
+    SeparableFunctionType& function,
+    MatType& iterateIn,
+    CallbackTypes&&... callbacks)
+{
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+
+  // Make sure that we have the methods that we need.
+  traits::CheckArbitrarySeparableFunctionTypeAPI<
+      SeparableFunctionType, BaseMatType>();
+  RequireDenseFloatingPointType<BaseMatType>();
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+
+  // The population size of the first restart (matching the CMA-ES default
+  // when unset), the per-restart generation cap and the stagnation
+  // parameters all come from the wrapped instance.
+  const size_t lambda0 = (cmaes.PopulationSize() != 0) ?
+      cmaes.PopulationSize() :
+      (size_t) ((4 + std::round(3 * std::log(iterate.n_elem))) * 10);
+  const size_t maxGenerations = cmaes.MaxIterations();
+  const double tolerance = cmaes.Tolerance();
+  const size_t numFunctions = function.NumFunctions();
+  const size_t batchSize = cmaes.BatchSize();
+
+  // One concurrently raced restart.
+  struct Run
+  {
+    CMAESType opt;
+    bool active = false;
+    size_t lambda = 0;
+    size_t generation = 0;
+    size_t stagnation = 0;
+    size_t trailing = 0;
+    size_t patience = 0;
+    //! Whether the run belongs to the large (growing) regime.
+    bool large = true;
+    ElemType best = std::numeric_limits<ElemType>::max();
+    ElemType lastBest = std::numeric_limits<ElemType>::max();
+  };
+  std::vector<Run> runs(std::max<size_t>(1, raceSize));
+
+  // Restart bookkeeping: the number of restarts started so far, the number
+  // of large-regime restarts (which sets the growing population size), and
+  // the evaluations spent in each regime (used by the BIPOP schedule to
+  // balance the two budgets).
+  size_t started = 0;
+  size_t largeRestarts = 0;
+  double largeBudget = 0;
+  double smallBudget = 0;
+
+  // Start the next restart of the schedule in the given slot; returns false
+  // once the restart budget is exhausted.
+  auto startRun = [&](Run& run)
+  {
+    if (started > maxRestarts)
+      return false;
+
+    // The large regime grows the population by populationFactor with each
+    // of its restarts.  Under BIPOP the regime with the smaller spent
+    // budget goes next; small-regime restarts draw a population size
+    // between lambda0 and half the current large population.
+    const size_t lambdaLarge = (size_t) (lambda0 *
+        std::pow(populationFactor, largeRestarts));
+    run.large = !bipop || (largeBudget <= smallBudget) ||
+        (lambdaLarge / 2 <= lambda0);
+    if (run.large)
+    {
+      run.lambda = lambdaLarge;
+      ++largeRestarts;
+    }
+    else
+    {
+      const double u = arma::randu();
+      run.lambda = (size_t) (lambda0 * std::pow(
+          0.5 * lambdaLarge / lambda0, u * u));
+    }
+
+    run.opt = cmaes;
+    run.opt.PopulationSize() = run.lambda;
+    run.opt.Initialize(iterate);
+    run.generation = 0;
+    run.stagnation = 0;
+    run.trailing = 0;
+    run.patience = 10 + (30 * iterate.n_elem / run.lambda) + 1;
+    run.best = std::numeric_limits<ElemType>::max();
+    run.lastBest = std::numeric_limits<ElemType>::max();
+    run.active = true;
+    ++started;
+    return true;
+  };
+
+  // Finish a run and charge its evaluations to its regime's budget.
+  auto finishRun = [&](Run& run)
+  {
+    run.active = false;
+    (run.large ? largeBudget : smallBudget) +=
+        (double) run.lambda * run.generation;
+  };
+
+  ElemType overallObjective = std::numeric_limits<ElemType>::max();
+  BaseMatType overallBest = iterate;
+
+  // Controls early termination of the optimization process.
+  bool terminate = false;
+
+  Callback::BeginOptimization(*this, function, iterate, callbacks...);
+
+  for (size_t slot = 0; slot < runs.size(); ++slot)
+    startRun(runs[slot]);
+
+  // Advance all active runs in lockstep generations.
+  bool anyActive = true;
+  while (anyActive && !terminate)
+  {
+    anyActive = false;
+    for (size_t slot = 0; slot < runs.size() && !terminate; ++slot)
+    {
+      Run& run = runs[slot];
+      if (!run.active)
+        continue;
+      anyActive = true;
+
+      // Sample and evaluate the next population of this restart.  The
+      // candidate evaluations are independent, so they share the OpenMP
+      // thread pool; callbacks are not thread-safe, so the Evaluate events
+      // are raised serially afterwards.
+      const BaseMatType population =
+          run.opt.template Ask<BaseMatType>();
+      BaseMatType objectives(run.lambda, 1);
+
+      ENS_PRAGMA_OMP_PARALLEL_FOR
+      for (ptrdiff_t j = 0; j < (ptrdiff_t) run.lambda; ++j)
+      {
+        const BaseMatType candidate = arma::reshape(population.col(j),
+            iterate.n_rows, iterate.n_cols);
+        ElemType objective = 0;
+        for (size_t f = 0; f < numFunctions; f += batchSize)
+        {
+          const size_t effectiveBatchSize = std::min(batchSize,
+              numFunctions - f);
+          objective += function.Evaluate(candidate, f, effectiveBatchSize);
+        }
+        objectives(j) = objective;
+      }
+
+      for (size_t j = 0; j < run.lambda; ++j)
+      {
+        terminate |= Callback::Evaluate(*this, function,
+            BaseMatType(arma::reshape(population.col(j), iterate.n_rows,
+            iterate.n_cols)), objectives(j), callbacks...);
+      }
+
+      run.best = run.opt.Tell(objectives);
+      ++run.generation;
+
+      if (run.best < overallObjective)
+      {
+        overallObjective = run.best;
+        overallBest = run.opt.template Best<BaseMatType>();
+        terminate |= Callback::StepTaken(*this, function, overallBest,
+            callbacks...);
+      }
+
+      // Per-restart stagnation detection, mirroring CMAES::Optimize().
+      if (std::abs(run.lastBest - run.best) < tolerance)
+        ++run.stagnation;
+      else
+        run.stagnation = 0;
+      run.lastBest = run.best;
+
+      if ((maxGenerations != 0 && run.generation >= maxGenerations) ||
+          run.stagnation > run.patience)
+      {
+        Info << "IPOP-CMA-ES: restart " << started << " of lambda "
+            << run.lambda << " stopped after " << run.generation
+            << " generations, objective " << run.best << "." << std::endl;
+
+        finishRun(run);
+        startRun(run);
+        continue;
+      }
+
+      // Racing: a run that trails the best of the other active runs for
+      // racePatience consecutive generations is dominated and killed early.
+      ElemType leader = std::numeric_limits<ElemType>::max();
+      for (size_t other = 0; other < runs.size(); ++other)
+      {
+        if (other != slot && runs[other].active)
+          leader = std::min(leader, runs[other].best);
+      }
+
+      if (run.best > leader)
+        ++run.trailing;
+      else
+        run.trailing = 0;
+
+      if (run.trailing >= racePatience)
+      {
+        Info << "IPOP-CMA-ES: restart of lambda " << run.lambda
+            << " dominated after " << run.generation
+            << " generations; killed." << std::endl;
+
+        finishRun(run);
+        startRun(run);
+      }
+    }
+  }
+
+  iterate = overallBest;
+
+  Callback::EndOptimization(*this, function, iterate, callbacks...);
+  return overallObjective;
+}
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,202 @@
+/**
+ * @file racing_selection.hpp
+ * @author Marcus Edel
+ *
+ * Racing-based adaptive selection strategy for use in the Evaluation step.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_CMAES_RACING_SELECTION_HPP
+#define ENSMALLEN_CMAES_RACING_SELECTION_HPP
+
+namespace ens {
+
+/**
+ * Estimate each candidate's objective on an incrementally growing random
+ * subset of the separable terms and stop sampling as soon as the estimate is
+ * statistically resolved.  After each round of sampling, a Hoeffding bound
+ * gives a confidence radius for the scaled estimate; sampling stops once the
+ * radius is smaller than half the gap to the nearest estimate returned for
+ * the other recent candidates, so that the rank ordering of the population
+ * is already decided with the configured confidence.  On easy generations
+ * with well-separated candidates this uses a small fraction of the terms;
+ * when candidates are close (or the objective is noisy), sampling keeps
+ * growing, up to a full evaluation.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @article{MaronMoore1997,
+ *   author  = {Maron, Oded and Moore, Andrew W.},
+ *   title   = {The Racing Algorithm: Model Selection for Lazy Learners},
+ *   journal = {Artificial Intelligence Review},
+ *   volume  = {11},
+ *   pages   = {193--225},
+ *   year    = {1997}
+ * }
+ * @endcode
+ *
+ * Note that this policy is stateful (it remembers the estimates of recent
+ * candidates to measure rank gaps), so it must not be combined with
+ * `ParallelEvaluation()`, where Select() is called concurrently.
+ */
+class RacingSelection
+{
+ public:
+  /**
+   * Constructor for the racing selection strategy.
+   *
+   * @param fraction The fraction of separable terms every estimate starts
+   *     from before the racing test is applied (Default 0.1).
+   * @param confidence The confidence level of the Hoeffding bound used to
+   *     resolve rank orderings (Default 0.95).
+   * @param termRange The range of a single separable term, used by the
+   *     Hoeffding bound; 0 estimates the range from the observed terms
+   *     (Default 0).
+   * @param windowSize Number of recent candidate estimates kept for
+   *     measuring rank gaps; use the population size if known (Default 64).
+   */
+  RacingSelection(const double fraction = 0.1,
+                  const double confidence = 0.95,
+                  const double termRange = 0,
+                  const size_t windowSize = 64) :
+      fraction(fraction),
+      confidence(confidence),
+      termRange(termRange),
+      windowSize(windowSize),
+      minTerm(std::numeric_limits<double>::max()),
+      maxTerm(-std::numeric_limits<double>::max())
+  { /* Nothing to do here. */ }
+
+  //! Get the initial sampling fraction.
+  double Fraction() const { return fraction; }
+  //! Modify the initial sampling fraction.
+  double& Fraction() { return fraction; }
+
+  //! Get the confidence level.
+  double Confidence() const { return confidence; }
+  //! Modify the confidence level.
+  double& Confidence() { return confidence; }
+
+  //! Get the separable term range (0 estimates it from observations).
+  double TermRange() const { return termRange; }
+  //! Modify the separable term range.
+  double& TermRange() { return termRange; }
+
+  //! Get the rank-gap window size.
+  size_t WindowSize() const { return windowSize; }
+  //! Modify the rank-gap window size.
+  size_t& WindowSize() { return windowSize; }
+
+  /**
+   * Estimate the objective function on a racing schedule of random
+   * separable terms.
+   *
+   * @tparam SeparableFunctionType Type of the function to be evaluated.
+   * @param function Function to optimize.
+   * @param batchSize Batch size to use for each step.
+   * @param terminate Whether optimization should be terminated after this call.
+   * @param iterate starting point.
+   */
+  template<typename SeparableFunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  double Select(SeparableFunctionType& function,
+                const size_t batchSize,
+                const MatType& iterate,
+                bool& terminate,
+                CallbackTypes&... callbacks)
+  {
+    // Find the number of functions to use.
+    const size_t numFunctions = function.NumFunctions();
+    const double delta = 1.0 - confidence;
+
+    size_t sampled = 0;
+    double sum = 0;
+    double estimate = 0;
+
+    // Every estimate starts from the configured fraction of the terms;
+    // each subsequent racing round doubles the sample size.
+    size_t target = std::max(batchSize,
+        (size_t) std::ceil(fraction * numFunctions));
+    while (true)
+    {
+      for (size_t f = sampled; f < target && f < numFunctions;
+          f += batchSize)
+      {
+        const size_t selection = arma::as_scalar(arma::randi<arma::uvec>(
+            1, arma::distr_param(0, (int) numFunctions - 1)));
+        const size_t effectiveBatchSize = std::min(batchSize,
+            numFunctions - selection);
+
+        const double value = function.Evaluate(iterate, selection,
+            effectiveBatchSize);
+        sum += value;
+        sampled += effectiveBatchSize;
+
+        // Track the observed per-term range for the Hoeffding bound.
+        const double term = value / effectiveBatchSize;
+        minTerm = std::min(minTerm, term);
+        maxTerm = std::max(maxTerm, term);
+
+        terminate |= Callback::Evaluate(*this, f, iterate, sum,
+            callbacks...);
+      }
+
+      estimate = sum * numFunctions / sampled;
+      if (sampled >= numFunctions)
+        break;
+
+      // Hoeffding confidence radius of the scaled estimate.
+      const double range = (termRange != 0) ? termRange :
+          (maxTerm - minTerm);
+      const double radius = numFunctions * range *
+          std::sqrt(std::log(2.0 / delta) / (2.0 * sampled));
+
+      // The rank ordering against the other recent candidates is resolved
+      // once the radius is below half the gap to the nearest of their
+      // estimates.
+      double gap = std::numeric_limits<double>::max();
+      for (size_t j = 0; j < window.size(); ++j)
+        gap = std::min(gap, std::abs(estimate - window[j]));
+
+      if (radius <= gap / 2)
+        break;
+
+      target = std::min(numFunctions, 2 * target);
+    }
+
+    // Remember the estimate for the rank gaps of the next candidates.
+    window.push_back(estimate);
+    if (window.size() > windowSize)
+      window.erase(window.begin());
+
+    return estimate;
+  }
+
+ private:
+  //! The initial sampling fraction.
+  double fraction;
+
+  //! The confidence level of the Hoeffding bound.
+  double confidence;
+
+  //! The range of a single separable term (0 estimates it).
+  double termRange;
+
+  //! The number of recent candidate estimates kept.
+  size_t windowSize;
+
+  //! The observed per-term range.
+  double minTerm, maxTerm;
+
+  //! The estimates of the most recent candidates.
+  std::vector<double> window;
+};
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,279 @@
+/**
+ * @file surrogate_selection.hpp
+ * @author Marcus Edel
+ *
+ * Surrogate-assisted selection strategy for use in the Evaluation step,
+ * in the spirit of lq-CMA-ES.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_CMAES_SURROGATE_SELECTION_HPP
+#define ENSMALLEN_CMAES_SURROGATE_SELECTION_HPP
+
+namespace ens {
+
+/**
+ * Rank most candidates on a cheap quadratic surrogate of the objective and
+ * call the true objective only when it matters.  A diagonal-quadratic model
+ * (features 1, x and x^2) is fit by ridge regression to an archive of past
+ * true evaluations; once the model is trained and its recent relative error
+ * is below the configured tolerance, a candidate is evaluated with the true
+ * objective only if the surrogate ranks it at least as good as the best true
+ * value seen so far (promising candidates are always verified), or if it
+ * falls on the periodic control schedule that keeps the error estimate
+ * fresh.  Everything else is ranked on the surrogate prediction.  On smooth
+ * objectives this skips the large majority of true evaluations without
+ * changing which candidates win selection.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @inproceedings{Hansen2019,
+ *   author    = {Hansen, Nikolaus},
+ *   title     = {A Global Surrogate Assisted {CMA-ES}},
+ *   booktitle = {Proceedings of the Genetic and Evolutionary Computation
+ *                Conference (GECCO)},
+ *   pages     = {664--672},
+ *   year      = {2019}
+ * }
+ * @endcode
+ *
+ * Note that this policy is stateful (it accumulates the evaluation archive
+ * across generations), so it must not be combined with
+ * `ParallelEvaluation()`, where Select() is called concurrently.
+ */
+class SurrogateSelection
+{
+ public:
+  /**
+   * Constructor for the surrogate-assisted selection strategy.
+   *
+   * @param controlPeriod Every controlPeriod-th candidate is evaluated with
+   *     the true objective even when the surrogate is trusted, to keep the
+   *     error estimate fresh (Default 5).
+   * @param relativeTolerance Maximum smoothed relative error of the
+   *     surrogate at control evaluations before predictions are trusted
+   *     (Default 0.1).
+   * @param maxArchiveSize Maximum number of true evaluations kept for
+   *     fitting the surrogate; the oldest entries are overwritten first
+   *     (Default 1024).
+   */
+  SurrogateSelection(const size_t controlPeriod = 5,
+                     const double relativeTolerance = 0.1,
+                     const size_t maxArchiveSize = 1024) :
+      controlPeriod(controlPeriod),
+      relativeTolerance(relativeTolerance),
+      maxArchiveSize(maxArchiveSize),
+      archiveSize(0),
+      nextSlot(0),
+      trained(false),
+      confident(false),
+      meanError(0),
+      bestObjective(std::numeric_limits<double>::max()),
+      calls(0),
+      trueEvaluations(0)
+  { /* Nothing to do here. */ }
+
+  //! Get the control evaluation period.
+  size_t ControlPeriod() const { return controlPeriod; }
+  //! Modify the control evaluation period.
+  size_t& ControlPeriod() { return controlPeriod; }
+
+  //! Get the relative error tolerance.
+  double RelativeTolerance() const { return relativeTolerance; }
+  //! Modify the relative error tolerance.
+  double& RelativeTolerance() { return relativeTolerance; }
+
+  //! Get the maximum archive size.
+  size_t MaxArchiveSize() const { return maxArchiveSize; }
+  //! Modify the maximum archive size.
+  size_t& MaxArchiveSize() { return maxArchiveSize; }
+
+  //! Get the number of Select() calls made so far.
+  size_t Calls() const { return calls; }
+
+  //! Get the number of true objective evaluations made so far.
+  size_t TrueEvaluations() const { return trueEvaluations; }
+
+  /**
+   * Calculate the objective function, either with the true objective or
+   * with the quadratic surrogate if its predictions are trusted and the
+   * candidate is neither promising nor due for a control evaluation.
+   *
+   * @tparam SeparableFunctionType Type of the function to be evaluated.
+   * @param function Function to optimize.
+   * @param batchSize Batch size to use for each step.
+   * @param terminate Whether optimization should be terminated after this call.
+   * @param iterate starting point.
+   */
+  template<typename SeparableFunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  double Select(SeparableFunctionType& function,
+                const size_t batchSize,
+                const MatType& iterate,
+                bool& terminate,
+                CallbackTypes&... callbacks)
+  {
+    const arma::vec x = arma::conv_to<arma::vec>::from(
+        arma::vectorise(iterate));
+    if (features.n_rows != 2 * x.n_elem + 1)
+      Reset(x.n_elem);
+
+    ++calls;
+    double predicted = 0;
+    if (trained)
+    {
+      predicted = Predict(x);
+
+      // Candidates the surrogate ranks at least as good as the best true
+      // value seen so far must be verified, since they may win selection;
+      // the periodic control evaluations keep the error estimate fresh.
+      const bool control = (calls % controlPeriod == 0);
+      if (confident && !control && predicted > bestObjective)
+        return predicted;
+    }
+
+    const double objective = Evaluate(function, batchSize, iterate,
+        terminate, callbacks...);
+
+    if (trained)
+    {
+      // Measure the prediction against the true value and update the
+      // smoothed relative error the trust decision is based on.
+      const double scale = std::max(std::max(std::abs(objective),
+          std::abs(predicted)), 1e-12);
+      meanError = 0.75 * meanError +
+          0.25 * (std::abs(predicted - objective) / scale);
+      confident = (meanError < relativeTolerance);
+    }
+
+    Insert(x, objective);
+    return objective;
+  }
+
+ private:
+  //! Evaluate the true objective function (mirrors FullSelection).
+  template<typename SeparableFunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  double Evaluate(SeparableFunctionType& function,
+                  const size_t batchSize,
+                  const MatType& iterate,
+                  bool& terminate,
+                  CallbackTypes&... callbacks)
+  {
+    ++trueEvaluations;
+
+    // Find the number of functions to use.
+    const size_t numFunctions = function.NumFunctions();
+
+    typename MatType::elem_type objective = 0;
+    for (size_t f = 0; f < numFunctions; f += batchSize)
+    {
+      const size_t effectiveBatchSize = std::min(batchSize, numFunctions - f);
+      objective += function.Evaluate(iterate, f, effectiveBatchSize);
+
+      terminate |= Callback::Evaluate(*this, f, iterate, objective,
+          callbacks...);
+    }
+
+    return objective;
+  }
+
+  //! Reset the archive and the model for the given problem dimension.
+  void Reset(const size_t dimension)
+  {
+    features.set_size(2 * dimension + 1, maxArchiveSize);
+    objectives.set_size(maxArchiveSize);
+    archiveSize = 0;
+    nextSlot = 0;
+    trained = false;
+    confident = false;
+    meanError = 0;
+    bestObjective = std::numeric_limits<double>::max();
+  }
+
+  //! The diagonal-quadratic feature map [1; x; x^2].
+  arma::vec Features(const arma::vec& x) const
+  {
+    arma::vec phi(2 * x.n_elem + 1);
+    phi(0) = 1;
+    phi.subvec(1, x.n_elem) = x;
+    phi.subvec(x.n_elem + 1, 2 * x.n_elem) = arma::square(x);
+    return phi;
+  }
+
+  //! Predict the objective of the given point with the surrogate.
+  double Predict(const arma::vec& x) const
+  {
+    return arma::dot(beta, Features(x));
+  }
+
+  //! Add a true evaluation to the archive and refit the surrogate.
+  void Insert(const arma::vec& x, const double objective)
+  {
+    features.col(nextSlot) = Features(x);
+    objectives(nextSlot) = objective;
+    nextSlot = (nextSlot + 1) % maxArchiveSize;
+    archiveSize = std::min(archiveSize + 1, maxArchiveSize);
+
+    if (objective < bestObjective)
+      bestObjective = objective;
+
+    // Refit by ridge regression on the normal equations once the archive
+    // overdetermines the model.
+    if (archiveSize >= features.n_rows + 2)
+    {
+      const arma::mat phi = features.cols(0, archiveSize - 1);
+      const arma::vec y = objectives.subvec(0, archiveSize - 1);
+      arma::mat normal = phi * phi.t();
+      normal.diag() += 1e-6;
+      trained = arma::solve(beta, normal, phi * y);
+    }
+  }
+
+  //! The control evaluation period.
+  size_t controlPeriod;
+
+  //! The relative error tolerance.
+  double relativeTolerance;
+
+  //! The maximum archive size.
+  size_t maxArchiveSize;
+
+  //! The archive of feature vectors of past true evaluations (one column
+  //! per evaluation) and their objective values, used as a ring buffer.
+  arma::mat features;
+  arma::vec objectives;
+  size_t archiveSize;
+  size_t nextSlot;
+
+  //! The surrogate coefficients.
+  arma::vec beta;
+
+  //! Whether the surrogate has been fit.
+  bool trained;
+
+  //! Whether the surrogate predictions are currently trusted.
+  bool confident;
+
+  //! The smoothed relative error of the surrogate at control evaluations.
+  double meanError;
+
+  //! The best true objective value seen so far.
+  double bestObjective;
+
+  //! The number of Select() calls made so far.
+  size_t calls;
+
+  //! The number of true objective evaluations made so far.
+  size_t trueEvaluations;
+};
+
+} // namespace ens
+
+#endif
@@ -76,61 +76,51 @@ public:
    */
   MatType Transform(const MatType& x)
   {
-    typedef typename MatType::elem_type ElemType;
-    double diff, al, au, xlow, xup, r;
-    size_t Bi, Bj;
+    // The per-element constants only depend on the bound pattern, so they
+    // are broadcast to the transformed shape once and reused; the
+    // transformation itself then runs as whole-matrix kernels instead of
+    // an element-by-element loop.
+    if (al.n_rows != x.n_rows || al.n_cols != x.n_cols ||
+        !arma::approx_equal(cachedLower, lowerBound, "absdiff", 0) ||
+        !arma::approx_equal(cachedUpper, upperBound, "absdiff", 0))
+      BuildCache(x.n_rows, x.n_cols);
+
     MatType y = x;
-    for (size_t i = 0; i < x.n_rows; i++)
-    {
-      Bi = (i < lowerBound.n_rows) ? i : (lowerBound.n_rows - 1);
-      for (size_t j = 0; j < x.n_cols; j++)
-      {
-        Bj = (j < lowerBound.n_cols) ? j : (lowerBound.n_cols - 1);
-
-        diff = (upperBound(Bi, Bj) - lowerBound(Bi, Bj)) / 2.0;
-        al = std::min(diff, (1 + std::abs(lowerBound(Bi, Bj))) / 20.0);
-        au = std::min(diff, (1 + std::abs(upperBound(Bi, Bj))) / 20.0);
-        xlow = lowerBound(Bi, Bj) - 2 * al - diff;
-        xup = upperBound(Bi, Bj) + 2 * au + diff;
-        r = 2 * (2 * diff + al + au);
-
-        // Shift y into feasible pre-image.
-        if (y(i, j) < xlow)
-        {
-          y(i,j) += (ElemType)(r * (1 + (int)((xlow - y(i, j)) / r)));
-        }
-        if (y(i, j) > xup)
-        {
-          y(i, j) -= (ElemType)(r * (1 + (int)((y(i, j) - xup) / r)));
-        }
-        if (y(i, j) < lowerBound(Bi, Bj) - al)
-        {
-          y(i, j) += (ElemType)(2 * (lowerBound(Bi, Bj) - al - y(i, j)));
-        }
-        if (y(i, j) > upperBound(Bi, Bj) + au)
-        {
-          y(i, j) -= (ElemType)(2 * (y(i, j) - upperBound(Bi, Bj) - au));
-        }
-
-        // Boundary transformation.
-        if (y(i, j) < lowerBound(Bi, Bj) + al)
-        {
-          y(i, j) = (ElemType)(lowerBound(Bi, Bj) +
-            (y(i, j) - (lowerBound(Bi, Bj) - al)) *
-            (y(i, j) - (lowerBound(Bi, Bj) - al)) / 4.0 / al);
-        }
-        else if (y(i,j) > upperBound(Bi,Bj) - au)
-        {
-          y(i, j) = (ElemType)(upperBound(Bi, Bj) -
-            (y(i, j) - (upperBound(Bi, Bj) + au)) *
-            (y(i, j) - (upperBound(Bi, Bj) + au)) / 4.0 / au);
-        }
-      }
-    }
+
+    // Shift y into the feasible pre-image (periodic fold, then
+    // reflection); each mask selects the elements the corresponding
+    // element-wise branch would have touched.
+    MatType mask = arma::conv_to<MatType>::from(y < xlow);
+    y += mask % (r % (1 + arma::floor((xlow - y) / r)));
+    mask = arma::conv_to<MatType>::from(y > xup);
+    y -= mask % (r % (1 + arma::floor((y - xup) / r)));
+    mask = arma::conv_to<MatType>::from(y < low - al);
+    y += 2 * (mask % (low - al - y));
+    mask = arma::conv_to<MatType>::from(y > up + au);
+    y -= 2 * (mask % (y - up - au));
+
+    // Boundary transformation: quadratic smoothing inside the margins,
+    // identity in between.
+    const MatType lowerMask = arma::conv_to<MatType>::from(y < low + al);
+    const MatType upperMask =
+        arma::conv_to<MatType>::from(y > up - au) % (1 - lowerMask);
+    y = lowerMask % (low + arma::square(y - (low - al)) / (4 * al)) +
+        upperMask % (up - arma::square(y - (up + au)) / (4 * au)) +
+        (1 - lowerMask - upperMask) % y;
 
     return y;
   }
 
+  /**
+   * Transform the coordinates into a caller-provided buffer.  The boundary
+   * transformation itself still builds intermediate masks, but the result
+   * lands in the buffer without an extra copy.
+   *
+   * @param x Input coordinates.
+   * @param y Output buffer for the transformed coordinates.
+   */
+  void Transform(const MatType& x, MatType& y) { y = Transform(x); }
+
   /**
    * Return a suitable initial step size.
    *
@@ -150,11 +140,50 @@ public:
   MatType& UpperBound() { return upperBound; }
 
 private:
+  /**
+   * Broadcast the bound pattern to the given shape and precompute the
+   * per-element constants of the transformation.
+   */
+  void BuildCache(const size_t rows, const size_t cols)
+  {
+    low.set_size(rows, cols);
+    up.set_size(rows, cols);
+    for (size_t i = 0; i < rows; i++)
+    {
+      const size_t bi = (i < lowerBound.n_rows) ? i : (lowerBound.n_rows - 1);
+      for (size_t j = 0; j < cols; j++)
+      {
+        const size_t bj = (j < lowerBound.n_cols) ? j :
+            (lowerBound.n_cols - 1);
+        low(i, j) = lowerBound(bi, bj);
+        up(i, j) = upperBound(bi, bj);
+      }
+    }
+
+    const MatType diff = (up - low) / 2;
+    al = arma::min(diff, (1 + arma::abs(low)) / 20);
+    au = arma::min(diff, (1 + arma::abs(up)) / 20);
+    xlow = low - 2 * al - diff;
+    xup = up + 2 * au + diff;
+    r = 2 * (2 * diff + al + au);
+
+    cachedLower = lowerBound;
+    cachedUpper = upperBound;
+  }
+
   //! Lower bound of decision variables.
   MatType lowerBound;
 
   //! Upper bound of decision variables.
   MatType upperBound;
+
+  //! The bounds the cached constants were built from; the cache is rebuilt
+  //! whenever the bounds are modified through the accessors.
+  MatType cachedLower, cachedUpper;
+
+  //! The bound pattern and the derived per-element constants of the
+  //! transformation, broadcast to the last transformed shape.
+  MatType low, up, al, au, xlow, xup, r;
 };
 
 } // namespace ens
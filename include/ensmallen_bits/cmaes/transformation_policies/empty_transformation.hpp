@@ -34,6 +34,15 @@ class EmptyTransformation
    */
   MatType Transform(const MatType& x) { return x; }
 
+  /**
+   * Transform the coordinates into a caller-provided buffer; the in-place
+   * copy performs no allocation when the buffer already has the right size.
+   *
+   * @param x Input coordinates.
+   * @param y Output buffer for the transformed coordinates.
+   */
+  void Transform(const MatType& x, MatType& y) { y = x; }
+
   /**
    * Return a suitable initial step size.
    *
@@ -16,6 +16,11 @@
 #ifndef ENSMALLEN_CNE_CNE_HPP
 #define ENSMALLEN_CNE_CNE_HPP
 
+#include <ensmallen_bits/utility/halton_sequence.hpp>
+#include <ensmallen_bits/utility/packed_population.hpp>
+#include <ensmallen_bits/utility/philox_generator.hpp>
+#include <ensmallen_bits/utility/stagnation_detector.hpp>
+
 namespace ens {
 
 /**
@@ -147,16 +152,74 @@ class CNE
   //! Modify the tolerance.
   double& Tolerance() { return tolerance; }
 
+  //! Get the stagnation detector used for early termination.
+  const StagnationDetector& Stagnation() const { return stagnation; }
+  //! Modify the stagnation detector used for early termination.  Disabled
+  //! by default; set its Patience() or MinDiversity() to terminate once the
+  //! best fitness stops improving or the population collapses, instead of
+  //! running out the generation budget.
+  StagnationDetector& Stagnation() { return stagnation; }
+
+  //! Get the random number generator.
+  const PhiloxGenerator& Generator() const { return generator; }
+  //! Modify the random number generator (e.g. to seed it for reproducibility).
+  PhiloxGenerator& Generator() { return generator; }
+
+  //! Get whether the initial population is drawn from a scrambled Halton
+  //! low-discrepancy sequence instead of pseudo-random Gaussian draws.
+  bool QuasiRandomInit() const { return quasiRandomInit; }
+  //! Modify whether the initial population is drawn quasi-randomly.
+  bool& QuasiRandomInit() { return quasiRandomInit; }
+
+  //! Get whether the candidate fitness evaluations run in parallel with
+  //! OpenMP (requires Evaluate() to be thread-safe).
+  bool ParallelEvaluation() const { return parallelEvaluation; }
+  //! Modify whether the candidate fitness evaluations run in parallel.
+  bool& ParallelEvaluation() { return parallelEvaluation; }
+
+  //! Get the forced re-evaluation cadence, in generations.  Candidates that
+  //! were not modified by crossover or mutation keep their cached fitness; a
+  //! value of 0 means such cached values are never re-evaluated, while k > 0
+  //! forces a full re-evaluation every k generations (for noisy objectives).
+  size_t ReevalInterval() const { return reevalInterval; }
+  //! Modify the forced re-evaluation cadence.
+  size_t& ReevalInterval() { return reevalInterval; }
+
+  //! Get whether the genomes are treated as binary and stored bit-packed.
+  bool BinaryGenome() const { return binaryGenome; }
+  //! Modify whether the genomes are treated as binary.  When enabled, the
+  //! population is held one bit per gene in a PackedPopulation arena:
+  //! crossover and mutation become bitwise word operations, and mutation
+  //! flips each bit with MutationProbability() (MutationSize() has no binary
+  //! analog and is ignored).  Candidates are unpacked to 0/1 elements only
+  //! for evaluation.  The starting point is binarized (elements >= 0.5 count
+  //! as set), and the initial population spreads one mutation step around it.
+  bool& BinaryGenome() { return binaryGenome; }
+
  private:
-  //! Reproduce candidates to create the next generation.
-  template<typename MatType>
-  void Reproduce(std::vector<MatType>& population,
+  //! Reproduce candidates to create the next generation.  The population is
+  //! held as a cube whose slices are the candidate genomes.  If incremental
+  //! is set, the elite prefix of index is known to be sorted already (the
+  //! elites kept their cached fitness), so only the regenerated candidates
+  //! are sorted and merged in instead of re-sorting the whole array.
+  template<typename CubeType, typename MatType>
+  void Reproduce(CubeType& population,
                  const MatType& fitnessValues,
-                 arma::uvec& index);
+                 arma::uvec& index,
+                 const bool incremental);
 
   //! Modify weights with some noise for the evolution of next generation.
-  template<typename MatType>
-  void Mutate(std::vector<MatType>& population, arma::uvec& index);
+  template<typename CubeType>
+  void Mutate(CubeType& population, arma::uvec& index);
+
+  //! Bitwise variants of the variation operators, used when BinaryGenome()
+  //! is enabled; Reproduce() dispatches to them by overload resolution.
+  void Mutate(PackedPopulation& population, arma::uvec& index);
+  void Crossover(PackedPopulation& population,
+                 const size_t mom,
+                 const size_t dad,
+                 const size_t dropout1,
+                 const size_t dropout2);
 
   /**
    * Crossover parents and create new childs. Two parents create two new childs.
@@ -170,8 +233,8 @@ class CNE
    *                 generation and place a child over there for the
    *                 next generation.
    */
-  template<typename MatType>
-  void Crossover(std::vector<MatType>& population,
+  template<typename CubeType>
+  void Crossover(CubeType& population,
                  const size_t mom,
                  const size_t dad,
                  const size_t dropout1,
@@ -195,11 +258,29 @@ class CNE
   //! The final value of the objective function.
   double tolerance;
 
+  //! The stagnation detector used for early termination.
+  StagnationDetector stagnation;
+
+  //! Whether the candidate fitness evaluations run in parallel.
+  bool parallelEvaluation;
+
   //! Number of candidates to become parent for the next generation.
   size_t numElite;
 
   //! Store the number of elements in a cube slice or a matrix column.
   size_t elements;
+
+  //! The random number generator used to evolve the population.
+  PhiloxGenerator generator;
+
+  //! Whether the initial population uses low-discrepancy draws.
+  bool quasiRandomInit;
+
+  //! Number of generations between forced full re-evaluations (0 = never).
+  size_t reevalInterval;
+
+  //! Whether the genomes are treated as binary and stored bit-packed.
+  bool binaryGenome;
 };
 
 } // namespace ens
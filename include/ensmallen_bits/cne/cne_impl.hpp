@@ -18,6 +18,8 @@
 
 #include "cne.hpp"
 
+#include <algorithm>
+
 namespace ens {
 
 inline CNE::CNE(const size_t populationSize,
@@ -32,8 +34,12 @@ inline CNE::CNE(const size_t populationSize,
     mutationSize(mutationSize),
     selectPercent(selectPercent),
     tolerance(tolerance),
+    parallelEvaluation(false),
     numElite(0),
-    elements(0)
+    elements(0),
+    quasiRandomInit(false),
+    reevalInterval(0),
+    binaryGenome(false)
 { /* Nothing to do here. */ }
 
 //! Optimize the function.
@@ -57,6 +63,9 @@ typename MatType::elem_type CNE::Optimize(ArbitraryFunctionType& function,
   BaseMatType fitnessValues;
   //! Index of sorted fitness values.
   arma::uvec index;
+  // Per-candidate stamp that marks whether a genome changed since its fitness
+  // was last computed; unchanged candidates are not re-evaluated.
+  arma::uvec modified;
 
   // Make sure for evolution to work at least four candidates are present.
   if (populationSize < 4)
@@ -89,19 +98,46 @@ typename MatType::elem_type CNE::Optimize(ArbitraryFunctionType& function,
   BaseMatType& iterate = (BaseMatType&) iterateIn;
 
   // Generate the population based on a Gaussian distribution around the given
-  // starting point.
-  std::vector<BaseMatType> population;
-  for (size_t i = 0 ; i < populationSize; ++i)
+  // starting point.  The genomes live in the slices of one contiguous cube,
+  // so selection and mutation below operate on views into a single arena
+  // instead of separately allocated matrices.  In binary mode the cube stays
+  // empty; the genomes live bit-packed in the PackedPopulation arena instead,
+  // and the initial population spreads one bit-flip mutation step around the
+  // binarized starting point (candidate 0 keeps the exact start).
+  arma::Cube<ElemType> population;
+  PackedPopulation packed(binaryGenome ? populationSize : 0,
+      binaryGenome ? iterate.n_elem : 0);
+  if (binaryGenome)
   {
-    population.push_back(arma::randn<BaseMatType>(iterate.n_rows,
-        iterate.n_cols) + iterate);
+    packed.Pack(0, iterate);
+    for (size_t i = 1; i < populationSize; i++)
+    {
+      packed.Copy(0, i);
+      packed.FlipMutate(i, mutationProb, generator);
+    }
+  }
+  else
+  {
+    population.set_size(iterate.n_rows, iterate.n_cols, populationSize);
+    if (quasiRandomInit)
+    {
+      HaltonSequence sequence(generator.CurrentSeed());
+      sequence.Randn(population);
+    }
+    else
+    {
+      generator.Randn(population);
+    }
+    population.each_slice() += iterate;
   }
 
   // Store the number of elements in the objective matrix.
   elements = iterate.n_rows * iterate.n_cols;
 
-  // Initialize helper variables.
+  // Initialize helper variables.  Every candidate starts dirty so the first
+  // generation is evaluated in full.
   fitnessValues.set_size(populationSize);
+  modified.ones(populationSize);
 
   // Controls early termination of the optimization process.
   bool terminate = false;
@@ -115,29 +151,110 @@ typename MatType::elem_type CNE::Optimize(ArbitraryFunctionType& function,
       callbacks...);
 
   // Iterate until maximum number of generations is obtained.
+  stagnation.Reset();
   Callback::BeginOptimization(*this, function, iterate, callbacks...);
   for (size_t gen = 1; gen <= maxGenerations && !terminate; gen++)
   {
-    // Calculating fitness values of all candidates.
-    for (size_t i = 0; i < populationSize; i++)
+    // With a noisy objective the cached values go stale, so optionally force
+    // a full re-evaluation every reevalInterval generations.
+    const bool reevaluate = (reevalInterval > 0) &&
+        (gen % reevalInterval == 0);
+    if (reevaluate)
+      modified.ones();
+
+    // After the first generation a candidate whose objective already exceeds
+    // the fitness of the worst elite cannot enter the elite set, so that
+    // cached value is handed to a bound-aware Evaluate() (see
+    // EvaluateWithBound()) as the point where the evaluation may as well
+    // stop.  The elites keep their exact cached fitness, so the reported
+    // best fitness is unaffected.
+    const ElemType eliteCutoff =
+        (index.n_elem == populationSize && !reevaluate) ?
+        fitnessValues[index[numElite - 1]] :
+        std::numeric_limits<ElemType>::max();
+
+    // Calculating fitness values of all modified candidates; unchanged
+    // candidates (the elites carried over from the previous generation) keep
+    // their cached fitness.  The candidates are independent, so with parallel
+    // evaluation enabled the generation is processed concurrently (Evaluate()
+    // must be thread-safe); the callbacks are invoked serially afterwards.
+    if (parallelEvaluation)
+    {
+      ENS_PRAGMA_OMP_PARALLEL_FOR
+      for (ptrdiff_t i = 0; i < (ptrdiff_t) populationSize; i++)
+      {
+        if (modified[i])
+        {
+          if (binaryGenome)
+          {
+            // Each thread unpacks into its own 0/1 genome buffer.
+            BaseMatType candidate(iterate.n_rows, iterate.n_cols);
+            packed.Unpack(i, candidate);
+            fitnessValues[i] = EvaluateWithBound(function, candidate,
+                eliteCutoff);
+          }
+          else
+          {
+            fitnessValues[i] = EvaluateWithBound(function, population.slice(i),
+                eliteCutoff);
+          }
+        }
+      }
+
+      for (size_t i = 0; i < populationSize && !terminate; i++)
+      {
+        if (!modified[i])
+          continue;
+
+        if (binaryGenome)
+          packed.Unpack(i, iterate);
+        else
+          iterate = population.slice(i);
+        terminate |= Callback::StepTaken(*this, function, iterate,
+            callbacks...);
+        terminate |= Callback::Evaluate(*this, function, iterate,
+            fitnessValues[i], callbacks...);
+      }
+    }
+    else
     {
+      for (size_t i = 0; i < populationSize; i++)
+      {
+        if (!modified[i])
+          continue;
+
         // Select a candidate and insert the parameters in the function.
-        iterate = population[i];
+        if (binaryGenome)
+          packed.Unpack(i, iterate);
+        else
+          iterate = population.slice(i);
         terminate |= Callback::StepTaken(*this, function, iterate,
             callbacks...);
 
         // Find fitness of candidate.
-        fitnessValues[i] = function.Evaluate(iterate);
+        fitnessValues[i] = EvaluateWithBound(function, iterate, eliteCutoff);
 
         terminate |= Callback::Evaluate(*this, function, iterate,
             fitnessValues[i], callbacks...);
+      }
     }
 
     Info << "Generation number: " << gen << " best fitness = "
         << fitnessValues.min() << std::endl;
 
-    // Create next generation of species.
-    Reproduce(population, fitnessValues, index);
+    // Create next generation of species.  If the elites were not
+    // re-evaluated, their prefix of the previous ranking is still sorted and
+    // the new ranking can be rebuilt incrementally.
+    const bool incremental = (index.n_elem == populationSize) && !reevaluate;
+    if (binaryGenome)
+      Reproduce(packed, fitnessValues, index, incremental);
+    else
+      Reproduce(population, fitnessValues, index, incremental);
+
+    // Only the regenerated candidates carry a new genome; the elites are
+    // passed through unaltered and keep their cached fitness.
+    for (size_t i = 0; i < populationSize; i++)
+      modified[index[i]] = (i >= numElite);
 
     // Check for termination criteria.
     if (std::abs(lastBestFitness - fitnessValues.min()) < tolerance)
@@ -149,10 +266,29 @@ typename MatType::elem_type CNE::Optimize(ArbitraryFunctionType& function,
 
     // Store the best fitness of present generation.
     lastBestFitness = fitnessValues.min();
+
+    // Optional stagnation-based early termination (see Stagnation()); the
+    // diversity statistic is only computed when its criterion is enabled.
+    if (stagnation.Enabled())
+    {
+      const double diversity = (stagnation.MinDiversity() > 0.0) ?
+          (binaryGenome ? packed.Diversity() :
+              StagnationDetector::Diversity(population)) :
+          std::numeric_limits<double>::max();
+      if (stagnation.Stagnated((double) lastBestFitness, diversity))
+      {
+        Info << "CNE: stagnation detected at generation " << gen << "; "
+            << "terminating optimization." << std::endl;
+        break;
+      }
+    }
   }
 
   // Set the best candidate into the network parameters.
-  iterateIn = population[index(0)];
+  if (binaryGenome)
+    packed.Unpack(index(0), iterate);
+  else
+    iterateIn = population.slice(index(0));
 
   // The output of the callback doesn't matter because the optimization is
   // finished.
@@ -164,13 +300,30 @@ typename MatType::elem_type CNE::Optimize(ArbitraryFunctionType& function,
 }
 
 //! Reproduce candidates to create the next generation.
-template<typename MatType>
-inline void CNE::Reproduce(std::vector<MatType>& population,
+template<typename CubeType, typename MatType>
+inline void CNE::Reproduce(CubeType& population,
                            const MatType& fitnessValues,
-                           arma::uvec& index)
+                           arma::uvec& index,
+                           const bool incremental)
 {
   // Sort fitness values. Smaller fitness value means better performance.
-  index = arma::sort_index(fitnessValues);
+  const auto compare = [&fitnessValues](const arma::uword a,
+      const arma::uword b) { return fitnessValues[a] < fitnessValues[b]; };
+  if (!incremental)
+  {
+    index = arma::sort_index(fitnessValues);
+  }
+  else
+  {
+    // The elites kept their cached fitness, so the first numElite entries of
+    // the previous ranking are already in order; only the regenerated
+    // candidates need sorting, and a single merge rebuilds the full ranking.
+    std::sort(index.begin() + numElite, index.end(), compare);
+    arma::uvec merged(populationSize);
+    std::merge(index.begin(), index.begin() + numElite,
+        index.begin() + numElite, index.end(), merged.begin(), compare);
+    index = std::move(merged);
+  }
 
   // First parent.
   size_t mom;
@@ -181,11 +334,9 @@ inline void CNE::Reproduce(std::vector<MatType>& population,
   for (size_t i = numElite; i < populationSize - 1; i++)
   {
     // Select 2 different parents from elite group randomly [0, numElite).
-    mom = arma::as_scalar(arma::randi<arma::uvec>(
-          1, arma::distr_param(0, numElite - 1)));
+    mom = generator.RandInt(numElite);
 
-    dad = arma::as_scalar(arma::randi<arma::uvec>(
-          1, arma::distr_param(0, numElite - 1)));
+    dad = generator.RandInt(numElite);
 
     // Making sure both parents are not the same.
     if (mom == dad)
@@ -211,50 +362,75 @@ inline void CNE::Reproduce(std::vector<MatType>& population,
 }
 
 //! Crossover parents to create new children.
-template<typename MatType>
-inline void CNE::Crossover(std::vector<MatType>& population,
+template<typename CubeType>
+inline void CNE::Crossover(CubeType& population,
                            const size_t mom,
                            const size_t dad,
                            const size_t child1,
                            const size_t child2)
 {
-  // Replace the candidates with parents at their place.
-  population[child1] = population[mom];
-  population[child2] = population[dad];
+  typedef typename CubeType::elem_type ElemType;
+  typedef arma::Mat<ElemType> MatType;
 
-  // Randomly alter mom and dad genome weights to get two different children.
-  for (size_t i = 0; i < elements; i++)
-  {
-    // Using it to alter the weights of the children.
-    const double random = arma::randu<typename MatType::elem_type>();
-    if (random > 0.5)
-    {
-      population[child1](i) = population[mom](i);
-      population[child2](i) = population[dad](i);
-    }
-    else
-    {
-      population[child1](i) = population[dad](i);
-      population[child2](i) = population[mom](i);
-    }
-  }
+  // Replace the candidates with parents at their place.
+  population.slice(child1) = population.slice(mom);
+  population.slice(child2) = population.slice(dad);
+
+  // Randomly alter mom and dad genome weights to get two different children:
+  // with equal probability each weight is either kept or swapped between the
+  // two children, as one batched draw over the whole genome slice.
+  MatType swapDraw(population.n_rows, population.n_cols);
+  generator.Randu(swapDraw);
+  const arma::uvec swapIndex = arma::find(swapDraw <= 0.5);
+  population.slice(child1).elem(swapIndex) =
+      population.slice(dad).elem(swapIndex);
+  population.slice(child2).elem(swapIndex) =
+      population.slice(mom).elem(swapIndex);
 }
 
 //! Modify weights with some noise for the evolution of next generation.
-template<typename MatType>
-inline void CNE::Mutate(std::vector<MatType>& population, arma::uvec& index)
+template<typename CubeType>
+inline void CNE::Mutate(CubeType& population, arma::uvec& index)
 {
-  // Mutate the whole matrix with the given rate and probability.
-  // The best candidate is not altered.
-  for (size_t i = 1; i < populationSize; i++)
+  typedef typename CubeType::elem_type ElemType;
+  typedef arma::Mat<ElemType> MatType;
+
+  // Mutate the regenerated candidates with the given rate and probability.
+  // The elite candidates are carried over unaltered, so their cached fitness
+  // values stay valid for the next generation.
+  MatType mutationDraw(population.n_rows, population.n_cols);
+  MatType mutationNoise(population.n_rows, population.n_cols);
+  for (size_t i = numElite; i < populationSize; i++)
   {
-    population[index(i)] += (arma::randu<MatType>(population[index(i)].n_rows,
-        population[index(i)].n_cols) < mutationProb) %
-        (mutationSize * arma::randn<MatType>(population[index(i)].n_rows,
-        population[index(i)].n_cols));
+    generator.Randu(mutationDraw);
+    generator.Randn(mutationNoise);
+    population.slice(index(i)) +=
+        (mutationDraw < mutationProb) % (mutationSize * mutationNoise);
   }
 }
 
+//! Crossover parents to create new children, bitwise (see BinaryGenome()):
+//! with equal probability each gene is either kept or swapped between the two
+//! children, one random mask word at a time.
+inline void CNE::Crossover(PackedPopulation& population,
+                           const size_t mom,
+                           const size_t dad,
+                           const size_t child1,
+                           const size_t child2)
+{
+  population.UniformCrossover(mom, dad, child1, child2, generator);
+}
+
+//! Mutate the regenerated candidates bitwise (see BinaryGenome()): each gene
+//! is flipped with the mutation probability, visiting only the flipped bits.
+//! The elite candidates are carried over unaltered, so their cached fitness
+//! values stay valid for the next generation.
+inline void CNE::Mutate(PackedPopulation& population, arma::uvec& index)
+{
+  for (size_t i = numElite; i < populationSize; i++)
+    population.FlipMutate(index(i), mutationProb, generator);
+}
+
 } // namespace ens
 
 #endif
@@ -18,6 +18,31 @@
   // #define ENS_PRINT_WARN
 #endif
 
+// ENS_LOG_LEVEL subsumes the two switches above: 0 prints nothing, 1 prints
+// warnings, 2 prints warnings and informational messages.  If it is not
+// defined, it is derived from ENS_PRINT_INFO / ENS_PRINT_WARN in log.hpp.
+// At disabled levels the ENS_LOG_INFO / ENS_LOG_WARN statement macros compile
+// to nothing, with unevaluated operands.
+//
+// #define ENS_LOG_LEVEL 2
+
+// ENS_TRACK_ALLOCATIONS routes Armadillo's memory allocation through counting
+// hooks and extends the Report callback with per-phase allocation statistics
+// (see allocation_tracking.hpp).  Unlike the switches above, it must be
+// defined before ensmallen.hpp is included (e.g. on the compiler command
+// line), because the hooks have to be installed before Armadillo is included.
+//
+// #define ENS_TRACK_ALLOCATIONS
+
+// ENS_MEMORY_RESOURCE routes Armadillo's memory allocation through the
+// thread-local memory resource installed by ens::ScopedMemoryResource, so a
+// per-Optimize() arena (see memory_resource.hpp) can serve all internal
+// optimizer buffers.  Like ENS_TRACK_ALLOCATIONS, it must be defined before
+// ensmallen.hpp is included; the resource classes themselves are available
+// without the switch.
+//
+// #define ENS_MEMORY_RESOURCE
+
 #if defined(ARMA_USE_OPENMP)
   #undef  ENS_USE_OPENMP
   #define ENS_USE_OPENMP
@@ -44,12 +69,23 @@
 
 
 #if defined(ENS_USE_OPENMP)
+  #define ENS_PRAGMA(x) _Pragma(#x)
   #define ENS_PRAGMA_OMP_PARALLEL _Pragma("omp parallel")
+  #define ENS_PRAGMA_OMP_PARALLEL_FOR _Pragma("omp parallel for")
+  // Variants taking the thread count for the region, usually obtained from
+  // ParallelRuntime::Get().RegionThreads() (see utility/parallel_runtime.hpp).
+  #define ENS_PRAGMA_OMP_PARALLEL_THREADS(n) \
+      ENS_PRAGMA(omp parallel num_threads(n))
+  #define ENS_PRAGMA_OMP_PARALLEL_FOR_THREADS(n) \
+      ENS_PRAGMA(omp parallel for num_threads(n))
   #define ENS_PRAGMA_OMP_ATOMIC   _Pragma("omp atomic")
   #define ENS_PRAGMA_OMP_CRITICAL _Pragma("omp critical")
   #define ENS_PRAGMA_OMP_CRITICAL_NAMED _Pragma("omp critical(section)")
 #else
   #define ENS_PRAGMA_OMP_PARALLEL
+  #define ENS_PRAGMA_OMP_PARALLEL_FOR
+  #define ENS_PRAGMA_OMP_PARALLEL_THREADS(n)
+  #define ENS_PRAGMA_OMP_PARALLEL_FOR_THREADS(n)
   #define ENS_PRAGMA_OMP_ATOMIC
   #define ENS_PRAGMA_OMP_CRITICAL
   #define ENS_PRAGMA_OMP_CRITICAL_NAMED
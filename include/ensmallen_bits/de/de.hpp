@@ -15,6 +15,11 @@
 #ifndef ENSMALLEN_DE_DE_HPP
 #define ENSMALLEN_DE_DE_HPP
 
+#include <ensmallen_bits/utility/halton_sequence.hpp>
+#include <ensmallen_bits/utility/packed_population.hpp>
+#include <ensmallen_bits/utility/philox_generator.hpp>
+#include <ensmallen_bits/utility/stagnation_detector.hpp>
+
 namespace ens {
 
 /**
@@ -80,6 +85,15 @@ class DE
      const double differentialWeight = 0.8,
      const double tolerance = 1e-5);
 
+  /**
+   * Clean memory associated with the DE object.
+   */
+  ~DE()
+  {
+    askTellState.Clean();
+    warmStartState.Clean();
+  }
+
   /**
    * Optimize the given function using DE. The given
    * starting point will be modified to store the finishing point of the
@@ -100,6 +114,45 @@ class DE
                                        MatType& iterate,
                                        CallbackTypes&&... callbacks);
 
+  /**
+   * Initialize the ask/tell interface from the given starting point.  The
+   * caller drives the loop instead of Optimize(): Ask() returns the
+   * candidates to evaluate, the caller evaluates them however it likes (e.g.
+   * batched on a remote cluster), and Tell() advances the population with
+   * the observed objective values.  The first Ask()/Tell() round evaluates
+   * the initial population; every following round evaluates one trial
+   * generation.  Termination is under the caller's control.
+   *
+   * @param iterate Starting point; only its value and shape are used.
+   */
+  template<typename MatType>
+  void Initialize(const MatType& iterate);
+
+  /**
+   * Return the candidates to evaluate next, one vectorized candidate per
+   * column.  Initialize() must have been called first.
+   */
+  template<typename MatType>
+  MatType Ask();
+
+  /**
+   * Advance the population with the objective values of the candidates
+   * returned by the preceding Ask() call, and return the best objective
+   * value observed so far.
+   *
+   * @param objectives Vector of objective values, in the column order of the
+   *     matrix returned by Ask().
+   */
+  template<typename MatType>
+  typename MatType::elem_type Tell(const MatType& objectives);
+
+  /**
+   * Return the best candidate observed by the ask/tell interface so far, in
+   * the shape of the starting point.
+   */
+  template<typename MatType>
+  MatType Best();
+
   //! Get the population size.
   size_t PopulationSize() const { return populationSize; }
   //! Modify the population size.
@@ -125,7 +178,103 @@ class DE
   //! Modify the tolerance.
   double& Tolerance() { return tolerance; }
 
+  //! Get the stagnation detector used for early termination.
+  const StagnationDetector& Stagnation() const { return stagnation; }
+  //! Modify the stagnation detector used for early termination.  Disabled
+  //! by default; set its Patience() or MinDiversity() to terminate once the
+  //! best fitness stops improving or the population collapses, instead of
+  //! running out the generation budget.
+  StagnationDetector& Stagnation() { return stagnation; }
+
+  //! Get the random number generator.
+  const PhiloxGenerator& Generator() const { return generator; }
+  //! Modify the random number generator (e.g. to seed it for reproducibility).
+  PhiloxGenerator& Generator() { return generator; }
+
+  //! Get whether the initial population is drawn from a scrambled Halton
+  //! low-discrepancy sequence instead of pseudo-random Gaussian draws.
+  bool QuasiRandomInit() const { return quasiRandomInit; }
+  //! Modify whether the initial population is drawn quasi-randomly.
+  bool& QuasiRandomInit() { return quasiRandomInit; }
+
+  //! Get whether the final population is retained across Optimize() calls.
+  bool WarmStart() const { return warmStart; }
+  //! Modify whether warm starting is enabled.  When enabled, the final
+  //! population of the last Optimize() call (or one injected with
+  //! SeedPopulation()) seeds the next call, provided the problem shape and
+  //! population size still match, instead of a fresh Gaussian sample around
+  //! the starting point.  On nearly identical day-over-day problems this
+  //! resumes from the previous converged population.
+  bool& WarmStart() { return warmStart; }
+
+  //! Get whether the genomes are treated as binary and stored bit-packed.
+  bool BinaryGenome() const { return binaryGenome; }
+  //! Modify whether the genomes are treated as binary.  When enabled,
+  //! Optimize() holds the population one bit per gene in a PackedPopulation
+  //! arena and runs the bitwise analog of the /best/1/bin strategy: a trial
+  //! genome starts from the best candidate, adopts each bit where two random
+  //! members disagree with probability DifferentialWeight() (clamped to 1),
+  //! and then keeps each trial bit with probability CrossoverRate() or
+  //! reverts to the parent's.  Candidates are unpacked to 0/1 elements only
+  //! for evaluation, and parents keep their cached fitness between
+  //! generations.  The ask/tell interface and warm starting are not
+  //! available in this mode.
+  bool& BinaryGenome() { return binaryGenome; }
+
+  /**
+   * Inject a population to seed the next Optimize() call with, e.g. one
+   * exported from a prior run with Population().  Each of the populationSize
+   * columns holds one vectorized candidate.  Implies WarmStart() = true.
+   *
+   * @param population The population matrix to seed with.
+   */
+  template<typename MatType>
+  void SeedPopulation(const MatType& population);
+
+  /**
+   * Return the population retained by the last warm-started Optimize() call
+   * (or injected with SeedPopulation()), one vectorized candidate per
+   * column.  MatType must match the type optimized with; throws if no
+   * population is held.
+   */
+  template<typename MatType>
+  const typename MatTypeTraits<MatType>::BaseMatType& Population() const;
+
  private:
+  /**
+   * Bit-packed variant of Optimize(), used when BinaryGenome() is enabled.
+   * The parameters and return value match Optimize().
+   */
+  template<typename FunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename MatType::elem_type OptimizeBinary(FunctionType& function,
+                                             MatType& iterate,
+                                             CallbackTypes&&... callbacks);
+
+  /**
+   * Persistent state of the ask/tell interface.  Candidates are kept
+   * vectorized, one per column, matching the population layout used by
+   * Optimize().
+   */
+  template<typename BaseMatType>
+  struct AskTellState
+  {
+    typedef typename BaseMatType::elem_type ElemType;
+
+    //! Shape of the starting point, for reshaping results.
+    size_t rows, cols;
+    //! Whether the initial population has been evaluated yet.
+    bool parentsEvaluated;
+    //! The current population and the pending trial candidates.
+    BaseMatType population, mutants;
+    //! Fitness of each population member.
+    arma::Col<ElemType> fitnessValues;
+    //! Best member observed so far.
+    BaseMatType bestColumn;
+    ElemType bestFitness;
+  };
+
   //! The number of candidates in the population.
   size_t populationSize;
 
@@ -140,6 +289,28 @@ class DE
 
   //! The tolerance for termination.
   double tolerance;
+
+  //! The stagnation detector used for early termination.
+  StagnationDetector stagnation;
+
+  //! The random number generator used to evolve the population.
+  PhiloxGenerator generator;
+
+  //! Whether the initial population uses low-discrepancy draws.
+  bool quasiRandomInit;
+
+  //! Whether the final population is retained across Optimize() calls.
+  bool warmStart;
+
+  //! Whether the genomes are treated as binary and stored bit-packed.
+  bool binaryGenome;
+
+  //! The retained or injected population; empty until a warm-started
+  //! Optimize() call finishes or SeedPopulation() is called.
+  Any warmStartState;
+
+  //! The instantiated ask/tell state; empty until Initialize() is called.
+  Any askTellState;
 };
 
 } // namespace ens
@@ -26,7 +26,10 @@ inline DE::DE(const size_t populationSize ,
     maxGenerations(maxGenerations),
     crossoverRate(crossoverRate),
     differentialWeight(differentialWeight),
-    tolerance(tolerance)
+    tolerance(tolerance),
+    quasiRandomInit(false),
+    warmStart(false),
+    binaryGenome(false)
 { /* Nothing to do here. */ }
 
 //!Optimize the function
@@ -37,18 +40,20 @@ typename MatType::elem_type DE::Optimize(FunctionType& function,
                                          MatType& iterateIn,
                                          CallbackTypes&&... callbacks)
 {
+  // The bit-packed binary mode replaces the whole generation pipeline (see
+  // BinaryGenome()).
+  if (binaryGenome)
+  {
+    return OptimizeBinary(function, iterateIn,
+        std::forward<CallbackTypes>(callbacks)...);
+  }
+
   // Convenience typedefs.
   typedef typename MatType::elem_type ElemType;
   typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
 
   BaseMatType& iterate = (BaseMatType&) iterateIn;
 
-  // Population matrix. Each column is a candidate.
-  std::vector<BaseMatType> population;
-  population.resize(populationSize);
-  // Vector of fitness values corresponding to each candidate.
-  arma::Col<ElemType> fitnessValues;
-
   // Make sure that we have the methods that we need.  Long name...
   traits::CheckArbitraryFunctionTypeAPI<
       FunctionType, BaseMatType>();
@@ -61,92 +66,152 @@ typename MatType::elem_type DE::Optimize(FunctionType& function,
         " 3!");
   }
 
+  // Population matrix: each column holds one vectorized candidate, so the
+  // mutation and crossover of a whole generation below are contiguous batched
+  // matrix operations instead of per-member temporaries.
+  BaseMatType population(iterate.n_elem, populationSize);
+  // Vector of fitness values corresponding to each candidate.
+  arma::Col<ElemType> fitnessValues(populationSize);
+
   // Initialize helper variables.
-  fitnessValues.set_size(populationSize);
   ElemType lastBestFitness = DBL_MAX;
-  BaseMatType bestElement;
+  BaseMatType bestColumn(iterate.n_elem, 1);
 
   // Controls early termination of the optimization process.
   bool terminate = false;
 
+  // Resume from the retained or injected population when warm starting and
+  // the shape still matches (see WarmStart()).
+  bool seeded = false;
+  if (warmStart && warmStartState.Has<BaseMatType>())
+  {
+    const BaseMatType& retained = warmStartState.As<BaseMatType>();
+    if (retained.n_rows == iterate.n_elem &&
+        retained.n_cols == populationSize)
+    {
+      population = retained;
+      seeded = true;
+    }
+  }
+
   // Generate a population based on a Gaussian distribution around the given
-  // starting point. Also finds the best element of the population.
-  for (size_t i = 0; i < populationSize; i++)
+  // starting point. Also finds the best element of the population.  With
+  // quasi-random initialization the Gaussian variates come from a scrambled
+  // Halton sequence, so the candidates cover the space evenly.
+  if (!seeded)
   {
-    population[i].randn(iterate.n_rows, iterate.n_cols);
-    population[i] += iterate;
-    fitnessValues[i] = function.Evaluate(population[i]);
+    if (quasiRandomInit)
+    {
+      HaltonSequence sequence(generator.CurrentSeed());
+      sequence.Randn(population);
+    }
+    else
+    {
+      generator.Randn(population);
+    }
+    population.each_col() += arma::vectorise(iterate);
+  }
 
-    terminate |= Callback::Evaluate(*this, function, population[i],
+  // Candidate in the shape the function expects.
+  BaseMatType candidate(iterate.n_rows, iterate.n_cols);
+
+  // Score the initial population; if the function provides the optional
+  // batched population Evaluate() overload, this is a single vectorized call.
+  PopulationEvaluator::Evaluate(function, population, iterate.n_rows,
+      iterate.n_cols, fitnessValues);
+  for (size_t i = 0; i < populationSize; i++)
+  {
+    candidate = arma::reshape(population.col(i), iterate.n_rows,
+        iterate.n_cols);
+    terminate |= Callback::Evaluate(*this, function, candidate,
         fitnessValues[i], callbacks...);
 
     if (fitnessValues[i] < lastBestFitness)
     {
       lastBestFitness = fitnessValues[i];
-      bestElement = population[i];
+      bestColumn = population.col(i);
     }
   }
 
+  // Per-generation index and trial buffers, allocated once.
+  arma::uvec lIndex(populationSize);
+  arma::uvec mIndex(populationSize);
+  BaseMatType mutants(iterate.n_elem, populationSize);
+  BaseMatType cr(iterate.n_elem, populationSize);
+  arma::Col<ElemType> mutantFitness(populationSize);
+
   // Iterate until maximum number of generations are completed.
+  stagnation.Reset();
   Callback::BeginOptimization(*this, function, iterate, callbacks...);
   for (size_t gen = 0; gen < maxGenerations && !terminate; gen++)
   {
-    // Generate new population based on /best/1/bin strategy.
+    // Generate two different random members for each member of the
+    // population.
     for (size_t member = 0; member < populationSize; member++)
     {
-      iterate = population[member];
-
-      // Generate two different random numbers to choose two random members.
       size_t l = 0, m = 0;
       do
       {
-        l = arma::randi<arma::uword>(arma::distr_param(0, populationSize - 1));
+        l = generator.RandInt(populationSize);
       }
       while (l == member);
 
       do
       {
-        m = arma::randi<arma::uword>(arma::distr_param(0, populationSize - 1));
+        m = generator.RandInt(populationSize);
       }
       while (m == member && m == l);
 
-      // Generate new "mutant" from two randomly chosen members.
-      BaseMatType mutant = bestElement + differentialWeight *
-          (population[l] - population[m]);
+      lIndex[member] = l;
+      mIndex[member] = m;
+    }
 
-      // Perform crossover.
-      const BaseMatType cr = arma::randu<BaseMatType>(iterate.n_rows);
-      for (size_t it = 0; it < iterate.n_rows; it++)
-      {
-        if (cr[it] >= crossoverRate)
-        {
-          mutant[it] = iterate[it];
-        }
-      }
+    // Generate the new trial population based on the /best/1/bin strategy,
+    // for all members at once.
+    mutants = population.cols(lIndex);
+    mutants -= population.cols(mIndex);
+    mutants *= differentialWeight;
+    mutants.each_col() += bestColumn;
 
-      ElemType iterateValue = function.Evaluate(iterate);
-      terminate |= Callback::Evaluate(*this, function, iterate, iterateValue,
-          callbacks...);
+    // Perform crossover: where the draw fails, the trial keeps the parent's
+    // coordinate.
+    generator.Randu(cr);
+    const arma::uvec keep = arma::find(cr >= crossoverRate);
+    mutants.elem(keep) = population.elem(keep);
 
-      const ElemType mutantValue = function.Evaluate(mutant);
-      terminate |= Callback::Evaluate(*this, function, mutant, mutantValue,
-          callbacks...);
+    // Evaluate the parents and the trial population; with the batched
+    // population Evaluate() overload these are two vectorized passes.
+    PopulationEvaluator::Evaluate(function, population, iterate.n_rows,
+        iterate.n_cols, fitnessValues);
+    PopulationEvaluator::Evaluate(function, mutants, iterate.n_rows,
+        iterate.n_cols, mutantFitness);
+
+    // Select per member.
+    for (size_t member = 0; member < populationSize; member++)
+    {
+      iterate = arma::reshape(population.col(member), iterate.n_rows,
+          iterate.n_cols);
+      terminate |= Callback::Evaluate(*this, function, iterate,
+          fitnessValues[member], callbacks...);
+
+      candidate = arma::reshape(mutants.col(member), iterate.n_rows,
+          iterate.n_cols);
+      terminate |= Callback::Evaluate(*this, function, candidate,
+          mutantFitness[member], callbacks...);
 
       if (terminate)
         break;
 
       // Replace the current member if mutant is better.
-      if (mutantValue < iterateValue)
+      if (mutantFitness[member] < fitnessValues[member])
       {
-        iterate = mutant;
-        iterateValue = mutantValue;
+        iterate = candidate;
+        population.col(member) = mutants.col(member);
+        fitnessValues[member] = mutantFitness[member];
 
         terminate |= Callback::StepTaken(*this, function, iterate,
             callbacks...);
       }
-
-      fitnessValues[member] = iterateValue;
-      population[member] = iterate;
     }
 
     // Check for termination criteria.
@@ -163,18 +228,384 @@ typename MatType::elem_type DE::Optimize(FunctionType& function,
     {
       if (fitnessValues[it] == lastBestFitness)
       {
-        bestElement = population[it];
+        bestColumn = population.col(it);
         break;
       }
     }
+
+    // Optional stagnation-based early termination (see Stagnation()); the
+    // diversity statistic is only computed when its criterion is enabled.
+    if (stagnation.Enabled())
+    {
+      const double diversity = (stagnation.MinDiversity() > 0.0) ?
+          StagnationDetector::Diversity(population) :
+          std::numeric_limits<double>::max();
+      if (stagnation.Stagnated((double) lastBestFitness, diversity))
+      {
+        Info << "DE: stagnation detected at generation " << gen << "; "
+            << "terminating optimization." << std::endl;
+        break;
+      }
+    }
+  }
+
+  // Retain the final population so the next warm-started call resumes from
+  // it (see WarmStart()).
+  if (warmStart)
+  {
+    warmStartState.Clean();
+    warmStartState.Set<BaseMatType>(new BaseMatType(population));
   }
 
-  iterate = bestElement;
+  iterate = arma::reshape(bestColumn, iterate.n_rows, iterate.n_cols);
 
   Callback::EndOptimization(*this, function, iterate, callbacks...);
   return lastBestFitness;
 }
 
+//! Bit-packed variant of Optimize(), used when BinaryGenome() is enabled.
+template<typename FunctionType,
+         typename MatType,
+         typename... CallbackTypes>
+typename MatType::elem_type DE::OptimizeBinary(FunctionType& function,
+                                               MatType& iterateIn,
+                                               CallbackTypes&&... callbacks)
+{
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+
+  // Make sure that we have the methods that we need.  Long name...
+  traits::CheckArbitraryFunctionTypeAPI<
+      FunctionType, BaseMatType>();
+  RequireDenseFloatingPointType<BaseMatType>();
+
+  // Population Size must be at least 3 for DE to work.
+  if (populationSize < 3)
+  {
+    throw std::logic_error("DE::Optimize(): population size should be at least"
+        " 3!");
+  }
+
+  // The genomes live bit-packed in two arenas: the population itself and the
+  // trial genomes of the current generation.
+  PackedPopulation population(populationSize, iterate.n_elem);
+  PackedPopulation trials(populationSize, iterate.n_elem);
+
+  // Candidate 0 keeps the binarized starting point; the rest of the
+  // population is uniformly random.
+  population.Pack(0, iterate);
+  for (size_t i = 1; i < populationSize; i++)
+    population.Randomize(i, generator);
+
+  // Fitness of each member and of the trial genomes.  Unlike the
+  // floating-point pipeline, surviving parents keep their cached fitness
+  // between generations.
+  arma::Col<ElemType> fitnessValues(populationSize);
+  arma::Col<ElemType> trialFitness(populationSize);
+
+  // Controls early termination of the optimization process.
+  bool terminate = false;
+
+  // Candidate in the shape the function expects.
+  BaseMatType candidate(iterate.n_rows, iterate.n_cols);
+
+  // Score the initial population and find its best member.
+  ElemType lastBestFitness = std::numeric_limits<ElemType>::max();
+  size_t bestIndex = 0;
+  for (size_t i = 0; i < populationSize; i++)
+  {
+    population.Unpack(i, candidate);
+    fitnessValues[i] = function.Evaluate(candidate);
+    terminate |= Callback::Evaluate(*this, function, candidate,
+        fitnessValues[i], callbacks...);
+
+    if (fitnessValues[i] < lastBestFitness)
+    {
+      lastBestFitness = fitnessValues[i];
+      bestIndex = i;
+    }
+  }
+
+  // Probability of adopting each bit where the two difference genomes
+  // disagree; the continuous amplification factor maps onto it directly.
+  const double adoptProb = std::min(differentialWeight, 1.0);
+
+  // Iterate until maximum number of generations are completed.
+  stagnation.Reset();
+  Callback::BeginOptimization(*this, function, iterate, callbacks...);
+  for (size_t gen = 0; gen < maxGenerations && !terminate; gen++)
+  {
+    // Build the trial genomes, all bitwise: the bitwise analog of the
+    // /best/1/bin strategy starts each trial from the best candidate, adopts
+    // the bits where two random members disagree with probability adoptProb,
+    // and then performs binomial crossover with the parent.
+    for (size_t member = 0; member < populationSize; member++)
+    {
+      size_t l = 0, m = 0;
+      do
+      {
+        l = generator.RandInt(populationSize);
+      }
+      while (l == member);
+
+      do
+      {
+        m = generator.RandInt(populationSize);
+      }
+      while (m == member && m == l);
+
+      trials.DifferentialMutate(population, bestIndex, l, m, member,
+          adoptProb, generator);
+      trials.BinomialCrossover(population, member, member, crossoverRate,
+          generator);
+    }
+
+    // Evaluate the trials and select per member.
+    for (size_t member = 0; member < populationSize; member++)
+    {
+      trials.Unpack(member, candidate);
+      trialFitness[member] = function.Evaluate(candidate);
+      terminate |= Callback::Evaluate(*this, function, candidate,
+          trialFitness[member], callbacks...);
+
+      if (terminate)
+        break;
+
+      // Replace the current member if the trial is better.
+      if (trialFitness[member] < fitnessValues[member])
+      {
+        population.CopyFrom(trials, member, member);
+        fitnessValues[member] = trialFitness[member];
+
+        iterate = candidate;
+        terminate |= Callback::StepTaken(*this, function, iterate,
+            callbacks...);
+
+        if (fitnessValues[member] < fitnessValues[bestIndex])
+          bestIndex = member;
+      }
+    }
+
+    // Check for termination criteria.
+    if (std::abs(lastBestFitness - fitnessValues[bestIndex]) < tolerance)
+    {
+      Info << "DE: minimized within tolerance " << tolerance << "; "
+          << "terminating optimization." << std::endl;
+      break;
+    }
+
+    // Update helper variables.
+    lastBestFitness = fitnessValues[bestIndex];
+
+    // Optional stagnation-based early termination (see Stagnation()); the
+    // diversity statistic is the popcount-based mean pairwise Hamming
+    // distance of the packed population.
+    if (stagnation.Enabled())
+    {
+      const double diversity = (stagnation.MinDiversity() > 0.0) ?
+          population.Diversity() :
+          std::numeric_limits<double>::max();
+      if (stagnation.Stagnated((double) lastBestFitness, diversity))
+      {
+        Info << "DE: stagnation detected at generation " << gen << "; "
+            << "terminating optimization." << std::endl;
+        break;
+      }
+    }
+  }
+
+  population.Unpack(bestIndex, iterate);
+
+  Callback::EndOptimization(*this, function, iterate, callbacks...);
+  return fitnessValues[bestIndex];
+}
+
+template<typename MatType>
+void DE::SeedPopulation(const MatType& population)
+{
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+
+  warmStart = true;
+  warmStartState.Clean();
+  warmStartState.Set<BaseMatType>(new BaseMatType(population));
+}
+
+template<typename MatType>
+const typename MatTypeTraits<MatType>::BaseMatType& DE::Population() const
+{
+  return warmStartState.As<typename MatTypeTraits<MatType>::BaseMatType>();
+}
+
+//! Initialize the ask/tell interface.
+template<typename MatType>
+void DE::Initialize(const MatType& iterateIn)
+{
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef AskTellState<BaseMatType> StateType;
+
+  RequireDenseFloatingPointType<BaseMatType>();
+
+  const BaseMatType& iterate = (const BaseMatType&) iterateIn;
+
+  if (populationSize < 3)
+  {
+    throw std::logic_error("DE::Initialize(): population size should be at "
+        "least 3!");
+  }
+
+  askTellState.Clean();
+  askTellState.Set<StateType>(new StateType());
+  StateType& state = askTellState.As<StateType>();
+
+  state.rows = iterate.n_rows;
+  state.cols = iterate.n_cols;
+  state.parentsEvaluated = false;
+
+  // Generate a population based on a Gaussian distribution around the given
+  // starting point, as in Optimize().
+  state.population.set_size(iterate.n_elem, populationSize);
+  if (quasiRandomInit)
+  {
+    HaltonSequence sequence(generator.CurrentSeed());
+    sequence.Randn(state.population);
+  }
+  else
+  {
+    generator.Randn(state.population);
+  }
+  state.population.each_col() += arma::vectorise(iterate);
+
+  state.fitnessValues.set_size(populationSize);
+  state.bestColumn = arma::vectorise(iterate);
+  state.bestFitness = std::numeric_limits<ElemType>::max();
+}
+
+//! Return the candidates to evaluate next.
+template<typename MatType>
+MatType DE::Ask()
+{
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef AskTellState<BaseMatType> StateType;
+
+  if (!askTellState.Has<StateType>())
+    throw std::logic_error("DE::Ask(): call Initialize() first!");
+  StateType& state = askTellState.As<StateType>();
+
+  // The initial population itself is the first batch to evaluate.
+  if (!state.parentsEvaluated)
+    return state.population;
+
+  // Generate two different random members for each member of the population.
+  arma::uvec lIndex(populationSize);
+  arma::uvec mIndex(populationSize);
+  for (size_t member = 0; member < populationSize; member++)
+  {
+    size_t l = 0, m = 0;
+    do
+    {
+      l = generator.RandInt(populationSize);
+    }
+    while (l == member);
+
+    do
+    {
+      m = generator.RandInt(populationSize);
+    }
+    while (m == member && m == l);
+
+    lIndex[member] = l;
+    mIndex[member] = m;
+  }
+
+  // Generate the new trial population based on the /best/1/bin strategy, for
+  // all members at once, as in Optimize().
+  state.mutants = state.population.cols(lIndex);
+  state.mutants -= state.population.cols(mIndex);
+  state.mutants *= differentialWeight;
+  state.mutants.each_col() += state.bestColumn;
+
+  // Perform crossover: where the draw fails, the trial keeps the parent's
+  // coordinate.
+  BaseMatType cr(state.population.n_rows, populationSize);
+  generator.Randu(cr);
+  const arma::uvec keep = arma::find(cr >= crossoverRate);
+  state.mutants.elem(keep) = state.population.elem(keep);
+
+  return state.mutants;
+}
+
+//! Advance the population with the observed objective values.
+template<typename MatType>
+typename MatType::elem_type DE::Tell(const MatType& objectivesIn)
+{
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef AskTellState<BaseMatType> StateType;
+
+  if (!askTellState.Has<StateType>())
+    throw std::logic_error("DE::Tell(): call Initialize() first!");
+  StateType& state = askTellState.As<StateType>();
+
+  const BaseMatType& objectives = (const BaseMatType&) objectivesIn;
+  if (objectives.n_elem != populationSize)
+  {
+    throw std::logic_error("DE::Tell(): expected " +
+        std::to_string(populationSize) + " objective values, got " +
+        std::to_string(objectives.n_elem) + "!");
+  }
+
+  if (!state.parentsEvaluated)
+  {
+    // The objectives belong to the initial population.
+    for (size_t member = 0; member < populationSize; member++)
+      state.fitnessValues(member) = objectives(member);
+    state.parentsEvaluated = true;
+  }
+  else
+  {
+    // Replace each member whose trial candidate improved on it.  Unlike
+    // Optimize(), the parents' cached fitness values are reused rather than
+    // re-evaluated.
+    for (size_t member = 0; member < populationSize; member++)
+    {
+      if (objectives(member) < state.fitnessValues(member))
+      {
+        state.population.col(member) = state.mutants.col(member);
+        state.fitnessValues(member) = objectives(member);
+      }
+    }
+  }
+
+  // Update the best member observed so far.
+  for (size_t member = 0; member < populationSize; member++)
+  {
+    if (state.fitnessValues(member) < state.bestFitness)
+    {
+      state.bestFitness = state.fitnessValues(member);
+      state.bestColumn = state.population.col(member);
+    }
+  }
+
+  return state.bestFitness;
+}
+
+//! Return the best candidate observed so far.
+template<typename MatType>
+MatType DE::Best()
+{
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef AskTellState<BaseMatType> StateType;
+
+  if (!askTellState.Has<StateType>())
+    throw std::logic_error("DE::Best(): call Initialize() first!");
+  StateType& state = askTellState.As<StateType>();
+
+  return arma::reshape(state.bestColumn, state.rows, state.cols);
+}
+
 } // namespace ens
 
 #endif
@@ -0,0 +1,160 @@
+/**
+ * @file shade.hpp
+ * @author Rahul Ganesh Prabhu
+ *
+ * SHADE: success-history based adaptive differential evolution.  A variant of
+ * DE that adapts the crossover rate and differential weight per member from a
+ * memory of parameter values that produced improvements in past generations.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef ENSMALLEN_DE_SHADE_HPP
+#define ENSMALLEN_DE_SHADE_HPP
+
+#include <ensmallen_bits/utility/philox_generator.hpp>
+
+namespace ens {
+
+/**
+ * SHADE (success-history based adaptive differential evolution) removes the
+ * need to tune the crossover rate and differential weight of DE by hand.
+ * Instead of fixed values, each member samples its own parameters around
+ * entries of a small circular memory; whenever a trial improves on its parent,
+ * the parameters that produced the improvement are folded back into the memory
+ * with a weight proportional to the improvement.
+ *
+ * Mutation follows the current-to-pbest/1 strategy: each member moves towards
+ * a randomly chosen member of the current best fraction of the population, and
+ * the second difference vector may be drawn from an external archive of
+ * recently replaced parents, which preserves diversity.  The archive is stored
+ * in a preallocated ring buffer of the same size as the population, so no
+ * allocation happens during the run.
+ *
+ * Unlike DE, parents are evaluated once and their fitness values are cached
+ * across generations, so each generation costs exactly one evaluation per
+ * member.
+ *
+ * For more information, see the following:
+ *
+ * @code
+ * @inproceedings{Tanabe2013,
+ *   title     = {Success-history based parameter adaptation for differential
+ *                evolution},
+ *   author    = {Tanabe, Ryoji and Fukunaga, Alex},
+ *   booktitle = {2013 IEEE Congress on Evolutionary Computation},
+ *   pages     = {71--78},
+ *   year      = 2013
+ * }
+ * @endcode
+ *
+ * SHADE can optimize arbitrary functions.  For more details, see the
+ * documentation on function types included with this distribution or on the
+ * ensmallen website.
+ */
+class SHADE
+{
+ public:
+  /**
+   * Constructor for the SHADE optimizer.
+   *
+   * The defaults here follow the reference implementation and work reasonably
+   * across problems; unlike DE, there is no crossover rate or differential
+   * weight to tune, as both are adapted during the run.
+   *
+   * @param populationSize The number of candidates in the population.
+   *     This should be at least 4 in size.
+   * @param maxGenerations The maximum number of generations allowed for SHADE.
+   * @param historySize The number of entries in the circular success-history
+   *     memory for the crossover rate and differential weight.
+   * @param pBestFraction The largest fraction of the population that a member
+   *     may move towards in the current-to-pbest/1 mutation; the fraction
+   *     itself is drawn per member.
+   * @param tolerance The final value of the objective function for
+   *     termination.
+   */
+  SHADE(const size_t populationSize = 100,
+        const size_t maxGenerations = 2000,
+        const size_t historySize = 50,
+        const double pBestFraction = 0.2,
+        const double tolerance = 1e-5);
+
+  /**
+   * Optimize the given function using SHADE. The given starting point will be
+   * modified to store the finishing point of the algorithm, and the final
+   * objective value is returned.
+   *
+   * @tparam FunctionType Type of the function to be optimized.
+   * @tparam MatType Type of matrix to optimize.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to optimize.
+   * @param iterate Starting point (will be modified).
+   * @param callbacks Callback functions.
+   * @return Objective value of the final point.
+   */
+  template<typename FunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(FunctionType& function,
+                                       MatType& iterate,
+                                       CallbackTypes&&... callbacks);
+
+  //! Get the population size.
+  size_t PopulationSize() const { return populationSize; }
+  //! Modify the population size.
+  size_t& PopulationSize() { return populationSize; }
+
+  //! Get maximum number of generations.
+  size_t MaxGenerations() const { return maxGenerations; }
+  //! Modify maximum number of generations.
+  size_t& MaxGenerations() { return maxGenerations; }
+
+  //! Get the size of the success-history memory.
+  size_t HistorySize() const { return historySize; }
+  //! Modify the size of the success-history memory.
+  size_t& HistorySize() { return historySize; }
+
+  //! Get the largest pbest fraction used by the mutation.
+  double PBestFraction() const { return pBestFraction; }
+  //! Modify the largest pbest fraction used by the mutation.
+  double& PBestFraction() { return pBestFraction; }
+
+  //! Get the tolerance.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the random number generator.
+  const PhiloxGenerator& Generator() const { return generator; }
+  //! Modify the random number generator (e.g. to seed it for reproducibility).
+  PhiloxGenerator& Generator() { return generator; }
+
+ private:
+  //! The number of candidates in the population.
+  size_t populationSize;
+
+  //! Maximum number of generations before termination criteria is met.
+  size_t maxGenerations;
+
+  //! The number of entries in the circular success-history memory.
+  size_t historySize;
+
+  //! The largest pbest fraction used by the mutation.
+  double pBestFraction;
+
+  //! The tolerance for termination.
+  double tolerance;
+
+  //! The random number generator used to evolve the population.
+  PhiloxGenerator generator;
+};
+
+} // namespace ens
+
+// Include implementation.
+#include "shade_impl.hpp"
+
+#endif
@@ -0,0 +1,305 @@
+/**
+ * @file shade_impl.hpp
+ * @author Rahul Ganesh Prabhu
+ *
+ * Implementation of SHADE, a success-history based adaptive variant of
+ * differential evolution.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_DE_SHADE_IMPL_HPP
+#define ENSMALLEN_DE_SHADE_IMPL_HPP
+
+#include "shade.hpp"
+
+namespace ens {
+
+inline SHADE::SHADE(const size_t populationSize,
+                    const size_t maxGenerations,
+                    const size_t historySize,
+                    const double pBestFraction,
+                    const double tolerance):
+    populationSize(populationSize),
+    maxGenerations(maxGenerations),
+    historySize(historySize),
+    pBestFraction(pBestFraction),
+    tolerance(tolerance)
+{ /* Nothing to do here. */ }
+
+//! Optimize the function.
+template<typename FunctionType,
+         typename MatType,
+         typename... CallbackTypes>
+typename MatType::elem_type SHADE::Optimize(FunctionType& function,
+                                            MatType& iterateIn,
+                                            CallbackTypes&&... callbacks)
+{
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+
+  // Make sure that we have the methods that we need.  Long name...
+  traits::CheckArbitraryFunctionTypeAPI<
+      FunctionType, BaseMatType>();
+  RequireDenseFloatingPointType<BaseMatType>();
+
+  // The current-to-pbest/1 mutation needs the member itself, a pbest member
+  // and two further distinct members.
+  if (populationSize < 4)
+  {
+    throw std::logic_error("SHADE::Optimize(): population size should be at "
+        "least 4!");
+  }
+
+  // Population matrix: each column holds one vectorized candidate, matching
+  // the layout used by DE.
+  BaseMatType population(iterate.n_elem, populationSize);
+  // Vector of fitness values corresponding to each candidate.  Parents are
+  // evaluated once and their fitness is cached across generations.
+  arma::Col<ElemType> fitnessValues(populationSize);
+
+  // Initialize helper variables.
+  ElemType lastBestFitness = DBL_MAX;
+  BaseMatType bestColumn(iterate.n_elem, 1);
+
+  // Controls early termination of the optimization process.
+  bool terminate = false;
+
+  // Generate a population based on a Gaussian distribution around the given
+  // starting point. Also finds the best element of the population.
+  generator.Randn(population);
+  population.each_col() += arma::vectorise(iterate);
+
+  // Candidate in the shape the function expects.
+  BaseMatType candidate(iterate.n_rows, iterate.n_cols);
+
+  // Score the initial population; if the function provides the optional
+  // batched population Evaluate() overload, this is a single vectorized call.
+  PopulationEvaluator::Evaluate(function, population, iterate.n_rows,
+      iterate.n_cols, fitnessValues);
+  for (size_t i = 0; i < populationSize; i++)
+  {
+    candidate = arma::reshape(population.col(i), iterate.n_rows,
+        iterate.n_cols);
+    terminate |= Callback::Evaluate(*this, function, candidate,
+        fitnessValues[i], callbacks...);
+
+    if (fitnessValues[i] < lastBestFitness)
+    {
+      lastBestFitness = fitnessValues[i];
+      bestColumn = population.col(i);
+    }
+  }
+
+  // Circular success-history memories for the crossover rate and the
+  // differential weight, both seeded with 0.5.
+  arma::vec memoryCR(historySize);
+  arma::vec memoryF(historySize);
+  memoryCR.fill(0.5);
+  memoryF.fill(0.5);
+  size_t memoryPos = 0;
+
+  // External archive of replaced parents, stored in a preallocated ring of
+  // the same size as the population; once the ring is full, the oldest entry
+  // is overwritten.
+  BaseMatType archive(iterate.n_elem, populationSize);
+  size_t archiveCount = 0;
+  size_t archivePos = 0;
+
+  // Per-generation buffers, allocated once.
+  BaseMatType trials(iterate.n_elem, populationSize);
+  BaseMatType trialColumn(iterate.n_elem, 1);
+  BaseMatType parentColumn(iterate.n_elem, 1);
+  BaseMatType cr(iterate.n_elem, 1);
+  arma::vec crValues(populationSize);
+  arma::vec fValues(populationSize);
+  arma::Col<ElemType> trialFitness(populationSize);
+  std::vector<double> successCR, successF, improvements;
+  successCR.reserve(populationSize);
+  successF.reserve(populationSize);
+  improvements.reserve(populationSize);
+
+  // The smallest pbest fraction always covers two members.
+  const double pMin = 2.0 / (double) populationSize;
+
+  // Iterate until maximum number of generations are completed.
+  Callback::BeginOptimization(*this, function, iterate, callbacks...);
+  for (size_t gen = 0; gen < maxGenerations && !terminate; gen++)
+  {
+    // Rank the members by fitness for the pbest selection below.
+    const arma::uvec order = arma::sort_index(fitnessValues);
+
+    // Generate the trial population; each member samples its own crossover
+    // rate and differential weight around a random memory entry.
+    for (size_t member = 0; member < populationSize; member++)
+    {
+      const size_t h = generator.RandInt(historySize);
+
+      // The crossover rate is drawn from a normal distribution around the
+      // memory entry and clamped to [0, 1].
+      double crossover = memoryCR[h] + 0.1 * generator.Gaussian();
+      crossover = std::min(std::max(crossover, 0.0), 1.0);
+
+      // The differential weight is drawn from a Cauchy distribution around
+      // the memory entry, regenerated until positive and truncated to 1.
+      double weight;
+      do
+      {
+        weight = memoryF[h] + 0.1 *
+            std::tan(arma::datum::pi * (generator.Uniform() - 0.5));
+      } while (weight <= 0.0);
+      weight = std::min(weight, 1.0);
+
+      crValues[member] = crossover;
+      fValues[member] = weight;
+
+      // Draw the pbest member from the best fraction of the population; the
+      // fraction itself is drawn uniformly from [pMin, pBestFraction].
+      const double p = pMin + (pBestFraction - pMin) * generator.Uniform();
+      const size_t numPBest = std::max((size_t) 2,
+          (size_t) std::ceil(p * populationSize));
+      const size_t pBestIndex = order[generator.RandInt(numPBest)];
+
+      // The first difference member comes from the population, the second
+      // from the union of the population and the archive.
+      size_t l = 0, m = 0;
+      do
+      {
+        l = generator.RandInt(populationSize);
+      }
+      while (l == member);
+
+      do
+      {
+        m = generator.RandInt(populationSize + archiveCount);
+      }
+      while (m == member || m == l);
+
+      // current-to-pbest/1 mutation.
+      trialColumn = population.col(member) + weight *
+          (population.col(pBestIndex) - population.col(member)) +
+          weight * population.col(l);
+      if (m < populationSize)
+        trialColumn -= weight * population.col(m);
+      else
+        trialColumn -= weight * archive.col(m - populationSize);
+
+      // Binomial crossover with one forced coordinate, so the trial always
+      // differs from its parent.
+      generator.Randu(cr);
+      cr[generator.RandInt(iterate.n_elem)] = 0.0;
+      parentColumn = population.col(member);
+      const arma::uvec keep = arma::find(cr >= crossover);
+      trialColumn.elem(keep) = parentColumn.elem(keep);
+
+      trials.col(member) = trialColumn;
+    }
+
+    // Evaluate the trial population---one vectorized pass if the function
+    // provides the batched population Evaluate() overload---and select per
+    // member; parents keep their cached fitness values.
+    PopulationEvaluator::Evaluate(function, trials, iterate.n_rows,
+        iterate.n_cols, trialFitness);
+
+    successCR.clear();
+    successF.clear();
+    improvements.clear();
+    for (size_t member = 0; member < populationSize; member++)
+    {
+      candidate = arma::reshape(trials.col(member), iterate.n_rows,
+          iterate.n_cols);
+      const ElemType trialValue = trialFitness[member];
+      terminate |= Callback::Evaluate(*this, function, candidate, trialValue,
+          callbacks...);
+
+      if (terminate)
+        break;
+
+      if (trialValue <= fitnessValues[member])
+      {
+        if (trialValue < fitnessValues[member])
+        {
+          // Strict improvement: the replaced parent goes into the archive
+          // ring, and the parameters that produced the improvement are
+          // recorded for the memory update, weighted by the improvement.
+          archive.col(archivePos) = population.col(member);
+          archivePos = (archivePos + 1) % populationSize;
+          if (archiveCount < populationSize)
+            archiveCount++;
+
+          successCR.push_back(crValues[member]);
+          successF.push_back(fValues[member]);
+          improvements.push_back(
+              (double) (fitnessValues[member] - trialValue));
+        }
+
+        iterate = candidate;
+        population.col(member) = trials.col(member);
+        fitnessValues[member] = trialValue;
+
+        terminate |= Callback::StepTaken(*this, function, iterate,
+            callbacks...);
+      }
+    }
+
+    // Fold the successful parameters back into the circular memory: the
+    // crossover rates via a weighted arithmetic mean and the differential
+    // weights via a weighted Lehmer mean, which biases towards larger steps.
+    if (!improvements.empty())
+    {
+      double improvementSum = 0.0;
+      for (size_t k = 0; k < improvements.size(); k++)
+        improvementSum += improvements[k];
+
+      double meanCR = 0.0, lehmerNum = 0.0, lehmerDenom = 0.0;
+      for (size_t k = 0; k < improvements.size(); k++)
+      {
+        const double w = improvements[k] / improvementSum;
+        meanCR += w * successCR[k];
+        lehmerNum += w * successF[k] * successF[k];
+        lehmerDenom += w * successF[k];
+      }
+
+      memoryCR[memoryPos] = meanCR;
+      memoryF[memoryPos] = lehmerNum / lehmerDenom;
+      memoryPos = (memoryPos + 1) % historySize;
+    }
+
+    // Check for termination criteria.  Because parents keep their cached
+    // fitness values, a single generation without a new best member is common
+    // long before convergence, so the tolerance check is only applied once a
+    // whole generation passes without any member improving.
+    if (improvements.empty() &&
+        std::abs(lastBestFitness - fitnessValues.min()) < tolerance)
+    {
+      Info << "SHADE: minimized within tolerance " << tolerance << "; "
+          << "terminating optimization." << std::endl;
+      break;
+    }
+
+    // Update helper variables.
+    lastBestFitness = fitnessValues.min();
+    for (size_t it = 0; it < populationSize; it++)
+    {
+      if (fitnessValues[it] == lastBestFitness)
+      {
+        bestColumn = population.col(it);
+        break;
+      }
+    }
+  }
+
+  iterate = arma::reshape(bestColumn, iterate.n_rows, iterate.n_cols);
+
+  Callback::EndOptimization(*this, function, iterate, callbacks...);
+  return lastBestFitness;
+}
+
+} // namespace ens
+
+#endif
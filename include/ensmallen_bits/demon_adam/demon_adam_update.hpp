@@ -14,6 +14,8 @@
 
 #include <assert.h>
 
+#include "demon_momentum_schedule.hpp"
+
 namespace ens {
 
 /**
@@ -103,6 +105,7 @@ class DemonAdamUpdate
            const size_t rows,
            const size_t cols) :
       parent(parent),
+      schedule(parent.T, parent.betaInit),
       adamUpdate(new InstUpdateRuleType(parent.adamUpdateInst, rows, cols))
     { /* Nothing to do here */ }
 
@@ -125,12 +128,9 @@ class DemonAdamUpdate
                 const double stepSize,
                 const GradType& gradient)
     {
-      double decayRate = 1;
-      if (parent.t > 0)
-        decayRate = 1.0 - (double) parent.t / (double) parent.T;
-
-      const double betaDecay = parent.betaInit * decayRate;
-      const double beta = betaDecay / ((1.0 - parent.betaInit) + betaDecay);
+      // The momentum coefficient comes from the schedule precomputed at
+      // policy construction.
+      const double beta = schedule.Beta(parent.t);
 
       // Perform the update.
       iterate *= beta;
@@ -146,6 +146,9 @@ class DemonAdamUpdate
     //! Instantiated parent object.
     DemonAdamUpdate<UpdateRule>& parent;
 
+    //! The precomputed momentum-decay schedule.
+    DemonMomentumSchedule schedule;
+
     //! The update policy.
     InstUpdateRuleType* adamUpdate;
   };
@@ -0,0 +1,87 @@
+/**
+ * @file demon_momentum_schedule.hpp
+ * @author Marcus Edel
+ *
+ * Precomputed momentum-decay schedule shared by DemonAdam and DemonSGD.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_DEMON_ADAM_DEMON_MOMENTUM_SCHEDULE_HPP
+#define ENSMALLEN_DEMON_ADAM_DEMON_MOMENTUM_SCHEDULE_HPP
+
+namespace ens {
+
+/**
+ * The decaying momentum coefficient used by DemonAdam and DemonSGD:
+ *
+ *   beta_t = betaInit * (1 - t / T) /
+ *            ((1 - betaInit) + betaInit * (1 - t / T))
+ *
+ * Since the schedule depends only on the iteration counter and parameters
+ * known at construction, the whole table is precomputed once when the
+ * instantiated policy is created, turning the per-step coefficient into a
+ * single table load.  Iterations past the precomputed range (or past T, if T
+ * is very large) fall back to the closed-form expression, matching the
+ * values the per-step computation would have produced exactly.
+ */
+class DemonMomentumSchedule
+{
+ public:
+  //! Construct an empty schedule; only usable after assignment.
+  DemonMomentumSchedule() : T(0), betaInit(0) { }
+
+  /**
+   * Precompute the momentum coefficients for all momentum iterations.
+   *
+   * @param momentumIterations The number of iterations before the momentum
+   *     decays to zero (T).
+   * @param betaInit The initial momentum coefficient.
+   */
+  DemonMomentumSchedule(const size_t momentumIterations,
+                        const double betaInit) :
+      T(momentumIterations),
+      betaInit(betaInit)
+  {
+    beta.set_size(std::min(momentumIterations, MaxTableSize));
+    for (size_t t = 0; t < beta.n_elem; ++t)
+      beta[t] = Compute(t);
+  }
+
+  //! Get the momentum coefficient for the given iteration.
+  double Beta(const size_t t) const
+  {
+    return (t < beta.n_elem) ? beta[t] : Compute(t);
+  }
+
+ private:
+  //! Evaluate the closed-form coefficient for the given iteration.
+  double Compute(const size_t t) const
+  {
+    double decayRate = 1;
+    if (t > 0)
+      decayRate = 1.0 - (double) t / (double) T;
+
+    const double betaDecay = betaInit * decayRate;
+    return betaDecay / ((1.0 - betaInit) + betaDecay);
+  }
+
+  //! Upper bound on the table length, so a huge iteration budget does not
+  //! turn into a huge allocation (8 MB of coefficients at most).
+  static const size_t MaxTableSize = 1048576;
+
+  //! The number of momentum iterations.
+  size_t T;
+
+  //! The initial momentum coefficient.
+  double betaInit;
+
+  //! The precomputed coefficients.
+  arma::vec beta;
+};
+
+} // namespace ens
+
+#endif
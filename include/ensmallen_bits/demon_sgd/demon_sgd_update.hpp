@@ -12,6 +12,8 @@
 #ifndef ENSMALLEN_DEMON_SGD_DEMON_SGD_UPDATE_HPP
 #define ENSMALLEN_DEMON_SGD_DEMON_SGD_UPDATE_HPP
 
+#include <ensmallen_bits/demon_adam/demon_momentum_schedule.hpp>
+
 namespace ens {
 
 /**
@@ -89,7 +91,8 @@ class DemonSGDUpdate
     Policy(DemonSGDUpdate& parent,
            const size_t /* rows */,
            const size_t /* cols */) :
-      parent(parent)
+      parent(parent),
+      schedule(parent.T, parent.betaInit)
     { /* Nothing to do here */ }
 
     /**
@@ -103,12 +106,9 @@ class DemonSGDUpdate
                 const double stepSize,
                 const GradType& gradient)
     {
-      double decayRate = 1;
-      if (parent.t > 0)
-        decayRate = 1.0 - (double) parent.t / (double) parent.T;
-
-      const double betaDecay = parent.betaInit * decayRate;
-      const double beta = betaDecay / ((1.0 - parent.betaInit) + betaDecay);
+      // The momentum coefficient comes from the schedule precomputed at
+      // policy construction.
+      const double beta = schedule.Beta(parent.t);
 
       // Perform the update.
       iterate *= beta;
@@ -121,6 +121,9 @@ class DemonSGDUpdate
    private:
     //! Instantiated parent object.
     DemonSGDUpdate& parent;
+
+    //! The precomputed momentum-decay schedule.
+    DemonMomentumSchedule schedule;
   };
 
  private:
@@ -0,0 +1,103 @@
+/**
+ * @file mpi_communicator.hpp
+ * @author Marcus Edel
+ *
+ * An MPI-backed communicator for distributed SGD.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_DISTRIBUTED_SGD_MPI_COMMUNICATOR_HPP
+#define ENSMALLEN_DISTRIBUTED_SGD_MPI_COMMUNICATOR_HPP
+
+// This communicator is only available when the application is built against
+// MPI; define ENS_USE_MPI (and link MPI) to enable it.  MPI_Init() and
+// MPI_Finalize() remain the responsibility of the application.
+#if defined(ENS_USE_MPI)
+
+#include <mpi.h>
+
+namespace ens {
+
+/**
+ * A communicator backed by an MPI communicator (MPI_COMM_WORLD by default).
+ * Matrix and scalar reductions are elementwise sums across all ranks; the
+ * AllreduceStart() / AllreduceWait() pair maps onto MPI_Iallreduce(), so
+ * DistributedSGD can overlap the reduction with local gradient computation.
+ */
+class MPICommunicator
+{
+ public:
+  /**
+   * Construct the communicator on top of the given MPI communicator.
+   *
+   * @param comm The MPI communicator to use (MPI_COMM_WORLD by default).
+   */
+  MPICommunicator(MPI_Comm comm = MPI_COMM_WORLD) : comm(comm)
+  {
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+  }
+
+  //! Get the rank of this process.
+  size_t Rank() const { return (size_t) rank; }
+  //! Get the number of participating processes.
+  size_t Size() const { return (size_t) size; }
+
+  //! Elementwise sum of the given matrix across all ranks, in place.
+  template<typename MatType>
+  void Allreduce(MatType& data)
+  {
+    MPI_Allreduce(MPI_IN_PLACE, data.memptr(), (int) data.n_elem,
+        MPIType<typename MatType::elem_type>(), MPI_SUM, comm);
+  }
+
+  //! Sum the given scalar across all ranks.
+  double Allreduce(const double value)
+  {
+    double result = value;
+    MPI_Allreduce(MPI_IN_PLACE, &result, 1, MPI_DOUBLE, MPI_SUM, comm);
+    return result;
+  }
+
+  //! Begin a nonblocking elementwise sum of the given matrix across all
+  //! ranks.  The buffer must stay untouched until AllreduceWait() returns.
+  template<typename MatType>
+  void AllreduceStart(MatType& data)
+  {
+    MPI_Iallreduce(MPI_IN_PLACE, data.memptr(), (int) data.n_elem,
+        MPIType<typename MatType::elem_type>(), MPI_SUM, comm, &request);
+  }
+
+  //! Finish the nonblocking sum started by AllreduceStart().
+  template<typename MatType>
+  void AllreduceWait(MatType& /* data */)
+  {
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+  }
+
+ private:
+  //! Map the element type onto the corresponding MPI datatype.
+  template<typename ElemType>
+  static MPI_Datatype MPIType()
+  {
+    return std::is_same<ElemType, float>::value ? MPI_FLOAT : MPI_DOUBLE;
+  }
+
+  //! The underlying MPI communicator.
+  MPI_Comm comm;
+  //! The rank of this process.
+  int rank;
+  //! The number of participating processes.
+  int size;
+  //! The request of the in-flight nonblocking reduction, if any.
+  MPI_Request request;
+};
+
+} // namespace ens
+
+#endif // ENS_USE_MPI
+
+#endif
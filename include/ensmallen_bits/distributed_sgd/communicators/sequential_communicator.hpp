@@ -0,0 +1,54 @@
+/**
+ * @file sequential_communicator.hpp
+ * @author Marcus Edel
+ *
+ * A single-process communicator for distributed SGD.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_DISTRIBUTED_SGD_SEQUENTIAL_COMMUNICATOR_HPP
+#define ENSMALLEN_DISTRIBUTED_SGD_SEQUENTIAL_COMMUNICATOR_HPP
+
+namespace ens {
+
+/**
+ * The trivial communicator: one rank, no communication.  This is the default
+ * CommunicatorType of DistributedSGD, so the optimizer compiles and runs
+ * without any MPI dependency; with it, DistributedSGD reduces to full-batch
+ * gradient descent over all functions.
+ *
+ * Any replacement communicator must provide the same interface: Rank() and
+ * Size(), a blocking elementwise-sum Allreduce() for matrices and scalars,
+ * and the nonblocking AllreduceStart() / AllreduceWait() pair used to overlap
+ * the reduction with local gradient computation.
+ */
+class SequentialCommunicator
+{
+ public:
+  //! Get the rank of this process (always 0).
+  size_t Rank() const { return 0; }
+  //! Get the number of participating processes (always 1).
+  size_t Size() const { return 1; }
+
+  //! Elementwise sum across all ranks; with one rank, nothing to do.
+  template<typename MatType>
+  void Allreduce(MatType& /* data */) { }
+
+  //! Sum the given scalar across all ranks.
+  double Allreduce(const double value) { return value; }
+
+  //! Begin a nonblocking elementwise sum across all ranks.
+  template<typename MatType>
+  void AllreduceStart(MatType& /* data */) { }
+
+  //! Finish the nonblocking sum started by AllreduceStart().
+  template<typename MatType>
+  void AllreduceWait(MatType& /* data */) { }
+};
+
+} // namespace ens
+
+#endif
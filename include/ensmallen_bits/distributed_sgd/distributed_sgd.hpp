@@ -0,0 +1,137 @@
+/**
+ * @file distributed_sgd.hpp
+ * @author Marcus Edel
+ *
+ * Distributed data-parallel Stochastic Gradient Descent.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_DISTRIBUTED_SGD_HPP
+#define ENSMALLEN_DISTRIBUTED_SGD_HPP
+
+#include "../parallel_sgd/decay_policies/constant_step.hpp"
+#include "communicators/sequential_communicator.hpp"
+#include "communicators/mpi_communicator.hpp"
+
+namespace ens {
+
+/**
+ * An implementation of distributed data-parallel gradient descent.  The
+ * separable functions are partitioned evenly across the ranks of the
+ * communicator; on every iteration each rank computes the gradient over its
+ * own shard, the shard gradients are summed across ranks with an allreduce,
+ * and every rank applies the same update, so the iterates stay bitwise
+ * identical on all ranks without any model averaging.
+ *
+ * Communication is a template policy: the default SequentialCommunicator has
+ * one rank and no dependencies (DistributedSGD then reduces to full-batch
+ * gradient descent), while MPICommunicator (available when ENS_USE_MPI is
+ * defined) runs the reduction over MPI.  With Overlap() enabled, the
+ * allreduce of each gradient is started nonblocking and overlapped with the
+ * computation of the next local gradient, at the cost of updates lagging one
+ * step behind the gradients.
+ *
+ * DistributedSGD can optimize differentiable separable functions.  For more
+ * details, see the documentation on function types included with this
+ * distribution or on the ensmallen website.
+ *
+ * @tparam CommunicatorType The communicator used to combine gradients across
+ *     ranks.
+ * @tparam DecayPolicyType Step size update policy used to update the
+ *     stepsize after each iteration.
+ */
+template<typename CommunicatorType = SequentialCommunicator,
+         typename DecayPolicyType = ConstantStep>
+class DistributedSGD
+{
+ public:
+  /**
+   * Construct the distributed SGD optimizer to optimize the given function
+   * with the given parameters.
+   *
+   * @param maxIterations Maximum number of iterations allowed (0 means no
+   *     limit).
+   * @param tolerance Maximum absolute tolerance to terminate the algorithm.
+   * @param communicator The communicator used to combine gradients.
+   * @param decayPolicy The step size update policy to use.
+   */
+  DistributedSGD(const size_t maxIterations = 100000,
+                 const double tolerance = 1e-5,
+                 const CommunicatorType& communicator = CommunicatorType(),
+                 const DecayPolicyType& decayPolicy = DecayPolicyType());
+
+  /**
+   * Optimize the given function using distributed SGD.  The given starting
+   * point will be modified to store the finishing point of the algorithm,
+   * and the value of the loss function at the final point is returned.  All
+   * ranks must call Optimize() with identical starting points.
+   *
+   * @tparam SeparableFunctionType Type of function to be optimized.
+   * @tparam MatType Type of the parameters matrix.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to be optimized (minimized).
+   * @param iterate Starting point (will be modified).
+   * @param callbacks Callback functions.
+   * @return Objective value at the final point.
+   */
+  template<typename SeparableFunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(SeparableFunctionType& function,
+                                       MatType& iterate,
+                                       CallbackTypes&&... callbacks);
+
+  //! Get the maximum number of iterations (0 indicates no limits).
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of iterations (0 indicates no limits).
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the tolerance for termination.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance for termination.
+  double& Tolerance() { return tolerance; }
+
+  //! Get whether the allreduce is overlapped with gradient computation.
+  bool Overlap() const { return overlap; }
+  //! Modify whether the allreduce is overlapped with gradient computation.
+  //! When enabled, the reduction of each gradient runs while the next local
+  //! gradient is computed, so updates are applied with gradients that are
+  //! one step stale.
+  bool& Overlap() { return overlap; }
+
+  //! Get the communicator.
+  const CommunicatorType& Communicator() const { return communicator; }
+  //! Modify the communicator.
+  CommunicatorType& Communicator() { return communicator; }
+
+  //! Get the step size decay policy.
+  const DecayPolicyType& DecayPolicy() const { return decayPolicy; }
+  //! Modify the step size decay policy.
+  DecayPolicyType& DecayPolicy() { return decayPolicy; }
+
+ private:
+  //! The maximum number of allowed iterations.
+  size_t maxIterations;
+
+  //! The tolerance for termination.
+  double tolerance;
+
+  //! Whether the allreduce is overlapped with gradient computation.
+  bool overlap;
+
+  //! The communicator used to combine gradients across ranks.
+  CommunicatorType communicator;
+
+  //! The step size decay policy.
+  DecayPolicyType decayPolicy;
+};
+
+} // namespace ens
+
+// Include implementation.
+#include "distributed_sgd_impl.hpp"
+
+#endif
@@ -0,0 +1,178 @@
+/**
+ * @file distributed_sgd_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of distributed data-parallel Stochastic Gradient Descent.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_DISTRIBUTED_SGD_IMPL_HPP
+#define ENSMALLEN_DISTRIBUTED_SGD_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "distributed_sgd.hpp"
+
+#include <ensmallen_bits/function.hpp>
+
+namespace ens {
+
+template<typename CommunicatorType, typename DecayPolicyType>
+DistributedSGD<CommunicatorType, DecayPolicyType>::DistributedSGD(
+    const size_t maxIterations,
+    const double tolerance,
+    const CommunicatorType& communicator,
+    const DecayPolicyType& decayPolicy) :
+    maxIterations(maxIterations),
+    tolerance(tolerance),
+    overlap(false),
+    communicator(communicator),
+    decayPolicy(decayPolicy)
+{ /* Nothing to do. */ }
+
+template<typename CommunicatorType, typename DecayPolicyType>
+template<typename SeparableFunctionType,
+         typename MatType,
+         typename... CallbackTypes>
+typename MatType::elem_type
+DistributedSGD<CommunicatorType, DecayPolicyType>::Optimize(
+    SeparableFunctionType& function,
+    MatType& iterateIn,
+    CallbackTypes&&... callbacks)
+{
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+
+  typedef Function<SeparableFunctionType, BaseMatType, BaseMatType>
+      FullFunctionType;
+  FullFunctionType& f(static_cast<FullFunctionType&>(function));
+
+  // Make sure we have all the methods that we need.
+  traits::CheckSeparableFunctionTypeAPI<FullFunctionType, BaseMatType,
+      BaseMatType>();
+  RequireFloatingPointType<BaseMatType>();
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+
+  // Partition the functions evenly across the ranks; any remainder is spread
+  // over the first ranks, so shard sizes differ by at most one.
+  const size_t numFunctions = f.NumFunctions();
+  const size_t rank = communicator.Rank();
+  const size_t worldSize = communicator.Size();
+  const size_t shardBegin = (rank * numFunctions) / worldSize;
+  const size_t shardSize = ((rank + 1) * numFunctions) / worldSize -
+      shardBegin;
+
+  ElemType overallObjective = DBL_MAX;
+  ElemType lastObjective;
+
+  // Controls early termination of the optimization process.
+  bool terminate = false;
+
+  // The gradient over this rank's shard; with Overlap() enabled, the
+  // reduction of 'gradient' runs while the next shard gradient is computed
+  // into 'nextGradient'.
+  BaseMatType gradient(iterate.n_rows, iterate.n_cols);
+  BaseMatType nextGradient;
+  if (overlap)
+    nextGradient.set_size(iterate.n_rows, iterate.n_cols);
+
+  // Compute the gradient over this rank's shard of the functions.
+  auto shardGradient = [&](BaseMatType& g)
+  {
+    if (shardSize > 0)
+    {
+      f.Gradient(iterate, shardBegin, g, shardSize);
+    }
+    else
+    {
+      // More ranks than functions; this rank only participates in the
+      // reductions.
+      g.zeros();
+    }
+  };
+
+  Callback::BeginOptimization(*this, f, iterate, callbacks...);
+
+  if (overlap)
+    shardGradient(gradient);
+
+  for (size_t i = 1; i != maxIterations && !terminate; ++i)
+  {
+    // Calculate the overall objective: every rank evaluates its own shard,
+    // and the shard objectives are summed across ranks.
+    lastObjective = overallObjective;
+    const ElemType localObjective = (shardSize > 0) ?
+        f.Evaluate(iterate, shardBegin, shardSize) : ElemType(0);
+    overallObjective = (ElemType) communicator.Allreduce(
+        (double) localObjective);
+
+    terminate |= Callback::Evaluate(*this, f, iterate, overallObjective,
+        callbacks...);
+
+    Info << "Distributed SGD: iteration " << i << ", objective "
+        << overallObjective << "." << std::endl;
+
+    if (std::isnan(overallObjective) || std::isinf(overallObjective))
+    {
+      Warn << "Distributed SGD: converged to " << overallObjective
+          << "; terminating with failure. Try a smaller step size?"
+          << std::endl;
+
+      Callback::EndOptimization(*this, f, iterate, callbacks...);
+      return overallObjective;
+    }
+
+    if (std::abs(lastObjective - overallObjective) < tolerance)
+    {
+      Info << "Distributed SGD: minimized within tolerance " << tolerance
+          << "; terminating optimization." << std::endl;
+
+      Callback::EndOptimization(*this, f, iterate, callbacks...);
+      return overallObjective;
+    }
+
+    const double stepSize = decayPolicy.StepSize(i);
+
+    if (overlap)
+    {
+      // Start the reduction of the current gradient, compute the next shard
+      // gradient while it is in flight, then apply the reduced gradient.
+      // The update therefore uses a gradient that is one step stale.
+      communicator.AllreduceStart(gradient);
+      shardGradient(nextGradient);
+      communicator.AllreduceWait(gradient);
+    }
+    else
+    {
+      shardGradient(gradient);
+      communicator.Allreduce(gradient);
+    }
+
+    terminate |= Callback::Gradient(*this, f, iterate, gradient,
+        callbacks...);
+
+    // Every rank applies the same update, so the iterates stay identical
+    // across ranks.  The gradient is a sum over all functions; normalize so
+    // the step size does not depend on the dataset size.
+    iterate -= (stepSize / numFunctions) * gradient;
+
+    if (overlap)
+      std::swap(gradient, nextGradient);
+
+    terminate |= Callback::StepTaken(*this, f, iterate, callbacks...);
+  }
+
+  Info << "\nDistributed SGD terminated with objective : " << overallObjective
+      << "." << std::endl;
+
+  Callback::EndOptimization(*this, f, iterate, callbacks...);
+  return overallObjective;
+}
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,69 @@
+/**
+ * @file extern_templates.hpp
+ * @author Marcus Edel
+ *
+ * Optional extern-template declarations for common optimizer configurations,
+ * backed by the prebuilt ensmallen_instantiations static library.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_EXTERN_TEMPLATES_HPP
+#define ENSMALLEN_EXTERN_TEMPLATES_HPP
+
+// Being header-only, every translation unit that includes ensmallen.hpp
+// normally instantiates the optimizer class templates and their
+// update-policy state it uses, producing duplicate template code in every
+// object file.  Defining ENS_USE_EXTERN_TEMPLATES before including
+// ensmallen.hpp declares the common `arma::mat` configurations below as
+// extern templates, so consumer translation units compile and link faster;
+// the single set of definitions then comes from the optional
+// ensmallen_instantiations static library (built with the
+// BUILD_STATIC_INSTANTIATIONS CMake option, which compiles this header with
+// ENS_INSTANTIATE_TEMPLATES defined).
+//
+// Only entities whose template arguments are fixed here can be prebuilt:
+// the optimizer classes themselves and the per-step update-policy state for
+// the `<arma::mat, arma::mat>` configuration.  Optimize() is a member
+// template over the user's function type and is necessarily still
+// instantiated where it is called.
+
+#if defined(ENS_USE_EXTERN_TEMPLATES) || defined(ENS_INSTANTIATE_TEMPLATES)
+
+#if defined(ENS_INSTANTIATE_TEMPLATES)
+  #define ENS_TEMPLATE_DECL template
+#else
+  #define ENS_TEMPLATE_DECL extern template
+#endif
+
+namespace ens {
+
+// The common SGD-family optimizer configurations.
+ENS_TEMPLATE_DECL class SGD<VanillaUpdate, NoDecay>;
+ENS_TEMPLATE_DECL class SGD<MomentumUpdate, NoDecay>;
+ENS_TEMPLATE_DECL class SGD<NesterovMomentumUpdate, NoDecay>;
+ENS_TEMPLATE_DECL class AdamType<AdamUpdate>;
+ENS_TEMPLATE_DECL class AdamType<AdaMaxUpdate>;
+ENS_TEMPLATE_DECL class AdamType<AMSGradUpdate>;
+ENS_TEMPLATE_DECL class AdamType<NadamUpdate>;
+
+// The per-step update-policy state for the arma::mat configuration; this is
+// the code executed in the optimizers' hot loops.
+ENS_TEMPLATE_DECL class VanillaUpdate::Policy<arma::mat, arma::mat>;
+ENS_TEMPLATE_DECL class MomentumUpdate::Policy<arma::mat, arma::mat>;
+ENS_TEMPLATE_DECL class NesterovMomentumUpdate::Policy<arma::mat, arma::mat>;
+ENS_TEMPLATE_DECL class AdamUpdate::Policy<arma::mat, arma::mat>;
+ENS_TEMPLATE_DECL class AdaMaxUpdate::Policy<arma::mat, arma::mat>;
+ENS_TEMPLATE_DECL class AMSGradUpdate::Policy<arma::mat, arma::mat>;
+ENS_TEMPLATE_DECL class NadamUpdate::Policy<arma::mat, arma::mat>;
+ENS_TEMPLATE_DECL class NoDecay::Policy<arma::mat, arma::mat>;
+
+} // namespace ens
+
+#undef ENS_TEMPLATE_DECL
+
+#endif
+
+#endif
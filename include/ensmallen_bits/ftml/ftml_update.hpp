@@ -12,6 +12,8 @@
 #ifndef ENSMALLEN_FTML_FTML_UPDATE_HPP
 #define ENSMALLEN_FTML_FTML_UPDATE_HPP
 
+#include <ensmallen_bits/sgd/update_policies/elementwise_update.hpp>
+
 namespace ens {
 
 /**
@@ -75,7 +77,7 @@ class FTMLUpdate
    * specific to an individual optimization.
    */
   template<typename MatType, typename GradType>
-  class Policy
+  class Policy : public ElementwiseUpdate<Policy<MatType, GradType>>
   {
    public:
     /**
@@ -87,7 +89,9 @@ class FTMLUpdate
      * @param cols Number of columns in the gradient matrix.
      */
     Policy(FTMLUpdate& parent, const size_t rows, const size_t cols) :
-        parent(parent)
+        parent(parent),
+        biasCorrection1(0),
+        biasCorrection2(0)
     {
       v.zeros(rows, cols);
       z.zeros(rows, cols);
@@ -108,21 +112,32 @@ class FTMLUpdate
       // Increment the iteration counter variable.
       ++iteration;
 
-      // And update the iterate.
-      v *= parent.beta2;
-      v += (1 - parent.beta2) * (gradient % gradient);
+      biasCorrection1 = 1.0 - std::pow(parent.beta1, iteration);
+      biasCorrection2 = 1.0 - std::pow(parent.beta2, iteration);
+
+      this->Elementwise(iterate, stepSize, gradient, v, z, d);
+    }
 
-      const double biasCorrection1 = 1.0 - std::pow(parent.beta1, iteration);
-      const double biasCorrection2 = 1.0 - std::pow(parent.beta2, iteration);
+    //! The per-element FTML rule; called by ElementwiseUpdate.
+    template<typename StateElemType, typename DElemType>
+    double Apply(const double stepSize,
+                 const double x,
+                 const double g,
+                 StateElemType& v,
+                 StateElemType& z,
+                 DElemType& d)
+    {
+      v = (StateElemType) (parent.beta2 * v +
+          (1 - parent.beta2) * g * g);
 
-      MatType sigma = -parent.beta1 * d;
-      d = biasCorrection1 / stepSize *
-        (arma::sqrt(v / biasCorrection2) + parent.epsilon);
-      sigma += d;
+      const double dNew = biasCorrection1 / stepSize *
+          (std::sqrt(v / biasCorrection2) + parent.epsilon);
+      const double sigma = dNew - parent.beta1 * d;
 
-      z *= parent.beta1;
-      z += (1 - parent.beta1) * gradient - sigma % iterate;
-      iterate = -z / d;
+      z = (StateElemType) (parent.beta1 * z +
+          (1 - parent.beta1) * g - sigma * x);
+      d = (DElemType) dNew;
+      return -z / dNew;
     }
 
    private:
@@ -140,6 +155,12 @@ class FTMLUpdate
 
     // The number of iterations.
     size_t iteration;
+
+    // The current first moment bias correction; set by Update().
+    double biasCorrection1;
+
+    // The current second moment bias correction; set by Update().
+    double biasCorrection2;
   };
 
  private:
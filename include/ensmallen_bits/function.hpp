@@ -22,10 +22,14 @@ class Function;
 
 #include "function/traits.hpp"
 #include "function/static_checks.hpp"
+#include "function/bounded_evaluate.hpp"
+#include "function/fidelity_evaluate.hpp"
 #include "function/add_evaluate.hpp"
 #include "function/add_gradient.hpp"
 #include "function/add_evaluate_with_gradient.hpp"
 #include "function/add_separable_evaluate.hpp"
+#include "function/add_evaluate_batch.hpp"
+#include "function/add_prefetch_batch.hpp"
 #include "function/add_separable_gradient.hpp"
 #include "function/add_separable_evaluate_with_gradient.hpp"
 
@@ -67,6 +71,10 @@ class Function :
     public AddSeparableEvaluateStatic<FunctionType, MatType, GradType>,
     public AddSeparableEvaluateConst<FunctionType, MatType, GradType>,
     public AddSeparableEvaluate<FunctionType, MatType, GradType>,
+    public AddPrefetchBatch<FunctionType, MatType, GradType>,
+    public AddEvaluateBatchStatic<FunctionType, MatType, GradType>,
+    public AddEvaluateBatchConst<FunctionType, MatType, GradType>,
+    public AddEvaluateBatch<FunctionType, MatType, GradType>,
     public AddEvaluateWithGradientStatic<FunctionType, MatType, GradType>,
     public AddEvaluateWithGradientConst<FunctionType, MatType, GradType>,
     public AddEvaluateWithGradient<FunctionType, MatType, GradType>,
@@ -97,6 +105,10 @@ class Function :
       FunctionType, MatType, GradType>::Evaluate;
   using AddSeparableEvaluateConst<FunctionType, MatType, GradType>::Evaluate;
   using AddSeparableEvaluate<FunctionType, MatType, GradType>::Evaluate;
+  using AddPrefetchBatch<FunctionType, MatType, GradType>::PrefetchBatch;
+  using AddEvaluateBatchStatic<FunctionType, MatType, GradType>::EvaluateBatch;
+  using AddEvaluateBatchConst<FunctionType, MatType, GradType>::EvaluateBatch;
+  using AddEvaluateBatch<FunctionType, MatType, GradType>::EvaluateBatch;
   using AddEvaluateWithGradientStatic<FunctionType, MatType, GradType>::EvaluateWithGradient;
   using AddEvaluateWithGradientConst<FunctionType, MatType, GradType>::EvaluateWithGradient;
   using AddEvaluateWithGradient<FunctionType, MatType, GradType>::EvaluateWithGradient;
@@ -110,4 +122,12 @@ class Function :
 
 } // namespace ens
 
+// The adapters need the complete Function class, so they are included last.
+#include "function/counting_function.hpp"
+#include "function/dual.hpp"
+#include "function/dual_function.hpp"
+#include "function/finite_difference_function.hpp"
+#include "function/memoized_function.hpp"
+#include "function/multithreaded_evaluate.hpp"
+
 #endif
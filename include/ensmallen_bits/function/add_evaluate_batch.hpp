@@ -0,0 +1,268 @@
+/**
+ * @file add_evaluate_batch.hpp
+ * @author Ryan Curtin
+ *
+ * Adds an EvaluateBatch() function---which evaluates an entire schedule of
+ * (begin, batchSize) ranges in one call---if a separable Evaluate() function
+ * exists.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_FUNCTION_ADD_EVALUATE_BATCH_HPP
+#define ENSMALLEN_FUNCTION_ADD_EVALUATE_BATCH_HPP
+
+#include "traits.hpp"
+
+namespace ens {
+
+/**
+ * The AddEvaluateBatch mixin class will add an EvaluateBatch() method---which
+ * returns the summed objective of a whole schedule of (begin, batchSize)
+ * ranges---if a separable Evaluate() method exists, or nothing otherwise.
+ *
+ * EvaluateBatch() is an optional part of the separable function contract:
+ * functions backed by vectorized or GPU pipelines can implement it directly
+ * and process the entire schedule internally, amortizing the per-call
+ * boundary that one Evaluate() call per batch would impose.  Optimizers that
+ * evaluate the whole dataset at fixed coordinates (such as the exact
+ * objective passes of SGD and SVRG) call EvaluateBatch(); for functions that
+ * do not provide it, the synthesized version below simply loops over the
+ * schedule.
+ */
+template<typename FunctionType,
+         typename MatType,
+         typename GradType,
+         bool HasSeparableEvaluate =
+             traits::HasEvaluate<FunctionType,
+                 traits::TypedForms<MatType, GradType>::template
+                     SeparableEvaluateForm>::value,
+         bool HasEvaluateBatch =
+             traits::HasEvaluateBatch<FunctionType,
+                 traits::TypedForms<MatType, GradType>::template
+                     EvaluateBatchForm>::value>
+class AddEvaluateBatch
+{
+ public:
+  // Provide a dummy overload so the name 'EvaluateBatch' exists for this
+  // object.
+  typename MatType::elem_type EvaluateBatch(
+      traits::UnconstructableType&,
+      const std::vector<std::pair<size_t, size_t>>&);
+};
+
+/**
+ * Reflect the existing EvaluateBatch().
+ */
+template<typename FunctionType,
+         typename MatType,
+         typename GradType,
+         bool HasSeparableEvaluate>
+class AddEvaluateBatch<FunctionType, MatType, GradType,
+    HasSeparableEvaluate, true>
+{
+ public:
+  // Reflect the existing EvaluateBatch().
+  typename MatType::elem_type EvaluateBatch(
+      const MatType& coordinates,
+      const std::vector<std::pair<size_t, size_t>>& schedule)
+  {
+    return static_cast<FunctionType*>(
+        static_cast<Function<FunctionType,
+                             MatType,
+                             GradType>*>(this))->EvaluateBatch(coordinates,
+                                                               schedule);
+  }
+};
+
+/**
+ * If we have a separable Evaluate() but not an EvaluateBatch(), add an
+ * EvaluateBatch() method that loops over the schedule.
+ */
+template<typename FunctionType, typename MatType, typename GradType>
+class AddEvaluateBatch<FunctionType, MatType, GradType, true, false>
+{
+ public:
+  /**
+   * Return the summed objective function for the given schedule of
+   * (begin, batchSize) ranges of individual functions.
+   *
+   * @param coordinates Coordinates to evaluate the function at.
+   * @param schedule Ranges of individual functions to evaluate.
+   */
+  typename MatType::elem_type EvaluateBatch(
+      const MatType& coordinates,
+      const std::vector<std::pair<size_t, size_t>>& schedule)
+  {
+    typename MatType::elem_type objective = 0;
+    for (size_t i = 0; i < schedule.size(); ++i)
+    {
+      objective += static_cast<Function<FunctionType,
+                                        MatType,
+                                        GradType>*>(this)->Evaluate(
+          coordinates, schedule[i].first, schedule[i].second);
+    }
+    return objective;
+  }
+};
+
+/**
+ * The AddEvaluateBatchConst mixin class will add a const EvaluateBatch()
+ * method if a separable const Evaluate() method exists, or nothing otherwise.
+ */
+template<typename FunctionType,
+         typename MatType,
+         typename GradType,
+         bool HasSeparableEvaluate =
+             traits::HasEvaluate<FunctionType,
+                 traits::TypedForms<MatType, GradType>::template
+                     SeparableEvaluateConstForm>::value,
+         bool HasEvaluateBatch =
+             traits::HasEvaluateBatch<FunctionType,
+                 traits::TypedForms<MatType, GradType>::template
+                     EvaluateBatchConstForm>::value>
+class AddEvaluateBatchConst
+{
+ public:
+  // Provide a dummy overload so the name 'EvaluateBatch' exists for this
+  // object.
+  typename MatType::elem_type EvaluateBatch(
+      traits::UnconstructableType&,
+      const std::vector<std::pair<size_t, size_t>>&) const;
+};
+
+/**
+ * Reflect the existing const EvaluateBatch().
+ */
+template<typename FunctionType,
+         typename MatType,
+         typename GradType,
+         bool HasSeparableEvaluate>
+class AddEvaluateBatchConst<FunctionType, MatType, GradType,
+    HasSeparableEvaluate, true>
+{
+ public:
+  // Reflect the existing EvaluateBatch().
+  typename MatType::elem_type EvaluateBatch(
+      const MatType& coordinates,
+      const std::vector<std::pair<size_t, size_t>>& schedule) const
+  {
+    return static_cast<const FunctionType*>(
+        static_cast<const Function<FunctionType,
+                                   MatType,
+                                   GradType>*>(this))->EvaluateBatch(
+        coordinates, schedule);
+  }
+};
+
+/**
+ * If we have a separable const Evaluate() but not a const EvaluateBatch(),
+ * add a const EvaluateBatch() method that loops over the schedule.
+ */
+template<typename FunctionType, typename MatType, typename GradType>
+class AddEvaluateBatchConst<FunctionType, MatType, GradType, true, false>
+{
+ public:
+  /**
+   * Return the summed objective function for the given schedule of
+   * (begin, batchSize) ranges of individual functions.
+   *
+   * @param coordinates Coordinates to evaluate the function at.
+   * @param schedule Ranges of individual functions to evaluate.
+   */
+  typename MatType::elem_type EvaluateBatch(
+      const MatType& coordinates,
+      const std::vector<std::pair<size_t, size_t>>& schedule) const
+  {
+    typename MatType::elem_type objective = 0;
+    for (size_t i = 0; i < schedule.size(); ++i)
+    {
+      objective += static_cast<const Function<FunctionType,
+                                              MatType,
+                                              GradType>*>(this)->Evaluate(
+          coordinates, schedule[i].first, schedule[i].second);
+    }
+    return objective;
+  }
+};
+
+/**
+ * The AddEvaluateBatchStatic mixin class will add a static EvaluateBatch()
+ * method if a separable static Evaluate() method exists, or nothing
+ * otherwise.
+ */
+template<typename FunctionType,
+         typename MatType,
+         typename GradType,
+         bool HasSeparableEvaluate =
+             traits::HasEvaluate<FunctionType,
+                 traits::TypedForms<MatType, GradType>::template
+                     SeparableEvaluateStaticForm>::value,
+         bool HasEvaluateBatch =
+             traits::HasEvaluateBatch<FunctionType,
+                 traits::TypedForms<MatType, GradType>::template
+                     EvaluateBatchStaticForm>::value>
+class AddEvaluateBatchStatic
+{
+ public:
+  // Provide a dummy overload so the name 'EvaluateBatch' exists for this
+  // object.
+  static typename MatType::elem_type EvaluateBatch(
+      traits::UnconstructableType&,
+      const std::vector<std::pair<size_t, size_t>>&);
+};
+
+/**
+ * Reflect the existing static EvaluateBatch().
+ */
+template<typename FunctionType,
+         typename MatType,
+         typename GradType,
+         bool HasSeparableEvaluate>
+class AddEvaluateBatchStatic<FunctionType, MatType, GradType,
+    HasSeparableEvaluate, true>
+{
+ public:
+  // Reflect the existing EvaluateBatch().
+  static typename MatType::elem_type EvaluateBatch(
+      const MatType& coordinates,
+      const std::vector<std::pair<size_t, size_t>>& schedule)
+  {
+    return FunctionType::EvaluateBatch(coordinates, schedule);
+  }
+};
+
+/**
+ * If we have a separable static Evaluate() but not a static EvaluateBatch(),
+ * add a static EvaluateBatch() method that loops over the schedule.
+ */
+template<typename FunctionType, typename MatType, typename GradType>
+class AddEvaluateBatchStatic<FunctionType, MatType, GradType, true, false>
+{
+ public:
+  /**
+   * Return the summed objective function for the given schedule of
+   * (begin, batchSize) ranges of individual functions.
+   *
+   * @param coordinates Coordinates to evaluate the function at.
+   * @param schedule Ranges of individual functions to evaluate.
+   */
+  static typename MatType::elem_type EvaluateBatch(
+      const MatType& coordinates,
+      const std::vector<std::pair<size_t, size_t>>& schedule)
+  {
+    typename MatType::elem_type objective = 0;
+    for (size_t i = 0; i < schedule.size(); ++i)
+    {
+      objective += FunctionType::Evaluate(coordinates, schedule[i].first,
+          schedule[i].second);
+    }
+    return objective;
+  }
+};
+
+} // namespace ens
+
+#endif
@@ -80,6 +80,13 @@ class AddEvaluateWithGradient<FunctionType,
 /**
  * If the FunctionType has Evaluate() and Gradient(), provide
  * EvaluateWithGradient().
+ *
+ * If the FunctionType additionally has a CachedEvaluate() method with the
+ * same signature as Evaluate(), that is called for the objective instead.
+ * This is a cooperative optimization hook for functions whose Evaluate() and
+ * Gradient() share expensive intermediates: CachedEvaluate() may store those
+ * intermediates, because it is always followed directly by a Gradient() call
+ * at the same coordinates, which can then reuse them instead of recomputing.
  */
 template<typename FunctionType, typename MatType, typename GradType>
 class AddEvaluateWithGradient<FunctionType, MatType, GradType, true, false>
@@ -96,13 +103,55 @@ class AddEvaluateWithGradient<FunctionType, MatType, GradType, true, false>
                                                    GradType& gradient)
   {
     const typename MatType::elem_type objective =
-        static_cast<Function<FunctionType,
-                             MatType, GradType>*>(this)->Evaluate(coordinates);
+        EvaluateForGradient<FunctionType>(coordinates);
     static_cast<Function<FunctionType,
                          MatType,
                          GradType>*>(this)->Gradient(coordinates, gradient);
     return objective;
   }
+
+ private:
+  //! Use the CachedEvaluate() hook for the objective, if it exists.
+  template<typename T>
+  typename std::enable_if<
+      traits::HasCachedEvaluate<T, traits::TypedForms<MatType, GradType>::
+          template EvaluateForm>::value ||
+      traits::HasCachedEvaluate<T, traits::TypedForms<MatType, GradType>::
+          template EvaluateConstForm>::value,
+      typename MatType::elem_type>::type
+  EvaluateForGradient(const MatType& coordinates)
+  {
+    static_assert(
+        traits::HasEvaluate<T, traits::TypedForms<MatType, GradType>::
+            template EvaluateForm>::value ||
+        traits::HasEvaluate<T, traits::TypedForms<MatType, GradType>::
+            template EvaluateConstForm>::value,
+        "CachedEvaluate() is an optional hook, not a replacement: it must "
+        "return the same objective value as a matching Evaluate() method, "
+        "which must also exist.  CachedEvaluate() is always followed "
+        "directly by a Gradient() call with the same coordinates, so "
+        "intermediates it stores can be reused there.");
+
+    return static_cast<T*>(
+        static_cast<Function<FunctionType,
+                             MatType,
+                             GradType>*>(this))->CachedEvaluate(coordinates);
+  }
+
+  //! Otherwise, fall back to the regular Evaluate().
+  template<typename T>
+  typename std::enable_if<
+      !(traits::HasCachedEvaluate<T, traits::TypedForms<MatType, GradType>::
+          template EvaluateForm>::value ||
+        traits::HasCachedEvaluate<T, traits::TypedForms<MatType, GradType>::
+          template EvaluateConstForm>::value),
+      typename MatType::elem_type>::type
+  EvaluateForGradient(const MatType& coordinates)
+  {
+    return static_cast<Function<FunctionType,
+                                MatType,
+                                GradType>*>(this)->Evaluate(coordinates);
+  }
 };
 
 /**
@@ -166,6 +215,9 @@ class AddEvaluateWithGradientConst<FunctionType,
 /**
  * If the FunctionType has Evaluate() const and Gradient() const, provide
  * EvaluateWithGradient() const.
+ *
+ * As with the non-const variant, an optional const CachedEvaluate() hook is
+ * used for the objective if the FunctionType provides one.
  */
 template<typename FunctionType, typename MatType, typename GradType>
 class AddEvaluateWithGradientConst<FunctionType, MatType, GradType, true, false>
@@ -182,15 +234,51 @@ class AddEvaluateWithGradientConst<FunctionType, MatType, GradType, true, false>
                                                    GradType& gradient) const
   {
     const typename MatType::elem_type objective =
-        static_cast<const Function<FunctionType,
-                                   MatType,
-                                   GradType>*>(this)->Evaluate(coordinates);
+        EvaluateForGradient<FunctionType>(coordinates);
     static_cast<const Function<FunctionType,
                                MatType,
                                GradType>*>(this)->Gradient(coordinates,
                                                            gradient);
     return objective;
   }
+
+ private:
+  //! Use the CachedEvaluate() hook for the objective, if it exists.
+  template<typename T>
+  typename std::enable_if<
+      traits::HasCachedEvaluate<T, traits::TypedForms<MatType, GradType>::
+          template EvaluateConstForm>::value,
+      typename MatType::elem_type>::type
+  EvaluateForGradient(const MatType& coordinates) const
+  {
+    static_assert(
+        traits::HasEvaluate<T, traits::TypedForms<MatType, GradType>::
+            template EvaluateConstForm>::value,
+        "CachedEvaluate() is an optional hook, not a replacement: it must "
+        "return the same objective value as a matching Evaluate() method, "
+        "which must also exist.  CachedEvaluate() is always followed "
+        "directly by a Gradient() call with the same coordinates, so "
+        "intermediates it stores can be reused there.");
+
+    return static_cast<const T*>(
+        static_cast<const Function<FunctionType,
+                                   MatType,
+                                   GradType>*>(this))->CachedEvaluate(
+        coordinates);
+  }
+
+  //! Otherwise, fall back to the regular Evaluate().
+  template<typename T>
+  typename std::enable_if<
+      !traits::HasCachedEvaluate<T, traits::TypedForms<MatType, GradType>::
+          template EvaluateConstForm>::value,
+      typename MatType::elem_type>::type
+  EvaluateForGradient(const MatType& coordinates) const
+  {
+    return static_cast<const Function<FunctionType,
+                                      MatType,
+                                      GradType>*>(this)->Evaluate(coordinates);
+  }
 };
 
 /**
@@ -271,10 +359,42 @@ class AddEvaluateWithGradientStatic<FunctionType,
       const MatType& coordinates, GradType& gradient)
   {
     const typename MatType::elem_type objective =
-        FunctionType::Evaluate(coordinates);
+        EvaluateForGradient<FunctionType>(coordinates);
     FunctionType::Gradient(coordinates, gradient);
     return objective;
   }
+
+ private:
+  //! Use the static CachedEvaluate() hook for the objective, if it exists.
+  template<typename T>
+  static typename std::enable_if<
+      traits::HasCachedEvaluate<T, traits::TypedForms<MatType, GradType>::
+          template EvaluateStaticForm>::value,
+      typename MatType::elem_type>::type
+  EvaluateForGradient(const MatType& coordinates)
+  {
+    static_assert(
+        traits::HasEvaluate<T, traits::TypedForms<MatType, GradType>::
+            template EvaluateStaticForm>::value,
+        "CachedEvaluate() is an optional hook, not a replacement: it must "
+        "return the same objective value as a matching Evaluate() method, "
+        "which must also exist.  CachedEvaluate() is always followed "
+        "directly by a Gradient() call with the same coordinates, so "
+        "intermediates it stores can be reused there.");
+
+    return T::CachedEvaluate(coordinates);
+  }
+
+  //! Otherwise, fall back to the regular Evaluate().
+  template<typename T>
+  static typename std::enable_if<
+      !traits::HasCachedEvaluate<T, traits::TypedForms<MatType, GradType>::
+          template EvaluateStaticForm>::value,
+      typename MatType::elem_type>::type
+  EvaluateForGradient(const MatType& coordinates)
+  {
+    return FunctionType::Evaluate(coordinates);
+  }
 };
 
 } // namespace ens
@@ -0,0 +1,85 @@
+/**
+ * @file add_prefetch_batch.hpp
+ * @author Ryan Curtin
+ *
+ * Adds a no-op PrefetchBatch() method---which announces the (begin, batchSize)
+ * range that will be visited next---if the function does not provide one.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_FUNCTION_ADD_PREFETCH_BATCH_HPP
+#define ENSMALLEN_FUNCTION_ADD_PREFETCH_BATCH_HPP
+
+#include "traits.hpp"
+
+namespace ens {
+
+/**
+ * The AddPrefetchBatch mixin class will reflect an existing PrefetchBatch()
+ * method, or add a no-op version otherwise.
+ *
+ * PrefetchBatch() is an optional part of the separable function contract:
+ * separable optimizers announce the (begin, batchSize) range of the batch
+ * they will visit next before computing the current batch, so functions
+ * backed by disk or network storage can start loading the next batch
+ * asynchronously and overlap I/O with compute.  Implementations must not
+ * block; a typical implementation posts a read request to a background thread
+ * and the matching Evaluate()/Gradient() call waits for it to complete.  For
+ * functions that do not provide PrefetchBatch(), the synthesized version
+ * below does nothing.
+ */
+template<typename FunctionType,
+         typename MatType,
+         typename GradType,
+         bool HasPrefetchBatch =
+             traits::HasPrefetchBatch<FunctionType,
+                 traits::TypedForms<MatType, GradType>::template
+                     PrefetchBatchForm>::value ||
+             traits::HasPrefetchBatch<FunctionType,
+                 traits::TypedForms<MatType, GradType>::template
+                     PrefetchBatchConstForm>::value ||
+             traits::HasPrefetchBatch<FunctionType,
+                 traits::TypedForms<MatType, GradType>::template
+                     PrefetchBatchStaticForm>::value>
+class AddPrefetchBatch
+{
+ public:
+  /**
+   * The function does not implement PrefetchBatch(), so announcing the next
+   * batch does nothing.
+   */
+  void PrefetchBatch(const size_t /* begin */, const size_t /* batchSize */)
+  { }
+};
+
+/**
+ * Reflect the existing PrefetchBatch(); the call below resolves whether the
+ * function implements it as a non-const, const or static method.
+ */
+template<typename FunctionType, typename MatType, typename GradType>
+class AddPrefetchBatch<FunctionType, MatType, GradType, true>
+{
+ public:
+  /**
+   * Announce the range of individual functions that will be visited next, so
+   * the function can start loading it asynchronously.
+   *
+   * @param begin Index of the first function of the next batch.
+   * @param batchSize Number of functions in the next batch.
+   */
+  void PrefetchBatch(const size_t begin, const size_t batchSize)
+  {
+    static_cast<FunctionType*>(
+        static_cast<Function<FunctionType,
+                             MatType,
+                             GradType>*>(this))->PrefetchBatch(begin,
+                                                               batchSize);
+  }
+};
+
+} // namespace ens
+
+#endif
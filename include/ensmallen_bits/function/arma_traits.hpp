@@ -45,11 +45,31 @@ struct MatTypeTraits<arma::SpRow<eT>>
   typedef arma::SpMat<eT> BaseMatType;
 };
 
+#ifdef ENS_USE_COOT
+
+template<typename eT>
+struct MatTypeTraits<coot::Col<eT>>
+{
+  typedef coot::Mat<eT> BaseMatType;
+};
+
+template<typename eT>
+struct MatTypeTraits<coot::Row<eT>>
+{
+  typedef coot::Mat<eT> BaseMatType;
+};
+
+#endif
+
 /**
  * Disable usage of arma::subviews and related types for optimizers.  It might
  * be nice to also explicitly disable Armadillo expressions, but we'll hope for
  * now nobody even tries that, since those aren't even lvalues and thus can't
  * really work.
+ *
+ * (The SGD family is the exception: it accepts dense subviews through
+ * SubviewAdapter below, so a slice of a larger parameter block can be
+ * optimized without copying it out first.)
  */
 
 template<typename eT>
@@ -109,6 +129,83 @@ struct MatTypeTraits<arma::Cube<eT>>
       "or a matrix alias instead!");
 };
 
+/**
+ * If value == true, then MatType is a dense Armadillo subview type.  This is
+ * used by optimizers that can operate on a view of a larger parameter block
+ * (currently the SGD family) to dispatch to SubviewAdapter instead of the
+ * MatTypeTraits error above.
+ */
+template<typename MatType>
+struct IsDenseSubviewType : std::false_type { };
+
+template<typename eT>
+struct IsDenseSubviewType<arma::subview<eT>> : std::true_type { };
+
+template<typename eT>
+struct IsDenseSubviewType<arma::subview_col<eT>> : std::true_type { };
+
+template<typename eT>
+struct IsDenseSubviewType<arma::subview_row<eT>> : std::true_type { };
+
+/**
+ * A RAII adapter that presents a dense Armadillo subview as a plain
+ * arma::Mat for the duration of an optimization.  If the view is contiguous
+ * in the parent's memory (a full-height column block, or a segment of a
+ * single column), the matrix is a zero-copy alias and every optimizer update
+ * lands directly in the parent matrix.  Otherwise the elements are copied in
+ * on construction and written back through the view on destruction, so the
+ * cost is one copy per Optimize() call instead of one per iteration.
+ */
+template<typename eT>
+class SubviewAdapter
+{
+ public:
+  //! Wrap the given view; alias it if it is contiguous, else copy it in.
+  explicit SubviewAdapter(arma::subview<eT>& view) :
+      view(view),
+      contiguous((view.n_cols == 1) || (view.n_rows == view.m.n_rows)),
+      mat(NULL)
+  {
+    if (contiguous)
+    {
+      // The adapter is only handed writable views, so shedding the const
+      // that subview uses for its parent reference is safe.
+      eT* ptr = const_cast<eT*>(view.m.memptr()) +
+          view.aux_col1 * view.m.n_rows + view.aux_row1;
+      mat = new arma::Mat<eT>(ptr, view.n_rows, view.n_cols, false, true);
+    }
+    else
+    {
+      mat = new arma::Mat<eT>(view);
+    }
+  }
+
+  //! Write a copied iterate back through the view.
+  ~SubviewAdapter()
+  {
+    if (!contiguous)
+      view = *mat;
+    delete mat;
+  }
+
+  //! Get the matrix to optimize; contiguity decides whether it aliases.
+  arma::Mat<eT>& Matrix() { return *mat; }
+
+  // The adapter holds a raw alias, so it cannot be copied.
+  SubviewAdapter(const SubviewAdapter&) = delete;
+  SubviewAdapter& operator=(const SubviewAdapter&) = delete;
+
+ private:
+  //! The wrapped view.
+  arma::subview<eT>& view;
+
+  //! Whether the view's elements are contiguous in the parent's memory.
+  const bool contiguous;
+
+  //! Alias of, or working copy of, the view's elements.
+  arma::Mat<eT>* mat;
+};
+
 /**
  * Issue a fatal error if the type is not an Armadillo double or floating point
  * sparse or dense matrix.
@@ -130,6 +227,12 @@ template<>
 inline void RequireDenseFloatingPointType<arma::mat>() { }
 template<>
 inline void RequireDenseFloatingPointType<arma::fmat>() { }
+#ifdef ENS_USE_COOT
+template<>
+inline void RequireDenseFloatingPointType<coot::mat>() { }
+template<>
+inline void RequireDenseFloatingPointType<coot::fmat>() { }
+#endif
 
 template<typename MatType>
 void RequireFloatingPointType()
@@ -152,6 +255,12 @@ template<>
 inline void RequireFloatingPointType<arma::sp_mat>() { }
 template<>
 inline void RequireFloatingPointType<arma::sp_fmat>() { }
+#ifdef ENS_USE_COOT
+template<>
+inline void RequireFloatingPointType<coot::mat>() { }
+template<>
+inline void RequireFloatingPointType<coot::fmat>() { }
+#endif
 
 /**
  * Require that the internal element type of the matrix type and gradient type
@@ -0,0 +1,91 @@
+/**
+ * @file bounded_evaluate.hpp
+ * @author Ryan Curtin
+ *
+ * Dispatch an objective evaluation to the optional bound-aware
+ * Evaluate(coordinates, bound) form, if the function provides one.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_FUNCTION_BOUNDED_EVALUATE_HPP
+#define ENSMALLEN_FUNCTION_BOUNDED_EVALUATE_HPP
+
+#include "traits.hpp"
+
+namespace ens {
+namespace traits {
+
+/**
+ * Check whether the given FunctionType has a bound-aware Evaluate() method
+ * for the given MatType; that is, an overload of the form
+ *
+ *   ElemType Evaluate(const MatType& coordinates, const ElemType bound);
+ *
+ * which may stop the evaluation early once it can prove the result is no
+ * better than the given bound (e.g. once a running sum of per-stage costs
+ * crosses it).  The contract for such an overload is: any value below the
+ * bound must be the exact objective, while any returned value at or above
+ * the bound only certifies that the true objective is no better than the
+ * bound.
+ */
+template<typename FunctionType, typename MatType>
+struct HasBoundedEvaluate
+{
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+
+  const static bool value =
+      HasEvaluate<FunctionType,
+          TypedForms<BaseMatType, BaseMatType>::template
+              BoundedEvaluateForm>::value ||
+      HasEvaluate<FunctionType,
+          TypedForms<BaseMatType, BaseMatType>::template
+              BoundedEvaluateConstForm>::value ||
+      HasEvaluate<FunctionType,
+          TypedForms<BaseMatType, BaseMatType>::template
+              BoundedEvaluateStaticForm>::value;
+};
+
+} // namespace traits
+
+/**
+ * Evaluate the given function at the given coordinates, passing the given
+ * bound through to the function if it implements the bound-aware
+ * Evaluate(coordinates, bound) form (see traits::HasBoundedEvaluate), and
+ * falling back to the plain Evaluate(coordinates) otherwise.  Comparing
+ * optimizers use this to hand their current incumbent (or rejection
+ * threshold) to the function, so multi-stage objectives can abandon a
+ * candidate once its partial objective can no longer win the comparison.
+ *
+ * @param function Function to evaluate.
+ * @param coordinates Coordinates to evaluate the function at.
+ * @param bound Objective value the result will be compared against.
+ */
+template<typename FunctionType, typename MatType>
+inline typename std::enable_if<
+    traits::HasBoundedEvaluate<FunctionType, MatType>::value,
+    typename MatType::elem_type>::type
+EvaluateWithBound(FunctionType& function,
+                  const MatType& coordinates,
+                  const typename MatType::elem_type bound)
+{
+  return function.Evaluate(coordinates, bound);
+}
+
+//! Fallback for functions without the bound-aware Evaluate() form.
+template<typename FunctionType, typename MatType>
+inline typename std::enable_if<
+    !traits::HasBoundedEvaluate<FunctionType, MatType>::value,
+    typename MatType::elem_type>::type
+EvaluateWithBound(FunctionType& function,
+                  const MatType& coordinates,
+                  const typename MatType::elem_type /* bound */)
+{
+  return function.Evaluate(coordinates);
+}
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,224 @@
+/**
+ * @file counting_function.hpp
+ * @author Ryan Curtin
+ *
+ * An adapter that counts the Evaluate()/Gradient()/EvaluateWithGradient()
+ * calls (and, for separable functions, the samples) made against the wrapped
+ * function, for evaluation-budget accounting and fair optimizer comparisons.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_FUNCTION_COUNTING_FUNCTION_HPP
+#define ENSMALLEN_FUNCTION_COUNTING_FUNCTION_HPP
+
+#include "static_checks.hpp"
+
+namespace ens {
+
+/**
+ * The CountingFunction adapter wraps a function and counts every call an
+ * optimizer makes against it, so that evaluation-budget accounting does not
+ * need hand-written counting shims:
+ *
+ * @code
+ * CountingFunction<RosenbrockFunction> f(rosenbrock);
+ * L_BFGS lbfgs;
+ * lbfgs.Optimize(f, coordinates);
+ * std::cout << f.Evaluations() << " objective evaluations." << std::endl;
+ * @endcode
+ *
+ * Each forwarded call costs one counter increment.  For separable functions
+ * the batch overloads also accumulate the number of samples touched, so the
+ * sample budget of mini-batch optimizers can be compared against full-batch
+ * ones.  Like the other adapters, the counting is strictly opt-in: functions
+ * passed to an optimizer directly are not touched, so there is no cost
+ * unless the wrapper is used.
+ *
+ * @tparam FunctionType The function type to be wrapped.
+ * @tparam MatType The matrix type used for coordinates.
+ * @tparam GradType The matrix type used for gradients.
+ */
+template<typename FunctionType,
+         typename MatType = arma::mat,
+         typename GradType = MatType>
+class CountingFunction
+{
+ public:
+  //! The element type of the objective.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Construct the adapter around the given function.  The function is held
+   * by reference, so it must outlive the adapter.
+   *
+   * @param function The function to wrap.
+   */
+  CountingFunction(FunctionType& function) :
+      function(function),
+      evaluations(0),
+      gradients(0),
+      evaluateWithGradients(0),
+      samples(0)
+  { /* Nothing to do. */ }
+
+  /**
+   * Evaluate the wrapped function and count the call.
+   *
+   * @param coordinates Coordinates to evaluate the function at.
+   */
+  ElemType Evaluate(const MatType& coordinates)
+  {
+    typedef Function<FunctionType, MatType, GradType> FullFunctionType;
+    FullFunctionType& f = static_cast<FullFunctionType&>(function);
+
+    ++evaluations;
+    return f.Evaluate(coordinates);
+  }
+
+  /**
+   * Compute the gradient of the wrapped function and count the call.
+   *
+   * @param coordinates Coordinates to evaluate the gradient at.
+   * @param gradient Matrix to store the gradient into.
+   */
+  void Gradient(const MatType& coordinates, GradType& gradient)
+  {
+    typedef Function<FunctionType, MatType, GradType> FullFunctionType;
+    FullFunctionType& f = static_cast<FullFunctionType&>(function);
+
+    ++gradients;
+    f.Gradient(coordinates, gradient);
+  }
+
+  /**
+   * Evaluate the wrapped function with its gradient and count the call.
+   *
+   * @param coordinates Coordinates to evaluate the function at.
+   * @param gradient Matrix to store the gradient into.
+   */
+  ElemType EvaluateWithGradient(const MatType& coordinates,
+                                GradType& gradient)
+  {
+    typedef Function<FunctionType, MatType, GradType> FullFunctionType;
+    FullFunctionType& f = static_cast<FullFunctionType&>(function);
+
+    ++evaluateWithGradients;
+    return f.EvaluateWithGradient(coordinates, gradient);
+  }
+
+  /**
+   * Evaluate the wrapped separable function on the given batch, counting the
+   * call and the samples touched.
+   *
+   * @param coordinates Coordinates to evaluate the function at.
+   * @param begin Index of the first function to evaluate.
+   * @param batchSize Number of functions to evaluate.
+   */
+  ElemType Evaluate(const MatType& coordinates,
+                    const size_t begin,
+                    const size_t batchSize)
+  {
+    typedef Function<FunctionType, MatType, GradType> FullFunctionType;
+    FullFunctionType& f = static_cast<FullFunctionType&>(function);
+
+    ++evaluations;
+    samples += batchSize;
+    return f.Evaluate(coordinates, begin, batchSize);
+  }
+
+  /**
+   * Compute the gradient of the wrapped separable function on the given
+   * batch, counting the call and the samples touched.
+   *
+   * @param coordinates Coordinates to evaluate the gradient at.
+   * @param begin Index of the first function to evaluate.
+   * @param gradient Matrix to store the gradient into.
+   * @param batchSize Number of functions to evaluate.
+   */
+  void Gradient(const MatType& coordinates,
+                const size_t begin,
+                GradType& gradient,
+                const size_t batchSize)
+  {
+    typedef Function<FunctionType, MatType, GradType> FullFunctionType;
+    FullFunctionType& f = static_cast<FullFunctionType&>(function);
+
+    ++gradients;
+    samples += batchSize;
+    f.Gradient(coordinates, begin, gradient, batchSize);
+  }
+
+  /**
+   * Evaluate the wrapped separable function with its gradient on the given
+   * batch, counting the call and the samples touched.
+   *
+   * @param coordinates Coordinates to evaluate the function at.
+   * @param begin Index of the first function to evaluate.
+   * @param gradient Matrix to store the gradient into.
+   * @param batchSize Number of functions to evaluate.
+   */
+  ElemType EvaluateWithGradient(const MatType& coordinates,
+                                const size_t begin,
+                                GradType& gradient,
+                                const size_t batchSize)
+  {
+    typedef Function<FunctionType, MatType, GradType> FullFunctionType;
+    FullFunctionType& f = static_cast<FullFunctionType&>(function);
+
+    ++evaluateWithGradients;
+    samples += batchSize;
+    return f.EvaluateWithGradient(coordinates, begin, gradient, batchSize);
+  }
+
+  //! Forward the number of separable functions of the wrapped function.
+  size_t NumFunctions() const { return function.NumFunctions(); }
+
+  //! Forward the shuffling of the wrapped separable function.
+  void Shuffle() { function.Shuffle(); }
+
+  //! Get the wrapped function.
+  const FunctionType& WrappedFunction() const { return function; }
+  //! Modify the wrapped function.
+  FunctionType& WrappedFunction() { return function; }
+
+  //! Get the number of Evaluate() calls made so far.
+  size_t Evaluations() const { return evaluations; }
+  //! Get the number of Gradient() calls made so far.
+  size_t Gradients() const { return gradients; }
+  //! Get the number of EvaluateWithGradient() calls made so far.
+  size_t EvaluateWithGradients() const { return evaluateWithGradients; }
+  //! Get the number of samples touched by the batch overloads so far.
+  size_t Samples() const { return samples; }
+
+  //! Reset all counters to zero (e.g. between Optimize() runs).
+  void ResetCounters()
+  {
+    evaluations = 0;
+    gradients = 0;
+    evaluateWithGradients = 0;
+    samples = 0;
+  }
+
+ private:
+  //! The wrapped function.
+  FunctionType& function;
+
+  //! The number of Evaluate() calls.
+  size_t evaluations;
+
+  //! The number of Gradient() calls.
+  size_t gradients;
+
+  //! The number of EvaluateWithGradient() calls.
+  size_t evaluateWithGradients;
+
+  //! The number of samples touched by the batch overloads.
+  size_t samples;
+};
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,221 @@
+/**
+ * @file dual.hpp
+ * @author Ryan Curtin
+ *
+ * A dual-number scalar type for forward-mode automatic differentiation.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_FUNCTION_DUAL_HPP
+#define ENSMALLEN_FUNCTION_DUAL_HPP
+
+namespace ens {
+
+/**
+ * A dual number a + b * eps with eps^2 = 0: the value part a is propagated
+ * through arithmetic as usual, and the derivative part b is propagated by
+ * the chain rule, so evaluating a function on duals yields its value and an
+ * exact directional derivative in one forward pass.  Seed the derivative
+ * part of one input with 1 to differentiate with respect to that input (see
+ * DualFunction, which does this for whole gradients).
+ *
+ * The arithmetic operators, comparisons (which compare value parts, so
+ * branches in the evaluated code behave as they do on plain scalars), and
+ * the common <cmath> functions are provided; they are found by
+ * argument-dependent lookup from generic code.
+ *
+ * @tparam T The underlying floating-point type.
+ */
+template<typename T>
+class Dual
+{
+ public:
+  //! Construct a zero dual number.
+  Dual() : value(0), derivative(0) { /* Nothing to do here. */ }
+
+  //! Construct a constant (zero derivative part).
+  Dual(const T value) : value(value), derivative(0)
+  { /* Nothing to do here. */ }
+
+  //! Construct from a value and derivative part.
+  Dual(const T value, const T derivative) :
+      value(value), derivative(derivative)
+  { /* Nothing to do here. */ }
+
+  //! Get the value part.
+  T Value() const { return value; }
+  //! Modify the value part.
+  T& Value() { return value; }
+
+  //! Get the derivative part.
+  T Derivative() const { return derivative; }
+  //! Modify the derivative part.
+  T& Derivative() { return derivative; }
+
+  //! Compound addition.
+  Dual& operator+=(const Dual& other)
+  {
+    value += other.value;
+    derivative += other.derivative;
+    return *this;
+  }
+
+  //! Compound subtraction.
+  Dual& operator-=(const Dual& other)
+  {
+    value -= other.value;
+    derivative -= other.derivative;
+    return *this;
+  }
+
+  //! Compound multiplication (product rule).
+  Dual& operator*=(const Dual& other)
+  {
+    derivative = derivative * other.value + value * other.derivative;
+    value *= other.value;
+    return *this;
+  }
+
+  //! Compound division (quotient rule).
+  Dual& operator/=(const Dual& other)
+  {
+    derivative = (derivative * other.value - value * other.derivative) /
+        (other.value * other.value);
+    value /= other.value;
+    return *this;
+  }
+
+ private:
+  //! The value part.
+  T value;
+
+  //! The derivative part.
+  T derivative;
+};
+
+//! Unary negation.
+template<typename T>
+inline Dual<T> operator-(const Dual<T>& a)
+{ return Dual<T>(-a.Value(), -a.Derivative()); }
+
+//! Addition.
+template<typename T>
+inline Dual<T> operator+(Dual<T> a, const Dual<T>& b) { return a += b; }
+template<typename T>
+inline Dual<T> operator+(Dual<T> a, const T b) { return a += Dual<T>(b); }
+template<typename T>
+inline Dual<T> operator+(const T a, Dual<T> b) { return b += Dual<T>(a); }
+
+//! Subtraction.
+template<typename T>
+inline Dual<T> operator-(Dual<T> a, const Dual<T>& b) { return a -= b; }
+template<typename T>
+inline Dual<T> operator-(Dual<T> a, const T b) { return a -= Dual<T>(b); }
+template<typename T>
+inline Dual<T> operator-(const T a, Dual<T> b)
+{ return Dual<T>(a) -= b; }
+
+//! Multiplication.
+template<typename T>
+inline Dual<T> operator*(Dual<T> a, const Dual<T>& b) { return a *= b; }
+template<typename T>
+inline Dual<T> operator*(Dual<T> a, const T b) { return a *= Dual<T>(b); }
+template<typename T>
+inline Dual<T> operator*(const T a, Dual<T> b) { return b *= Dual<T>(a); }
+
+//! Division.
+template<typename T>
+inline Dual<T> operator/(Dual<T> a, const Dual<T>& b) { return a /= b; }
+template<typename T>
+inline Dual<T> operator/(Dual<T> a, const T b) { return a /= Dual<T>(b); }
+template<typename T>
+inline Dual<T> operator/(const T a, Dual<T> b)
+{ return Dual<T>(a) /= b; }
+
+//! Comparisons compare the value parts, so branches behave as on plain
+//! scalars (the derivative of max-like constructs is one-sided).
+template<typename T>
+inline bool operator<(const Dual<T>& a, const Dual<T>& b)
+{ return a.Value() < b.Value(); }
+template<typename T>
+inline bool operator>(const Dual<T>& a, const Dual<T>& b)
+{ return a.Value() > b.Value(); }
+template<typename T>
+inline bool operator<=(const Dual<T>& a, const Dual<T>& b)
+{ return a.Value() <= b.Value(); }
+template<typename T>
+inline bool operator>=(const Dual<T>& a, const Dual<T>& b)
+{ return a.Value() >= b.Value(); }
+template<typename T>
+inline bool operator==(const Dual<T>& a, const Dual<T>& b)
+{ return a.Value() == b.Value(); }
+template<typename T>
+inline bool operator!=(const Dual<T>& a, const Dual<T>& b)
+{ return a.Value() != b.Value(); }
+
+//! The common <cmath> functions, with derivative parts by the chain rule.
+template<typename T>
+inline Dual<T> exp(const Dual<T>& a)
+{
+  const T e = std::exp(a.Value());
+  return Dual<T>(e, a.Derivative() * e);
+}
+
+template<typename T>
+inline Dual<T> log(const Dual<T>& a)
+{ return Dual<T>(std::log(a.Value()), a.Derivative() / a.Value()); }
+
+template<typename T>
+inline Dual<T> sqrt(const Dual<T>& a)
+{
+  const T s = std::sqrt(a.Value());
+  return Dual<T>(s, a.Derivative() / (2 * s));
+}
+
+template<typename T>
+inline Dual<T> pow(const Dual<T>& a, const T p)
+{
+  return Dual<T>(std::pow(a.Value(), p),
+      a.Derivative() * p * std::pow(a.Value(), p - 1));
+}
+
+template<typename T>
+inline Dual<T> abs(const Dual<T>& a)
+{
+  return (a.Value() < 0) ? Dual<T>(-a.Value(), -a.Derivative()) : a;
+}
+
+template<typename T>
+inline Dual<T> sin(const Dual<T>& a)
+{
+  return Dual<T>(std::sin(a.Value()),
+      a.Derivative() * std::cos(a.Value()));
+}
+
+template<typename T>
+inline Dual<T> cos(const Dual<T>& a)
+{
+  return Dual<T>(std::cos(a.Value()),
+      -a.Derivative() * std::sin(a.Value()));
+}
+
+template<typename T>
+inline Dual<T> tan(const Dual<T>& a)
+{
+  const T t = std::tan(a.Value());
+  return Dual<T>(t, a.Derivative() * (1 + t * t));
+}
+
+template<typename T>
+inline Dual<T> tanh(const Dual<T>& a)
+{
+  const T t = std::tanh(a.Value());
+  return Dual<T>(t, a.Derivative() * (1 - t * t));
+}
+
+} // namespace ens
+
+#endif
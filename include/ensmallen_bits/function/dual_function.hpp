@@ -0,0 +1,163 @@
+/**
+ * @file dual_function.hpp
+ * @author Ryan Curtin
+ *
+ * An adapter that wraps a scalar-generic objective and exposes the regular
+ * differentiable FunctionType API, computing exact gradients with
+ * forward-mode dual-number differentiation.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_FUNCTION_DUAL_FUNCTION_HPP
+#define ENSMALLEN_FUNCTION_DUAL_FUNCTION_HPP
+
+#include "dual.hpp"
+
+namespace ens {
+
+/**
+ * The DualFunction adapter computes machine-precision gradients of a
+ * scalar-generic objective with forward-mode dual numbers (see Dual) and
+ * exposes the regular differentiable FunctionType API, so gradient-based
+ * optimizers such as L_BFGS can consume objectives for which no analytic
+ * gradient was written.  Each partial derivative costs one forward pass on
+ * duals (n passes per gradient, versus 2n for central finite differences),
+ * and the result is exact to machine precision rather than accurate to
+ * O(h^2), so line searches see consistent values and gradients.
+ *
+ * Armadillo matrices cannot hold a user-defined element type, so the
+ * wrapped objective is not the usual MatType-templated function; instead it
+ * must be written generically over the scalar type, evaluated on a
+ * std::vector of scalars:
+ *
+ * @code
+ * struct Calibration
+ * {
+ *   template<typename T>
+ *   T Evaluate(const std::vector<T>& x)
+ *   {
+ *     T sum(0);
+ *     for (size_t i = 0; i < x.size(); ++i)
+ *       sum += (x[i] - 2.0) * (x[i] - 2.0);
+ *     return sum;
+ *   }
+ * };
+ *
+ * Calibration c;
+ * DualFunction<Calibration> f(c);
+ * L_BFGS lbfgs;
+ * lbfgs.Optimize(f, coordinates);
+ * @endcode
+ *
+ * Inside Evaluate(), use the arithmetic operators, comparisons and <cmath>
+ * functions unqualified (they are found for duals by argument-dependent
+ * lookup).  The passes of one gradient are independent, so they are
+ * dispatched across all OpenMP threads; the wrapped Evaluate() must be safe
+ * to call simultaneously from multiple threads.  This is aimed at
+ * small-dimension problems (tens of parameters); for large n, the n passes
+ * of forward mode grow as expensive as finite differences.
+ *
+ * @tparam FunctionType The scalar-generic objective type to be wrapped.
+ */
+template<typename FunctionType>
+class DualFunction
+{
+ public:
+  /**
+   * Construct the adapter around the given objective.  The objective is
+   * held by reference, so it must outlive the adapter.
+   *
+   * @param function The scalar-generic objective to wrap.
+   */
+  DualFunction(FunctionType& function) : function(function)
+  { /* Nothing to do. */ }
+
+  /**
+   * Evaluate the wrapped objective.  The pass runs on zero-seeded duals
+   * (rather than plain scalars) so that the unqualified math calls in the
+   * objective always resolve through argument-dependent lookup.
+   *
+   * @param coordinates Coordinates to evaluate the objective at.
+   */
+  template<typename MatType>
+  typename MatType::elem_type Evaluate(const MatType& coordinates)
+  {
+    typedef typename MatType::elem_type ElemType;
+
+    std::vector<Dual<ElemType>> x(coordinates.n_elem);
+    for (size_t i = 0; i < coordinates.n_elem; ++i)
+      x[i] = Dual<ElemType>(coordinates(i));
+
+    return function.Evaluate(x).Value();
+  }
+
+  /**
+   * Compute the exact gradient of the wrapped objective with one dual
+   * forward pass per coordinate, evaluating the passes in parallel.
+   *
+   * @param coordinates Coordinates to evaluate the gradient at.
+   * @param gradient Matrix to store the gradient into.
+   */
+  template<typename MatType, typename GradType>
+  void Gradient(const MatType& coordinates, GradType& gradient)
+  {
+    EvaluateWithGradient(coordinates, gradient);
+  }
+
+  /**
+   * Evaluate the wrapped objective and compute its exact gradient with one
+   * dual forward pass per coordinate; the objective value falls out of the
+   * first pass for free.
+   *
+   * @param coordinates Coordinates to evaluate the objective at.
+   * @param gradient Matrix to store the gradient into.
+   */
+  template<typename MatType, typename GradType>
+  typename MatType::elem_type EvaluateWithGradient(const MatType& coordinates,
+                                                   GradType& gradient)
+  {
+    typedef typename MatType::elem_type ElemType;
+
+    std::vector<Dual<ElemType>> x(coordinates.n_elem);
+    for (size_t i = 0; i < coordinates.n_elem; ++i)
+      x[i] = Dual<ElemType>(coordinates(i));
+
+    gradient.set_size(coordinates.n_rows, coordinates.n_cols);
+    ElemType objective = 0;
+
+    // Each pass seeds the derivative part of one coordinate; the passes are
+    // independent, so they are spread over all threads.  The copy of the
+    // dual vector is per pass, which is negligible for the small-dimension
+    // objectives this adapter is meant for.
+    // Use a signed index: some OpenMP implementations require it.
+    ENS_PRAGMA_OMP_PARALLEL_FOR
+    for (ptrdiff_t i = 0; i < (ptrdiff_t) coordinates.n_elem; ++i)
+    {
+      std::vector<Dual<ElemType>> seeded = x;
+      seeded[i].Derivative() = 1;
+
+      const Dual<ElemType> result = function.Evaluate(seeded);
+      gradient(i) = result.Derivative();
+      if (i == 0)
+        objective = result.Value();
+    }
+
+    return objective;
+  }
+
+  //! Get the wrapped objective.
+  const FunctionType& WrappedFunction() const { return function; }
+  //! Modify the wrapped objective.
+  FunctionType& WrappedFunction() { return function; }
+
+ private:
+  //! The wrapped scalar-generic objective.
+  FunctionType& function;
+};
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,115 @@
+/**
+ * @file fidelity_evaluate.hpp
+ * @author Ryan Curtin
+ *
+ * Dispatch an objective evaluation to the optional fidelity-parameterized
+ * Evaluate(coordinates, fidelity) form, if the function provides one.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_FUNCTION_FIDELITY_EVALUATE_HPP
+#define ENSMALLEN_FUNCTION_FIDELITY_EVALUATE_HPP
+
+#include "traits.hpp"
+
+namespace ens {
+namespace traits {
+
+/**
+ * Check whether the given FunctionType has a fidelity-parameterized
+ * Evaluate() method for the given MatType; that is, an overload of the form
+ *
+ *   ElemType Evaluate(const MatType& coordinates, const size_t fidelity);
+ *
+ * which returns the objective obtained after spending the given fidelity (in
+ * problem-defined units, such as simulation steps, training epochs, or data
+ * subset sizes) on the evaluation.  Larger fidelities are expected to
+ * produce more reliable objective values; the fidelity at which the
+ * evaluation becomes exact can optionally be exposed through a
+ * size_t MaxFidelity() method (see GetMaxFidelity()).
+ */
+template<typename FunctionType, typename MatType>
+struct HasFidelityEvaluate
+{
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+
+  const static bool value =
+      HasEvaluate<FunctionType,
+          TypedForms<BaseMatType, BaseMatType>::template
+              FidelityEvaluateForm>::value ||
+      HasEvaluate<FunctionType,
+          TypedForms<BaseMatType, BaseMatType>::template
+              FidelityEvaluateConstForm>::value ||
+      HasEvaluate<FunctionType,
+          TypedForms<BaseMatType, BaseMatType>::template
+              FidelityEvaluateStaticForm>::value;
+};
+
+} // namespace traits
+
+/**
+ * Evaluate the given function at the given coordinates with the given
+ * fidelity, if the function implements the fidelity-parameterized
+ * Evaluate(coordinates, fidelity) form (see traits::HasFidelityEvaluate),
+ * and fall back to the plain (exact) Evaluate(coordinates) otherwise.  The
+ * fallback is correct for any fidelity---an exact evaluation is the highest
+ * fidelity---but does not realize the cost savings.
+ *
+ * @param function Function to evaluate.
+ * @param coordinates Coordinates to evaluate the function at.
+ * @param fidelity Fidelity (in problem-defined units) to spend.
+ */
+template<typename FunctionType, typename MatType>
+inline typename std::enable_if<
+    traits::HasFidelityEvaluate<FunctionType, MatType>::value,
+    typename MatType::elem_type>::type
+EvaluateWithFidelity(FunctionType& function,
+                     const MatType& coordinates,
+                     const size_t fidelity)
+{
+  return function.Evaluate(coordinates, fidelity);
+}
+
+//! Fallback for functions without the fidelity-parameterized Evaluate()
+//! form.
+template<typename FunctionType, typename MatType>
+inline typename std::enable_if<
+    !traits::HasFidelityEvaluate<FunctionType, MatType>::value,
+    typename MatType::elem_type>::type
+EvaluateWithFidelity(FunctionType& function,
+                     const MatType& coordinates,
+                     const size_t /* fidelity */)
+{
+  return function.Evaluate(coordinates);
+}
+
+/**
+ * Return the fidelity at which the given function's evaluation becomes
+ * exact, as reported by its MaxFidelity() method, or 0 if the function does
+ * not expose one (meaning the cost model is unknown).
+ *
+ * @param function Function to query.
+ */
+template<typename FunctionType>
+inline typename std::enable_if<
+    traits::HasMaxFidelitySignature<FunctionType>::value, size_t>::type
+GetMaxFidelity(FunctionType& function)
+{
+  return function.MaxFidelity();
+}
+
+//! Fallback for functions without a MaxFidelity() method.
+template<typename FunctionType>
+inline typename std::enable_if<
+    !traits::HasMaxFidelitySignature<FunctionType>::value, size_t>::type
+GetMaxFidelity(FunctionType& /* function */)
+{
+  return 0;
+}
+
+} // namespace ens
+
+#endif
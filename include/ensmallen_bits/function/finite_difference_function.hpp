@@ -0,0 +1,157 @@
+/**
+ * @file finite_difference_function.hpp
+ * @author Ryan Curtin
+ *
+ * An adapter that wraps a black-box function providing only Evaluate() and
+ * exposes the regular differentiable FunctionType API, synthesizing the
+ * gradient with central finite differences.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_FUNCTION_FINITE_DIFFERENCE_FUNCTION_HPP
+#define ENSMALLEN_FUNCTION_FINITE_DIFFERENCE_FUNCTION_HPP
+
+#include "static_checks.hpp"
+
+namespace ens {
+
+/**
+ * The FiniteDifferenceFunction adapter wraps any function satisfying the
+ * ArbitraryFunctionType API (just Evaluate()) and exposes the regular
+ * differentiable FunctionType API, approximating Gradient() with central
+ * differences:
+ *
+ * \f[
+ *     g_i = (f(x + h e_i) - f(x - h e_i)) / (2 h)
+ * \f]
+ *
+ * This allows gradient-based optimizers such as L_BFGS or GradientDescent to
+ * be used on black-box objectives that would otherwise be restricted to
+ * gradient-free methods:
+ *
+ * @code
+ * FiniteDifferenceFunction<BlackBoxFunction> f(blackBox);
+ * L_BFGS lbfgs;
+ * lbfgs.Optimize(f, coordinates);
+ * @endcode
+ *
+ * Each gradient costs 2n evaluations of the wrapped function (2n + 1 for
+ * EvaluateWithGradient()); since the evaluations are independent, they are
+ * dispatched across all OpenMP threads.  The wrapped function's Evaluate()
+ * must therefore be safe to call simultaneously from multiple threads.  When
+ * OpenMP is not enabled, the evaluations run serially.
+ *
+ * @tparam FunctionType The black-box function type to be wrapped.
+ */
+template<typename FunctionType>
+class FiniteDifferenceFunction
+{
+ public:
+  /**
+   * Construct the adapter around the given function.  The function is held
+   * by reference, so it must outlive the adapter.
+   *
+   * @param function The black-box function to wrap.
+   * @param stepSize Perturbation h used for the central differences; the
+   *     default is a reasonable choice for objectives whose coordinates and
+   *     values are of order one, but it should be scaled to the problem.
+   */
+  FiniteDifferenceFunction(FunctionType& function,
+                           const double stepSize = 1e-5) :
+      function(function),
+      stepSize(stepSize)
+  { /* Nothing to do. */ }
+
+  /**
+   * Evaluate the wrapped function.
+   *
+   * @param coordinates Coordinates to evaluate the function at.
+   */
+  template<typename MatType>
+  typename MatType::elem_type Evaluate(const MatType& coordinates)
+  {
+    typedef Function<FunctionType, MatType, MatType> FullFunctionType;
+    FullFunctionType& f = static_cast<FullFunctionType&>(function);
+
+    // Make sure the wrapped function has an objective.
+    traits::CheckArbitraryFunctionTypeAPI<FullFunctionType, MatType>();
+
+    return f.Evaluate(coordinates);
+  }
+
+  /**
+   * Approximate the gradient of the wrapped function with central
+   * differences, evaluating the perturbations in parallel.
+   *
+   * @param coordinates Coordinates to evaluate the gradient at.
+   * @param gradient Matrix to store the gradient into.
+   */
+  template<typename MatType, typename GradType>
+  void Gradient(const MatType& coordinates, GradType& gradient)
+  {
+    typedef typename MatType::elem_type ElemType;
+    typedef Function<FunctionType, MatType, GradType> FullFunctionType;
+    FullFunctionType& f = static_cast<FullFunctionType&>(function);
+
+    // Make sure the wrapped function has an objective.
+    traits::CheckArbitraryFunctionTypeAPI<FullFunctionType, MatType>();
+
+    gradient.set_size(coordinates.n_rows, coordinates.n_cols);
+
+    // The two evaluations of each coordinate are independent of all of the
+    // others, so the 2n evaluations are spread over all threads.  The copy of
+    // the coordinates is per perturbation, which is negligible next to the
+    // black-box evaluations this adapter is meant for.
+    // Use a signed index: some OpenMP implementations require it.
+    ENS_PRAGMA_OMP_PARALLEL_FOR
+    for (ptrdiff_t i = 0; i < (ptrdiff_t) coordinates.n_elem; ++i)
+    {
+      MatType perturbed = coordinates;
+      perturbed(i) = coordinates(i) + stepSize;
+      const ElemType forward = f.Evaluate(perturbed);
+      perturbed(i) = coordinates(i) - stepSize;
+      const ElemType backward = f.Evaluate(perturbed);
+
+      gradient(i) = (forward - backward) / (2 * stepSize);
+    }
+  }
+
+  /**
+   * Evaluate the wrapped function and approximate its gradient with central
+   * differences.
+   *
+   * @param coordinates Coordinates to evaluate the function at.
+   * @param gradient Matrix to store the gradient into.
+   */
+  template<typename MatType, typename GradType>
+  typename MatType::elem_type EvaluateWithGradient(const MatType& coordinates,
+                                                   GradType& gradient)
+  {
+    Gradient(coordinates, gradient);
+    return Evaluate(coordinates);
+  }
+
+  //! Get the wrapped function.
+  const FunctionType& WrappedFunction() const { return function; }
+  //! Modify the wrapped function.
+  FunctionType& WrappedFunction() { return function; }
+
+  //! Get the finite-difference step size.
+  double StepSize() const { return stepSize; }
+  //! Modify the finite-difference step size.
+  double& StepSize() { return stepSize; }
+
+ private:
+  //! The wrapped black-box function.
+  FunctionType& function;
+
+  //! Perturbation used for the central differences.
+  double stepSize;
+};
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,254 @@
+/**
+ * @file memoized_function.hpp
+ * @author Ryan Curtin
+ *
+ * An adapter that caches the objective and gradient of the wrapped function
+ * at the most recent coordinates, deduplicating the repeated same-point
+ * Evaluate()/Gradient() calls that line search based optimizers produce.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_FUNCTION_MEMOIZED_FUNCTION_HPP
+#define ENSMALLEN_FUNCTION_MEMOIZED_FUNCTION_HPP
+
+#include "static_checks.hpp"
+
+namespace ens {
+
+/**
+ * The MemoizedFunction adapter wraps a differentiable function and caches the
+ * objective and gradient at the most recent coordinates.  Several optimizers
+ * visit the same point more than once---a line search accepts a step by
+ * evaluating the objective, and the outer loop then immediately asks for the
+ * gradient at the same coordinates (L_BFGS, AugLagrangian and FrankWolfe all
+ * show this pattern)---so serving the repeat from cache removes those
+ * duplicate evaluations without touching the optimizers:
+ *
+ * @code
+ * MemoizedFunction<ExpensiveFunction> f(expensive);
+ * L_BFGS lbfgs;
+ * lbfgs.Optimize(f, coordinates);
+ * @endcode
+ *
+ * An incoming point is first screened with a cheap fingerprint (the element
+ * count and a strided sample of elements, mixed into a single hash), which
+ * rejects almost all changed points without scanning the whole matrix; only
+ * when the fingerprint matches is the full element-wise comparison performed,
+ * so a cache hit can never serve a value from different coordinates.
+ *
+ * Only the latest point is cached (one stored coordinate matrix and one
+ * gradient), which is exactly the duplicate-point pattern above; the cache is
+ * not a history.  The adapter is not thread-safe.
+ *
+ * @tparam FunctionType The function type to be wrapped.
+ * @tparam MatType The matrix type used for coordinates.
+ * @tparam GradType The matrix type used for gradients.
+ */
+template<typename FunctionType,
+         typename MatType = arma::mat,
+         typename GradType = MatType>
+class MemoizedFunction
+{
+ public:
+  //! The element type of the cached objective.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Construct the adapter around the given function.  The function is held
+   * by reference, so it must outlive the adapter.
+   *
+   * @param function The function to wrap.
+   */
+  MemoizedFunction(FunctionType& function) :
+      function(function),
+      cachedObjective(0),
+      fingerprint(0),
+      hasPoint(false),
+      hasObjective(false),
+      hasGradient(false),
+      hits(0),
+      misses(0)
+  { /* Nothing to do. */ }
+
+  /**
+   * Evaluate the wrapped function, serving the result from cache when the
+   * coordinates are unchanged since the last call.
+   *
+   * @param coordinates Coordinates to evaluate the function at.
+   */
+  ElemType Evaluate(const MatType& coordinates)
+  {
+    typedef Function<FunctionType, MatType, GradType> FullFunctionType;
+    FullFunctionType& f = static_cast<FullFunctionType&>(function);
+    traits::CheckFunctionTypeAPI<FullFunctionType, MatType, GradType>();
+
+    if (CacheValid(coordinates) && hasObjective)
+    {
+      ++hits;
+      return cachedObjective;
+    }
+
+    Rebase(coordinates);
+    cachedObjective = f.Evaluate(coordinates);
+    hasObjective = true;
+    ++misses;
+    return cachedObjective;
+  }
+
+  /**
+   * Compute the gradient of the wrapped function, serving the result from
+   * cache when the coordinates are unchanged since the last call.
+   *
+   * @param coordinates Coordinates to evaluate the gradient at.
+   * @param gradient Matrix to store the gradient into.
+   */
+  void Gradient(const MatType& coordinates, GradType& gradient)
+  {
+    typedef Function<FunctionType, MatType, GradType> FullFunctionType;
+    FullFunctionType& f = static_cast<FullFunctionType&>(function);
+    traits::CheckFunctionTypeAPI<FullFunctionType, MatType, GradType>();
+
+    if (CacheValid(coordinates) && hasGradient)
+    {
+      ++hits;
+      gradient = cachedGradient;
+      return;
+    }
+
+    Rebase(coordinates);
+    f.Gradient(coordinates, cachedGradient);
+    hasGradient = true;
+    ++misses;
+    gradient = cachedGradient;
+  }
+
+  /**
+   * Evaluate the wrapped function and compute its gradient, serving both
+   * from cache when the coordinates are unchanged since the last call.
+   *
+   * @param coordinates Coordinates to evaluate the function at.
+   * @param gradient Matrix to store the gradient into.
+   */
+  ElemType EvaluateWithGradient(const MatType& coordinates,
+                                GradType& gradient)
+  {
+    typedef Function<FunctionType, MatType, GradType> FullFunctionType;
+    FullFunctionType& f = static_cast<FullFunctionType&>(function);
+    traits::CheckFunctionTypeAPI<FullFunctionType, MatType, GradType>();
+
+    if (CacheValid(coordinates) && hasObjective && hasGradient)
+    {
+      ++hits;
+      gradient = cachedGradient;
+      return cachedObjective;
+    }
+
+    Rebase(coordinates);
+    cachedObjective = f.EvaluateWithGradient(coordinates, cachedGradient);
+    hasObjective = true;
+    hasGradient = true;
+    ++misses;
+    gradient = cachedGradient;
+    return cachedObjective;
+  }
+
+  //! Get the wrapped function.
+  const FunctionType& WrappedFunction() const { return function; }
+  //! Modify the wrapped function.
+  FunctionType& WrappedFunction() { return function; }
+
+  //! Get the number of calls served from cache.
+  size_t Hits() const { return hits; }
+  //! Get the number of calls that reached the wrapped function.
+  size_t Misses() const { return misses; }
+
+ private:
+  /**
+   * Compute a cheap fingerprint of the coordinates: the element count and a
+   * strided sample of elements, mixed into a single hash.  The fingerprint
+   * is only a fast filter; matches are confirmed element-wise.
+   */
+  size_t Fingerprint(const MatType& coordinates) const
+  {
+    const size_t n = coordinates.n_elem;
+    const size_t stride = std::max<size_t>(1, n / 16);
+
+    size_t h = n;
+    for (size_t i = 0; i < n; i += stride)
+    {
+      // Reinterpret the element bits into an integer and mix them in
+      // (a Fibonacci-style combine).
+      const double value = (double) coordinates[i];
+      size_t bits = 0;
+      std::memcpy(&bits, &value, std::min(sizeof(bits), sizeof(value)));
+      h ^= bits + (size_t) 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    }
+
+    return h;
+  }
+
+  //! Check whether the cached point matches the given coordinates.
+  bool CacheValid(const MatType& coordinates) const
+  {
+    if (!hasPoint || Fingerprint(coordinates) != fingerprint)
+      return false;
+
+    // The fingerprint matched; confirm with the exact comparison so that a
+    // hash collision can never serve a stale value.
+    return (coordinates.n_rows == cachedCoordinates.n_rows) &&
+        (coordinates.n_cols == cachedCoordinates.n_cols) &&
+        (std::memcmp(coordinates.memptr(), cachedCoordinates.memptr(),
+            coordinates.n_elem * sizeof(ElemType)) == 0);
+  }
+
+  //! Make the given coordinates the cached point, invalidating any stored
+  //! objective and gradient.
+  void Rebase(const MatType& coordinates)
+  {
+    if (CacheValid(coordinates))
+      return;
+
+    cachedCoordinates = coordinates;
+    fingerprint = Fingerprint(coordinates);
+    hasPoint = true;
+    hasObjective = false;
+    hasGradient = false;
+  }
+
+  //! The wrapped function.
+  FunctionType& function;
+
+  //! The coordinates the cache refers to.
+  MatType cachedCoordinates;
+
+  //! The cached gradient at the cached coordinates.
+  GradType cachedGradient;
+
+  //! The cached objective at the cached coordinates.
+  ElemType cachedObjective;
+
+  //! The fingerprint of the cached coordinates.
+  size_t fingerprint;
+
+  //! Whether a point has been cached at all.
+  bool hasPoint;
+
+  //! Whether the cached objective is valid.
+  bool hasObjective;
+
+  //! Whether the cached gradient is valid.
+  bool hasGradient;
+
+  //! The number of calls served from cache.
+  size_t hits;
+
+  //! The number of calls that reached the wrapped function.
+  size_t misses;
+};
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,240 @@
+/**
+ * @file multithreaded_evaluate.hpp
+ * @author Ryan Curtin
+ *
+ * An adapter that wraps a separable function and exposes the regular
+ * FunctionType API, computing the full objective and gradient with an
+ * internal OpenMP reduction over the individual functions.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_FUNCTION_MULTITHREADED_EVALUATE_HPP
+#define ENSMALLEN_FUNCTION_MULTITHREADED_EVALUATE_HPP
+
+#include "static_checks.hpp"
+
+namespace ens {
+
+/**
+ * The MultithreadedEvaluate adapter wraps any function satisfying the
+ * SeparableFunctionType API (NumFunctions(), and Evaluate() and Gradient()
+ * taking a starting index and a batch size) and exposes the regular
+ * FunctionType API.  Evaluate(), Gradient() and EvaluateWithGradient() sum
+ * the contributions of all individual functions, with the batches shared
+ * across OpenMP threads and each thread accumulating into its own buffer.
+ *
+ * This allows full-batch optimizers that take non-separable functions, such
+ * as L_BFGS or GradientDescent, to use every core on separable data without
+ * the threading being rewritten for each use:
+ *
+ * @code
+ * MultithreadedEvaluate<LogisticRegressionFunction> f(lrf);
+ * L_BFGS lbfgs;
+ * lbfgs.Optimize(f, coordinates);
+ * @endcode
+ *
+ * The wrapped function's separable Evaluate() and Gradient() methods must be
+ * safe to call simultaneously from multiple threads on disjoint batches.
+ * When OpenMP is not enabled, the reduction runs serially.
+ *
+ * @tparam SeparableFunctionType The separable function type to be wrapped.
+ */
+template<typename SeparableFunctionType>
+class MultithreadedEvaluate
+{
+ public:
+  /**
+   * Construct the adapter around the given separable function.  The function
+   * is held by reference, so it must outlive the adapter.
+   *
+   * @param function The separable function to wrap.
+   * @param batchSize Number of functions each thread evaluates at a time.
+   */
+  MultithreadedEvaluate(SeparableFunctionType& function,
+                        const size_t batchSize = 32) :
+      function(function),
+      batchSize(batchSize)
+  { /* Nothing to do. */ }
+
+  /**
+   * Evaluate the full objective, summing all of the individual functions
+   * across threads.
+   *
+   * @param coordinates Coordinates to evaluate the function at.
+   */
+  template<typename MatType>
+  typename MatType::elem_type Evaluate(const MatType& coordinates)
+  {
+    typedef typename MatType::elem_type ElemType;
+    typedef Function<SeparableFunctionType, MatType, MatType>
+        FullFunctionType;
+    FullFunctionType& f = static_cast<FullFunctionType&>(function);
+
+    // Make sure we have the separable methods we need.
+    traits::CheckSeparableFunctionTypeAPI<FullFunctionType, MatType,
+        MatType>();
+
+    const size_t numFunctions = f.NumFunctions();
+    ElemType objective = 0;
+
+    ENS_PRAGMA_OMP_PARALLEL_THREADS(
+        (int) ParallelRuntime::Get().RegionThreads())
+    {
+      ElemType threadObjective = 0;
+      size_t threadId = 0;
+      size_t numThreads = 1;
+      #ifdef ENS_USE_OPENMP
+        threadId = omp_get_thread_num();
+        numThreads = omp_get_num_threads();
+      #endif
+
+      // Batches are dealt round-robin to the threads.
+      for (size_t begin = threadId * batchSize; begin < numFunctions;
+           begin += numThreads * batchSize)
+      {
+        const size_t effectiveBatchSize = std::min(batchSize,
+            numFunctions - begin);
+        threadObjective += f.Evaluate(coordinates, begin, effectiveBatchSize);
+      }
+
+      ENS_PRAGMA_OMP_CRITICAL
+      {
+        objective += threadObjective;
+      }
+    }
+
+    return objective;
+  }
+
+  /**
+   * Evaluate the full gradient, summing the gradients of all of the
+   * individual functions across threads.
+   *
+   * @param coordinates Coordinates to evaluate the gradient at.
+   * @param gradient Matrix to store the gradient into.
+   */
+  template<typename MatType, typename GradType>
+  void Gradient(const MatType& coordinates, GradType& gradient)
+  {
+    typedef Function<SeparableFunctionType, MatType, GradType>
+        FullFunctionType;
+    FullFunctionType& f = static_cast<FullFunctionType&>(function);
+
+    // Make sure we have the separable methods we need.
+    traits::CheckSeparableFunctionTypeAPI<FullFunctionType, MatType,
+        GradType>();
+
+    const size_t numFunctions = f.NumFunctions();
+    gradient.zeros(coordinates.n_rows, coordinates.n_cols);
+
+    ENS_PRAGMA_OMP_PARALLEL_THREADS(
+        (int) ParallelRuntime::Get().RegionThreads())
+    {
+      GradType threadGradient;
+      threadGradient.zeros(coordinates.n_rows, coordinates.n_cols);
+      GradType batchGradient;
+      size_t threadId = 0;
+      size_t numThreads = 1;
+      #ifdef ENS_USE_OPENMP
+        threadId = omp_get_thread_num();
+        numThreads = omp_get_num_threads();
+      #endif
+
+      for (size_t begin = threadId * batchSize; begin < numFunctions;
+           begin += numThreads * batchSize)
+      {
+        const size_t effectiveBatchSize = std::min(batchSize,
+            numFunctions - begin);
+        f.Gradient(coordinates, begin, batchGradient, effectiveBatchSize);
+        threadGradient += batchGradient;
+      }
+
+      ENS_PRAGMA_OMP_CRITICAL
+      {
+        gradient += threadGradient;
+      }
+    }
+  }
+
+  /**
+   * Evaluate the full objective and gradient together, summing the
+   * contributions of all of the individual functions across threads.
+   *
+   * @param coordinates Coordinates to evaluate the function at.
+   * @param gradient Matrix to store the gradient into.
+   */
+  template<typename MatType, typename GradType>
+  typename MatType::elem_type EvaluateWithGradient(const MatType& coordinates,
+                                                   GradType& gradient)
+  {
+    typedef typename MatType::elem_type ElemType;
+    typedef Function<SeparableFunctionType, MatType, GradType>
+        FullFunctionType;
+    FullFunctionType& f = static_cast<FullFunctionType&>(function);
+
+    // Make sure we have the separable methods we need.
+    traits::CheckSeparableFunctionTypeAPI<FullFunctionType, MatType,
+        GradType>();
+
+    const size_t numFunctions = f.NumFunctions();
+    gradient.zeros(coordinates.n_rows, coordinates.n_cols);
+    ElemType objective = 0;
+
+    ENS_PRAGMA_OMP_PARALLEL_THREADS(
+        (int) ParallelRuntime::Get().RegionThreads())
+    {
+      ElemType threadObjective = 0;
+      GradType threadGradient;
+      threadGradient.zeros(coordinates.n_rows, coordinates.n_cols);
+      GradType batchGradient;
+      size_t threadId = 0;
+      size_t numThreads = 1;
+      #ifdef ENS_USE_OPENMP
+        threadId = omp_get_thread_num();
+        numThreads = omp_get_num_threads();
+      #endif
+
+      for (size_t begin = threadId * batchSize; begin < numFunctions;
+           begin += numThreads * batchSize)
+      {
+        const size_t effectiveBatchSize = std::min(batchSize,
+            numFunctions - begin);
+        threadObjective += f.EvaluateWithGradient(coordinates, begin,
+            batchGradient, effectiveBatchSize);
+        threadGradient += batchGradient;
+      }
+
+      ENS_PRAGMA_OMP_CRITICAL
+      {
+        objective += threadObjective;
+        gradient += threadGradient;
+      }
+    }
+
+    return objective;
+  }
+
+  //! Get the wrapped function.
+  const SeparableFunctionType& WrappedFunction() const { return function; }
+  //! Modify the wrapped function.
+  SeparableFunctionType& WrappedFunction() { return function; }
+
+  //! Get the batch size.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the batch size.
+  size_t& BatchSize() { return batchSize; }
+
+ private:
+  //! The wrapped separable function.
+  SeparableFunctionType& function;
+
+  //! Number of functions each thread evaluates at a time.
+  size_t batchSize;
+};
+
+} // namespace ens
+
+#endif
@@ -251,6 +251,27 @@ struct CheckEvaluateWithGradient
               EvaluateWithGradientStaticForm>::value;
 };
 
+/**
+ * Check if a suitable overload of Hvp() (Hessian-vector product) is
+ * available.
+ *
+ * This is an optional extension of the FunctionType API: optimizers that can
+ * exploit curvature (such as NewtonCG) use it to dispatch to the exact
+ * Hessian-vector product when the function provides one, and fall back to a
+ * finite-difference approximation otherwise.  No optimizer requires it.
+ */
+template<typename FunctionType, typename MatType, typename GradType>
+struct CheckHvp
+{
+  const static bool value =
+      HasHvp<FunctionType,
+          TypedForms<MatType, GradType>::template HvpForm>::value ||
+      HasHvp<FunctionType,
+          TypedForms<MatType, GradType>::template HvpConstForm>::value ||
+      HasHvp<FunctionType,
+          TypedForms<MatType, GradType>::template HvpStaticForm>::value;
+};
+
 /**
  * Check if a suitable separable overload of EvaluateWithGradient() is
  * available.
@@ -21,12 +21,21 @@ namespace traits {
 
 //! Detect an Evaluate() method.
 ENS_HAS_EXACT_METHOD_FORM(Evaluate, HasEvaluate)
+//! Detect an optional CachedEvaluate() hook; it has the same form as
+//! Evaluate(), so the Evaluate() forms below are used for the check.
+ENS_HAS_EXACT_METHOD_FORM(CachedEvaluate, HasCachedEvaluate)
 //! Detect a Gradient() method.
 ENS_HAS_EXACT_METHOD_FORM(Gradient, HasGradient)
 //! Detect an EvaluateWithGradient() method.
 ENS_HAS_EXACT_METHOD_FORM(EvaluateWithGradient, HasEvaluateWithGradient)
+//! Detect an optional Hvp() (Hessian-vector product) method.
+ENS_HAS_EXACT_METHOD_FORM(Hvp, HasHvp)
+//! Detect an optional EvaluateBatch() method.
+ENS_HAS_EXACT_METHOD_FORM(EvaluateBatch, HasEvaluateBatch)
 //! Detect a NumFunctions() method.
 ENS_HAS_EXACT_METHOD_FORM(NumFunctions, HasNumFunctions)
+//! Detect an optional PrefetchBatch() method.
+ENS_HAS_EXACT_METHOD_FORM(PrefetchBatch, HasPrefetchBatch)
 //! Detect a Shuffle() method.
 ENS_HAS_EXACT_METHOD_FORM(Shuffle, HasShuffle)
 //! Detect a NumConstraints() method.
@@ -41,6 +50,8 @@ ENS_HAS_EXACT_METHOD_FORM(NumFeatures, HasNumFeatures)
 ENS_HAS_EXACT_METHOD_FORM(PartialGradient, HasPartialGradient)
 //! Detect an MaxIterations() method.
 ENS_HAS_EXACT_METHOD_FORM(MaxIterations, HasMaxIterations)
+//! Detect an optional MaxFidelity() method.
+ENS_HAS_EXACT_METHOD_FORM(MaxFidelity, HasMaxFidelity)
 //! Detect an ResetPolicy() method.
 ENS_HAS_EXACT_METHOD_FORM(ResetPolicy, HasResetPolicy)
 //! Detect an BatchSize() method.
@@ -69,6 +80,43 @@ struct TypedForms
   using EvaluateStaticForm = typename BaseMatType::elem_type(*)(
       const BaseMatType&);
 
+  //! This is the form of a non-const bound-aware Evaluate() method, which
+  //! may stop the evaluation early once the partial objective crosses the
+  //! given bound (see EvaluateWithBound() in bounded_evaluate.hpp).
+  template<typename FunctionType>
+  using BoundedEvaluateForm = typename BaseMatType::elem_type(FunctionType::*)(
+      const BaseMatType&, const typename BaseMatType::elem_type);
+
+  //! This is the form of a const bound-aware Evaluate() method.
+  template<typename FunctionType>
+  using BoundedEvaluateConstForm =
+      typename BaseMatType::elem_type(FunctionType::*)(
+      const BaseMatType&, const typename BaseMatType::elem_type) const;
+
+  //! This is the form of a static bound-aware Evaluate() method.
+  template<typename FunctionType>
+  using BoundedEvaluateStaticForm = typename BaseMatType::elem_type(*)(
+      const BaseMatType&, const typename BaseMatType::elem_type);
+
+  //! This is the form of a non-const fidelity-parameterized Evaluate()
+  //! method, which returns the objective obtained with the given evaluation
+  //! fidelity (see EvaluateWithFidelity() in fidelity_evaluate.hpp).
+  template<typename FunctionType>
+  using FidelityEvaluateForm =
+      typename BaseMatType::elem_type(FunctionType::*)(
+      const BaseMatType&, const size_t);
+
+  //! This is the form of a const fidelity-parameterized Evaluate() method.
+  template<typename FunctionType>
+  using FidelityEvaluateConstForm =
+      typename BaseMatType::elem_type(FunctionType::*)(
+      const BaseMatType&, const size_t) const;
+
+  //! This is the form of a static fidelity-parameterized Evaluate() method.
+  template<typename FunctionType>
+  using FidelityEvaluateStaticForm = typename BaseMatType::elem_type(*)(
+      const BaseMatType&, const size_t);
+
   //! This is the form of a non-const Gradient() method.
   template<typename FunctionType>
   using GradientForm = void(FunctionType::*)(const BaseMatType&, BaseGradType&);
@@ -99,6 +147,40 @@ struct TypedForms
   using EvaluateWithGradientStaticForm = typename BaseMatType::elem_type(*)(
       const BaseMatType&, BaseGradType&);
 
+  //! This is the form of a non-const Hvp() (Hessian-vector product) method,
+  //! which computes the product of the Hessian at the first argument with
+  //! the second argument, storing the result into the third.
+  template<typename FunctionType>
+  using HvpForm = void(FunctionType::*)(
+      const BaseMatType&, const BaseGradType&, BaseGradType&);
+
+  //! This is the form of a const Hvp() method.
+  template<typename FunctionType>
+  using HvpConstForm = void(FunctionType::*)(
+      const BaseMatType&, const BaseGradType&, BaseGradType&) const;
+
+  //! This is the form of a static Hvp() method.
+  template<typename FunctionType>
+  using HvpStaticForm = void(*)(
+      const BaseMatType&, const BaseGradType&, BaseGradType&);
+
+  //! This is the form of a non-const EvaluateBatch() method, which takes a
+  //! schedule of (begin, batchSize) ranges of individual functions.
+  template<typename FunctionType>
+  using EvaluateBatchForm = typename BaseMatType::elem_type(FunctionType::*)(
+      const BaseMatType&, const std::vector<std::pair<size_t, size_t>>&);
+
+  //! This is the form of a const EvaluateBatch() method.
+  template<typename FunctionType>
+  using EvaluateBatchConstForm =
+      typename BaseMatType::elem_type(FunctionType::*)(
+      const BaseMatType&, const std::vector<std::pair<size_t, size_t>>&) const;
+
+  //! This is the form of a static EvaluateBatch() method.
+  template<typename FunctionType>
+  using EvaluateBatchStaticForm = typename BaseMatType::elem_type(*)(
+      const BaseMatType&, const std::vector<std::pair<size_t, size_t>>&);
+
   //! This is the form of a non-const NumFunctions() method.
   template <typename FunctionType>
   using NumFunctionsForm = size_t(FunctionType::*)();
@@ -123,6 +205,20 @@ struct TypedForms
   template<typename FunctionType>
   using ShuffleStaticForm = void(*)();
 
+  //! This is the form of a non-const PrefetchBatch() method, which takes the
+  //! (begin, batchSize) range of the batch that will be visited next.
+  template<typename FunctionType>
+  using PrefetchBatchForm = void(FunctionType::*)(const size_t, const size_t);
+
+  //! This is the form of a const PrefetchBatch() method.
+  template<typename FunctionType>
+  using PrefetchBatchConstForm =
+      void(FunctionType::*)(const size_t, const size_t) const;
+
+  //! This is the form of a static PrefetchBatch() method.
+  template<typename FunctionType>
+  using PrefetchBatchStaticForm = void(*)(const size_t, const size_t);
+
   //! This is the form of a separable Evaluate() method.
   template<typename FunctionType>
   using SeparableEvaluateForm =
@@ -275,6 +371,22 @@ struct TypedForms
   using PartialGradientStaticForm = void(*)(
       const BaseMatType&, const size_t, BaseGradType&);
 
+  //! This is the form of a non-const PartialGradient() method that takes a
+  //! block of features at once.
+  template<typename FunctionType>
+  using BlockPartialGradientForm = void(FunctionType::*)(
+      const BaseMatType&, const arma::uvec&, BaseGradType&);
+
+  //! This is the form of a const block PartialGradient() method.
+  template<typename FunctionType>
+  using BlockPartialGradientConstForm = void(FunctionType::*)(
+      const BaseMatType&, const arma::uvec&, BaseGradType&) const;
+
+  //! This is the form of a static block PartialGradient() method.
+  template<typename FunctionType>
+  using BlockPartialGradientStaticForm = void(*)(
+      const BaseMatType&, const arma::uvec&, BaseGradType&);
+
   //! This is a utility struct that will match any non-const form.
   template<typename FunctionType, typename... Ts>
   using OtherForm = typename BaseMatType::elem_type(FunctionType::*)(Ts...);
@@ -420,6 +532,22 @@ struct HasMaxIterationsSignature
       HasMaxIterations<OptimizerType, HasMaxIterationsForm>::value;
 };
 
+//! Utility struct, check if size_t MaxFidelity() const or size_t
+//! MaxFidelity() exists.
+template<typename FunctionType>
+struct HasMaxFidelitySignature
+{
+  template<typename C>
+  using MaxFidelityConstForm = size_t(C::*)(void) const;
+
+  template<typename C>
+  using MaxFidelityForm = size_t(C::*)(void);
+
+  const static bool value =
+      HasMaxFidelity<FunctionType, MaxFidelityForm>::value ||
+      HasMaxFidelity<FunctionType, MaxFidelityConstForm>::value;
+};
+
 //! Utility struct, check if size_t NumFunctions() const or
 //! size_t NumFunctions() exists.
 template<typename OptimizerType>
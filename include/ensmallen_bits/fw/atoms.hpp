@@ -20,46 +20,65 @@ namespace ens {
  * Class to hold the information and operations of current atoms in the
  * soluton space.  This is not fully templatized, and may cost some extra
  * operations for the conversion.
+ *
+ * The atoms are stored in a preallocated sparse arena matrix that grows
+ * geometrically, so adding an atom does not reallocate and copy the whole
+ * dictionary, and the memory and algebra of the span scale with the stored
+ * nonzeros instead of the ambient dimension (lp ball atoms are signed unit
+ * vectors, so sparse-recovery problems keep one nonzero per atom).  An
+ * index keyed on the position of each atom's
+ * largest-magnitude element is kept for duplicate detection: if the linear
+ * constrained solver returns an atom that is already in the dictionary, the
+ * new coefficient is folded into the existing atom instead of growing the
+ * dictionary.
  */
 class Atoms
 {
  public:
-  Atoms(){ /* Nothing to do. */ }
+  Atoms() : numAtoms(0) { /* Nothing to do. */ }
 
   /**
-   * Add atom into the solution space.
+   * Add atom into the solution space.  If the atom is already present, its
+   * coefficient is increased by c instead.
    *
    * @param v new atom to be added.
    * @param c coefficient of the new atom.
    */
   void AddAtom(const arma::mat& v, FuncSq& function, const double c = 0)
   {
-    if (currentAtoms.is_empty())
-    {
-      CurrentAtoms() = v;
-      CurrentCoeffs().set_size(1);
-      CurrentCoeffs().fill(c);
-      atomSqTerm.set_size(1);
-      atomSqTerm(0) = std::pow(norm(function.MatrixA() * v, 2), 2);
-    }
-    else
+    const arma::sp_mat sv(v);
+
+    // Reuse the atom if the solver has produced it before.
+    const size_t existing = FindAtom(sv, v);
+    if (existing < numAtoms)
     {
-      currentAtoms.insert_cols(0, v);
-      arma::vec cVec(1);
-      cVec(0) = c;
-      currentCoeffs.insert_rows(0, cVec);
-      double tmp = std::pow(norm(function.MatrixA() * v, 2), 2);
-      arma::vec tmpVec(1);
-      tmpVec(0) = tmp;
-      atomSqTerm.insert_rows(0, tmpVec);
+      currentCoeffs(existing) += c;
+      return;
     }
+
+    // Grow the arena geometrically so the dictionary is not reallocated on
+    // every added atom.
+    if (numAtoms == atomArena.n_cols)
+      atomArena.resize(v.n_rows, std::max<size_t>(16, 2 * atomArena.n_cols));
+
+    atomArena.col(numAtoms) = sv;
+    atomIndex[AtomKey(v)].push_back(numAtoms);
+
+    currentCoeffs.resize(numAtoms + 1);
+    currentCoeffs(numAtoms) = c;
+    atomSqTerm.resize(numAtoms + 1);
+    // The dense-times-sparse product costs a column gather per stored
+    // nonzero of the atom instead of a full pass over the dictionary.
+    atomSqTerm(numAtoms) =
+        std::pow(norm(arma::vec(function.MatrixA() * sv), 2), 2);
+    ++numAtoms;
   }
 
 
   //! Recover the solution coordinate from the coefficients of current atoms.
   void RecoverVector(arma::mat& x)
   {
-    x = currentAtoms * currentCoeffs;
+    x = CurrentAtoms() * currentCoeffs;
   }
 
   /**
@@ -85,7 +104,7 @@ class Atoms
   {
     arma::vec sqTerm = 0.5 * atomSqTerm % square(currentCoeffs);
 
-    while (currentAtoms.n_cols > 1)
+    while (numAtoms > 1)
     {
       // Solve for current gradient.
       arma::mat x;
@@ -95,19 +114,13 @@ class Atoms
 
       // Find possible atom to be deleted.
       arma::vec gap = sqTerm -
-          currentCoeffs % trans(gradient.t() * currentAtoms);
+          currentCoeffs % trans(gradient.t() * CurrentAtoms());
       arma::uword ind;
       gap.min(ind);
 
       // Try deleting the atom.
-      arma::mat newAtoms(currentAtoms.n_rows, currentAtoms.n_cols - 1);
-      if (ind > 0)
-        newAtoms.cols(0, ind - 1) = currentAtoms.cols(0, ind - 1);
-      if (ind < (currentAtoms.n_cols - 1))
-      {
-        newAtoms.cols(ind, newAtoms.n_cols - 1) =
-            currentAtoms.cols(ind + 1, currentAtoms.n_cols - 1);
-      }
+      arma::sp_mat newAtoms(CurrentAtoms());
+      newAtoms.shed_col(ind);
 
       // Reoptimize the coefficients, we brute-forcely reoptimize in the span,
       // which would be used in UpdateSpan class. Alternatively, if you want to
@@ -125,9 +138,8 @@ class Atoms
       else
       {
         // Delete the atom from current atoms.
-        currentAtoms = newAtoms;
+        RemoveAtom(ind);
         currentCoeffs = newCoeffs;
-        atomSqTerm.shed_row(ind);
         sqTerm.shed_row(ind);
       } // else
     } // while
@@ -176,7 +188,7 @@ class Atoms
       // Update currentCoeffs with gradient descent method.
       arma::mat g;
       function.Gradient(x, g);
-      g = currentAtoms.t() * g;
+      g = CurrentAtoms().t() * g;
       currentCoeffs = currentCoeffs - stepSize * g;
 
       // Projection of currentCoeffs to satisfy the atom norm constraint.
@@ -198,17 +210,95 @@ class Atoms
   //! Modify the current atom coefficients.
   arma::vec& CurrentCoeffs() { return currentCoeffs; }
 
-  //! Get the current atoms.
-  const arma::mat& CurrentAtoms() const { return currentAtoms; }
-  //! Modify the current atoms.
-  arma::mat& CurrentAtoms() { return currentAtoms; }
+  //! Get the current atoms as a sparse matrix; the copy out of the arena
+  //! costs one pass over the stored nonzeros.
+  arma::sp_mat CurrentAtoms() const
+  { return arma::sp_mat(atomArena.cols(0, numAtoms - 1)); }
+
+  //! Get the number of atoms in the dictionary.
+  size_t NumAtoms() const { return numAtoms; }
 
  private:
+  /**
+   * Key of an atom in the duplicate index: the linear index of its
+   * largest-magnitude element.  Atoms returned by lp ball constrained
+   * solvers have their mass concentrated on few elements, so this key
+   * separates distinct atoms well; candidates that share a key are verified
+   * element by element in FindAtom().
+   */
+  static arma::uword AtomKey(const arma::mat& v)
+  {
+    arma::uword k = 0;
+    const arma::vec av = arma::abs(arma::vectorise(v));
+    av.max(k);
+    return k;
+  }
+
+  //! Return the arena position of an atom equal to v (given in both sparse
+  //! and dense form), or numAtoms if v has not been seen before.
+  size_t FindAtom(const arma::sp_mat& sv, const arma::mat& v) const
+  {
+    const std::map<arma::uword, std::vector<size_t>>::const_iterator it =
+        atomIndex.find(AtomKey(v));
+    if (it == atomIndex.end())
+      return numAtoms;
+
+    for (size_t j = 0; j < it->second.size(); ++j)
+    {
+      const size_t pos = it->second[j];
+      const arma::sp_mat diff = arma::sp_mat(atomArena.col(pos)) - sv;
+      if (diff.n_nonzero == 0)
+        return pos;
+    }
+
+    return numAtoms;
+  }
+
+  //! Remove the atom at the given position, keeping the order of the
+  //! remaining atoms and fixing up the duplicate index.
+  void RemoveAtom(const size_t ind)
+  {
+    for (std::map<arma::uword, std::vector<size_t>>::iterator it =
+        atomIndex.begin(); it != atomIndex.end(); ++it)
+    {
+      std::vector<size_t>& positions = it->second;
+      for (size_t p = 0; p < positions.size(); )
+      {
+        if (positions[p] == ind)
+        {
+          positions.erase(positions.begin() + p);
+        }
+        else
+        {
+          if (positions[p] > ind)
+            --positions[p];
+          ++p;
+        }
+      }
+    }
+
+    // Rebuild the arena without the removed column; this is one pass over
+    // the stored nonzeros, not over the ambient dimension.
+    arma::sp_mat kept(atomArena.cols(0, numAtoms - 1));
+    kept.shed_col(ind);
+    kept.resize(atomArena.n_rows, atomArena.n_cols);
+    atomArena = std::move(kept);
+    atomSqTerm.shed_row(ind);
+    --numAtoms;
+  }
+
   //! Coefficients of current atoms.
   arma::vec currentCoeffs;
 
-  //! Current atoms in the solution space.
-  arma::mat currentAtoms;
+  //! Preallocated sparse storage for the atoms; only the first numAtoms
+  //! columns are in use.
+  arma::sp_mat atomArena;
+
+  //! Number of atoms currently in the dictionary.
+  size_t numAtoms;
+
+  //! Index from atom key to arena positions, used for duplicate detection.
+  std::map<arma::uword, std::vector<size_t>> atomIndex;
 
   //! Atom square term: ||A * atom||^2, used in PruneSupport(). It is computed
   //! when an atom is added.
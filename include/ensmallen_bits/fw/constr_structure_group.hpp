@@ -55,6 +55,7 @@ namespace ens {
  *
  *    size_t NumGroups();
  *    double DualNorm(const arma::vec& yk, const int group_ind);
+ *    void DualNorms(const arma::mat& v, arma::vec& norms);
  *    ProjectToGroup(const arma::mat& v, const size_t groupId, arma::vec& y);
  *    void OptimalFromGroup(const arma::mat& v, const size_t groupId, arma::mat& s);
  *
@@ -87,26 +88,15 @@ class ConstrStructGroupSolver
   {
     typedef typename MatType::elem_type ElemType;
 
-    size_t nGroups = groupExtractor.NumGroups();
-    ElemType dualNorm = 0;
-    size_t optimalGroup = 1;
+    // Compute the dual norms of all groups in one batched pass instead of
+    // projecting each group into its own temporary, and take the largest.
+    arma::Col<ElemType> norms;
+    groupExtractor.DualNorms(v, norms);
 
-    // Find the optimal group.
-    for (size_t i = 1; i <= nGroups; ++i)
-    {
-      MatType y;
-      groupExtractor.ProjectToGroup(v, i, y);
-      ElemType newNorm = groupExtractor.DualNorm(y, i);
-
-      // Find the group with largest dual norm.
-      if (newNorm > dualNorm)
-      {
-        optimalGroup = i;
-        dualNorm = newNorm;
-      }
-    }
+    arma::uword optimalGroup = 0;
+    norms.max(optimalGroup);
 
-    groupExtractor.OptimalFromGroup(v, optimalGroup, s);
+    groupExtractor.OptimalFromGroup(v, optimalGroup + 1, s);
   }
 
  private:
@@ -136,7 +126,29 @@ class GroupLpBall
     dimOrig(dimOrig),
     groupIndicesList(groupIndicesList),
     lpBallSolver(p)
-  {/* Nothing to do. */}
+  {
+    // Flatten the group index lists into one contiguous array with CSR-style
+    // offsets, so the batched dual-norm computation is a single blocked
+    // gather followed by contiguous segment reductions.
+    groupOffsets.set_size(numGroups + 1);
+    size_t total = 0;
+    for (size_t g = 0; g < numGroups; ++g)
+    {
+      groupOffsets(g) = total;
+      total += this->groupIndicesList[g].n_elem;
+    }
+    groupOffsets(numGroups) = total;
+
+    flatIndices.set_size(total);
+    for (size_t g = 0; g < numGroups; ++g)
+    {
+      if (this->groupIndicesList[g].n_elem > 0)
+      {
+        flatIndices.subvec(groupOffsets(g), groupOffsets(g + 1) - 1) =
+            this->groupIndicesList[g];
+      }
+    }
+  }
 
   /**
    * Projection to specific group.
@@ -184,6 +196,69 @@ class GroupLpBall
       s(indList(i)) = sProj(i);
   }
 
+  /**
+   * Compute the dual norms of every group in one blocked pass: the vector is
+   * gathered through the flattened index array once, and the contiguous
+   * per-group segments are reduced independently---across threads when
+   * OpenMP is enabled---without any per-group temporaries.
+   *
+   * @param v Input vector.
+   * @param norms Output vector with the dual norm of every group.
+   */
+  template<typename MatType>
+  void DualNorms(const MatType& v,
+                 arma::Col<typename MatType::elem_type>& norms)
+  {
+    typedef typename MatType::elem_type ElemType;
+
+    norms.set_size(numGroups);
+
+    // One vectorized gather of all group elements; each group's elements
+    // stay contiguous in the gathered vector.
+    const arma::Col<ElemType> flat = arma::vectorise(v);
+    const arma::Col<ElemType> gathered = flat.elem(flatIndices);
+
+    // Dual exponent of the lp norm (only used for 1 < p < inf).
+    const double q = (p > 1.0 && p != std::numeric_limits<double>::infinity())
+        ? 1.0 / (1.0 - 1.0 / p) : 0.0;
+
+    const ElemType* mem = gathered.memptr();
+    ENS_PRAGMA_OMP_PARALLEL_FOR_THREADS(
+        (int) ParallelRuntime::Get().RegionThreads())
+    for (ptrdiff_t g = 0; g < (ptrdiff_t) numGroups; ++g)
+    {
+      const size_t begin = groupOffsets(g);
+      const size_t end = groupOffsets(g + 1);
+
+      ElemType acc = 0;
+      if (p == 1.0)
+      {
+        // Dual of l1 is the inf-norm.
+        for (size_t j = begin; j < end; ++j)
+          acc = std::max(acc, std::abs(mem[j]));
+      }
+      else if (p == std::numeric_limits<double>::infinity())
+      {
+        // Dual of inf is the 1-norm.
+        for (size_t j = begin; j < end; ++j)
+          acc += std::abs(mem[j]);
+      }
+      else if (p > 1.0)
+      {
+        // Dual of lp is the lq norm with 1/p + 1/q = 1.
+        for (size_t j = begin; j < end; ++j)
+          acc += std::pow(std::abs(mem[j]), (ElemType) q);
+        acc = std::pow(acc, (ElemType) (1.0 / q));
+      }
+      else
+      {
+        Log::Fatal << "Wrong norm p!" << std::endl;
+      }
+
+      norms(g) = acc;
+    }
+  }
+
   //! Get the number of groups.
   size_t NumGroups() const {return numGroups;}
   //! Modify the number of groups.
@@ -237,6 +312,13 @@ class GroupLpBall
 
   //! Each group uses lp norm
   ConstrLpBallSolver lpBallSolver;
+
+  //! All group index lists flattened into one contiguous array.
+  arma::uvec flatIndices;
+
+  //! CSR-style segment offsets into flatIndices, one entry per group plus a
+  //! trailing end marker.
+  arma::uvec groupOffsets;
 };
 
 } // namespace ens
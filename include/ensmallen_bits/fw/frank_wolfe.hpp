@@ -15,6 +15,8 @@
 #include "update_full_correction.hpp"
 #include "update_linesearch.hpp"
 #include "update_classic.hpp"
+#include "update_away_steps.hpp"
+#include "update_pairwise.hpp"
 #include "update_span.hpp"
 #include "constr_lpball.hpp"
 
@@ -55,14 +55,10 @@ inline void Proximal::ProjectToL1Ball(MatType& v, double tau)
   }
   const double theta = (simplexSum(rho) - tau) / rho;
 
-  // Threshold on absolute value of v with theta.
-  for (arma::uword j = 0; j < simplexSol.n_rows; j++)
-  {
-    if (v(j) >= 0.0)
-      v(j) = std::max(v(j) - theta, 0.0);
-    else
-      v(j) = std::min(v(j) + theta, 0.0);
-  }
+  // Soft-threshold the absolute value of v with theta in one vectorized
+  // expression instead of a scalar loop.
+  v = arma::sign(v) % arma::clamp(arma::abs(v) - theta, 0.0,
+      std::numeric_limits<double>::max());
 }
 
 /**
@@ -0,0 +1,180 @@
+/**
+ * @file stochastic_frank_wolfe.hpp
+ * @author Chenzhe Diao
+ *
+ * Stochastic Frank-Wolfe Algorithm for separable objectives.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_FW_STOCHASTIC_FRANK_WOLFE_HPP
+#define ENSMALLEN_FW_STOCHASTIC_FRANK_WOLFE_HPP
+
+#include "update_classic.hpp"
+#include "constr_lpball.hpp"
+
+namespace ens {
+
+/**
+ * Stochastic Frank-Wolfe minimizes a separable objective
+ *
+ * \f[
+ * f(A) = \sum_{i = 0}^{n} f_i(A)
+ * \f]
+ *
+ * over a compact convex domain \f$ D \f$ without ever forming the full
+ * gradient: in each iteration the linear minimization oracle is run against
+ * a mini-batch gradient estimate
+ *
+ * \f[
+ * s_k := arg\min_{s\in D} <s, \sum_{i \in B_k} \nabla f_i(x_k)>,
+ * \f]
+ *
+ * and the iterate is combined with \f$ s_k \f$ by the update rule, as in the
+ * deterministic FrankWolfe class.  Since the linear oracle is invariant to
+ * positive scaling of the gradient, an unbiased batch estimate suffices.
+ *
+ * Following the increasing-batch-size analysis of stochastic Frank-Wolfe,
+ * the batch grows geometrically (see BatchGrowth()) from BatchSize() until
+ * it covers the whole dataset, at which point the method continues as exact
+ * Frank-Wolfe; this keeps early iterations nearly free while retaining the
+ * deterministic convergence of the late iterations.  The duality gap
+ * termination check is only trusted once the batch is exact, since on a
+ * mini-batch the gap is a noisy estimate.
+ *
+ * StochasticFrankWolfe can optimize differentiable separable functions.  For
+ * more details, see the documentation on function types included with this
+ * distribution or on the ensmallen website.
+ *
+ * The LinearConstrSolverType and UpdateRuleType template parameters match
+ * the ones of FrankWolfe.  Note that update rules which evaluate the full
+ * objective in every iteration (e.g. line search or full correction) negate
+ * the point of stochastic gradients; UpdateClassic is the intended rule.
+ *
+ * @tparam LinearConstrSolverType Solver for the linear constrained problem.
+ * @tparam UpdateRuleType Rule to update the solution in each iteration.
+ */
+template<
+    typename LinearConstrSolverType,
+    typename UpdateRuleType>
+class StochasticFrankWolfe
+{
+ public:
+  /**
+   * Construct the stochastic Frank-Wolfe optimizer with the given function
+   * and parameters.  As with FrankWolfe, the constraint domain \f$ D \f$ is
+   * input at the initialization of linearConstrSolver.
+   *
+   * @param linearConstrSolver Solver for linear constrained problem.
+   * @param updateRule Rule for updating solution in each iteration.
+   * @param batchSize Initial batch size for the gradient estimate.
+   * @param maxIterations Maximum number of iterations allowed (0 means no
+   *     limit).
+   * @param tolerance Maximum absolute tolerance to terminate algorithm;
+   *     only checked once the batch covers the whole dataset.
+   * @param batchGrowth Geometric growth factor of the batch size per
+   *     iteration (must be >= 1; 1 keeps the batch size fixed).
+   */
+  StochasticFrankWolfe(const LinearConstrSolverType linearConstrSolver,
+                       const UpdateRuleType updateRule,
+                       const size_t batchSize = 32,
+                       const size_t maxIterations = 100000,
+                       const double tolerance = 1e-10,
+                       const double batchGrowth = 1.5);
+
+  /**
+   * Optimize the given separable function using stochastic Frank-Wolfe.  The
+   * given starting point will be modified to store the finishing point of
+   * the algorithm, and the exact final objective value (one full pass) is
+   * returned.
+   *
+   * @tparam SeparableFunctionType Type of the function to be optimized.
+   * @tparam MatType Type of objective matrix.
+   * @tparam GradType Type of gradient matrix (default is MatType).
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to be optimized.
+   * @param iterate Input with starting point, and will be modified to save
+   *                the output optimal solution coordinates.
+   * @param callbacks Callback functions.
+   * @return Objective value at the final solution.
+   */
+  template<typename SeparableFunctionType, typename MatType,
+           typename GradType, typename... CallbackTypes>
+  typename std::enable_if<IsArmaType<GradType>::value,
+      typename MatType::elem_type>::type
+  Optimize(SeparableFunctionType& function,
+           MatType& iterate,
+           CallbackTypes&&... callbacks);
+
+  //! Forward the MatType as GradType.
+  template<typename SeparableFunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(SeparableFunctionType& function,
+                                       MatType& iterate,
+                                       CallbackTypes&&... callbacks)
+  {
+    return Optimize<SeparableFunctionType, MatType, MatType,
+        CallbackTypes...>(function, iterate,
+        std::forward<CallbackTypes>(callbacks)...);
+  }
+
+  //! Get the linear constrained solver.
+  const LinearConstrSolverType& LinearConstrSolver()
+      const { return linearConstrSolver; }
+  //! Modify the linear constrained solver.
+  LinearConstrSolverType& LinearConstrSolver() { return linearConstrSolver; }
+
+  //! Get the update rule.
+  const UpdateRuleType& UpdateRule() const { return updateRule; }
+  //! Modify the update rule.
+  UpdateRuleType& UpdateRule() { return updateRule; }
+
+  //! Get the initial batch size.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the initial batch size.
+  size_t& BatchSize() { return batchSize; }
+
+  //! Get the maximum number of iterations (0 indicates no limit).
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of iterations (0 indicates no limit).
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the tolerance for termination.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance for termination.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the geometric growth factor of the batch size.
+  double BatchGrowth() const { return batchGrowth; }
+  //! Modify the geometric growth factor of the batch size.
+  double& BatchGrowth() { return batchGrowth; }
+
+ private:
+  //! The solver for constrained linear problem in first step.
+  LinearConstrSolverType linearConstrSolver;
+
+  //! The rule to update, used in the second step.
+  UpdateRuleType updateRule;
+
+  //! The initial batch size for the gradient estimate.
+  size_t batchSize;
+
+  //! The maximum number of allowed iterations.
+  size_t maxIterations;
+
+  //! The tolerance for termination.
+  double tolerance;
+
+  //! Geometric growth factor of the batch size per iteration.
+  double batchGrowth;
+};
+
+} // namespace ens
+
+// Include implementation.
+#include "stochastic_frank_wolfe_impl.hpp"
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * @file stochastic_frank_wolfe_impl.hpp
+ * @author Chenzhe Diao
+ *
+ * Stochastic Frank-Wolfe Algorithm for separable objectives.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_FW_STOCHASTIC_FRANK_WOLFE_IMPL_HPP
+#define ENSMALLEN_FW_STOCHASTIC_FRANK_WOLFE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "stochastic_frank_wolfe.hpp"
+
+#include <ensmallen_bits/function.hpp>
+
+namespace ens {
+
+//! Constructor of the StochasticFrankWolfe class.
+template<
+    typename LinearConstrSolverType,
+    typename UpdateRuleType>
+StochasticFrankWolfe<LinearConstrSolverType, UpdateRuleType>::
+StochasticFrankWolfe(const LinearConstrSolverType linearConstrSolver,
+                     const UpdateRuleType updateRule,
+                     const size_t batchSize,
+                     const size_t maxIterations,
+                     const double tolerance,
+                     const double batchGrowth) :
+    linearConstrSolver(linearConstrSolver),
+    updateRule(updateRule),
+    batchSize(batchSize),
+    maxIterations(maxIterations),
+    tolerance(tolerance),
+    batchGrowth(batchGrowth)
+{ /* Nothing to do. */ }
+
+//! Optimize the function (minimize).
+template<
+    typename LinearConstrSolverType,
+    typename UpdateRuleType>
+template<typename SeparableFunctionType, typename MatType, typename GradType,
+         typename... CallbackTypes>
+typename std::enable_if<IsArmaType<GradType>::value,
+typename MatType::elem_type>::type
+StochasticFrankWolfe<LinearConstrSolverType, UpdateRuleType>::Optimize(
+  SeparableFunctionType& function,
+  MatType& iterateIn,
+  CallbackTypes&&... callbacks)
+{
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef typename MatTypeTraits<GradType>::BaseMatType BaseGradType;
+
+  typedef Function<SeparableFunctionType, BaseMatType, BaseGradType>
+      FullFunctionType;
+  FullFunctionType& f = static_cast<FullFunctionType&>(function);
+
+  // Make sure we have all necessary functions.
+  traits::CheckSeparableFunctionTypeAPI<FullFunctionType, BaseMatType,
+      BaseGradType>();
+  RequireFloatingPointType<BaseMatType>();
+  RequireFloatingPointType<BaseGradType>();
+  RequireSameInternalTypes<BaseMatType, BaseGradType>();
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+
+  const size_t numFunctions = f.NumFunctions();
+
+  // To keep track of the function value estimate.
+  ElemType currentObjective = std::numeric_limits<ElemType>::max();
+
+  BaseGradType gradient(iterate.n_rows, iterate.n_cols);
+  BaseMatType s(iterate.n_rows, iterate.n_cols);
+  BaseMatType iterateNew(iterate.n_rows, iterate.n_cols);
+  double gap = 0;
+
+  // The batch size is grown geometrically in floating point, so that growth
+  // factors close to 1 still make progress instead of rounding to a fixed
+  // size.
+  double currentBatchSize = (double) std::max<size_t>(batchSize, 1);
+
+  // Controls early termination of the optimization process.
+  bool terminate = false;
+
+  Callback::BeginOptimization(*this, f, iterate, callbacks...);
+  for (size_t i = 1; i != maxIterations && !terminate; ++i)
+  {
+    // Sample the mini-batch for this iteration's gradient estimate; once
+    // the batch covers the dataset the method proceeds as exact
+    // Frank-Wolfe.
+    const size_t effectiveBatchSize = std::min(numFunctions,
+        (size_t) currentBatchSize);
+    const size_t begin = (effectiveBatchSize == numFunctions) ? 0 :
+        arma::as_scalar(arma::randi<arma::uvec>(1,
+        arma::distr_param(0, (int) (numFunctions - effectiveBatchSize))));
+
+    currentObjective = f.EvaluateWithGradient(iterate, begin, gradient,
+        effectiveBatchSize);
+
+    terminate |= Callback::EvaluateWithGradient(*this, f, iterate,
+        currentObjective, gradient, callbacks...);
+
+    // Output current objective function (a mini-batch estimate until the
+    // batch is exact).
+    Info << "StochasticFrankWolfe::Optimize(): iteration " << i
+        << ", batch size " << effectiveBatchSize << ", batch objective "
+        << currentObjective << "." << std::endl;
+
+    // Solve linear constrained problem, solution saved in s.  The linear
+    // oracle is invariant to positive scaling, so the unnormalized batch
+    // gradient can be passed directly.
+    linearConstrSolver.Optimize(gradient, s, callbacks...);
+
+    // Check duality gap for return condition; on a mini-batch the gap is
+    // only a noisy estimate, so convergence is declared solely from exact
+    // gradients.
+    gap = std::fabs(dot(iterate - s, gradient));
+    if (effectiveBatchSize == numFunctions && gap < tolerance)
+    {
+      Info << "StochasticFrankWolfe::Optimize(): minimized within tolerance "
+          << tolerance << "; " << "terminating optimization." << std::endl;
+
+      Callback::EndOptimization(*this, f, iterate, callbacks...);
+      return f.Evaluate(iterate, 0, numFunctions);
+    }
+
+    // Update solution, save in iterateNew.
+    updateRule.template Update<FullFunctionType, BaseMatType, BaseGradType>(
+        f, iterate, s, iterateNew, i);
+
+    iterate = std::move(iterateNew);
+    terminate |= Callback::StepTaken(*this, f, iterate, callbacks...);
+
+    // Grow the batch for the next iteration.
+    currentBatchSize = std::min((double) numFunctions,
+        currentBatchSize * batchGrowth);
+  }
+
+  Info << "StochasticFrankWolfe::Optimize(): maximum iterations ("
+      << maxIterations << ") reached; " << "terminating optimization."
+      << std::endl;
+
+  // Report the exact objective at the final iterate.
+  currentObjective = f.Evaluate(iterate, 0, numFunctions);
+
+  // The optimization is over, so it doesn't matter what the callback
+  // returns.
+  (void) Callback::Evaluate(*this, f, iterate, currentObjective,
+      callbacks...);
+
+  Callback::EndOptimization(*this, f, iterate, callbacks...);
+  return currentObjective;
+} // Optimize()
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,190 @@
+/**
+ * @file update_pairwise.hpp
+ * @author Chenzhe Diao
+ *
+ * Pairwise update method for FrankWolfe algorithm. Used as UpdateRuleType.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_FW_UPDATE_PAIRWISE_HPP
+#define ENSMALLEN_FW_UPDATE_PAIRWISE_HPP
+
+#include "line_search/line_search.hpp"
+
+namespace ens {
+
+/**
+ * Pairwise update rule for the FrankWolfe algorithm.  In each iteration,
+ * weight is moved directly from the away atom (the active atom most aligned
+ * with the gradient) to the FrankWolfe atom returned by the linear
+ * constrained solver, i.e. the step direction is \f$ s - v \f$.  The step
+ * size is found by line search and capped by the weight of the away atom, so
+ * the iterate stays a convex combination of the atoms.  Like the away-steps
+ * variant, this converges linearly on polytope domains for strongly convex
+ * objectives, and it tends to keep the active set even smaller.
+ *
+ * The active atom set and its weights are maintained in contiguous storage
+ * (an arma::mat of atom columns and an arma::vec of weights); atoms whose
+ * weight drops to zero are removed.  The starting point of the optimization
+ * is used as the initial atom, so it should be a point of the constraint
+ * domain (ideally a vertex).
+ *
+ * For more information, see the following.
+ * @code
+ * @inproceedings{LacosteJulien2015,
+ *   author    = {Lacoste-Julien, Simon and Jaggi, Martin},
+ *   title     = {On the Global Linear Convergence of Frank-Wolfe Optimization
+ *                Variants},
+ *   booktitle = {Advances in Neural Information Processing Systems 28},
+ *   year      = {2015}
+ * }
+ * @endcode
+ */
+class UpdatePairwise
+{
+ public:
+  /**
+   * Construct the pairwise update rule.
+   *
+   * @param maxIterations Max number of iterations in line search.
+   * @param tolerance Tolerance for termination of line search.
+   */
+  UpdatePairwise(const size_t maxIterations = 100000,
+                 const double tolerance = 1e-5) :
+      tolerance(tolerance), maxIterations(maxIterations)
+  { /* Do nothing. */ }
+
+  /**
+   * Pairwise update rule for FrankWolfe.
+   *
+   * @param function Function to be optimized.
+   * @param oldCoords Previous solution coords.
+   * @param s Current linear_constr_solution result.
+   * @param newCoords Output new solution coords.
+   * @param numIter Current iteration number.
+   */
+  template<typename FunctionType, typename MatType, typename GradType>
+  void Update(FunctionType& function,
+              const MatType& oldCoords,
+              const MatType& s,
+              MatType& newCoords,
+              const size_t /* numIter */)
+  {
+    // The atoms are stored as vectorized columns; coordinates of matrix
+    // shape are reshaped back when the new solution is formed.
+    const arma::vec x = arma::conv_to<arma::vec>::from(
+        arma::vectorise(oldCoords));
+    const arma::vec sv = arma::conv_to<arma::vec>::from(arma::vectorise(s));
+
+    // The first call seeds the active set with the starting point.
+    if (weights.is_empty())
+    {
+      atoms = x;
+      weights.set_size(1);
+      weights(0) = 1.0;
+    }
+
+    GradType gradient(arma::size(oldCoords));
+    function.Gradient(oldCoords, gradient);
+    const arma::vec g = arma::conv_to<arma::vec>::from(
+        arma::vectorise(gradient));
+
+    // Find the away atom: the active atom most aligned with the gradient.
+    const arma::rowvec alignments = g.t() * atoms;
+    arma::uword awayIndex = 0;
+    alignments.max(awayIndex);
+
+    // Move weight from the away atom to the FrankWolfe atom; the step size
+    // is capped by the weight of the away atom.
+    const arma::vec d = sv - atoms.col(awayIndex);
+    const double gammaMax = weights(awayIndex);
+
+    const double dNormSq = arma::dot(d, d);
+    if (dNormSq == 0.0)
+    {
+      newCoords = oldCoords;
+      return;
+    }
+
+    // Line search on the segment [x, x + gammaMax * d].
+    LineSearch solver(maxIterations, tolerance);
+    newCoords = arma::conv_to<MatType>::from(arma::reshape(
+        x + gammaMax * d, oldCoords.n_rows, oldCoords.n_cols));
+    solver.Optimize<FunctionType, MatType, GradType>(function, oldCoords,
+        newCoords);
+
+    // Recover the step size taken by the line search.
+    const double gamma = arma::dot(arma::conv_to<arma::vec>::from(
+        arma::vectorise(newCoords)) - x, d) / dNormSq;
+
+    // Update the atom weights.
+    weights(awayIndex) -= gamma;
+    AddWeight(sv, gamma);
+    DropZeroWeights();
+  }
+
+  //! Get the tolerance for termination of line search.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance for termination of line search.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the maximum number of iterations of line search.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of iterations of line search.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the active atoms.
+  const arma::mat& ActiveAtoms() const { return atoms; }
+  //! Get the active atom weights.
+  const arma::vec& ActiveWeights() const { return weights; }
+
+ private:
+  //! Add weight to an atom, appending it to the active set if it is new.
+  void AddWeight(const arma::vec& v, const double gamma)
+  {
+    for (size_t i = 0; i < atoms.n_cols; ++i)
+    {
+      if (arma::approx_equal(atoms.col(i), v, "absdiff", 1e-12))
+      {
+        weights(i) += gamma;
+        return;
+      }
+    }
+
+    atoms.insert_cols(atoms.n_cols, v);
+    weights.resize(weights.n_elem + 1);
+    weights(weights.n_elem - 1) = gamma;
+  }
+
+  //! Remove atoms whose weight has dropped to zero.
+  void DropZeroWeights()
+  {
+    for (size_t i = atoms.n_cols; i > 0; --i)
+    {
+      if (weights(i - 1) <= 1e-16)
+      {
+        atoms.shed_col(i - 1);
+        weights.shed_row(i - 1);
+      }
+    }
+  }
+
+  //! Tolerance for convergence of line search.
+  double tolerance;
+
+  //! Max number of iterations of line search.
+  size_t maxIterations;
+
+  //! Active atoms, stored as contiguous columns.
+  arma::mat atoms;
+
+  //! Weights of the active atoms.
+  arma::vec weights;
+};  // class UpdatePairwise
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ * @file agd.hpp
+ * @author Marcus Edel
+ *
+ * Nesterov-accelerated gradient descent with adaptive restarts.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_GRADIENT_DESCENT_AGD_HPP
+#define ENSMALLEN_GRADIENT_DESCENT_AGD_HPP
+
+namespace ens {
+
+/**
+ * Accelerated gradient descent (AGD) is Nesterov's accelerated variant of
+ * full-batch gradient descent.  Each iteration takes a gradient step from an
+ * extrapolated (lookahead) point rather than from the current iterate:
+ *
+ * \f[
+ * x_{k + 1} = y_k - \alpha \nabla F(y_k), \qquad
+ * y_{k + 1} = x_{k + 1} + \frac{t_k - 1}{t_{k + 1}} (x_{k + 1} - x_k)
+ * \f]
+ *
+ * with \f$ t_{k + 1} = (1 + \sqrt{1 + 4 t_k^2}) / 2 \f$.  On smooth convex
+ * problems this improves the convergence rate from O(1/k) for plain gradient
+ * descent to O(1/k^2), at the cost of one extra stored parameter-sized
+ * vector.  Whenever the objective increases between iterations, the momentum
+ * sequence is reset (an adaptive restart), which recovers monotone behavior
+ * in practice without estimating the function's strong convexity.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @article{Nesterov1983,
+ *   author  = {Nesterov, Yurii},
+ *   title   = {A method of solving a convex programming problem with
+ *              convergence rate O(1/k^2)},
+ *   journal = {Soviet Mathematics Doklady},
+ *   volume  = {27},
+ *   pages   = {372--376},
+ *   year    = {1983}
+ * }
+ *
+ * @article{ODonoghue2015,
+ *   author  = {O'Donoghue, Brendan and Cand{\`e}s, Emmanuel},
+ *   title   = {Adaptive restart for accelerated gradient schemes},
+ *   journal = {Foundations of Computational Mathematics},
+ *   volume  = {15},
+ *   pages   = {715--732},
+ *   year    = {2015}
+ * }
+ * @endcode
+ *
+ * AGD can optimize differentiable functions.  For more details, see the
+ * documentation on function types included with this distribution or on the
+ * ensmallen website.
+ */
+class AGD
+{
+ public:
+  /**
+   * Construct the accelerated gradient descent optimizer with the given
+   * parameters.  As with plain gradient descent, the step size must be
+   * tailored to the problem at hand (for an L-smooth objective, any step
+   * size up to 1 / L is safe).
+   *
+   * @param stepSize Step size for each iteration.
+   * @param maxIterations Maximum number of iterations allowed (0 means no
+   *     limit).
+   * @param tolerance Maximum absolute tolerance to terminate algorithm.
+   */
+  AGD(const double stepSize = 0.001,
+      const size_t maxIterations = 100000,
+      const double tolerance = 1e-5);
+
+  /**
+   * Optimize the given function using accelerated gradient descent.  The
+   * given starting point will be modified to store the finishing point of
+   * the algorithm, and the final objective value is returned.
+   *
+   * @tparam FunctionType Type of the function to optimize.
+   * @tparam MatType Type of matrix to optimize with.
+   * @tparam GradType Type of matrix to use to represent function gradients.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to optimize.
+   * @param iterate Starting point (will be modified).
+   * @param callbacks Callback functions.
+   * @return Objective value of the final point.
+   */
+  template<typename FunctionType,
+           typename MatType,
+           typename GradType,
+           typename... CallbackTypes>
+  typename std::enable_if<IsArmaType<GradType>::value,
+      typename MatType::elem_type>::type
+  Optimize(FunctionType& function,
+           MatType& iterate,
+           CallbackTypes&&... callbacks);
+
+  //! Forward the MatType as GradType.
+  template<typename FunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(FunctionType& function,
+                                       MatType& iterate,
+                                       CallbackTypes&&... callbacks)
+  {
+    return Optimize<FunctionType, MatType, MatType, CallbackTypes...>(
+        function, iterate, std::forward<CallbackTypes>(callbacks)...);
+  }
+
+  //! Get the step size.
+  double StepSize() const { return stepSize; }
+  //! Modify the step size.
+  double& StepSize() { return stepSize; }
+
+  //! Get the maximum number of iterations (0 indicates no limit).
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of iterations (0 indicates no limit).
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the tolerance for termination.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance for termination.
+  double& Tolerance() { return tolerance; }
+
+ private:
+  //! The step size for each iteration.
+  double stepSize;
+
+  //! The maximum number of allowed iterations.
+  size_t maxIterations;
+
+  //! The tolerance for termination.
+  double tolerance;
+};
+
+} // namespace ens
+
+#include "agd_impl.hpp"
+
+#endif
@@ -0,0 +1,141 @@
+/**
+ * @file agd_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of Nesterov-accelerated gradient descent with adaptive
+ * restarts.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_GRADIENT_DESCENT_AGD_IMPL_HPP
+#define ENSMALLEN_GRADIENT_DESCENT_AGD_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "agd.hpp"
+
+namespace ens {
+
+inline AGD::AGD(const double stepSize,
+                const size_t maxIterations,
+                const double tolerance) :
+    stepSize(stepSize),
+    maxIterations(maxIterations),
+    tolerance(tolerance)
+{ /* Nothing to do. */ }
+
+//! Optimize the function (minimize).
+template<typename FunctionType,
+         typename MatType,
+         typename GradType,
+         typename... CallbackTypes>
+typename std::enable_if<IsArmaType<GradType>::value,
+    typename MatType::elem_type>::type
+AGD::Optimize(FunctionType& function,
+              MatType& iterateIn,
+              CallbackTypes&&... callbacks)
+{
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef typename MatTypeTraits<GradType>::BaseMatType BaseGradType;
+
+  // Use the Function<> wrapper to ensure the function has all of the
+  // functions that we need.
+  typedef Function<FunctionType, BaseMatType, BaseGradType> FullFunctionType;
+  FullFunctionType& f = static_cast<FullFunctionType&>(function);
+
+  // Check that we have all the functions we will need.
+  traits::CheckFunctionTypeAPI<FullFunctionType, BaseMatType, BaseGradType>();
+  RequireFloatingPointType<BaseMatType>();
+  RequireFloatingPointType<BaseGradType>();
+  RequireSameInternalTypes<BaseMatType, BaseGradType>();
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+
+  // To keep track of the function value.
+  ElemType overallObjective = std::numeric_limits<ElemType>::max();
+  ElemType lastObjective = std::numeric_limits<ElemType>::max();
+
+  // During the optimization `iterate` holds the lookahead point y_k, from
+  // which the gradient is evaluated; `position` holds the most recent
+  // gradient step result x_k.  This is the only storage beyond what plain
+  // gradient descent needs.
+  BaseGradType gradient(iterate.n_rows, iterate.n_cols);
+  BaseMatType position = iterate;
+
+  // The momentum sequence t_k; t = 1 corresponds to no momentum.
+  double t = 1.0;
+
+  // Controls early termination of the optimization process.
+  bool terminate = false;
+
+  Callback::BeginOptimization(*this, f, iterate, callbacks...);
+  for (size_t i = 1; (i != maxIterations) && !terminate; ++i)
+  {
+    overallObjective = f.EvaluateWithGradient(iterate, gradient);
+    terminate |= Callback::EvaluateWithGradient(*this, f, iterate,
+        overallObjective, gradient, callbacks...);
+
+    // Output current objective function.
+    Info << "AGD: iteration " << i << ", objective " << overallObjective
+        << "." << std::endl;
+
+    if (std::isnan(overallObjective) || std::isinf(overallObjective))
+    {
+      Warn << "AGD: converged to " << overallObjective << "; terminating"
+          << " with failure.  Try a smaller step size?" << std::endl;
+
+      Callback::EndOptimization(*this, f, iterate, callbacks...);
+      return overallObjective;
+    }
+
+    if (std::abs(lastObjective - overallObjective) < tolerance)
+    {
+      Info << "AGD: minimized within tolerance " << tolerance << "; "
+          << "terminating optimization." << std::endl;
+
+      Callback::EndOptimization(*this, f, iterate, callbacks...);
+      return overallObjective;
+    }
+
+    // Adaptive restart: if the objective increased, the momentum has
+    // overshot, so reset the momentum sequence.  With t = 1 the
+    // extrapolation below vanishes and the next lookahead point coincides
+    // with the next iterate, exactly as if the optimization were restarted
+    // there.
+    if (overallObjective > lastObjective)
+      t = 1.0;
+
+    lastObjective = overallObjective;
+
+    // The gradient step from the lookahead point: iterate becomes x_{k+1}.
+    iterate -= stepSize * gradient;
+
+    // Extrapolate along the difference of the last two gradient step
+    // results.  The gradient buffer is free until the next evaluation, so
+    // reuse it to hold x_{k+1} - x_k.
+    const double tNext = 0.5 * (1.0 + std::sqrt(1.0 + 4.0 * t * t));
+    gradient = iterate - position;
+    position = iterate;
+    iterate += ((ElemType) ((t - 1.0) / tNext)) * gradient;
+    t = tNext;
+
+    terminate |= Callback::StepTaken(*this, f, iterate, callbacks...);
+  }
+
+  Info << "AGD: maximum iterations (" << maxIterations << ") reached; "
+      << "terminating optimization." << std::endl;
+
+  // Return the last gradient step result rather than the lookahead point.
+  iterate = std::move(position);
+
+  Callback::EndOptimization(*this, f, iterate, callbacks...);
+  return overallObjective;
+}
+
+} // namespace ens
+
+#endif
@@ -12,6 +12,11 @@
 #ifndef ENSMALLEN_GRADIENT_DESCENT_GRADIENT_DESCENT_HPP
 #define ENSMALLEN_GRADIENT_DESCENT_GRADIENT_DESCENT_HPP
 
+#include <ensmallen_bits/line_search/wolfe_line_search.hpp>
+
+#include "step_policies/fixed_step.hpp"
+#include "step_policies/barzilai_borwein_step.hpp"
+
 namespace ens {
 
 /**
@@ -39,8 +44,17 @@ namespace ens {
  * GradientDescent can optimize differentiable functions.  For more details, see
  * the documentation on function types included with this distribution or on the
  * ensmallen website.
+ *
+ * The step size used in each iteration is controlled by the StepPolicyType
+ * template parameter: FixedStep (the default) keeps the constructor-supplied
+ * step size for the entire run, while BarzilaiBorweinStep adapts the step
+ * size to the local curvature using the previous iterate and gradient pair,
+ * at no extra evaluation cost.
+ *
+ * @tparam StepPolicyType The step size policy to use.
  */
-class GradientDescent
+template<typename StepPolicyType = FixedStep>
+class GradientDescentType
 {
  public:
   /**
@@ -50,14 +64,18 @@ class GradientDescent
    * at hand.
    *
    * @param function Function to be optimized (minimized).
-   * @param stepSize Step size for each iteration.
+   * @param stepSize Step size for each iteration (the initial step size, if
+   *     the step size policy adapts it).
    * @param maxIterations Maximum number of iterations allowed (0 means no
    *     limit).
    * @param tolerance Maximum absolute tolerance to terminate algorithm.
+   * @param stepPolicy Instantiated step size policy used to adjust the step
+   *     size.
    */
-  GradientDescent(const double stepSize = 0.01,
-                  const size_t maxIterations = 100000,
-                  const double tolerance = 1e-5);
+  GradientDescentType(const double stepSize = 0.01,
+                      const size_t maxIterations = 100000,
+                      const double tolerance = 1e-5,
+                      const StepPolicyType& stepPolicy = StepPolicyType());
 
   /**
    * Optimize the given function using gradient descent.  The given starting
@@ -160,6 +178,24 @@ class GradientDescent
   //! Modify the tolerance for termination.
   double& Tolerance() { return tolerance; }
 
+  //! Get whether each iteration runs a strong-Wolfe line search along the
+  //! negative gradient instead of taking a fixed step of size StepSize().
+  //! This removes the need to hand-tune the step size per problem; StepSize()
+  //! then only seeds the first trial step of each search.
+  bool UseLineSearch() const { return useLineSearch; }
+  //! Modify whether each iteration runs a strong-Wolfe line search.
+  bool& UseLineSearch() { return useLineSearch; }
+
+  //! Get the line search used when UseLineSearch() is enabled.
+  const WolfeLineSearch& LineSearch() const { return lineSearch; }
+  //! Modify the line search used when UseLineSearch() is enabled.
+  WolfeLineSearch& LineSearch() { return lineSearch; }
+
+  //! Get the step size policy.
+  const StepPolicyType& StepPolicy() const { return stepPolicy; }
+  //! Modify the step size policy.
+  StepPolicyType& StepPolicy() { return stepPolicy; }
+
  private:
   //! The step size for each example.
   double stepSize;
@@ -169,8 +205,23 @@ class GradientDescent
 
   //! The tolerance for termination.
   double tolerance;
+
+  //! Whether each iteration runs a strong-Wolfe line search.
+  bool useLineSearch;
+
+  //! The line search used when useLineSearch is enabled.
+  WolfeLineSearch lineSearch;
+
+  //! The step size policy.
+  StepPolicyType stepPolicy;
 };
 
+//! Gradient descent with the conventional fixed step size.
+using GradientDescent = GradientDescentType<FixedStep>;
+
+//! Gradient descent with the Barzilai-Borwein adaptive step size.
+using BBGradientDescent = GradientDescentType<BarzilaiBorweinStep>;
+
 } // namespace ens
 
 #include "gradient_descent_impl.hpp"
@@ -20,25 +20,30 @@
 namespace ens {
 
 //! Constructor.
-inline GradientDescent::GradientDescent(
+template<typename StepPolicyType>
+GradientDescentType<StepPolicyType>::GradientDescentType(
     const double stepSize,
     const size_t maxIterations,
-    const double tolerance) :
+    const double tolerance,
+    const StepPolicyType& stepPolicy) :
     stepSize(stepSize),
     maxIterations(maxIterations),
-    tolerance(tolerance)
+    tolerance(tolerance),
+    useLineSearch(false),
+    stepPolicy(stepPolicy)
 { /* Nothing to do. */ }
 
 //! Optimize the function (minimize).
+template<typename StepPolicyType>
 template<typename FunctionType,
          typename MatType,
          typename GradType,
          typename... CallbackTypes>
 typename std::enable_if<IsArmaType<GradType>::value,
 typename MatType::elem_type>::type
-GradientDescent::Optimize(FunctionType& function,
-                          MatType& iterateIn,
-                          CallbackTypes&&... callbacks)
+GradientDescentType<StepPolicyType>::Optimize(FunctionType& function,
+                                              MatType& iterateIn,
+                                              CallbackTypes&&... callbacks)
 {
   // Convenience typedefs.
   typedef typename MatType::elem_type ElemType;
@@ -62,6 +67,16 @@ GradientDescent::Optimize(FunctionType& function,
   BaseMatType& iterate = (BaseMatType&) iterateIn;
   BaseGradType gradient(iterate.n_rows, iterate.n_cols);
 
+  // Working buffers for the line search, allocated only if it is used.
+  BaseMatType newIterateTmp;
+  BaseGradType searchDirection;
+
+  // Instantiate the step size policy for this optimization; the step size it
+  // adjusts starts from the configured fixed step size.
+  typename StepPolicyType::template Policy<BaseMatType, BaseGradType>
+      instStepPolicy(stepPolicy);
+  double currentStepSize = stepSize;
+
   // Controls early termination of the optimization process.
   bool terminate = false;
 
@@ -100,8 +115,32 @@ GradientDescent::Optimize(FunctionType& function,
     // Reset the counter variables.
     lastObjective = overallObjective;
 
+    // Let the step size policy adjust the step size for this iteration.
+    instStepPolicy.Update(iterate, currentStepSize, gradient);
+
     // And update the iterate.
-    iterate -= stepSize * gradient;
+    if (useLineSearch)
+    {
+      // Search along the negative gradient for a step satisfying the strong
+      // Wolfe conditions, seeding the first trial with the policy's step size.
+      searchDirection = -gradient;
+      lineSearch.InitialStep() = currentStepSize;
+      double finalStepSize; // Set by Search().
+      if (!lineSearch.Search(*this, f, overallObjective, iterate, gradient,
+          newIterateTmp, searchDirection, finalStepSize, terminate,
+          callbacks...))
+      {
+        Warn << "Gradient Descent: line search failed; terminating "
+            << "optimization." << std::endl;
+
+        Callback::EndOptimization(*this, f, iterate, callbacks...);
+        return overallObjective;
+      }
+    }
+    else
+    {
+      iterate -= currentStepSize * gradient;
+    }
     terminate |= Callback::StepTaken(*this, f, iterate, callbacks...);
   }
 
@@ -112,13 +151,14 @@ GradientDescent::Optimize(FunctionType& function,
   return overallObjective;
 }
 
+template<typename StepPolicyType>
 template<typename FunctionType,
          typename MatType,
          typename GradType,
          typename... CallbackTypes>
 typename std::enable_if<IsArmaType<GradType>::value,
 typename MatType::elem_type>::type
-GradientDescent::Optimize(
+GradientDescentType<StepPolicyType>::Optimize(
     FunctionType& function,
     MatType& iterate,
     const std::vector<bool>& categoricalDimensions,
@@ -0,0 +1,157 @@
+/**
+ * @file barzilai_borwein_step.hpp
+ * @author Sumedh Ghaisas
+ *
+ * Barzilai-Borwein adaptive step size policy for gradient descent.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_GRADIENT_DESCENT_STEP_POLICIES_BARZILAI_BORWEIN_STEP_HPP
+#define ENSMALLEN_GRADIENT_DESCENT_STEP_POLICIES_BARZILAI_BORWEIN_STEP_HPP
+
+namespace ens {
+
+/**
+ * The Barzilai-Borwein step size policy chooses the step size from the most
+ * recent iterate and gradient pair: with \f$ s = x_k - x_{k-1} \f$ and
+ * \f$ y = \nabla f(x_k) - \nabla f(x_{k-1}) \f$, the step
+ *
+ * \f[
+ * \alpha_k = \frac{s^T s}{s^T y}
+ * \f]
+ *
+ * (or \f$ s^T y / y^T y \f$ for the second variant) captures local curvature
+ * along the last step, so the step size adapts to the conditioning of the
+ * problem without any extra function or gradient evaluations.  On the first
+ * iteration, and whenever the formula produces a non-positive or non-finite
+ * value, the current step size is kept.
+ *
+ * For more information, see the following:
+ *
+ * @code
+ * @article{Barzilai1988,
+ *   author  = {Barzilai, Jonathan and Borwein, Jonathan M.},
+ *   title   = {Two-Point Step Size Gradient Methods},
+ *   journal = {IMA Journal of Numerical Analysis},
+ *   volume  = {8},
+ *   number  = {1},
+ *   pages   = {141--148},
+ *   year    = {1988}
+ * }
+ * @endcode
+ */
+class BarzilaiBorweinStep
+{
+ public:
+  /**
+   * Construct the Barzilai-Borwein step size policy.
+   *
+   * @param maxStep Upper bound on the computed step size, guarding against
+   *     the huge steps the formula can produce when the denominator is tiny.
+   * @param secondOrder If true, use the second variant
+   *     \f$ s^T y / y^T y \f$ instead of \f$ s^T s / s^T y \f$.
+   */
+  BarzilaiBorweinStep(const double maxStep = 1e10,
+                      const bool secondOrder = false) :
+      maxStep(maxStep),
+      secondOrder(secondOrder)
+  { /* Nothing to do. */ }
+
+  //! Get the upper bound on the computed step size.
+  double MaxStep() const { return maxStep; }
+  //! Modify the upper bound on the computed step size.
+  double& MaxStep() { return maxStep; }
+
+  //! Get whether the second Barzilai-Borwein variant is used.
+  bool SecondOrder() const { return secondOrder; }
+  //! Modify whether the second Barzilai-Borwein variant is used.
+  bool& SecondOrder() { return secondOrder; }
+
+  /**
+   * The StepPolicyType policy classes must contain an internal 'Policy'
+   * template class with two template arguments: MatType and GradType.  This is
+   * initialized at the start of the optimization, and holds parameters specific
+   * to an individual optimization.
+   */
+  template<typename MatType, typename GradType>
+  class Policy
+  {
+   public:
+    /**
+     * This constructor is called by the GradientDescent Optimize() method
+     * before the start of the iteration update process.
+     */
+    Policy(BarzilaiBorweinStep& parent) :
+        parent(parent),
+        hasPrevious(false),
+        secondOrder(parent.SecondOrder())
+    { /* Nothing to do. */ }
+
+    /**
+     * Compute the Barzilai-Borwein step size from the previous iterate and
+     * gradient pair, and remember the current pair for the next iteration.
+     * This is called in each iteration after the gradient is computed and
+     * before the step is taken.
+     *
+     * @param iterate Parameters that minimize the function.
+     * @param stepSize Step size to be used for the given iteration.
+     * @param gradient The gradient matrix.
+     */
+    void Update(const MatType& iterate,
+                double& stepSize,
+                const GradType& gradient)
+    {
+      if (hasPrevious)
+      {
+        const double sDotY = arma::dot(iterate - previousIterate,
+            gradient - previousGradient);
+        const double num = secondOrder ? sDotY :
+            (double) arma::dot(iterate - previousIterate,
+                               iterate - previousIterate);
+        const double denom = secondOrder ?
+            (double) arma::dot(gradient - previousGradient,
+                               gradient - previousGradient) : sDotY;
+
+        const double newStep = num / denom;
+        if (std::isfinite(newStep) && (newStep > 0.0))
+          stepSize = std::min(newStep, parent.MaxStep());
+        // Otherwise, keep the current step size; the curvature estimate along
+        // the last step is unusable.
+      }
+
+      previousIterate = iterate;
+      previousGradient = gradient;
+      hasPrevious = true;
+    }
+
+   private:
+    //! Reference to the instantiated parent object.
+    BarzilaiBorweinStep& parent;
+
+    //! Whether a previous iterate and gradient pair has been stored.
+    bool hasPrevious;
+
+    //! Which Barzilai-Borwein variant to use.
+    bool secondOrder;
+
+    //! The iterate at the previous iteration.
+    MatType previousIterate;
+
+    //! The gradient at the previous iteration.
+    GradType previousGradient;
+  };
+
+ private:
+  //! Upper bound on the computed step size.
+  double maxStep;
+
+  //! Whether the second Barzilai-Borwein variant is used.
+  bool secondOrder;
+};
+
+} // namespace ens
+
+#endif // ENSMALLEN_GRADIENT_DESCENT_STEP_POLICIES_BARZILAI_BORWEIN_STEP_HPP
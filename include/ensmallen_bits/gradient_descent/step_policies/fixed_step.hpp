@@ -0,0 +1,66 @@
+/**
+ * @file fixed_step.hpp
+ * @author Sumedh Ghaisas
+ *
+ * Definition of the policy type for a fixed gradient descent step size.
+ *
+ * You should define your own step size policy that looks like FixedStep.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_GRADIENT_DESCENT_STEP_POLICIES_FIXED_STEP_HPP
+#define ENSMALLEN_GRADIENT_DESCENT_STEP_POLICIES_FIXED_STEP_HPP
+
+namespace ens {
+
+/**
+ * Definition of the FixedStep class, which leaves the step size unchanged for
+ * the entire optimization.  Use this as a template for your own.
+ */
+class FixedStep
+{
+ public:
+  /**
+   * This constructor is called before the first iteration.
+   */
+  FixedStep() { }
+
+  /**
+   * The StepPolicyType policy classes must contain an internal 'Policy'
+   * template class with two template arguments: MatType and GradType.  This is
+   * initialized at the start of the optimization, and holds parameters specific
+   * to an individual optimization.
+   */
+  template<typename MatType, typename GradType>
+  class Policy
+  {
+   public:
+    /**
+     * This constructor is called by the GradientDescent Optimize() method
+     * before the start of the iteration update process.
+     */
+    Policy(FixedStep& /* parent */) { }
+
+    /**
+     * This function is called in each iteration after the gradient is
+     * computed and before the step is taken.
+     *
+     * @param iterate Parameters that minimize the function.
+     * @param stepSize Step size to be used for the given iteration.
+     * @param gradient The gradient matrix.
+     */
+    void Update(const MatType& /* iterate */,
+                double& /* stepSize */,
+                const GradType& /* gradient */)
+    {
+      // Nothing to do here.
+    }
+  };
+};
+
+} // namespace ens
+
+#endif // ENSMALLEN_GRADIENT_DESCENT_STEP_POLICIES_FIXED_STEP_HPP
@@ -25,26 +25,63 @@ namespace ens {
 class GridSearch
 {
  public:
+  /**
+   * Construct the GridSearch optimizer.
+   *
+   * @param parallelEvaluation If true, the grid is flattened into a linear
+   *     index space and the points are evaluated across OpenMP threads, with
+   *     a per-thread best result merged at the end.  This requires
+   *     Evaluate() to be thread-safe.
+   */
+  GridSearch(const bool parallelEvaluation = false) :
+      parallelEvaluation(parallelEvaluation),
+      pruning(false)
+  { /* Nothing to do. */ }
+
   /**
    * Optimize (minimize) the given function by iterating through the all
    * possible combinations of values for the parameters specified in
    * datasetInfo.
    *
+   * The Evaluate() callback is raised once for every grid point with its
+   * configuration and objective value, so a sweep harness can stream all
+   * results instead of only receiving the single best configuration.
+   *
    * @tparam FunctionType Type of function to optimize.
    * @tparam MatType Type of matrix to optimize with.
+   * @tparam CallbackTypes Types of callback functions.
    * @param function Function to optimize.
    * @param bestParameters Variable for storing results.
    * @param categoricalDimensions Set of dimension types.  If a value is true,
    *     then that dimension is a categorical dimension.
    * @param numCategories Number of categories in each categorical dimension.
+   * @param callbacks Callback functions.
    * @return Objective value of the final point.
    */
-  template<typename FunctionType, typename MatType>
+  template<typename FunctionType, typename MatType, typename... CallbackTypes>
   typename MatType::elem_type Optimize(
       FunctionType& function,
       MatType& bestParameters,
       const std::vector<bool>& categoricalDimensions,
-      const arma::Row<size_t>& numCategories);
+      const arma::Row<size_t>& numCategories,
+      CallbackTypes&&... callbacks);
+
+  //! Get whether or not the grid points are evaluated in parallel.
+  bool ParallelEvaluation() const { return parallelEvaluation; }
+  //! Modify whether or not the grid points are evaluated in parallel
+  //! (requires Evaluate() to be thread-safe).
+  bool& ParallelEvaluation() { return parallelEvaluation; }
+
+  //! Get whether incumbent-threshold pruning is enabled.  When enabled, the
+  //! best objective found so far is passed to the function's
+  //! Evaluate(parameters, incumbent) overload if one exists, so multi-stage
+  //! objectives can abort a configuration as soon as its partial objective
+  //! can no longer beat the incumbent.  Objective values reported for aborted
+  //! configurations are lower bounds, not exact values.  In parallel mode
+  //! each thread prunes against its own incumbent.
+  bool Pruning() const { return pruning; }
+  //! Modify whether incumbent-threshold pruning is enabled.
+  bool& Pruning() { return pruning; }
 
  private:
   /**
@@ -54,7 +91,7 @@ class GridSearch
    * (parameters) are specified in the first i rows of the currentParameters
    * argument.
    */
-  template<typename FunctionType, typename MatType>
+  template<typename FunctionType, typename MatType, typename... CallbackTypes>
   void Optimize(
       FunctionType& function,
       typename MatType::elem_type& bestObjective,
@@ -62,7 +99,15 @@ class GridSearch
       MatType& currentParameters,
       const std::vector<bool>& categoricalDimensions,
       const arma::Row<size_t>& numCategories,
-      size_t i);
+      size_t i,
+      bool& terminate,
+      CallbackTypes&... callbacks);
+
+  //! Controls whether or not the grid points are evaluated in parallel.
+  bool parallelEvaluation;
+
+  //! Controls whether incumbent-threshold pruning is enabled.
+  bool pruning;
 };
 
 } // namespace ens
@@ -17,12 +17,13 @@
 
 namespace ens {
 
-template<typename FunctionType, typename MatType>
+template<typename FunctionType, typename MatType, typename... CallbackTypes>
 typename MatType::elem_type GridSearch::Optimize(
     FunctionType& function,
     MatType& bestParameters,
     const std::vector<bool>& categoricalDimensions,
-    const arma::Row<size_t>& numCategories)
+    const arma::Row<size_t>& numCategories,
+    CallbackTypes&&... callbacks)
 {
   for (size_t i = 0; i < categoricalDimensions.size(); ++i)
   {
@@ -48,13 +49,127 @@ typename MatType::elem_type GridSearch::Optimize(
   for (size_t i = 0; i < categoricalDimensions.size(); ++i)
     bestParameters(i, 0) = 0;
 
+  Callback::BeginOptimization(*this, function, bestParameters, callbacks...);
+
+  if (parallelEvaluation)
+  {
+    // Convenience typedefs.
+    typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+
+    // Make sure we have the methods that we need.  No restrictions on the
+    // matrix type are needed.
+    traits::CheckArbitraryFunctionTypeAPI<FunctionType, BaseMatType>();
+
+    // Flatten the grid into a linear index space, with dimension 0 the most
+    // significant digit so that the enumeration order matches the recursive
+    // implementation.
+    size_t totalPoints = 1;
+    for (size_t i = 0; i < categoricalDimensions.size(); ++i)
+      totalPoints *= numCategories(i);
+
+    // The flattened index of the best point found so far; used to break ties
+    // deterministically (the earliest point wins, as in the serial sweep).
+    size_t bestIndex = totalPoints;
+
+    // Objective values of all grid points, kept so the Evaluate() callbacks
+    // can be raised serially (and in deterministic order) after the parallel
+    // region.
+    arma::Col<ElemType> objectives(totalPoints);
+
+    ENS_PRAGMA_OMP_PARALLEL_THREADS(
+        (int) ParallelRuntime::Get().RegionThreads())
+    {
+      size_t threadId = 0;
+      size_t numThreads = 1;
+      #ifdef ENS_USE_OPENMP
+        threadId = omp_get_thread_num();
+        numThreads = omp_get_num_threads();
+      #endif
+
+      MatType threadParameters(categoricalDimensions.size(), 1);
+      ElemType threadBest = std::numeric_limits<ElemType>::max();
+      size_t threadBestIndex = totalPoints;
+
+      // Shard the index space round-robin: evaluation costs often vary
+      // smoothly across the grid, so interleaving the indices balances the
+      // shards better than contiguous blocks.
+      for (size_t p = threadId; p < totalPoints; p += numThreads)
+      {
+        size_t remainder = p;
+        for (size_t d = categoricalDimensions.size(); d > 0; --d)
+        {
+          threadParameters(d - 1) = remainder % numCategories(d - 1);
+          remainder /= numCategories(d - 1);
+        }
+
+        const ElemType incumbent = pruning ? threadBest :
+            std::numeric_limits<ElemType>::max();
+        const ElemType objective = EvaluateWithBound(function,
+            (BaseMatType&) threadParameters, incumbent);
+        objectives(p) = objective;
+        if (objective < threadBest ||
+            (objective == threadBest && p < threadBestIndex))
+        {
+          threadBest = objective;
+          threadBestIndex = p;
+        }
+      }
+
+      // Merge the per-thread results.
+      ENS_PRAGMA_OMP_CRITICAL
+      {
+        if (threadBest < bestObjective ||
+            (threadBest == bestObjective && threadBestIndex < bestIndex))
+        {
+          bestObjective = threadBest;
+          bestIndex = threadBestIndex;
+        }
+      }
+    }
+
+    if (bestIndex < totalPoints)
+    {
+      size_t remainder = bestIndex;
+      for (size_t d = categoricalDimensions.size(); d > 0; --d)
+      {
+        bestParameters(d - 1) = remainder % numCategories(d - 1);
+        remainder /= numCategories(d - 1);
+      }
+    }
+
+    // Stream the recorded results to the callbacks, in grid order.  The
+    // callbacks are not required to be thread-safe, so this happens outside
+    // the parallel region.
+    if (sizeof...(CallbackTypes) > 0)
+    {
+      bool terminate = false;
+      for (size_t p = 0; p < totalPoints && !terminate; ++p)
+      {
+        size_t remainder = p;
+        for (size_t d = categoricalDimensions.size(); d > 0; --d)
+        {
+          currentParameters(d - 1) = remainder % numCategories(d - 1);
+          remainder /= numCategories(d - 1);
+        }
+
+        terminate |= Callback::Evaluate(*this, function, currentParameters,
+            objectives(p), callbacks...);
+      }
+    }
+
+    Callback::EndOptimization(*this, function, bestParameters, callbacks...);
+    return bestObjective;
+  }
+
+  bool terminate = false;
   Optimize(function, bestObjective, bestParameters, currentParameters,
-      categoricalDimensions, numCategories, 0);
+      categoricalDimensions, numCategories, 0, terminate, callbacks...);
 
+  Callback::EndOptimization(*this, function, bestParameters, callbacks...);
   return bestObjective;
 }
 
-template<typename FunctionType, typename MatType>
+template<typename FunctionType, typename MatType, typename... CallbackTypes>
 void GridSearch::Optimize(
     FunctionType& function,
     typename MatType::elem_type& bestObjective,
@@ -62,7 +177,9 @@ void GridSearch::Optimize(
     MatType& currentParameters,
     const std::vector<bool>& categoricalDimensions,
     const arma::Row<size_t>& numCategories,
-    size_t i)
+    size_t i,
+    bool& terminate,
+    CallbackTypes&... callbacks)
 {
   // Convenience typedefs.
   typedef typename MatType::elem_type ElemType;
@@ -74,16 +191,22 @@ void GridSearch::Optimize(
 
   if (i < categoricalDimensions.size())
   {
-    for (size_t j = 0; j < numCategories(i); ++j)
+    for (size_t j = 0; j < numCategories(i) && !terminate; ++j)
     {
       currentParameters(i) = j;
       Optimize(function, bestObjective, bestParameters, currentParameters,
-          categoricalDimensions, numCategories, i + 1);
+          categoricalDimensions, numCategories, i + 1, terminate,
+          callbacks...);
     }
   }
   else
   {
-    ElemType objective = function.Evaluate((BaseMatType&) currentParameters);
+    const ElemType incumbent = pruning ? bestObjective :
+        std::numeric_limits<ElemType>::max();
+    ElemType objective = EvaluateWithBound(function,
+        (BaseMatType&) currentParameters, incumbent);
+    terminate |= Callback::Evaluate(*this, function, currentParameters,
+        objective, callbacks...);
     if (objective < bestObjective)
     {
       bestObjective = objective;
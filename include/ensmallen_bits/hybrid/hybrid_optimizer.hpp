@@ -0,0 +1,128 @@
+/**
+ * @file hybrid_optimizer.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the global-to-local hybrid meta-optimizer, which chains a
+ * global exploration phase and a local refinement phase with state transfer
+ * across the handoff.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_HYBRID_HYBRID_OPTIMIZER_HPP
+#define ENSMALLEN_HYBRID_HYBRID_OPTIMIZER_HPP
+
+#include <ensmallen_bits/cmaes/cmaes.hpp>
+#include <ensmallen_bits/lbfgs/lbfgs.hpp>
+
+namespace ens {
+
+/**
+ * HybridOptimizer chains a global optimizer and a local optimizer in one
+ * Optimize() call: the global phase locates a promising basin, and the local
+ * phase refines the result.  The iterate carries the best global point into
+ * the local phase, and where both ends support it, distribution state is
+ * carried across the handoff as well: with the default CMA-ES / L-BFGS
+ * pairing, the scale of the final CMA-ES sampling covariance (an isotropic
+ * estimate of the local inverse Hessian) seeds L-BFGS's initial Hessian
+ * scaling, so the local phase starts with well-sized steps instead of the
+ * cold-start gradient-norm heuristic.
+ *
+ * The state transfer activates whenever the global optimizer exposes
+ * DistributionScale() and the local optimizer exposes
+ * InitialScalingFactor(); for any other pairing (say PSO feeding
+ * GradientDescent), the chain still works through the iterate handoff
+ * alone.  The function must satisfy the requirements of both wrapped
+ * optimizers, and callbacks passed to Optimize() are raised from both
+ * phases in turn.
+ *
+ * @tparam GlobalOptimizerType The wrapped global exploration optimizer.
+ * @tparam LocalOptimizerType The wrapped local refinement optimizer.
+ */
+template<typename GlobalOptimizerType = CMAES<>,
+         typename LocalOptimizerType = L_BFGS>
+class HybridOptimizer
+{
+ public:
+  /**
+   * Construct the hybrid meta-optimizer from configured phase optimizers.
+   *
+   * @param globalOptimizer Configured global exploration optimizer.
+   * @param localOptimizer Configured local refinement optimizer.
+   */
+  HybridOptimizer(
+      const GlobalOptimizerType& globalOptimizer = GlobalOptimizerType(),
+      const LocalOptimizerType& localOptimizer = LocalOptimizerType());
+
+  /**
+   * Optimize the given function by running the global phase and then the
+   * local phase, transferring state across the handoff.  The given starting
+   * point will be modified to store the finishing point of the local phase,
+   * and the final objective value is returned.
+   *
+   * @tparam FunctionType Type of the function to be optimized.
+   * @tparam MatType Type of matrix to optimize.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to optimize.
+   * @param iterate Starting point (will be modified).
+   * @param callbacks Callback functions.
+   * @return Objective value of the final point.
+   */
+  template<typename FunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(FunctionType& function,
+                                       MatType& iterate,
+                                       CallbackTypes&&... callbacks);
+
+  //! Get the global exploration optimizer.
+  const GlobalOptimizerType& GlobalOptimizer() const
+  { return globalOptimizer; }
+  //! Modify the global exploration optimizer.
+  GlobalOptimizerType& GlobalOptimizer() { return globalOptimizer; }
+
+  //! Get the local refinement optimizer.
+  const LocalOptimizerType& LocalOptimizer() const { return localOptimizer; }
+  //! Modify the local refinement optimizer.
+  LocalOptimizerType& LocalOptimizer() { return localOptimizer; }
+
+ private:
+  /**
+   * Carry distribution state across the handoff: preferred overload,
+   * selected when the global optimizer reports the scale of its final
+   * search distribution and the local optimizer accepts an initial Hessian
+   * scaling seed.
+   */
+  template<typename GlobalType, typename LocalType>
+  static auto TransferState(const GlobalType& global, LocalType& local, int)
+      -> decltype(void(local.InitialScalingFactor() =
+          global.DistributionScale()))
+  {
+    if (global.DistributionScale() > 0)
+      local.InitialScalingFactor() = global.DistributionScale();
+  }
+
+  /**
+   * Fallback overload for pairings without a matching state channel; the
+   * handoff then consists of the iterate alone.
+   */
+  template<typename GlobalType, typename LocalType>
+  static void TransferState(const GlobalType& /* global */,
+                            LocalType& /* local */,
+                            long)
+  { /* Nothing to do here. */ }
+
+  //! The wrapped global exploration optimizer.
+  GlobalOptimizerType globalOptimizer;
+
+  //! The wrapped local refinement optimizer.
+  LocalOptimizerType localOptimizer;
+};
+
+} // namespace ens
+
+#include "hybrid_optimizer_impl.hpp"
+
+#endif
@@ -0,0 +1,57 @@
+/**
+ * @file hybrid_optimizer_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the global-to-local hybrid meta-optimizer.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_HYBRID_HYBRID_OPTIMIZER_IMPL_HPP
+#define ENSMALLEN_HYBRID_HYBRID_OPTIMIZER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "hybrid_optimizer.hpp"
+
+namespace ens {
+
+template<typename GlobalOptimizerType, typename LocalOptimizerType>
+HybridOptimizer<GlobalOptimizerType, LocalOptimizerType>::HybridOptimizer(
+    const GlobalOptimizerType& globalOptimizer,
+    const LocalOptimizerType& localOptimizer) :
+    globalOptimizer(globalOptimizer),
+    localOptimizer(localOptimizer)
+{ /* Nothing to do. */ }
+
+//! Optimize the function (minimize).
+template<typename GlobalOptimizerType, typename LocalOptimizerType>
+template<typename FunctionType,
+         typename MatType,
+         typename... CallbackTypes>
+typename MatType::elem_type
+HybridOptimizer<GlobalOptimizerType, LocalOptimizerType>::Optimize(
+    FunctionType& function,
+    MatType& iterate,
+    CallbackTypes&&... callbacks)
+{
+  // Each wrapped optimizer performs its own function API checks; the
+  // function must satisfy the requirements of both.
+
+  // Global exploration phase; the iterate carries the best point found
+  // into the local phase.
+  globalOptimizer.Optimize(function, iterate, callbacks...);
+
+  // Carry distribution state across the handoff where both ends support
+  // it; the overload with the int tag is preferred when the state channel
+  // exists and falls back to the iterate-only handoff otherwise.
+  TransferState(globalOptimizer, localOptimizer, 0);
+
+  // Local refinement phase.
+  return localOptimizer.Optimize(function, iterate, callbacks...);
+}
+
+} // namespace ens
+
+#endif
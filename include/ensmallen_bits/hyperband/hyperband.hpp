@@ -0,0 +1,120 @@
+/**
+ * @file hyperband.hpp
+ * @author Kirill Mishchenko
+ *
+ * Hyperband optimization (successive halving over random configurations).
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_HYPERBAND_HYPERBAND_HPP
+#define ENSMALLEN_HYPERBAND_HYPERBAND_HPP
+
+namespace ens {
+
+/**
+ * An optimizer for categorical functions whose objective can be evaluated
+ * with a partial budget (for example, a model tuned by training for fewer
+ * epochs).  Where GridSearch spends the full evaluation budget on every grid
+ * point, Hyperband samples random configurations, evaluates them with a small
+ * budget, and repeatedly promotes the best fraction to larger budgets
+ * (successive halving).  Several brackets with different tradeoffs between
+ * the number of configurations and the starting budget are run, so no
+ * assumption is needed about how early a bad configuration can be recognized.
+ *
+ * Hyperband is built around the fidelity-parameterized evaluation contract
+ * (see fidelity_evaluate.hpp): the function type should implement
+ *
+ * @code
+ * double Evaluate(const arma::mat& parameters, const size_t budget);
+ * @endcode
+ *
+ * which returns the objective obtained after spending the given budget (in
+ * problem-defined units, such as epochs) on the given configuration.  Larger
+ * budgets are expected to produce more reliable objective values.  If the
+ * function also exposes its cost model through size_t MaxFidelity(), the
+ * full budget is clamped to it.  A function with only a plain Evaluate()
+ * still works, but is evaluated exactly on every rung, so none of the
+ * partial-budget savings are realized.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @article{Li2017,
+ *   author  = {Li, Lisha and Jamieson, Kevin and DeSalvo, Giulia and
+ *              Rostamizadeh, Afshin and Talwalkar, Ameet},
+ *   title   = {Hyperband: A Novel Bandit-Based Approach to Hyperparameter
+ *              Optimization},
+ *   journal = {Journal of Machine Learning Research},
+ *   volume  = {18},
+ *   number  = {185},
+ *   pages   = {1--52},
+ *   year    = {2018}
+ * }
+ * @endcode
+ */
+class Hyperband
+{
+ public:
+  /**
+   * Construct the Hyperband optimizer.
+   *
+   * @param maxBudget The maximum budget (in problem-defined units) that can
+   *     be spent on a single configuration.
+   * @param eta The elimination rate: each successive-halving rung keeps the
+   *     best 1 / eta fraction of its configurations and multiplies their
+   *     budget by eta.
+   */
+  Hyperband(const size_t maxBudget = 81, const double eta = 3.0) :
+      maxBudget(maxBudget),
+      eta(eta)
+  { /* Nothing to do. */ }
+
+  /**
+   * Optimize (minimize) the given budget-parameterized function over random
+   * configurations drawn from the categorical grid specified in
+   * numCategories.
+   *
+   * @tparam FunctionType Type of function to optimize; must implement
+   *     Evaluate(parameters, budget).
+   * @tparam MatType Type of matrix to optimize with.
+   * @param function Function to optimize.
+   * @param bestParameters Variable for storing results.
+   * @param categoricalDimensions Set of dimension types.  If a value is true,
+   *     then that dimension is a categorical dimension.
+   * @param numCategories Number of categories in each categorical dimension.
+   * @return Objective value of the best configuration at the full budget.
+   */
+  template<typename FunctionType, typename MatType>
+  typename MatType::elem_type Optimize(
+      FunctionType& function,
+      MatType& bestParameters,
+      const std::vector<bool>& categoricalDimensions,
+      const arma::Row<size_t>& numCategories);
+
+  //! Get the maximum budget for a single configuration.
+  size_t MaxBudget() const { return maxBudget; }
+  //! Modify the maximum budget for a single configuration.
+  size_t& MaxBudget() { return maxBudget; }
+
+  //! Get the elimination rate.
+  double Eta() const { return eta; }
+  //! Modify the elimination rate.
+  double& Eta() { return eta; }
+
+ private:
+  //! The maximum budget that can be spent on a single configuration.
+  size_t maxBudget;
+
+  //! The elimination rate of the successive-halving rungs.
+  double eta;
+};
+
+} // namespace ens
+
+// Include implementation
+#include "hyperband_impl.hpp"
+
+#endif
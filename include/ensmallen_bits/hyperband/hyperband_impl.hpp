@@ -0,0 +1,149 @@
+/**
+ * @file hyperband_impl.hpp
+ * @author Kirill Mishchenko
+ *
+ * Implementation of the Hyperband optimization.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_HYPERBAND_HYPERBAND_IMPL_HPP
+#define ENSMALLEN_HYPERBAND_HYPERBAND_IMPL_HPP
+
+#include <limits>
+#include <ensmallen_bits/function.hpp>
+
+namespace ens {
+
+template<typename FunctionType, typename MatType>
+typename MatType::elem_type Hyperband::Optimize(
+    FunctionType& function,
+    MatType& bestParameters,
+    const std::vector<bool>& categoricalDimensions,
+    const arma::Row<size_t>& numCategories)
+{
+  for (size_t i = 0; i < categoricalDimensions.size(); ++i)
+  {
+    if (!categoricalDimensions[i])
+    {
+      std::ostringstream oss;
+      oss << "Hyperband::Optimize(): the dimension " << i
+          << " is not categorical" << std::endl;
+      throw std::invalid_argument(oss.str());
+    }
+  }
+
+  if (maxBudget == 0)
+  {
+    throw std::invalid_argument("Hyperband::Optimize(): the maximum budget "
+        "must be at least 1");
+  }
+
+  if (eta <= 1.0)
+  {
+    throw std::invalid_argument("Hyperband::Optimize(): the elimination rate "
+        "eta must be greater than 1");
+  }
+
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+
+  const size_t numDimensions = categoricalDimensions.size();
+
+  // If the function exposes its cost model through MaxFidelity(), the full
+  // budget is clamped to it: spending more than the exact-evaluation
+  // fidelity on a configuration would be wasted.
+  const size_t maxFidelity = GetMaxFidelity(function);
+  const size_t fullBudget = (maxFidelity > 0) ?
+      std::min(maxBudget, maxFidelity) : maxBudget;
+
+  // The number of brackets; bracket sMax starts with the smallest budget and
+  // the most configurations, bracket 0 runs every configuration at the full
+  // budget directly.
+  const size_t sMax = (size_t) std::floor(std::log((double) fullBudget) /
+      std::log(eta));
+  const double totalBudget = (sMax + 1) * (double) fullBudget;
+
+  ElemType bestObjective = std::numeric_limits<ElemType>::max();
+  bestParameters.set_size(numDimensions, 1);
+
+  /* Initialize best parameters for the case (very unlikely though) when no
+   * configuration gives an objective value better than
+   * std::numeric_limits<double>::max() */
+  for (size_t i = 0; i < numDimensions; ++i)
+    bestParameters(i, 0) = 0;
+
+  for (size_t bracket = sMax + 1; bracket > 0; --bracket)
+  {
+    const size_t s = bracket - 1;
+
+    // The number of configurations this bracket starts with, and the budget
+    // each of them receives on the first rung.
+    const size_t n = (size_t) std::ceil((totalBudget / fullBudget) *
+        std::pow(eta, (double) s) / (s + 1));
+    const double r = fullBudget * std::pow(eta, -(double) s);
+
+    // Sample the starting configurations uniformly from the grid.
+    std::vector<MatType> configurations(n, MatType(numDimensions, 1));
+    for (size_t c = 0; c < n; ++c)
+    {
+      for (size_t d = 0; d < numDimensions; ++d)
+      {
+        configurations[c](d) = (ElemType) arma::as_scalar(
+            arma::randi<arma::uvec>(1, arma::distr_param(0,
+            (int) numCategories(d) - 1)));
+      }
+    }
+
+    // Successive halving: each rung evaluates the surviving configurations
+    // with an eta times larger budget and keeps the best 1 / eta fraction.
+    for (size_t i = 0; i <= s; ++i)
+    {
+      const size_t budget = std::min(fullBudget, (size_t) std::max(1.0,
+          std::round(r * std::pow(eta, (double) i))));
+
+      arma::Col<ElemType> objectives(configurations.size());
+      for (size_t c = 0; c < configurations.size(); ++c)
+      {
+        objectives(c) = EvaluateWithFidelity(function, configurations[c],
+            budget);
+      }
+
+      // The last rung of every bracket runs at the full budget; the overall
+      // winner is chosen among those full-budget evaluations only, since
+      // partial-budget objectives are not comparable across rungs.
+      if (budget == fullBudget)
+      {
+        arma::uword bestIndex = 0;
+        const ElemType rungBest = objectives.min(bestIndex);
+        if (rungBest < bestObjective)
+        {
+          bestObjective = rungBest;
+          bestParameters = configurations[bestIndex];
+        }
+      }
+
+      if (i == s)
+        break;
+
+      // Promote the best 1 / eta fraction to the next rung.
+      const size_t survivors = std::max((size_t) 1,
+          (size_t) std::floor(configurations.size() / eta));
+      const arma::uvec order = arma::sort_index(objectives);
+
+      std::vector<MatType> promoted;
+      promoted.reserve(survivors);
+      for (size_t c = 0; c < survivors; ++c)
+        promoted.push_back(configurations[order(c)]);
+      configurations = std::move(promoted);
+    }
+  }
+
+  return bestObjective;
+}
+
+} // namespace ens
+
+#endif
@@ -63,11 +63,18 @@ class IQN
    * @param maxIterations Maximum number of iterations allowed (0 means no
    *     limit).
    * @param tolerance Maximum absolute tolerance to terminate algorithm.
+   * @param memory Number of curvature pairs kept by the limited-memory
+   *     variant.  The default of 0 keeps the exact dense per-function
+   *     Hessian estimates, which take O(d^2) memory per batch; a nonzero
+   *     memory stores each curvature correction as an (s, y) pair instead
+   *     and applies the two-loop recursion, bringing the footprint down to
+   *     O(d (n + memory)) at the cost of the superlinear local rate.
    */
   IQN(const double stepSize = 0.01,
       const size_t batchSize = 10,
       const size_t maxIterations = 100000,
-      const double tolerance = 1e-5);
+      const double tolerance = 1e-5,
+      const size_t memory = 0);
 
   /**
    * Optimize the given function using IQN. The given starting point will be
@@ -126,6 +133,18 @@ class IQN
   //! Modify the tolerance for termination.
   double& Tolerance() { return tolerance; }
 
+  //! Get the number of curvature pairs of the limited-memory variant (0
+  //! indicates the exact dense Hessian estimates).
+  size_t Memory() const { return memory; }
+  //! Modify the number of curvature pairs of the limited-memory variant.
+  size_t& Memory() { return memory; }
+
+  //! Get whether the initial full-gradient pass is computed in parallel with
+  //! OpenMP (requires Gradient() to be thread-safe).
+  bool ParallelFullGradient() const { return parallelFullGradient; }
+  //! Modify whether the initial full-gradient pass is computed in parallel.
+  bool& ParallelFullGradient() { return parallelFullGradient; }
+
  private:
   //! The step size for each example.
   double stepSize;
@@ -138,6 +157,12 @@ class IQN
 
   //! The tolerance for termination.
   double tolerance;
+
+  //! The number of curvature pairs of the limited-memory variant.
+  size_t memory;
+
+  //! Whether the initial full-gradient pass is computed in parallel.
+  bool parallelFullGradient;
 };
 
 } // namespace ens
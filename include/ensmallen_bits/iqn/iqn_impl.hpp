@@ -24,11 +24,14 @@ namespace ens {
 inline IQN::IQN(const double stepSize,
                 const size_t batchSize,
                 const size_t maxIterations,
-                const double tolerance) :
+                const double tolerance,
+                const size_t memory) :
     stepSize(stepSize),
     batchSize(batchSize),
     maxIterations(maxIterations),
-    tolerance(tolerance)
+    tolerance(tolerance),
+    memory(memory),
+    parallelFullGradient(false)
 { /* Nothing to do. */ }
 
 //! Optimize the function (minimize).
@@ -79,35 +82,105 @@ IQN::Optimize(SeparableFunctionType& functionIn,
       iterate.n_cols));
   std::vector<BaseMatType> t(numBatches, BaseMatType(iterate.n_rows,
       iterate.n_cols));
-  std::vector<BaseMatType> Q(numBatches, BaseMatType(iterate.n_elem,
-      iterate.n_elem));
+
+  // The dense per-function Hessian estimates and the aggregate estimate are
+  // only kept in the exact mode; the limited-memory mode represents the
+  // curvature by (s, y) pairs instead.
+  std::vector<BaseMatType> Q((memory == 0) ? numBatches : 0,
+      BaseMatType(iterate.n_elem, iterate.n_elem));
   BaseMatType initialIterate = arma::randn<arma::Mat<ElemType>>(iterate.n_rows,
       iterate.n_cols);
-  BaseGradType B(iterate.n_elem, iterate.n_elem);
-  B.eye();
+  BaseGradType B;
+  if (memory == 0)
+  {
+    B.set_size(iterate.n_elem, iterate.n_elem);
+    B.eye();
+  }
+
+  // Ring buffer of curvature pairs for the limited-memory mode, following
+  // the L_BFGS storage layout, plus preallocated two-loop work buffers.
+  arma::Cube<ElemType> sPairs, yPairs;
+  arma::Col<ElemType> sDotY, twoLoopAlpha;
+  BaseGradType direction;
+  size_t numPairs = 0;
+  if (memory > 0)
+  {
+    sPairs.set_size(iterate.n_rows, iterate.n_cols, memory);
+    yPairs.set_size(iterate.n_rows, iterate.n_cols, memory);
+    sDotY.set_size(memory);
+    twoLoopAlpha.set_size(memory);
+    direction.set_size(iterate.n_rows, iterate.n_cols);
+  }
 
   BaseGradType g(iterate.n_rows, iterate.n_cols);
   g.zeros();
-  for (size_t i = 0, f = 0; i < numFunctions; f++)
+  if (parallelFullGradient)
   {
-    // Find the effective batch size (the last batch may be smaller).
-    const size_t effectiveBatchSize = std::min(batchSize, numFunctions - i);
+    // Parallel initial pass: the per-batch gradients are independent, so each
+    // thread processes its share of the batches and accumulates a partial sum
+    // of g, reduced at the end.  This requires Gradient() to be thread-safe;
+    // the Gradient callback is invoked once with the reduced full gradient.
+    ENS_PRAGMA_OMP_PARALLEL
+    {
+      size_t threadId = 0;
+      size_t numThreads = 1;
+      #ifdef ENS_USE_OPENMP
+        threadId = omp_get_thread_num();
+        numThreads = omp_get_num_threads();
+      #endif
 
-    // It would be nice to avoid this copy but it is difficult to be generic to
-    // any MatType and still do that.
-    t[f] = initialIterate;
-    function.Gradient(initialIterate, i, y[f], effectiveBatchSize);
+      BaseGradType partialGradient(iterate.n_rows, iterate.n_cols);
+      partialGradient.zeros();
 
-    terminate |= Callback::Gradient(*this, function, initialIterate,
-        y[f], callbacks...);
+      for (size_t f = threadId; f < numBatches; f += numThreads)
+      {
+        const size_t begin = f * batchSize;
+        const size_t effectiveBatchSize = std::min(batchSize,
+            numFunctions - begin);
 
-    Q[f].eye();
-    g += y[f];
-    y[f] /= (double) effectiveBatchSize;
+        t[f] = initialIterate;
+        function.Gradient(initialIterate, begin, y[f], effectiveBatchSize);
 
-    i += effectiveBatchSize;
+        if (memory == 0)
+          Q[f].eye();
+        partialGradient += y[f];
+        y[f] /= (double) effectiveBatchSize;
+      }
+
+      ENS_PRAGMA_OMP_CRITICAL
+      {
+        g += partialGradient;
+      }
+    }
+
+    g /= numFunctions;
+    terminate |= Callback::Gradient(*this, function, initialIterate, g,
+        callbacks...);
+  }
+  else
+  {
+    for (size_t i = 0, f = 0; i < numFunctions; f++)
+    {
+      // Find the effective batch size (the last batch may be smaller).
+      const size_t effectiveBatchSize = std::min(batchSize, numFunctions - i);
+
+      // It would be nice to avoid this copy but it is difficult to be generic
+      // to any MatType and still do that.
+      t[f] = initialIterate;
+      function.Gradient(initialIterate, i, y[f], effectiveBatchSize);
+
+      terminate |= Callback::Gradient(*this, function, initialIterate,
+          y[f], callbacks...);
+
+      if (memory == 0)
+        Q[f].eye();
+      g += y[f];
+      y[f] /= (double) effectiveBatchSize;
+
+      i += effectiveBatchSize;
+    }
+    g /= numFunctions;
   }
-  g /= numFunctions;
 
   BaseGradType gradient(iterate.n_rows, iterate.n_cols);
   BaseMatType u = t[0];
@@ -133,31 +206,91 @@ IQN::Optimize(SeparableFunctionType& functionIn,
         terminate |= Callback::Gradient(*this, function, iterate, gradient,
             callbacks...);
 
-        const BaseMatType s = arma::vectorise(iterate - t[it]);
-        const BaseGradType yy = arma::vectorise(gradient - y[it]);
-
-        const BaseGradType stochasticHessian = Q[it] + yy * yy.t() /
-            arma::as_scalar(yy.t() * s) - Q[it] * s * s.t() *
-            Q[it] / arma::as_scalar(s.t() * Q[it] * s);
-
-        // Update aggregate Hessian approximation.
-        B += (1.0 / numBatches) * (stochasticHessian - Q[it]);
-
-        // Update aggregate Hessian-variable product.
-        u += arma::reshape((1.0 / numBatches) * (stochasticHessian *
-            arma::vectorise(iterate) - Q[it] * arma::vectorise(t[it])),
-            u.n_rows, u.n_cols);;
-
-        // Update aggregate gradient.
-        g += (1.0 / numBatches) * (gradient - y[it]);
-
-        // Update the function information tables.
-        Q[it] = std::move(stochasticHessian);
-        y[it] = std::move(gradient);
-        t[it] = iterate;
-
-        iterate = arma::reshape(stepSize * B.i() * (u.t() - arma::vectorise(g)),
-            iterate.n_rows, iterate.n_cols) + (1 - stepSize) * iterate;
+        if (memory > 0)
+        {
+          // Limited-memory mode: instead of folding the correction into a
+          // dense per-function BFGS estimate, keep it as an (s, y) curvature
+          // pair in the ring buffer.  Pairs that fail the curvature
+          // condition would break the positive definiteness of the estimate
+          // and are skipped.
+          const BaseMatType sNew = iterate - t[it];
+          const BaseGradType yNew = gradient - y[it];
+          const ElemType sy = arma::dot(sNew, yNew);
+          if (sy > ElemType(0))
+          {
+            const size_t pos = numPairs % memory;
+            sPairs.slice(pos) = sNew;
+            yPairs.slice(pos) = yNew;
+            sDotY(pos) = sy;
+            ++numPairs;
+          }
+
+          // Update aggregate gradient.
+          g += (1.0 / numBatches) * (gradient - y[it]);
+
+          // Update the function information tables.
+          y[it] = std::move(gradient);
+          t[it] = iterate;
+
+          // Apply the limited-memory inverse curvature estimate to the
+          // aggregate gradient with the two-loop recursion, newest pair
+          // first.  With an empty buffer this reduces to a gradient step.
+          direction = g;
+          const size_t pairs = std::min(numPairs, memory);
+          for (size_t k = 0; k < pairs; ++k)
+          {
+            const size_t pos = (numPairs - 1 - k) % memory;
+            twoLoopAlpha(k) = arma::dot(sPairs.slice(pos), direction) /
+                sDotY(pos);
+            direction -= twoLoopAlpha(k) * yPairs.slice(pos);
+          }
+
+          if (pairs > 0)
+          {
+            const size_t newest = (numPairs - 1) % memory;
+            direction *= sDotY(newest) /
+                arma::dot(yPairs.slice(newest), yPairs.slice(newest));
+          }
+
+          for (size_t k = pairs; k > 0; --k)
+          {
+            const size_t pos = (numPairs - k) % memory;
+            const ElemType beta = arma::dot(yPairs.slice(pos), direction) /
+                sDotY(pos);
+            direction += (twoLoopAlpha(k - 1) - beta) * sPairs.slice(pos);
+          }
+
+          iterate -= stepSize * direction;
+        }
+        else
+        {
+          const BaseMatType s = arma::vectorise(iterate - t[it]);
+          const BaseGradType yy = arma::vectorise(gradient - y[it]);
+
+          const BaseGradType stochasticHessian = Q[it] + yy * yy.t() /
+              arma::as_scalar(yy.t() * s) - Q[it] * s * s.t() *
+              Q[it] / arma::as_scalar(s.t() * Q[it] * s);
+
+          // Update aggregate Hessian approximation.
+          B += (1.0 / numBatches) * (stochasticHessian - Q[it]);
+
+          // Update aggregate Hessian-variable product.
+          u += arma::reshape((1.0 / numBatches) * (stochasticHessian *
+              arma::vectorise(iterate) - Q[it] * arma::vectorise(t[it])),
+              u.n_rows, u.n_cols);;
+
+          // Update aggregate gradient.
+          g += (1.0 / numBatches) * (gradient - y[it]);
+
+          // Update the function information tables.
+          Q[it] = std::move(stochasticHessian);
+          y[it] = std::move(gradient);
+          t[it] = iterate;
+
+          iterate = arma::reshape(stepSize * B.i() *
+              (u.t() - arma::vectorise(g)), iterate.n_rows, iterate.n_cols) +
+              (1 - stepSize) * iterate;
+        }
 
         terminate |= Callback::StepTaken(*this, function, iterate,
             callbacks...);
@@ -12,6 +12,8 @@
 #ifndef ENSMALLEN_KATYUSHA_KATYUSHA_HPP
 #define ENSMALLEN_KATYUSHA_KATYUSHA_HPP
 
+#include <ensmallen_bits/sgd/update_policies/proximal_update.hpp>
+
 namespace ens {
 
 /**
@@ -38,9 +40,19 @@ namespace ens {
  * see the documentation on function types included with this distribution or on
  * the ensmallen website.
  *
+ * For composite objectives (a smooth separable loss plus a nonsmooth
+ * regularizer such as the L1 norm), a proximal operator can be given as the
+ * second template parameter; the z and y sequence updates of the inner loop
+ * then go through the operator, so the nonsmooth term is handled exactly
+ * instead of through subgradients.  The operators are shared with the SGD
+ * family (L1Proximal, GroupL1Proximal); the default IdentityProximal keeps
+ * the plain smooth updates.
+ *
  * @tparam proximal Whether the proximal update should be used or not.
+ * @tparam ProxOperatorType Proximal operator of the nonsmooth regularizer;
+ *     it must provide Apply(iterate, stepSize).
  */
-template<bool Proximal = false>
+template<bool Proximal = false, typename ProxOperatorType = IdentityProximal>
 class KatyushaType
 {
  public:
@@ -65,6 +77,7 @@ class KatyushaType
    *    function is visited in linear order.
    * @param exactObjective Calculate the exact objective (Default: estimate the
    *        final objective obtained on the last pass over the data).
+   * @param proxOperator The proximal operator of the nonsmooth regularizer.
    */
   KatyushaType(const double convexity = 1.0,
                const double lipschitz = 10.0,
@@ -73,7 +86,8 @@ class KatyushaType
                const size_t innerIterations = 0,
                const double tolerance = 1e-5,
                const bool shuffle = true,
-               const bool exactObjective = false);
+               const bool exactObjective = false,
+               const ProxOperatorType& proxOperator = ProxOperatorType());
 
   /**
    * Optimize the given function using Katyusha. The given starting point will
@@ -152,6 +166,11 @@ class KatyushaType
   //! Modify whether or not the actual objective is calculated.
   bool& ExactObjective() { return exactObjective; }
 
+  //! Get the proximal operator of the nonsmooth regularizer.
+  const ProxOperatorType& ProxOperator() const { return proxOperator; }
+  //! Modify the proximal operator of the nonsmooth regularizer.
+  ProxOperatorType& ProxOperator() { return proxOperator; }
+
  private:
   //! The convexity regularization term.
   double convexity;
@@ -177,6 +196,9 @@ class KatyushaType
 
   //! Controls whether or not the actual Objective value is calculated.
   bool exactObjective;
+
+  //! The proximal operator of the nonsmooth regularizer.
+  ProxOperatorType proxOperator;
 };
 
 // Convenience typedefs.
@@ -191,6 +213,14 @@ using Katyusha = KatyushaType<false>;
  */
 using KatyushaProximal = KatyushaType<true>;
 
+/**
+ * Katyusha for composite objectives: the inner-loop sequence updates go
+ * through the given proximal operator, handling a nonsmooth regularizer
+ * (L1 by default) exactly.
+ */
+template<typename ProxOperatorType = L1Proximal>
+using ProximalKatyusha = KatyushaType<false, ProxOperatorType>;
+
 } // namespace ens
 
 // Include implementation.
@@ -19,8 +19,148 @@
 
 namespace ens {
 
-template<bool Proximal>
-KatyushaType<Proximal>::KatyushaType(
+/**
+ * Fused inner-loop kernel for dense types: one pass over the buffers updates
+ * the z, y, and w sequences together, instead of the separate full-vector
+ * expressions (which also allocated a temporary for the new z).  On large
+ * problems this streams the parameter memory once per step instead of once
+ * per sequence.
+ */
+template<bool Proximal, typename MatType, typename GradType>
+typename std::enable_if<!arma::is_arma_sparse_type<MatType>::value, void>::type
+KatyushaInnerUpdate(MatType& y,
+                    MatType& z,
+                    MatType& w,
+                    const MatType& iterate,
+                    const GradType& fullGradient,
+                    const GradType& gradient,
+                    const GradType& gradient0,
+                    const double alpha,
+                    const double tau1,
+                    const double lipschitz,
+                    const double batchSize,
+                    const double cw)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  const ElemType a = (ElemType) alpha;
+  const ElemType t1 = (ElemType) tau1;
+  const ElemType invBatch = (ElemType) (1.0 / batchSize);
+  const ElemType prox = (ElemType) (1.0 / (3.0 * lipschitz));
+  const ElemType cwLocal = (ElemType) cw;
+
+  const ElemType* itMem = iterate.memptr();
+  const ElemType* fgMem = fullGradient.memptr();
+  const ElemType* gMem = gradient.memptr();
+  const ElemType* g0Mem = gradient0.memptr();
+  ElemType* yMem = y.memptr();
+  ElemType* zMem = z.memptr();
+  ElemType* wMem = w.memptr();
+
+  const size_t n = iterate.n_elem;
+  for (size_t j = 0; j < n; ++j)
+  {
+    // Variance reduced gradient.
+    const ElemType vr = fgMem[j] + (gMem[j] - g0Mem[j]) * invBatch;
+    const ElemType zOld = zMem[j];
+    const ElemType zNew = zOld - a * vr;
+    zMem[j] = zNew;
+    yMem[j] = Proximal ? (itMem[j] + prox * wMem[j]) :
+        (itMem[j] + t1 * (zNew - zOld));
+    wMem[j] += cwLocal * itMem[j];
+  }
+}
+
+//! Sparse types have no contiguous memory to walk, so keep the
+//! expression-based sequence updates.
+template<bool Proximal, typename MatType, typename GradType>
+typename std::enable_if<arma::is_arma_sparse_type<MatType>::value, void>::type
+KatyushaInnerUpdate(MatType& y,
+                    MatType& z,
+                    MatType& w,
+                    const MatType& iterate,
+                    const GradType& fullGradient,
+                    const GradType& gradient,
+                    const GradType& gradient0,
+                    const double alpha,
+                    const double tau1,
+                    const double lipschitz,
+                    const double batchSize,
+                    const double cw)
+{
+  MatType zNew = z - alpha * (fullGradient + (gradient - gradient0) /
+      batchSize);
+
+  if (Proximal)
+    y = iterate + 1.0 / (3.0 * lipschitz) * w;
+  else
+    y = iterate + tau1 * (zNew - z);
+
+  z = std::move(zNew);
+  w += cw * iterate;
+}
+
+/**
+ * Inner-loop step for smooth objectives (the default IdentityProximal):
+ * dispatch straight to the fused kernel above.
+ */
+template<bool Proximal, typename MatType, typename GradType>
+void KatyushaInnerStep(MatType& y,
+                       MatType& z,
+                       MatType& w,
+                       const MatType& iterate,
+                       const GradType& fullGradient,
+                       const GradType& gradient,
+                       const GradType& gradient0,
+                       const double alpha,
+                       const double tau1,
+                       const double lipschitz,
+                       const double batchSize,
+                       const double cw,
+                       const IdentityProximal& /* proxOperator */)
+{
+  KatyushaInnerUpdate<Proximal>(y, z, w, iterate, fullGradient, gradient,
+      gradient0, alpha, tau1, lipschitz, batchSize, cw);
+}
+
+/**
+ * Inner-loop step for composite objectives: both argmin sequences become
+ * proximal (gradient-mapping) steps.  The z update is the mirror descent
+ * step with step size alpha, and the y update is the gradient step with the
+ * 1 / (3L) step dictated by the smoothness bound; applying the proximal
+ * operator after each one solves the respective argmin including the
+ * nonsmooth term exactly.  The expression forms are kept here (instead of
+ * the fused kernel) because the operator acts on whole matrices.
+ */
+template<bool Proximal, typename MatType, typename GradType,
+         typename ProxOperatorType>
+void KatyushaInnerStep(MatType& y,
+                       MatType& z,
+                       MatType& w,
+                       const MatType& iterate,
+                       const GradType& fullGradient,
+                       const GradType& gradient,
+                       const GradType& gradient0,
+                       const double alpha,
+                       const double /* tau1 */,
+                       const double lipschitz,
+                       const double batchSize,
+                       const double cw,
+                       const ProxOperatorType& proxOperator)
+{
+  const GradType vr = fullGradient + (gradient - gradient0) / batchSize;
+
+  z -= alpha * vr;
+  proxOperator.Apply(z, alpha);
+
+  y = iterate - 1.0 / (3.0 * lipschitz) * vr;
+  proxOperator.Apply(y, 1.0 / (3.0 * lipschitz));
+
+  w += cw * iterate;
+}
+
+template<bool Proximal, typename ProxOperatorType>
+KatyushaType<Proximal, ProxOperatorType>::KatyushaType(
     const double convexity,
     const double lipschitz,
     const size_t batchSize,
@@ -28,7 +168,8 @@ KatyushaType<Proximal>::KatyushaType(
     const size_t innerIterations,
     const double tolerance,
     const bool shuffle,
-    const bool exactObjective) :
+    const bool exactObjective,
+    const ProxOperatorType& proxOperator) :
     convexity(convexity),
     lipschitz(lipschitz),
     batchSize(batchSize),
@@ -36,18 +177,19 @@ KatyushaType<Proximal>::KatyushaType(
     innerIterations(innerIterations),
     tolerance(tolerance),
     shuffle(shuffle),
-    exactObjective(exactObjective)
+    exactObjective(exactObjective),
+    proxOperator(proxOperator)
 { /* Nothing to do. */ }
 
 //! Optimize the function (minimize).
-template<bool Proximal>
+template<bool Proximal, typename ProxOperatorType>
 template<typename SeparableFunctionType,
          typename MatType,
          typename GradType,
          typename... CallbackTypes>
 typename std::enable_if<IsArmaType<GradType>::value,
 typename MatType::elem_type>::type
-KatyushaType<Proximal>::Optimize(
+KatyushaType<Proximal, ProxOperatorType>::Optimize(
     SeparableFunctionType& function,
     MatType& iterateIn,
     CallbackTypes&&... callbacks)
@@ -207,31 +349,27 @@ KatyushaType<Proximal>::Optimize(
 
       // By the minimality definition of z_{k + 1}, we have that:
       // z_{k+1} − z_k + \alpha * \sigma_{k+1} + \alpha g = 0.
-      BaseMatType zNew = z - alpha * (fullGradient + (gradient - gradient0) /
-          (double) batchSize);
-
+      //
       // Proximal update, choose between Option I and Option II. Shift relative
       // to the Lipschitz constant or take a constant step using the given step
-      // size.
-      if (Proximal)
-      {
-        // yk = x0 − 1 / (3L) * \delta1, k = 1
-        // yk = x0 − 1 / (3L) * \delta2 - ((1 - tau) / (3L)) + tau * alpha)
-        // * \delta1, k = 2
-        // yk = x0 − 1 / (3L) * \delta3 - ((1 - tau) / (3L)) + tau * alpha)
-        // * \delta2 - ((1-tau)^2 / (3L) + (1 - (1 - tau)^2) * alpha) * \delta1,
-        // k = 3.
-        y = iterate + 1.0 / (3.0 * lipschitz) * w;
-      }
-      else
-      {
-        y = iterate + tau1 * (zNew - z);
-      }
-
-      z = std::move(zNew);
-
+      // size:
+      //
+      // yk = x0 − 1 / (3L) * \delta1, k = 1
+      // yk = x0 − 1 / (3L) * \delta2 - ((1 - tau) / (3L)) + tau * alpha)
+      // * \delta1, k = 2
+      // yk = x0 − 1 / (3L) * \delta3 - ((1 - tau) / (3L)) + tau * alpha)
+      // * \delta2 - ((1-tau)^2 / (3L) + (1 - (1 - tau)^2) * alpha) * \delta1,
+      // k = 3.
+      //
+      // The w update accumulates
       // sum_{j=0}^{m-1} 1 + std::min(alpha * convexity, 1 / (4 * m)^j * ys).
-      w += cw * iterate;
+      //
+      // The z, y, and w sequence updates are fused into a single pass over
+      // the buffers for dense types.  With a real proximal operator the step
+      // switches to the composite (prox) form of the sequence updates.
+      KatyushaInnerStep<Proximal>(y, z, w, iterate, fullGradient, gradient,
+          gradient0, alpha, tau1, lipschitz, (double) batchSize, cw,
+          proxOperator);
       cw *= r;
 
       currentFunction += effectiveBatchSize;
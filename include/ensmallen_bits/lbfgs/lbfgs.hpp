@@ -144,7 +144,76 @@ class L_BFGS
   //! Modify the maximum line search step size.
   double& MaxStep() { return maxStep; }
 
- private:
+  //! Get whether the line search evaluates several trial step sizes
+  //! concurrently (requires EvaluateWithGradient() to be thread-safe).
+  bool SpeculativeLineSearch() const { return speculativeLineSearch; }
+  //! Modify whether the line search evaluates trial step sizes concurrently.
+  bool& SpeculativeLineSearch() { return speculativeLineSearch; }
+
+  //! Get the number of trial step sizes evaluated concurrently per round of
+  //! the speculative line search.
+  size_t SpeculationWidth() const { return speculationWidth; }
+  //! Modify the number of trial step sizes evaluated concurrently.
+  size_t& SpeculationWidth() { return speculationWidth; }
+
+  //! Get whether the line search brackets the minimizer and narrows the
+  //! bracket with cubic interpolation (see WolfeLineSearch) instead of
+  //! back-tracking; this usually needs fewer evaluations per iteration.
+  bool CubicLineSearch() const { return cubicLineSearch; }
+  //! Modify whether the line search uses bracketing with cubic interpolation.
+  bool& CubicLineSearch() { return cubicLineSearch; }
+
+  //! Get the nonmonotone line search memory (0 forces monotone descent).
+  size_t NonmonotoneMemory() const { return nonmonotoneMemory; }
+  //! Modify the nonmonotone line search memory.  A value M > 0 relaxes the
+  //! Armijo acceptance of the back-tracking line search to the
+  //! Grippo-Lampariello-Lucidi rule: a trial step is compared against the
+  //! maximum function value over the last M iterates instead of the current
+  //! one.  On ill-conditioned problems this avoids the long back-tracking
+  //! cascades that monotone descent triggers inside narrow curved valleys,
+  //! typically reducing the total number of function evaluations.  The
+  //! history is kept in a ring buffer of M values.
+  size_t& NonmonotoneMemory() { return nonmonotoneMemory; }
+
+  //! Get whether the stored (s, y) memory pairs are carried over between
+  //! Optimize() calls.  This is useful when a slowly-changing function is
+  //! minimized repeatedly, as in AugLagrangian's outer iterations.
+  bool RetainMemory() const { return retainMemory; }
+  //! Modify whether the memory pairs are carried over between calls.
+  bool& RetainMemory() { return retainMemory; }
+
+  //! Get the externally seeded initial Hessian scaling factor (0 uses the
+  //! standard gradient-norm heuristic).
+  double InitialScalingFactor() const { return initialScalingFactor; }
+  //! Modify the initial Hessian scaling factor.  Before any (s, y) pairs
+  //! are recorded, the inverse Hessian approximation is this multiple of
+  //! the identity, so a caller with curvature information from a preceding
+  //! global phase (e.g. the CMA-ES sampling covariance scale; see
+  //! HybridOptimizer) can seed it instead of starting from the
+  //! gradient-norm heuristic.
+  double& InitialScalingFactor() { return initialScalingFactor; }
+
+  //! Get whether the search direction is computed with the vector-free
+  //! formulation.
+  bool VectorFree() const { return vectorFree; }
+  //! Modify whether the search direction is computed with the vector-free
+  //! formulation (Chen et al., 2014).  The two-loop recursion is then run on
+  //! the (2m + 1)^2 Gram matrix of the stored pairs and the gradient -- the
+  //! pairwise entries are maintained incrementally, one pass of dot products
+  //! per iteration -- and the direction is formed in a single linear
+  //! combination pass over the history.  The computed direction is
+  //! mathematically identical to the ordinary recursion; the benefit is that
+  //! the history vectors are only ever read in bulk dot products and one
+  //! linear combination, instead of one read-modify-write pass per stored
+  //! pair, which matters when the iterate is too large to stay in cache (or
+  //! lives on several machines).
+  bool& VectorFree() { return vectorFree; }
+
+ protected:
+  // The members and helpers below are protected (not private) so that
+  // L_BFGS_B can reuse the limited-memory machinery, in particular the
+  // two-loop recursion in SearchDirection().
+
   //! Size of memory for this L-BFGS optimizer.
   size_t numBasis;
   //! Maximum number of iterations.
@@ -163,9 +232,48 @@ class L_BFGS
   double minStep;
   //! Maximum step of the line search.
   double maxStep;
+  //! Whether the line search evaluates trial step sizes concurrently.
+  bool speculativeLineSearch;
+  //! Number of trial step sizes evaluated concurrently per round.
+  size_t speculationWidth;
+  //! Whether the line search uses bracketing with cubic interpolation.
+  bool cubicLineSearch;
+  //! Nonmonotone line search memory (0 forces monotone descent).
+  size_t nonmonotoneMemory;
+  //! Ring buffer holding the last nonmonotoneMemory function values.
+  std::vector<double> nonmonotoneHistory;
+  //! Write position in the nonmonotone ring buffer.
+  size_t nonmonotoneNext;
+  //! Number of valid entries in the nonmonotone ring buffer.
+  size_t nonmonotoneCount;
+  //! Whether the memory pairs are carried over between Optimize() calls.
+  bool retainMemory;
+  //! Externally seeded initial Hessian scaling factor (0 uses the standard
+  //! gradient-norm heuristic).
+  double initialScalingFactor;
+  //! Whether the search direction is computed with the vector-free
+  //! formulation.
+  bool vectorFree;
   //! Controls early termination of the optimization process.
   bool terminate;
 
+  //! The limited-memory state stored between Optimize() calls when
+  //! RetainMemory() is enabled.
+  template<typename ElemType>
+  struct RetainedMemory
+  {
+    //! Stored iterate and gradient difference pairs.
+    arma::Cube<ElemType> s, y;
+    //! Cached dot products of the stored pairs.
+    arma::Col<ElemType> sDotY, yDotY;
+    //! Total number of pairs recorded so far (not capped at numBasis).
+    size_t numPairs;
+  };
+
+  //! Instantiated RetainedMemory<ElemType> of the last Optimize() call;
+  //! lazily created since the element type is not known until then.
+  Any retainedMemory;
+
   /**
    * Calculate the scaling factor, gamma, which is used to scale the Hessian
    * approximation matrix.  See method M3 in Section 4 of Liu and Nocedal
@@ -173,14 +281,14 @@ class L_BFGS
    *
    * @return The calculated scaling factor.
    * @param gradient The gradient at the initial point.
-   * @param s Differences between the iterate and old iterate matrix.
-   * @param y Differences between the gradient and the old gradient matrix.
+   * @param sDotY Cached dot products s_k . y_k of the stored pairs.
+   * @param yDotY Cached dot products y_k . y_k of the stored pairs.
    */
-  template<typename MatType, typename CubeType>
+  template<typename MatType, typename ColType>
   double ChooseScalingFactor(const size_t iterationNum,
                              const MatType& gradient,
-                             const CubeType& s,
-                             const CubeType& y);
+                             const ColType& sDotY,
+                             const ColType& yDotY);
 
   /**
    * Perform a back-tracking line search along the search direction to
@@ -211,6 +319,30 @@ class L_BFGS
                   double& finalStepSize,
                   CallbackTypes&... callbacks);
 
+  /**
+   * Speculative variant of LineSearch(): in each round, a ladder of candidate
+   * step sizes is evaluated concurrently and the largest candidate satisfying
+   * the Armijo and strong Wolfe conditions is accepted.  Requires the
+   * function's EvaluateWithGradient() to be thread-safe.
+   *
+   * The parameters match LineSearch().
+   *
+   * @return false if no step size is suitable, true otherwise.
+   */
+  template<typename FunctionType,
+           typename ElemType,
+           typename MatType,
+           typename GradType,
+           typename... CallbackTypes>
+  bool SpeculativeSearch(FunctionType& function,
+                         ElemType& functionValue,
+                         MatType& iterate,
+                         GradType& gradient,
+                         MatType& newIterateTmp,
+                         const GradType& searchDirection,
+                         double& finalStepSize,
+                         CallbackTypes&... callbacks);
+
   /**
    * Find the L-BFGS search direction.
    *
@@ -219,16 +351,95 @@ class L_BFGS
    * @param scalingFactor Scaling factor to use (see ChooseScalingFactor_()).
    * @param s Differences between the iterate and old iterate matrix.
    * @param y Differences between the gradient and the old gradient matrix.
+   * @param sDotY Cached dot products s_k . y_k of the stored pairs.
    * @param searchDirection Vector to store search direction in.
    */
-  template<typename MatType, typename CubeType>
+  template<typename MatType, typename CubeType, typename ColType>
   void SearchDirection(const MatType& gradient,
                        const size_t iterationNum,
                        const double scalingFactor,
                        const CubeType& s,
                        const CubeType& y,
+                       const ColType& sDotY,
+                       MatType& searchDirection);
+
+  /**
+   * Fused implementation of the two-loop recursion for dense types: each pass
+   * over the search direction applies one pair's update and gathers the dot
+   * product needed by the next pair, halving the memory traffic of the
+   * recursion.  The parameters match SearchDirection().
+   */
+  template<typename MatType, typename CubeType, typename ColType>
+  typename std::enable_if<arma::is_arma_type<MatType>::value, void>::type
+  FusedSearchDirection(const MatType& gradient,
+                       const size_t iterationNum,
+                       const double scalingFactor,
+                       const CubeType& s,
+                       const CubeType& y,
+                       const ColType& sDotY,
+                       MatType& searchDirection);
+
+  /**
+   * Unfused implementation of the two-loop recursion, for types without
+   * contiguous element access (e.g. sparse gradients).  The parameters match
+   * SearchDirection().
+   */
+  template<typename MatType, typename CubeType, typename ColType>
+  typename std::enable_if<!arma::is_arma_type<MatType>::value, void>::type
+  FusedSearchDirection(const MatType& gradient,
+                       const size_t iterationNum,
+                       const double scalingFactor,
+                       const CubeType& s,
+                       const CubeType& y,
+                       const ColType& sDotY,
                        MatType& searchDirection);
 
+  /**
+   * Vector-free computation of the L-BFGS search direction (see
+   * VectorFree()): the two-loop recursion is run on the coefficients of the
+   * direction over the basis [s_0, ..., s_{m-1}, y_0, ..., y_{m-1},
+   * gradient], so it only reads the (2m + 1)^2 Gram matrix of that basis.
+   * The pairwise entries of the Gram matrix were maintained incrementally by
+   * UpdateGramMatrix(); this method refreshes the gradient row and forms the
+   * direction in a single linear combination pass over the stored vectors.
+   *
+   * @param gradient The gradient at the current point.
+   * @param iterationNum The iteration number.
+   * @param scalingFactor Scaling factor to use (see ChooseScalingFactor_()).
+   * @param s Differences between the iterate and old iterate matrix.
+   * @param y Differences between the gradient and the old gradient matrix.
+   * @param sDotY Cached dot products s_k . y_k of the stored pairs.
+   * @param gram Gram matrix of the stored pairs and the gradient.
+   * @param searchDirection Vector to store search direction in.
+   */
+  template<typename MatType, typename CubeType, typename ColType,
+           typename GramType>
+  void VectorFreeSearchDirection(const MatType& gradient,
+                                 const size_t iterationNum,
+                                 const double scalingFactor,
+                                 const CubeType& s,
+                                 const CubeType& y,
+                                 const ColType& sDotY,
+                                 GramType& gram,
+                                 MatType& searchDirection);
+
+  /**
+   * Update the Gram matrix of the stored pairs after UpdateBasisSet() wrote a
+   * new (s, y) pair: the dot products between previously stored pairs are
+   * still valid, so only the new pair's row and column are recomputed.
+   *
+   * @param iterationNum Iteration number (the same value that was passed to
+   *     UpdateBasisSet()).
+   * @param s Differences between the iterate and old iterate matrix.
+   * @param y Differences between the gradient and the old gradient matrix.
+   * @param gram Gram matrix of the stored pairs and the gradient.
+   */
+  template<typename CubeType, typename GramType>
+  void UpdateGramMatrix(const size_t iterationNum,
+                        const CubeType& s,
+                        const CubeType& y,
+                        GramType& gram);
+
   /**
    * Update the y and s matrices, which store the differences
    * between the iterate and old iterate and the differences between the
@@ -241,15 +452,20 @@ class L_BFGS
    * @param oldGradient Gradient at last iteration point (oldIterate).
    * @param s Differences between the iterate and old iterate matrix.
    * @param y Differences between the gradient and the old gradient matrix.
+   * @param sDotY Cached dot products s_k . y_k of the stored pairs.
+   * @param yDotY Cached dot products y_k . y_k of the stored pairs.
    */
-  template<typename MatType, typename GradType, typename CubeType>
+  template<typename MatType, typename GradType, typename CubeType,
+           typename ColType>
   void UpdateBasisSet(const size_t iterationNum,
                       const MatType& iterate,
                       const MatType& oldIterate,
                       const GradType& gradient,
                       const GradType& oldGradient,
                       CubeType& s,
-                      CubeType& y);
+                      CubeType& y,
+                      ColType& sDotY,
+                      ColType& yDotY);
 };
 
 } // namespace ens
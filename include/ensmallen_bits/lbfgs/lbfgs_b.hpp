@@ -0,0 +1,172 @@
+/**
+ * @file lbfgs_b.hpp
+ * @author Ryan Curtin
+ *
+ * The L-BFGS-B optimizer for box-constrained problems, built on the L_BFGS
+ * limited-memory machinery.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_LBFGS_LBFGS_B_HPP
+#define ENSMALLEN_LBFGS_LBFGS_B_HPP
+
+#include "lbfgs.hpp"
+
+namespace ens {
+
+/**
+ * L-BFGS-B minimizes a differentiable function subject to simple bound (box)
+ * constraints on the parameters.  The limited-memory Hessian approximation and
+ * the two-loop recursion are shared with L_BFGS; feasibility is maintained by
+ * a back-tracking search along the projected arc P(x + alpha * d), and
+ * convergence is measured with the projected gradient.  Compared to clamping
+ * the result of an unconstrained solver, the history only ever sees feasible
+ * points, so curvature information stays consistent and far fewer
+ * Evaluate()/Gradient() calls are needed.
+ *
+ * This follows the gradient-projection approach of:
+ *
+ * @code
+ * @article{Byrd1995,
+ *   author  = {Byrd, Richard H. and Lu, Peihuang and Nocedal, Jorge and
+ *              Zhu, Ciyou},
+ *   title   = {A Limited Memory Algorithm for Bound Constrained Optimization},
+ *   journal = {SIAM Journal on Scientific Computing},
+ *   year    = {1995},
+ *   volume  = {16},
+ *   number  = {5},
+ *   pages   = {1190--1208}}
+ * @endcode
+ *
+ * with the simplification that the subspace step is the projected
+ * quasi-Newton direction instead of an explicit Cauchy-point computation;
+ * correction pairs that fail the curvature condition are skipped so the
+ * Hessian approximation stays positive definite on the feasible set.
+ *
+ * Bounds are given as matrices matching the shape of the iterate; a 1x1 bound
+ * applies to every coordinate.  L_BFGS_B can optimize differentiable
+ * functions.
+ */
+class L_BFGS_B : public L_BFGS
+{
+ public:
+  /**
+   * Initialize the L-BFGS-B object with per-coordinate bounds.  The remaining
+   * parameters match L_BFGS.
+   *
+   * @param lowerBound Lower bound of the coordinates (1x1 applies to all).
+   * @param upperBound Upper bound of the coordinates (1x1 applies to all).
+   * @param numBasis Number of memory points to be stored (default 10).
+   * @param maxIterations Maximum number of iterations for the optimization
+   *     (0 means no limit and may run indefinitely).
+   * @param armijoConstant Controls the accuracy of the line search routine for
+   *     determining the Armijo condition.
+   * @param wolfe Parameter for detecting the Wolfe condition.
+   * @param minGradientNorm Minimum projected gradient norm required to
+   *     continue the optimization.
+   * @param factr Minimum relative function value decrease to continue
+   *     the optimization.
+   * @param maxLineSearchTrials The maximum number of trials for the line
+   *     search (before giving up).
+   * @param minStep The minimum step of the line search.
+   * @param maxStep The maximum step of the line search.
+   */
+  L_BFGS_B(const arma::mat& lowerBound,
+           const arma::mat& upperBound,
+           const size_t numBasis = 10,
+           const size_t maxIterations = 10000,
+           const double armijoConstant = 1e-4,
+           const double wolfe = 0.9,
+           const double minGradientNorm = 1e-6,
+           const double factr = 1e-15,
+           const size_t maxLineSearchTrials = 50,
+           const double minStep = 1e-20,
+           const double maxStep = 1e20);
+
+  /**
+   * Initialize the L-BFGS-B object with the same scalar bounds for every
+   * coordinate.  The defaults give an unconstrained problem, in which case
+   * the behavior matches L_BFGS.
+   *
+   * @param lowerBound Lower bound applied to every coordinate.
+   * @param upperBound Upper bound applied to every coordinate.
+   */
+  L_BFGS_B(const double lowerBound =
+               -std::numeric_limits<double>::infinity(),
+           const double upperBound =
+               std::numeric_limits<double>::infinity());
+
+  /**
+   * Use L-BFGS-B to minimize the given function subject to the box
+   * constraints, starting at the given iterate point.  The starting point is
+   * projected into the feasible box before optimization begins, will be
+   * modified to store the finishing point of the algorithm, and the final
+   * objective value is returned.
+   *
+   * @tparam FunctionType Type of the function to be optimized.
+   * @tparam MatType Type of matrix to optimize with.
+   * @tparam GradType Type of matrix to use to represent function gradients.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to optimize; must have Evaluate() and Gradient().
+   * @param iterate Starting point (will be modified).
+   * @param callbacks Callback functions.
+   * @return Objective value of the final point.
+   */
+  template<typename FunctionType,
+           typename MatType,
+           typename GradType,
+           typename... CallbackTypes>
+  typename std::enable_if<IsArmaType<GradType>::value,
+      typename MatType::elem_type>::type
+  Optimize(FunctionType& function,
+           MatType& iterate,
+           CallbackTypes&&... callbacks);
+
+  //! Forward the MatType as GradType.
+  template<typename FunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(FunctionType& function,
+                                       MatType& iterate,
+                                       CallbackTypes&&... callbacks)
+  {
+    return Optimize<FunctionType, MatType, MatType,
+        CallbackTypes...>(function, iterate,
+        std::forward<CallbackTypes>(callbacks)...);
+  }
+
+  //! Get the lower bound of the coordinates.
+  const arma::mat& LowerBound() const { return lowerBound; }
+  //! Modify the lower bound of the coordinates.
+  arma::mat& LowerBound() { return lowerBound; }
+
+  //! Get the upper bound of the coordinates.
+  const arma::mat& UpperBound() const { return upperBound; }
+  //! Modify the upper bound of the coordinates.
+  arma::mat& UpperBound() { return upperBound; }
+
+ private:
+  /**
+   * Project the given point onto the feasible box, elementwise.  A 1x1 bound
+   * matrix is broadcast to every coordinate.
+   *
+   * @param x Point to project (will be modified).
+   */
+  template<typename MatType>
+  void Project(MatType& x) const;
+
+  //! Lower bound of the coordinates.
+  arma::mat lowerBound;
+
+  //! Upper bound of the coordinates.
+  arma::mat upperBound;
+};
+
+} // namespace ens
+
+#include "lbfgs_b_impl.hpp"
+
+#endif // ENSMALLEN_LBFGS_LBFGS_B_HPP
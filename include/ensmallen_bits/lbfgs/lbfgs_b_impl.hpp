@@ -0,0 +1,306 @@
+/**
+ * @file lbfgs_b_impl.hpp
+ * @author Ryan Curtin
+ *
+ * The implementation of the L_BFGS_B optimizer.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_LBFGS_LBFGS_B_IMPL_HPP
+#define ENSMALLEN_LBFGS_LBFGS_B_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "lbfgs_b.hpp"
+
+#include <ensmallen_bits/function.hpp>
+
+namespace ens {
+
+inline L_BFGS_B::L_BFGS_B(const arma::mat& lowerBound,
+                          const arma::mat& upperBound,
+                          const size_t numBasis,
+                          const size_t maxIterations,
+                          const double armijoConstant,
+                          const double wolfe,
+                          const double minGradientNorm,
+                          const double factr,
+                          const size_t maxLineSearchTrials,
+                          const double minStep,
+                          const double maxStep) :
+    L_BFGS(numBasis, maxIterations, armijoConstant, wolfe, minGradientNorm,
+        factr, maxLineSearchTrials, minStep, maxStep),
+    lowerBound(lowerBound),
+    upperBound(upperBound)
+{
+  // Nothing to do.
+}
+
+inline L_BFGS_B::L_BFGS_B(const double lowerBound, const double upperBound) :
+    L_BFGS(),
+    lowerBound(arma::mat(1, 1).fill(lowerBound)),
+    upperBound(arma::mat(1, 1).fill(upperBound))
+{
+  // Nothing to do.
+}
+
+//! Project the given point onto the feasible box, elementwise.
+template<typename MatType>
+void L_BFGS_B::Project(MatType& x) const
+{
+  typedef typename MatType::elem_type ElemType;
+
+  for (size_t j = 0; j < x.n_cols; ++j)
+  {
+    // Broadcast 1x1 (or single-column) bounds to every coordinate.
+    const size_t lj = (j < lowerBound.n_cols) ? j : (lowerBound.n_cols - 1);
+    const size_t uj = (j < upperBound.n_cols) ? j : (upperBound.n_cols - 1);
+    for (size_t i = 0; i < x.n_rows; ++i)
+    {
+      const size_t li = (i < lowerBound.n_rows) ? i : (lowerBound.n_rows - 1);
+      const size_t ui = (i < upperBound.n_rows) ? i : (upperBound.n_rows - 1);
+
+      if (x(i, j) < (ElemType) lowerBound(li, lj))
+        x(i, j) = (ElemType) lowerBound(li, lj);
+      else if (x(i, j) > (ElemType) upperBound(ui, uj))
+        x(i, j) = (ElemType) upperBound(ui, uj);
+    }
+  }
+}
+
+template<typename FunctionType,
+         typename MatType,
+         typename GradType,
+         typename... CallbackTypes>
+typename std::enable_if<IsArmaType<GradType>::value,
+typename MatType::elem_type>::type
+L_BFGS_B::Optimize(FunctionType& function,
+                   MatType& iterateIn,
+                   CallbackTypes&&... callbacks)
+{
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef typename MatTypeTraits<GradType>::BaseMatType BaseGradType;
+
+  // Use the Function<> wrapper to ensure the function has all of the functions
+  // that we need.
+  typedef Function<FunctionType, BaseMatType, BaseGradType> FullFunctionType;
+  FullFunctionType& f = static_cast<FullFunctionType&>(function);
+
+  // Check that we have all the functions we will need.
+  traits::CheckFunctionTypeAPI<FullFunctionType, BaseMatType, BaseGradType>();
+  RequireFloatingPointType<BaseMatType>();
+  RequireFloatingPointType<BaseGradType>();
+  RequireSameInternalTypes<BaseMatType, BaseGradType>();
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+
+  // Start from a feasible point.
+  Project(iterate);
+
+  const size_t rows = iterate.n_rows;
+  const size_t cols = iterate.n_cols;
+
+  BaseMatType newIterateTmp(rows, cols);
+  arma::Cube<ElemType> s(rows, cols, numBasis);
+  arma::Cube<ElemType> y(rows, cols, numBasis);
+
+  // Cached dot products of the stored correction pairs (see L_BFGS).
+  arma::Col<ElemType> sDotY(numBasis);
+  arma::Col<ElemType> yDotY(numBasis);
+  sDotY.zeros();
+  yDotY.zeros();
+
+  // Number of correction pairs accepted so far; pairs failing the curvature
+  // condition are skipped, so this can lag behind the iteration number.
+  size_t pairCount = 0;
+
+  // The old iterate and gradient to be saved.
+  BaseMatType oldIterate(rows, cols);
+  oldIterate.zeros();
+  BaseGradType gradient(rows, cols);
+  gradient.zeros();
+  BaseGradType oldGradient(rows, cols);
+  oldGradient.zeros();
+
+  // The search direction and the projected gradient.
+  BaseGradType searchDirection(rows, cols);
+  searchDirection.zeros();
+  BaseMatType projectedGradient(rows, cols);
+
+  // Whether to optimize until convergence.
+  const bool optimizeUntilConvergence = (maxIterations == 0);
+
+  // The initial function value and gradient.
+  ElemType functionValue = f.EvaluateWithGradient(iterate, gradient);
+
+  terminate |= Callback::EvaluateWithGradient(*this, f, iterate,
+      functionValue, gradient, callbacks...);
+
+  ElemType prevFunctionValue;
+
+  // Back-tracking search along the projected arc P(x + stepSize * direction):
+  // each trial projects the candidate onto the box, so the path bends along
+  // the active constraints.  Only the Armijo condition is tested; the
+  // curvature of accepted pairs is checked separately below.
+  auto arcSearch = [&](const BaseGradType& direction, double& finalStepSize)
+  {
+    const ElemType initialFunctionValue = functionValue;
+    double stepSize = 1.0;
+    finalStepSize = 0.0;
+
+    for (size_t trial = 0; trial < maxLineSearchTrials; ++trial)
+    {
+      newIterateTmp = iterate;
+      newIterateTmp += stepSize * direction;
+      Project(newIterateTmp);
+
+      // The linear model holds for the projected step, not the raw one.
+      const ElemType directionalDerivative = arma::dot(oldGradient,
+          newIterateTmp - iterate);
+      if (directionalDerivative >= 0.0 ||
+          std::isfinite(directionalDerivative) == false)
+      {
+        // The projected step is not a descent step; all coordinates may be at
+        // their bounds, or the step is too long.  Try a shorter one.
+        stepSize *= 0.5;
+        if (stepSize < minStep)
+          return false;
+        continue;
+      }
+
+      functionValue = f.EvaluateWithGradient(newIterateTmp, gradient);
+      if (std::isnan(functionValue))
+        return false;
+
+      terminate |= Callback::EvaluateWithGradient(*this, f, newIterateTmp,
+          functionValue, gradient, callbacks...);
+
+      if (functionValue <= initialFunctionValue + armijoConstant *
+          directionalDerivative)
+      {
+        iterate = newIterateTmp;
+        finalStepSize = stepSize;
+        return true;
+      }
+
+      stepSize *= 0.5;
+      if (stepSize < minStep)
+        break;
+    }
+
+    functionValue = initialFunctionValue;
+    return false;
+  };
+
+  // The main optimization loop.
+  Callback::BeginOptimization(*this, f, iterate, callbacks...);
+  for (size_t itNum = 0; (optimizeUntilConvergence || (itNum != maxIterations))
+      && !terminate; ++itNum)
+  {
+    prevFunctionValue = functionValue;
+
+    // Break when the norm of the projected gradient becomes too small; at a
+    // constrained minimizer the raw gradient need not vanish, but the
+    // projected gradient does.
+    projectedGradient = iterate - gradient;
+    Project(projectedGradient);
+    projectedGradient = iterate - projectedGradient;
+    if (arma::norm(projectedGradient, 2) < minGradientNorm)
+    {
+      Info << "L-BFGS-B projected gradient norm too small (terminating "
+          << "successfully)." << std::endl;
+      break;
+    }
+
+    // Break if the objective is not a number.
+    if (std::isnan(functionValue))
+    {
+      Warn << "L-BFGS-B terminated with objective " << functionValue << "; "
+          << "are the objective and gradient functions implemented correctly?"
+          << std::endl;
+      break;
+    }
+
+    // Choose the scaling factor from the accepted correction pairs.
+    const double scalingFactor = ChooseScalingFactor(pairCount, gradient,
+        sDotY, yDotY);
+    if ((scalingFactor == 0.0) || (std::isfinite(scalingFactor) == false))
+    {
+      Info << "L-BFGS-B scaling factor computed as " << scalingFactor
+          << " (terminating)." << std::endl;
+      break;
+    }
+
+    // Build the quasi-Newton direction with the shared two-loop recursion.
+    SearchDirection(gradient, pairCount, scalingFactor, s, y, sDotY,
+        searchDirection);
+
+    // Save the old iterate and the gradient before stepping.
+    oldIterate = iterate;
+    oldGradient = gradient;
+
+    double stepSize; // Set by arcSearch().
+    if (!arcSearch(searchDirection, stepSize))
+    {
+      // The quasi-Newton direction can fail along the projected arc when the
+      // active set changes; fall back to projected steepest descent before
+      // giving up.
+      searchDirection = -oldGradient;
+      gradient = oldGradient;
+      if (!arcSearch(searchDirection, stepSize))
+      {
+        Warn << "Line search failed.  Stopping optimization." << std::endl;
+        break;
+      }
+    }
+
+    // It is possible that the projection left the iterate unchanged.  In this
+    // case we terminate successfully.
+    if (stepSize == 0.0)
+    {
+      Info << "L-BFGS-B step size of 0 (terminating successfully)."
+          << std::endl;
+      break;
+    }
+
+    // If we can't make progress on the gradient, then we'll also accept
+    // a stable function value.
+    const double denom = std::max(
+        std::max(std::abs(prevFunctionValue), std::abs(functionValue)),
+        (ElemType) 1.0);
+    if ((prevFunctionValue - functionValue) / denom <= factr)
+    {
+      Info << "L-BFGS-B function value stable (terminating successfully)."
+          << std::endl;
+      break;
+    }
+
+    // Store the correction pair in the ring, but only if it satisfies the
+    // curvature condition; projection can produce pairs with s . y <= 0,
+    // which would destroy the positive definiteness of the approximation.
+    const size_t pos = pairCount % numBasis;
+    s.slice(pos) = iterate - oldIterate;
+    y.slice(pos) = gradient - oldGradient;
+    const ElemType sy = arma::dot(s.slice(pos), y.slice(pos));
+    const ElemType yy = arma::dot(y.slice(pos), y.slice(pos));
+    if (sy > 100 * std::numeric_limits<ElemType>::epsilon() * yy)
+    {
+      sDotY(pos) = sy;
+      yDotY(pos) = yy;
+      ++pairCount;
+    }
+
+    terminate |= Callback::StepTaken(*this, f, iterate, callbacks...);
+  } // End of the optimization loop.
+
+  Callback::EndOptimization(*this, f, iterate, callbacks...);
+  return functionValue;
+}
+
+} // namespace ens
+
+#endif // ENSMALLEN_LBFGS_LBFGS_B_IMPL_HPP
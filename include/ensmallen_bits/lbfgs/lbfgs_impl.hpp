@@ -17,6 +17,7 @@
 #include "lbfgs.hpp"
 
 #include <ensmallen_bits/function.hpp>
+#include <ensmallen_bits/line_search/wolfe_line_search.hpp>
 
 namespace ens {
 
@@ -56,6 +57,15 @@ inline L_BFGS::L_BFGS(const size_t numBasis,
     maxLineSearchTrials(maxLineSearchTrials),
     minStep(minStep),
     maxStep(maxStep),
+    speculativeLineSearch(false),
+    speculationWidth(4),
+    cubicLineSearch(false),
+    nonmonotoneMemory(0),
+    nonmonotoneNext(0),
+    nonmonotoneCount(0),
+    retainMemory(false),
+    initialScalingFactor(0.0),
+    vectorFree(false),
     terminate(false)
 {
   // Nothing to do.
@@ -68,16 +78,16 @@ inline L_BFGS::L_BFGS(const size_t numBasis,
  *
  * @return The calculated scaling factor.
  * @param gradient The gradient at the initial point.
- * @param s Differences between the iterate and old iterate matrix.
- * @param y Differences between the gradient and the old gradient matrix.
+ * @param sDotY Cached dot products s_k . y_k of the stored pairs.
+ * @param yDotY Cached dot products y_k . y_k of the stored pairs.
  */
-template<typename MatType, typename CubeType>
+template<typename MatType, typename ColType>
 double L_BFGS::ChooseScalingFactor(const size_t iterationNum,
                                    const MatType& gradient,
-                                   const CubeType& s,
-                                   const CubeType& y)
+                                   const ColType& sDotY,
+                                   const ColType& yDotY)
 {
-  typedef typename CubeType::elem_type CubeElemType;
+  typedef typename ColType::elem_type CubeElemType;
 
   constexpr const CubeElemType tol =
       100 * std::numeric_limits<CubeElemType>::epsilon();
@@ -86,14 +96,16 @@ double L_BFGS::ChooseScalingFactor(const size_t iterationNum,
   if (iterationNum > 0)
   {
     int previousPos = (iterationNum - 1) % numBasis;
-    // Get s and y matrices once instead of multiple times.
-    const arma::Mat<CubeElemType>& sMat = s.slice(previousPos);
-    const arma::Mat<CubeElemType>& yMat = y.slice(previousPos);
 
-    const CubeElemType tmp   = arma::dot(yMat, yMat);
+    const CubeElemType tmp   = yDotY(previousPos);
     const CubeElemType denom = (tmp >= tol) ? tmp : CubeElemType(1);
 
-    scalingFactor = arma::dot(sMat, yMat) / denom;
+    scalingFactor = sDotY(previousPos) / denom;
+  }
+  else if (initialScalingFactor > 0.0)
+  {
+    // Externally seeded curvature estimate (see InitialScalingFactor()).
+    scalingFactor = initialScalingFactor;
   }
   else
   {
@@ -113,14 +125,145 @@ double L_BFGS::ChooseScalingFactor(const size_t iterationNum,
  * @param scalingFactor Scaling factor to use (see ChooseScalingFactor_()).
  * @param s Differences between the iterate and old iterate matrix.
  * @param y Differences between the gradient and the old gradient matrix.
+ * @param sDotY Cached dot products s_k . y_k of the stored pairs.
  * @param searchDirection Vector to store search direction in.
  */
-template<typename MatType, typename CubeType>
+template<typename MatType, typename CubeType, typename ColType>
 void L_BFGS::SearchDirection(const MatType& gradient,
                              const size_t iterationNum,
                              const double scalingFactor,
                              const CubeType& s,
                              const CubeType& y,
+                             const ColType& sDotY,
+                             MatType& searchDirection)
+{
+  // Dispatch to the fused single-pass-per-pair implementation for dense
+  // types, and to the expression-based implementation otherwise.
+  FusedSearchDirection(gradient, iterationNum, scalingFactor, s, y, sDotY,
+      searchDirection);
+}
+
+//! Fused two-loop recursion for dense types.
+template<typename MatType, typename CubeType, typename ColType>
+typename std::enable_if<arma::is_arma_type<MatType>::value, void>::type
+L_BFGS::FusedSearchDirection(const MatType& gradient,
+                             const size_t iterationNum,
+                             const double scalingFactor,
+                             const CubeType& s,
+                             const CubeType& y,
+                             const ColType& sDotY,
+                             MatType& searchDirection)
+{
+  typedef typename CubeType::elem_type CubeElemType;
+
+  const size_t limit = (numBasis > iterationNum) ? 0 :
+      (iterationNum - numBasis);
+  const size_t numPairs = iterationNum - limit;
+  const size_t n = gradient.n_elem;
+
+  if (numPairs == 0)
+  {
+    searchDirection = -scalingFactor * gradient;
+    return;
+  }
+
+  // Ring positions of the stored pairs, newest first, and the cached rho
+  // values; these match the ordering of the unfused implementation.
+  arma::Col<arma::uword> pos(numPairs);
+  arma::Col<CubeElemType> rho(numPairs);
+  arma::Col<CubeElemType> alpha(numPairs);
+  for (size_t k = 0; k < numPairs; ++k)
+  {
+    pos[k] = ((iterationNum - k) + (numBasis - 1)) % numBasis;
+
+    const CubeElemType sy = sDotY(pos[k]);
+    rho[k] = (sy != CubeElemType(0)) ? (CubeElemType) (1.0 / sy) :
+        CubeElemType(1);
+  }
+
+  // Start from this point.
+  searchDirection = gradient;
+  CubeElemType* q = searchDirection.memptr();
+
+  // The dot product of the newest pair with the starting direction; every
+  // later dot product is gathered while the previous pair's update is being
+  // written, so the recursion makes one pass over the vector per pair
+  // instead of two.
+  const CubeElemType* sNewest = s.slice(pos[0]).memptr();
+  CubeElemType d = 0;
+  for (size_t e = 0; e < n; ++e)
+    d += sNewest[e] * q[e];
+
+  // First recursion loop, newest to oldest.
+  for (size_t k = 0; k < numPairs; ++k)
+  {
+    alpha[k] = rho[k] * d;
+    const CubeElemType a = alpha[k];
+    const CubeElemType* yPtr = y.slice(pos[k]).memptr();
+
+    if (k + 1 < numPairs)
+    {
+      const CubeElemType* sNext = s.slice(pos[k + 1]).memptr();
+      CubeElemType dNext = 0;
+      for (size_t e = 0; e < n; ++e)
+      {
+        q[e] -= a * yPtr[e];
+        dNext += sNext[e] * q[e];
+      }
+      d = dNext;
+    }
+    else
+    {
+      // Oldest pair: fold in the initial Hessian scaling and gather the
+      // first dot product of the second loop (y_oldest . r) as well.
+      const CubeElemType scale = (CubeElemType) scalingFactor;
+      CubeElemType dNext = 0;
+      for (size_t e = 0; e < n; ++e)
+      {
+        q[e] = (q[e] - a * yPtr[e]) * scale;
+        dNext += yPtr[e] * q[e];
+      }
+      d = dNext;
+    }
+  }
+
+  // Second recursion loop, oldest to newest.
+  for (size_t k = numPairs; k-- > 0; )
+  {
+    const CubeElemType beta = rho[k] * d;
+    const CubeElemType c = alpha[k] - beta;
+    const CubeElemType* sPtr = s.slice(pos[k]).memptr();
+
+    if (k > 0)
+    {
+      const CubeElemType* yPrev = y.slice(pos[k - 1]).memptr();
+      CubeElemType dNext = 0;
+      for (size_t e = 0; e < n; ++e)
+      {
+        q[e] += c * sPtr[e];
+        dNext += yPrev[e] * q[e];
+      }
+      d = dNext;
+    }
+    else
+    {
+      // Newest pair: apply the final update and negate the result so that it
+      // is a descent direction, in the same pass.
+      for (size_t e = 0; e < n; ++e)
+        q[e] = -(q[e] + c * sPtr[e]);
+    }
+  }
+}
+
+//! Unfused two-loop recursion for types without contiguous element access.
+template<typename MatType, typename CubeType, typename ColType>
+typename std::enable_if<!arma::is_arma_type<MatType>::value, void>::type
+L_BFGS::FusedSearchDirection(const MatType& gradient,
+                             const size_t iterationNum,
+                             const double scalingFactor,
+                             const CubeType& s,
+                             const CubeType& y,
+                             const ColType& sDotY,
                              MatType& searchDirection)
 {
   // Start from this point.
@@ -142,7 +285,9 @@ void L_BFGS::SearchDirection(const MatType& gradient,
     const arma::Mat<CubeElemType>& sMat = s.slice(translatedPosition);
     const arma::Mat<CubeElemType>& yMat = y.slice(translatedPosition);
 
-    const CubeElemType tmp = arma::dot(yMat, sMat);
+    // The dot product s . y was cached when the pair was stored, so walking
+    // the ring costs no extra pass over the (possibly huge) history vectors.
+    const CubeElemType tmp = sDotY(translatedPosition);
 
     rho[iterationNum - i] = (tmp != CubeElemType(0)) ? (1.0 / tmp) :
         CubeElemType(1);
@@ -168,6 +313,137 @@ void L_BFGS::SearchDirection(const MatType& gradient,
   searchDirection *= -1;
 }
 
+/**
+ * Vector-free computation of the search direction (Chen et al., "Large-scale
+ * L-BFGS using MapReduce", 2014): instead of running the two-loop recursion
+ * on n-dimensional vectors, the direction is represented by its coefficients
+ * over the basis [s_0, ..., s_{m-1}, y_0, ..., y_{m-1}, gradient], and the
+ * recursion manipulates those 2m + 1 coefficients using only the Gram matrix
+ * of the basis.  The history vectors are then touched exactly twice per
+ * iteration: once to refresh the gradient row of the Gram matrix, and once to
+ * assemble the direction as a single linear combination.
+ *
+ * The parameters match SearchDirection(), plus the Gram matrix.
+ */
+template<typename MatType, typename CubeType, typename ColType,
+         typename GramType>
+void L_BFGS::VectorFreeSearchDirection(const MatType& gradient,
+                                       const size_t iterationNum,
+                                       const double scalingFactor,
+                                       const CubeType& s,
+                                       const CubeType& y,
+                                       const ColType& sDotY,
+                                       GramType& gram,
+                                       MatType& searchDirection)
+{
+  typedef typename CubeType::elem_type CubeElemType;
+
+  const size_t limit = (numBasis > iterationNum) ? 0 :
+      (iterationNum - numBasis);
+  const size_t numPairs = iterationNum - limit;
+  const size_t gIdx = 2 * numBasis; // Index of the gradient in the basis.
+
+  if (numPairs == 0)
+  {
+    searchDirection = -scalingFactor * gradient;
+    return;
+  }
+
+  // Ring positions of the stored pairs, newest first, and the cached rho
+  // values; these match the ordering of the two-loop implementations.
+  arma::Col<arma::uword> pos(numPairs);
+  arma::Col<CubeElemType> rho(numPairs);
+  arma::Col<CubeElemType> alpha(numPairs);
+  for (size_t k = 0; k < numPairs; ++k)
+  {
+    pos[k] = ((iterationNum - k) + (numBasis - 1)) % numBasis;
+
+    const CubeElemType sy = sDotY(pos[k]);
+    rho[k] = (sy != CubeElemType(0)) ? (CubeElemType) (1.0 / sy) :
+        CubeElemType(1);
+  }
+
+  // Refresh the gradient row of the Gram matrix; the pairwise entries were
+  // maintained incrementally by UpdateGramMatrix() and are still valid.
+  for (size_t k = 0; k < numPairs; ++k)
+  {
+    gram(pos[k], gIdx) = arma::dot(s.slice(pos[k]), gradient);
+    gram(numBasis + pos[k], gIdx) = arma::dot(y.slice(pos[k]), gradient);
+    gram(gIdx, pos[k]) = gram(pos[k], gIdx);
+    gram(gIdx, numBasis + pos[k]) = gram(numBasis + pos[k], gIdx);
+  }
+
+  // Coefficients of the running direction over the basis; initially the
+  // direction is the gradient itself.  Entries of unused ring positions stay
+  // zero, so the Gram rows of stale slices never contribute.
+  arma::Col<CubeElemType> delta(2 * numBasis + 1, arma::fill::zeros);
+  delta(gIdx) = 1;
+
+  // First recursion loop, newest to oldest: s_k . q is a (2m + 1)-term sum
+  // over the Gram row of s_k.
+  for (size_t k = 0; k < numPairs; ++k)
+  {
+    alpha[k] = rho[k] * arma::dot(gram.col(pos[k]), delta);
+    delta(numBasis + pos[k]) -= alpha[k];
+  }
+
+  // Fold in the initial Hessian scaling.
+  delta *= (CubeElemType) scalingFactor;
+
+  // Second recursion loop, oldest to newest.
+  for (size_t k = numPairs; k-- > 0; )
+  {
+    const CubeElemType beta = rho[k] *
+        arma::dot(gram.col(numBasis + pos[k]), delta);
+    delta(pos[k]) += alpha[k] - beta;
+  }
+
+  // Assemble the direction as one linear combination pass over the stored
+  // vectors, negated so that it is a descent direction.
+  searchDirection = delta(gIdx) * gradient;
+  for (size_t k = 0; k < numPairs; ++k)
+  {
+    searchDirection += delta(pos[k]) * s.slice(pos[k]);
+    searchDirection += delta(numBasis + pos[k]) * y.slice(pos[k]);
+  }
+  searchDirection *= -1;
+}
+
+/**
+ * Update the Gram matrix after a new pair was stored: one pass of dot
+ * products against the stored history recomputes the new pair's row and
+ * column, while all other entries are unchanged from previous iterations.
+ *
+ * The parameters match UpdateBasisSet(), plus the Gram matrix.
+ */
+template<typename CubeType, typename GramType>
+void L_BFGS::UpdateGramMatrix(const size_t iterationNum,
+                              const CubeType& s,
+                              const CubeType& y,
+                              GramType& gram)
+{
+  const size_t newPos = iterationNum % numBasis;
+
+  // Valid ring positions are always 0 .. numPairs - 1, since the ring fills
+  // from position 0 upwards.
+  const size_t numPairs = std::min(iterationNum + 1, numBasis);
+  for (size_t p = 0; p < numPairs; ++p)
+  {
+    gram(newPos, p) = arma::dot(s.slice(newPos), s.slice(p));
+    gram(newPos, numBasis + p) = arma::dot(s.slice(newPos), y.slice(p));
+    gram(numBasis + newPos, p) = arma::dot(y.slice(newPos), s.slice(p));
+    gram(numBasis + newPos, numBasis + p) =
+        arma::dot(y.slice(newPos), y.slice(p));
+
+    // Keep the matrix symmetric so rows and columns are interchangeable.
+    gram(p, newPos) = gram(newPos, p);
+    gram(numBasis + p, newPos) = gram(newPos, numBasis + p);
+    gram(p, numBasis + newPos) = gram(numBasis + newPos, p);
+    gram(numBasis + p, numBasis + newPos) =
+        gram(numBasis + newPos, numBasis + p);
+  }
+}
+
 /**
  * Update the y and s matrices, which store the differences between
  * the iterate and old iterate and the differences between the gradient and the
@@ -180,21 +456,33 @@ void L_BFGS::SearchDirection(const MatType& gradient,
  * @param oldGradient Gradient at last iteration point (oldIterate).
  * @param s Differences between the iterate and old iterate matrix.
  * @param y Differences between the gradient and the old gradient matrix.
+ * @param sDotY Cached dot products s_k . y_k of the stored pairs.
+ * @param yDotY Cached dot products y_k . y_k of the stored pairs.
  */
-template<typename MatType, typename GradType, typename CubeType>
+template<typename MatType, typename GradType, typename CubeType,
+         typename ColType>
 void L_BFGS::UpdateBasisSet(const size_t iterationNum,
                             const MatType& iterate,
                             const MatType& oldIterate,
                             const GradType& gradient,
                             const GradType& oldGradient,
                             CubeType& s,
-                            CubeType& y)
+                            CubeType& y,
+                            ColType& sDotY,
+                            ColType& yDotY)
 {
-  // Overwrite a certain position instead of pushing everything in the vector
-  // back one position.
+  // The basis set is a ring buffer: overwrite the oldest position instead of
+  // pushing everything in the vector back one position, so each iteration
+  // writes exactly one new pair no matter how large numBasis is.
   int overwritePos = iterationNum % numBasis;
   s.slice(overwritePos) = iterate - oldIterate;
   y.slice(overwritePos) = gradient - oldGradient;
+
+  // Cache the dot products of the new pair while it is still warm in cache;
+  // ChooseScalingFactor() and the two-loop recursion reuse these every
+  // iteration the pair stays in the ring.
+  sDotY(overwritePos) = arma::dot(s.slice(overwritePos), y.slice(overwritePos));
+  yDotY(overwritePos) = arma::dot(y.slice(overwritePos), y.slice(overwritePos));
 }
 
 /**
@@ -225,6 +513,24 @@ bool L_BFGS::LineSearch(FunctionType& function,
                         double& finalStepSize,
                         CallbackTypes&... callbacks)
 {
+  // If requested, bracket the minimizer and narrow the bracket with cubic
+  // interpolation instead of back-tracking.
+  if (cubicLineSearch)
+  {
+    WolfeLineSearch search(armijoConstant, wolfe, maxLineSearchTrials, 1.0,
+        minStep, maxStep);
+    return search.Search(*this, function, functionValue, iterate, gradient,
+        newIterateTmp, searchDirection, finalStepSize, terminate,
+        callbacks...);
+  }
+
+  // If requested, evaluate trial step sizes concurrently instead.
+  if (speculativeLineSearch)
+  {
+    return SpeculativeSearch(function, functionValue, iterate, gradient,
+        newIterateTmp, searchDirection, finalStepSize, callbacks...);
+  }
+
   // Default first step size of 1.0.
   double stepSize = 1.0;
   finalStepSize = 0.0; // Set only when we take the step.
@@ -238,14 +544,33 @@ bool L_BFGS::LineSearch(FunctionType& function,
   if ( (initialSearchDirectionDotGradient > 0.0)
     || (std::isfinite(initialSearchDirectionDotGradient) == false) )
   {
-    Warn << "L-BFGS line search direction is not a descent direction "
-        << "(terminating)!" << std::endl;
+    ENS_LOG_WARN("L-BFGS line search direction is not a descent direction "
+        << "(terminating)!" << std::endl);
     return false;
   }
 
   // Save the initial function value.
   ElemType initialFunctionValue = functionValue;
 
+  // Nonmonotone acceptance (Grippo, Lampariello & Lucidi, 1986): compare
+  // trial values against the maximum function value over the last
+  // NonmonotoneMemory() iterates instead of the current one.  On
+  // ill-conditioned problems this avoids the long back-tracking cascades
+  // that monotone descent triggers inside narrow curved valleys.
+  ElemType referenceValue = initialFunctionValue;
+  if (nonmonotoneMemory > 0)
+  {
+    nonmonotoneHistory[nonmonotoneNext] = (double) initialFunctionValue;
+    nonmonotoneNext = (nonmonotoneNext + 1) % nonmonotoneMemory;
+    if (nonmonotoneCount < nonmonotoneMemory)
+      ++nonmonotoneCount;
+    for (size_t j = 0; j < nonmonotoneCount; ++j)
+    {
+      referenceValue = std::max(referenceValue,
+          (ElemType) nonmonotoneHistory[j]);
+    }
+  }
+
   // Unit linear approximation to the decrease in function value.
   ElemType linearApproxFunctionValueDecrease = armijoConstant *
       initialSearchDirectionDotGradient;
@@ -270,7 +595,7 @@ bool L_BFGS::LineSearch(FunctionType& function,
 
     if (std::isnan(functionValue))
     {
-      Warn << "L-BFGS objective value is NaN (terminating)!" << std::endl;
+      ENS_LOG_WARN("L-BFGS objective value is NaN (terminating)!" << std::endl);
       return false;
     }
 
@@ -284,7 +609,12 @@ bool L_BFGS::LineSearch(FunctionType& function,
     }
     numIterations++;
 
-    if (functionValue > initialFunctionValue + stepSize *
+    // A callback requested termination; fall back to the best improving step
+    // seen so far, so the caller exits from a consistent iterate.
+    if (terminate)
+      break;
+
+    if (functionValue > referenceValue + stepSize *
         linearApproxFunctionValueDecrease)
     {
       width = dec;
@@ -332,6 +662,166 @@ bool L_BFGS::LineSearch(FunctionType& function,
   return true;
 }
 
+/**
+ * Speculative variant of the back-tracking line search: each round evaluates
+ * a ladder of candidate step sizes concurrently, then selects the largest
+ * candidate satisfying the Armijo and strong Wolfe conditions.  When the
+ * objective is expensive this trades a little wasted compute for much lower
+ * latency per L-BFGS iteration.
+ *
+ * The parameters match LineSearch().
+ *
+ * @return false if no step size is suitable, true otherwise.
+ */
+template<typename FunctionType,
+         typename ElemType,
+         typename MatType,
+         typename GradType,
+         typename... CallbackTypes>
+bool L_BFGS::SpeculativeSearch(FunctionType& function,
+                               ElemType& functionValue,
+                               MatType& iterate,
+                               GradType& gradient,
+                               MatType& newIterateTmp,
+                               const GradType& searchDirection,
+                               double& finalStepSize,
+                               CallbackTypes&... callbacks)
+{
+  finalStepSize = 0.0; // Set only when we take the step.
+
+  // The initial linear term approximation in the direction of the
+  // search direction.
+  const ElemType initialSearchDirectionDotGradient =
+      arma::dot(gradient, searchDirection);
+
+  // If it is not a descent direction, just report failure.
+  if ( (initialSearchDirectionDotGradient > 0.0)
+    || (std::isfinite(initialSearchDirectionDotGradient) == false) )
+  {
+    ENS_LOG_WARN("L-BFGS line search direction is not a descent direction "
+        << "(terminating)!" << std::endl);
+    return false;
+  }
+
+  // Save the initial function value.
+  const ElemType initialFunctionValue = functionValue;
+
+  // Unit linear approximation to the decrease in function value.
+  const ElemType linearApproxFunctionValueDecrease = armijoConstant *
+      initialSearchDirectionDotGradient;
+
+  // Step size scaling factors; these match the sequential search.
+  const double inc = 2.1;
+  const double dec = 0.5;
+
+  // Per-candidate state.  Each lane needs its own trial point and gradient, so
+  // memory use grows linearly with the speculation width.
+  const size_t lanes = std::max(std::min(speculationWidth,
+      maxLineSearchTrials), (size_t) 1);
+  std::vector<MatType> trialPoints(lanes, iterate);
+  std::vector<GradType> trialGradients(lanes, gradient);
+  std::vector<double> trialSteps(lanes, 1.0);
+  std::vector<ElemType> trialObjectives(lanes, ElemType(0));
+
+  double stepSize = 1.0;
+  size_t numIterations = 0;
+  double bestStepSize = 1.0;
+  ElemType bestObjective = std::numeric_limits<ElemType>::max();
+
+  while (true)
+  {
+    // Build the ladder of candidates for this round: one expansion step, then
+    // successively smaller back-tracking steps.  The expansion lane covers the
+    // case where the sequential search would have grown the step size.
+    trialSteps[0] = stepSize * inc;
+    for (size_t k = 1; k < lanes; ++k)
+      trialSteps[k] = trialSteps[k - 1] * ((k == 1) ? (dec / inc) : dec);
+
+    // Evaluate all candidates; EvaluateWithGradient() must be thread-safe.
+    ENS_PRAGMA_OMP_PARALLEL_FOR
+    for (ptrdiff_t k = 0; k < (ptrdiff_t) lanes; ++k)
+    {
+      trialPoints[k] = iterate;
+      trialPoints[k] += trialSteps[k] * searchDirection;
+      trialObjectives[k] = function.EvaluateWithGradient(trialPoints[k],
+          trialGradients[k]);
+    }
+
+    // Report the evaluations to the callbacks serially, in ladder order.
+    for (size_t k = 0; k < lanes; ++k)
+    {
+      terminate |= Callback::EvaluateWithGradient(*this, function,
+          trialPoints[k], trialObjectives[k], trialGradients[k], callbacks...);
+    }
+    numIterations += lanes;
+
+    // Select among the completed candidates: take the largest step satisfying
+    // both the Armijo condition and the strong Wolfe curvature condition.
+    for (size_t k = 0; k < lanes; ++k)
+    {
+      if (std::isnan(trialObjectives[k]))
+        continue;
+
+      if (trialObjectives[k] < bestObjective)
+      {
+        bestStepSize = trialSteps[k];
+        bestObjective = trialObjectives[k];
+      }
+
+      if (trialObjectives[k] > initialFunctionValue + trialSteps[k] *
+          linearApproxFunctionValueDecrease)
+        continue;
+
+      const ElemType searchDirectionDotGradient = arma::dot(trialGradients[k],
+          searchDirection);
+      if ((searchDirectionDotGradient < wolfe *
+          initialSearchDirectionDotGradient) ||
+          (searchDirectionDotGradient > -wolfe *
+          initialSearchDirectionDotGradient))
+        continue;
+
+      // Accept this candidate.
+      functionValue = trialObjectives[k];
+      gradient = std::move(trialGradients[k]);
+      iterate = std::move(trialPoints[k]);
+      finalStepSize = trialSteps[k];
+      return true;
+    }
+
+    // Continue the ladder below the smallest candidate of this round, unless
+    // the search budget or step size limits are exhausted, or a callback
+    // requested termination.
+    stepSize = trialSteps[lanes - 1] * dec;
+    if ((stepSize < minStep) || (numIterations >= maxLineSearchTrials) ||
+        terminate)
+      break;
+  }
+
+  // On termination, leave the iterate untouched (and skip the restoring
+  // re-evaluation below) so the caller exits from a consistent point.
+  if (terminate)
+    return false;
+
+  // No candidate satisfied the Wolfe conditions; fall back to the best
+  // objective seen, as the sequential search does when its trials run out.
+  // Earlier rounds overwrote the per-lane state, so re-evaluate the chosen
+  // step to restore its gradient.
+  if (std::isnan(bestObjective) ||
+      (bestObjective == std::numeric_limits<ElemType>::max()))
+  {
+    ENS_LOG_WARN("L-BFGS speculative line search found no finite objective "
+        << "(terminating)!" << std::endl);
+    return false;
+  }
+
+  newIterateTmp = iterate;
+  newIterateTmp += bestStepSize * searchDirection;
+  functionValue = function.EvaluateWithGradient(newIterateTmp, gradient);
+  iterate = newIterateTmp;
+  finalStepSize = bestStepSize;
+  return true;
+}
+
 /**
  * Use L_BFGS to optimize the given function, starting at the given iterate
  * point and performing no more than the specified number of maximum iterations.
@@ -379,6 +869,47 @@ L_BFGS::Optimize(FunctionType& function,
   arma::Cube<ElemType> s(rows, cols, numBasis);
   arma::Cube<ElemType> y(rows, cols, numBasis);
 
+  // Dot products of each stored (s, y) pair, cached when the pair is written
+  // so that the two-loop recursion does not recompute them every iteration.
+  arma::Col<ElemType> sDotY(numBasis);
+  arma::Col<ElemType> yDotY(numBasis);
+  sDotY.zeros();
+  yDotY.zeros();
+
+  // Gram matrix of the stored pairs and the gradient, maintained only when
+  // the vector-free direction computation is enabled (see VectorFree()).
+  arma::Mat<ElemType> gram;
+  if (vectorFree)
+    gram.zeros(2 * numBasis + 1, 2 * numBasis + 1);
+
+  // If memory retention is enabled, restore the pairs stored by the previous
+  // Optimize() call; numPairs keeps the ring positions consistent across
+  // calls.  Stale state (different problem size or memory size) is dropped.
+  typedef RetainedMemory<ElemType> RetainedMemoryType;
+  size_t numPairs = 0;
+  if (retainMemory && retainedMemory.Has<RetainedMemoryType>())
+  {
+    RetainedMemoryType& mem = retainedMemory.As<RetainedMemoryType>();
+    if (mem.s.n_rows == rows && mem.s.n_cols == cols &&
+        mem.s.n_slices == numBasis)
+    {
+      s = std::move(mem.s);
+      y = std::move(mem.y);
+      sDotY = std::move(mem.sDotY);
+      yDotY = std::move(mem.yDotY);
+      numPairs = mem.numPairs;
+
+      // The Gram matrix is not retained between calls; rebuild the pairwise
+      // entries of the restored pairs by replaying the incremental update.
+      if (vectorFree && numPairs > 0)
+      {
+        const size_t start = (numPairs > numBasis) ? (numPairs - numBasis) : 0;
+        for (size_t i = start; i < numPairs; ++i)
+          UpdateGramMatrix(i, s, y, gram);
+      }
+    }
+  }
+
   // The old iterate to be saved.
   BaseMatType oldIterate(iterate.n_rows, iterate.n_cols);
   oldIterate.zeros();
@@ -404,6 +935,15 @@ L_BFGS::Optimize(FunctionType& function,
 
   ElemType prevFunctionValue;
 
+  // Each Optimize() call starts with an empty nonmonotone reference window
+  // (see NonmonotoneMemory()); the ring buffer is filled by LineSearch().
+  if (nonmonotoneMemory > 0)
+  {
+    nonmonotoneHistory.assign(nonmonotoneMemory, 0.0);
+    nonmonotoneNext = 0;
+    nonmonotoneCount = 0;
+  }
+
   // The main optimization loop.
   Callback::BeginOptimization(*this, f, iterate, callbacks...);
   for (size_t itNum = 0; (optimizeUntilConvergence || (itNum != maxIterations))
@@ -419,39 +959,49 @@ L_BFGS::Optimize(FunctionType& function,
     // 12.4
     if (arma::norm(gradient, 2) < minGradientNorm)
     {
-      Info << "L-BFGS gradient norm too small (terminating successfully)."
-          << std::endl;
+      ENS_LOG_INFO("L-BFGS gradient norm too small (terminating successfully)."
+          << std::endl);
       break;
     }
 
     // Break if the objective is not a number.
     if (std::isnan(functionValue))
     {
-      Warn << "L-BFGS terminated with objective " << functionValue << "; "
-          << "are the objective and gradient functions implemented correctly?"
-          << std::endl;
+      ENS_LOG_WARN("L-BFGS terminated with objective " << functionValue
+          << "; are the objective and gradient functions implemented "
+          << "correctly?" << std::endl);
       break;
     }
 
     // Choose the scaling factor.
-    double scalingFactor = ChooseScalingFactor(itNum, gradient, s, y);
+    double scalingFactor = ChooseScalingFactor(numPairs, gradient, sDotY,
+        yDotY);
     if (scalingFactor == 0.0)
     {
-      Info << "L-BFGS scaling factor computed as 0 (terminating successfully)."
-          << std::endl;
+      ENS_LOG_INFO("L-BFGS scaling factor computed as 0 (terminating "
+          << "successfully)." << std::endl);
       break;
     }
 
     if (std::isfinite(scalingFactor) == false)
       {
-      Warn << "L-BFGS scaling factor is not finite.  Stopping optimization."
-           << std::endl;
+      ENS_LOG_WARN("L-BFGS scaling factor is not finite.  Stopping "
+          << "optimization." << std::endl);
       break;
       }
 
     // Build an approximation to the Hessian and choose the search
     // direction for the current iteration.
-    SearchDirection(gradient, itNum, scalingFactor, s, y, searchDirection);
+    if (vectorFree)
+    {
+      VectorFreeSearchDirection(gradient, numPairs, scalingFactor, s, y,
+          sDotY, gram, searchDirection);
+    }
+    else
+    {
+      SearchDirection(gradient, numPairs, scalingFactor, s, y, sDotY,
+          searchDirection);
+    }
 
     // Save the old iterate and the gradient before stepping.
     oldIterate = iterate;
@@ -461,7 +1011,11 @@ L_BFGS::Optimize(FunctionType& function,
     if (!LineSearch(f, functionValue, iterate, gradient, newIterateTmp,
         searchDirection, stepSize, callbacks...))
     {
-      Warn << "Line search failed.  Stopping optimization." << std::endl;
+      if (!terminate)
+      {
+        ENS_LOG_WARN("Line search failed.  Stopping optimization."
+            << std::endl);
+      }
       break; // The line search failed; nothing else to try.
     }
 
@@ -469,8 +1023,8 @@ L_BFGS::Optimize(FunctionType& function,
     // In this case we terminate successfully.
     if (stepSize == 0.0)
     {
-      Info << "L-BFGS step size of 0 (terminating successfully)."
-          << std::endl;
+      ENS_LOG_INFO("L-BFGS step size of 0 (terminating successfully)."
+          << std::endl);
       break;
     }
 
@@ -481,17 +1035,34 @@ L_BFGS::Optimize(FunctionType& function,
         (ElemType) 1.0);
     if ((prevFunctionValue - functionValue) / denom <= factr)
     {
-      Info << "L-BFGS function value stable (terminating successfully)."
-          << std::endl;
+      ENS_LOG_INFO("L-BFGS function value stable (terminating successfully)."
+          << std::endl);
       break;
     }
 
     // Overwrite an old basis set.
-    UpdateBasisSet(itNum, iterate, oldIterate, gradient, oldGradient, s, y);
+    UpdateBasisSet(numPairs, iterate, oldIterate, gradient, oldGradient, s, y,
+        sDotY, yDotY);
+    if (vectorFree)
+      UpdateGramMatrix(numPairs, s, y, gram);
+    ++numPairs;
 
     terminate |= Callback::StepTaken(*this, f, iterate, callbacks...);
   } // End of the optimization loop.
 
+  // Store the memory pairs for the next Optimize() call.
+  if (retainMemory)
+  {
+    if (!retainedMemory.Has<RetainedMemoryType>())
+      retainedMemory.Emplace<RetainedMemoryType>();
+    RetainedMemoryType& mem = retainedMemory.As<RetainedMemoryType>();
+    mem.s = std::move(s);
+    mem.y = std::move(y);
+    mem.sDotY = std::move(sDotY);
+    mem.yDotY = std::move(yDotY);
+    mem.numPairs = numPairs;
+  }
+
   Callback::EndOptimization(*this, f, iterate, callbacks...);
   return functionValue;
 }
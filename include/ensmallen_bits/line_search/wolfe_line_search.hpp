@@ -0,0 +1,148 @@
+/**
+ * @file wolfe_line_search.hpp
+ * @author Ryan Curtin
+ *
+ * A strong-Wolfe line search with bracketing and cubic interpolation, shared
+ * by the gradient-based optimizers.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_LINE_SEARCH_WOLFE_LINE_SEARCH_HPP
+#define ENSMALLEN_LINE_SEARCH_WOLFE_LINE_SEARCH_HPP
+
+namespace ens {
+
+/**
+ * A line search that finds a step size satisfying the strong Wolfe conditions
+ *
+ * \f[
+ * f(x + \alpha d) \le f(x) + c_1 \alpha d^T \nabla f(x), \qquad
+ * | d^T \nabla f(x + \alpha d) | \le -c_2 d^T \nabla f(x),
+ * \f]
+ *
+ * using the bracketing strategy of Nocedal and Wright (Algorithms 3.5 and
+ * 3.6): the step is expanded until the minimizer is bracketed, then the
+ * bracket is narrowed with cubic interpolation of the function and derivative
+ * values at its endpoints.  Because every trial evaluation contributes either
+ * a bracket endpoint or an interpolation point, far fewer evaluations are
+ * typically needed than with simple back-tracking.
+ *
+ * The search is a reusable component: any optimizer that has a descent
+ * direction and a function with EvaluateWithGradient() can call Search() to
+ * advance its iterate.  If the evaluation budget runs out before the Wolfe
+ * conditions are satisfied, the best improving step seen is taken instead.
+ */
+class WolfeLineSearch
+{
+ public:
+  /**
+   * Construct the line search with the given parameters.
+   *
+   * @param armijoConstant Controls the accuracy of the sufficient decrease
+   *     (Armijo) condition.
+   * @param wolfe Parameter for the curvature (Wolfe) condition.
+   * @param maxTrials The maximum number of function evaluations (before
+   *     giving up).
+   * @param initialStep The first trial step size.
+   * @param minStep The minimum step of the line search.
+   * @param maxStep The maximum step of the line search.
+   */
+  WolfeLineSearch(const double armijoConstant = 1e-4,
+                  const double wolfe = 0.9,
+                  const size_t maxTrials = 20,
+                  const double initialStep = 1.0,
+                  const double minStep = 1e-20,
+                  const double maxStep = 1e20);
+
+  /**
+   * Search along the given descent direction for a step size satisfying the
+   * strong Wolfe conditions, and advance the iterate by that step.  On entry,
+   * functionValue and gradient must hold the function value and gradient at
+   * the iterate; on success they hold the value and gradient at the new
+   * iterate.  Every evaluation is reported to the callbacks on behalf of the
+   * calling optimizer.
+   *
+   * @param optimizer The optimizer on whose behalf the search runs (passed to
+   *     the callbacks).
+   * @param function Function to optimize.
+   * @param functionValue Value of the function at the initial point.
+   * @param iterate The initial point to begin the line search from.
+   * @param gradient The gradient at the initial point.
+   * @param newIterateTmp Working buffer for trial points.
+   * @param searchDirection A vector specifying the search direction.
+   * @param finalStepSize The resulting step size used (0 if no step).
+   * @param terminate Set to true if a callback requested termination.
+   * @param callbacks Callback functions.
+   *
+   * @return false if no step size is suitable, true otherwise.
+   */
+  template<typename OptimizerType,
+           typename FunctionType,
+           typename ElemType,
+           typename MatType,
+           typename GradType,
+           typename... CallbackTypes>
+  bool Search(OptimizerType& optimizer,
+              FunctionType& function,
+              ElemType& functionValue,
+              MatType& iterate,
+              GradType& gradient,
+              MatType& newIterateTmp,
+              const GradType& searchDirection,
+              double& finalStepSize,
+              bool& terminate,
+              CallbackTypes&... callbacks);
+
+  //! Get the Armijo condition constant.
+  double ArmijoConstant() const { return armijoConstant; }
+  //! Modify the Armijo condition constant.
+  double& ArmijoConstant() { return armijoConstant; }
+
+  //! Get the Wolfe parameter.
+  double Wolfe() const { return wolfe; }
+  //! Modify the Wolfe parameter.
+  double& Wolfe() { return wolfe; }
+
+  //! Get the maximum number of function evaluations.
+  size_t MaxTrials() const { return maxTrials; }
+  //! Modify the maximum number of function evaluations.
+  size_t& MaxTrials() { return maxTrials; }
+
+  //! Get the first trial step size.
+  double InitialStep() const { return initialStep; }
+  //! Modify the first trial step size.
+  double& InitialStep() { return initialStep; }
+
+  //! Return the minimum step size.
+  double MinStep() const { return minStep; }
+  //! Modify the minimum step size.
+  double& MinStep() { return minStep; }
+
+  //! Return the maximum step size.
+  double MaxStep() const { return maxStep; }
+  //! Modify the maximum step size.
+  double& MaxStep() { return maxStep; }
+
+ private:
+  //! Parameter for the sufficient decrease (Armijo) condition.
+  double armijoConstant;
+  //! Parameter for the curvature (Wolfe) condition.
+  double wolfe;
+  //! Maximum number of function evaluations.
+  size_t maxTrials;
+  //! The first trial step size.
+  double initialStep;
+  //! Minimum step size.
+  double minStep;
+  //! Maximum step size.
+  double maxStep;
+};
+
+} // namespace ens
+
+#include "wolfe_line_search_impl.hpp"
+
+#endif
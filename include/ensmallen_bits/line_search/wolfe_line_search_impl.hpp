@@ -0,0 +1,269 @@
+/**
+ * @file wolfe_line_search_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the strong-Wolfe cubic-interpolation line search.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_LINE_SEARCH_WOLFE_LINE_SEARCH_IMPL_HPP
+#define ENSMALLEN_LINE_SEARCH_WOLFE_LINE_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "wolfe_line_search.hpp"
+
+namespace ens {
+
+inline WolfeLineSearch::WolfeLineSearch(const double armijoConstant,
+                                        const double wolfe,
+                                        const size_t maxTrials,
+                                        const double initialStep,
+                                        const double minStep,
+                                        const double maxStep) :
+    armijoConstant(armijoConstant),
+    wolfe(wolfe),
+    maxTrials(maxTrials),
+    initialStep(initialStep),
+    minStep(minStep),
+    maxStep(maxStep)
+{ /* Nothing to do. */ }
+
+template<typename OptimizerType,
+         typename FunctionType,
+         typename ElemType,
+         typename MatType,
+         typename GradType,
+         typename... CallbackTypes>
+bool WolfeLineSearch::Search(OptimizerType& optimizer,
+                             FunctionType& function,
+                             ElemType& functionValue,
+                             MatType& iterate,
+                             GradType& gradient,
+                             MatType& newIterateTmp,
+                             const GradType& searchDirection,
+                             double& finalStepSize,
+                             bool& terminate,
+                             CallbackTypes&... callbacks)
+{
+  finalStepSize = 0.0; // Set only when we take the step.
+
+  // The function value and directional derivative at the starting point.
+  const ElemType phi0 = functionValue;
+  const ElemType dPhi0 = arma::dot(gradient, searchDirection);
+
+  // If it is not a descent direction, just report failure.
+  if ((dPhi0 > 0.0) || (std::isfinite(dPhi0) == false))
+  {
+    Warn << "Line search direction is not a descent direction (terminating)!"
+        << std::endl;
+    return false;
+  }
+
+  // The best improving step seen so far, used as a fallback when the budget
+  // runs out before the Wolfe conditions are satisfied.
+  double bestStepSize = 0.0;
+  ElemType bestObjective = phi0;
+
+  size_t numTrials = 0;
+
+  // Function value and directional derivative at the current trial step.
+  ElemType phi = phi0;
+  ElemType dPhi = dPhi0;
+
+  // Bracket endpoints; the endpoints are ordered by function value (lo is the
+  // better one), not by step size.  These are set by the bracketing phase.
+  bool bracketed = false;
+  double alphaLo = 0.0, alphaHi = 0.0;
+  ElemType phiLo = phi0, phiHi = phi0;
+  ElemType dPhiLo = dPhi0, dPhiHi = dPhi0;
+
+  // Bracketing phase: expand the step until the sufficient decrease condition
+  // fails or the derivative turns non-negative, either of which brackets a
+  // strong-Wolfe point between the previous and current steps.
+  double alphaPrev = 0.0;
+  ElemType phiPrev = phi0;
+  ElemType dPhiPrev = dPhi0;
+  double alpha = std::min(std::max(initialStep, minStep), maxStep);
+
+  while (!terminate && (numTrials < maxTrials))
+  {
+    newIterateTmp = iterate;
+    newIterateTmp += alpha * searchDirection;
+    phi = function.EvaluateWithGradient(newIterateTmp, gradient);
+    terminate |= Callback::EvaluateWithGradient(optimizer, function,
+        newIterateTmp, phi, gradient, callbacks...);
+    numTrials++;
+
+    if (std::isnan(phi))
+    {
+      // The step overshot into a region where the function is not defined;
+      // back off, as the back-tracking search would.
+      alpha *= 0.5;
+      if (alpha < minStep)
+        break;
+      continue;
+    }
+
+    dPhi = arma::dot(gradient, searchDirection);
+
+    if (phi < bestObjective)
+    {
+      bestStepSize = alpha;
+      bestObjective = phi;
+    }
+
+    if ((phi > phi0 + armijoConstant * alpha * dPhi0) ||
+        ((numTrials > 1) && (phi >= phiPrev)))
+    {
+      // The function stopped decreasing, so the minimizer is bracketed
+      // between the previous and current steps.
+      alphaLo = alphaPrev; phiLo = phiPrev; dPhiLo = dPhiPrev;
+      alphaHi = alpha; phiHi = phi; dPhiHi = dPhi;
+      bracketed = true;
+      break;
+    }
+
+    if (std::abs(dPhi) <= -wolfe * dPhi0)
+    {
+      // The strong Wolfe conditions hold; accept the step.
+      functionValue = phi;
+      iterate = newIterateTmp;
+      finalStepSize = alpha;
+      return true;
+    }
+
+    if (dPhi >= 0)
+    {
+      // The derivative turned non-negative, so the minimizer is behind us;
+      // the current step has the better function value and becomes lo.
+      alphaLo = alpha; phiLo = phi; dPhiLo = dPhi;
+      alphaHi = alphaPrev; phiHi = phiPrev; dPhiHi = dPhiPrev;
+      bracketed = true;
+      break;
+    }
+
+    // Sufficient decrease with a still-negative derivative: the minimizer is
+    // further out, so expand the step.
+    alphaPrev = alpha; phiPrev = phi; dPhiPrev = dPhi;
+    if (alpha >= maxStep)
+      break;
+    alpha = std::min(2.0 * alpha, maxStep);
+  }
+
+  // Zoom phase: narrow the bracket with cubic interpolation of the function
+  // and derivative values at its endpoints (Nocedal & Wright, eq. 3.59),
+  // falling back to bisection whenever the interpolant is untrustworthy.
+  while (bracketed && !terminate && (numTrials < maxTrials))
+  {
+    const double d1 = dPhiLo + dPhiHi -
+        3.0 * (phiLo - phiHi) / (alphaLo - alphaHi);
+    const double disc = d1 * d1 - (double) dPhiLo * (double) dPhiHi;
+
+    double alphaJ;
+    if (disc >= 0.0)
+    {
+      const double d2 = ((alphaHi > alphaLo) ? 1.0 : -1.0) * std::sqrt(disc);
+      alphaJ = alphaHi - (alphaHi - alphaLo) *
+          ((dPhiHi + d2 - d1) / (dPhiHi - dPhiLo + 2.0 * d2));
+    }
+    else
+    {
+      alphaJ = 0.5 * (alphaLo + alphaHi);
+    }
+
+    // Keep the trial step well inside the bracket, so that each round
+    // shrinks the bracket by a guaranteed fraction.
+    const double lower = std::min(alphaLo, alphaHi);
+    const double upper = std::max(alphaLo, alphaHi);
+    const double margin = 0.1 * (upper - lower);
+    if (!(alphaJ >= lower + margin) || !(alphaJ <= upper - margin))
+      alphaJ = 0.5 * (alphaLo + alphaHi);
+
+    newIterateTmp = iterate;
+    newIterateTmp += alphaJ * searchDirection;
+    phi = function.EvaluateWithGradient(newIterateTmp, gradient);
+    terminate |= Callback::EvaluateWithGradient(optimizer, function,
+        newIterateTmp, phi, gradient, callbacks...);
+    numTrials++;
+
+    if (std::isnan(phi))
+    {
+      // Treat an undefined trial point as a bad endpoint, biasing the
+      // bracket back toward lo.
+      alphaHi = alphaJ;
+      phiHi = std::numeric_limits<ElemType>::max();
+      dPhiHi = 0;
+      continue;
+    }
+
+    dPhi = arma::dot(gradient, searchDirection);
+
+    if (phi < bestObjective)
+    {
+      bestStepSize = alphaJ;
+      bestObjective = phi;
+    }
+
+    if ((phi > phi0 + armijoConstant * alphaJ * dPhi0) || (phi >= phiLo))
+    {
+      // The trial point is not better than lo; it becomes the new hi.
+      alphaHi = alphaJ; phiHi = phi; dPhiHi = dPhi;
+    }
+    else
+    {
+      if (std::abs(dPhi) <= -wolfe * dPhi0)
+      {
+        // The strong Wolfe conditions hold; accept the step.
+        functionValue = phi;
+        iterate = newIterateTmp;
+        finalStepSize = alphaJ;
+        return true;
+      }
+
+      // The trial point is the new lo; if its derivative points away from
+      // the old hi, the minimizer is between the trial point and the old lo.
+      if (dPhi * (alphaHi - alphaLo) >= 0)
+      {
+        alphaHi = alphaLo; phiHi = phiLo; dPhiHi = dPhiLo;
+      }
+      alphaLo = alphaJ; phiLo = phi; dPhiLo = dPhi;
+    }
+
+    // Give up once the bracket has degenerated.
+    if (std::abs(alphaHi - alphaLo) < minStep)
+      break;
+  }
+
+  // A callback requested termination; leave the iterate untouched (and skip
+  // the restoring re-evaluation below) so the caller exits from a consistent
+  // point.
+  if (terminate)
+    return false;
+
+  // The Wolfe conditions were never satisfied within the evaluation budget;
+  // fall back to the best improving step seen, if there was one.
+  if ((bestStepSize == 0.0) ||
+      (std::isfinite((double) bestObjective) == false))
+  {
+    Warn << "Line search found no improving step (terminating)!" << std::endl;
+    return false;
+  }
+
+  // The last evaluation was not necessarily at the best step, so re-evaluate
+  // there to restore the function value and gradient.
+  newIterateTmp = iterate;
+  newIterateTmp += bestStepSize * searchDirection;
+  functionValue = function.EvaluateWithGradient(newIterateTmp, gradient);
+  terminate |= Callback::EvaluateWithGradient(optimizer, function,
+      newIterateTmp, functionValue, gradient, callbacks...);
+  iterate = newIterateTmp;
+  finalStepSize = bestStepSize;
+  return true;
+}
+
+} // namespace ens
+
+#endif
@@ -70,13 +70,27 @@ class NullOutStream
   NullOutStream& operator<<(const T&) { return *this; }
 };
 
-#ifdef ENS_PRINT_INFO
+// The compile-time log level: 0 prints nothing, 1 prints warnings, 2 prints
+// warnings and informational messages.  If ENS_LOG_LEVEL is not set, it is
+// derived from the older ENS_PRINT_INFO / ENS_PRINT_WARN switches, which
+// remain supported.
+#if !defined(ENS_LOG_LEVEL)
+  #if defined(ENS_PRINT_INFO)
+    #define ENS_LOG_LEVEL 2
+  #elif defined(ENS_PRINT_WARN)
+    #define ENS_LOG_LEVEL 1
+  #else
+    #define ENS_LOG_LEVEL 0
+  #endif
+#endif
+
+#if (ENS_LOG_LEVEL >= 2)
   static std::ostream& Info = arma::get_cout_stream();
 #else
   static NullOutStream Info;
 #endif
 
-#ifdef ENS_PRINT_WARN
+#if (ENS_LOG_LEVEL >= 1)
   static std::ostream& Warn = arma::get_cerr_stream();
 #else
   static NullOutStream Warn;
@@ -84,4 +98,24 @@ class NullOutStream
 
 } // namespace ens
 
+// The streams above keep existing `Info << ...` call sites working, but their
+// operands are evaluated even when the output is discarded (NullOutStream only
+// discards the already-computed values).  The statement macros below compile
+// to empty statements at disabled levels, so their operands are never
+// evaluated and hot loops pay nothing for logging.  The argument is a stream
+// expression, including any manipulators:
+//
+//   ENS_LOG_WARN("step " << i << " failed" << std::endl);
+#if (ENS_LOG_LEVEL >= 2)
+  #define ENS_LOG_INFO(msg) do { ens::Info << msg; } while (false)
+#else
+  #define ENS_LOG_INFO(msg) do { } while (false)
+#endif
+
+#if (ENS_LOG_LEVEL >= 1)
+  #define ENS_LOG_WARN(msg) do { ens::Warn << msg; } while (false)
+#else
+  #define ENS_LOG_WARN(msg) do { } while (false)
+#endif
+
 #endif
@@ -19,6 +19,37 @@
 
 namespace ens {
 
+//! Fused in-place slow-weight interpolation for dense types: a single pass
+//! over the two preallocated buffers computes x += stepSize * (model - x)
+//! without forming the difference as a temporary.
+template<typename MatType>
+typename std::enable_if<!arma::is_arma_sparse_type<MatType>::value, void>::type
+LookaheadInterpolate(MatType& iterate,
+                     const MatType& iterateModel,
+                     const double stepSize)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  const ElemType s = (ElemType) stepSize;
+  ElemType* itMem = iterate.memptr();
+  const ElemType* modelMem = iterateModel.memptr();
+
+  const size_t n = iterate.n_elem;
+  for (size_t j = 0; j < n; ++j)
+    itMem[j] += s * (modelMem[j] - itMem[j]);
+}
+
+//! Sparse types have no contiguous memory to walk, so keep the
+//! expression-based interpolation.
+template<typename MatType>
+typename std::enable_if<arma::is_arma_sparse_type<MatType>::value, void>::type
+LookaheadInterpolate(MatType& iterate,
+                     const MatType& iterateModel,
+                     const double stepSize)
+{
+  iterate += stepSize * (iterateModel - iterate);
+}
+
 template<typename BaseOptimizerType, typename DecayPolicyType>
 inline Lookahead<BaseOptimizerType, DecayPolicyType>::Lookahead(
     const double stepSize,
@@ -126,27 +157,33 @@ Lookahead<BaseOptimizerType, DecayPolicyType>::Optimize(
   // Initialize the decay policy if needed.
   if (!isInitialized || !instDecayPolicy.Has<InstDecayPolicyType>())
   {
-    instDecayPolicy.Clean();
-    instDecayPolicy.Set<InstDecayPolicyType>(
-        new InstDecayPolicyType(decayPolicy));
+    instDecayPolicy.Emplace<InstDecayPolicyType>(decayPolicy);
     isInitialized = true;
   }
 
+  // Resolve the concrete policy type once, so the typeid check in As<T>()
+  // stays out of the loop below.
+  InstDecayPolicyType& instDecay = instDecayPolicy.As<InstDecayPolicyType>();
+
+  // The fast weights, preallocated once; each burst starts from the slow
+  // weights and the inner optimizer's update policy state persists across
+  // bursts through the ResetPolicy() override above.
+  BaseMatType iterateModel(iterate.n_rows, iterate.n_cols);
+
   // Now iterate!
   Callback::BeginOptimization(*this, f, iterate, callbacks...);
   const size_t actualMaxIterations = (maxIterations == 0) ?
       std::numeric_limits<size_t>::max() : maxIterations;
   for (size_t i = 0; i < actualMaxIterations && !terminate; i++)
   {
-    BaseMatType iterateModel = iterate;
+    iterateModel = iterate;
 
     overallObjective = baseOptimizer.Optimize(f, iterateModel,
         callbacks...);
 
     // Now update the learning rate if requested by the user, note we pass the
     // latest inner model coordinates instead of the gradient.
-    instDecayPolicy.As<InstDecayPolicyType>().Update(iterate, stepSize,
-        iterateModel);
+    instDecay.Update(iterate, stepSize, iterateModel);
 
     if (std::isnan(overallObjective) || std::isinf(overallObjective))
     {
@@ -169,7 +206,7 @@ Lookahead<BaseOptimizerType, DecayPolicyType>::Optimize(
       return overallObjective;
     }
 
-    iterate += stepSize * (iterateModel - iterate);
+    LookaheadInterpolate(iterate, iterateModel, stepSize);
     terminate |= Callback::StepTaken(*this, f, iterate, callbacks...);
 
     // Save the current objective.
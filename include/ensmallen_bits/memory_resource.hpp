@@ -0,0 +1,275 @@
+/**
+ * @file memory_resource.hpp
+ * @author Marcus Edel
+ *
+ * Opt-in pluggable memory resources for the optimizer-internal allocations.
+ * The MemoryResource interface, the PoolMemoryResource arena, and the
+ * ScopedMemoryResource guard are always available; when ENS_MEMORY_RESOURCE
+ * is defined before ensmallen.hpp is included, Armadillo's memory allocation
+ * is additionally routed through the thread-local current resource, so every
+ * internal optimizer buffer (gradients, moment state, population matrices,
+ * history cubes) on a thread running inside a ScopedMemoryResource comes
+ * from the installed arena instead of the global heap.  Per-Optimize()
+ * arenas make setup/teardown a handful of pointer bumps and keep thousands
+ * of concurrent optimizations from contending in the allocator.
+ *
+ * Like allocation_tracking.hpp, this header must be included before
+ * <armadillo>, because the hooks are installed via Armadillo's
+ * ARMA_ALIEN_MEM_ALLOC_FUNCTION mechanism, which is read when Armadillo
+ * itself is compiled in.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_MEMORY_RESOURCE_HPP
+#define ENSMALLEN_MEMORY_RESOURCE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace ens {
+
+/**
+ * Abstract interface for a user-supplied memory resource.  Implementations
+ * must be safe to call from the thread that installed them (see
+ * ScopedMemoryResource); they do not need to be thread-safe across threads,
+ * since each thread consults only its own installed resource.
+ *
+ * A resource must outlive every allocation made from it: matrices handed
+ * back to the caller from a resource-scoped Optimize() call still free
+ * through the resource that produced them.
+ */
+class MemoryResource
+{
+ public:
+  //! Virtual destructor so resources can be deleted through the interface.
+  virtual ~MemoryResource() { }
+
+  /**
+   * Allocate nBytes bytes, suitably aligned for any fundamental type.
+   *
+   * @param nBytes Number of bytes to allocate.
+   */
+  virtual void* Allocate(const size_t nBytes) = 0;
+
+  /**
+   * Release an allocation previously returned by Allocate().
+   *
+   * @param mem The allocation to release.
+   * @param nBytes The size the allocation was made with.
+   */
+  virtual void Deallocate(void* mem, const size_t nBytes) = 0;
+};
+
+//! The memory resource installed on the calling thread, or null if
+//! allocations should go to the global heap.  Install a resource with the
+//! ScopedMemoryResource guard rather than assigning here directly.
+inline MemoryResource*& CurrentMemoryResource()
+{
+  static thread_local MemoryResource* current = nullptr;
+  return current;
+}
+
+/**
+ * RAII guard that installs a memory resource on the calling thread for the
+ * duration of a scope, restoring the previously installed resource (usually
+ * none) on destruction.  Typical use wraps a single Optimize() call:
+ *
+ * @code
+ * ens::PoolMemoryResource pool;
+ * {
+ *   ens::ScopedMemoryResource guard(pool);
+ *   optimizer.Optimize(f, coordinates);
+ * }
+ * @endcode
+ *
+ * Note that `coordinates` above is allocated by the caller, outside the
+ * scope, so it remains heap-backed and survives the pool.
+ */
+class ScopedMemoryResource
+{
+ public:
+  /**
+   * Install the given resource on the calling thread.
+   *
+   * @param resource The resource to install; must outlive the guard and
+   *     every allocation made while it is installed.
+   */
+  ScopedMemoryResource(MemoryResource& resource) :
+      previous(CurrentMemoryResource())
+  {
+    CurrentMemoryResource() = &resource;
+  }
+
+  //! Restore the previously installed resource.
+  ~ScopedMemoryResource()
+  {
+    CurrentMemoryResource() = previous;
+  }
+
+ private:
+  //! Guards are scope markers; copying one would corrupt the restore chain.
+  ScopedMemoryResource(const ScopedMemoryResource&);
+  ScopedMemoryResource& operator=(const ScopedMemoryResource&);
+
+  //! The resource to restore on destruction.
+  MemoryResource* previous;
+};
+
+/**
+ * A monotonic arena: allocations bump a pointer through geometrically
+ * growing malloc()ed blocks, Deallocate() is a no-op, and all memory is
+ * returned at once by Release() or the destructor.  This is the right shape
+ * for per-Optimize() scratch memory, where every buffer dies with the call:
+ * allocation is a pointer bump, teardown is a handful of free()s regardless
+ * of how many matrices the optimizer churned through, and nothing touches
+ * the global allocator in between.
+ *
+ * The arena only grows while it is live; size the initial block near the
+ * expected peak (problem dimension times history/population size) to keep
+ * the block count at one.
+ */
+class PoolMemoryResource : public MemoryResource
+{
+ public:
+  /**
+   * Construct an empty pool; no memory is reserved until the first
+   * allocation.
+   *
+   * @param initialBlockSize Size of the first block, in bytes; subsequent
+   *     blocks double.
+   */
+  PoolMemoryResource(const size_t initialBlockSize = 1048576) :
+      nextBlockSize(initialBlockSize),
+      cursor(nullptr),
+      remaining(0),
+      bytesAllocated(0)
+  { /* Nothing to do here. */ }
+
+  //! Return all blocks to the heap.
+  ~PoolMemoryResource() { Release(); }
+
+  /**
+   * Bump-allocate nBytes bytes from the current block, starting a new block
+   * if it does not fit.
+   *
+   * @param nBytes Number of bytes to allocate.
+   */
+  void* Allocate(const size_t nBytes)
+  {
+    const size_t aligned = Align(nBytes);
+    if (aligned > remaining)
+    {
+      // Oversized requests get a block of their own size, so they never
+      // force the doubling sequence to overshoot.
+      const size_t blockSize = std::max(aligned, nextBlockSize);
+      char* block = (char*) std::malloc(blockSize);
+      if (block == nullptr)
+        throw std::bad_alloc();
+
+      blocks.push_back(block);
+      cursor = block;
+      remaining = blockSize;
+      if (blockSize == nextBlockSize)
+        nextBlockSize *= 2;
+    }
+
+    void* mem = cursor;
+    cursor += aligned;
+    remaining -= aligned;
+    bytesAllocated += aligned;
+    return mem;
+  }
+
+  //! No-op: a monotonic arena reclaims everything at Release() time.
+  void Deallocate(void* /* mem */, const size_t /* nBytes */) { }
+
+  //! Return all blocks to the heap and reset the pool for reuse.  Every
+  //! allocation made from the pool must be dead before calling this.
+  void Release()
+  {
+    for (size_t i = 0; i < blocks.size(); ++i)
+      std::free(blocks[i]);
+    blocks.clear();
+    cursor = nullptr;
+    remaining = 0;
+    bytesAllocated = 0;
+  }
+
+  //! Get the number of bytes handed out since construction or the last
+  //! Release(); useful for sizing the initial block of the next pool.
+  size_t BytesAllocated() const { return bytesAllocated; }
+
+ private:
+  //! Round a request up so every returned pointer stays maximally aligned.
+  static size_t Align(const size_t nBytes)
+  {
+    const size_t a = alignof(std::max_align_t);
+    return (nBytes + a - 1) & ~(a - 1);
+  }
+
+  //! All blocks acquired so far; freed en masse by Release().
+  std::vector<char*> blocks;
+  //! Size of the next regular block.
+  size_t nextBlockSize;
+  //! Bump pointer into the current block.
+  char* cursor;
+  //! Bytes left in the current block.
+  size_t remaining;
+  //! Total (aligned) bytes handed out.
+  size_t bytesAllocated;
+};
+
+} // namespace ens
+
+#if defined(ENS_MEMORY_RESOURCE)
+
+// Each hooked allocation is prefixed with a header recording the resource
+// it came from (null for the heap), so a matrix that outlives the scope it
+// was allocated in still frees through the right resource.  The header is
+// one max_align_t unit, preserving the alignment of the user block.
+
+//! Routing replacement for Armadillo's memory allocation function.
+inline void* ens_resource_alloc(const size_t nBytes)
+{
+#if defined(ENS_TRACK_ALLOCATIONS)
+  ens::AllocationTracker::Record(nBytes);
+#endif
+  const size_t header = alignof(std::max_align_t);
+  ens::MemoryResource* resource = ens::CurrentMemoryResource();
+  void* mem = (resource != nullptr) ?
+      resource->Allocate(nBytes + header) : std::malloc(nBytes + header);
+  if (mem == nullptr)
+    return nullptr;
+  *(ens::MemoryResource**) mem = resource;
+  return (char*) mem + header;
+}
+
+//! Matching replacement for Armadillo's memory free function.
+inline void ens_resource_free(void* mem, const size_t nBytes)
+{
+  const size_t header = alignof(std::max_align_t);
+  void* base = (char*) mem - header;
+  ens::MemoryResource* resource = *(ens::MemoryResource**) base;
+  if (resource != nullptr)
+    resource->Deallocate(base, nBytes + header);
+  else
+    std::free(base);
+}
+
+// These definitions intentionally come after allocation_tracking.hpp's, so
+// that when both switches are on, the routing hooks win and forward to the
+// tracker themselves.
+#undef ARMA_ALIEN_MEM_ALLOC_FUNCTION
+#undef ARMA_ALIEN_MEM_FREE_FUNCTION
+#define ARMA_ALIEN_MEM_ALLOC_FUNCTION ens_resource_alloc
+#define ARMA_ALIEN_MEM_FREE_FUNCTION ens_resource_free
+
+#endif // ENS_MEMORY_RESOURCE
+
+#endif
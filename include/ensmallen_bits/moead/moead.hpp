@@ -24,6 +24,7 @@
 #include "weight_init_policies/uniform_init.hpp"
 #include "weight_init_policies/bbs_init.hpp"
 #include "weight_init_policies/dirichlet_init.hpp"
+#include "weight_init_policies/riesz_energy_init.hpp"
 
 namespace ens {
 
@@ -191,6 +192,39 @@ class MOEAD {
   //! Modify value of maxReplace.
   double& Epsilon() { return epsilon; }
 
+  //! Get the maximum size of the external archive of non-dominated solutions
+  //! (0 disables the archive).  When enabled, every evaluated candidate is
+  //! offered to an epsilon-grid dominance archive (Laumanns et al.), and the
+  //! final Pareto set and front are taken from the archive instead of the
+  //! population.
+  size_t MaxArchiveSize() const { return maxArchiveSize; }
+  //! Modify the maximum size of the external archive.
+  size_t& MaxArchiveSize() { return maxArchiveSize; }
+
+  //! Get the grid cell width of the external archive: objective vectors
+  //! falling in the same cell are considered equivalent, and one per cell is
+  //! kept.
+  double ArchiveEpsilon() const { return archiveEpsilon; }
+  //! Modify the grid cell width of the external archive.
+  double& ArchiveEpsilon() { return archiveEpsilon; }
+
+  //! Get whether the population objective evaluations run in parallel with
+  //! OpenMP (requires the Evaluate() methods of all objectives to be
+  //! thread-safe).
+  bool ParallelEvaluation() const { return parallelEvaluation; }
+  //! Modify whether the population objective evaluations run in parallel.
+  bool& ParallelEvaluation() { return parallelEvaluation; }
+
+  //! Get whether the whole generation runs island-parallel: the subproblem
+  //! set is sharded across threads, cross-island neighbor replacements and
+  //! archive offers are batched to the end of the generation, and the ideal
+  //! point is kept as per-island minima merged once per generation.  This
+  //! also requires the Evaluate() methods of all objectives to be
+  //! thread-safe.
+  bool IslandParallel() const { return islandParallel; }
+  //! Modify whether the whole generation runs island-parallel.
+  bool& IslandParallel() { return islandParallel; }
+
   //! Retrieve value of lowerBound.
   const arma::vec& LowerBound() const { return lowerBound; }
   //! Modify value of lowerBound.
@@ -249,7 +283,9 @@ class MOEAD {
               const MatType& upperBound);
 
   /**
-   * Evaluate objectives for the elite population.
+   * Evaluate objectives for the elite population.  This dispatches to the
+   * shared PopulationEvaluator, which runs the members in parallel when
+   * parallelEvaluation is set.
    *
    * @tparam ArbitraryFunctionType std::tuple of multiple function types.
    * @tparam MatType Type of matrix to optimize.
@@ -257,20 +293,9 @@ class MOEAD {
    * @param objectives The set of objectives.
    * @param calculatedObjectives Vector to store calculated objectives.
    */
-  template<std::size_t I = 0,
-           typename MatType,
-           typename ...ArbitraryFunctionType>
-  typename std::enable_if<I == sizeof...(ArbitraryFunctionType), void>::type
-  EvaluateObjectives(
-                     std::vector<MatType>&,
-                     std::tuple<ArbitraryFunctionType...>&,
-                     std::vector<arma::Col<typename MatType::elem_type> >&);
-
-  template<std::size_t I = 0,
-           typename MatType,
+  template<typename MatType,
            typename ...ArbitraryFunctionType>
-  typename std::enable_if<I < sizeof...(ArbitraryFunctionType), void>::type
-  EvaluateObjectives(
+  void EvaluateObjectives(
                      std::vector<MatType>& population,
                      std::tuple<ArbitraryFunctionType...>& objectives,
                      std::vector<arma::Col<typename MatType::elem_type> >&
@@ -298,6 +323,18 @@ class MOEAD {
   //! Amplification factor for differentiation.
   double differentialWeight;
 
+  //! Whether the population objective evaluations run in parallel.
+  bool parallelEvaluation;
+
+  //! Whether the generation loop is sharded into per-thread islands.
+  bool islandParallel;
+
+  //! Maximum size of the external archive (0 disables the archive).
+  size_t maxArchiveSize;
+
+  //! Grid cell width of the external archive.
+  double archiveEpsilon;
+
   //! Maximum number of childs which can replace the parent. Higher value
   //! leads to a loss of diversity.
   size_t maxReplace;
@@ -330,6 +367,7 @@ class MOEAD {
 using DefaultMOEAD = MOEAD<Uniform, Tchebycheff>;
 using BBSMOEAD = MOEAD<BayesianBootstrap, Tchebycheff>;
 using DirichletMOEAD = MOEAD<Dirichlet, Tchebycheff>;
+using RieszEnergyMOEAD = MOEAD<RieszEnergy, Tchebycheff>;
 } // namespace ens
 
 // Include implementation.
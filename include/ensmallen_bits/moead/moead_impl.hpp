@@ -40,6 +40,10 @@ MOEAD(const size_t populationSize,
     neighborSize(neighborSize),
     distributionIndex(distributionIndex),
     differentialWeight(differentialWeight),
+    parallelEvaluation(false),
+    islandParallel(false),
+    maxArchiveSize(0),
+    archiveEpsilon(1e-3),
     maxReplace(maxReplace),
     epsilon(epsilon),
     lowerBound(lowerBound),
@@ -70,6 +74,10 @@ MOEAD(const size_t populationSize,
     neighborSize(neighborSize),
     distributionIndex(distributionIndex),
     differentialWeight(differentialWeight),
+    parallelEvaluation(false),
+    islandParallel(false),
+    maxArchiveSize(0),
+    archiveEpsilon(1e-3),
     maxReplace(maxReplace),
     epsilon(epsilon),
     lowerBound(lowerBound * arma::ones(1, 1)),
@@ -151,16 +159,26 @@ Optimize(std::tuple<ArbitraryFunctionType...>& objectives,
   const BaseMatType weights = initPolicy.template Generate<BaseMatType>(
       numObjectives, populationSize, epsilon);
 
-  // 1.1 Storing the indices of nearest neighbors of each weight vector.
+  // 1.1 Build the T-nearest-neighbor topology of the weight vectors once,
+  // into a flat column-contiguous index: column i holds the neighbors of
+  // subproblem i, and the generation loop below only ever walks these
+  // columns.  All pairwise squared distances come from a single Gram matrix
+  // product instead of one distance expression per weight.
   arma::umat neighborIndices(neighborSize, populationSize);
-  for (size_t i = 0; i < populationSize; ++i)
   {
-    // Cache the distance between weights[i] and other weights.
-    const arma::Row<ElemType> distances =
-        arma::sqrt(arma::sum(arma::square(weights.col(i) - weights.each_col())));
-    arma::uvec sortedIndices = arma::stable_sort_index(distances);
-    // Ignore distance from self.
-    neighborIndices.col(i) = sortedIndices(arma::span(1, neighborSize));
+    const BaseMatType gram = weights.t() * weights;
+    const arma::Col<ElemType> squaredNorms = gram.diag();
+    BaseMatType squaredDistances = -2.0 * gram;
+    squaredDistances.each_col() += squaredNorms;
+    squaredDistances.each_row() += squaredNorms.t();
+
+    for (size_t i = 0; i < populationSize; ++i)
+    {
+      const arma::uvec sortedIndices =
+          arma::stable_sort_index(squaredDistances.col(i));
+      // Ignore distance from self.
+      neighborIndices.col(i) = sortedIndices(arma::span(1, neighborSize));
+    }
   }
 
   // 1.2 Random generation of the initial population.
@@ -188,99 +206,299 @@ Optimize(std::tuple<ArbitraryFunctionType...>& objectives,
   for (const arma::Col<ElemType>& individualFitness : populationFitness)
     idealPoint = arma::min(idealPoint, individualFitness);
 
+  // External epsilon-grid archive of non-dominated solutions, keyed by the
+  // grid cell of the objective vector; at most one member is kept per cell,
+  // which both bounds the archive and gives an O(log |archive|) same-cell
+  // lookup.  See Laumanns et al., "Combining convergence and diversity in
+  // evolutionary multiobjective optimization" (2002).
+  typedef std::map<std::vector<arma::sword>,
+      std::pair<BaseMatType, arma::Col<ElemType>>> ArchiveType;
+  ArchiveType archive;
+
+  // The grid cell of an objective vector.
+  auto archiveCell = [&](const arma::Col<ElemType>& fitness)
+  {
+    std::vector<arma::sword> cell(numObjectives);
+    for (size_t m = 0; m < numObjectives; ++m)
+      cell[m] = (arma::sword) std::floor(fitness(m) / archiveEpsilon);
+    return cell;
+  };
+
+  // Pareto dominance on grid cells (all coordinates no worse, one better).
+  auto cellDominates = [&](const std::vector<arma::sword>& cellA,
+                           const std::vector<arma::sword>& cellB)
+  {
+    bool oneBetter = false;
+    for (size_t m = 0; m < numObjectives; ++m)
+    {
+      if (cellA[m] > cellB[m])
+        return false;
+      else if (cellA[m] < cellB[m])
+        oneBetter = true;
+    }
+    return oneBetter;
+  };
+
+  // Offer a candidate to the archive.  Same-cell candidates replace the
+  // incumbent only if they dominate it; candidates in a cell dominated by an
+  // archived cell are rejected; otherwise all archived cells the candidate
+  // dominates are evicted and the candidate is inserted, unless the archive
+  // is at its bound and nothing was evicted.
+  auto archiveInsert = [&](const BaseMatType& candidate,
+                           const arma::Col<ElemType>& fitness)
+  {
+    const std::vector<arma::sword> cell = archiveCell(fitness);
+
+    typename ArchiveType::iterator sameCell = archive.find(cell);
+    if (sameCell != archive.end())
+    {
+      bool oneBetter = false;
+      for (size_t m = 0; m < numObjectives; ++m)
+      {
+        if (fitness(m) > sameCell->second.second(m))
+          return;
+        else if (fitness(m) < sameCell->second.second(m))
+          oneBetter = true;
+      }
+      if (oneBetter)
+        sameCell->second = std::make_pair(candidate, fitness);
+      return;
+    }
+
+    for (const typename ArchiveType::value_type& entry : archive)
+    {
+      if (cellDominates(entry.first, cell))
+        return;
+    }
+
+    bool evicted = false;
+    typename ArchiveType::iterator it = archive.begin();
+    while (it != archive.end())
+    {
+      if (cellDominates(cell, it->first))
+      {
+        it = archive.erase(it);
+        evicted = true;
+      }
+      else
+        ++it;
+    }
+
+    if (archive.size() >= maxArchiveSize && !evicted)
+      return;
+
+    archive.emplace(cell, std::make_pair(candidate, fitness));
+  };
+
+  // Seed the archive with the initial population.
+  if (maxArchiveSize > 0)
+  {
+    for (size_t i = 0; i < populationSize; ++i)
+      archiveInsert(population[i], populationFitness[i]);
+  }
+
   Callback::BeginOptimization(*this, objectives, iterate, callbacks...);
 
+  // The subproblem set is sharded into contiguous islands, one per thread,
+  // when islandParallel is set; a single island reduces to the plain serial
+  // pass.  Every island works on its own shard with its own candidate
+  // temporaries and index pools, replaces neighbors inside its own shard
+  // immediately, and batches everything that crosses a shard boundary (the
+  // neighbor replacements outside the island, the archive offers, and the
+  // ideal-point minima) to be merged serially at the island boundary after
+  // the generation.  Cross-island reads of the population during mating are
+  // intentionally unsynchronized: the members keep their shape, so a
+  // concurrent replacement can at worst hand the stochastic differential
+  // operator a mixture of the old and new member.
+  const size_t numIslands = islandParallel ?
+      std::max<size_t>(1, std::min((size_t)
+          ParallelRuntime::Get().RegionThreads(), populationSize)) : 1;
+  const size_t islandSize = (populationSize + numIslands - 1) / numIslands;
+
+  // A neighbor replacement that crosses an island boundary, deferred until
+  // the end of the generation.
+  struct PendingUpdate
+  {
+    size_t pick;
+    BaseMatType candidate;
+    arma::Col<ElemType> fitness;
+  };
+
+  std::vector<std::vector<PendingUpdate>> pendingUpdates(numIslands);
+  std::vector<std::vector<std::pair<BaseMatType, arma::Col<ElemType>>>>
+      pendingArchive(numIslands);
+  std::vector<arma::Col<ElemType>> localIdealPoints(numIslands);
+
   // 2 The main loop.
   for (size_t generation = 1; generation <= maxGenerations && !terminate; ++generation)
   {
-    // Shuffle indexes of subproblems.
-    const arma::uvec shuffle = arma::shuffle(
-        arma::linspace<arma::uvec>(0, populationSize - 1, populationSize));
-    for (size_t subProblemIdx : shuffle)
+    // Every island starts the generation from the merged ideal point.
+    std::fill(localIdealPoints.begin(), localIdealPoints.end(), idealPoint);
+
+    ENS_PRAGMA_OMP_PARALLEL_FOR_THREADS((int) numIslands)
+    for (ptrdiff_t island = 0; island < (ptrdiff_t) numIslands; ++island)
     {
-      // 2.1 Randomly select two indices in neighborIndices[subProblemIdx] and use them
-      // to make a child.
-      size_t r1, r2, r3;
-      r1 = subProblemIdx;
-      // Randomly choose to sample from the population or the neighbors.
-      const bool sampleNeighbor = arma::randu() < neighborProb;
-      std::tie(r2, r3) =
-          Mating(subProblemIdx, neighborIndices, sampleNeighbor);
-
-      // 2.2 - 2.3 Reproduction and Repair: Differential Operator followed by
-      // Polynomial Mutation.
-      BaseMatType candidate(iterate.n_rows, iterate.n_cols);
-
-      for (size_t geneIdx = 0; geneIdx < numVariables; ++geneIdx)
+      const size_t islandStart = island * islandSize;
+      const size_t islandEnd =
+          std::min(islandStart + islandSize, populationSize);
+      if (islandStart >= islandEnd)
+        continue;
+
+      arma::Col<ElemType>& localIdealPoint = localIdealPoints[island];
+
+      // The candidate and its fitness are passed to EvaluateObjectives()
+      // through single-element containers, allocated once per island and
+      // reused for every candidate of the generation.
+      std::vector<BaseMatType> candidateContainer(1);
+      candidateContainer[0].set_size(iterate.n_rows, iterate.n_cols);
+      std::vector<arma::Col<ElemType>> fitnessContainer(1);
+      fitnessContainer[0].set_size(numObjectives);
+
+      // Reusable index pools, shuffled in place each time they are needed.
+      arma::uvec neighborPool =
+          arma::linspace<arma::uvec>(0, neighborSize - 1, neighborSize);
+      arma::uvec populationPool =
+          arma::linspace<arma::uvec>(0, populationSize - 1, populationSize);
+
+      // Shuffled pass over the subproblems of this shard.
+      const arma::uvec subProblemOrder = arma::shuffle(
+          arma::linspace<arma::uvec>(islandStart, islandEnd - 1,
+              islandEnd - islandStart));
+      for (size_t subProblemIdx : subProblemOrder)
       {
-        if (arma::randu() < crossoverProb)
+        // 2.1 Randomly select two indices in neighborIndices[subProblemIdx] and use them
+        // to make a child.
+        size_t r1, r2, r3;
+        r1 = subProblemIdx;
+        // Randomly choose to sample from the population or the neighbors.
+        const bool sampleNeighbor = arma::randu() < neighborProb;
+        std::tie(r2, r3) =
+            Mating(subProblemIdx, neighborIndices, sampleNeighbor);
+
+        // 2.2 - 2.3 Reproduction and Repair: Differential Operator followed by
+        // Polynomial Mutation.
+        BaseMatType& candidate = candidateContainer[0];
+
+        for (size_t geneIdx = 0; geneIdx < numVariables; ++geneIdx)
         {
-          candidate(geneIdx) = population[r1](geneIdx) +
-              differentialWeight * (population[r2](geneIdx) -
-                  population[r3](geneIdx));
-
-          // Boundary conditions.
-          if (candidate(geneIdx) < castedLowerBound(geneIdx))
+          if (arma::randu() < crossoverProb)
           {
-            candidate(geneIdx) = castedLowerBound(geneIdx) +
-                arma::randu() * (population[r1](geneIdx) - castedLowerBound(geneIdx));
-          }
-          if (candidate(geneIdx) > castedUpperBound(geneIdx))
-          {
-            candidate(geneIdx) = castedUpperBound(geneIdx) -
-                arma::randu() * (castedUpperBound(geneIdx) - population[r1](geneIdx));
+            candidate(geneIdx) = population[r1](geneIdx) +
+                differentialWeight * (population[r2](geneIdx) -
+                    population[r3](geneIdx));
+
+            // Boundary conditions.
+            if (candidate(geneIdx) < castedLowerBound(geneIdx))
+            {
+              candidate(geneIdx) = castedLowerBound(geneIdx) +
+                  arma::randu() * (population[r1](geneIdx) - castedLowerBound(geneIdx));
+            }
+            if (candidate(geneIdx) > castedUpperBound(geneIdx))
+            {
+              candidate(geneIdx) = castedUpperBound(geneIdx) -
+                  arma::randu() * (castedUpperBound(geneIdx) - population[r1](geneIdx));
+            }
           }
+          else
+            candidate(geneIdx) = population[r1](geneIdx);
         }
-        else
-          candidate(geneIdx) = population[r1](geneIdx);
-      }
 
-      Mutate(candidate, 1.0 / static_cast<double>(numVariables),
-          castedLowerBound, castedUpperBound);
+        Mutate(candidate, 1.0 / static_cast<double>(numVariables),
+            castedLowerBound, castedUpperBound);
 
-      arma::Col<ElemType> candidateFitness(numObjectives);
-      //! Creating temp vectors to pass to EvaluateObjectives.
-      std::vector<BaseMatType> candidateContainer { candidate };
-      std::vector<arma::Col<ElemType>> fitnessContainer { candidateFitness };
-      EvaluateObjectives(candidateContainer, objectives, fitnessContainer);
-      candidateFitness = std::move(fitnessContainer[0]);
-      //! Flush out the dummy containers.
-      fitnessContainer.clear();
-      candidateContainer.clear();
+        arma::Col<ElemType>& candidateFitness = fitnessContainer[0];
+        EvaluateObjectives(candidateContainer, objectives, fitnessContainer);
 
-      // 2.4 Update of ideal point.
-      idealPoint = arma::min(idealPoint, candidateFitness);
+        // 2.4 Update of the island-local ideal point; the per-island minima
+        // are merged at the island boundary.
+        localIdealPoint = arma::min(localIdealPoint, candidateFitness);
 
-      // 2.5 Update of the population.
-      size_t replaceCounter = 0;
-      const size_t sampleSize = sampleNeighbor ? neighborSize : populationSize;
+        // Offer the candidate to the external archive, if one is kept; the
+        // offers of an island are batched and inserted serially at the
+        // island boundary.
+        if (maxArchiveSize > 0)
+          pendingArchive[island].emplace_back(candidate, candidateFitness);
 
-      const arma::uvec idxShuffle = arma::shuffle(
-          arma::linspace<arma::uvec>(0, sampleSize - 1, sampleSize));
+        // 2.5 Update of the population, walking the flat neighbor column of
+        // this subproblem (or the whole population) in shuffled order.
+        // Neighbors inside this island's shard are replaced immediately;
+        // replacements outside it are deferred to the island boundary (they
+        // still consume the replacement budget of this candidate).
+        size_t replaceCounter = 0;
+        arma::uvec& idxShuffle = sampleNeighbor ? neighborPool : populationPool;
+        idxShuffle = arma::shuffle(idxShuffle);
 
-      for (size_t idx : idxShuffle)
-      {
-        // Preserve diversity by controlling replacement of neighbors
-        // by child solution.
-        if (replaceCounter >= maxReplace)
-          break;
+        for (size_t idx : idxShuffle)
+        {
+          // Preserve diversity by controlling replacement of neighbors
+          // by child solution.
+          if (replaceCounter >= maxReplace)
+            break;
+
+          const size_t pick = sampleNeighbor ?
+              neighborIndices(idx, subProblemIdx) : idx;
+
+          if (pick < islandStart || pick >= islandEnd)
+          {
+            pendingUpdates[island].push_back(
+                PendingUpdate{ pick, candidate, candidateFitness });
+            ++replaceCounter;
+            continue;
+          }
+
+          const ElemType candidateDecomposition = decompPolicy.template
+              Apply<arma::Col<ElemType>>(weights.col(pick), localIdealPoint, candidateFitness);
+          const ElemType parentDecomposition =  decompPolicy.template
+              Apply<arma::Col<ElemType>>(weights.col(pick), localIdealPoint, populationFitness[pick]);
+
+          if (candidateDecomposition < parentDecomposition)
+          {
+            population[pick] = candidate;
+            populationFitness[pick] = candidateFitness;
+            ++replaceCounter;
+          }
+        }
+      } // End of pass over the subproblems of this shard.
+    } // End of the pass over all islands.
 
-        const size_t pick = sampleNeighbor ?
-            neighborIndices(idx, subProblemIdx) : idx;
+    // Island boundary: merge the per-island ideal-point minima ...
+    for (size_t island = 0; island < numIslands; ++island)
+      idealPoint = arma::min(idealPoint, localIdealPoints[island]);
 
+    // ... apply the deferred cross-island neighbor replacements, re-checked
+    // against the merged ideal point and the current owner fitness (the
+    // owning island may have replaced the member since the deferral) ...
+    for (size_t island = 0; island < numIslands; ++island)
+    {
+      for (const PendingUpdate& update : pendingUpdates[island])
+      {
         const ElemType candidateDecomposition = decompPolicy.template
-            Apply<arma::Col<ElemType>>(weights.col(pick), idealPoint, candidateFitness);
-        const ElemType parentDecomposition =  decompPolicy.template
-            Apply<arma::Col<ElemType>>(weights.col(pick), idealPoint, populationFitness[pick]);
+            Apply<arma::Col<ElemType>>(weights.col(update.pick), idealPoint,
+                update.fitness);
+        const ElemType parentDecomposition = decompPolicy.template
+            Apply<arma::Col<ElemType>>(weights.col(update.pick), idealPoint,
+                populationFitness[update.pick]);
 
         if (candidateDecomposition < parentDecomposition)
         {
-          population[pick] = candidate;
-          populationFitness[pick] = candidateFitness;
-          ++replaceCounter;
+          population[update.pick] = update.candidate;
+          populationFitness[update.pick] = update.fitness;
         }
       }
-    } // End of pass over all subproblems.
+      pendingUpdates[island].clear();
+    }
+
+    // ... and insert the batched archive offers.
+    if (maxArchiveSize > 0)
+    {
+      for (size_t island = 0; island < numIslands; ++island)
+      {
+        for (const std::pair<BaseMatType, arma::Col<ElemType>>& offer :
+            pendingArchive[island])
+          archiveInsert(offer.first, offer.second);
+        pendingArchive[island].clear();
+      }
+    }
 
     //  The final population itself is the best front.
     const std::vector<arma::uvec> frontIndices { arma::shuffle(
@@ -290,25 +508,49 @@ Optimize(std::tuple<ArbitraryFunctionType...>& objectives,
         populationFitness, frontIndices, callbacks...);
   } // End of pass over all the generations.
 
-  // Set the candidates from the Pareto Set as the output.
-  paretoSet.set_size(population[0].n_rows, population[0].n_cols, population.size());
-
-  // The Pareto Front is stored, can be obtained via ParetoSet() getter.
-  for (size_t solutionIdx = 0; solutionIdx < population.size(); ++solutionIdx)
+  if (maxArchiveSize > 0 && !archive.empty())
   {
-    paretoSet.slice(solutionIdx) =
-        arma::conv_to<arma::mat>::from(population[solutionIdx]);
+    // The archive holds the non-dominated solutions seen during the whole
+    // run; report it as the Pareto set and front.
+    paretoSet.set_size(population[0].n_rows, population[0].n_cols,
+        archive.size());
+    paretoFront.set_size(populationFitness[0].n_rows,
+        populationFitness[0].n_cols, archive.size());
+
+    size_t solutionIdx = 0;
+    for (const typename ArchiveType::value_type& entry : archive)
+    {
+      paretoSet.slice(solutionIdx) =
+          arma::conv_to<arma::mat>::from(entry.second.first);
+      paretoFront.slice(solutionIdx) =
+          arma::conv_to<arma::mat>::from(entry.second.second);
+      ++solutionIdx;
+    }
   }
+  else
+  {
+    // Set the candidates from the Pareto Set as the output.
+    paretoSet.set_size(population[0].n_rows, population[0].n_cols,
+        population.size());
 
-  // Set the candidates from the Pareto Front as the output.
-  paretoFront.set_size(populationFitness[0].n_rows, populationFitness[0].n_cols,
-      populationFitness.size());
+    // The Pareto Front is stored, can be obtained via ParetoSet() getter.
+    for (size_t solutionIdx = 0; solutionIdx < population.size(); ++solutionIdx)
+    {
+      paretoSet.slice(solutionIdx) =
+          arma::conv_to<arma::mat>::from(population[solutionIdx]);
+    }
 
-  // The Pareto Front is stored, can be obtained via ParetoFront() getter.
-  for (size_t solutionIdx = 0; solutionIdx < populationFitness.size(); ++solutionIdx)
-  {
-    paretoFront.slice(solutionIdx) =
-        arma::conv_to<arma::mat>::from(populationFitness[solutionIdx]);
+    // Set the candidates from the Pareto Front as the output.
+    paretoFront.set_size(populationFitness[0].n_rows,
+        populationFitness[0].n_cols, populationFitness.size());
+
+    // The Pareto Front is stored, can be obtained via ParetoFront() getter.
+    for (size_t solutionIdx = 0; solutionIdx < populationFitness.size();
+        ++solutionIdx)
+    {
+      paretoFront.slice(solutionIdx) =
+          arma::conv_to<arma::mat>::from(populationFitness[solutionIdx]);
+    }
   }
 
   // Assign iterate to first element of the Pareto Set.
@@ -401,39 +643,18 @@ Mutate(MatType& candidate,
     candidate = arma::min(arma::max(candidate, lowerBound), upperBound);
 }
 
-//! No objectives to evaluate.
-template <typename InitPolicyType, typename DecompPolicyType>
-template<std::size_t I,
-         typename MatType,
-         typename ...ArbitraryFunctionType>
-typename std::enable_if<I == sizeof...(ArbitraryFunctionType), void>::type
-MOEAD<InitPolicyType, DecompPolicyType>::
-EvaluateObjectives(
-    std::vector<MatType>&,
-    std::tuple<ArbitraryFunctionType...>&,
-    std::vector<arma::Col<typename MatType::elem_type> >&)
-{
- // Nothing to do here.
-}
-
 //! Evaluate the objectives for the entire population.
 template <typename InitPolicyType, typename DecompPolicyType>
-template<std::size_t I,
-         typename MatType,
+template<typename MatType,
          typename ...ArbitraryFunctionType>
-typename std::enable_if<I < sizeof...(ArbitraryFunctionType), void>::type
-MOEAD<InitPolicyType, DecompPolicyType>::
+void MOEAD<InitPolicyType, DecompPolicyType>::
 EvaluateObjectives(
     std::vector<MatType>& population,
     std::tuple<ArbitraryFunctionType...>& objectives,
     std::vector<arma::Col<typename MatType::elem_type> >& calculatedObjectives)
 {
-  for (size_t i = 0; i < population.size(); i++)
-  {
-    calculatedObjectives[i](I) = std::get<I>(objectives).Evaluate(population[i]);
-    EvaluateObjectives<I+1, MatType, ArbitraryFunctionType...>(population, objectives,
-                                                               calculatedObjectives);
-  }
+  PopulationEvaluator::Evaluate(population, objectives, calculatedObjectives,
+      population.size(), parallelEvaluation);
 }
 
 }  // namespace ens
@@ -0,0 +1,179 @@
+/**
+ * @file riesz_energy_init.hpp
+ * @author Marcus Edel
+ *
+ * The Riesz energy method of Weight Initialization.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_MOEAD_RIESZ_ENERGY_HPP
+#define ENSMALLEN_MOEAD_RIESZ_ENERGY_HPP
+
+namespace ens {
+
+/**
+ * The Riesz energy method for initializing weights.  A deterministic
+ * low-discrepancy sequence seeds the requested number of points on the unit
+ * simplex, and a few sweeps of Riesz s-energy descent then push the points
+ * apart until they are well spread.
+ *
+ * Unlike the Das-Dennis lattice of the Uniform policy, whose size is a
+ * binomial coefficient that explodes with the number of objectives, this
+ * policy produces any requested population size for any number of
+ * objectives, so many-objective MOEA/D runs do not need lattice-sized
+ * populations just to cover the simplex.
+ *
+ * For more information, see the following:
+ *
+ * @code
+ * @article{Hardin2004,
+ *   title   = {Discretizing manifolds via minimum energy points},
+ *   author  = {Hardin, Douglas P. and Saff, Edward B.},
+ *   journal = {Notices of the American Mathematical Society},
+ *   pages   = {1186--1194},
+ *   year    = {2004}
+ * }
+ * @endcode
+ */
+class RieszEnergy
+{
+ public:
+  /**
+   * Constructor for the Riesz energy policy.
+   *
+   * @param numSweeps Number of energy-descent refinement sweeps over the
+   *     whole point set.
+   * @param stepSize Initial descent step, as a fraction of the expected
+   *     point spacing; the step decays geometrically over the sweeps.
+   */
+  RieszEnergy(const size_t numSweeps = 10, const double stepSize = 0.25) :
+      numSweeps(numSweeps),
+      stepSize(stepSize)
+  {
+    /* Nothing to do. */
+  }
+
+  /**
+   * Generate the reference direction matrix.
+   *
+   * @tparam MatType The type of the matrix used for constructing weights.
+   * @param numObjectives The dimensionality of objective space.
+   * @param numPoints The number of reference directions requested.
+   * @param epsilon Handle numerical stability after weight initialization.
+   */
+  template<typename MatType>
+  MatType Generate(const size_t numObjectives,
+                   const size_t numPoints,
+                   const double epsilon)
+  {
+    typedef typename MatType::elem_type ElemType;
+
+    MatType weights(numObjectives, numPoints);
+    if (numObjectives == 1)
+    {
+      weights.ones();
+      return weights;
+    }
+
+    // Seed the simplex with a Kronecker (additive recurrence) sequence: the
+    // fractional parts of i * alpha, with alpha built from the generalized
+    // golden ratio, fill the unit cube with low discrepancy, and the
+    // -log() map sends uniform variates to the simplex.
+    double phi = 2.0;
+    for (size_t it = 0; it < 32; ++it)
+      phi = std::pow(1.0 + phi, 1.0 / (numObjectives + 1));
+
+    arma::Col<ElemType> alpha(numObjectives);
+    double alphaValue = 1.0;
+    for (size_t j = 0; j < numObjectives; ++j)
+    {
+      alphaValue /= phi;
+      alpha[j] = (ElemType) alphaValue;
+    }
+
+    for (size_t i = 0; i < numPoints; ++i)
+    {
+      for (size_t j = 0; j < numObjectives; ++j)
+      {
+        double u = std::fmod((i + 1) * (double) alpha[j], 1.0);
+        // Guard the logarithm below against u = 0.
+        u = std::max(u, 1e-12);
+        weights(j, i) = (ElemType) -std::log(u);
+      }
+    }
+    weights = arma::clamp(arma::normalise(weights, 1, 0), (ElemType) epsilon,
+        (ElemType) 1.0);
+
+    // Refinement: a few sweeps of descent on the Riesz s-energy
+    // sum_{i != j} 1 / ||w_i - w_j||^s, with s set to the simplex dimension.
+    // Every point is pushed along the repulsion exerted by all others; the
+    // move is projected onto the simplex tangent space (zero column sum), so
+    // the points stay on the simplex up to the clamping below.
+    const ElemType s = (ElemType) (numObjectives - 1);
+    // The expected spacing of numPoints well-spread points on a
+    // (numObjectives - 1)-dimensional simplex.
+    const ElemType spacing = (ElemType) std::pow((double) numPoints,
+        -1.0 / (double) (numObjectives - 1));
+
+    arma::Col<ElemType> repulsion(numObjectives);
+    arma::Col<ElemType> diff(numObjectives);
+    ElemType step = stepSize * spacing;
+    for (size_t sweep = 0; sweep < numSweeps; ++sweep)
+    {
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        repulsion.zeros();
+        for (size_t j = 0; j < numPoints; ++j)
+        {
+          if (j == i)
+            continue;
+
+          diff = weights.col(i) - weights.col(j);
+          const ElemType dist = std::max(
+              (ElemType) std::sqrt(arma::dot(diff, diff)),
+              (ElemType) 1e-12);
+          repulsion += diff / std::pow(dist, s + 2);
+        }
+
+        // Project onto the simplex tangent space and take a step of fixed
+        // length; only the direction of the summed repulsion matters.
+        repulsion -= arma::accu(repulsion) / numObjectives;
+        const ElemType norm = std::sqrt(arma::dot(repulsion, repulsion));
+        if (norm > ElemType(0))
+          weights.col(i) += (step / norm) * repulsion;
+
+        // Clamp to the nonnegative orthant and renormalize.
+        weights.col(i) = arma::clamp(weights.col(i), (ElemType) epsilon,
+            (ElemType) 1.0);
+        weights.col(i) /= arma::accu(weights.col(i));
+      }
+
+      step *= 0.8;
+    }
+
+    return weights;
+  }
+
+  //! Get the number of refinement sweeps.
+  size_t NumSweeps() const { return numSweeps; }
+  //! Modify the number of refinement sweeps.
+  size_t& NumSweeps() { return numSweeps; }
+
+  //! Get the initial step size.
+  double StepSize() const { return stepSize; }
+  //! Modify the initial step size.
+  double& StepSize() { return stepSize; }
+
+ private:
+  //! Number of energy-descent sweeps over the point set.
+  size_t numSweeps;
+  //! Initial descent step, relative to the expected point spacing.
+  double stepSize;
+};
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,133 @@
+/**
+ * @file multi_start.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the parallel multi-start meta-optimizer.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_MULTI_START_MULTI_START_HPP
+#define ENSMALLEN_MULTI_START_MULTI_START_HPP
+
+#include <ensmallen_bits/lbfgs/lbfgs.hpp>
+
+namespace ens {
+
+/**
+ * MultiStart runs a local optimizer from several starting points and returns
+ * the best result, the standard recipe for nonconvex problems where a single
+ * run only finds the nearest local optimum.  The starts are independent, so
+ * they are spread over the OpenMP thread pool; all runs share the incumbent
+ * best objective, and a run whose own best value has stalled while trailing
+ * the incumbent is heuristically dominated and terminated early (through the
+ * callback mechanism of the wrapped optimizer), so that hopeless starts do
+ * not burn the full iteration budget.
+ *
+ * The first start is the given starting point; the remaining starts are
+ * sampled uniformly from the configured box.  Note that the starts run
+ * concurrently, so the objective function must be safe to evaluate from
+ * several threads at once, and callbacks passed to Optimize() are raised at
+ * the wrapper level only (once per finished start), not from inside the
+ * wrapped runs.
+ *
+ * MultiStart works with any function type its wrapped optimizer works with;
+ * for more details, see the documentation on function types included with
+ * this distribution or on the ensmallen website.
+ *
+ * @tparam OptimizerType The wrapped local optimizer.
+ */
+template<typename OptimizerType = L_BFGS>
+class MultiStart
+{
+ public:
+  /**
+   * Construct the multi-start meta-optimizer.
+   *
+   * @param optimizer Configured local optimizer to run from each start.
+   * @param numStarts Number of starting points.
+   * @param lowerBound Lower bound of the start sampling box, applied to
+   *     every dimension.
+   * @param upperBound Upper bound of the start sampling box, applied to
+   *     every dimension.
+   * @param pruningPatience Number of consecutive objective evaluations a
+   *     run's best value may stall while trailing the shared incumbent
+   *     before the run is terminated (0 disables pruning).
+   */
+  MultiStart(const OptimizerType& optimizer = OptimizerType(),
+             const size_t numStarts = 8,
+             const double lowerBound = -10.0,
+             const double upperBound = 10.0,
+             const size_t pruningPatience = 50);
+
+  /**
+   * Optimize the given function from numStarts starting points with copies
+   * of the wrapped optimizer and keep the best result. The given starting
+   * point is used as the first start and will be modified to store the best
+   * finishing point; the best objective value is returned.
+   *
+   * @tparam FunctionType Type of the function to be optimized.
+   * @tparam MatType Type of matrix to optimize.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to optimize.
+   * @param iterate Starting point (will be modified).
+   * @param callbacks Callback functions.
+   * @return Objective value of the final point.
+   */
+  template<typename FunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(FunctionType& function,
+                                       MatType& iterate,
+                                       CallbackTypes&&... callbacks);
+
+  //! Get the wrapped local optimizer.
+  const OptimizerType& BaseOptimizer() const { return optimizer; }
+  //! Modify the wrapped local optimizer.
+  OptimizerType& BaseOptimizer() { return optimizer; }
+
+  //! Get the number of starting points.
+  size_t NumStarts() const { return numStarts; }
+  //! Modify the number of starting points.
+  size_t& NumStarts() { return numStarts; }
+
+  //! Get the lower bound of the start sampling box.
+  double LowerBound() const { return lowerBound; }
+  //! Modify the lower bound of the start sampling box.
+  double& LowerBound() { return lowerBound; }
+
+  //! Get the upper bound of the start sampling box.
+  double UpperBound() const { return upperBound; }
+  //! Modify the upper bound of the start sampling box.
+  double& UpperBound() { return upperBound; }
+
+  //! Get the pruning patience (0 disables pruning).
+  size_t PruningPatience() const { return pruningPatience; }
+  //! Modify the pruning patience (0 disables pruning).
+  size_t& PruningPatience() { return pruningPatience; }
+
+ private:
+  //! The wrapped local optimizer; each start runs a copy of it.
+  OptimizerType optimizer;
+
+  //! The number of starting points.
+  size_t numStarts;
+
+  //! The lower bound of the start sampling box.
+  double lowerBound;
+
+  //! The upper bound of the start sampling box.
+  double upperBound;
+
+  //! The pruning patience in objective evaluations.
+  size_t pruningPatience;
+};
+
+} // namespace ens
+
+// Include implementation.
+#include "multi_start_impl.hpp"
+
+#endif
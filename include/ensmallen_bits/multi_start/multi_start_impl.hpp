@@ -0,0 +1,174 @@
+/**
+ * @file multi_start_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the parallel multi-start meta-optimizer.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_MULTI_START_MULTI_START_IMPL_HPP
+#define ENSMALLEN_MULTI_START_MULTI_START_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "multi_start.hpp"
+
+#include <ensmallen_bits/function.hpp>
+
+namespace ens {
+
+/**
+ * Internal callback attached to every start: it publishes the run's best
+ * objective to the shared incumbent and terminates the run once its best
+ * value has stalled for the configured patience while trailing the
+ * incumbent (a heuristically dominated trajectory).
+ */
+class MultiStartPruneCallback
+{
+ public:
+  MultiStartPruneCallback(double& sharedBest, const size_t patience) :
+      sharedBest(sharedBest),
+      patience(patience),
+      best(std::numeric_limits<double>::max()),
+      stall(0)
+  { /* Nothing to do here. */ }
+
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  bool Evaluate(OptimizerType& /* optimizer */,
+                FunctionType& /* function */,
+                const MatType& /* coordinates */,
+                const double objective)
+  {
+    if (objective < best)
+    {
+      best = objective;
+      stall = 0;
+    }
+    else
+    {
+      ++stall;
+    }
+
+    double incumbent;
+    ENS_PRAGMA_OMP_CRITICAL
+    {
+      if (best < sharedBest)
+        sharedBest = best;
+      incumbent = sharedBest;
+    }
+
+    return (patience != 0) && (stall >= patience) && (best > incumbent);
+  }
+
+  //! Get the run's best objective.
+  double Best() const { return best; }
+
+ private:
+  //! The incumbent best objective shared by all starts.
+  double& sharedBest;
+
+  //! The pruning patience in objective evaluations.
+  size_t patience;
+
+  //! The run's best objective.
+  double best;
+
+  //! The number of evaluations since the run's best objective improved.
+  size_t stall;
+};
+
+template<typename OptimizerType>
+MultiStart<OptimizerType>::MultiStart(const OptimizerType& optimizer,
+                                      const size_t numStarts,
+                                      const double lowerBound,
+                                      const double upperBound,
+                                      const size_t pruningPatience) :
+    optimizer(optimizer),
+    numStarts(numStarts),
+    lowerBound(lowerBound),
+    upperBound(upperBound),
+    pruningPatience(pruningPatience)
+{ /* Nothing to do. */ }
+
+//! Optimize the function (minimize).
+template<typename OptimizerType>
+template<typename FunctionType,
+         typename MatType,
+         typename... CallbackTypes>
+typename MatType::elem_type MultiStart<OptimizerType>::Optimize(
+    FunctionType& function,
+    MatType& iterateIn,
+    CallbackTypes&&... callbacks)
+{
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+
+  // The wrapped optimizer performs its own function API checks, which
+  // depend on its type; here it is enough to require a dense matrix.
+  RequireDenseFloatingPointType<BaseMatType>();
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+
+  if (numStarts == 0)
+  {
+    throw std::logic_error("MultiStart::Optimize(): at least one starting "
+        "point is required!");
+  }
+
+  // The first start is the given starting point; the others are sampled
+  // uniformly from the configured box.  Sampling stays serial so results
+  // do not depend on the thread schedule.
+  std::vector<BaseMatType> points(numStarts);
+  points[0] = iterate;
+  for (size_t s = 1; s < numStarts; ++s)
+  {
+    points[s] = lowerBound + (upperBound - lowerBound) *
+        arma::randu<BaseMatType>(iterate.n_rows, iterate.n_cols);
+  }
+
+  arma::Col<ElemType> objectives(numStarts);
+
+  Callback::BeginOptimization(*this, function, iterate, callbacks...);
+
+  // The starts are independent, so spread them over all threads.  The
+  // objective must be safe to evaluate concurrently; callbacks are not
+  // thread-safe, so the user's Evaluate events are raised serially
+  // afterwards, once per finished start.
+  double sharedBest = std::numeric_limits<double>::max();
+
+  ENS_PRAGMA_OMP_PARALLEL_FOR
+  for (ptrdiff_t s = 0; s < (ptrdiff_t) numStarts; ++s)
+  {
+    OptimizerType localOptimizer = optimizer;
+    MultiStartPruneCallback prune(sharedBest, pruningPatience);
+    objectives(s) = localOptimizer.Optimize(function, points[s], prune);
+
+    ENS_PRAGMA_OMP_CRITICAL
+    {
+      if ((double) objectives(s) < sharedBest)
+        sharedBest = (double) objectives(s);
+    }
+  }
+
+  bool terminate = false;
+  for (size_t s = 0; s < numStarts; ++s)
+  {
+    terminate |= Callback::Evaluate(*this, function, points[s],
+        objectives(s), callbacks...);
+  }
+
+  // Keep the best finishing point.
+  const arma::uword bestIndex = objectives.index_min();
+  iterate = points[bestIndex];
+  terminate |= Callback::StepTaken(*this, function, iterate, callbacks...);
+
+  Callback::EndOptimization(*this, function, iterate, callbacks...);
+  return objectives(bestIndex);
+}
+
+} // namespace ens
+
+#endif
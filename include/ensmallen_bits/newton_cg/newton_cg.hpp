@@ -0,0 +1,202 @@
+/**
+ * @file newton_cg.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the trust-region Newton-CG (truncated Newton) optimizer.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_NEWTON_CG_NEWTON_CG_HPP
+#define ENSMALLEN_NEWTON_CG_NEWTON_CG_HPP
+
+namespace ens {
+
+/**
+ * Trust-region Newton-CG (also known as truncated Newton) minimizes a
+ * differentiable function using second-order curvature information without
+ * ever forming the Hessian.  Each outer iteration approximately minimizes
+ * the local quadratic model inside a trust region with the Steihaug-Toint
+ * conjugate gradient method, which only needs Hessian-vector products; the
+ * trust-region radius then grows or shrinks depending on how well the model
+ * predicted the actual objective change.
+ *
+ * If the function implements the optional Hvp() method of the form
+ *
+ * @code
+ * void Hvp(const arma::mat& coordinates, const arma::mat& v, arma::mat& out);
+ * @endcode
+ *
+ * the exact Hessian-vector product is used.  Otherwise the product is
+ * approximated with a forward difference of two gradients,
+ * \f$ H v \approx (\nabla f(x + h v) - \nabla f(x)) / h \f$, at the cost of
+ * one extra gradient evaluation per product.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @book{Nocedal2006,
+ *   author    = {Nocedal, Jorge and Wright, Stephen J.},
+ *   title     = {Numerical Optimization},
+ *   edition   = {2nd},
+ *   publisher = {Springer},
+ *   year      = {2006}
+ * }
+ * @endcode
+ *
+ * NewtonCG can optimize differentiable functions.  For more details, see the
+ * documentation on function types included with this distribution or on the
+ * ensmallen website.
+ */
+class NewtonCG
+{
+ public:
+  /**
+   * Construct the trust-region Newton-CG optimizer.
+   *
+   * @param maxIterations Maximum number of outer iterations allowed (0 means
+   *     no limit).
+   * @param minGradientNorm Minimum gradient norm required to continue the
+   *     optimization.
+   * @param initialRadius Initial trust-region radius.
+   * @param maxRadius Maximum trust-region radius.
+   * @param maxCGIterations Maximum number of inner CG iterations per outer
+   *     iteration (0 means the number of parameters).
+   * @param fdStep Base step used for the finite-difference Hessian-vector
+   *     product when the function does not provide Hvp().
+   */
+  NewtonCG(const size_t maxIterations = 1000,
+           const double minGradientNorm = 1e-10,
+           const double initialRadius = 1.0,
+           const double maxRadius = 1e4,
+           const size_t maxCGIterations = 0,
+           const double fdStep = 1e-5);
+
+  /**
+   * Optimize the given function using trust-region Newton-CG.  The given
+   * starting point will be modified to store the finishing point of the
+   * algorithm, and the final objective value is returned.
+   *
+   * @tparam FunctionType Type of the function to be optimized.
+   * @tparam MatType Type of matrix to optimize.
+   * @tparam GradType Type of matrix for the gradient.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to optimize.
+   * @param iterate Starting point (will be modified).
+   * @param callbacks Callback functions.
+   * @return Objective value of the final point.
+   */
+  template<typename FunctionType,
+           typename MatType,
+           typename GradType,
+           typename... CallbackTypes>
+  typename std::enable_if<IsArmaType<GradType>::value,
+      typename MatType::elem_type>::type
+  Optimize(FunctionType& function,
+           MatType& iterate,
+           CallbackTypes&&... callbacks);
+
+  //! Forward the MatType as GradType.
+  template<typename FunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(FunctionType& function,
+                                       MatType& iterate,
+                                       CallbackTypes&&... callbacks)
+  {
+    return Optimize<FunctionType, MatType, MatType, CallbackTypes...>(
+        function, iterate, std::forward<CallbackTypes>(callbacks)...);
+  }
+
+  //! Get the maximum number of outer iterations (0 indicates no limit).
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of outer iterations (0 indicates no limit).
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the minimum gradient norm.
+  double MinGradientNorm() const { return minGradientNorm; }
+  //! Modify the minimum gradient norm.
+  double& MinGradientNorm() { return minGradientNorm; }
+
+  //! Get the initial trust-region radius.
+  double InitialRadius() const { return initialRadius; }
+  //! Modify the initial trust-region radius.
+  double& InitialRadius() { return initialRadius; }
+
+  //! Get the maximum trust-region radius.
+  double MaxRadius() const { return maxRadius; }
+  //! Modify the maximum trust-region radius.
+  double& MaxRadius() { return maxRadius; }
+
+  //! Get the maximum number of inner CG iterations (0 indicates the number
+  //! of parameters).
+  size_t MaxCGIterations() const { return maxCGIterations; }
+  //! Modify the maximum number of inner CG iterations.
+  size_t& MaxCGIterations() { return maxCGIterations; }
+
+  //! Get the finite-difference Hessian-vector product step.
+  double FDStep() const { return fdStep; }
+  //! Modify the finite-difference Hessian-vector product step.
+  double& FDStep() { return fdStep; }
+
+ private:
+  /**
+   * Compute the Hessian-vector product with the function's exact Hvp()
+   * method.  This overload is selected when the function provides one.
+   */
+  template<typename FunctionType,
+           typename BaseMatType,
+           typename BaseGradType>
+  void Hvp(std::true_type,
+           FunctionType& f,
+           const BaseMatType& coordinates,
+           const BaseGradType& gradient,
+           const BaseGradType& v,
+           BaseGradType& out,
+           BaseMatType& workCoordinates,
+           BaseGradType& workGradient);
+
+  /**
+   * Approximate the Hessian-vector product with a forward difference of two
+   * gradients.  This overload is selected when the function does not provide
+   * Hvp().
+   */
+  template<typename FunctionType,
+           typename BaseMatType,
+           typename BaseGradType>
+  void Hvp(std::false_type,
+           FunctionType& f,
+           const BaseMatType& coordinates,
+           const BaseGradType& gradient,
+           const BaseGradType& v,
+           BaseGradType& out,
+           BaseMatType& workCoordinates,
+           BaseGradType& workGradient);
+
+  //! The maximum number of allowed outer iterations.
+  size_t maxIterations;
+
+  //! The minimum gradient norm.
+  double minGradientNorm;
+
+  //! The initial trust-region radius.
+  double initialRadius;
+
+  //! The maximum trust-region radius.
+  double maxRadius;
+
+  //! The maximum number of inner CG iterations.
+  size_t maxCGIterations;
+
+  //! The finite-difference Hessian-vector product step.
+  double fdStep;
+};
+
+} // namespace ens
+
+// Include implementation.
+#include "newton_cg_impl.hpp"
+
+#endif
@@ -0,0 +1,267 @@
+/**
+ * @file newton_cg_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the trust-region Newton-CG (truncated Newton) optimizer.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_NEWTON_CG_NEWTON_CG_IMPL_HPP
+#define ENSMALLEN_NEWTON_CG_NEWTON_CG_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "newton_cg.hpp"
+
+#include <ensmallen_bits/function.hpp>
+
+namespace ens {
+
+inline NewtonCG::NewtonCG(const size_t maxIterations,
+                          const double minGradientNorm,
+                          const double initialRadius,
+                          const double maxRadius,
+                          const size_t maxCGIterations,
+                          const double fdStep) :
+    maxIterations(maxIterations),
+    minGradientNorm(minGradientNorm),
+    initialRadius(initialRadius),
+    maxRadius(maxRadius),
+    maxCGIterations(maxCGIterations),
+    fdStep(fdStep)
+{ /* Nothing to do. */ }
+
+template<typename FunctionType, typename BaseMatType, typename BaseGradType>
+void NewtonCG::Hvp(std::true_type,
+                   FunctionType& f,
+                   const BaseMatType& coordinates,
+                   const BaseGradType& /* gradient */,
+                   const BaseGradType& v,
+                   BaseGradType& out,
+                   BaseMatType& /* workCoordinates */,
+                   BaseGradType& /* workGradient */)
+{
+  f.Hvp(coordinates, v, out);
+}
+
+template<typename FunctionType, typename BaseMatType, typename BaseGradType>
+void NewtonCG::Hvp(std::false_type,
+                   FunctionType& f,
+                   const BaseMatType& coordinates,
+                   const BaseGradType& gradient,
+                   const BaseGradType& v,
+                   BaseGradType& out,
+                   BaseMatType& workCoordinates,
+                   BaseGradType& workGradient)
+{
+  typedef typename BaseMatType::elem_type ElemType;
+
+  const ElemType vNorm = arma::norm(v, 2);
+  if (vNorm == ElemType(0))
+  {
+    out.zeros(v.n_rows, v.n_cols);
+    return;
+  }
+
+  // Scale the perturbation to the size of the iterate so that the forward
+  // difference stays accurate far from the origin.
+  const ElemType h = (ElemType) fdStep *
+      (1 + arma::norm(coordinates, 2)) / vNorm;
+
+  workCoordinates = coordinates + h * v;
+  f.Gradient(workCoordinates, workGradient);
+  out = (workGradient - gradient) / h;
+}
+
+//! Optimize the function (minimize).
+template<typename FunctionType,
+         typename MatType,
+         typename GradType,
+         typename... CallbackTypes>
+typename std::enable_if<IsArmaType<GradType>::value,
+    typename MatType::elem_type>::type
+NewtonCG::Optimize(FunctionType& function,
+                   MatType& iterateIn,
+                   CallbackTypes&&... callbacks)
+{
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef typename MatTypeTraits<GradType>::BaseMatType BaseGradType;
+
+  // Use the Function<> wrapper to ensure the function has all of the
+  // functions that we need.
+  typedef Function<FunctionType, BaseMatType, BaseGradType> FullFunctionType;
+  FullFunctionType& f = static_cast<FullFunctionType&>(function);
+
+  // Check that we have all the functions we will need.
+  traits::CheckFunctionTypeAPI<FullFunctionType, BaseMatType, BaseGradType>();
+  RequireFloatingPointType<BaseMatType>();
+  RequireFloatingPointType<BaseGradType>();
+  RequireSameInternalTypes<BaseMatType, BaseGradType>();
+
+  // Whether the function provides an exact Hessian-vector product; detected
+  // on the user's type, not the wrapper, since Hvp() cannot be synthesized.
+  typedef std::integral_constant<bool, traits::CheckHvp<
+      FunctionType, BaseMatType, BaseGradType>::value> HasExactHvp;
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+
+  // The working set: the gradient, the CG residual, direction and their
+  // Hessian products, the trial step, and scratch space for the
+  // finite-difference Hessian-vector product.
+  BaseGradType gradient(iterate.n_rows, iterate.n_cols);
+  BaseGradType r(iterate.n_rows, iterate.n_cols);
+  BaseGradType d(iterate.n_rows, iterate.n_cols);
+  BaseGradType hd(iterate.n_rows, iterate.n_cols);
+  BaseGradType z(iterate.n_rows, iterate.n_cols);
+  BaseGradType hz(iterate.n_rows, iterate.n_cols);
+  BaseMatType workCoordinates(iterate.n_rows, iterate.n_cols);
+  BaseGradType workGradient(iterate.n_rows, iterate.n_cols);
+
+  const size_t cgLimit = (maxCGIterations == 0) ?
+      std::max<size_t>(1, iterate.n_elem) : maxCGIterations;
+
+  // Controls early termination of the optimization process.
+  bool terminate = false;
+
+  ElemType functionValue = f.EvaluateWithGradient(iterate, gradient);
+  terminate |= Callback::EvaluateWithGradient(*this, f, iterate,
+      functionValue, gradient, callbacks...);
+
+  double radius = initialRadius;
+  const bool optimizeUntilConvergence = (maxIterations == 0);
+
+  Callback::BeginOptimization(*this, f, iterate, callbacks...);
+  for (size_t i = 0; (optimizeUntilConvergence || (i != maxIterations))
+      && !terminate; ++i)
+  {
+    const ElemType gradNorm = arma::norm(gradient, 2);
+    if (gradNorm < minGradientNorm)
+    {
+      Info << "NewtonCG gradient norm too small (terminating successfully)."
+          << std::endl;
+      break;
+    }
+
+    if (std::isnan(functionValue) || std::isinf(functionValue))
+    {
+      Warn << "NewtonCG terminated with objective " << functionValue << "; "
+          << "are the objective and gradient functions implemented "
+          << "correctly?" << std::endl;
+      break;
+    }
+
+    // Approximately minimize the local quadratic model inside the trust
+    // region with the Steihaug-Toint conjugate gradient method.  The
+    // Hessian product of the accumulated step is maintained alongside the
+    // step itself, so the predicted model reduction comes for free.
+    z.zeros();
+    hz.zeros();
+    r = gradient;
+    d = -gradient;
+    bool onBoundary = false;
+
+    // The inexact Newton forcing sequence: solve the system only as
+    // accurately as the gradient norm warrants (superlinear far out,
+    // quadratic near the solution).
+    const ElemType cgTolerance = std::min((ElemType) 0.5,
+        std::sqrt(gradNorm)) * gradNorm;
+
+    ElemType rr = gradNorm * gradNorm;
+    for (size_t j = 0; j < cgLimit; ++j)
+    {
+      Hvp(HasExactHvp(), f, iterate, gradient, d, hd, workCoordinates,
+          workGradient);
+
+      const ElemType dhd = arma::dot(d, hd);
+      const ElemType zd = arma::dot(z, d);
+      const ElemType dd = arma::dot(d, d);
+      const ElemType zz = arma::dot(z, z);
+
+      if (dhd <= 0)
+      {
+        // Negative curvature: follow the direction to the trust-region
+        // boundary.
+        const ElemType tau = (-zd + std::sqrt(zd * zd +
+            dd * ((ElemType) (radius * radius) - zz))) / dd;
+        z += tau * d;
+        hz += tau * hd;
+        onBoundary = true;
+        break;
+      }
+
+      const ElemType alpha = rr / dhd;
+      if (zz + 2 * alpha * zd + alpha * alpha * dd >=
+          (ElemType) (radius * radius))
+      {
+        // The full CG step leaves the trust region: stop at the boundary.
+        const ElemType tau = (-zd + std::sqrt(zd * zd +
+            dd * ((ElemType) (radius * radius) - zz))) / dd;
+        z += tau * d;
+        hz += tau * hd;
+        onBoundary = true;
+        break;
+      }
+
+      z += alpha * d;
+      hz += alpha * hd;
+      r += alpha * hd;
+
+      const ElemType rrNew = arma::dot(r, r);
+      if (std::sqrt(rrNew) < cgTolerance)
+        break;
+
+      d *= rrNew / rr;
+      d -= r;
+      rr = rrNew;
+    }
+
+    // The reduction the quadratic model predicts for the step.
+    const ElemType predicted = -(arma::dot(gradient, z) +
+        0.5 * arma::dot(z, hz));
+
+    workCoordinates = iterate + z;
+    const ElemType newValue = f.Evaluate(workCoordinates);
+    terminate |= Callback::Evaluate(*this, f, workCoordinates, newValue,
+        callbacks...);
+
+    // Agreement between the model and the actual objective change governs
+    // the trust-region update.
+    const ElemType rho = (predicted > 0) ?
+        (functionValue - newValue) / predicted : ElemType(-1);
+
+    if (rho < 0.25)
+      radius *= 0.25;
+    else if (rho > 0.75 && onBoundary)
+      radius = std::min(2 * radius, maxRadius);
+
+    if (rho > 1e-4)
+    {
+      // Accept the step and compute the gradient at the new iterate.
+      iterate = std::move(workCoordinates);
+      functionValue = newValue;
+      f.Gradient(iterate, gradient);
+      terminate |= Callback::Gradient(*this, f, iterate, gradient,
+          callbacks...);
+    }
+
+    if (radius < 1e-15)
+    {
+      Info << "NewtonCG trust-region radius collapsed (terminating "
+          << "successfully)." << std::endl;
+      break;
+    }
+
+    terminate |= Callback::StepTaken(*this, f, iterate, callbacks...);
+  }
+
+  Callback::EndOptimization(*this, f, iterate, callbacks...);
+  return functionValue;
+}
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,156 @@
+/**
+ * @file nonlinear_cg.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the nonlinear conjugate gradient optimizer with the
+ * Polak-Ribiere+ update and automatic restarts.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_NONLINEAR_CG_NONLINEAR_CG_HPP
+#define ENSMALLEN_NONLINEAR_CG_NONLINEAR_CG_HPP
+
+#include <ensmallen_bits/line_search/wolfe_line_search.hpp>
+
+namespace ens {
+
+/**
+ * Nonlinear conjugate gradient is a full-batch first-order optimizer: each
+ * iteration takes a strong-Wolfe line search along a direction that combines
+ * the current negative gradient with the previous direction, using the
+ * Polak-Ribiere+ conjugacy coefficient.  The method is restarted (the
+ * direction reset to steepest descent) when the PR+ coefficient is clipped
+ * at zero, when successive gradients lose orthogonality (the Powell
+ * criterion), on a periodic schedule, and whenever the computed direction is
+ * not a descent direction.
+ *
+ * In contrast to L-BFGS, which stores 2 * numBasis parameter-sized history
+ * vectors, nonlinear CG only carries the gradient, the previous gradient and
+ * the search direction (plus the line search's trial buffer), which makes it
+ * the practical full-batch choice when the parameter vector itself is near
+ * the memory budget.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @book{Nocedal2006,
+ *   author    = {Nocedal, Jorge and Wright, Stephen J.},
+ *   title     = {Numerical Optimization},
+ *   edition   = {2nd},
+ *   publisher = {Springer},
+ *   year      = {2006}
+ * }
+ * @endcode
+ *
+ * NonlinearCG can optimize differentiable functions.  For more details, see
+ * the documentation on function types included with this distribution or on
+ * the ensmallen website.
+ */
+class NonlinearCG
+{
+ public:
+  /**
+   * Construct the nonlinear conjugate gradient optimizer.
+   *
+   * @param maxIterations Maximum number of iterations allowed (0 means no
+   *     limit).
+   * @param minGradientNorm Minimum gradient norm required to continue the
+   *     optimization.
+   * @param factr Minimum relative function value decrease to continue the
+   *     optimization.
+   * @param restartInterval Number of iterations between periodic restarts
+   *     from steepest descent (0 restarts every n iterations, where n is
+   *     the number of parameters).
+   */
+  NonlinearCG(const size_t maxIterations = 10000,
+              const double minGradientNorm = 1e-10,
+              const double factr = 1e-15,
+              const size_t restartInterval = 0);
+
+  /**
+   * Optimize the given function using nonlinear conjugate gradient.  The
+   * given starting point will be modified to store the finishing point of
+   * the algorithm, and the final objective value is returned.
+   *
+   * @tparam FunctionType Type of the function to be optimized.
+   * @tparam MatType Type of matrix to optimize.
+   * @tparam GradType Type of matrix for the gradient.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to optimize.
+   * @param iterate Starting point (will be modified).
+   * @param callbacks Callback functions.
+   * @return Objective value of the final point.
+   */
+  template<typename FunctionType,
+           typename MatType,
+           typename GradType,
+           typename... CallbackTypes>
+  typename std::enable_if<IsArmaType<GradType>::value,
+      typename MatType::elem_type>::type
+  Optimize(FunctionType& function,
+           MatType& iterate,
+           CallbackTypes&&... callbacks);
+
+  //! Forward the MatType as GradType.
+  template<typename FunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(FunctionType& function,
+                                       MatType& iterate,
+                                       CallbackTypes&&... callbacks)
+  {
+    return Optimize<FunctionType, MatType, MatType, CallbackTypes...>(
+        function, iterate, std::forward<CallbackTypes>(callbacks)...);
+  }
+
+  //! Get the maximum number of iterations (0 indicates no limit).
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of iterations (0 indicates no limit).
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the minimum gradient norm.
+  double MinGradientNorm() const { return minGradientNorm; }
+  //! Modify the minimum gradient norm.
+  double& MinGradientNorm() { return minGradientNorm; }
+
+  //! Get the minimum relative function value decrease.
+  double Factr() const { return factr; }
+  //! Modify the minimum relative function value decrease.
+  double& Factr() { return factr; }
+
+  //! Get the periodic restart interval (0 restarts every n iterations).
+  size_t RestartInterval() const { return restartInterval; }
+  //! Modify the periodic restart interval.
+  size_t& RestartInterval() { return restartInterval; }
+
+  //! Get the line search.
+  const WolfeLineSearch& LineSearch() const { return lineSearch; }
+  //! Modify the line search (e.g. its Wolfe constants or trial budget).
+  WolfeLineSearch& LineSearch() { return lineSearch; }
+
+ private:
+  //! The maximum number of allowed iterations.
+  size_t maxIterations;
+
+  //! The minimum gradient norm.
+  double minGradientNorm;
+
+  //! The minimum relative function value decrease.
+  double factr;
+
+  //! The periodic restart interval.
+  size_t restartInterval;
+
+  //! The strong-Wolfe line search used along each direction.
+  WolfeLineSearch lineSearch;
+};
+
+} // namespace ens
+
+// Include implementation.
+#include "nonlinear_cg_impl.hpp"
+
+#endif
@@ -0,0 +1,175 @@
+/**
+ * @file nonlinear_cg_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the nonlinear conjugate gradient optimizer with the
+ * Polak-Ribiere+ update and automatic restarts.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_NONLINEAR_CG_NONLINEAR_CG_IMPL_HPP
+#define ENSMALLEN_NONLINEAR_CG_NONLINEAR_CG_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "nonlinear_cg.hpp"
+
+#include <ensmallen_bits/function.hpp>
+
+namespace ens {
+
+inline NonlinearCG::NonlinearCG(const size_t maxIterations,
+                                const double minGradientNorm,
+                                const double factr,
+                                const size_t restartInterval) :
+    maxIterations(maxIterations),
+    minGradientNorm(minGradientNorm),
+    factr(factr),
+    restartInterval(restartInterval)
+{ /* Nothing to do. */ }
+
+//! Optimize the function (minimize).
+template<typename FunctionType,
+         typename MatType,
+         typename GradType,
+         typename... CallbackTypes>
+typename std::enable_if<IsArmaType<GradType>::value,
+    typename MatType::elem_type>::type
+NonlinearCG::Optimize(FunctionType& function,
+                      MatType& iterateIn,
+                      CallbackTypes&&... callbacks)
+{
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef typename MatTypeTraits<GradType>::BaseMatType BaseGradType;
+
+  // Use the Function<> wrapper to ensure the function has all of the
+  // functions that we need.
+  typedef Function<FunctionType, BaseMatType, BaseGradType> FullFunctionType;
+  FullFunctionType& f = static_cast<FullFunctionType&>(function);
+
+  // Check that we have all the functions we will need.
+  traits::CheckFunctionTypeAPI<FullFunctionType, BaseMatType, BaseGradType>();
+  RequireFloatingPointType<BaseMatType>();
+  RequireFloatingPointType<BaseGradType>();
+  RequireSameInternalTypes<BaseMatType, BaseGradType>();
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+
+  // The complete working set: the gradient, the previous gradient, the
+  // search direction, and the line search's trial buffer.
+  BaseGradType gradient(iterate.n_rows, iterate.n_cols);
+  BaseGradType oldGradient(iterate.n_rows, iterate.n_cols);
+  BaseGradType direction(iterate.n_rows, iterate.n_cols);
+  BaseMatType newIterateTmp(iterate.n_rows, iterate.n_cols);
+
+  const size_t interval = (restartInterval == 0) ?
+      std::max<size_t>(1, iterate.n_elem) : restartInterval;
+
+  // Controls early termination of the optimization process.
+  bool terminate = false;
+
+  // The initial function value, gradient and direction.
+  ElemType functionValue = f.EvaluateWithGradient(iterate, gradient);
+  terminate |= Callback::EvaluateWithGradient(*this, f, iterate,
+      functionValue, gradient, callbacks...);
+  direction = -gradient;
+
+  const bool optimizeUntilConvergence = (maxIterations == 0);
+  size_t sinceRestart = 0;
+
+  Callback::BeginOptimization(*this, f, iterate, callbacks...);
+  for (size_t i = 0; (optimizeUntilConvergence || (i != maxIterations))
+      && !terminate; ++i)
+  {
+    // Break when the norm of the gradient becomes too small.
+    if (arma::norm(gradient, 2) < minGradientNorm)
+    {
+      Info << "Nonlinear CG gradient norm too small (terminating "
+          << "successfully)." << std::endl;
+      break;
+    }
+
+    // Break if the objective is not a number.
+    if (std::isnan(functionValue))
+    {
+      Warn << "Nonlinear CG terminated with objective " << functionValue
+          << "; are the objective and gradient functions implemented "
+          << "correctly?" << std::endl;
+      break;
+    }
+
+    // Fall back to steepest descent whenever the computed direction is not
+    // a descent direction.
+    if (arma::dot(direction, gradient) >= 0)
+    {
+      direction = -gradient;
+      sinceRestart = 0;
+    }
+
+    // Save the gradient before stepping; the line search overwrites it
+    // with the gradient at the new iterate.
+    oldGradient = gradient;
+    const ElemType prevFunctionValue = functionValue;
+
+    double stepSize; // Set by Search().
+    if (!lineSearch.Search(*this, f, functionValue, iterate, gradient,
+        newIterateTmp, direction, stepSize, terminate, callbacks...))
+    {
+      Warn << "Nonlinear CG line search failed; terminating optimization."
+          << std::endl;
+      break;
+    }
+
+    // It is possible that the difference between the two coordinates is
+    // zero.  In this case we terminate successfully.
+    if (stepSize == 0.0)
+    {
+      Info << "Nonlinear CG step size of 0 (terminating successfully)."
+          << std::endl;
+      break;
+    }
+
+    // If we can't make progress on the gradient, then we'll also accept a
+    // stable function value.
+    const double denom = std::max(
+        std::max(std::abs(prevFunctionValue), std::abs(functionValue)),
+        (ElemType) 1.0);
+    if ((prevFunctionValue - functionValue) / denom <= factr)
+    {
+      Info << "Nonlinear CG function value stable (terminating "
+          << "successfully)." << std::endl;
+      break;
+    }
+
+    // The Polak-Ribiere+ coefficient; the clip at zero is itself a restart
+    // to steepest descent.
+    const double gg = arma::dot(oldGradient, oldGradient);
+    double beta = std::max(0.0,
+        arma::dot(gradient, gradient - oldGradient) / gg);
+
+    // Automatic restarts: periodically, and when successive gradients lose
+    // orthogonality (the Powell criterion).
+    ++sinceRestart;
+    if (sinceRestart >= interval || std::abs(arma::dot(gradient,
+        oldGradient)) >= 0.2 * arma::dot(gradient, gradient))
+      beta = 0;
+    if (beta == 0)
+      sinceRestart = 0;
+
+    direction *= (ElemType) beta;
+    direction -= gradient;
+
+    terminate |= Callback::StepTaken(*this, f, iterate, callbacks...);
+  }
+
+  Callback::EndOptimization(*this, f, iterate, callbacks...);
+  return functionValue;
+}
+
+} // namespace ens
+
+#endif
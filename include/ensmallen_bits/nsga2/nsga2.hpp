@@ -160,6 +160,27 @@ class NSGA2
   //! Modify the tolerance.
   double& Epsilon() { return epsilon; }
 
+  //! Get whether the population objective evaluations run in parallel with
+  //! OpenMP (requires the Evaluate() methods of all objectives to be
+  //! thread-safe).
+  bool ParallelEvaluation() const { return parallelEvaluation; }
+  //! Modify whether the population objective evaluations run in parallel.
+  bool& ParallelEvaluation() { return parallelEvaluation; }
+
+  //! Get whether the efficient non-dominated sort (lexicographic presort plus
+  //! binary search over the fronts) is used instead of the pairwise
+  //! O(MN^2) fast non-dominated sort.
+  bool EfficientSort() const { return efficientSort; }
+  //! Modify whether the efficient non-dominated sort is used.
+  bool& EfficientSort() { return efficientSort; }
+
+  //! Get whether duplicate offspring are detected via genome fingerprints,
+  //! so that candidates identical to an already-scored genome are served
+  //! their cached objective vectors instead of being re-evaluated.
+  bool DuplicateCaching() const { return duplicateCaching; }
+  //! Modify whether duplicate offspring reuse cached objective evaluations.
+  bool& DuplicateCaching() { return duplicateCaching; }
+
   //! Retrieve value of lowerBound.
   const arma::vec& LowerBound() const { return lowerBound; }
   //! Modify value of lowerBound.
@@ -200,7 +221,9 @@ class NSGA2
 
  private:
   /**
-   * Evaluate objectives for the elite population.
+   * Evaluate objectives for the elite population.  This dispatches to the
+   * shared PopulationEvaluator, which runs the members in parallel when
+   * parallelEvaluation is set.
    *
    * @tparam ArbitraryFunctionType std::tuple of multiple function types.
    * @tparam MatType Type of matrix to optimize.
@@ -208,22 +231,12 @@ class NSGA2
    * @param objectives The set of objectives.
    * @param calculatedObjectives Vector to store calculated objectives.
    */
-  template<std::size_t I = 0,
-           typename MatType,
-           typename ...ArbitraryFunctionType>
-  typename std::enable_if<I == sizeof...(ArbitraryFunctionType), void>::type
-  EvaluateObjectives(std::vector<MatType>&,
-                     std::tuple<ArbitraryFunctionType...>&,
-                     std::vector<arma::Col<typename MatType::elem_type> >&);
-
-  template<std::size_t I = 0,
-           typename MatType,
+  template<typename MatType,
            typename ...ArbitraryFunctionType>
-  typename std::enable_if<I < sizeof...(ArbitraryFunctionType), void>::type
-  EvaluateObjectives(std::vector<MatType>& population,
-                     std::tuple<ArbitraryFunctionType...>& objectives,
-                     std::vector<arma::Col<typename MatType::elem_type> >&
-                     calculatedObjectives);
+  void EvaluateObjectives(std::vector<MatType>& population,
+                          std::tuple<ArbitraryFunctionType...>& objectives,
+                          std::vector<arma::Col<typename MatType::elem_type> >&
+                          calculatedObjectives);
 
   /**
    * Reproduce candidates from the elite population to generate a new
@@ -285,6 +298,40 @@ class NSGA2
       std::vector<size_t>& ranks,
       std::vector<arma::Col<typename MatType::elem_type> >& calculatedObjectives);
 
+  /**
+   * Sort the candidate population into Pareto fronts with the efficient
+   * non-dominated sort (ENS-BS).  The objective vectors are first packed into
+   * one contiguous objectives-by-population matrix, the candidates are sorted
+   * lexicographically by their objectives, and each candidate is then placed
+   * by binary search over the already-built fronts, so a candidate is only
+   * compared against members of the fronts it may belong to instead of the
+   * whole population.  The produced fronts and ranks are identical to those
+   * of FastNonDominatedSort().
+   *
+   * For more information, see:
+   *
+   * @code
+   * @article{Zhang2015,
+   *   author  = {Xingyi Zhang and Ye Tian and Ran Cheng and Yaochu Jin},
+   *   title   = {An Efficient Approach to Nondominated Sorting for
+   *              Evolutionary Multiobjective Optimization},
+   *   journal = {IEEE Transactions on Evolutionary Computation},
+   *   year    = {2015}
+   * }
+   * @endcode
+   *
+   * @tparam MatType Type of matrix to optimize.
+   * @param fronts The population is sorted into these Pareto fronts. The first
+   *     front is the best, the second worse and so on.
+   * @param ranks The assigned ranks, used for crowding distance based sorting.
+   * @param calculatedObjectives The previously calculated objectives.
+   */
+  template<typename MatType>
+  void EfficientNonDominatedSort(
+      std::vector<std::vector<size_t> >& fronts,
+      std::vector<size_t>& ranks,
+      std::vector<arma::Col<typename MatType::elem_type> >& calculatedObjectives);
+
   /**
    * Operator to check if one candidate Pareto-dominates the other.
    *
@@ -364,6 +411,15 @@ class NSGA2
   //! The tolerance for termination.
   double epsilon;
 
+  //! Whether the population objective evaluations run in parallel.
+  bool parallelEvaluation;
+
+  //! Whether the efficient non-dominated sort is used.
+  bool efficientSort;
+
+  //! Whether duplicate offspring reuse cached objective evaluations.
+  bool duplicateCaching;
+
   //! Lower bound of the initial swarm.
   arma::vec lowerBound;
 
@@ -17,6 +17,7 @@
 
 #include "nsga2.hpp"
 #include <assert.h>
+#include <unordered_map>
 
 namespace ens {
 
@@ -36,6 +37,9 @@ inline NSGA2::NSGA2(const size_t populationSize,
     mutationProb(mutationProb),
     mutationStrength(mutationStrength),
     epsilon(epsilon),
+    parallelEvaluation(false),
+    efficientSort(false),
+    duplicateCaching(false),
     lowerBound(lowerBound),
     upperBound(upperBound)
 { /* Nothing to do here. */ }
@@ -56,6 +60,9 @@ inline NSGA2::NSGA2(const size_t populationSize,
     mutationProb(mutationProb),
     mutationStrength(mutationStrength),
     epsilon(epsilon),
+    parallelEvaluation(false),
+    efficientSort(false),
+    duplicateCaching(false),
     lowerBound(lowerBound * arma::ones(1, 1)),
     upperBound(upperBound * arma::ones(1, 1))
 { /* Nothing to do here. */ }
@@ -124,6 +131,30 @@ typename MatType::elem_type NSGA2::Optimize(
   const BaseMatType castedLowerBound = arma::conv_to<BaseMatType>::from(lowerBound);
   const BaseMatType castedUpperBound = arma::conv_to<BaseMatType>::from(upperBound);
 
+  // When duplicate caching is enabled, previously scored genomes are
+  // remembered in a fingerprint table: the key is a byte-level hash of the
+  // genome matrix, and every entry keeps the genome itself so that hash
+  // collisions cannot serve the wrong objectives.  Crossover and mutation
+  // frequently regenerate candidates that were already scored (especially
+  // on discrete or mixed design spaces), and a table hit skips all of the
+  // member's objective evaluations.
+  std::unordered_map<uint64_t,
+      std::vector<std::pair<BaseMatType, arma::Col<ElemType> > > >
+      evaluationCache;
+  const auto fingerprint = [](const BaseMatType& member)
+  {
+    // FNV-1a over the raw genome bytes.
+    const unsigned char* bytes =
+        reinterpret_cast<const unsigned char*>(member.memptr());
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t b = 0; b < member.n_elem * sizeof(ElemType); ++b)
+    {
+      hash ^= (uint64_t) bytes[b];
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  };
+
   // Controls early termination of the optimization process.
   bool terminate = false;
 
@@ -155,11 +186,58 @@ typename MatType::elem_type NSGA2::Optimize(
     calculatedObjectives.resize(population.size());
     std::fill(calculatedObjectives.begin(), calculatedObjectives.end(),
         arma::Col<ElemType>(numObjectives, arma::fill::zeros));
-    EvaluateObjectives(population, objectives, calculatedObjectives);
+    if (duplicateCaching)
+    {
+      // Consult the fingerprint table first, so that only genomes that have
+      // never been scored before pay their objective evaluations.
+      std::vector<BaseMatType> uncached;
+      std::vector<size_t> uncachedIndices;
+      for (size_t i = 0; i < populationSize; i++)
+      {
+        bool cached = false;
+        for (const auto& entry : evaluationCache[fingerprint(population[i])])
+        {
+          if (entry.first.n_elem == population[i].n_elem &&
+              std::memcmp(entry.first.memptr(), population[i].memptr(),
+                  population[i].n_elem * sizeof(ElemType)) == 0)
+          {
+            calculatedObjectives[i] = entry.second;
+            cached = true;
+            break;
+          }
+        }
 
-    // Perform fast non dominated sort on P_t ∪ G_t.
+        if (!cached)
+        {
+          uncached.push_back(population[i]);
+          uncachedIndices.push_back(i);
+        }
+      }
+
+      // Evaluate the cache misses and remember their results.
+      std::vector<arma::Col<ElemType> > uncachedObjectives(uncached.size(),
+          arma::Col<ElemType>(numObjectives, arma::fill::zeros));
+      PopulationEvaluator::Evaluate(uncached, objectives, uncachedObjectives,
+          uncached.size(), parallelEvaluation);
+      for (size_t k = 0; k < uncached.size(); k++)
+      {
+        calculatedObjectives[uncachedIndices[k]] = uncachedObjectives[k];
+        evaluationCache[fingerprint(uncached[k])].emplace_back(
+            std::move(uncached[k]), std::move(uncachedObjectives[k]));
+      }
+    }
+    else
+    {
+      EvaluateObjectives(population, objectives, calculatedObjectives);
+    }
+
+    // Perform non dominated sort on P_t ∪ G_t.
     ranks.resize(population.size());
-    FastNonDominatedSort<BaseMatType>(fronts, ranks, calculatedObjectives);
+    if (efficientSort)
+      EfficientNonDominatedSort<BaseMatType>(fronts, ranks,
+          calculatedObjectives);
+    else
+      FastNonDominatedSort<BaseMatType>(fronts, ranks, calculatedObjectives);
 
     // Perform crowding distance assignment.
     crowdingDistance.resize(population.size());
@@ -170,25 +248,26 @@ typename MatType::elem_type NSGA2::Optimize(
           fronts[fNum], calculatedObjectives, crowdingDistance);
     }
 
-    // Sort based on crowding distance.
-    std::sort(population.begin(), population.end(),
-      [this, ranks, crowdingDistance, population]
-        (BaseMatType candidateP, BaseMatType candidateQ)
+    // Sort based on rank and crowding distance.  The indices are sorted and
+    // the permutation applied afterwards: comparing indices directly avoids
+    // the per-comparison scans over the whole population that identifying
+    // candidates by matrix value would need.
+    arma::uvec selectionOrder =
+        arma::regspace<arma::uvec>(0, 1, population.size() - 1);
+    std::sort(selectionOrder.begin(), selectionOrder.end(),
+      [this, &ranks, &crowdingDistance]
+        (const arma::uword idxP, const arma::uword idxQ)
           {
-            size_t idxP{}, idxQ{};
-            for (size_t i = 0; i < population.size(); i++)
-            {
-              if (arma::approx_equal(population[i], candidateP, "absdiff", epsilon))
-                idxP = i;
-
-              if (arma::approx_equal(population[i], candidateQ, "absdiff", epsilon))
-                idxQ = i;
-            }
-
-            return CrowdingOperator<BaseMatType>(idxP, idxQ, ranks, crowdingDistance);
+            return CrowdingOperator<BaseMatType>(idxP, idxQ, ranks,
+                crowdingDistance);
           }
     );
 
+    std::vector<BaseMatType> sortedPopulation(population.size());
+    for (size_t i = 0; i < population.size(); i++)
+      sortedPopulation[i] = std::move(population[selectionOrder(i)]);
+    population = std::move(sortedPopulation);
+
     // Yield a new population P_{t+1} of size populationSize.
     // Discards unfit population from the R_{t} to yield P_{t+1}.
     population.resize(populationSize);
@@ -234,35 +313,16 @@ typename MatType::elem_type NSGA2::Optimize(
   return performance;
 }
 
-//! No objectives to evaluate.
-template<std::size_t I,
-         typename MatType,
-         typename ...ArbitraryFunctionType>
-typename std::enable_if<I == sizeof...(ArbitraryFunctionType), void>::type
-NSGA2::EvaluateObjectives(
-    std::vector<MatType>&,
-    std::tuple<ArbitraryFunctionType...>&,
-    std::vector<arma::Col<typename MatType::elem_type> >&)
-{
-  // Nothing to do here.
-}
-
 //! Evaluate the objectives for the entire population.
-template<std::size_t I,
-         typename MatType,
+template<typename MatType,
          typename ...ArbitraryFunctionType>
-typename std::enable_if<I < sizeof...(ArbitraryFunctionType), void>::type
-NSGA2::EvaluateObjectives(
+void NSGA2::EvaluateObjectives(
     std::vector<MatType>& population,
     std::tuple<ArbitraryFunctionType...>& objectives,
     std::vector<arma::Col<typename MatType::elem_type> >& calculatedObjectives)
 {
-  for (size_t i = 0; i < populationSize; i++)
-  {
-    calculatedObjectives[i](I) = std::get<I>(objectives).Evaluate(population[i]);
-    EvaluateObjectives<I+1, MatType, ArbitraryFunctionType...>(population, objectives,
-                                                               calculatedObjectives);
-  }
+  PopulationEvaluator::Evaluate(population, objectives, calculatedObjectives,
+      populationSize, parallelEvaluation);
 }
 
 //! Reproduce and generate new candidates.
@@ -271,9 +331,16 @@ inline void NSGA2::BinaryTournamentSelection(std::vector<MatType>& population,
                                              const MatType& lowerBound,
                                              const MatType& upperBound)
 {
-  std::vector<MatType> children;
-
-  while (children.size() < population.size())
+  // Generate the whole offspring batch at once: the selected parents are
+  // gathered into contiguous candidates-as-columns matrices, and crossover
+  // and mutation run as masked operations over the entire batch instead of
+  // allocating per-child temporaries.
+  const size_t numPairs = population.size() / 2;
+  const size_t candidateElems = population[0].n_elem;
+
+  MatType parentsA(candidateElems, numPairs);
+  MatType parentsB(candidateElems, numPairs);
+  for (size_t j = 0; j < numPairs; j++)
   {
     // Choose two random parents for reproduction from the elite population.
     size_t indexA = arma::randi<size_t>(arma::distr_param(0, populationSize - 1));
@@ -288,21 +355,33 @@ inline void NSGA2::BinaryTournamentSelection(std::vector<MatType>& population,
         indexB--;
     }
 
-    // Initialize the children to the respective parents.
-    MatType childA = population[indexA], childB = population[indexB];
-
-    Crossover(childA, childB, population[indexA], population[indexB]);
-
-    Mutate(childA, lowerBound, upperBound);
-    Mutate(childB, lowerBound, upperBound);
-
-    // Add the children to the candidate population.
-    children.push_back(childA);
-    children.push_back(childB);
+    parentsA.col(j) = arma::vectorise(population[indexA]);
+    parentsB.col(j) = arma::vectorise(population[indexB]);
   }
 
-  // Add the candidates to the elite population.
-  population.insert(std::end(population), std::begin(children), std::end(children));
+  // Initialize the children to the respective parents; Crossover() and
+  // Mutate() are elementwise, so the column batches go through the same
+  // code as single candidates.
+  MatType childrenA = parentsA, childrenB = parentsB;
+  Crossover(childrenA, childrenB, parentsA, parentsB);
+
+  const MatType lowerBoundBatch =
+      arma::repmat(arma::vectorise(lowerBound), 1, numPairs);
+  const MatType upperBoundBatch =
+      arma::repmat(arma::vectorise(upperBound), 1, numPairs);
+  Mutate(childrenA, lowerBoundBatch, upperBoundBatch);
+  Mutate(childrenB, lowerBoundBatch, upperBoundBatch);
+
+  // Unpack the columns and add the candidates to the elite population.
+  const size_t candidateRows = population[0].n_rows;
+  const size_t candidateCols = population[0].n_cols;
+  for (size_t j = 0; j < numPairs; j++)
+  {
+    population.push_back(arma::reshape(childrenA.col(j), candidateRows,
+        candidateCols));
+    population.push_back(arma::reshape(childrenB.col(j), candidateRows,
+        candidateCols));
+  }
 }
 
 //! Perform crossover of genes for the children.
@@ -318,7 +397,7 @@ inline void NSGA2::Crossover(MatType& childA,
   // Use traits from parentA for indices where idx is 1 and parentB otherwise.
   childA = parentA % idx + parentB % (1 - idx);
   // Use traits from parentB for indices where idx is 1 and parentA otherwise.
-  childB = parentA % (1 - idx) + parentA % idx;
+  childB = parentB % idx + parentA % (1 - idx);
 }
 
 //! Perform mutation of the candidates weights with some noise.
@@ -395,6 +474,95 @@ inline void NSGA2::FastNonDominatedSort(
   fronts.pop_back();
 }
 
+//! Sort population into Pareto fronts with the efficient non-dominated sort.
+template<typename MatType>
+inline void NSGA2::EfficientNonDominatedSort(
+    std::vector<std::vector<size_t> >& fronts,
+    std::vector<size_t>& ranks,
+    std::vector<arma::Col<typename MatType::elem_type> >& calculatedObjectives)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  const size_t numMembers = populationSize;
+  const size_t numObj = calculatedObjectives[0].n_elem;
+
+  // Pack the objective vectors into one contiguous objectives-by-population
+  // matrix so the dominance comparisons below walk cache-resident columns.
+  arma::Mat<ElemType> objectives(numObj, numMembers);
+  for (size_t i = 0; i < numMembers; ++i)
+    objectives.col(i) = calculatedObjectives[i];
+
+  // Sort the candidates lexicographically by their objectives.  After this, a
+  // candidate can only be dominated by candidates that appear before it.
+  arma::uvec order = arma::regspace<arma::uvec>(0, 1, numMembers - 1);
+  std::sort(order.begin(), order.end(),
+      [&](const arma::uword a, const arma::uword b)
+      {
+        for (size_t m = 0; m < numObj; ++m)
+        {
+          if (objectives(m, a) < objectives(m, b))
+            return true;
+          else if (objectives(m, a) > objectives(m, b))
+            return false;
+        }
+        return a < b;
+      });
+
+  // Column-wise dominance check on the contiguous objectives matrix.
+  auto dominates = [&](const arma::uword p, const arma::uword q)
+  {
+    const ElemType* colP = objectives.colptr(p);
+    const ElemType* colQ = objectives.colptr(q);
+    bool atleastOneBetter = false;
+    for (size_t m = 0; m < numObj; ++m)
+    {
+      if (colP[m] > colQ[m])
+        return false;
+      else if (colP[m] < colQ[m])
+        atleastOneBetter = true;
+    }
+    return atleastOneBetter;
+  };
+
+  fronts.clear();
+
+  // Insert the candidates in lexicographic order: binary search for the first
+  // front with no member dominating the candidate (dominance against the
+  // fronts is monotone under this insertion order), so each candidate is only
+  // compared against the members of the fronts visited by the search.  The
+  // most recently inserted members of a front are checked first, since they
+  // are lexicographically closest and the most likely dominators.
+  for (size_t i = 0; i < numMembers; ++i)
+  {
+    const arma::uword p = order(i);
+
+    size_t lo = 0, hi = fronts.size();
+    while (lo < hi)
+    {
+      const size_t mid = lo + (hi - lo) / 2;
+      bool dominated = false;
+      for (size_t j = fronts[mid].size(); j > 0; --j)
+      {
+        if (dominates(fronts[mid][j - 1], p))
+        {
+          dominated = true;
+          break;
+        }
+      }
+
+      if (dominated)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+    if (lo == fronts.size())
+      fronts.push_back(std::vector<size_t>());
+    fronts[lo].push_back(p);
+    ranks[p] = lo;
+  }
+}
+
 //! Check if a candidate Pareto dominates another candidate.
 template<typename MatType>
 inline bool NSGA2::Dominates(
@@ -431,25 +599,23 @@ inline void NSGA2::CrowdingDistanceAssignment(
   typedef typename MatType::elem_type ElemType;
 
   size_t fSize = front.size();
-  // Stores the sorted indices of the fronts.
-  arma::uvec sortedIdx  = arma::regspace<arma::uvec>(0, 1, fSize - 1);
+
+  // Gather the objective values of the front into one contiguous matrix (one
+  // column per objective), so every per-objective sort below runs on
+  // cache-resident data instead of chasing the per-member objective vectors.
+  arma::Mat<ElemType> frontObjectives(fSize, numObjectives);
+  for (size_t i = 0; i < fSize; i++)
+    for (size_t m = 0; m < numObjectives; m++)
+      frontObjectives(i, m) = calculatedObjectives[front[i]](m);
 
   for (size_t m = 0; m < numObjectives; m++)
   {
-    // Cache fValues of individuals for current objective.
-    arma::Col<ElemType> fValues(fSize);
-    std::transform(front.begin(), front.end(), fValues.begin(),
-      [&](const size_t& individual)
-        {
-          return calculatedObjectives[individual](m);
-        });
+    // fValues of individuals for the current objective, as a contiguous
+    // column.
+    const arma::Col<ElemType> fValues = frontObjectives.col(m);
 
     // Sort front indices by ascending fValues for current objective.
-    std::sort(sortedIdx.begin(), sortedIdx.end(),
-      [&](const size_t& frontIdxA, const size_t& frontIdxB)
-        {
-          return (fValues(frontIdxA) < fValues(frontIdxB));
-        });
+    const arma::uvec sortedIdx = arma::sort_index(fValues);
 
     crowdingDistance[front[sortedIdx(0)]] =
         std::numeric_limits<ElemType>::max();
@@ -0,0 +1,330 @@
+/**
+ * @file steady_state_nsga2.hpp
+ * @author Marcus Edel
+ *
+ * An asynchronous steady-state variant of NSGA-II: variation and objective
+ * evaluation are pipelined through a pool of worker threads, and every scored
+ * candidate is inserted into the population immediately instead of waiting
+ * for a full offspring generation.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef ENSMALLEN_NSGA2_STEADY_STATE_NSGA2_HPP
+#define ENSMALLEN_NSGA2_STEADY_STATE_NSGA2_HPP
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace ens {
+
+/**
+ * SteadyStateNSGA2 is an asynchronous steady-state variant of the NSGA-II
+ * multi-objective optimizer.  Where the generational NSGA2 waits for the
+ * entire offspring population to be evaluated before selecting the next
+ * generation, this variant keeps a fixed-size evaluation pipeline busy at
+ * all times: binary tournament selection, crossover and mutation produce
+ * candidates continuously on the optimization thread, a pool of worker
+ * threads evaluates them, and every completed individual is inserted into
+ * the population (replacing the current worst member by the rank and
+ * crowding distance criteria) as soon as its objectives are known.
+ *
+ * Because there is no generation barrier, the evaluation workers stay fully
+ * utilized even when the objective cost varies strongly between candidates;
+ * a slow evaluation only delays its own insertion, not the whole
+ * generation.  This requires the Evaluate() methods of all the objectives
+ * to be thread-safe.
+ *
+ * The total evaluation budget matches the generational optimizer with the
+ * same parameters: maxGenerations * populationSize offspring are scored and
+ * inserted, and callbacks see one generational step per populationSize
+ * insertions.
+ *
+ * For more information, see the following:
+ *
+ * @code
+ * @article{10.1109/4235.996017,
+ *   author = {Deb, K. and Pratap, A. and Agarwal, S. and Meyarivan, T.},
+ *   title = {A Fast and Elitist Multiobjective Genetic Algorithm: NSGA-II},
+ *   year = {2002},
+ *   url = {https://doi.org/10.1109/4235.996017},
+ *   journal = {Trans. Evol. Comp}}
+ * @endcode
+ *
+ * @code
+ * @inproceedings{10.1145/1569901.1569995,
+ *   author = {Durillo, Juan J. and Nebro, Antonio J. and Luna, Francisco
+ *       and Alba, Enrique},
+ *   title = {On the Effect of the Steady-State Selection Scheme in
+ *       Multi-Objective Genetic Algorithms},
+ *   booktitle = {Evolutionary Multi-Criterion Optimization},
+ *   year = {2009}}
+ * @endcode
+ *
+ * SteadyStateNSGA2 can optimize arbitrary multi-objective functions.  For
+ * more details, see the documentation on function types included with this
+ * distribution or on the ensmallen website.
+ */
+class SteadyStateNSGA2
+{
+ public:
+  /**
+   * Constructor for the SteadyStateNSGA2 optimizer.
+   *
+   * The default values provided over here are not necessarily suitable for a
+   * given function. Therefore it is highly recommended to adjust the
+   * parameters according to the problem.
+   *
+   * @param populationSize The number of candidates in the population.
+   *     This should be at least 4 in size.
+   * @param maxGenerations The evaluation budget, counted in generation
+   *     equivalents: maxGenerations * populationSize offspring are scored.
+   * @param crossoverProb The probability that a crossover will occur.
+   * @param mutationProb The probability that a mutation will occur.
+   * @param mutationStrength The strength of the mutation.
+   * @param epsilon The minimum difference required to distinguish between
+   *     candidate solutions.
+   * @param lowerBound Lower bound of the coordinates of the initial population.
+   * @param upperBound Upper bound of the coordinates of the initial population.
+   */
+  SteadyStateNSGA2(const size_t populationSize = 100,
+                   const size_t maxGenerations = 2000,
+                   const double crossoverProb = 0.6,
+                   const double mutationProb = 0.3,
+                   const double mutationStrength = 1e-3,
+                   const double epsilon = 1e-6,
+                   const arma::vec& lowerBound = arma::zeros(1, 1),
+                   const arma::vec& upperBound = arma::ones(1, 1));
+
+  /**
+   * Constructor for the SteadyStateNSGA2 optimizer. This constructor provides
+   * an overload to use `lowerBound` and `upperBound` of type double.
+   *
+   * The default values provided over here are not necessarily suitable for a
+   * given function. Therefore it is highly recommended to adjust the
+   * parameters according to the problem.
+   *
+   * @param populationSize The number of candidates in the population.
+   *     This should be at least 4 in size.
+   * @param maxGenerations The evaluation budget, counted in generation
+   *     equivalents: maxGenerations * populationSize offspring are scored.
+   * @param crossoverProb The probability that a crossover will occur.
+   * @param mutationProb The probability that a mutation will occur.
+   * @param mutationStrength The strength of the mutation.
+   * @param epsilon The minimum difference required to distinguish between
+   *     candidate solutions.
+   * @param lowerBound Lower bound of the coordinates of the initial population.
+   * @param upperBound Upper bound of the coordinates of the initial population.
+   */
+  SteadyStateNSGA2(const size_t populationSize = 100,
+                   const size_t maxGenerations = 2000,
+                   const double crossoverProb = 0.6,
+                   const double mutationProb = 0.3,
+                   const double mutationStrength = 1e-3,
+                   const double epsilon = 1e-6,
+                   const double lowerBound = 0,
+                   const double upperBound = 1);
+
+  /**
+   * Optimize a set of objectives. The initial population is generated using
+   * the starting point. The output is the best generated front.
+   *
+   * @tparam ArbitraryFunctionType std::tuple of multiple objectives.
+   * @tparam MatType Type of matrix to optimize.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param objectives Vector of objective functions to optimize for.
+   * @param iterate Starting point.
+   * @param callbacks Callback functions.
+   * @return MatType::elem_type The minimum of the accumulated sum over the
+   *     objective values in the best front.
+   */
+  template<typename MatType,
+           typename... ArbitraryFunctionType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(
+      std::tuple<ArbitraryFunctionType...>& objectives,
+      MatType& iterate,
+      CallbackTypes&&... callbacks);
+
+  //! Get the population size.
+  size_t PopulationSize() const { return populationSize; }
+  //! Modify the population size.
+  size_t& PopulationSize() { return populationSize; }
+
+  //! Get the evaluation budget in generation equivalents.
+  size_t MaxGenerations() const { return maxGenerations; }
+  //! Modify the evaluation budget in generation equivalents.
+  size_t& MaxGenerations() { return maxGenerations; }
+
+  //! Get the crossover rate.
+  double CrossoverRate() const { return crossoverProb; }
+  //! Modify the crossover rate.
+  double& CrossoverRate() { return crossoverProb; }
+
+  //! Get the mutation probability.
+  double MutationProbability() const { return mutationProb; }
+  //! Modify the mutation probability.
+  double& MutationProbability() { return mutationProb; }
+
+  //! Get the mutation strength.
+  double MutationStrength() const { return mutationStrength; }
+  //! Modify the mutation strength.
+  double& MutationStrength() { return mutationStrength; }
+
+  //! Get the tolerance.
+  double Epsilon() const { return epsilon; }
+  //! Modify the tolerance.
+  double& Epsilon() { return epsilon; }
+
+  //! Get the number of in-flight evaluations (which is also the number of
+  //! evaluation worker threads).
+  size_t PipelineDepth() const { return pipelineDepth; }
+  //! Modify the number of in-flight evaluations.
+  size_t& PipelineDepth() { return pipelineDepth; }
+
+  //! Retrieve value of lowerBound.
+  const arma::vec& LowerBound() const { return lowerBound; }
+  //! Modify value of lowerBound.
+  arma::vec& LowerBound() { return lowerBound; }
+
+  //! Retrieve value of upperBound.
+  const arma::vec& UpperBound() const { return upperBound; }
+  //! Modify value of upperBound.
+  arma::vec& UpperBound() { return upperBound; }
+
+  //! Retrieve the Pareto optimal points in variable space. This returns an
+  //! empty cube until `Optimize()` has been called.
+  const arma::cube& ParetoSet() const { return paretoSet; }
+
+  //! Retrieve the best front (the Pareto frontier). This returns an empty
+  //! cube until `Optimize()` has been called.
+  const arma::cube& ParetoFront() const { return paretoFront; }
+
+ private:
+  /**
+   * Sort the given members into Pareto fronts, assigning a rank to every
+   * member.  Unlike the generational optimizer, the number of members is
+   * taken from calculatedObjectives: the steady-state insertion step sorts
+   * populationSize + 1 members to find the one to discard.
+   *
+   * @tparam MatType Type of matrix to optimize.
+   * @param fronts The Pareto fronts, composed of indices of the members.
+   * @param ranks The assigned ranks, used for crowding distance based sorting.
+   * @param calculatedObjectives The previously calculated objectives.
+   */
+  template<typename MatType>
+  void FastNonDominatedSort(
+      std::vector<std::vector<size_t> >& fronts,
+      std::vector<size_t>& ranks,
+      std::vector<arma::Col<typename MatType::elem_type> >&
+          calculatedObjectives);
+
+  /**
+   * Operator to check if one candidate Pareto-dominates the other.
+   *
+   * A candidate is said to dominate the other if it is at least as good as
+   * the other candidate for all the objectives and there exists at least one
+   * objective for which it is strictly better than the other candidate.
+   *
+   * @tparam MatType Type of matrix to optimize.
+   * @param calculatedObjectives The previously calculated objectives.
+   * @param candidateP The candidate being compared from the population.
+   * @param candidateQ The candidate being compared against.
+   * @return true if candidateP Pareto dominates candidateQ, otherwise, false.
+   */
+  template<typename MatType>
+  bool Dominates(
+      std::vector<arma::Col<typename MatType::elem_type> >&
+          calculatedObjectives,
+      size_t candidateP,
+      size_t candidateQ);
+
+  /**
+   * Assigns crowding distance metric for sorting.
+   *
+   * @param front The previously generated Pareto front.
+   * @param calculatedObjectives The previously calculated objectives.
+   * @param crowdingDistance The crowding distance for each individual in
+   *    the population.
+   */
+  template<typename MatType>
+  void CrowdingDistanceAssignment(
+      const std::vector<size_t>& front,
+      std::vector<arma::Col<typename MatType::elem_type> >&
+          calculatedObjectives,
+      std::vector<typename MatType::elem_type>& crowdingDistance);
+
+  /**
+   * The operator used in the crowding distance based sorting.
+   *
+   * If a candidate has a lower rank then it is preferred.
+   * Otherwise, if the ranks are equal then the candidate with the larger
+   * crowding distance is preferred.
+   *
+   * @param idxP The index of the first candidate being compared.
+   * @param idxQ The index of the second candidate being compared.
+   * @param ranks The previously calculated ranks.
+   * @param crowdingDistance The crowding distance for each individual in
+   *    the population.
+   * @return true if the first candidate is preferred, otherwise, false.
+   */
+  template<typename MatType>
+  bool CrowdingOperator(
+      size_t idxP,
+      size_t idxQ,
+      const std::vector<size_t>& ranks,
+      const std::vector<typename MatType::elem_type>& crowdingDistance);
+
+  //! The number of objectives being optimised for.
+  size_t numObjectives;
+
+  //! The number of variables used per objectives.
+  size_t numVariables;
+
+  //! The number of candidates in the population.
+  size_t populationSize;
+
+  //! The evaluation budget in generation equivalents.
+  size_t maxGenerations;
+
+  //! Probability that crossover will occur.
+  double crossoverProb;
+
+  //! Probability that mutation will occur.
+  double mutationProb;
+
+  //! Strength of the mutation.
+  double mutationStrength;
+
+  //! The tolerance for termination.
+  double epsilon;
+
+  //! The number of in-flight evaluations and evaluation worker threads.
+  size_t pipelineDepth;
+
+  //! Lower bound of the initial swarm.
+  arma::vec lowerBound;
+
+  //! Upper bound of the initial swarm.
+  arma::vec upperBound;
+
+  //! The set of all the Pareto optimal points.
+  //! Stored after Optimize() is called.
+  arma::cube paretoSet;
+
+  //! The set of all the Pareto optimal objective vectors.
+  //! Stored after Optimize() is called.
+  arma::cube paretoFront;
+};
+
+} // namespace ens
+
+// Include implementation.
+#include "steady_state_nsga2_impl.hpp"
+
+#endif
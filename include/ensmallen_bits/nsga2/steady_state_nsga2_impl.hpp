@@ -0,0 +1,537 @@
+/**
+ * @file steady_state_nsga2_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the asynchronous steady-state NSGA-II variant.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef ENSMALLEN_NSGA2_STEADY_STATE_NSGA2_IMPL_HPP
+#define ENSMALLEN_NSGA2_STEADY_STATE_NSGA2_IMPL_HPP
+
+#include "steady_state_nsga2.hpp"
+#include <assert.h>
+
+namespace ens {
+
+inline SteadyStateNSGA2::SteadyStateNSGA2(const size_t populationSize,
+                                          const size_t maxGenerations,
+                                          const double crossoverProb,
+                                          const double mutationProb,
+                                          const double mutationStrength,
+                                          const double epsilon,
+                                          const arma::vec& lowerBound,
+                                          const arma::vec& upperBound) :
+    numObjectives(0),
+    numVariables(0),
+    populationSize(populationSize),
+    maxGenerations(maxGenerations),
+    crossoverProb(crossoverProb),
+    mutationProb(mutationProb),
+    mutationStrength(mutationStrength),
+    epsilon(epsilon),
+    pipelineDepth(4),
+    lowerBound(lowerBound),
+    upperBound(upperBound)
+{ /* Nothing to do here. */ }
+
+inline SteadyStateNSGA2::SteadyStateNSGA2(const size_t populationSize,
+                                          const size_t maxGenerations,
+                                          const double crossoverProb,
+                                          const double mutationProb,
+                                          const double mutationStrength,
+                                          const double epsilon,
+                                          const double lowerBound,
+                                          const double upperBound) :
+    numObjectives(0),
+    numVariables(0),
+    populationSize(populationSize),
+    maxGenerations(maxGenerations),
+    crossoverProb(crossoverProb),
+    mutationProb(mutationProb),
+    mutationStrength(mutationStrength),
+    epsilon(epsilon),
+    pipelineDepth(4),
+    lowerBound(lowerBound * arma::ones(1, 1)),
+    upperBound(upperBound * arma::ones(1, 1))
+{ /* Nothing to do here. */ }
+
+//! Optimize the function.
+template<typename MatType,
+         typename... ArbitraryFunctionType,
+         typename... CallbackTypes>
+typename MatType::elem_type SteadyStateNSGA2::Optimize(
+    std::tuple<ArbitraryFunctionType...>& objectives,
+    MatType& iterateIn,
+    CallbackTypes&&... callbacks)
+{
+  // Make sure for evolution to work at least four candidates are present.
+  if (populationSize < 4)
+  {
+    throw std::logic_error("SteadyStateNSGA2::Optimize(): population size "
+        "should be at least 4!");
+  }
+
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+
+  // Make sure that we have the methods that we need.  Long name...
+  traits::CheckArbitraryFunctionTypeAPI<ArbitraryFunctionType...,
+      BaseMatType>();
+  RequireDenseFloatingPointType<BaseMatType>();
+
+  // Check if lower bound is a vector of a single dimension.
+  if (lowerBound.n_rows == 1)
+    lowerBound = lowerBound(0, 0) * arma::ones(iterate.n_rows, iterate.n_cols);
+
+  // Check if upper bound is a vector of a single dimension.
+  if (upperBound.n_rows == 1)
+    upperBound = upperBound(0, 0) * arma::ones(iterate.n_rows, iterate.n_cols);
+
+  // Check the dimensions of lowerBound and upperBound.
+  assert(lowerBound.n_rows == iterate.n_rows && "The dimensions of "
+      "lowerBound are not the same as the dimensions of iterate.");
+  assert(upperBound.n_rows == iterate.n_rows && "The dimensions of "
+      "upperBound are not the same as the dimensions of iterate.");
+
+  numObjectives = sizeof...(ArbitraryFunctionType);
+  numVariables = iterate.n_rows;
+
+  std::vector<BaseMatType> population;
+  population.reserve(populationSize + 1);
+  std::vector<arma::Col<ElemType> > calculatedObjectives;
+  calculatedObjectives.reserve(populationSize + 1);
+
+  // Pareto fronts, ranks and crowding distances of the current population,
+  // refreshed by the non-dominated sort of every insertion step.
+  std::vector<std::vector<size_t> > fronts;
+  std::vector<size_t> ranks;
+  std::vector<ElemType> crowdingDistance;
+
+  //! Useful temporaries for float-like comparisons.
+  const BaseMatType castedLowerBound =
+      arma::conv_to<BaseMatType>::from(lowerBound);
+  const BaseMatType castedUpperBound =
+      arma::conv_to<BaseMatType>::from(upperBound);
+
+  // Controls early termination of the optimization process.
+  bool terminate = false;
+
+  // The evaluation pipeline.  The optimization thread produces candidates
+  // into `pending`; the workers score them against all objectives and push
+  // the results into `completed`.  Both queues share one mutex: the hand-off
+  // is a couple of matrix moves, so there is nothing to gain from finer
+  // locking while the objective evaluations run outside the lock.
+  std::queue<BaseMatType> pending;
+  std::queue<std::pair<BaseMatType, arma::Col<ElemType> > > completed;
+  std::mutex pipelineMutex;
+  std::condition_variable candidateReady, resultReady;
+  bool shuttingDown = false;
+
+  auto evaluationLoop = [&]()
+  {
+    // One-member vectors, so the scoring goes through the shared
+    // PopulationEvaluator like everywhere else.
+    std::vector<BaseMatType> member(1);
+    std::vector<arma::Col<ElemType> > memberObjectives(1);
+
+    while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock(pipelineMutex);
+        candidateReady.wait(lock,
+            [&]() { return !pending.empty() || shuttingDown; });
+        if (pending.empty())
+          break;
+
+        member[0] = std::move(pending.front());
+        pending.pop();
+      }
+
+      memberObjectives[0].zeros(numObjectives);
+      PopulationEvaluator::Evaluate(member, objectives, memberObjectives, 1,
+          false);
+
+      {
+        std::lock_guard<std::mutex> lock(pipelineMutex);
+        completed.emplace(std::move(member[0]),
+            std::move(memberObjectives[0]));
+      }
+      resultReady.notify_one();
+    }
+  };
+
+  // Hand a candidate to the workers.
+  auto submit = [&](BaseMatType&& candidate)
+  {
+    {
+      std::lock_guard<std::mutex> lock(pipelineMutex);
+      pending.push(std::move(candidate));
+    }
+    candidateReady.notify_one();
+  };
+
+  // Wait for one scored candidate.
+  auto collect = [&]()
+  {
+    std::unique_lock<std::mutex> lock(pipelineMutex);
+    resultReady.wait(lock, [&]() { return !completed.empty(); });
+    std::pair<BaseMatType, arma::Col<ElemType> > result =
+        std::move(completed.front());
+    completed.pop();
+    return result;
+  };
+
+  // One worker per pipeline slot; a deeper pipeline admits more concurrent
+  // evaluations.
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < std::max<size_t>(1, pipelineDepth); t++)
+    workers.emplace_back(evaluationLoop);
+
+  // Generate the initial population based on a uniform distribution around
+  // the given starting point, and score it through the pipeline as well.
+  for (size_t i = 0; i < populationSize; i++)
+  {
+    BaseMatType candidate = arma::randu<BaseMatType>(iterate.n_rows,
+        iterate.n_cols) - 0.5 + iterate;
+    candidate = arma::min(arma::max(candidate, castedLowerBound),
+        castedUpperBound);
+    submit(std::move(candidate));
+  }
+  for (size_t i = 0; i < populationSize; i++)
+  {
+    std::pair<BaseMatType, arma::Col<ElemType> > result = collect();
+    population.push_back(std::move(result.first));
+    calculatedObjectives.push_back(std::move(result.second));
+  }
+
+  // Rank the initial population.
+  ranks.resize(populationSize);
+  FastNonDominatedSort<BaseMatType>(fronts, ranks, calculatedObjectives);
+  crowdingDistance.resize(populationSize);
+  std::fill(crowdingDistance.begin(), crowdingDistance.end(), 0.);
+  for (size_t fNum = 0; fNum < fronts.size(); fNum++)
+  {
+    CrowdingDistanceAssignment<BaseMatType>(fronts[fNum],
+        calculatedObjectives, crowdingDistance);
+  }
+
+  Info << "SteadyStateNSGA2 initialized successfully. Optimization started."
+      << std::endl;
+
+  Callback::BeginOptimization(*this, objectives, iterate, callbacks...);
+
+  // Produce one offspring with binary tournament selection, elementwise
+  // crossover and mutation, as in the generational optimizer.
+  auto makeOffspring = [&]()
+  {
+    auto tournament = [&]()
+    {
+      size_t indexA =
+          arma::randi<size_t>(arma::distr_param(0, populationSize - 1));
+      size_t indexB =
+          arma::randi<size_t>(arma::distr_param(0, populationSize - 1));
+
+      // Make sure that the competitors differ.
+      if (indexA == indexB)
+      {
+        if (indexB < populationSize - 1)
+          indexB++;
+        else
+          indexB--;
+      }
+
+      return CrowdingOperator<BaseMatType>(indexA, indexB, ranks,
+          crowdingDistance) ? indexA : indexB;
+    };
+
+    const BaseMatType& parentA = population[tournament()];
+    const BaseMatType& parentB = population[tournament()];
+
+    // Indices at which crossover is to occur.
+    const arma::umat idx = arma::randu<BaseMatType>(parentA.n_rows,
+        parentA.n_cols) < crossoverProb;
+    BaseMatType child = parentA % idx + parentB % (1 - idx);
+
+    // Perform mutation of the candidate weights with some noise.
+    child += (arma::randu<BaseMatType>(child.n_rows, child.n_cols) <
+        mutationProb) %
+        (mutationStrength * arma::randn<BaseMatType>(child.n_rows,
+        child.n_cols));
+
+    // Constrain all genes to be between bounds.
+    child = arma::min(arma::max(child, castedLowerBound), castedUpperBound);
+    return child;
+  };
+
+  // The steady-state loop: keep the pipeline filled with offspring, and
+  // whenever a scored candidate comes back, insert it into the population
+  // and discard the worst of the populationSize + 1 members by the rank and
+  // crowding distance criteria.  There is no generation barrier: a slow
+  // objective evaluation delays only its own insertion.
+  const size_t maxInsertions = maxGenerations * populationSize;
+  size_t inFlight = 0;
+  size_t produced = 0;
+
+  for (size_t inserted = 0; inserted < maxInsertions && !terminate; )
+  {
+    while (inFlight < std::max<size_t>(1, pipelineDepth) &&
+        produced < maxInsertions)
+    {
+      submit(makeOffspring());
+      ++inFlight;
+      ++produced;
+    }
+
+    std::pair<BaseMatType, arma::Col<ElemType> > result = collect();
+    --inFlight;
+
+    population.push_back(std::move(result.first));
+    calculatedObjectives.push_back(std::move(result.second));
+
+    // Rank the extended population and find the member to discard: the one
+    // every other member is preferred over.
+    ranks.resize(population.size());
+    FastNonDominatedSort<BaseMatType>(fronts, ranks, calculatedObjectives);
+    crowdingDistance.resize(population.size());
+    std::fill(crowdingDistance.begin(), crowdingDistance.end(), 0.);
+    for (size_t fNum = 0; fNum < fronts.size(); fNum++)
+    {
+      CrowdingDistanceAssignment<BaseMatType>(fronts[fNum],
+          calculatedObjectives, crowdingDistance);
+    }
+
+    size_t worst = 0;
+    for (size_t i = 1; i < population.size(); i++)
+    {
+      if (CrowdingOperator<BaseMatType>(worst, i, ranks, crowdingDistance))
+        worst = i;
+    }
+
+    population.erase(population.begin() + worst);
+    calculatedObjectives.erase(calculatedObjectives.begin() + worst);
+    ranks.erase(ranks.begin() + worst);
+    crowdingDistance.erase(crowdingDistance.begin() + worst);
+
+    ++inserted;
+
+    // Report one generational step per populationSize insertions, so
+    // callbacks observe the same cadence as with the generational NSGA2.
+    if (inserted % populationSize == 0)
+    {
+      FastNonDominatedSort<BaseMatType>(fronts, ranks, calculatedObjectives);
+      terminate |= Callback::GenerationalStepTaken(*this, objectives, iterate,
+          calculatedObjectives, fronts, callbacks...);
+    }
+  }
+
+  // Drain the in-flight evaluations (their results are discarded on early
+  // termination), then stop the workers.
+  while (inFlight > 0)
+  {
+    collect();
+    --inFlight;
+  }
+  {
+    std::lock_guard<std::mutex> lock(pipelineMutex);
+    shuttingDown = true;
+  }
+  candidateReady.notify_all();
+  for (size_t t = 0; t < workers.size(); t++)
+    workers[t].join();
+
+  // Re-rank the final population for the output fronts.
+  FastNonDominatedSort<BaseMatType>(fronts, ranks, calculatedObjectives);
+
+  // Set the candidates from the Pareto Set as the output.
+  paretoSet.set_size(population[0].n_rows, population[0].n_cols,
+      fronts[0].size());
+  // The Pareto Set is stored, can be obtained via ParetoSet() getter.
+  for (size_t solutionIdx = 0; solutionIdx < fronts[0].size(); ++solutionIdx)
+  {
+    paretoSet.slice(solutionIdx) =
+        arma::conv_to<arma::mat>::from(population[fronts[0][solutionIdx]]);
+  }
+
+  // Set the candidates from the Pareto Front as the output.
+  paretoFront.set_size(calculatedObjectives[0].n_rows,
+      calculatedObjectives[0].n_cols, fronts[0].size());
+  // The Pareto Front is stored, can be obtained via ParetoFront() getter.
+  for (size_t solutionIdx = 0; solutionIdx < fronts[0].size(); ++solutionIdx)
+  {
+    paretoFront.slice(solutionIdx) = arma::conv_to<arma::mat>::from(
+        calculatedObjectives[fronts[0][solutionIdx]]);
+  }
+
+  // Assign iterate to first element of the Pareto Set.
+  iterate = population[fronts[0][0]];
+
+  Callback::EndOptimization(*this, objectives, iterate, callbacks...);
+
+  ElemType performance = std::numeric_limits<ElemType>::max();
+
+  for (const arma::Col<ElemType>& objective: calculatedObjectives)
+    if (arma::accu(objective) < performance)
+      performance = arma::accu(objective);
+
+  return performance;
+}
+
+//! Sort the population into Pareto fronts.
+template<typename MatType>
+inline void SteadyStateNSGA2::FastNonDominatedSort(
+    std::vector<std::vector<size_t> >& fronts,
+    std::vector<size_t>& ranks,
+    std::vector<arma::Col<typename MatType::elem_type> >&
+        calculatedObjectives)
+{
+  const size_t numMembers = calculatedObjectives.size();
+  std::map<size_t, size_t> dominationCount;
+  std::map<size_t, std::set<size_t> > dominated;
+
+  // Reset and initialize fronts.
+  fronts.clear();
+  fronts.push_back(std::vector<size_t>());
+
+  for (size_t p = 0; p < numMembers; p++)
+  {
+    dominated[p] = std::set<size_t>();
+    dominationCount[p] = 0;
+
+    for (size_t q = 0; q < numMembers; q++)
+    {
+      if (Dominates<MatType>(calculatedObjectives, p, q))
+        dominated[p].insert(q);
+      else if (Dominates<MatType>(calculatedObjectives, q, p))
+        dominationCount[p] += 1;
+    }
+
+    if (dominationCount[p] == 0)
+    {
+      ranks[p] = 0;
+      fronts[0].push_back(p);
+    }
+  }
+
+  size_t i = 0;
+
+  while (!fronts[i].empty())
+  {
+    std::vector<size_t> nextFront;
+
+    for (size_t p: fronts[i])
+    {
+      for (size_t q: dominated[p])
+      {
+        dominationCount[q]--;
+
+        if (dominationCount[q] == 0)
+        {
+          ranks[q] = i + 1;
+          nextFront.push_back(q);
+        }
+      }
+    }
+
+    i++;
+    fronts.push_back(nextFront);
+  }
+  // Remove the empty final set.
+  fronts.pop_back();
+}
+
+//! Check if a candidate Pareto dominates another candidate.
+template<typename MatType>
+inline bool SteadyStateNSGA2::Dominates(
+    std::vector<arma::Col<typename MatType::elem_type> >&
+        calculatedObjectives,
+    size_t candidateP,
+    size_t candidateQ)
+{
+  bool allBetterOrEqual = true;
+  bool atleastOneBetter = false;
+  size_t n_objectives = calculatedObjectives[0].n_elem;
+
+  for (size_t i = 0; i < n_objectives; i++)
+  {
+    // P is worse than Q for the i-th objective function.
+    if (calculatedObjectives[candidateP](i) >
+        calculatedObjectives[candidateQ](i))
+      allBetterOrEqual = false;
+
+    // P is better than Q for the i-th objective function.
+    else if (calculatedObjectives[candidateP](i) <
+        calculatedObjectives[candidateQ](i))
+      atleastOneBetter = true;
+  }
+
+  return allBetterOrEqual && atleastOneBetter;
+}
+
+//! Assign crowding distance to the population.
+template<typename MatType>
+inline void SteadyStateNSGA2::CrowdingDistanceAssignment(
+    const std::vector<size_t>& front,
+    std::vector<arma::Col<typename MatType::elem_type> >&
+        calculatedObjectives,
+    std::vector<typename MatType::elem_type>& crowdingDistance)
+{
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+
+  size_t fSize = front.size();
+
+  for (size_t m = 0; m < numObjectives; m++)
+  {
+    // fValues of individuals for the current objective.
+    arma::Col<ElemType> fValues(fSize);
+    for (size_t i = 0; i < fSize; i++)
+      fValues(i) = calculatedObjectives[front[i]](m);
+
+    // Sort front indices by ascending fValues for current objective.
+    const arma::uvec sortedIdx = arma::sort_index(fValues);
+
+    crowdingDistance[front[sortedIdx(0)]] =
+        std::numeric_limits<ElemType>::max();
+    crowdingDistance[front[sortedIdx(fSize - 1)]] =
+        std::numeric_limits<ElemType>::max();
+    ElemType minFval = fValues(sortedIdx(0));
+    ElemType maxFval = fValues(sortedIdx(fSize - 1));
+    ElemType scale =
+        std::abs(maxFval - minFval) == 0. ? 1. : std::abs(maxFval - minFval);
+
+    for (size_t i = 1; i + 1 < fSize; i++)
+    {
+      crowdingDistance[front[sortedIdx(i)]] +=
+          (fValues(sortedIdx(i + 1)) - fValues(sortedIdx(i - 1))) / scale;
+    }
+  }
+}
+
+//! Comparator for crowding distance based sorting.
+template<typename MatType>
+inline bool SteadyStateNSGA2::CrowdingOperator(
+    size_t idxP,
+    size_t idxQ,
+    const std::vector<size_t>& ranks,
+    const std::vector<typename MatType::elem_type>& crowdingDistance)
+{
+  if (ranks[idxP] < ranks[idxQ])
+    return true;
+  else if (ranks[idxP] == ranks[idxQ] &&
+      crowdingDistance[idxP] > crowdingDistance[idxQ])
+    return true;
+
+  return false;
+}
+
+} // namespace ens
+
+#endif
@@ -12,6 +12,8 @@
 #ifndef ENSMALLEN_PADAM_PADAM_UPDATE_HPP
 #define ENSMALLEN_PADAM_PADAM_UPDATE_HPP
 
+#include <ensmallen_bits/sgd/update_policies/elementwise_update.hpp>
+
 namespace ens {
 
 /**
@@ -82,7 +84,7 @@ class PadamUpdate
    * specific to an individual optimization.
    */
   template<typename MatType, typename GradType>
-  class Policy
+  class Policy : public ElementwiseUpdate<Policy<MatType, GradType>>
   {
    public:
     /**
@@ -116,21 +118,33 @@ class PadamUpdate
       // Increment the iteration counter variable.
       ++iteration;
 
-      // And update the iterate.
-      m *= parent.beta1;
-      m += (1 - parent.beta1) * gradient;
-
-      v *= parent.beta2;
-      v += (1 - parent.beta2) * (gradient % gradient);
-
       const double biasCorrection1 = 1.0 - std::pow(parent.beta1, iteration);
       const double biasCorrection2 = 1.0 - std::pow(parent.beta2, iteration);
 
+      this->Elementwise(iterate,
+          stepSize * std::sqrt(biasCorrection2) / biasCorrection1, gradient,
+          m, v, vImproved);
+    }
+
+    //! The per-element Padam rule; called by ElementwiseUpdate.  The bias
+    //! corrections are folded into the forwarded step scalar.
+    template<typename StateElemType>
+    double Apply(const double scaledStepSize,
+                 const double x,
+                 const double g,
+                 StateElemType& m,
+                 StateElemType& v,
+                 StateElemType& vImproved)
+    {
+      m = (StateElemType) (parent.beta1 * m + (1 - parent.beta1) * g);
+      v = (StateElemType) (parent.beta2 * v + (1 - parent.beta2) * g * g);
+
       // Element wise maximum of past and present squared gradients.
-      vImproved = arma::max(vImproved, v);
+      if (v > vImproved)
+        vImproved = v;
 
-      iterate -= (stepSize * std::sqrt(biasCorrection2) / biasCorrection1) *
-          m / arma::pow(vImproved + parent.epsilon, parent.partial);
+      return x - scaledStepSize * m /
+          std::pow(vImproved + parent.epsilon, parent.partial);
     }
 
    private:
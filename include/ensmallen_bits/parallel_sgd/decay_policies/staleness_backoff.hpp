@@ -0,0 +1,93 @@
+/**
+ * @file staleness_backoff.hpp
+ * @author Shikhar Bhardwaj
+ *
+ * Staleness-adaptive step size policy for parallel Stochastic Gradient
+ * Descent: updates computed from stale iterates take proportionally smaller
+ * steps.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_PARALLEL_SGD_STALENESS_BACKOFF_HPP
+#define ENSMALLEN_PARALLEL_SGD_STALENESS_BACKOFF_HPP
+
+namespace ens {
+
+/**
+ * Staleness-adaptive stepsize policy for parallel SGD.  In asynchronous
+ * (HOGWILD!-style) execution some threads run ahead of others, so a gradient
+ * may be computed from an iterate that other threads have since updated many
+ * times.  This policy scales each step by 1 / (1 + staleness / halfLife),
+ * where the staleness is the number of updates applied to the shared iterate
+ * since the gradient's snapshot: fresh updates take the full step, while an
+ * update that is halfLife updates stale takes half of it.  This recovers
+ * convergence behavior close to synchronous SGD while keeping asynchronous
+ * throughput, which matters most when the thread speeds are skewed.
+ *
+ * For more information, see the following.
+ *
+ * @misc{1511.05950,
+ *   Author = {Wei Zhang and Suyog Gupta and Xiangru Lian and Ji Liu},
+ *   Title = {Staleness-aware Async-SGD for Distributed Deep Learning},
+ *   Year = {2015},
+ *   Eprint = {arXiv:1511.05950},
+ * }
+ *
+ * In the synchronous implementation no staleness information is available
+ * and the policy degrades to a constant step.
+ */
+class StalenessBackoff
+{
+ public:
+  /**
+   * Member initialization constructor.
+   *
+   * @param step The initial stepsize.
+   * @param halfLife The staleness (in updates to the shared iterate) at
+   *    which the stepsize is halved.
+   */
+  StalenessBackoff(const double step = 0.01, const double halfLife = 100.0) :
+    step(step),
+    halfLife(halfLife)
+  { /* Nothing to do. */ }
+
+  /**
+   * Get the step size for the current gradient update when no staleness
+   * information is available (e.g. in the synchronous implementation).
+   *
+   * @param numEpoch The iteration number of the current update.
+   * @return The stepsize for the current iteration.
+   */
+  double StepSize(const size_t /* numEpoch */)
+  {
+    return step;
+  }
+
+  /**
+   * Get the step size for the current gradient update, scaled down by the
+   * staleness of the iterate it was computed from.
+   *
+   * @param numEpoch The iteration number of the current update.
+   * @param staleness Number of updates applied to the shared iterate since
+   *    the snapshot this update's gradient was computed from.
+   * @return The stepsize for the current iteration.
+   */
+  double StepSize(const size_t /* numEpoch */, const size_t staleness)
+  {
+    return step / (1.0 + (double) staleness / halfLife);
+  }
+
+ private:
+  //! The initial stepsize.
+  double step;
+
+  //! The staleness at which the stepsize is halved.
+  double halfLife;
+};
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,177 @@
+/**
+ * @file local_sgd.hpp
+ * @author Marcus Edel
+ *
+ * Local SGD (periodic parameter averaging).
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_PARALLEL_SGD_LOCAL_SGD_HPP
+#define ENSMALLEN_PARALLEL_SGD_LOCAL_SGD_HPP
+
+#include <ensmallen_bits/sgd/update_policies/vanilla_update.hpp>
+#include <ensmallen_bits/sgd/decay_policies/no_decay.hpp>
+
+namespace ens {
+
+/**
+ * An implementation of Local SGD (periodic parameter averaging), the middle
+ * point between fully synchronous mini-batch SGD and the lock-free HOGWILD!
+ * scheme of ParallelSGD.  Every thread runs an independent SGD chain on its
+ * own shard of the separable functions, using its own private iterate and
+ * its own instantiated update and decay policies from the regular SGD policy
+ * stack; every AveragingInterval() steps the private iterates are averaged
+ * into the center, and the chains restart from the average.  Synchronizing
+ * only every H steps cuts the synchronization cost by a factor of H while
+ * matching mini-batch SGD convergence for reasonable H.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @article{Stich2018,
+ *   author  = {Sebastian U. Stich},
+ *   title   = {Local {SGD} Converges Fast and Communicates Little},
+ *   journal = {arXiv preprint arXiv:1805.09767},
+ *   year    = {2018}
+ * }
+ * @endcode
+ *
+ * LocalSGD can optimize differentiable separable functions.  For more
+ * details, see the documentation on function types included with this
+ * distribution or on the ensmallen website.
+ *
+ * @tparam UpdatePolicyType Update policy used by each thread's SGD chain
+ *     (default VanillaUpdate).
+ * @tparam DecayPolicyType Decay policy used by each thread's SGD chain to
+ *     adjust the step size (default NoDecay).
+ */
+template<typename UpdatePolicyType = VanillaUpdate,
+         typename DecayPolicyType = NoDecay>
+class LocalSGD
+{
+ public:
+  /**
+   * Construct the Local SGD optimizer with the given function and
+   * parameters.  The defaults here are not necessarily good for the given
+   * problem, so it is suggested that the values used be tailored to the task
+   * at hand.
+   *
+   * @param stepSize Step size for each iteration.
+   * @param batchSize Batch size to use for each step.
+   * @param maxIterations Maximum number of iterations allowed per thread (0
+   *     means no limit).
+   * @param averagingInterval Number of steps each thread runs between
+   *     averaging rounds.
+   * @param tolerance Maximum absolute tolerance to terminate the algorithm.
+   * @param shuffle If true, the function order is shuffled between rounds;
+   *     otherwise, each function is visited in linear order.
+   * @param updatePolicy An instantiated update policy used to adjust the
+   *     given parameters.
+   * @param decayPolicy An instantiated decay policy used to adjust the step
+   *     size.
+   */
+  LocalSGD(const double stepSize = 0.01,
+           const size_t batchSize = 32,
+           const size_t maxIterations = 100000,
+           const size_t averagingInterval = 16,
+           const double tolerance = 1e-5,
+           const bool shuffle = true,
+           const UpdatePolicyType& updatePolicy = UpdatePolicyType(),
+           const DecayPolicyType& decayPolicy = DecayPolicyType());
+
+  /**
+   * Optimize the given function using Local SGD.  The given starting point
+   * will be modified to store the finishing point of the algorithm, and the
+   * value of the loss function at the final point is returned.
+   *
+   * @tparam SeparableFunctionType Type of function to be optimized.
+   * @tparam MatType Type of the parameters matrix.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to be optimized (minimized).
+   * @param iterate Starting point (will be modified).
+   * @param callbacks Callback functions.
+   * @return Objective value at the final point.
+   */
+  template<typename SeparableFunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(SeparableFunctionType& function,
+                                       MatType& iterate,
+                                       CallbackTypes&&... callbacks);
+
+  //! Get the step size.
+  double StepSize() const { return stepSize; }
+  //! Modify the step size.
+  double& StepSize() { return stepSize; }
+
+  //! Get the batch size.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the batch size.
+  size_t& BatchSize() { return batchSize; }
+
+  //! Get the maximum number of iterations (0 indicates no limits).
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of iterations (0 indicates no limits).
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the number of steps between averaging rounds.
+  size_t AveragingInterval() const { return averagingInterval; }
+  //! Modify the number of steps between averaging rounds.
+  size_t& AveragingInterval() { return averagingInterval; }
+
+  //! Get the tolerance for termination.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance for termination.
+  double& Tolerance() { return tolerance; }
+
+  //! Get whether or not the individual functions are shuffled.
+  bool Shuffle() const { return shuffle; }
+  //! Modify whether or not the individual functions are shuffled.
+  bool& Shuffle() { return shuffle; }
+
+  //! Get the update policy.
+  const UpdatePolicyType& UpdatePolicy() const { return updatePolicy; }
+  //! Modify the update policy.
+  UpdatePolicyType& UpdatePolicy() { return updatePolicy; }
+
+  //! Get the step size decay policy.
+  const DecayPolicyType& DecayPolicy() const { return decayPolicy; }
+  //! Modify the step size decay policy.
+  DecayPolicyType& DecayPolicy() { return decayPolicy; }
+
+ private:
+  //! The step size for each iteration.
+  double stepSize;
+
+  //! The batch size for each step.
+  size_t batchSize;
+
+  //! The maximum number of allowed iterations per thread.
+  size_t maxIterations;
+
+  //! The number of steps each thread runs between averaging rounds.
+  size_t averagingInterval;
+
+  //! The tolerance for termination.
+  double tolerance;
+
+  //! Controls whether or not the individual functions are shuffled when
+  //! iterating.
+  bool shuffle;
+
+  //! The update policy used by each thread's SGD chain.
+  UpdatePolicyType updatePolicy;
+
+  //! The decay policy used by each thread's SGD chain.
+  DecayPolicyType decayPolicy;
+};
+
+} // namespace ens
+
+// Include implementation.
+#include "local_sgd_impl.hpp"
+
+#endif
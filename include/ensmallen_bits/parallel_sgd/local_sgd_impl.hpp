@@ -0,0 +1,202 @@
+/**
+ * @file local_sgd_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of Local SGD (periodic parameter averaging).
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_PARALLEL_SGD_LOCAL_SGD_IMPL_HPP
+#define ENSMALLEN_PARALLEL_SGD_LOCAL_SGD_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "local_sgd.hpp"
+
+#include <ensmallen_bits/function.hpp>
+
+// For the DeterministicObjective() reduction shared with ParallelSGD.
+#include "parallel_sgd_impl.hpp"
+
+namespace ens {
+
+template<typename UpdatePolicyType, typename DecayPolicyType>
+LocalSGD<UpdatePolicyType, DecayPolicyType>::LocalSGD(
+    const double stepSize,
+    const size_t batchSize,
+    const size_t maxIterations,
+    const size_t averagingInterval,
+    const double tolerance,
+    const bool shuffle,
+    const UpdatePolicyType& updatePolicy,
+    const DecayPolicyType& decayPolicy) :
+    stepSize(stepSize),
+    batchSize(batchSize),
+    maxIterations(maxIterations),
+    averagingInterval(std::max(averagingInterval, (size_t) 1)),
+    tolerance(tolerance),
+    shuffle(shuffle),
+    updatePolicy(updatePolicy),
+    decayPolicy(decayPolicy)
+{ /* Nothing to do. */ }
+
+template<typename UpdatePolicyType, typename DecayPolicyType>
+template<typename SeparableFunctionType,
+         typename MatType,
+         typename... CallbackTypes>
+typename MatType::elem_type
+LocalSGD<UpdatePolicyType, DecayPolicyType>::Optimize(
+    SeparableFunctionType& function,
+    MatType& iterateIn,
+    CallbackTypes&&... callbacks)
+{
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+
+  typedef Function<SeparableFunctionType, BaseMatType, BaseMatType>
+      FullFunctionType;
+  FullFunctionType& f(static_cast<FullFunctionType&>(function));
+
+  // Each thread runs a full SGD chain, so it needs its own instantiated
+  // update and decay policies from the regular SGD policy stack.
+  typedef typename UpdatePolicyType::template Policy<BaseMatType, BaseMatType>
+      InstUpdatePolicyType;
+  typedef typename DecayPolicyType::template Policy<BaseMatType, BaseMatType>
+      InstDecayPolicyType;
+
+  // Make sure we have all the methods that we need.
+  traits::CheckSeparableFunctionTypeAPI<FullFunctionType, BaseMatType,
+      BaseMatType>();
+  RequireFloatingPointType<BaseMatType>();
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+
+  const size_t numFunctions = f.NumFunctions();
+  const size_t numThreads = ParallelRuntime::Get().RegionThreads();
+
+  // Per-thread state, allocated once for the whole optimization: the private
+  // iterates the chains run on, the per-chain gradient buffers, the per-chain
+  // policies, and the per-chain step sizes (the decay policy may adjust them
+  // independently, although identical chains keep them identical).
+  std::vector<BaseMatType> threadIterates(numThreads, iterate);
+  std::vector<BaseMatType> threadGradients(numThreads,
+      BaseMatType(iterate.n_rows, iterate.n_cols));
+  std::vector<double> threadStepSizes(numThreads, stepSize);
+  std::vector<size_t> threadCursors(numThreads, 0);
+  std::vector<InstUpdatePolicyType> threadUpdates;
+  std::vector<InstDecayPolicyType> threadDecays;
+  threadUpdates.reserve(numThreads);
+  threadDecays.reserve(numThreads);
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    threadUpdates.emplace_back(updatePolicy, iterate.n_rows, iterate.n_cols);
+    threadDecays.emplace_back(decayPolicy);
+  }
+
+  ElemType overallObjective = DBL_MAX;
+  ElemType lastObjective;
+
+  // Controls early termination of the optimization process.
+  bool terminate = false;
+
+  Callback::BeginOptimization(*this, f, iterate, callbacks...);
+
+  // Each round runs every chain for averagingInterval steps and then
+  // averages the private iterates into the center.
+  size_t iteration = 0;
+  while (!terminate)
+  {
+    // Calculate the overall objective at the center.
+    lastObjective = overallObjective;
+    overallObjective = DeterministicObjective(f, iterate);
+
+    terminate |= Callback::Evaluate(*this, f, iterate, overallObjective,
+        callbacks...);
+
+    Info << "Local SGD: iteration " << iteration << ", objective "
+        << overallObjective << "." << std::endl;
+
+    if (std::isnan(overallObjective) || std::isinf(overallObjective))
+    {
+      Warn << "Local SGD: converged to " << overallObjective
+          << "; terminating with failure. Try a smaller step size?"
+          << std::endl;
+      break;
+    }
+
+    if (std::abs(lastObjective - overallObjective) < tolerance)
+    {
+      Info << "Local SGD: minimized within tolerance " << tolerance
+          << "; terminating optimization." << std::endl;
+      break;
+    }
+
+    if (maxIterations != 0 && iteration >= maxIterations)
+      break;
+
+    // Shuffle the function visitation order between rounds.
+    if (shuffle)
+      f.Shuffle();
+
+    // Restart every chain from the center.
+    for (size_t t = 0; t < numThreads; ++t)
+      threadIterates[t] = iterate;
+
+    // The number of steps each chain runs this round.
+    const size_t roundSteps = (maxIterations == 0) ? averagingInterval :
+        std::min(averagingInterval, maxIterations - iteration);
+
+    ENS_PRAGMA_OMP_PARALLEL_FOR_THREADS((int) numThreads)
+    for (ptrdiff_t t = 0; t < (ptrdiff_t) numThreads; ++t)
+    {
+      // This chain's shard of the functions; shard sizes differ by at most
+      // one, and a thread without functions just keeps the center.
+      const size_t shardBegin = (t * numFunctions) / numThreads;
+      const size_t shardSize = ((t + 1) * numFunctions) / numThreads -
+          shardBegin;
+      if (shardSize == 0)
+        continue;
+
+      const size_t shardBatches = (shardSize + batchSize - 1) / batchSize;
+
+      BaseMatType& localIterate = threadIterates[t];
+      BaseMatType& gradient = threadGradients[t];
+
+      for (size_t s = 0; s < roundSteps; ++s)
+      {
+        // Visit the shard's batches cyclically.
+        const size_t begin = shardBegin +
+            (threadCursors[t] % shardBatches) * batchSize;
+        const size_t effectiveBatchSize = std::min(batchSize,
+            shardBegin + shardSize - begin);
+        ++threadCursors[t];
+
+        f.Gradient(localIterate, begin, gradient, effectiveBatchSize);
+        threadUpdates[t].Update(localIterate, threadStepSizes[t], gradient);
+        threadDecays[t].Update(localIterate, threadStepSizes[t], gradient);
+      }
+    }
+
+    // Average the private iterates into the center.
+    iterate = threadIterates[0];
+    for (size_t t = 1; t < numThreads; ++t)
+      iterate += threadIterates[t];
+    iterate /= (ElemType) numThreads;
+
+    iteration += roundSteps;
+    terminate |= Callback::StepTaken(*this, f, iterate, callbacks...);
+  }
+
+  Info << "\nLocal SGD terminated with objective : " << overallObjective
+      << "." << std::endl;
+
+  Callback::EndOptimization(*this, f, iterate, callbacks...);
+  return overallObjective;
+}
+
+} // namespace ens
+
+#endif
@@ -14,6 +14,7 @@
 
 #include "decay_policies/constant_step.hpp"
 #include "decay_policies/exponential_backoff.hpp"
+#include "decay_policies/staleness_backoff.hpp"
 
 namespace ens {
 
@@ -94,6 +95,20 @@ class ParallelSGD
            MatType& iterate,
            CallbackTypes&&... callbacks);
 
+  /**
+   * Optimize the given function asynchronously: worker threads process
+   * samples continuously with no epoch-boundary barrier while the calling
+   * thread evaluates the objective on iterate snapshots, enforcing the
+   * configured staleness bound.  Called by Optimize() when Async() is set.
+   */
+  template <typename SparseFunctionType,
+            typename MatType,
+            typename GradType,
+            typename... CallbackTypes>
+  typename MatType::elem_type OptimizeAsync(SparseFunctionType& function,
+                                            MatType& iterate,
+                                            CallbackTypes&&... callbacks);
+
   //! Forward arma::SpMat<typename MatType::elem_type> as GradType.
   template<typename SeparableFunctionType,
            typename MatType,
@@ -129,12 +144,139 @@ class ParallelSGD
   //! Modify whether or not the individual functions are shuffled.
   bool& Shuffle() { return shuffle; }
 
+  //! Get whether threads claim work dynamically from a shared queue.
+  bool WorkStealing() const { return workStealing; }
+  //! Modify whether threads claim work dynamically from a shared queue.
+  //! When enabled, the per-iteration work budget is unchanged, but instead of
+  //! fixed per-thread ranges, threads repeatedly pull chunks of the
+  //! visitation order from a shared atomic cursor, so cores stay busy even
+  //! when per-sample cost is highly non-uniform.
+  bool& WorkStealing() { return workStealing; }
+
+  //! Get the chunk size used when work stealing is enabled.
+  size_t StealChunkSize() const { return stealChunkSize; }
+  //! Modify the chunk size used when work stealing is enabled.
+  size_t& StealChunkSize() { return stealChunkSize; }
+
+  //! Get whether the asynchronous (epoch-barrier-free) mode is used.
+  bool Async() const { return async; }
+  //! Modify whether the asynchronous mode is used.  When enabled, worker
+  //! threads run continuously against the shared iterate while the calling
+  //! thread evaluates the objective on snapshots; there is no epoch-boundary
+  //! barrier.  Workers may run at most MaxStaleness() epochs' worth of
+  //! samples ahead of the last evaluated snapshot.
+  bool& Async() { return async; }
+
+  //! Get the staleness bound (in epochs) for asynchronous mode.
+  size_t MaxStaleness() const { return maxStaleness; }
+  //! Modify the staleness bound (in epochs) for asynchronous mode.
+  size_t& MaxStaleness() { return maxStaleness; }
+
+  //! Get whether each thread works on a local replica of the parameters.
+  bool LocalReplicas() const { return localReplicas; }
+  //! Modify whether each thread works on a local replica of the parameters.
+  //! When enabled, every thread copies the iterate into memory it touches
+  //! first (so on NUMA machines the pages land on its own socket), applies
+  //! its sparse updates there without locking, and merges the accumulated
+  //! delta into the shared iterate every MergeInterval() samples.  This
+  //! trades some update freshness for the removal of cross-socket
+  //! cache-line traffic on the shared parameters.
+  bool& LocalReplicas() { return localReplicas; }
+
+  //! Get the number of samples a thread processes between replica merges.
+  size_t MergeInterval() const { return mergeInterval; }
+  //! Modify the number of samples a thread processes between replica merges.
+  size_t& MergeInterval() { return mergeInterval; }
+
+  //! Get whether elastic averaging (EASGD) is used.
+  bool ElasticAveraging() const { return elasticAveraging; }
+  //! Modify whether elastic averaging (EASGD) is used.  When enabled, each
+  //! thread owns a private iterate and couples it elastically to the shared
+  //! center variable every MergeInterval() samples: private iterate and
+  //! center move toward each other by ElasticAlpha().  Between syncs there
+  //! is no write sharing at all, which helps dense-gradient problems where
+  //! HOGWILD!-style per-step updates conflict heavily.  The center variable
+  //! is the result of the optimization.  Takes precedence over
+  //! LocalReplicas().
+  bool& ElasticAveraging() { return elasticAveraging; }
+
+  //! Get the elastic coupling strength.
+  double ElasticAlpha() const { return elasticAlpha; }
+  //! Modify the elastic coupling strength (in (0, 1]).
+  double& ElasticAlpha() { return elasticAlpha; }
+
+  //! Get the number of gradient entries applied per step (0 disables
+  //! sparsification).
+  size_t TopK() const { return topK; }
+  //! Modify the number of gradient entries applied per step.  When nonzero,
+  //! each thread applies only the k pending updates of largest magnitude on
+  //! every step and keeps the remainder in a thread-local residual (error
+  //! feedback), so held-back entries are applied on later steps instead of
+  //! being dropped.  The residual is flushed at the end of every epoch.
+  size_t& TopK() { return topK; }
+
+  //! Get whether striped-lock updates are used.
+  bool StripedLocks() const { return stripedLocks; }
+  //! Modify whether striped-lock updates are used.  When enabled, the
+  //! iterate is partitioned into NumStripes() contiguous stripes, each
+  //! guarded by a spinlock; every sample's update acquires the stripes it
+  //! touches in ascending index order, applies all its entries, and
+  //! releases them.  This makes each sample's update atomic, which avoids
+  //! the overwrite churn of lock-free updates at medium gradient density
+  //! (roughly 1-10% nonzeros) while staying close to lock-free speed.
+  //! Only used for dense iterates; sparse iterates keep the critical
+  //! section, and LocalReplicas() / ElasticAveraging() take precedence.
+  bool& StripedLocks() { return stripedLocks; }
+
+  //! Get the number of stripes used when striped locks are enabled.
+  size_t NumStripes() const { return numStripes; }
+  //! Modify the number of stripes used when striped locks are enabled.
+  size_t& NumStripes() { return numStripes; }
+
+  //! Get whether the throughput autotuner is enabled.
+  bool Autotune() const { return autotune; }
+  //! Modify whether the throughput autotuner is enabled.  When enabled, a
+  //! short calibration phase at the start of Optimize() measures the update
+  //! throughput (samples per second) over a small search across thread
+  //! counts and thread share sizes, and locks in the fastest schedule for
+  //! the following iterations.  The probes perform real updates with the
+  //! current step size, so calibration work advances the optimization
+  //! instead of being thrown away.  The schedule is re-checked every
+  //! AutotuneInterval() iterations, since the best settings can drift as
+  //! the gradients become sparser or denser over the course of a run.
+  //! ThreadShareSize() is overwritten with the tuned value.
+  bool& Autotune() { return autotune; }
+
+  //! Get the recalibration cadence in iterations (0 tunes only once).
+  size_t AutotuneInterval() const { return autotuneInterval; }
+  //! Modify the recalibration cadence in iterations (0 tunes only once).
+  size_t& AutotuneInterval() { return autotuneInterval; }
+
   //! Get the step size decay policy.
   DecayPolicyType& DecayPolicy() const { return decayPolicy; }
   //! Modify the step size decay policy.
   DecayPolicyType& DecayPolicy() { return decayPolicy; }
 
  private:
+  /**
+   * Run timed throughput probes over a small search across thread counts
+   * and thread share sizes, and return the fastest thread count found.
+   * ThreadShareSize() is updated in place.  Each probe performs one
+   * iteration's worth of real HOGWILD!-style updates at the candidate
+   * schedule, so no calibration work is discarded.
+   *
+   * @param function Function being optimized.
+   * @param iterate Current parameters (updated by the probes).
+   * @param visitationOrder The order in which functions are visited.
+   * @param stepSize Step size to use for the probe updates.
+   * @return The thread count of the fastest schedule measured.
+   */
+  template <typename SparseFunctionType, typename MatType, typename GradType>
+  size_t CalibrateSchedule(SparseFunctionType& function,
+                           MatType& iterate,
+                           const arma::Col<size_t>& visitationOrder,
+                           const double stepSize);
+
   //! The maximum number of allowed iterations.
   size_t maxIterations;
 
@@ -148,6 +290,46 @@ class ParallelSGD
   //! iterating.
   bool shuffle;
 
+  //! Whether threads claim work dynamically instead of using fixed ranges.
+  bool workStealing;
+
+  //! Number of datapoints claimed from the shared queue at a time.
+  size_t stealChunkSize;
+
+  //! Whether worker threads run without epoch-boundary barriers.
+  bool async;
+
+  //! How many epochs' worth of samples workers may run ahead of the last
+  //! objective snapshot in asynchronous mode.
+  size_t maxStaleness;
+
+  //! Whether each thread works on a local replica of the parameters.
+  bool localReplicas;
+
+  //! Number of samples a thread processes between replica merges.
+  size_t mergeInterval;
+
+  //! Number of gradient entries applied per step; 0 disables sparsification.
+  size_t topK;
+
+  //! Whether elastic averaging (EASGD) is used.
+  bool elasticAveraging;
+
+  //! The elastic coupling strength.
+  double elasticAlpha;
+
+  //! Whether striped-lock updates are used.
+  bool stripedLocks;
+
+  //! The number of stripes the iterate is partitioned into.
+  size_t numStripes;
+
+  //! Whether the throughput autotuner is enabled.
+  bool autotune;
+
+  //! Iterations between schedule recalibrations; 0 tunes only once.
+  size_t autotuneInterval;
+
   //! The step size decay policy.
   DecayPolicyType decayPolicy;
 };
@@ -17,6 +17,13 @@
 
 #include <ensmallen_bits/function.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
 namespace ens {
 
 // Utility function to update a location of a dense matrix or other type using
@@ -45,6 +52,88 @@ inline void UpdateLocation(arma::SpMat<eT>& iterate,
   }
 }
 
+// Striped-lock updates write elements of the iterate in place under a
+// stripe's spinlock, which is only safe for dense types; inserting into a
+// sparse matrix mutates shared structure outside the stripe, so sparse
+// iterates keep the critical-section path.
+template<typename MatType>
+inline bool StripedUpdateSupported(const MatType& /* iterate */)
+{
+  return true;
+}
+
+template<typename eT>
+inline bool StripedUpdateSupported(const arma::SpMat<eT>& /* iterate */)
+{
+  return false;
+}
+
+// Utility function to compute the overall objective of a separable function
+// in parallel with a deterministic summation order.  The individual functions
+// are summed in fixed-size chunks, and the chunk partials are combined by a
+// pairwise tree in a fixed order; both depend only on the number of
+// functions, not on the number of threads, so the result is bitwise
+// reproducible across runs and thread counts.
+template<typename FunctionType, typename MatType>
+inline typename MatType::elem_type DeterministicObjective(
+    FunctionType& function, const MatType& iterate)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  const size_t numFunctions = function.NumFunctions();
+  if (numFunctions == 0)
+    return 0;
+
+  const size_t chunkSize = 64;
+  const size_t numChunks = (numFunctions + chunkSize - 1) / chunkSize;
+  arma::Col<ElemType> partials(numChunks);
+
+  ENS_PRAGMA_OMP_PARALLEL_FOR
+  for (ptrdiff_t c = 0; c < (ptrdiff_t) numChunks; ++c)
+  {
+    const size_t begin = c * chunkSize;
+    partials(c) = function.Evaluate(iterate, begin,
+        std::min(chunkSize, numFunctions - begin));
+  }
+
+  // Combine the partials pairwise: (0, 1), (2, 3), ... with any odd element
+  // carried over, until one value remains.
+  size_t length = numChunks;
+  while (length > 1)
+  {
+    for (size_t c = 0; c < length / 2; ++c)
+      partials(c) = partials(2 * c) + partials(2 * c + 1);
+    if (length % 2 == 1)
+      partials(length / 2) = partials(length - 1);
+    length = (length + 1) / 2;
+  }
+
+  return partials(0);
+}
+
+// Utility overload pair to pass staleness information to decay policies that
+// can use it: if the policy provides StepSize(numEpoch, staleness) the first
+// overload is preferred (the int parameter matches exactly); policies with
+// only the classic StepSize(numEpoch) fall back to the second.
+template<typename DecayPolicyType>
+inline auto StepSizeForUpdate(DecayPolicyType& decayPolicy,
+                              const size_t numEpoch,
+                              const size_t staleness,
+                              int)
+    -> decltype(decayPolicy.StepSize(numEpoch, staleness))
+{
+  return decayPolicy.StepSize(numEpoch, staleness);
+}
+
+template<typename DecayPolicyType>
+inline double StepSizeForUpdate(DecayPolicyType& decayPolicy,
+                                const size_t numEpoch,
+                                const size_t /* staleness */,
+                                long)
+{
+  return decayPolicy.StepSize(numEpoch);
+}
+
 template <typename DecayPolicyType>
 ParallelSGD<DecayPolicyType>::ParallelSGD(
     const size_t maxIterations,
@@ -56,9 +145,114 @@ ParallelSGD<DecayPolicyType>::ParallelSGD(
     threadShareSize(threadShareSize),
     tolerance(tolerance),
     shuffle(shuffle),
+    workStealing(false),
+    stealChunkSize(16),
+    async(false),
+    maxStaleness(2),
+    localReplicas(false),
+    mergeInterval(64),
+    topK(0),
+    elasticAveraging(false),
+    elasticAlpha(0.5),
+    stripedLocks(false),
+    numStripes(64),
+    autotune(false),
+    autotuneInterval(16),
     decayPolicy(decayPolicy)
 { /* Nothing to do. */ }
 
+template <typename DecayPolicyType>
+template <typename SparseFunctionType, typename MatType, typename GradType>
+size_t ParallelSGD<DecayPolicyType>::CalibrateSchedule(
+    SparseFunctionType& function,
+    MatType& iterate,
+    const arma::Col<size_t>& visitationOrder,
+    const double stepSize)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  const size_t maxThreads = ParallelRuntime::Get().RegionThreads();
+
+  // One timed probe at the given schedule.  The probe is one iteration's
+  // worth of plain HOGWILD!-style updates with the current step size: real
+  // optimization steps, so the calibration phase advances the run instead
+  // of discarding its work.
+  auto measure = [&](const size_t threads, const size_t share) -> double
+  {
+    const size_t totalShare = std::min((size_t) visitationOrder.n_elem,
+        threads * share);
+
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    ENS_PRAGMA_OMP_PARALLEL_THREADS((int) threads)
+    {
+      size_t threadId = 0;
+      #ifdef ENS_USE_OPENMP
+        threadId = omp_get_thread_num();
+      #endif
+
+      for (size_t j = threadId * share;
+          j < (threadId + 1) * share && j < totalShare; ++j)
+      {
+        GradType gradient;
+        function.Gradient(iterate, visitationOrder[j], gradient, 1);
+
+        for (size_t i = 0; i < gradient.n_cols; ++i)
+        {
+          const typename GradType::iterator curEnd = gradient.end_col(i);
+          for (typename GradType::iterator cur = gradient.begin_col(i);
+              cur != curEnd; ++cur)
+          {
+            UpdateLocation(iterate, cur.row(), i,
+                (ElemType) (stepSize * (*cur)));
+          }
+        }
+      }
+    }
+    const double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    // Samples per second; guard against a clock tick of zero.
+    return (double) totalShare / std::max(elapsed, 1e-9);
+  };
+
+  // Coordinate search: first the thread count at the current share size
+  // (powers of two up to the runtime's limit, plus the limit itself), then
+  // the share size around the current value at the chosen thread count.
+  size_t bestThreads = maxThreads;
+  double bestRate = measure(maxThreads, threadShareSize);
+  for (size_t t = 1; t < maxThreads; t *= 2)
+  {
+    const double rate = measure(t, threadShareSize);
+    if (rate > bestRate)
+    {
+      bestRate = rate;
+      bestThreads = t;
+    }
+  }
+
+  const size_t shareCandidates[2] = {
+      std::max((size_t) 1, threadShareSize / 2), 2 * threadShareSize };
+  for (size_t c = 0; c < 2; ++c)
+  {
+    if (shareCandidates[c] == threadShareSize)
+      continue;
+
+    const double rate = measure(bestThreads, shareCandidates[c]);
+    if (rate > bestRate)
+    {
+      bestRate = rate;
+      threadShareSize = shareCandidates[c];
+    }
+  }
+
+  Info << "Parallel SGD: autotuned to " << bestThreads << " threads, thread"
+      << " share size " << threadShareSize << " (" << bestRate
+      << " samples/s)." << std::endl;
+
+  return bestThreads;
+}
+
 template <typename DecayPolicyType>
 template <typename SparseFunctionType,
           typename MatType,
@@ -84,12 +278,24 @@ typename MatType::elem_type>::type ParallelSGD<DecayPolicyType>::Optimize(
 
   BaseMatType& iterate = (BaseMatType&) iterateIn;
 
+  // In asynchronous mode, hand off to the barrier-free implementation.
+  if (async)
+  {
+    return OptimizeAsync<SparseFunctionType, MatType, GradType,
+        CallbackTypes...>(function, iterateIn,
+        std::forward<CallbackTypes>(callbacks)...);
+  }
+
   ElemType overallObjective = DBL_MAX;
   ElemType lastObjective;
 
   // Controls early termination of the optimization process.
   bool terminate = false;
 
+  // Thread count locked in by the autotuner; 0 means not tuned (yet), in
+  // which case the shared parallel runtime decides.
+  size_t tunedThreads = 0;
+
   // The order in which the functions will be visited.
   // TODO: maybe use function.Shuffle() instead?
   arma::Col<size_t> visitationOrder = arma::linspace<arma::Col<size_t>>(0,
@@ -104,7 +310,7 @@ typename MatType::elem_type>::type ParallelSGD<DecayPolicyType>::Optimize(
     // Calculate the overall objective.
     lastObjective = overallObjective;
 
-    overallObjective = function.Evaluate(iterate);
+    overallObjective = DeterministicObjective(function, iterate);
 
     terminate |= Callback::Evaluate(*this, function, iterate, overallObjective,
         callbacks...);
@@ -142,18 +348,179 @@ typename MatType::elem_type>::type ParallelSGD<DecayPolicyType>::Optimize(
       visitationOrder = arma::shuffle(visitationOrder);
     }
 
-    ENS_PRAGMA_OMP_PARALLEL
+    // (Re)calibrate the schedule when the autotuner is enabled: once at the
+    // start of the run, and again every autotuneInterval iterations, since
+    // the best settings can drift as gradients change density.
+    if (autotune && (i == 1 ||
+        (autotuneInterval > 0 && i % autotuneInterval == 0)))
     {
-      // Each processor gets a subset of the instances.
-      // Each subset is of size threadShareSize
-      size_t threadId = 0;
-      #ifdef ENS_USE_OPENMP
-        threadId = omp_get_thread_num();
-      #endif
+      tunedThreads = CalibrateSchedule<SparseFunctionType, BaseMatType,
+          BaseGradType>(function, iterate, visitationOrder, stepSize);
+    }
+
+    // The total amount of work in this iteration stays the same in both
+    // scheduling modes: up to threadShareSize datapoints per thread.  The
+    // thread count comes from the autotuner when it has run, and otherwise
+    // from the shared parallel runtime, so it honors a library-wide
+    // override and does not oversubscribe when this Optimize() call is
+    // itself nested inside a parallel region.
+    const size_t numThreads = (tunedThreads > 0) ? tunedThreads :
+        ParallelRuntime::Get().RegionThreads();
+    const size_t totalShare = std::min((size_t) visitationOrder.n_elem,
+        numThreads * threadShareSize);
+
+    // Shared cursor from which threads claim chunks of the visitation order
+    // when work stealing is enabled.
+    std::atomic<size_t> cursor(0);
+
+    // Striped-lock mode: one spinlock per contiguous stripe of the iterate.
+    // Thread-local replica modes have no write sharing and take precedence.
+    const bool useStripes = stripedLocks && !localReplicas &&
+        !elasticAveraging && StripedUpdateSupported(iterate);
+    const size_t stripes = std::max((size_t) 1, numStripes);
+    const size_t stripeSize = (iterate.n_elem + stripes - 1) / stripes;
+    std::unique_ptr<std::atomic<bool>[]> stripeLockArray;
+    if (useStripes)
+    {
+      stripeLockArray.reset(new std::atomic<bool>[stripes]);
+      for (size_t s = 0; s < stripes; ++s)
+        stripeLockArray[s].store(false, std::memory_order_relaxed);
+    }
 
-      for (size_t j = threadId * threadShareSize;
-          j < (threadId + 1) * threadShareSize && j < visitationOrder.n_elem;
-          ++j)
+    ENS_PRAGMA_OMP_PARALLEL_THREADS((int) numThreads)
+    {
+      // When local replicas are enabled, each thread works on its own copy
+      // of the parameters instead of hammering the shared iterate.  The
+      // replica and the delta are allocated (and first touched) by the
+      // thread that uses them, so on NUMA machines their pages land on the
+      // thread's own socket and the per-sample updates generate no
+      // cross-socket cache-line traffic.  The accumulated delta is folded
+      // into the shared iterate every mergeInterval samples, and the replica
+      // is refreshed from the merged state.
+      // Elastic averaging also gives each thread a private iterate, but
+      // instead of merging raw deltas, the private iterate and the shared
+      // center variable are pulled toward each other by elasticAlpha on the
+      // same cadence; between syncs there is no write sharing at all.
+      BaseMatType localIterate;
+      BaseMatType localDelta;
+      size_t samplesSinceMerge = 0;
+      if (localReplicas || elasticAveraging)
+        localIterate = iterate;
+      if (localReplicas)
+        localDelta.zeros(iterate.n_rows, iterate.n_cols);
+
+      auto mergeReplica = [&]()
+      {
+        ENS_PRAGMA_OMP_CRITICAL
+        {
+          iterate += localDelta;
+          localIterate = iterate;
+        }
+        localDelta.zeros();
+        samplesSinceMerge = 0;
+      };
+
+      // Elastic coupling step: move the private iterate and the center
+      // variable toward each other by the elastic strength.
+      auto elasticSync = [&]()
+      {
+        ENS_PRAGMA_OMP_CRITICAL
+        {
+          const BaseMatType diff = (ElemType) elasticAlpha *
+              (localIterate - iterate);
+          localIterate -= diff;
+          iterate += diff;
+        }
+        samplesSinceMerge = 0;
+      };
+
+      // Pending updates held back by top-k sparsification (error feedback);
+      // thread-local, so on NUMA machines it is socket-local as well.
+      arma::Mat<ElemType> residual;
+      if (topK > 0)
+        residual.zeros(iterate.n_rows, iterate.n_cols);
+
+      // Apply one update entry to the shared iterate, or to the thread-local
+      // replica when local replicas are enabled.
+      auto applyUpdate = [&](const arma::uword row,
+                             const arma::uword col,
+                             const ElemType value)
+      {
+        if (elasticAveraging)
+        {
+          // Private iterate; coupled to the center on cadence below.
+          localIterate(row, col) -= value;
+        }
+        else if (localReplicas)
+        {
+          // Socket-local, lock-free writes; merged on cadence below.
+          localIterate(row, col) -= value;
+          localDelta(row, col) -= value;
+        }
+        else
+        {
+          // Call out to utility function to use the right type of OpenMP
+          // lock.
+          UpdateLocation(iterate, row, col, value);
+        }
+      };
+
+      // Striped-lock application of one whole gradient: collect the touched
+      // stripes, acquire their spinlocks in ascending index order (so two
+      // threads can never wait on each other in a cycle), write every entry
+      // directly, and release.  Holding all touched stripes makes the
+      // sample's update atomic with respect to other samples, which avoids
+      // the overwrite churn of per-element lock-free updates at medium
+      // gradient density.
+      std::vector<size_t> touchedStripes;
+      auto applyStripedGradient = [&](BaseGradType& gradient)
+      {
+        touchedStripes.clear();
+        for (size_t i = 0; i < gradient.n_cols; ++i)
+        {
+          const typename GradType::iterator curEnd = gradient.end_col(i);
+          for (typename GradType::iterator cur = gradient.begin_col(i);
+              cur != curEnd; ++cur)
+          {
+            touchedStripes.push_back(
+                (cur.row() + i * iterate.n_rows) / stripeSize);
+          }
+        }
+        std::sort(touchedStripes.begin(), touchedStripes.end());
+        touchedStripes.erase(std::unique(touchedStripes.begin(),
+            touchedStripes.end()), touchedStripes.end());
+
+        for (size_t t = 0; t < touchedStripes.size(); ++t)
+        {
+          std::atomic<bool>& lock = stripeLockArray[touchedStripes[t]];
+          // Test-and-test-and-set spin: the inner load keeps the waiting
+          // thread out of the cache-coherence write traffic.
+          while (lock.exchange(true, std::memory_order_acquire))
+          {
+            while (lock.load(std::memory_order_relaxed)) { }
+          }
+        }
+
+        for (size_t i = 0; i < gradient.n_cols; ++i)
+        {
+          const typename GradType::iterator curEnd = gradient.end_col(i);
+          for (typename GradType::iterator cur = gradient.begin_col(i);
+              cur != curEnd; ++cur)
+          {
+            iterate(cur.row(), i) -= (ElemType) (stepSize * (*cur));
+          }
+        }
+
+        for (size_t t = touchedStripes.size(); t > 0; --t)
+        {
+          stripeLockArray[touchedStripes[t - 1]].store(false,
+              std::memory_order_release);
+        }
+      };
+
+      // Process the gradient of a single datapoint and apply the sparse
+      // update to the shared iterate (or to the thread-local replica).
+      auto processSample = [&](const size_t j)
       {
         // Each instance affects only some components of the decision variable.
         // So the gradient is sparse.
@@ -161,31 +528,145 @@ typename MatType::elem_type>::type ParallelSGD<DecayPolicyType>::Optimize(
 
         // Evaluate the sparse gradient.
         // TODO: support for batch size > 1 could be really useful.
-        function.Gradient(iterate, visitationOrder[j], gradient, 1);
+        function.Gradient(
+            (localReplicas || elasticAveraging) ? localIterate : iterate,
+            visitationOrder[j], gradient, 1);
 
         terminate |= Callback::Gradient(*this, function, iterate, gradient,
             callbacks...);
 
-        // Update the decision variable with non-zero components of the
-        // gradient.
-        for (size_t i = 0; i < gradient.n_cols; ++i)
+        // In striped-lock mode the whole sample is applied under its
+        // touched stripe locks.  Top-k sparsification applies entries on
+        // its own (per-element) cadence and keeps the default path.
+        if (useStripes && topK == 0)
         {
-          // Iterate over the non-zero elements.
-          const typename GradType::iterator curEnd = gradient.end_col(i);
-          for (typename GradType::iterator cur = gradient.begin_col(i);
-              cur != curEnd; ++cur)
+          applyStripedGradient(gradient);
+        }
+        else
+        {
+          // Update the decision variable with non-zero components of the
+          // gradient.  With top-k sparsification the new entries are folded
+          // into the residual first, and only the k largest pending updates
+          // are applied; the rest stay in the residual (error feedback) and
+          // get their chance on a later step.
+          for (size_t i = 0; i < gradient.n_cols; ++i)
           {
-            const ElemType value = (*cur);
-            const arma::uword row = cur.row();
+            // Iterate over the non-zero elements.
+            const typename GradType::iterator curEnd = gradient.end_col(i);
+            for (typename GradType::iterator cur = gradient.begin_col(i);
+                cur != curEnd; ++cur)
+            {
+              const ElemType value = (*cur);
+              const arma::uword row = cur.row();
+
+              if (topK > 0)
+                residual(row, i) += stepSize * value;
+              else
+                applyUpdate(row, i, stepSize * value);
+            }
+          }
+        }
 
-            // Call out to utility function to use the right type of OpenMP
-            // lock.
-            UpdateLocation(iterate, row, i, stepSize * value);
+        if (topK > 0)
+        {
+          const arma::uvec pending = arma::find(residual);
+          if (pending.n_elem <= topK)
+          {
+            // Everything pending fits in the budget; apply it all.
+            for (size_t t = 0; t < pending.n_elem; ++t)
+            {
+              const arma::uword idx = pending[t];
+              applyUpdate(idx % residual.n_rows, idx / residual.n_rows,
+                  residual(idx));
+              residual(idx) = 0;
+            }
+          }
+          else
+          {
+            // Rank the pending updates by magnitude and apply the k largest.
+            const arma::uvec order = arma::sort_index(
+                arma::abs(residual.elem(pending)), "descend");
+            for (size_t t = 0; t < topK; ++t)
+            {
+              const arma::uword idx = pending[order[t]];
+              applyUpdate(idx % residual.n_rows, idx / residual.n_rows,
+                  residual(idx));
+              residual(idx) = 0;
+            }
           }
         }
+
+        if ((localReplicas || elasticAveraging) &&
+            ++samplesSinceMerge >= mergeInterval)
+        {
+          if (elasticAveraging)
+            elasticSync();
+          else
+            mergeReplica();
+        }
+
         terminate |= Callback::StepTaken(*this, function, iterate,
             callbacks...);
+      };
+
+      if (workStealing)
+      {
+        // Threads repeatedly pull chunks from the shared cursor until the
+        // work budget for this iteration is exhausted; threads that draw
+        // cheap samples simply come back for more, so skewed per-sample
+        // costs no longer leave cores idle.
+        const size_t chunk = std::max(stealChunkSize, (size_t) 1);
+        while (true)
+        {
+          const size_t start = cursor.fetch_add(chunk,
+              std::memory_order_relaxed);
+          if (start >= totalShare)
+            break;
+
+          const size_t end = std::min(start + chunk, totalShare);
+          for (size_t j = start; j < end; ++j)
+            processSample(j);
+        }
       }
+      else
+      {
+        // Static partitioning: each processor gets a fixed subset of the
+        // instances, each of size threadShareSize.
+        size_t threadId = 0;
+        #ifdef ENS_USE_OPENMP
+          threadId = omp_get_thread_num();
+        #endif
+
+        for (size_t j = threadId * threadShareSize;
+            j < (threadId + 1) * threadShareSize && j < visitationOrder.n_elem;
+            ++j)
+        {
+          processSample(j);
+        }
+      }
+
+      // Flush any updates still held back by the error feedback, so each
+      // epoch ends with every update applied.
+      if (topK > 0)
+      {
+        const arma::uvec pending = arma::find(residual);
+        for (size_t t = 0; t < pending.n_elem; ++t)
+        {
+          const arma::uword idx = pending[t];
+          applyUpdate(idx % residual.n_rows, idx / residual.n_rows,
+              residual(idx));
+          residual(idx) = 0;
+        }
+      }
+
+      // Fold any delta accumulated since the last merge into the shared
+      // iterate before leaving the parallel region; with elastic averaging,
+      // couple to the center one last time so the epoch's progress reaches
+      // the center variable.
+      if (localReplicas && samplesSinceMerge > 0)
+        mergeReplica();
+      else if (elasticAveraging && samplesSinceMerge > 0)
+        elasticSync();
     }
   }
 
@@ -196,6 +677,160 @@ typename MatType::elem_type>::type ParallelSGD<DecayPolicyType>::Optimize(
   return overallObjective;
 }
 
+//! Asynchronous (epoch-barrier-free) optimization with bounded staleness.
+template <typename DecayPolicyType>
+template <typename SparseFunctionType,
+          typename MatType,
+          typename GradType,
+          typename... CallbackTypes>
+typename MatType::elem_type ParallelSGD<DecayPolicyType>::OptimizeAsync(
+    SparseFunctionType& function,
+    MatType& iterateIn,
+    CallbackTypes&&... callbacks)
+{
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef typename MatTypeTraits<GradType>::BaseMatType BaseGradType;
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+
+  const size_t numFunctions = function.NumFunctions();
+
+  // The order in which the functions will be visited.
+  arma::Col<size_t> visitationOrder = arma::linspace<arma::Col<size_t>>(0,
+      (numFunctions - 1), numFunctions);
+  if (shuffle)
+    visitationOrder = arma::shuffle(visitationOrder);
+
+  // Shared optimization state.  Workers claim samples from the cursor; the
+  // calling thread evaluates snapshots and advances evaluatedSamples, which
+  // bounds how far workers may run ahead.
+  std::atomic<size_t> cursor(0);
+  std::atomic<size_t> evaluatedSamples(0);
+  std::atomic<bool> stop(false);
+
+  // One "iteration" of the synchronous implementation processes up to
+  // threadShareSize samples per thread; keep the same total budget here.
+  // The worker count comes from the shared parallel runtime.
+  const size_t numThreads = ParallelRuntime::Get().RegionThreads();
+  const size_t totalSamples = (maxIterations == 0) ?
+      std::numeric_limits<size_t>::max() :
+      maxIterations * numThreads * threadShareSize;
+
+  // Samples workers may process beyond the last evaluated snapshot.
+  const size_t stalenessBound = std::max((size_t) 1, maxStaleness) *
+      numFunctions;
+
+  bool terminate = false;
+  Callback::BeginOptimization(*this, function, iterate, callbacks...);
+
+  // Worker thread body: claim samples and apply HOGWILD!-style sparse
+  // updates to the shared iterate, yielding when the staleness bound is hit.
+  auto worker = [&]()
+  {
+    while (!stop.load(std::memory_order_relaxed))
+    {
+      const size_t ticket = cursor.fetch_add(1, std::memory_order_relaxed);
+      if (ticket >= totalSamples)
+        break;
+
+      // Enforce the staleness bound relative to the last snapshot.
+      while (!stop.load(std::memory_order_relaxed) &&
+          (ticket > evaluatedSamples.load(std::memory_order_relaxed) +
+           stalenessBound))
+      {
+        std::this_thread::yield();
+      }
+      if (stop.load(std::memory_order_relaxed))
+        break;
+
+      // The staleness of this update is the distance the worker has run
+      // ahead of the last evaluated snapshot; staleness-aware decay policies
+      // use it to scale the step down, others ignore it.
+      const size_t evaluated =
+          evaluatedSamples.load(std::memory_order_relaxed);
+      const size_t staleness = (ticket > evaluated) ? ticket - evaluated : 0;
+      const double stepSize = StepSizeForUpdate(decayPolicy,
+          1 + ticket / (numThreads * threadShareSize), staleness, 0);
+
+      BaseGradType gradient;
+      function.Gradient(iterate, visitationOrder[ticket % numFunctions],
+          gradient, 1);
+
+      for (size_t i = 0; i < gradient.n_cols; ++i)
+      {
+        const typename GradType::iterator curEnd = gradient.end_col(i);
+        for (typename GradType::iterator cur = gradient.begin_col(i);
+            cur != curEnd; ++cur)
+        {
+          UpdateLocation(iterate, cur.row(), i,
+              (ElemType) (stepSize * (*cur)));
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < numThreads; ++t)
+    workers.emplace_back(worker);
+
+  // Evaluation loop: snapshot the iterate (HOGWILD!-style, without locking;
+  // individual elements may be mid-update, which the algorithm tolerates),
+  // evaluate the objective, and advance the staleness window.
+  ElemType overallObjective = DBL_MAX;
+  ElemType lastObjective;
+  BaseMatType snapshot;
+  while (!terminate)
+  {
+    const size_t processed = std::min(
+        cursor.load(std::memory_order_relaxed), totalSamples);
+
+    snapshot = iterate;
+    lastObjective = overallObjective;
+    overallObjective = DeterministicObjective(function, snapshot);
+
+    terminate |= Callback::Evaluate(*this, function, snapshot,
+        overallObjective, callbacks...);
+
+    Info << "Parallel SGD (async): " << processed << " samples processed, "
+        << "objective " << overallObjective << "." << std::endl;
+
+    if (std::isnan(overallObjective) || std::isinf(overallObjective))
+    {
+      Warn << "Parallel SGD (async): converged to " << overallObjective
+          << "; terminating with failure. Try a smaller step size?"
+          << std::endl;
+      break;
+    }
+
+    if (std::abs(lastObjective - overallObjective) < tolerance)
+    {
+      Info << "Parallel SGD (async): minimized within tolerance " << tolerance
+          << "; terminating optimization." << std::endl;
+      break;
+    }
+
+    if (processed >= totalSamples)
+      break;
+
+    // Release workers blocked on the staleness bound.
+    evaluatedSamples.store(processed, std::memory_order_relaxed);
+  }
+
+  stop.store(true, std::memory_order_relaxed);
+  for (size_t t = 0; t < workers.size(); ++t)
+    workers[t].join();
+
+  overallObjective = DeterministicObjective(function, iterate);
+
+  Info << "\nParallel SGD (async) terminated with objective : "
+      << overallObjective << "." << std::endl;
+
+  Callback::EndOptimization(*this, function, iterate, callbacks...);
+  return overallObjective;
+}
+
 } // namespace ens
 
 #endif
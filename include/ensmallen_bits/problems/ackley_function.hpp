@@ -79,6 +79,17 @@ class AckleyFunction
   template<typename MatType>
   typename MatType::elem_type Evaluate(const MatType& coordinates) const;
 
+  /**
+   * Evaluate a whole population of candidates at once, one vectorized
+   * candidate per column.  Population optimizers detect this batched
+   * overload and use it to score a generation in one vectorized pass.
+   *
+   * @param population Matrix with one candidate per column.
+   * @param fitness Vector to store the objective of every candidate into.
+   */
+  template<typename MatType, typename ColType>
+  void Evaluate(const MatType& population, ColType& fitness) const;
+
   /**
    * Evaluate the gradient of a function for a particular batch-size.
    *
@@ -51,6 +51,20 @@ typename MatType::elem_type AckleyFunction::Evaluate(
   return Evaluate(coordinates, 0, NumFunctions());
 }
 
+template<typename MatType, typename ColType>
+void AckleyFunction::Evaluate(const MatType& population,
+                              ColType& fitness) const
+{
+  typedef typename MatType::elem_type ElemType;
+
+  const arma::Row<ElemType> x1 = population.row(0);
+  const arma::Row<ElemType> x2 = population.row(1);
+
+  fitness = (-20.0 * arma::exp(-0.2 * arma::sqrt(0.5 * (x1 % x1 + x2 % x2))) -
+      arma::exp(0.5 * (arma::cos(c * x1) + arma::cos(c * x2))) +
+      std::exp(1) + 20.0).t();
+}
+
 template<typename MatType, typename GradType>
 inline void AckleyFunction::Gradient(const MatType& coordinates,
                                      const size_t /* begin */,
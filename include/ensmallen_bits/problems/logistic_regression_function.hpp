@@ -21,16 +21,24 @@ namespace test {
  * The log-likelihood function for the logistic regression objective function.
  * This is used by various ensmallen optimizers to train a logistic regression
  * model.
+ *
+ * The type of the data matrix can be chosen independently of the type of the
+ * parameters, so sparse data can be used directly with dense parameters:
+ * LogisticRegressionFunction<arma::mat, arma::sp_mat> evaluates the objective
+ * and gradient at a cost proportional to the number of nonzero data elements.
+ *
+ * @tparam MatType Type of the parameters matrix (and gradients).
+ * @tparam DataType Type of the predictors matrix (defaults to MatType).
  */
-template<typename MatType = arma::mat>
+template<typename MatType = arma::mat, typename DataType = MatType>
 class LogisticRegressionFunction
 {
  public:
-  LogisticRegressionFunction(MatType& predictors,
+  LogisticRegressionFunction(DataType& predictors,
                              arma::Row<size_t>& responses,
                              const double lambda = 0);
 
-  LogisticRegressionFunction(MatType& predictors,
+  LogisticRegressionFunction(DataType& predictors,
                              arma::Row<size_t>& responses,
                              MatType& initialPoint,
                              const double lambda = 0);
@@ -46,7 +54,7 @@ class LogisticRegressionFunction
   double& Lambda() { return lambda; }
 
   //! Return the matrix of predictors.
-  const MatType& Predictors() const { return predictors; }
+  const DataType& Predictors() const { return predictors; }
   //! Return the vector of responses.
   const arma::Row<size_t>& Responses() const { return responses; }
 
@@ -69,6 +77,18 @@ class LogisticRegressionFunction
    */
   typename MatType::elem_type Evaluate(const MatType& parameters) const;
 
+  /**
+   * Evaluate the objective at a whole population of parameter vectors at
+   * once, one vectorized parameter set per column.  Population optimizers
+   * detect this batched overload and use it to score a generation against
+   * the data with a single matrix product.
+   *
+   * @param population Matrix with one vectorized parameter set per column.
+   * @param fitness Vector to store the objective of every candidate into.
+   */
+  template<typename PopType, typename ColType>
+  void Evaluate(const PopType& population, ColType& fitness) const;
+
   /**
    * Evaluate the logistic regression log-likelihood function with the given
    * parameters using the given batch size from the given point index.  This is
@@ -134,6 +154,22 @@ class LogisticRegressionFunction
                        const size_t j,
                        arma::sp_mat& gradient) const;
 
+  /**
+   * Evaluate the gradient of the logistic regression log-likelihood function
+   * with the given parameters, with respect to a block of features at once.
+   * The vector of prediction residuals is computed once and shared by every
+   * feature in the block, so this is much cheaper than one PartialGradient()
+   * call per feature.
+   *
+   * @param parameters Vector of logistic regression parameters.
+   * @param features Indices of the features with respect to which the
+   *    gradient is to be computed.
+   * @param gradient Sparse matrix to output gradient into.
+   */
+  void PartialGradient(const MatType& parameters,
+                       const arma::uvec& features,
+                       arma::sp_mat& gradient) const;
+
   /**
    * Evaluate the objective function and gradient of the logistic regression
    * log-likelihood function simultaneously with the given parameters.
@@ -174,7 +210,7 @@ class LogisticRegressionFunction
    * @param decisionBoundary Decision boundary (default 0.5).
    * @return Percentage of responses that are predicted correctly.
    */
-  double ComputeAccuracy(const MatType& predictors,
+  double ComputeAccuracy(const DataType& predictors,
                          const arma::Row<size_t>& responses,
                          const MatType& parameters,
                          const double decisionBoundary = 0.5) const;
@@ -191,17 +227,44 @@ class LogisticRegressionFunction
    * @param parameters Vector of logistic regression parameters.
    * @param decisionBoundary Decision boundary (default 0.5).
    */
-  void Classify(const MatType& dataset,
+  void Classify(const DataType& dataset,
                 arma::Row<size_t>& labels,
                 const MatType& parameters,
                 const double decisionBoundary = 0.5) const;
 
  private:
+  /**
+   * Apply the logistic sigmoid 1 / (1 + e^-z) to every element of the row of
+   * linear terms, in place.  Keeping the map in a single vectorized pass over
+   * one buffer avoids the temporaries that writing the expression longhand at
+   * every call site would produce.
+   */
+  static void SigmoidKernel(arma::Row<typename MatType::elem_type>& z)
+  {
+    z = 1.0 / (1.0 + arma::exp(-z));
+  }
+
+  /**
+   * Reorder the columns of the data matrix so that output column i is input
+   * column ordering[i].  The dense version copies column by column; the
+   * sparse version rebuilds the matrix with the batch constructor, which is
+   * much cheaper than inserting into a sparse matrix one column at a time.
+   */
+  template<typename eT>
+  static void ReorderCols(const arma::Mat<eT>& input,
+                          const arma::uvec& ordering,
+                          arma::Mat<eT>& output);
+
+  template<typename eT>
+  static void ReorderCols(const arma::SpMat<eT>& input,
+                          const arma::uvec& ordering,
+                          arma::SpMat<eT>& output);
+
   //! The initial point, from which to start the optimization.
   MatType initialPoint;
   //! The matrix of data points (predictors).  This is an alias until shuffling
   //! is done.
-  MatType& predictors;
+  DataType& predictors;
   //! The vector of responses to the input data points.  This is an alias until
   //! shuffling is done.
   arma::Row<size_t>& responses;
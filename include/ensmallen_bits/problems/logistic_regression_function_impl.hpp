@@ -18,9 +18,9 @@
 namespace ens {
 namespace test {
 
-template<typename MatType>
-LogisticRegressionFunction<MatType>::LogisticRegressionFunction(
-    MatType& predictors,
+template<typename MatType, typename DataType>
+LogisticRegressionFunction<MatType, DataType>::LogisticRegressionFunction(
+    DataType& predictors,
     arma::Row<size_t>& responses,
     const double lambda) :
     // We promise to be well-behaved... the elements won't be modified.
@@ -43,9 +43,9 @@ LogisticRegressionFunction<MatType>::LogisticRegressionFunction(
   }
 }
 
-template<typename MatType>
-LogisticRegressionFunction<MatType>::LogisticRegressionFunction(
-    MatType& predictors,
+template<typename MatType, typename DataType>
+LogisticRegressionFunction<MatType, DataType>::LogisticRegressionFunction(
+    DataType& predictors,
     arma::Row<size_t>& responses,
     MatType& initialPoint,
     const double lambda) :
@@ -64,18 +64,16 @@ LogisticRegressionFunction<MatType>::LogisticRegressionFunction(
 /**
  * Shuffle the datapoints.
  */
-template<typename MatType>
-void LogisticRegressionFunction<MatType>::Shuffle()
+template<typename MatType, typename DataType>
+void LogisticRegressionFunction<MatType, DataType>::Shuffle()
 {
-  MatType newPredictors;
+  DataType newPredictors;
   arma::Row<size_t> newResponses;
 
   arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
       predictors.n_cols - 1, predictors.n_cols));
 
-  newPredictors.set_size(predictors.n_rows, predictors.n_cols);
-  for (size_t i = 0; i < predictors.n_cols; ++i)
-    newPredictors.col(i) = predictors.col(ordering[i]);
+  ReorderCols(predictors, ordering, newPredictors);
   newResponses = responses.cols(ordering);
 
   // Take ownership of the new data.
@@ -87,8 +85,9 @@ void LogisticRegressionFunction<MatType>::Shuffle()
  * Evaluate the logistic regression objective function given the estimated
  * parameters.
  */
-template<typename MatType>
-typename MatType::elem_type LogisticRegressionFunction<MatType>::Evaluate(
+template<typename MatType, typename DataType>
+typename MatType::elem_type
+LogisticRegressionFunction<MatType, DataType>::Evaluate(
     const MatType& parameters) const
 {
   // The objective function is the log-likelihood function (w is the parameters
@@ -107,9 +106,10 @@ typename MatType::elem_type LogisticRegressionFunction<MatType>::Evaluate(
 
   // Calculate vectors of sigmoids.  The intercept term is parameters(0, 0) and
   // does not need to be multiplied by any of the predictors.
-  const arma::Row<ElemType> sigmoid = 1.0 / (1.0 +
-      arma::exp(-(parameters(0, 0) +
-                parameters.tail_cols(parameters.n_elem - 1) * predictors)));
+  arma::Row<ElemType> sigmoid =
+      parameters.tail_cols(parameters.n_elem - 1) * predictors;
+  sigmoid += parameters(0, 0);
+  SigmoidKernel(sigmoid);
 
   // Assemble full objective function.  Often the objective function and the
   // regularization as given are divided by the number of features, but this
@@ -125,12 +125,48 @@ typename MatType::elem_type LogisticRegressionFunction<MatType>::Evaluate(
   return regularization - result;
 }
 
+/**
+ * Evaluate the logistic regression objective function for a whole population
+ * of parameter vectors at once.
+ */
+template<typename MatType, typename DataType>
+template<typename PopType, typename ColType>
+void LogisticRegressionFunction<MatType, DataType>::Evaluate(
+    const PopType& population,
+    ColType& fitness) const
+{
+  typedef typename PopType::elem_type ElemType;
+
+  // Each column of the population holds one vectorized parameter set: the
+  // intercept in its first element and the feature weights below it.
+  const arma::Mat<ElemType> weights =
+      population.rows(1, population.n_rows - 1);
+
+  // One matrix product computes the linear terms of every candidate against
+  // every data point; row k of the result belongs to candidate k.
+  arma::Mat<ElemType> sigmoids = weights.t() * predictors;
+  sigmoids.each_col() += population.row(0).t();
+  sigmoids = 1.0 / (1.0 + arma::exp(-sigmoids));
+
+  const arma::Row<ElemType> respD =
+      arma::conv_to<arma::Row<ElemType>>::from(responses);
+
+  // As in the single-candidate Evaluate(), the per-point likelihood is
+  // 1 - y + sig % (2 y - 1); here it is assembled for all candidates at once.
+  sigmoids.each_row() %= 2.0 * respD - 1.0;
+  sigmoids.each_row() += 1.0 - respD;
+
+  fitness = 0.5 * lambda * arma::sum(weights % weights, 0).t() -
+      arma::sum(arma::log(sigmoids), 1);
+}
+
 /**
  * Evaluate the logistic regression objective function given the estimated
  * parameters for a given batch from a given point.
  */
-template<typename MatType>
-typename MatType::elem_type LogisticRegressionFunction<MatType>::Evaluate(
+template<typename MatType, typename DataType>
+typename MatType::elem_type
+LogisticRegressionFunction<MatType, DataType>::Evaluate(
     const MatType& parameters,
     const size_t begin,
     const size_t batchSize) const
@@ -144,10 +180,10 @@ typename MatType::elem_type LogisticRegressionFunction<MatType>::Evaluate(
                 parameters.tail_cols(parameters.n_elem - 1));
 
   // Calculate the sigmoid function values.
-  const arma::Row<ElemType> sigmoid = 1.0 / (1.0 +
-      arma::exp(-(parameters(0, 0) +
-                  parameters.tail_cols(parameters.n_elem - 1) *
-                      predictors.cols(begin, begin + batchSize - 1))));
+  arma::Row<ElemType> sigmoid = parameters.tail_cols(parameters.n_elem - 1) *
+      predictors.cols(begin, begin + batchSize - 1);
+  sigmoid += parameters(0, 0);
+  SigmoidKernel(sigmoid);
 
   // Compute the objective for the given batch size from a given point.
   arma::Row<ElemType> respD = arma::conv_to<arma::Row<ElemType>>::from(
@@ -160,9 +196,9 @@ typename MatType::elem_type LogisticRegressionFunction<MatType>::Evaluate(
 }
 
 //! Evaluate the gradient of the logistic regression objective function.
-template<typename MatType>
+template<typename MatType, typename DataType>
 template<typename GradType>
-void LogisticRegressionFunction<MatType>::Gradient(
+void LogisticRegressionFunction<MatType, DataType>::Gradient(
     const MatType& parameters,
     GradType& gradient) const
 {
@@ -171,8 +207,10 @@ void LogisticRegressionFunction<MatType>::Gradient(
   MatType regularization;
   regularization = lambda * parameters.tail_cols(parameters.n_elem - 1);
 
-  const arma::Row<ElemType> sigmoids = (1 / (1 + arma::exp(-parameters(0, 0)
-      - parameters.tail_cols(parameters.n_elem - 1) * predictors)));
+  arma::Row<ElemType> sigmoids =
+      parameters.tail_cols(parameters.n_elem - 1) * predictors;
+  sigmoids += parameters(0, 0);
+  SigmoidKernel(sigmoids);
 
   gradient.set_size(arma::size(parameters));
   gradient[0] = -arma::accu(responses - sigmoids);
@@ -182,9 +220,9 @@ void LogisticRegressionFunction<MatType>::Gradient(
 
 //! Evaluate the gradient of the logistic regression objective function for a
 //! given batch size.
-template<typename MatType>
+template<typename MatType, typename DataType>
 template<typename GradType>
-void LogisticRegressionFunction<MatType>::Gradient(
+void LogisticRegressionFunction<MatType, DataType>::Gradient(
                 const MatType& parameters,
                 const size_t begin,
                 GradType& gradient,
@@ -197,11 +235,11 @@ void LogisticRegressionFunction<MatType>::Gradient(
   regularization = lambda * parameters.tail_cols(parameters.n_elem - 1)
       / predictors.n_cols * batchSize;
 
-  const arma::Row<ElemType> exponents = parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) *
-      predictors.cols(begin, begin + batchSize - 1);
   // Calculating the sigmoid function values.
-  const arma::Row<ElemType> sigmoids = 1.0 / (1.0 + arma::exp(-exponents));
+  arma::Row<ElemType> sigmoids = parameters.tail_cols(parameters.n_elem - 1) *
+      predictors.cols(begin, begin + batchSize - 1);
+  sigmoids += parameters(0, 0);
+  SigmoidKernel(sigmoids);
 
   gradient.set_size(parameters.n_rows, parameters.n_cols);
   gradient[0] = -arma::accu(responses.subvec(begin, begin + batchSize - 1) -
@@ -215,16 +253,17 @@ void LogisticRegressionFunction<MatType>::Gradient(
  * Evaluate the partial gradient of the logistic regression objective
  * function with respect to the individual features in the parameter.
  */
-template <typename MatType>
-void LogisticRegressionFunction<MatType>::PartialGradient(
+template<typename MatType, typename DataType>
+void LogisticRegressionFunction<MatType, DataType>::PartialGradient(
     const MatType& parameters,
     const size_t j,
     arma::sp_mat& gradient) const
 {
-  const arma::Row<typename MatType::elem_type> diffs = responses -
-      (1 / (1 + arma::exp(-parameters(0, 0) -
-                          parameters.tail_cols(parameters.n_elem - 1) *
-                              predictors)));
+  arma::Row<typename MatType::elem_type> sigmoids =
+      parameters.tail_cols(parameters.n_elem - 1) * predictors;
+  sigmoids += parameters(0, 0);
+  SigmoidKernel(sigmoids);
+  const arma::Row<typename MatType::elem_type> diffs = responses - sigmoids;
 
   gradient.set_size(arma::size(parameters));
 
@@ -234,15 +273,45 @@ void LogisticRegressionFunction<MatType>::PartialGradient(
   }
   else
   {
-    gradient[j] = arma::dot(-predictors.row(j - 1), diffs) + lambda *
+    gradient[j] = -arma::dot(predictors.row(j - 1), diffs) + lambda *
       parameters(0, j);
   }
 }
 
-template<typename MatType>
+template<typename MatType, typename DataType>
+void LogisticRegressionFunction<MatType, DataType>::PartialGradient(
+    const MatType& parameters,
+    const arma::uvec& features,
+    arma::sp_mat& gradient) const
+{
+  // The residuals are computed once and shared by every feature in the block.
+  arma::Row<typename MatType::elem_type> sigmoids =
+      parameters.tail_cols(parameters.n_elem - 1) * predictors;
+  sigmoids += parameters(0, 0);
+  SigmoidKernel(sigmoids);
+  const arma::Row<typename MatType::elem_type> diffs = responses - sigmoids;
+
+  gradient.set_size(arma::size(parameters));
+
+  for (size_t k = 0; k < features.n_elem; ++k)
+  {
+    const size_t j = features[k];
+    if (j == 0)
+    {
+      gradient[j] = -arma::accu(diffs);
+    }
+    else
+    {
+      gradient[j] = -arma::dot(predictors.row(j - 1), diffs) + lambda *
+        parameters(0, j);
+    }
+  }
+}
+
+template<typename MatType, typename DataType>
 template<typename GradType>
 typename MatType::elem_type
-LogisticRegressionFunction<MatType>::EvaluateWithGradient(
+LogisticRegressionFunction<MatType, DataType>::EvaluateWithGradient(
     const MatType& parameters,
     GradType& gradient) const
 {
@@ -257,9 +326,10 @@ LogisticRegressionFunction<MatType>::EvaluateWithGradient(
                 parameters.tail_cols(parameters.n_elem - 1));
 
   // Calculate the sigmoid function values.
-  const arma::Row<ElemType> sigmoids = 1.0 / (1.0 +
-      arma::exp(-(parameters(0, 0) +
-                  parameters.tail_cols(parameters.n_elem - 1) * predictors)));
+  arma::Row<ElemType> sigmoids =
+      parameters.tail_cols(parameters.n_elem - 1) * predictors;
+  sigmoids += parameters(0, 0);
+  SigmoidKernel(sigmoids);
 
   gradient.set_size(arma::size(parameters));
   gradient[0] = -arma::accu(responses - sigmoids);
@@ -275,10 +345,10 @@ LogisticRegressionFunction<MatType>::EvaluateWithGradient(
   return objectiveRegularization - result;
 }
 
-template<typename MatType>
+template<typename MatType, typename DataType>
 template<typename GradType>
 typename MatType::elem_type
-LogisticRegressionFunction<MatType>::EvaluateWithGradient(
+LogisticRegressionFunction<MatType, DataType>::EvaluateWithGradient(
     const MatType& parameters,
     const size_t begin,
     GradType& gradient,
@@ -297,10 +367,10 @@ LogisticRegressionFunction<MatType>::EvaluateWithGradient(
                 parameters.tail_cols(parameters.n_elem - 1));
 
   // Calculate the sigmoid function values.
-  const arma::Row<ElemType> sigmoids = 1.0 / (1.0 +
-      arma::exp(-(parameters(0, 0) +
-                  parameters.tail_cols(parameters.n_elem - 1) *
-                      predictors.cols(begin, begin + batchSize - 1))));
+  arma::Row<ElemType> sigmoids = parameters.tail_cols(parameters.n_elem - 1) *
+      predictors.cols(begin, begin + batchSize - 1);
+  sigmoids += parameters(0, 0);
+  SigmoidKernel(sigmoids);
 
   gradient.set_size(parameters.n_rows, parameters.n_cols);
   gradient[0] = -arma::accu(responses.subvec(begin, begin + batchSize - 1) -
@@ -319,24 +389,26 @@ LogisticRegressionFunction<MatType>::EvaluateWithGradient(
   return objectiveRegularization - result;
 }
 
-template<typename MatType>
-void LogisticRegressionFunction<MatType>::Classify(
-    const MatType& dataset,
+template<typename MatType, typename DataType>
+void LogisticRegressionFunction<MatType, DataType>::Classify(
+    const DataType& dataset,
     arma::Row<size_t>& labels,
     const MatType& parameters,
     const double decisionBoundary) const
 {
   // Calculate sigmoid function for each point.  The (1.0 - decisionBoundary)
   // term correctly sets an offset so that floor() returns 0 or 1 correctly.
-  labels = arma::conv_to<arma::Row<size_t>>::from((1.0 /
-      (1.0 + arma::exp(-parameters(0) -
-      parameters.tail_cols(parameters.n_elem - 1) * dataset))) +
+  arma::Row<typename MatType::elem_type> sigmoids =
+      parameters.tail_cols(parameters.n_elem - 1) * dataset;
+  sigmoids += parameters(0);
+  SigmoidKernel(sigmoids);
+  labels = arma::conv_to<arma::Row<size_t>>::from(sigmoids +
       (1.0 - decisionBoundary));
 }
 
-template<typename MatType>
-double LogisticRegressionFunction<MatType>::ComputeAccuracy(
-    const MatType& predictors,
+template<typename MatType, typename DataType>
+double LogisticRegressionFunction<MatType, DataType>::ComputeAccuracy(
+    const DataType& predictors,
     const arma::Row<size_t>& responses,
     const MatType& parameters,
     const double decisionBoundary) const
@@ -356,6 +428,49 @@ double LogisticRegressionFunction<MatType>::ComputeAccuracy(
   return (double) (count * 100) / responses.n_elem;
 }
 
+//! Reorder the columns of a dense data matrix.
+template<typename MatType, typename DataType>
+template<typename eT>
+void LogisticRegressionFunction<MatType, DataType>::ReorderCols(
+    const arma::Mat<eT>& input,
+    const arma::uvec& ordering,
+    arma::Mat<eT>& output)
+{
+  output.set_size(input.n_rows, input.n_cols);
+  for (size_t i = 0; i < input.n_cols; ++i)
+    output.col(i) = input.col(ordering[i]);
+}
+
+//! Reorder the columns of a sparse data matrix, using the batch constructor.
+template<typename MatType, typename DataType>
+template<typename eT>
+void LogisticRegressionFunction<MatType, DataType>::ReorderCols(
+    const arma::SpMat<eT>& input,
+    const arma::uvec& ordering,
+    arma::SpMat<eT>& output)
+{
+  // Invert the ordering, so every nonzero can be placed directly.
+  arma::uvec reverseOrdering(ordering.n_elem);
+  for (size_t i = 0; i < ordering.n_elem; ++i)
+    reverseOrdering[ordering[i]] = i;
+
+  arma::umat locations(2, input.n_nonzero);
+  arma::Col<eT> values(input.n_nonzero);
+  typename arma::SpMat<eT>::const_iterator it = input.begin();
+  size_t loc = 0;
+  while (it != input.end())
+  {
+    locations(0, loc) = it.row();
+    locations(1, loc) = reverseOrdering[it.col()];
+    values[loc] = (*it);
+
+    ++it;
+    ++loc;
+  }
+
+  output = arma::SpMat<eT>(locations, values, input.n_rows, input.n_cols);
+}
+
 } // namespace test
 } // namespace ens
 
@@ -61,6 +61,15 @@ typename MatType::elem_type RastriginFunction::Evaluate(
   return Evaluate(coordinates, 0, NumFunctions());
 }
 
+template<typename MatType, typename ColType>
+void RastriginFunction::Evaluate(const MatType& population,
+                                 ColType& fitness) const
+{
+  fitness = (arma::sum(population % population -
+      10.0 * arma::cos(2.0 * arma::datum::pi * population), 0) +
+      10.0 * n).t();
+}
+
 template<typename MatType, typename GradType>
 inline void RastriginFunction::Gradient(const MatType& coordinates,
                                         const size_t begin,
@@ -16,6 +16,16 @@
 namespace ens {
 namespace test {
 
+/**
+ * The objective function for softmax regression.  The type of the data matrix
+ * is a template parameter, so sparse data can be used directly:
+ * SoftmaxRegressionFunction<arma::sp_mat> evaluates the objective and gradient
+ * at a cost proportional to the number of nonzero data elements, while the
+ * parameters and gradients stay dense.
+ *
+ * @tparam MatType Type of the data matrix (defaults to arma::mat).
+ */
+template<typename MatType = arma::mat>
 class SoftmaxRegressionFunction
 {
  public:
@@ -30,7 +40,7 @@ class SoftmaxRegressionFunction
    * @param lambda L2-regularization constant.
    * @param fitIntercept Intercept term flag.
    */
-  SoftmaxRegressionFunction(const arma::mat& data,
+  SoftmaxRegressionFunction(const MatType& data,
                             const arma::Row<size_t>& labels,
                             const size_t numClasses,
                             const double lambda = 0.0001,
@@ -183,8 +193,39 @@ class SoftmaxRegressionFunction
   bool FitIntercept() const { return fitIntercept; }
 
  private:
+  /**
+   * Make a non-owning alias of the given dense data matrix.  Sparse matrices
+   * cannot alias memory they do not own, so the sparse overload takes a copy
+   * instead.
+   */
+  template<typename eT>
+  static arma::Mat<eT> MakeDataAlias(const arma::Mat<eT>& data)
+  {
+    return arma::Mat<eT>(const_cast<arma::Mat<eT>&>(data).memptr(),
+        data.n_rows, data.n_cols, false, false);
+  }
+
+  template<typename eT>
+  static arma::SpMat<eT> MakeDataAlias(const arma::SpMat<eT>& data)
+  {
+    return data;
+  }
+
+  /**
+   * Re-sort the columns of the data matrix so that column i afterwards is
+   * column ordering[i] before.  The dense version gathers the columns in a
+   * single copy; the sparse version rebuilds the matrix with the batch
+   * constructor, since sparse matrices do not support non-contiguous column
+   * views.
+   */
+  template<typename eT>
+  static void ReorderData(arma::Mat<eT>& data, const arma::uvec& ordering);
+
+  template<typename eT>
+  static void ReorderData(arma::SpMat<eT>& data, const arma::uvec& ordering);
+
   //! Training data matrix.  This is an alias until the data is shuffled.
-  arma::mat data;
+  MatType data;
   //! Label matrix for the provided data.
   arma::sp_mat groundTruth;
   //! Initial parameter point.
@@ -18,14 +18,14 @@
 namespace ens {
 namespace test {
 
-inline SoftmaxRegressionFunction::SoftmaxRegressionFunction(
-    const arma::mat& data,
+template<typename MatType>
+SoftmaxRegressionFunction<MatType>::SoftmaxRegressionFunction(
+    const MatType& data,
     const arma::Row<size_t>& labels,
     const size_t numClasses,
     const double lambda,
     const bool fitIntercept) :
-    data(arma::mat(const_cast<arma::mat&>(data).memptr(), data.n_rows,
-      data.n_cols, false, false)),
+    data(MakeDataAlias(data)),
     numClasses(numClasses),
     lambda(lambda),
     fitIntercept(fitIntercept)
@@ -40,39 +40,16 @@ inline SoftmaxRegressionFunction::SoftmaxRegressionFunction(
 /**
  * Shuffle the data.
  */
-inline void SoftmaxRegressionFunction::Shuffle()
+template<typename MatType>
+void SoftmaxRegressionFunction<MatType>::Shuffle()
 {
   // Determine new ordering.
   arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
       data.n_cols - 1, data.n_cols));
 
-  // Re-sort data.
-  arma::mat newData = data.cols(ordering);
-  if (data.mem_state >= 1)
-    data.reset();
-  data = std::move(newData);
-
-  // Assemble data for batch constructor.  We need reverse orderings though...
-  arma::uvec reverseOrdering(ordering.n_elem);
-  for (size_t i = 0; i < ordering.n_elem; ++i)
-    reverseOrdering[ordering[i]] = i;
-
-  arma::umat newLocations(2, groundTruth.n_nonzero);
-  arma::vec values(groundTruth.n_nonzero);
-  arma::sp_mat::const_iterator it = groundTruth.begin();
-  size_t loc = 0;
-  while (it != groundTruth.end())
-  {
-    newLocations(0, loc) = reverseOrdering(it.col());
-    newLocations(1, loc) = it.row();
-    values(loc) = (*it);
-
-    ++it;
-    ++loc;
-  }
-
-  groundTruth = arma::sp_mat(newLocations, values, groundTruth.n_rows,
-      groundTruth.n_cols);
+  // Re-sort the data and the ground truth matrix into the same order.
+  ReorderData(data, ordering);
+  ReorderData(groundTruth, ordering);
 }
 
 /**
@@ -80,12 +57,14 @@ inline void SoftmaxRegressionFunction::Shuffle()
  * normal distribution. The weights cannot be initialized to zero, as that will
  * lead to each class output being the same.
  */
-inline const arma::mat SoftmaxRegressionFunction::InitializeWeights()
+template<typename MatType>
+const arma::mat SoftmaxRegressionFunction<MatType>::InitializeWeights()
 {
   return InitializeWeights(data.n_rows, numClasses, fitIntercept);
 }
 
-inline const arma::mat SoftmaxRegressionFunction::InitializeWeights(
+template<typename MatType>
+const arma::mat SoftmaxRegressionFunction<MatType>::InitializeWeights(
     const size_t featureSize,
     const size_t numClasses,
     const bool fitIntercept)
@@ -95,7 +74,8 @@ inline const arma::mat SoftmaxRegressionFunction::InitializeWeights(
     return parameters;
 }
 
-inline void SoftmaxRegressionFunction::InitializeWeights(
+template<typename MatType>
+void SoftmaxRegressionFunction<MatType>::InitializeWeights(
     arma::mat &weights,
     const size_t featureSize,
     const size_t numClasses,
@@ -116,7 +96,8 @@ inline void SoftmaxRegressionFunction::InitializeWeights(
  * labels. The output is in the form of a matrix, which leads to simpler
  * calculations in the Evaluate() and Gradient() methods.
  */
-inline void SoftmaxRegressionFunction::GetGroundTruthMatrix(
+template<typename MatType>
+void SoftmaxRegressionFunction<MatType>::GetGroundTruthMatrix(
     const arma::Row<size_t>& labels, arma::sp_mat& groundTruth)
 {
   // Calculate the ground truth matrix according to the labels passed. The
@@ -149,7 +130,8 @@ inline void SoftmaxRegressionFunction::GetGroundTruthMatrix(
  * Evaluate the probabilities matrix. If fitIntercept flag is true,
  * it should consider the parameters.cols(0) intercept term.
  */
-inline void SoftmaxRegressionFunction::GetProbabilitiesMatrix(
+template<typename MatType>
+void SoftmaxRegressionFunction<MatType>::GetProbabilitiesMatrix(
     const arma::mat& parameters,
     arma::mat& probabilities,
     const size_t start,
@@ -161,29 +143,33 @@ inline void SoftmaxRegressionFunction::GetProbabilitiesMatrix(
   {
     // In order to add the intercept term, we should compute following matrix:
     //     [1; data] = arma::join_cols(ones(1, data.n_cols), data)
-    //     hypothesis = arma::exp(parameters * [1; data]).
+    //     hypothesis = parameters * [1; data].
     //
     // Since the cost of join may be high due to the copy of original data,
     // split the hypothesis computation to two components.
-    hypothesis = arma::exp(
-        arma::repmat(parameters.col(0), 1, batchSize) +
-        parameters.cols(1, parameters.n_cols - 1) *
-        data.cols(start, start + batchSize - 1));
+    hypothesis = parameters.cols(1, parameters.n_cols - 1) *
+        data.cols(start, start + batchSize - 1);
+    hypothesis.each_col() += parameters.col(0);
   }
   else
   {
-    hypothesis = arma::exp(parameters *
-        data.cols(start, start + batchSize - 1));
+    hypothesis = parameters * data.cols(start, start + batchSize - 1);
   }
 
-  probabilities = hypothesis / arma::repmat(arma::sum(hypothesis, 0),
-                                            numClasses, 1);
+  // Shift each column by its maximum before exponentiating (the log-sum-exp
+  // trick), so large linear terms cannot overflow; the shift cancels in the
+  // normalization.  Normalizing with each_row() avoids materializing the
+  // repmat() of the column sums.
+  hypothesis.each_row() -= arma::max(hypothesis, 0);
+  hypothesis = arma::exp(hypothesis);
+  probabilities = hypothesis.each_row() / arma::sum(hypothesis, 0);
 }
 
 /**
  * Evaluates the objective function given the parameters.
  */
-inline double SoftmaxRegressionFunction::Evaluate(
+template<typename MatType>
+double SoftmaxRegressionFunction<MatType>::Evaluate(
     const arma::mat& parameters) const
 {
   // The objective function is the negative log likelihood of the model
@@ -222,7 +208,8 @@ inline double SoftmaxRegressionFunction::Evaluate(
 /**
  * Evaluate the objective function for the given points given the parameters.
  */
-inline double SoftmaxRegressionFunction::Evaluate(
+template<typename MatType>
+double SoftmaxRegressionFunction<MatType>::Evaluate(
     const arma::mat& parameters,
     const size_t start,
     const size_t batchSize) const
@@ -235,7 +222,7 @@ inline double SoftmaxRegressionFunction::Evaluate(
 
   logLikelihood = arma::accu(groundTruth.cols(start, start + batchSize - 1) %
       arma::log(probabilities)) / batchSize;
-  weightDecay = 0.5 * lambda * arma::accu(parameters * parameters);
+  weightDecay = 0.5 * lambda * arma::accu(parameters % parameters);
 
   return -logLikelihood + weightDecay;
 }
@@ -243,7 +230,8 @@ inline double SoftmaxRegressionFunction::Evaluate(
 /**
  * Calculates and stores the gradient values given a set of parameters.
  */
-inline void SoftmaxRegressionFunction::Gradient(
+template<typename MatType>
+void SoftmaxRegressionFunction<MatType>::Gradient(
     const arma::mat& parameters, arma::mat& gradient) const
 {
   // Calculate the class probabilities for each training example. The
@@ -263,7 +251,7 @@ inline void SoftmaxRegressionFunction::Gradient(
     // the cost of building matrix [1; data].
     arma::mat inner = probabilities - groundTruth;
     gradient.col(0) =
-      inner * arma::ones<arma::mat>(data.n_cols, 1) / data.n_cols +
+      arma::sum(inner, 1) / data.n_cols +
       lambda * parameters.col(0);
     gradient.cols(1, parameters.n_cols - 1) =
       inner * data.t() / data.n_cols +
@@ -276,7 +264,8 @@ inline void SoftmaxRegressionFunction::Gradient(
   }
 }
 
-inline void SoftmaxRegressionFunction::Gradient(
+template<typename MatType>
+void SoftmaxRegressionFunction<MatType>::Gradient(
     const arma::mat& parameters,
     const size_t start,
     arma::mat& gradient,
@@ -292,7 +281,7 @@ inline void SoftmaxRegressionFunction::Gradient(
     arma::mat inner = probabilities - groundTruth.cols(start, start +
         batchSize - 1);
     gradient.col(0) =
-        inner * arma::ones<arma::mat>(batchSize, 1) / batchSize +
+        arma::sum(inner, 1) / batchSize +
         lambda * parameters.col(0);
     gradient.cols(1, parameters.n_cols - 1) =
         inner * data.cols(start, start + batchSize - 1).t() / batchSize +
@@ -306,7 +295,8 @@ inline void SoftmaxRegressionFunction::Gradient(
   }
 }
 
-inline void SoftmaxRegressionFunction::PartialGradient(
+template<typename MatType>
+void SoftmaxRegressionFunction<MatType>::PartialGradient(
     const arma::mat& parameters,
     const size_t j,
     arma::sp_mat& gradient) const
@@ -323,12 +313,14 @@ inline void SoftmaxRegressionFunction::PartialGradient(
     if (j == 0)
     {
       gradient.col(j) =
-          inner * arma::ones<arma::mat>(data.n_cols, 1) / data.n_cols +
+          arma::sum(inner, 1) / data.n_cols +
           lambda * parameters.col(0);
     }
     else
     {
-      gradient.col(j) = inner * data.row(j).t() / data.n_cols + lambda *
+      // Parameter column j corresponds to data row (j - 1), since column 0
+      // holds the intercept.
+      gradient.col(j) = inner * data.row(j - 1).t() / data.n_cols + lambda *
           parameters.col(j);
     }
   }
@@ -339,6 +331,48 @@ inline void SoftmaxRegressionFunction::PartialGradient(
   }
 }
 
+//! Re-sort the columns of a dense data matrix.
+template<typename MatType>
+template<typename eT>
+void SoftmaxRegressionFunction<MatType>::ReorderData(
+    arma::Mat<eT>& data,
+    const arma::uvec& ordering)
+{
+  arma::Mat<eT> newData = data.cols(ordering);
+  if (data.mem_state >= 1)
+    data.reset();
+  data = std::move(newData);
+}
+
+//! Re-sort the columns of a sparse data matrix with the batch constructor.
+template<typename MatType>
+template<typename eT>
+void SoftmaxRegressionFunction<MatType>::ReorderData(
+    arma::SpMat<eT>& data,
+    const arma::uvec& ordering)
+{
+  // Invert the ordering, so every nonzero can be placed directly.
+  arma::uvec reverseOrdering(ordering.n_elem);
+  for (size_t i = 0; i < ordering.n_elem; ++i)
+    reverseOrdering[ordering[i]] = i;
+
+  arma::umat newLocations(2, data.n_nonzero);
+  arma::Col<eT> values(data.n_nonzero);
+  typename arma::SpMat<eT>::const_iterator it = data.begin();
+  size_t loc = 0;
+  while (it != data.end())
+  {
+    newLocations(0, loc) = it.row();
+    newLocations(1, loc) = reverseOrdering(it.col());
+    values(loc) = (*it);
+
+    ++it;
+    ++loc;
+  }
+
+  data = arma::SpMat<eT>(newLocations, values, data.n_rows, data.n_cols);
+}
+
 } // namespace test
 } // namespace ens
 
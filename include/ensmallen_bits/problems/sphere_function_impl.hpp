@@ -62,6 +62,13 @@ typename MatType::elem_type SphereFunction::Evaluate(
   return Evaluate(coordinates, 0, NumFunctions());
 }
 
+template<typename MatType, typename ColType>
+void SphereFunction::Evaluate(const MatType& population,
+                              ColType& fitness) const
+{
+  fitness = arma::sum(population % population, 0).t();
+}
+
 template<typename MatType, typename GradType>
 void SphereFunction::Gradient(const MatType& coordinates,
                               const size_t begin,
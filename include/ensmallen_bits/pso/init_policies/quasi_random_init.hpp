@@ -0,0 +1,137 @@
+/**
+ * @file quasi_random_init.hpp
+ * @author Marcus Edel
+ *
+ * A quasi-random (scrambled Halton) initialization policy for the PSO
+ * optimizer.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_PSO_INIT_POLICIES_QUASI_RANDOM_INIT_HPP
+#define ENSMALLEN_PSO_INIT_POLICIES_QUASI_RANDOM_INIT_HPP
+#include <assert.h>
+
+#include <ensmallen_bits/utility/halton_sequence.hpp>
+
+namespace ens {
+
+/**
+ * A quasi-random initialization policy for the PSO optimizer.  Particle
+ * positions are drawn from a scrambled Halton low-discrepancy sequence and
+ * mapped to [lowerBound, upperBound], so the swarm covers the search space
+ * evenly instead of clustering the way uniform pseudo-random draws do in
+ * higher dimensions.  Velocities, personal bests and fitness values are set
+ * up exactly as in DefaultInit.
+ */
+class QuasiRandomInit
+{
+ public:
+  /**
+   * Construct the QuasiRandomInit policy with randomly seeded scrambling.
+   */
+  QuasiRandomInit()
+  { /* Nothing to do. */ }
+
+  /**
+   * Construct the QuasiRandomInit policy with a fixed scrambling seed for
+   * reproducible swarms.
+   *
+   * @param seed Seed for the scrambling of the underlying sequence.
+   */
+  QuasiRandomInit(const uint64_t seed) : sequence(seed)
+  { /* Nothing to do. */ }
+
+  /**
+   * The Initialize method of the init policy; see DefaultInit for the
+   * required interface.
+   *
+   * @param iterate Coordinates of the initial point for training.
+   * @param numParticles The number of particles in the swarm.
+   * @param lowerBound Lower bound of the position initialization range.
+   * @param upperBound Upper bound of the position initialization range.
+   * @param particlePositions Current positions of particles.
+   * @param particleVelocities Current velocities of particles.
+   * @param particleFitnesses Current fitness values of particles.
+   * @param particleBestPositions Best positions attained by each particle.
+   * @param particleBestFitnesses Best fitness values attained by each particle.
+   */
+  template<typename MatType,
+           typename BoundMatType,
+           typename VecType,
+           typename CubeType>
+  void Initialize(const MatType& iterate,
+                  const size_t numParticles,
+                  BoundMatType& lowerBound,
+                  BoundMatType& upperBound,
+                  CubeType& particlePositions,
+                  CubeType& particleVelocities,
+                  VecType& particleFitnesses,
+                  CubeType& particleBestPositions,
+                  VecType& particleBestFitnesses)
+  {
+    // Convenience typedef.
+    typedef typename MatType::elem_type ElemType;
+    typedef typename CubeType::elem_type CubeElemType;
+
+    // Draw the whole swarm from the low-discrepancy sequence in one pass;
+    // each slice is one point of the sequence.
+    particlePositions.set_size(iterate.n_rows, iterate.n_cols, numParticles);
+    sequence.Uniform(particlePositions);
+
+    // Check if lowerBound is equal to upperBound. If equal, reinitialize.
+    arma::umat lbEquality = (lowerBound == upperBound);
+    if (lbEquality.n_rows == 1 && lbEquality(0, 0) == 1)
+    {
+      lowerBound.set_size(iterate.n_rows, iterate.n_cols);
+      lowerBound.fill(-1.0);
+
+      upperBound.set_size(iterate.n_rows, iterate.n_cols);
+      upperBound.fill(1.0);
+    }
+    // Check if lowerBound and upperBound are vectors of a single dimension.
+    else if (lbEquality.n_rows == 1 && lbEquality(0, 0) == 0)
+    {
+      lowerBound = -lowerBound(0) * arma::ones(iterate.n_rows, iterate.n_cols);
+      upperBound = upperBound(0) * arma::ones(iterate.n_rows, iterate.n_cols);
+    }
+
+    // Check the dimensions of lowerBound and upperBound.
+    assert(lowerBound.n_rows == iterate.n_rows && "The dimensions of "
+        "lowerBound are not the same as the dimensions of iterate.");
+    assert(upperBound.n_rows == iterate.n_rows && "The dimensions of "
+        "upperBound are not the same as the dimensions of iterate.");
+
+    // Distribute particles in [lowerBound, upperBound].
+    for (size_t i = 0; i < numParticles; i++)
+    {
+      particlePositions.slice(i) = particlePositions.slice(i) %
+          arma::conv_to<arma::Mat<CubeElemType> >::from(upperBound - lowerBound)
+          + arma::conv_to<arma::Mat<CubeElemType> >::from(lowerBound);
+    }
+
+    // Initialize particle velocities from the sequence as well.
+    particleVelocities.set_size(iterate.n_rows, iterate.n_cols, numParticles);
+    sequence.Uniform(particleVelocities);
+
+    // Initialize current fitness values to infinity.
+    particleFitnesses.set_size(numParticles);
+    particleFitnesses.fill(std::numeric_limits<ElemType>::max());
+
+    // Copy to personal best values for first iteration.
+    particleBestPositions = particlePositions;
+    // Initialize personal best fitness values to infinity.
+    particleBestFitnesses.set_size(numParticles);
+    particleBestFitnesses.fill(std::numeric_limits<ElemType>::max());
+  }
+
+ private:
+  //! The low-discrepancy sequence the particles are drawn from.
+  HaltonSequence sequence;
+};
+
+} // ens
+
+#endif
@@ -13,8 +13,11 @@
 #ifndef ENSMALLEN_PSO_PSO_HPP
 #define ENSMALLEN_PSO_PSO_HPP
 
+#include <ensmallen_bits/utility/stagnation_detector.hpp>
+
 #include "update_policies/lbest_update.hpp"
 #include "init_policies/default_init.hpp"
+#include "init_policies/quasi_random_init.hpp"
 
 namespace ens {
 
@@ -106,8 +109,12 @@ class PSOType
           impTolerance(impTolerance),
           exploitationFactor(exploitationFactor),
           explorationFactor(explorationFactor),
+          parallelEvaluation(false),
+          adaptiveShrinking(false),
+          minParticles(8),
           velocityUpdatePolicy(velocityUpdatePolicy),
-          initPolicy(initPolicy)
+          initPolicy(initPolicy),
+          warmStart(false)
   { /* Nothing to do. */ }
 
   /**
@@ -116,6 +123,8 @@ class PSOType
   ~PSOType()
   {
     instUpdatePolicy.Clean();
+    askTellState.Clean();
+    warmStartState.Clean();
   }
 
   /**
@@ -152,8 +161,12 @@ class PSOType
           impTolerance(impTolerance),
           exploitationFactor(exploitationFactor),
           explorationFactor(explorationFactor),
+          parallelEvaluation(false),
+          adaptiveShrinking(false),
+          minParticles(8),
           velocityUpdatePolicy(velocityUpdatePolicy),
-          initPolicy(initPolicy)
+          initPolicy(initPolicy),
+          warmStart(false)
   { /* Nothing to do. */ }
 
   /**
@@ -177,6 +190,44 @@ class PSOType
                                        MatType& iterate,
                                        CallbackTypes&&... callbacks);
 
+  /**
+   * Initialize the ask/tell interface from the given starting point.  The
+   * caller drives the loop instead of Optimize(): Ask() returns the current
+   * particle positions, the caller evaluates them however it likes (e.g.
+   * batched on a remote cluster), and Tell() updates the personal bests,
+   * velocities and positions with the observed fitness values.  Termination
+   * is under the caller's control; the improvement horizon is not used.
+   *
+   * @param iterate Starting point; only its shape is used.
+   */
+  template<typename MatType>
+  void Initialize(const MatType& iterate);
+
+  /**
+   * Return the particle positions to evaluate next, one vectorized particle
+   * per column.  Initialize() must have been called first.
+   */
+  template<typename MatType>
+  MatType Ask();
+
+  /**
+   * Update the swarm with the fitness values of the positions returned by
+   * the preceding Ask() call, move the particles, and return the best
+   * fitness observed so far.
+   *
+   * @param objectives Vector of fitness values, in the column order of the
+   *     matrix returned by Ask().
+   */
+  template<typename MatType>
+  typename MatType::elem_type Tell(const MatType& objectives);
+
+  /**
+   * Return the best position observed by the ask/tell interface so far, in
+   * the shape of the starting point.
+   */
+  template<typename MatType>
+  MatType Best();
+
   //! Retrieve value of numParticles.
   size_t NumParticles() const { return numParticles; }
   //! Modify value of numParticles.
@@ -207,6 +258,17 @@ class PSOType
   //! Modify value of impTolerance.
   double& ImpTolerance() { return impTolerance; }
 
+  //! Get the stagnation detector used for early termination.
+  const StagnationDetector& Stagnation() const { return stagnation; }
+  //! Modify the stagnation detector used for early termination.  Disabled
+  //! by default; set its Patience() or MinDiversity() to terminate once the
+  //! best fitness stops improving or the swarm collapses.  This complements
+  //! the improvement horizon: the horizon only triggers after HorizonSize()
+  //! iterations, while the detector can fire much earlier.  The diversity
+  //! statistic here is the positional variance of the active swarm around
+  //! its centroid (the same statistic adaptive shrinking tracks).
+  StagnationDetector& Stagnation() { return stagnation; }
+
   //! Retrieve value of exploitationFactor.
   double ExploitationFactor() const { return exploitationFactor; }
   //! Modify value of exploitationFactor.
@@ -217,6 +279,67 @@ class PSOType
   //! Modify value of explorationFactor.
   double& ExplorationFactor() { return explorationFactor; }
 
+  //! Get whether the swarm fitness evaluations run in parallel with OpenMP
+  //! (requires Evaluate() to be thread-safe).
+  bool ParallelEvaluation() const { return parallelEvaluation; }
+  //! Modify whether the swarm fitness evaluations run in parallel.
+  bool& ParallelEvaluation() { return parallelEvaluation; }
+
+  //! Get whether the swarm shrinks adaptively as it converges.
+  bool AdaptiveShrinking() const { return adaptiveShrinking; }
+  //! Modify whether the swarm shrinks adaptively as it converges.  When
+  //! enabled, the positional variance of the swarm is tracked after the
+  //! initial horizon; each time it halves relative to the last shrink, the
+  //! quarter of the particles with the worst personal-best fitness is
+  //! retired (down to MinParticles()), so late iterations stop paying for
+  //! redundant objective evaluations.  Surviving particles are compacted
+  //! into the contiguous prefix of the existing swarm cubes -- nothing is
+  //! reallocated -- and the velocity-update topology is rebuilt for the
+  //! smaller swarm, which requires a topology that can be built from a
+  //! swarm size alone (the default ring; not a user-supplied adjacency).
+  bool& AdaptiveShrinking() { return adaptiveShrinking; }
+
+  //! Get the minimum number of active particles when shrinking.
+  size_t MinParticles() const { return minParticles; }
+  //! Modify the minimum number of active particles when shrinking.
+  size_t& MinParticles() { return minParticles; }
+
+  //! Get whether the final swarm is retained across Optimize() calls.
+  bool WarmStart() const { return warmStart; }
+  //! Modify whether warm starting is enabled.  When enabled, the particle
+  //! positions and velocities of the last Optimize() call (or a swarm
+  //! injected with SeedSwarm()) seed the next call, provided the problem
+  //! shape and numParticles still match, instead of the fresh draw of the
+  //! initialization policy.  On nearly identical day-over-day problems this
+  //! resumes from the previous converged swarm; the personal and global
+  //! bests are recomputed from scratch on the new objective.
+  bool& WarmStart() { return warmStart; }
+
+  /**
+   * Inject a swarm to seed the next Optimize() call with, e.g. one exported
+   * from a prior run with SwarmPositions() and SwarmVelocities().  One slice
+   * per particle, in the shape of the iterate.  Implies WarmStart() = true.
+   *
+   * @param positions The particle positions to seed with.
+   * @param velocities The particle velocities to seed with.
+   */
+  template<typename ElemType>
+  void SeedSwarm(const arma::Cube<ElemType>& positions,
+                 const arma::Cube<ElemType>& velocities);
+
+  /**
+   * Return the particle positions retained by the last warm-started
+   * Optimize() call (or injected with SeedSwarm()), one slice per particle.
+   * ElemType must match the element type optimized with; throws if no swarm
+   * is held.
+   */
+  template<typename ElemType>
+  const arma::Cube<ElemType>& SwarmPositions() const;
+
+  //! Return the retained particle velocities (see SwarmPositions()).
+  template<typename ElemType>
+  const arma::Cube<ElemType>& SwarmVelocities() const;
+
   //! Get the update policy.
   const VelocityUpdatePolicy& UpdatePolicy() const
   {
@@ -233,6 +356,38 @@ class PSOType
   Any& InstUpdatePolicy() { return instUpdatePolicy; }
 
  private:
+  /**
+   * The swarm state retained across warm-started Optimize() calls (see
+   * WarmStart()); only the positions and velocities are carried over, since
+   * the bests must be recomputed on the new objective.
+   */
+  template<typename ElemType>
+  struct RetainedSwarm
+  {
+    //! Particle positions and velocities, one slice per particle.
+    arma::Cube<ElemType> positions, velocities;
+  };
+
+  /**
+   * Persistent state of the ask/tell interface.  The swarm is kept in the
+   * same cube layout Optimize() uses; positions are only flattened into
+   * columns when handed to the caller.
+   */
+  template<typename BaseMatType>
+  struct AskTellState
+  {
+    typedef typename BaseMatType::elem_type ElemType;
+
+    //! Shape of the starting point, for reshaping results.
+    size_t rows, cols;
+    //! Swarm state, one slice/entry per particle.
+    arma::Cube<ElemType> positions, velocities, bestPositions;
+    arma::Col<ElemType> fitnesses, bestFitnesses;
+    //! Best particle observed so far.
+    size_t bestParticle;
+    ElemType bestFitness;
+  };
+
   //! Number of particles in the swarm.
   size_t numParticles;
 
@@ -251,19 +406,41 @@ class PSOType
   //! The tolerance for improvement over the horizon.
   double impTolerance;
 
+  //! The stagnation detector used for early termination.
+  StagnationDetector stagnation;
+
   //! Exploitation factor for lbest version.
   double exploitationFactor;
 
   //! Exploration factor for lbest version.
   double explorationFactor;
 
+  //! Whether the swarm fitness evaluations run in parallel.
+  bool parallelEvaluation;
+
+  //! Whether the swarm shrinks adaptively as it converges.
+  bool adaptiveShrinking;
+
+  //! The minimum number of active particles when shrinking.
+  size_t minParticles;
+
   //! Velocity update policy used.
   VelocityUpdatePolicy velocityUpdatePolicy;
   //! Particle initialization policy used.
   InitPolicy initPolicy;
 
+  //! Whether the final swarm is retained across Optimize() calls.
+  bool warmStart;
+
+  //! The retained or injected swarm; empty until a warm-started Optimize()
+  //! call finishes or SeedSwarm() is called.
+  Any warmStartState;
+
   //! The initialized update policy.
   Any instUpdatePolicy;
+
+  //! The instantiated ask/tell state; empty until Initialize() is called.
+  Any askTellState;
 };
 
 using LBestPSO = PSOType<LBestUpdate>;
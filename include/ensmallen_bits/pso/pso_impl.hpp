@@ -16,6 +16,7 @@
 #include "pso.hpp"
 #include <ensmallen_bits/function.hpp>
 #include <queue>
+#include <vector>
 
 namespace ens {
 
@@ -96,20 +97,110 @@ typename MatType::elem_type PSOType<VelocityUpdatePolicy, InitPolicy>::Optimize(
       particleBestPositions,
       particleBestFitnesses);
 
+  // Resume from the retained or injected swarm when warm starting and the
+  // shape still matches (see WarmStart()); the personal bests are recomputed
+  // from scratch on the new objective by the first swarm evaluation.
+  if (warmStart && warmStartState.Has<RetainedSwarm<ElemType>>())
+  {
+    const RetainedSwarm<ElemType>& retained =
+        warmStartState.As<RetainedSwarm<ElemType>>();
+    if (retained.positions.n_rows == iterate.n_rows &&
+        retained.positions.n_cols == iterate.n_cols &&
+        retained.positions.n_slices == numParticles &&
+        arma::size(retained.velocities) == arma::size(retained.positions))
+    {
+      particlePositions = retained.positions;
+      particleVelocities = retained.velocities;
+      particleBestPositions = retained.positions;
+    }
+  }
+
   // Initialize the update policy.
   instUpdatePolicy.As<InstUpdatePolicyType>().Initialize(exploitationFactor,
       explorationFactor, numParticles, iterate);
 
+  // The number of particles currently active; adaptive shrinking retires
+  // particles by compacting the survivors into the prefix of the swarm
+  // cubes, so the active swarm always occupies slices [0, activeParticles).
+  size_t activeParticles = numParticles;
+
   Callback::BeginOptimization(*this, function, iterate, callbacks...);
 
+  // Evaluate the fitness of the whole swarm and update the personal bests.
+  // Each particle's fitness and personal best are independent of the others,
+  // so with parallel evaluation enabled the particles are processed
+  // concurrently (Evaluate() must be thread-safe); the global best is found
+  // by the serial scan after the velocity update, outside the parallel
+  // region, and the Evaluate callbacks are invoked serially afterwards.
+  auto evaluateSwarm = [&]()
+  {
+    if (parallelEvaluation)
+    {
+      ENS_PRAGMA_OMP_PARALLEL_FOR
+      for (ptrdiff_t j = 0; j < (ptrdiff_t) activeParticles; j++)
+      {
+        particleFitnesses(j) = function.Evaluate(particlePositions.slice(j));
+
+        // Compare and copy fitness and position to particle best.
+        if (particleFitnesses(j) < particleBestFitnesses(j))
+        {
+          particleBestFitnesses(j) = particleFitnesses(j);
+          particleBestPositions.slice(j) = particlePositions.slice(j);
+        }
+      }
+
+      for (size_t j = 0; (j < activeParticles) && !terminate; j++)
+      {
+        terminate |= Callback::Evaluate(*this, function,
+            particlePositions.slice(j), particleFitnesses(j), callbacks...);
+      }
+    }
+    else
+    {
+      for (size_t j = 0; (j < activeParticles) && !terminate; j++)
+      {
+        particleFitnesses(j) = function.Evaluate(particlePositions.slice(j));
+        terminate |= Callback::Evaluate(*this, function,
+            particlePositions.slice(j), particleFitnesses(j), callbacks...);
+        if (terminate)
+          break;
+
+        // Compare and copy fitness and position to particle best.
+        if (particleFitnesses(j) < particleBestFitnesses(j))
+        {
+          particleBestFitnesses(j) = particleFitnesses(j);
+          particleBestPositions.slice(j) = particlePositions.slice(j);
+        }
+      }
+    }
+  };
+
   // Calculate initial fitness of population.
-  for (size_t i = 0; (i < numParticles) && !terminate; i++)
+  if (parallelEvaluation)
   {
-    // Calculate fitness value.
-    particleFitnesses(i) = function.Evaluate(particlePositions.slice(i));
-    terminate |= Callback::Evaluate(*this, function,
-        particlePositions.slice(i), particleFitnesses(i), callbacks...);
-    particleBestFitnesses(i) = particleFitnesses(i);
+    ENS_PRAGMA_OMP_PARALLEL_FOR
+    for (ptrdiff_t i = 0; i < (ptrdiff_t) numParticles; i++)
+    {
+      particleFitnesses(i) = function.Evaluate(particlePositions.slice(i));
+      particleBestFitnesses(i) = particleFitnesses(i);
+    }
+
+    for (size_t i = 0; (i < numParticles) && !terminate; i++)
+    {
+      terminate |= Callback::Evaluate(*this, function,
+          particlePositions.slice(i), particleFitnesses(i), callbacks...);
+    }
+  }
+  else
+  {
+    for (size_t i = 0; (i < numParticles) && !terminate; i++)
+    {
+      // Calculate fitness value.
+      particleFitnesses(i) = function.Evaluate(particlePositions.slice(i));
+      terminate |= Callback::Evaluate(*this, function,
+          particlePositions.slice(i), particleFitnesses(i), callbacks...);
+      particleBestFitnesses(i) = particleFitnesses(i);
+    }
   }
 
   // Declare queue to keep track of improvements over a number of iterations.
@@ -119,6 +210,83 @@ typename MatType::elem_type PSOType<VelocityUpdatePolicy, InitPolicy>::Optimize(
   // Find the best fitness.
   ElemType bestFitness = std::numeric_limits<ElemType>::max();
 
+  // Positional variance of the active swarm around its centroid, computed
+  // as E[||x||^2] - ||E[x]||^2 in one pass over the contiguous slice memory.
+  auto swarmDiversity = [&]() -> ElemType
+  {
+    BaseMatType centroid(iterate.n_rows, iterate.n_cols);
+    centroid.zeros();
+    ElemType sumSquares = 0;
+    for (size_t j = 0; j < activeParticles; j++)
+    {
+      centroid += particlePositions.slice(j);
+      sumSquares += arma::accu(arma::square(particlePositions.slice(j)));
+    }
+    centroid /= (ElemType) activeParticles;
+
+    return sumSquares / (ElemType) activeParticles -
+        arma::accu(arma::square(centroid));
+  };
+
+  // Retire the worst quarter of the active particles (by personal-best
+  // fitness): the survivors are copied into the contiguous prefix of the
+  // swarm cubes -- retired slots simply fall out of use, so nothing is
+  // reallocated -- and the update policy's topology is rebuilt for the
+  // smaller swarm.
+  auto shrinkSwarm = [&]()
+  {
+    const size_t newActive = std::max(minParticles,
+        activeParticles - activeParticles / 4);
+    if (newActive >= activeParticles)
+      return;
+
+    const arma::uvec order = arma::sort_index(
+        particleBestFitnesses.head(activeParticles));
+
+    // Mark the prefix slots already holding a survivor, then move every
+    // survivor that sits beyond the prefix into a free prefix slot.
+    std::vector<bool> slotKept(newActive, false);
+    for (size_t k = 0; k < newActive; ++k)
+    {
+      if (order(k) < newActive)
+        slotKept[order(k)] = true;
+    }
+
+    size_t freeSlot = 0;
+    for (size_t k = 0; k < newActive; ++k)
+    {
+      const size_t particle = order(k);
+      if (particle < newActive)
+        continue;
+
+      while (slotKept[freeSlot])
+        ++freeSlot;
+
+      particlePositions.slice(freeSlot) = particlePositions.slice(particle);
+      particleVelocities.slice(freeSlot) = particleVelocities.slice(particle);
+      particleBestPositions.slice(freeSlot) =
+          particleBestPositions.slice(particle);
+      particleFitnesses(freeSlot) = particleFitnesses(particle);
+      particleBestFitnesses(freeSlot) = particleBestFitnesses(particle);
+      slotKept[freeSlot] = true;
+    }
+
+    activeParticles = newActive;
+    instUpdatePolicy.As<InstUpdatePolicyType>().Initialize(exploitationFactor,
+        explorationFactor, activeParticles, iterate);
+
+    // The global best survives every shrink (the best personal bests are
+    // kept); find its new slot.
+    bestParticle = 0;
+    for (size_t j = 1; j < activeParticles; j++)
+    {
+      if (particleBestFitnesses(j) < particleBestFitnesses(bestParticle))
+        bestParticle = j;
+    }
+  };
+
+  stagnation.Reset();
+
   // Run PSO for horizonSize number of iterations.
   // This will allow the performanceHorizon to be updated.
   // With some initial values in this, we may proceed with the remaining steps
@@ -128,21 +296,7 @@ typename MatType::elem_type PSOType<VelocityUpdatePolicy, InitPolicy>::Optimize(
   for (size_t i = 0; (i < horizonSize) && !terminate; i++)
   {
     // Calculate fitness and evaluate personal best.
-    for (size_t j = 0; (j < numParticles) && !terminate; j++)
-    {
-      particleFitnesses(j) = function.Evaluate(particlePositions.slice(j));
-      terminate |= Callback::Evaluate(*this, function,
-          particlePositions.slice(j), particleFitnesses(j), callbacks...);
-      if (terminate)
-        break;
-
-      // Compare and copy fitness and position to particle best.
-      if (particleFitnesses(j) < particleBestFitnesses(j))
-      {
-        particleBestFitnesses(j) = particleFitnesses(j);
-        particleBestPositions.slice(j) = particlePositions.slice(j);
-      }
-    }
+    evaluateSwarm();
 
     // Evaluate local best and update velocity.
     instUpdatePolicy.As<InstUpdatePolicyType>().Update(
@@ -153,7 +307,7 @@ typename MatType::elem_type PSOType<VelocityUpdatePolicy, InitPolicy>::Optimize(
     particlePositions += particleVelocities;
 
     // Find the best particle.
-    for (size_t j = 0; j < numParticles; j++)
+    for (size_t j = 0; j < activeParticles; j++)
     {
       if (particleBestFitnesses(j) < bestFitness)
       {
@@ -167,8 +321,30 @@ typename MatType::elem_type PSOType<VelocityUpdatePolicy, InitPolicy>::Optimize(
 
     // Append bestFitness to performanceHorizon.
     performanceHorizon.push(bestFitness);
+
+    // Optional stagnation-based early termination (see Stagnation()); unlike
+    // the improvement horizon it can already fire during these warm-up
+    // iterations.  The diversity statistic is only computed when its
+    // criterion is enabled.
+    if (stagnation.Enabled())
+    {
+      const double diversity = (stagnation.MinDiversity() > 0.0) ?
+          (double) swarmDiversity() : std::numeric_limits<double>::max();
+      if (stagnation.Stagnated((double) bestFitness, diversity))
+      {
+        Info << "PSO: stagnation detected at iteration " << i << "; "
+            << "terminating optimization." << std::endl;
+        terminate = true;
+      }
+    }
   }
 
+  // Diversity at the last shrink; the reference the collapse is measured
+  // against.
+  ElemType referenceDiversity = 0;
+  if (adaptiveShrinking)
+    referenceDiversity = swarmDiversity();
+
   // Run the remaining iterations of PSO.
   for (size_t i = 0; (i < maxIterations - horizonSize) && !terminate; i++)
   {
@@ -177,21 +353,22 @@ typename MatType::elem_type PSOType<VelocityUpdatePolicy, InitPolicy>::Optimize(
     if (performanceHorizon.front() - performanceHorizon.back() < impTolerance)
       break;
 
-    // Calculate fitness and evaluate personal best.
-    for (size_t j = 0; (j < numParticles) && !terminate; j++)
+    // Once the swarm has concentrated to half the positional variance seen
+    // at the last shrink, most particles are redundant; retire the worst of
+    // them so the remaining iterations pay for fewer evaluations.
+    if (adaptiveShrinking && activeParticles > minParticles)
     {
-      particleFitnesses(j) = function.Evaluate(particlePositions.slice(j));
-      terminate |= Callback::Evaluate(*this, function,
-          particlePositions.slice(j), particleFitnesses(j), callbacks...);
-
-      // Compare and copy fitness and position to particle best.
-      if (particleFitnesses(j) < particleBestFitnesses(j))
+      const ElemType diversity = swarmDiversity();
+      if (diversity < (ElemType) 0.5 * referenceDiversity)
       {
-        particleBestFitnesses(j) = particleFitnesses(j);
-        particleBestPositions.slice(j) = particlePositions.slice(j);
+        shrinkSwarm();
+        referenceDiversity = diversity;
       }
     }
 
+    // Calculate fitness and evaluate personal best.
+    evaluateSwarm();
+
     // Evaluate local best and update velocity.
     instUpdatePolicy.As<InstUpdatePolicyType>().Update(
         particlePositions, particleVelocities, particleBestPositions,
@@ -201,7 +378,7 @@ typename MatType::elem_type PSOType<VelocityUpdatePolicy, InitPolicy>::Optimize(
     particlePositions += particleVelocities;
 
     // Find the best particle.
-    for (size_t j = 0; j < numParticles; j++)
+    for (size_t j = 0; j < activeParticles; j++)
     {
       if (particleBestFitnesses(j) < bestFitness)
       {
@@ -217,6 +394,34 @@ typename MatType::elem_type PSOType<VelocityUpdatePolicy, InitPolicy>::Optimize(
     performanceHorizon.pop();
     // Push most recent bestFitness to performanceHorizon.
     performanceHorizon.push(bestFitness);
+
+    // Optional stagnation-based early termination (see Stagnation()); the
+    // diversity statistic is only computed when its criterion is enabled.
+    if (stagnation.Enabled())
+    {
+      const double diversity = (stagnation.MinDiversity() > 0.0) ?
+          (double) swarmDiversity() : std::numeric_limits<double>::max();
+      if (stagnation.Stagnated((double) bestFitness, diversity))
+      {
+        Info << "PSO: stagnation detected at iteration "
+            << (horizonSize + i) << "; terminating optimization."
+            << std::endl;
+        break;
+      }
+    }
+  }
+
+  // Retain the final swarm so the next warm-started call resumes from it
+  // (see WarmStart()).  If the swarm was shrunk, the retired slices still
+  // hold the particles as of their retirement.
+  if (warmStart)
+  {
+    warmStartState.Clean();
+    warmStartState.Set<RetainedSwarm<ElemType>>(new RetainedSwarm<ElemType>());
+    RetainedSwarm<ElemType>& retained =
+        warmStartState.As<RetainedSwarm<ElemType>>();
+    retained.positions = particlePositions;
+    retained.velocities = particleVelocities;
   }
 
   // Copy results back.
@@ -226,6 +431,180 @@ typename MatType::elem_type PSOType<VelocityUpdatePolicy, InitPolicy>::Optimize(
   return bestFitness;
 }
 
+template<typename VelocityUpdatePolicy, typename InitPolicy>
+template<typename ElemType>
+void PSOType<VelocityUpdatePolicy, InitPolicy>::SeedSwarm(
+    const arma::Cube<ElemType>& positions,
+    const arma::Cube<ElemType>& velocities)
+{
+  warmStart = true;
+  warmStartState.Clean();
+  warmStartState.Set<RetainedSwarm<ElemType>>(new RetainedSwarm<ElemType>());
+  RetainedSwarm<ElemType>& retained =
+      warmStartState.As<RetainedSwarm<ElemType>>();
+  retained.positions = positions;
+  retained.velocities = velocities;
+}
+
+template<typename VelocityUpdatePolicy, typename InitPolicy>
+template<typename ElemType>
+const arma::Cube<ElemType>&
+PSOType<VelocityUpdatePolicy, InitPolicy>::SwarmPositions() const
+{
+  return warmStartState.As<RetainedSwarm<ElemType>>().positions;
+}
+
+template<typename VelocityUpdatePolicy, typename InitPolicy>
+template<typename ElemType>
+const arma::Cube<ElemType>&
+PSOType<VelocityUpdatePolicy, InitPolicy>::SwarmVelocities() const
+{
+  return warmStartState.As<RetainedSwarm<ElemType>>().velocities;
+}
+
+//! Initialize the ask/tell interface.
+template<typename VelocityUpdatePolicy, typename InitPolicy>
+template<typename MatType>
+void PSOType<VelocityUpdatePolicy, InitPolicy>::Initialize(
+    const MatType& iterateIn)
+{
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef typename VelocityUpdatePolicy::template Policy<BaseMatType>
+      InstUpdatePolicyType;
+  typedef AskTellState<BaseMatType> StateType;
+
+  RequireDenseFloatingPointType<BaseMatType>();
+
+  // The init and update policies expect a mutable iterate-shaped matrix.
+  BaseMatType iterate = (const BaseMatType&) iterateIn;
+
+  if (!instUpdatePolicy.Has<InstUpdatePolicyType>())
+  {
+    instUpdatePolicy.Clean();
+    instUpdatePolicy.Set<InstUpdatePolicyType>(
+        new InstUpdatePolicyType(velocityUpdatePolicy));
+  }
+
+  askTellState.Clean();
+  askTellState.Set<StateType>(new StateType());
+  StateType& state = askTellState.As<StateType>();
+
+  state.rows = iterate.n_rows;
+  state.cols = iterate.n_cols;
+
+  // Initialize the swarm and the update policy, as in Optimize().
+  initPolicy.Initialize(iterate,
+      numParticles,
+      lowerBound,
+      upperBound,
+      state.positions,
+      state.velocities,
+      state.fitnesses,
+      state.bestPositions,
+      state.bestFitnesses);
+
+  instUpdatePolicy.As<InstUpdatePolicyType>().Initialize(exploitationFactor,
+      explorationFactor, numParticles, iterate);
+
+  // The personal bests are seeded by the first Tell() call.
+  state.bestFitnesses.fill(std::numeric_limits<ElemType>::max());
+  state.bestPositions = state.positions;
+
+  state.bestParticle = 0;
+  state.bestFitness = std::numeric_limits<ElemType>::max();
+}
+
+//! Return the particle positions to evaluate next.
+template<typename VelocityUpdatePolicy, typename InitPolicy>
+template<typename MatType>
+MatType PSOType<VelocityUpdatePolicy, InitPolicy>::Ask()
+{
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef AskTellState<BaseMatType> StateType;
+
+  if (!askTellState.Has<StateType>())
+    throw std::logic_error("PSO::Ask(): call Initialize() first!");
+  StateType& state = askTellState.As<StateType>();
+
+  BaseMatType population(state.positions.n_rows * state.positions.n_cols,
+      numParticles);
+  for (size_t j = 0; j < numParticles; j++)
+    population.col(j) = arma::vectorise(state.positions.slice(j));
+
+  return population;
+}
+
+//! Update the swarm with the observed fitness values.
+template<typename VelocityUpdatePolicy, typename InitPolicy>
+template<typename MatType>
+typename MatType::elem_type PSOType<VelocityUpdatePolicy, InitPolicy>::Tell(
+    const MatType& objectivesIn)
+{
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef typename VelocityUpdatePolicy::template Policy<BaseMatType>
+      InstUpdatePolicyType;
+  typedef AskTellState<BaseMatType> StateType;
+
+  if (!askTellState.Has<StateType>())
+    throw std::logic_error("PSO::Tell(): call Initialize() first!");
+  StateType& state = askTellState.As<StateType>();
+
+  const BaseMatType& objectives = (const BaseMatType&) objectivesIn;
+  if (objectives.n_elem != numParticles)
+  {
+    throw std::logic_error("PSO::Tell(): expected " +
+        std::to_string(numParticles) + " fitness values, got " +
+        std::to_string(objectives.n_elem) + "!");
+  }
+
+  // Update the personal bests.
+  for (size_t j = 0; j < numParticles; j++)
+  {
+    state.fitnesses(j) = objectives(j);
+    if (state.fitnesses(j) < state.bestFitnesses(j))
+    {
+      state.bestFitnesses(j) = state.fitnesses(j);
+      state.bestPositions.slice(j) = state.positions.slice(j);
+    }
+  }
+
+  // Evaluate local best and update velocity.
+  instUpdatePolicy.As<InstUpdatePolicyType>().Update(
+      state.positions, state.velocities, state.bestPositions,
+      state.bestFitnesses);
+
+  // In-place update of particle positions.
+  state.positions += state.velocities;
+
+  // Find the best particle.
+  for (size_t j = 0; j < numParticles; j++)
+  {
+    if (state.bestFitnesses(j) < state.bestFitness)
+    {
+      state.bestParticle = j;
+      state.bestFitness = state.bestFitnesses(state.bestParticle);
+    }
+  }
+
+  return state.bestFitness;
+}
+
+//! Return the best position observed so far.
+template<typename VelocityUpdatePolicy, typename InitPolicy>
+template<typename MatType>
+MatType PSOType<VelocityUpdatePolicy, InitPolicy>::Best()
+{
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef AskTellState<BaseMatType> StateType;
+
+  if (!askTellState.Has<StateType>())
+    throw std::logic_error("PSO::Best(): call Initialize() first!");
+  StateType& state = askTellState.As<StateType>();
+
+  return state.bestPositions.slice(state.bestParticle);
+}
+
 } // ens
 
 #endif
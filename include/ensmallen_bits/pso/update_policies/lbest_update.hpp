@@ -14,14 +14,28 @@
 #define ENSMALLEN_PSO_UPDATE_POLICIES_LBEST_UPDATE_HPP
 #include <assert.h>
 
+#include <algorithm>
+
+#include <ensmallen_bits/utility/philox_generator.hpp>
+
 namespace ens {
 
 /**
  * The local best version (lbest) of PSO in which particles communicate with
- * only two neighbours each, thus forming a ring topology amongst them. This
+ * only a few neighbours each; by default they form a ring topology.  This
  * approach allows PSO to converge at the global minimum, but takes
  * significantly more iterations to do so.
  *
+ * The neighborhood structure is represented once, up front, as a flat
+ * CSR-style adjacency index (an offset array plus a concatenated neighbor
+ * array), and the neighborhood-best reduction each iteration is a single
+ * segmented-min pass over the personal-best fitness array.  The per-iteration
+ * cost is therefore proportional to the number of edges and independent of
+ * the topology's structure, so arbitrary topologies (ring, von Neumann grid,
+ * random k-regular) are all equally cheap, even for large swarms.  Use the
+ * static builders Ring(), VonNeumann() and RandomRegular() to construct
+ * common topologies, or pass any CSR adjacency directly.
+ *
  * The lbest update scheme is described as follows:
  *
  * \f{eqation}{
@@ -57,6 +71,135 @@ namespace ens {
 class LBestUpdate
 {
  public:
+  /**
+   * Construct the lbest update policy with the default topology: a ring in
+   * which each particle communicates with its two direct neighbours.  The
+   * adjacency index is built when the swarm size becomes known.
+   */
+  LBestUpdate()
+  { /* Nothing to do. */ }
+
+  /**
+   * Construct the lbest update policy with an arbitrary topology given as a
+   * flat CSR adjacency index: the neighbors of particle i are the entries
+   * neighborIndices[neighborOffsets[i] .. neighborOffsets[i + 1] - 1].  A
+   * particle is always considered a member of its own neighborhood and does
+   * not need to be listed.
+   *
+   * @param neighborOffsets Segment offsets, one entry per particle plus a
+   *     trailing end marker.
+   * @param neighborIndices Concatenated neighbor indices of all particles.
+   */
+  LBestUpdate(const arma::uvec& neighborOffsets,
+              const arma::uvec& neighborIndices) :
+      neighborOffsets(neighborOffsets),
+      neighborIndices(neighborIndices)
+  { /* Nothing to do. */ }
+
+  /**
+   * Build a ring topology in which each particle communicates with the
+   * `span` particles on either side of it.
+   *
+   * @param numParticles The number of particles in the swarm.
+   * @param span Number of neighbors on each side (1 gives the classic ring).
+   */
+  static LBestUpdate Ring(const size_t numParticles, const size_t span = 1)
+  {
+    arma::uvec offsets(numParticles + 1);
+    arma::uvec neighbors(2 * span * numParticles);
+
+    size_t pos = 0;
+    for (size_t i = 0; i < numParticles; ++i)
+    {
+      offsets(i) = pos;
+      for (size_t s = 1; s <= span; ++s)
+      {
+        neighbors(pos++) = (i + numParticles - s) % numParticles;
+        neighbors(pos++) = (i + s) % numParticles;
+      }
+    }
+    offsets(numParticles) = pos;
+
+    return LBestUpdate(offsets, neighbors);
+  }
+
+  /**
+   * Build a von Neumann topology: the particles are arranged on a wrapping
+   * rows x cols grid and communicate with their four grid neighbors.
+   *
+   * @param rows Number of grid rows.
+   * @param cols Number of grid columns (rows * cols particles in total).
+   */
+  static LBestUpdate VonNeumann(const size_t rows, const size_t cols)
+  {
+    const size_t numParticles = rows * cols;
+    arma::uvec offsets(numParticles + 1);
+    arma::uvec neighbors(4 * numParticles);
+
+    size_t pos = 0;
+    for (size_t r = 0; r < rows; ++r)
+    {
+      for (size_t c = 0; c < cols; ++c)
+      {
+        offsets(r * cols + c) = pos;
+        neighbors(pos++) = ((r + rows - 1) % rows) * cols + c;
+        neighbors(pos++) = ((r + 1) % rows) * cols + c;
+        neighbors(pos++) = r * cols + (c + cols - 1) % cols;
+        neighbors(pos++) = r * cols + (c + 1) % cols;
+      }
+    }
+    offsets(numParticles) = pos;
+
+    return LBestUpdate(offsets, neighbors);
+  }
+
+  /**
+   * Build a random topology in which each particle communicates with
+   * `degree` distinct other particles drawn uniformly at random.
+   *
+   * @param numParticles The number of particles in the swarm.
+   * @param degree Number of neighbors of each particle.
+   * @param seed Seed for the generator drawing the neighbors.
+   */
+  static LBestUpdate RandomRegular(const size_t numParticles,
+                                   const size_t degree,
+                                   const uint64_t seed = 0)
+  {
+    assert(degree < numParticles && "The neighbor degree must be smaller "
+        "than the number of particles.");
+
+    PhiloxGenerator generator(seed);
+    arma::uvec offsets(numParticles + 1);
+    arma::uvec neighbors(degree * numParticles);
+
+    std::vector<size_t> chosen;
+    size_t pos = 0;
+    for (size_t i = 0; i < numParticles; ++i)
+    {
+      offsets(i) = pos;
+      chosen.clear();
+      while (chosen.size() < degree)
+      {
+        const size_t candidate = generator.RandInt(numParticles);
+        if (candidate == i || std::find(chosen.begin(), chosen.end(),
+            candidate) != chosen.end())
+          continue;
+
+        chosen.push_back(candidate);
+        neighbors(pos++) = candidate;
+      }
+    }
+    offsets(numParticles) = pos;
+
+    return LBestUpdate(offsets, neighbors);
+  }
+
+  //! Get the CSR segment offsets of the topology (empty for the default
+  //! ring, which is built once the swarm size is known).
+  const arma::uvec& NeighborOffsets() const { return neighborOffsets; }
+  //! Get the concatenated neighbor indices of the topology.
+  const arma::uvec& NeighborIndices() const { return neighborIndices; }
+
   /**
    * The UpdatePolicyType policy classes must contain an internal 'Policy'
    * template class with two template arguments: MatType.  This is
@@ -73,14 +216,15 @@ class LBestUpdate
      *
      * @param parent Instantiated parent class.
      */
-     Policy(const LBestUpdate& /* parent */) : n(0)
+     Policy(const LBestUpdate& parent) : parent(parent), n(0)
      { /* Do nothing. */ }
 
      /**
       * The Initialize method is called by PSO Optimizer method before the
       * start of the iteration process. It calculates the value of the
       * constriction coefficent, initializes the local best indices of each
-      * particle to itself, and sets the shape of the r1 and r2 vectors.
+      * particle to itself, sets the shape of the r1 and r2 vectors, and
+      * builds (or validates) the flat CSR adjacency index of the topology.
       *
       * @param exploitationFactor Influence of personal best achieved.
       * @param explorationFactor Influence of neighbouring particles.
@@ -104,9 +248,24 @@ class LBestUpdate
 
        chi = 2.0 / std::abs(2.0 - phi - std::sqrt((phi - 4.0) * phi));
 
+       // Take the user-supplied topology, or build the classic ring.
+       if (parent.NeighborOffsets().n_elem == n + 1)
+       {
+         neighborOffsets = parent.NeighborOffsets();
+         neighborIndices = parent.NeighborIndices();
+       }
+       else
+       {
+         assert(parent.NeighborOffsets().n_elem == 0 && "The topology of the "
+             "update policy was built for a different number of particles.");
+
+         const LBestUpdate ring = LBestUpdate::Ring(n);
+         neighborOffsets = ring.NeighborOffsets();
+         neighborIndices = ring.NeighborIndices();
+       }
+
        // Initialize local best indices to self indices of particles.
-       localBestIndices = arma::linspace<
-           arma::Col<typename MatType::elem_type> >(0, n-1, n);
+       localBestIndices = arma::regspace<arma::uvec>(0, n - 1);
 
        // Set sizes r1 and r2.
        r1.set_size(iterate.n_rows, iterate.n_cols);
@@ -114,10 +273,11 @@ class LBestUpdate
      }
 
      /**
-      * Update step for LBestPSO. Compares personal best of each particle with
-      * that of its neighbours, and sets the best of the 3 as the lobal best.
-      * This particle is then used for calculating the velocity for the update
-      * step.
+      * Update step for LBestPSO. Determines the best personal-best fitness in
+      * each particle's neighborhood (including the particle itself) with one
+      * segmented-min pass over the fitness array, guided by the CSR adjacency
+      * index.  The local best is then used for calculating the velocity for
+      * the update step.
       *
       * @param particlePositions The current coordinates of particles.
       * @param particleVelocities The current velocities (will be modified).
@@ -131,15 +291,21 @@ class LBestUpdate
                  arma::Cube<typename MatType::elem_type>& particleBestPositions,
                  arma::Col<typename MatType::elem_type>& particleBestFitnesses)
      {
-       // Velocity update logic.
-       for (size_t i = 0; i < n; i++)
+       // Segmented-min pass: each particle's segment of the neighbor array
+       // is reduced against its own fitness.  The segments are independent,
+       // so the pass is parallelized over particles.
+       ENS_PRAGMA_OMP_PARALLEL_FOR_THREADS(
+           (int) ParallelRuntime::Get().RegionThreads())
+       for (ptrdiff_t i = 0; i < (ptrdiff_t) n; i++)
        {
-         localBestIndices(i) =
-             particleBestFitnesses(left(i)) < particleBestFitnesses(i) ?
-             left(i) : i;
-         localBestIndices(i) =
-             particleBestFitnesses(right(i)) < particleBestFitnesses(i) ?
-             right(i) : i;
+         size_t best = i;
+         for (size_t j = neighborOffsets(i); j < neighborOffsets(i + 1); ++j)
+         {
+           const size_t neighbor = neighborIndices(j);
+           if (particleBestFitnesses(neighbor) < particleBestFitnesses(best))
+             best = neighbor;
+         }
+         localBestIndices(i) = best;
        }
 
        for (size_t i = 0; i < n; i++)
@@ -156,6 +322,9 @@ class LBestUpdate
      }
 
     private:
+     //! The parent policy, carrying any user-supplied topology.
+     const LBestUpdate& parent;
+
      //! Number of particles.
      size_t n;
 
@@ -172,12 +341,22 @@ class LBestUpdate
      MatType r1, r2;
 
      //! Indices of each particle's best neighbour.
-     arma::Col<typename MatType::elem_type> localBestIndices;
+     arma::uvec localBestIndices;
+
+     //! CSR segment offsets of the topology, one entry per particle plus a
+     //! trailing end marker.
+     arma::uvec neighborOffsets;
 
-     // Helper functions for calculating neighbours.
-    inline size_t left(size_t index) { return (index + n - 1) % n; }
-    inline size_t right(size_t index) { return (index + 1) % n; }
+     //! Concatenated neighbor indices of all particles.
+     arma::uvec neighborIndices;
   };
+
+ private:
+  //! CSR segment offsets of a user-supplied topology (empty by default).
+  arma::uvec neighborOffsets;
+
+  //! Concatenated neighbor indices of a user-supplied topology.
+  arma::uvec neighborIndices;
 };
 
 } // ens
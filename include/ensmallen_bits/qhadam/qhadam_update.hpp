@@ -13,6 +13,8 @@
 #ifndef ENSMALLEN_ADAM_QHADAM_UPDATE_HPP
 #define ENSMALLEN_ADAM_QHADAM_UPDATE_HPP
 
+#include <ensmallen_bits/sgd/update_policies/elementwise_update.hpp>
+
 namespace ens {
 
 /**
@@ -91,7 +93,7 @@ class QHAdamUpdate
    * specific to an individual optimization.
    */
   template<typename MatType, typename GradType>
-  class Policy
+  class Policy : public ElementwiseUpdate<Policy<MatType, GradType>>
   {
    public:
     /**
@@ -104,7 +106,9 @@ class QHAdamUpdate
      */
     Policy(QHAdamUpdate& parent, const size_t rows, const size_t cols) :
         parent(parent),
-        iteration(0)
+        iteration(0),
+        biasCorrection1(0),
+        biasCorrection2(0)
     {
       m.zeros(rows, cols);
       v.zeros(rows, cols);
@@ -124,23 +128,30 @@ class QHAdamUpdate
       // Increment the iteration counter variable.
       ++iteration;
 
-      // And update the iterate.
-      m *= parent.beta1;
-      m += (1 - parent.beta1) * gradient;
+      biasCorrection1 = 1.0 - std::pow(parent.beta1, iteration);
+      biasCorrection2 = 1.0 - std::pow(parent.beta2, iteration);
 
-      v *= parent.beta2;
-      v += (1 - parent.beta2) * (gradient % gradient);
+      this->Elementwise(iterate, stepSize, gradient, m, v);
+    }
 
-      const double biasCorrection1 = 1.0 - std::pow(parent.beta1, iteration);
-      const double biasCorrection2 = 1.0 - std::pow(parent.beta2, iteration);
+    //! The per-element QHAdam rule; called by ElementwiseUpdate.
+    template<typename StateElemType>
+    double Apply(const double stepSize,
+                 const double x,
+                 const double g,
+                 StateElemType& m,
+                 StateElemType& v)
+    {
+      m = (StateElemType) (parent.beta1 * m + (1 - parent.beta1) * g);
+      v = (StateElemType) (parent.beta2 * v + (1 - parent.beta2) * g * g);
 
-      GradType mDash = m / biasCorrection1;
-      GradType vDash = v / biasCorrection2;
+      const double mDash = m / biasCorrection1;
+      const double vDash = v / biasCorrection2;
 
       // QHAdam recovers Adam when v2 = v1 = 1.
-      iterate -= stepSize *
-          ((((1 - parent.v1) * gradient) + parent.v1 * mDash) /
-           (arma::sqrt(((1 - parent.v2) * (gradient % gradient)) +
+      return x - stepSize *
+          (((1 - parent.v1) * g + parent.v1 * mDash) /
+           (std::sqrt((1 - parent.v2) * g * g +
             parent.v2 * vDash) + parent.epsilon));
     }
 
@@ -156,6 +167,12 @@ class QHAdamUpdate
 
     // The number of iterations.
     size_t iteration;
+
+    // The current first moment bias correction; set by Update().
+    double biasCorrection1;
+
+    // The current second moment bias correction; set by Update().
+    double biasCorrection2;
   };
 
  private:
@@ -148,6 +148,12 @@ class RMSProp
   //! Modify the smoothing parameter.
   double& Alpha() { return optimizer.UpdatePolicy().Alpha(); }
 
+  //! Get whether the mean squared gradient is stored in single precision.
+  bool MixedPrecision() const
+  { return optimizer.UpdatePolicy().MixedPrecision(); }
+  //! Modify whether the mean squared gradient is stored in single precision.
+  bool& MixedPrecision() { return optimizer.UpdatePolicy().MixedPrecision(); }
+
   //! Get the value used to initialise the mean squared gradient parameter.
   double Epsilon() const { return optimizer.UpdatePolicy().Epsilon(); }
   //! Modify the value used to initialise the mean squared gradient parameter.
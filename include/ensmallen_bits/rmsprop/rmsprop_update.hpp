@@ -47,11 +47,18 @@ class RMSPropUpdate
    * @param epsilon The epsilon value used to initialise the squared gradient
    *        parameter.
    * @param alpha The smoothing parameter.
+   * @param mixedPrecision If true, store the mean squared gradient in single
+   *        precision while accumulating its recursion and the parameter step
+   *        in double; this halves the optimizer state memory for
+   *        double-precision models.  Only available for dense gradients;
+   *        sparse gradients keep full-precision state.
    */
   RMSPropUpdate(const double epsilon = 1e-8,
-                const double alpha = 0.99) :
+                const double alpha = 0.99,
+                const bool mixedPrecision = false) :
     epsilon(epsilon),
-    alpha(alpha)
+    alpha(alpha),
+    mixedPrecision(mixedPrecision)
   {
     // Nothing to do.
   }
@@ -66,6 +73,11 @@ class RMSPropUpdate
   //! Modify the smoothing parameter.
   double& Alpha() { return alpha; }
 
+  //! Get whether the mean squared gradient is stored in single precision.
+  bool MixedPrecision() const { return mixedPrecision; }
+  //! Modify whether the mean squared gradient is stored in single precision.
+  bool& MixedPrecision() { return mixedPrecision; }
+
   /**
    * The UpdatePolicyType policy classes must contain an internal 'Policy'
    * template class with two template arguments: MatType and GradType.  This is
@@ -87,8 +99,13 @@ class RMSPropUpdate
     Policy(RMSPropUpdate& parent, const size_t rows, const size_t cols) :
         parent(parent)
     {
-      // Leaky sum of squares of parameter gradient.
-      meanSquaredGradient.zeros(rows, cols);
+      // Leaky sum of squares of parameter gradient.  In the mixed-precision
+      // mode it lives in the single-precision buffer instead; sparse
+      // gradients keep full-precision state.
+      if (parent.mixedPrecision && !arma::is_arma_sparse_type<GradType>::value)
+        meanSquaredGradientF.zeros(rows, cols);
+      else
+        meanSquaredGradient.zeros(rows, cols);
     }
 
     /**
@@ -102,6 +119,13 @@ class RMSPropUpdate
                 const double stepSize,
                 const GradType& gradient)
     {
+      if (parent.mixedPrecision &&
+          !arma::is_arma_sparse_type<GradType>::value)
+      {
+        MixedUpdate(iterate, stepSize, gradient);
+        return;
+      }
+
       meanSquaredGradient *= parent.alpha;
       meanSquaredGradient += (1 - parent.alpha) * (gradient % gradient);
       iterate -= stepSize * gradient / (arma::sqrt(meanSquaredGradient) +
@@ -109,8 +133,54 @@ class RMSPropUpdate
     }
 
    private:
+    /**
+     * Mixed-precision update kernel for dense gradients: the mean squared
+     * gradient is read from and written back to the single-precision buffer,
+     * while its recursion and the parameter step are accumulated in double.
+     */
+    template<typename InGradType>
+    typename std::enable_if<arma::is_arma_type<InGradType>::value, void>::type
+    MixedUpdate(MatType& iterate,
+                const double stepSize,
+                const InGradType& gradient)
+    {
+      typedef typename MatType::elem_type ElemType;
+
+      const ElemType* g = gradient.memptr();
+      float* msgMem = meanSquaredGradientF.memptr();
+      ElemType* itMem = iterate.memptr();
+
+      const size_t n = iterate.n_elem;
+      for (size_t j = 0; j < n; ++j)
+      {
+        const double gj = (double) g[j];
+        const double msg = parent.alpha * msgMem[j] +
+            (1 - parent.alpha) * gj * gj;
+        msgMem[j] = (float) msg;
+        itMem[j] -= (ElemType) (stepSize * gj /
+            (std::sqrt(msg) + parent.epsilon));
+      }
+    }
+
+    //! Sparse gradients never reach the mixed-precision path at runtime;
+    //! this overload only exists so the dispatch above compiles.
+    template<typename InGradType>
+    typename std::enable_if<!arma::is_arma_type<InGradType>::value, void>::type
+    MixedUpdate(MatType& iterate,
+                const double stepSize,
+                const InGradType& gradient)
+    {
+      meanSquaredGradient *= parent.alpha;
+      meanSquaredGradient += (1 - parent.alpha) * (gradient % gradient);
+      iterate -= stepSize * gradient / (arma::sqrt(meanSquaredGradient) +
+          parent.epsilon);
+    }
+
     // Leaky sum of squares of parameter gradient.
     GradType meanSquaredGradient;
+    // Single-precision storage of the mean squared gradient, used in the
+    // mixed-precision mode.
+    arma::Mat<float> meanSquaredGradientF;
     // Reference to instantiated parent object.
     RMSPropUpdate& parent;
   };
@@ -121,6 +191,9 @@ class RMSPropUpdate
 
   // The smoothing parameter.
   double alpha;
+
+  // Whether the mean squared gradient is stored in single precision.
+  bool mixedPrecision;
 };
 
 } // namespace ens
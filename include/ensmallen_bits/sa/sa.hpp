@@ -12,6 +12,8 @@
 #ifndef ENSMALLEN_SA_SA_HPP
 #define ENSMALLEN_SA_SA_HPP
 
+#include <ensmallen_bits/utility/philox_generator.hpp>
+
 #include "exponential_schedule.hpp"
 
 namespace ens {
@@ -142,6 +144,55 @@ class SA
   //! Modify the maximum number of iterations.
   size_t& MaxIterations() { return maxIterations; }
 
+  //! Get the number of trial moves proposed per step.  With a value greater
+  //! than 1, each step draws that many candidate moves, evaluates them in
+  //! parallel with OpenMP (requires Evaluate() to be thread-safe), and applies
+  //! a multiple-try Metropolis selection to the batch.
+  size_t ProposalBatchSize() const { return proposalBatchSize; }
+  //! Modify the number of trial moves proposed per step.
+  size_t& ProposalBatchSize() { return proposalBatchSize; }
+
+  //! Get the number of tempering replicas.  With a value greater than 1,
+  //! that many annealing chains run concurrently on the thread pool, each at
+  //! its own temperature on a geometric ladder above the base temperature
+  //! (replica k runs at temperature * LadderRatio()^k).  Every
+  //! ExchangeInterval() steps, adjacent replicas attempt a state exchange
+  //! with the usual replica-exchange acceptance rule, so good states found
+  //! by hot, fast-exploring replicas percolate down to the cold chain.  On
+  //! rugged landscapes this reaches a given objective in far fewer total
+  //! sweeps than a single chain.  Evaluate() must be thread-safe; the
+  //! per-move Evaluate callbacks are not raised in this mode.
+  size_t NumReplicas() const { return numReplicas; }
+  //! Modify the number of tempering replicas (1 disables tempering).
+  size_t& NumReplicas() { return numReplicas; }
+
+  //! Get the number of steps between replica-exchange attempts.
+  size_t ExchangeInterval() const { return exchangeInterval; }
+  //! Modify the number of steps between replica-exchange attempts.
+  size_t& ExchangeInterval() { return exchangeInterval; }
+
+  //! Get the temperature ratio between adjacent replicas.
+  double LadderRatio() const { return ladderRatio; }
+  //! Modify the temperature ratio between adjacent replicas.
+  double& LadderRatio() { return ladderRatio; }
+
+  //! Get the screening fidelity.  With a value greater than 0 and a function
+  //! implementing the fidelity-parameterized form
+  //! Evaluate(coordinates, fidelity) (see fidelity_evaluate.hpp), each
+  //! proposed move is first scored at this fidelity, and the exact
+  //! evaluation is only spent on proposals whose cheap score does not
+  //! already cross the Metropolis rejection threshold.  This is a heuristic
+  //! filter: a proposal whose cheap score misjudges the true energy may be
+  //! rejected although the exact evaluation would have been accepted.
+  size_t ScreeningFidelity() const { return screeningFidelity; }
+  //! Modify the screening fidelity (0 disables screening).
+  size_t& ScreeningFidelity() { return screeningFidelity; }
+
+  //! Get the random number generator.
+  const PhiloxGenerator& Generator() const { return generator; }
+  //! Modify the random number generator (e.g. to seed it for reproducibility).
+  PhiloxGenerator& Generator() { return generator; }
+
  private:
   //! The cooling schedule being used.
   CoolingScheduleType coolingSchedule;
@@ -163,6 +214,64 @@ class SA
   double initMoveCoef;
   //! Proportional control in feedback move control.
   double gain;
+  //! The number of trial moves proposed per step.
+  size_t proposalBatchSize;
+  //! The number of tempering replicas (1 disables tempering).
+  size_t numReplicas;
+  //! The number of steps between replica-exchange attempts.
+  size_t exchangeInterval;
+  //! The temperature ratio between adjacent replicas.
+  double ladderRatio;
+  //! The fidelity used to screen proposed moves (0 disables screening).
+  size_t screeningFidelity;
+  //! The random number generator used to draw moves and acceptance tests.
+  PhiloxGenerator generator;
+
+  /**
+   * Replica-exchange (parallel tempering) optimization loop, used when
+   * numReplicas > 1.  Each replica runs the single-proposal annealing move
+   * at its own rung of the temperature ladder, with its own feedback move
+   * control and its own random stream; adjacent rungs attempt state
+   * exchanges every exchangeInterval steps.  The coldest replica's state is
+   * the result.
+   *
+   * @param function Function to optimize.
+   * @param iterate Starting point (will be modified).
+   * @param callbacks Callback functions.
+   * @return Objective value of the final point.
+   */
+  template<typename FunctionType, typename MatType, typename... CallbackTypes>
+  typename MatType::elem_type OptimizeTempering(FunctionType& function,
+                                                MatType& iterate,
+                                                CallbackTypes&... callbacks);
+
+  /**
+   * Perform one single-proposal annealing move of one tempering replica:
+   * propose a Laplace move on iterate(idx) at the given temperature, accept
+   * or reject it by the Metropolis criterion using the replica's own random
+   * stream, and advance the replica's sweep and move-control state.  Raises
+   * no callbacks, so it is safe to call from inside a parallel region.
+   *
+   * @param function Function to optimize.
+   * @param iterate The replica's current position.
+   * @param accept Matrix of accepted-move counts for the replica.
+   * @param moveSize Strides for a move.
+   * @param energy Current energy of the replica.
+   * @param idx Current parameter to modify.
+   * @param sweepCounter The replica's sweep counter.
+   * @param replicaTemperature The replica's current temperature.
+   * @param rng The replica's random stream.
+   */
+  template<typename FunctionType, typename MatType>
+  void ReplicaMove(FunctionType& function,
+                   MatType& iterate,
+                   MatType& accept,
+                   MatType& moveSize,
+                   typename MatType::elem_type& energy,
+                   size_t& idx,
+                   size_t& sweepCounter,
+                   const double replicaTemperature,
+                   PhiloxGenerator& rng);
 
   /**
    * GenerateMove proposes a move on element iterate(idx), and determines if
@@ -172,6 +281,12 @@ class SA
    * resets idx and increments sweepCounter. When sweepCounter reaches
    * moveCtrlSweep, it performs MoveControl() and resets sweepCounter.
    *
+   * When proposalBatchSize is greater than 1, a batch of trial moves on
+   * iterate(idx) is drawn instead, the trial points are evaluated in parallel,
+   * and one trial is selected by Boltzmann-weighted sampling before the
+   * Metropolis acceptance.  The trial buffers are allocated once by Optimize()
+   * and reused across calls.
+   *
    * @param iterate Current optimization position.
    * @param accept Matrix representing which parameters have had accepted moves.
    * @param moveSize Strides for a move.
@@ -179,6 +294,9 @@ class SA
    * @param idx Current parameter to modify.
    * @param sweepCounter Current counter representing how many sweeps have been
    *      completed.
+   * @param trialPoints Preallocated trial points for the proposal batch.
+   * @param trialMoves Preallocated trial move sizes for the proposal batch.
+   * @param trialEnergies Preallocated trial energies for the proposal batch.
    * @return Whether the optimization should be terminated.
    */
   template<typename FunctionType, typename MatType, typename... CallbackTypes>
@@ -189,6 +307,9 @@ class SA
                     typename MatType::elem_type& energy,
                     size_t& idx,
                     size_t& sweepCounter,
+                    std::vector<MatType>& trialPoints,
+                    arma::Col<typename MatType::elem_type>& trialMoves,
+                    arma::Col<typename MatType::elem_type>& trialEnergies,
                     CallbackTypes&... callbacks);
 
   /**
@@ -37,7 +37,12 @@ SA<CoolingScheduleType>::SA(
     maxToleranceSweep(maxToleranceSweep),
     maxMoveCoef(maxMoveCoef),
     initMoveCoef(initMoveCoef),
-    gain(gain)
+    gain(gain),
+    proposalBatchSize(1),
+    numReplicas(1),
+    exchangeInterval(100),
+    ladderRatio(2.0),
+    screeningFidelity(0)
 {
   // Nothing to do.
 }
@@ -60,6 +65,10 @@ typename MatType::elem_type SA<CoolingScheduleType>::Optimize(
 
   BaseMatType& iterate = (BaseMatType&) iterateIn;
 
+  // Replica-exchange mode runs its own loop.
+  if (numReplicas > 1)
+    return OptimizeTempering(function, iterate, callbacks...);
+
   const size_t rows = iterate.n_rows;
   const size_t cols = iterate.n_cols;
 
@@ -80,13 +89,25 @@ typename MatType::elem_type SA<CoolingScheduleType>::Optimize(
   BaseMatType moveSize(rows, cols, arma::fill::none);
   moveSize.fill(initMoveCoef);
 
+  // Trial buffers for the batched proposal mode, allocated once here so the
+  // per-step proposal generation does not reallocate.
+  std::vector<BaseMatType> trialPoints;
+  arma::Col<ElemType> trialMoves;
+  arma::Col<ElemType> trialEnergies;
+  if (proposalBatchSize > 1)
+  {
+    trialPoints.resize(proposalBatchSize, iterate);
+    trialMoves.set_size(proposalBatchSize);
+    trialEnergies.set_size(proposalBatchSize);
+  }
+
   Callback::BeginOptimization(*this, function, iterate, callbacks...);
 
   // Initial moves to get rid of dependency of initial states.
   for (size_t i = 0; i < initMoves; ++i)
   {
     terminate |= GenerateMove(function, iterate, accept, moveSize, energy, idx,
-        sweepCounter, callbacks...);
+        sweepCounter, trialPoints, trialMoves, trialEnergies, callbacks...);
     if (terminate)
       break;
   }
@@ -96,7 +117,7 @@ typename MatType::elem_type SA<CoolingScheduleType>::Optimize(
   {
     oldEnergy = energy;
     terminate |= GenerateMove(function, iterate, accept, moveSize, energy, idx,
-        sweepCounter, callbacks...);
+        sweepCounter, trialPoints, trialMoves, trialEnergies, callbacks...);
     if (terminate)
       break;
     terminate |= Callback::StepTaken(*this, function, iterate, callbacks...);
@@ -128,6 +149,192 @@ typename MatType::elem_type SA<CoolingScheduleType>::Optimize(
   return energy;
 }
 
+//! Replica-exchange (parallel tempering) optimization.
+template<typename CoolingScheduleType>
+template<typename FunctionType, typename MatType, typename... CallbackTypes>
+typename MatType::elem_type SA<CoolingScheduleType>::OptimizeTempering(
+    FunctionType& function,
+    MatType& iterate,
+    CallbackTypes&... callbacks)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  const size_t replicas = numReplicas;
+  const size_t interval = std::max((size_t) 1, exchangeInterval);
+
+  // Per-replica state: position, energy, feedback move control and random
+  // stream.  Replica 0 is the coldest chain and carries the result; replica
+  // k runs at temperature * ladderRatio^k.
+  std::vector<MatType> repIterate(replicas, iterate);
+  arma::Col<ElemType> repEnergy(replicas);
+  std::vector<MatType> repAccept(replicas,
+      MatType(iterate.n_rows, iterate.n_cols, arma::fill::zeros));
+  std::vector<MatType> repMoveSize(replicas,
+      MatType(iterate.n_rows, iterate.n_cols, arma::fill::none));
+  std::vector<size_t> repIdx(replicas, 0);
+  std::vector<size_t> repSweep(replicas, 0);
+  std::vector<PhiloxGenerator> repGenerator;
+  std::vector<double> tempFactor(replicas);
+  for (size_t k = 0; k < replicas; ++k)
+  {
+    repMoveSize[k].fill(initMoveCoef);
+    repGenerator.push_back(generator.WithStream(generator.Stream() + k));
+    tempFactor[k] = std::pow(ladderRatio, (double) k);
+  }
+
+  bool terminate = false;
+
+  // Initial energies; the evaluations are independent.
+  ENS_PRAGMA_OMP_PARALLEL_FOR
+  for (ptrdiff_t k = 0; k < (ptrdiff_t) replicas; ++k)
+    repEnergy(k) = function.Evaluate(repIterate[k]);
+
+  terminate |= Callback::Evaluate(*this, function, repIterate[0],
+      repEnergy(0), callbacks...);
+
+  Callback::BeginOptimization(*this, function, iterate, callbacks...);
+
+  size_t frozenCount = 0;
+  size_t exchangeRound = 0;
+  for (size_t i = 0; i < maxIterations + initMoves && !terminate;
+      i += interval, ++exchangeRound)
+  {
+    const ElemType oldEnergy = repEnergy(0);
+
+    // Step every replica through one exchange interval; each chain uses its
+    // own random stream and move control, so the chains touch no shared
+    // state in here and the loop parallelizes cleanly.  No callbacks are
+    // raised inside the region.
+    ENS_PRAGMA_OMP_PARALLEL_FOR
+    for (ptrdiff_t k = 0; k < (ptrdiff_t) replicas; ++k)
+    {
+      for (size_t s = 0; s < interval; ++s)
+      {
+        ReplicaMove(function, repIterate[k], repAccept[k], repMoveSize[k],
+            repEnergy(k), repIdx[k], repSweep[k],
+            temperature * tempFactor[k], repGenerator[k]);
+      }
+    }
+
+    // Attempt exchanges between adjacent rungs; the starting parity
+    // alternates so every neighboring pair is tried every other round.
+    for (size_t k = exchangeRound % 2; k + 1 < replicas; k += 2)
+    {
+      const double betaCold = 1.0 / (temperature * tempFactor[k]);
+      const double betaHot = 1.0 / (temperature * tempFactor[k + 1]);
+      const double criterion = std::exp((betaCold - betaHot) *
+          (double) (repEnergy(k) - repEnergy(k + 1)));
+      if (criterion >= 1.0 || generator.Uniform() < criterion)
+      {
+        repIterate[k].swap(repIterate[k + 1]);
+        std::swap(repEnergy(k), repEnergy(k + 1));
+      }
+    }
+
+    // The base temperature stays at initT for the initial moves and cools
+    // once per step afterwards, as in the single-chain loop.
+    if (i >= initMoves)
+    {
+      for (size_t s = 0; s < interval; ++s)
+      {
+        temperature = coolingSchedule.NextTemperature(temperature,
+            repEnergy(0));
+      }
+    }
+
+    iterate = repIterate[0];
+    terminate |= Callback::StepTaken(*this, function, iterate, callbacks...);
+
+    // Frozen-state detection on the cold chain, as in the single-chain
+    // loop, with the interval's worth of steps counted at once.
+    if (std::abs(repEnergy(0) - oldEnergy) < tolerance)
+      frozenCount += interval;
+    else
+      frozenCount = 0;
+
+    if (frozenCount >= maxToleranceSweep * moveCtrlSweep * iterate.n_elem)
+    {
+      Info << "SA: minimized within tolerance " << tolerance << " for "
+          << maxToleranceSweep << " sweeps after " << i << " iterations; "
+          << "terminating optimization." << std::endl;
+
+      Callback::EndOptimization(*this, function, iterate, callbacks...);
+      return repEnergy(0);
+    }
+  }
+
+  if (!terminate)
+  {
+    Warn << "SA: maximum iterations (" << maxIterations << ") reached; "
+        << "terminating optimization." << std::endl;
+  }
+
+  iterate = repIterate[0];
+  Callback::EndOptimization(*this, function, iterate, callbacks...);
+  return repEnergy(0);
+}
+
+//! Single annealing move of one tempering replica.
+template<typename CoolingScheduleType>
+template<typename FunctionType, typename MatType>
+void SA<CoolingScheduleType>::ReplicaMove(
+    FunctionType& function,
+    MatType& iterate,
+    MatType& accept,
+    MatType& moveSize,
+    typename MatType::elem_type& energy,
+    size_t& idx,
+    size_t& sweepCounter,
+    const double replicaTemperature,
+    PhiloxGenerator& rng)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  const ElemType prevEnergy = energy;
+  const ElemType prevValue = iterate(idx);
+
+  // Sample from a Laplace distribution with scale parameter moveSize(idx).
+  const double unif = 2.0 * rng.Uniform() - 1.0;
+  const ElemType move = (unif < 0) ? (moveSize(idx) * std::log(1 + unif)) :
+      (-moveSize(idx) * std::log(1 - unif));
+
+  // As in GenerateMove(), the acceptance threshold is drawn up front so a
+  // bound-aware Evaluate() can stop once rejection is certain; the energy is
+  // restored on rejection, so a truncated value never survives the step.
+  const double xi = rng.Uniform();
+  const ElemType rejectionBound = prevEnergy -
+      ElemType(replicaTemperature * std::log(xi));
+
+  iterate(idx) += move;
+  energy = EvaluateWithBound(function, iterate, rejectionBound);
+
+  // Metropolis criterion at the replica's own temperature.
+  const double delta = energy - prevEnergy;
+  const double criterion = std::exp(-delta / replicaTemperature);
+  if (delta <= 0. || criterion > xi)
+  {
+    accept(idx) += ElemType(1.);
+  }
+  else // Reject the move; restore previous state.
+  {
+    iterate(idx) = prevValue;
+    energy = prevEnergy;
+  }
+
+  ++idx;
+  if (idx == iterate.n_elem) // Finished with a sweep.
+  {
+    idx = 0;
+    ++sweepCounter;
+  }
+
+  if (sweepCounter == moveCtrlSweep) // Do MoveControl().
+  {
+    MoveControl(moveCtrlSweep, accept, moveSize);
+    sweepCounter = 0;
+  }
+}
+
 /**
  * GenerateMove proposes a move on element iterate(idx), and determines
  * it that move is acceptable or not according to the Metropolis criterion.
@@ -135,6 +342,14 @@ typename MatType::elem_type SA<CoolingScheduleType>::Optimize(
  * parameters. When all elements of the state have been moved (a sweep), it
  * resets idx and increments sweepCounter. When sweepCounter reaches
  * moveCtrlSweep, it performs moveControl and resets sweepCounter.
+ *
+ * With proposalBatchSize > 1, a batch of trial moves on iterate(idx) is drawn
+ * instead and the trial points are evaluated in parallel (multiple-try
+ * Metropolis): one trial is selected by sampling proportionally to the
+ * Boltzmann weights exp(-E_j / T), and the selected trial then faces the
+ * usual Metropolis acceptance against the current state.  The reverse-move
+ * correction of full multiple-try Metropolis is omitted; SA needs a biased
+ * exploration of low-energy moves, not detailed balance.
  */
 template<typename CoolingScheduleType>
 template<typename FunctionType, typename MatType, typename... CallbackTypes>
@@ -146,6 +361,9 @@ bool SA<CoolingScheduleType>::GenerateMove(
     typename MatType::elem_type& energy,
     size_t& idx,
     size_t& sweepCounter,
+    std::vector<MatType>& trialPoints,
+    arma::Col<typename MatType::elem_type>& trialMoves,
+    arma::Col<typename MatType::elem_type>& trialEnergies,
     CallbackTypes&... callbacks)
 {
   typedef typename MatType::elem_type ElemType;
@@ -153,34 +371,125 @@ bool SA<CoolingScheduleType>::GenerateMove(
   const ElemType prevEnergy = energy;
   const ElemType prevValue = iterate(idx);
 
+  bool terminate = false;
+
   // It is possible to use a non-Laplace distribution here, but it is difficult
   // because the acceptance ratio should be as close to 0.44 as possible, and
   // MoveControl() is derived for the Laplace distribution.
 
-  // Sample from a Laplace distribution with scale parameter moveSize(idx).
-  const double unif = 2.0 * arma::randu() - 1.0;
-  const ElemType move = (unif < 0) ? (moveSize(idx) * std::log(1 + unif)) :
-      (-moveSize(idx) * std::log(1 - unif));
+  if (proposalBatchSize > 1)
+  {
+    const size_t batch = proposalBatchSize;
 
-  iterate(idx) += move;
-  energy = function.Evaluate(iterate);
+    // Draw the batch of Laplace moves serially (the draws are cheap and this
+    // keeps the RNG use single-threaded), then evaluate the trial points in
+    // parallel; Evaluate() must be thread-safe for this.
+    for (size_t j = 0; j < batch; ++j)
+    {
+      const double unif = 2.0 * generator.Uniform() - 1.0;
+      trialMoves(j) = (unif < 0) ? (moveSize(idx) * std::log(1 + unif)) :
+          (-moveSize(idx) * std::log(1 - unif));
+    }
 
-  const bool terminate = Callback::Evaluate(*this, function, iterate, energy,
-      callbacks...);
+    ENS_PRAGMA_OMP_PARALLEL_FOR
+    for (ptrdiff_t j = 0; j < (ptrdiff_t) batch; ++j)
+    {
+      trialPoints[j] = iterate;
+      trialPoints[j](idx) = prevValue + trialMoves(j);
+      trialEnergies(j) = function.Evaluate(trialPoints[j]);
+    }
 
-  // According to the Metropolis criterion, accept the move with probability
-  // min{1, exp(-(E_new - E_old) / T)}.
-  const double xi = arma::randu();
-  const double delta = energy - prevEnergy;
-  const double criterion = std::exp(-delta / temperature);
-  if (delta <= 0. || criterion > xi)
-  {
-    accept(idx) += ElemType(1.);
+    for (size_t j = 0; j < batch; ++j)
+    {
+      terminate |= Callback::Evaluate(*this, function, trialPoints[j],
+          trialEnergies(j), callbacks...);
+    }
+
+    // Select one trial proportionally to exp(-E_j / T); shifting by the
+    // minimum trial energy keeps the exponentials from underflowing.
+    const ElemType minTrialEnergy = trialEnergies.min();
+    double totalWeight = 0.0;
+    for (size_t j = 0; j < batch; ++j)
+      totalWeight += std::exp(-(trialEnergies(j) - minTrialEnergy) /
+          temperature);
+
+    const double u = generator.Uniform() * totalWeight;
+    size_t selected = batch - 1;
+    double cumulative = 0.0;
+    for (size_t j = 0; j < batch; ++j)
+    {
+      cumulative += std::exp(-(trialEnergies(j) - minTrialEnergy) /
+          temperature);
+      if (cumulative >= u)
+      {
+        selected = j;
+        break;
+      }
+    }
+
+    // The selected trial faces the usual Metropolis acceptance.
+    const double xi = generator.Uniform();
+    const double delta = trialEnergies(selected) - prevEnergy;
+    const double criterion = std::exp(-delta / temperature);
+    if (delta <= 0. || criterion > xi)
+    {
+      iterate(idx) = prevValue + trialMoves(selected);
+      energy = trialEnergies(selected);
+      accept(idx) += ElemType(1.);
+    }
+    // Otherwise the move is rejected and iterate is left untouched.
   }
-  else // Reject the move; restore previous state.
+  else
   {
-    iterate(idx) = prevValue;
-    energy = prevEnergy;
+    // Sample from a Laplace distribution with scale parameter moveSize(idx).
+    const double unif = 2.0 * generator.Uniform() - 1.0;
+    const ElemType move = (unif < 0) ? (moveSize(idx) * std::log(1 + unif)) :
+        (-moveSize(idx) * std::log(1 - unif));
+
+    // Draw the Metropolis acceptance threshold up front: the move is
+    // rejected exactly when the new energy reaches
+    // prevEnergy - T * log(xi), so that value can be handed to a bound-aware
+    // Evaluate() (see EvaluateWithBound()) as the point where the evaluation
+    // may as well stop.  The energy is restored on rejection, so a truncated
+    // value never survives the step.
+    const double xi = generator.Uniform();
+    const ElemType rejectionBound = prevEnergy -
+        ElemType(temperature * std::log(xi));
+
+    iterate(idx) += move;
+
+    // Optional low-fidelity screening (see ScreeningFidelity()): the cheap
+    // score only filters proposals that already cross the rejection
+    // threshold, so the exact evaluation is spent on the survivors.  A
+    // screened-out proposal keeps its cheap score as the energy, which the
+    // Metropolis test below then rejects and restores.
+    bool screenedOut = false;
+    if (screeningFidelity > 0 &&
+        traits::HasFidelityEvaluate<FunctionType, MatType>::value)
+    {
+      energy = EvaluateWithFidelity(function, iterate, screeningFidelity);
+      screenedOut = (energy >= rejectionBound);
+    }
+
+    if (!screenedOut)
+      energy = EvaluateWithBound(function, iterate, rejectionBound);
+
+    terminate |= Callback::Evaluate(*this, function, iterate, energy,
+        callbacks...);
+
+    // According to the Metropolis criterion, accept the move with probability
+    // min{1, exp(-(E_new - E_old) / T)}.
+    const double delta = energy - prevEnergy;
+    const double criterion = std::exp(-delta / temperature);
+    if (delta <= 0. || criterion > xi)
+    {
+      accept(idx) += ElemType(1.);
+    }
+    else // Reject the move; restore previous state.
+    {
+      iterate(idx) = prevValue;
+      energy = prevEnergy;
+    }
   }
 
   ++idx;
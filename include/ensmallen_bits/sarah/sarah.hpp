@@ -12,6 +12,9 @@
 #ifndef ENSMALLEN_SARAH_SARAH_HPP
 #define ENSMALLEN_SARAH_SARAH_HPP
 
+#include <ensmallen_bits/sgd/decay_policies/no_decay.hpp>
+#include <ensmallen_bits/svrg/barzilai_borwein_decay.hpp>
+
 #include "sarah_update.hpp"
 #include "sarah_plus_update.hpp"
 
@@ -42,8 +45,12 @@ namespace ens {
  *
  * @tparam UpdatePolicyType update policy used by SARAHType during the iterative
  *    update process.
+ * @tparam DecayPolicyType Decay policy used to adjust the step size between
+ *    outer iterations; BarzilaiBorweinDecay computes the step size from the
+ *    snapshot points and full gradients, so no step size tuning is needed.
  */
-template<typename UpdatePolicyType = SARAHUpdate>
+template<typename UpdatePolicyType = SARAHUpdate,
+         typename DecayPolicyType = NoDecay>
 class SARAHType
 {
  public:
@@ -67,6 +74,8 @@ class SARAHType
    *     function is visited in linear order.
    * @param updatePolicy Instantiated update policy used to adjust the given
    *     parameters.
+   * @param decayPolicy Instantiated decay policy used to adjust the step size
+   *     between outer iterations.
    * @param exactObjective Calculate the exact objective (Default: estimate the
    *        final objective obtained on the last pass over the data).
    */
@@ -77,6 +86,7 @@ class SARAHType
             const double tolerance = 1e-5,
             const bool shuffle = true,
             const UpdatePolicyType& updatePolicy = UpdatePolicyType(),
+            const DecayPolicyType& decayPolicy = DecayPolicyType(),
             const bool exactObjective = false);
 
   /**
@@ -151,11 +161,27 @@ class SARAHType
   //! Modify whether or not the actual objective is calculated.
   bool& ExactObjective() { return exactObjective; }
 
+  //! Get whether the full-gradient snapshot is computed in parallel with
+  //! OpenMP (requires Gradient() to be thread-safe).
+  bool ParallelFullGradient() const { return parallelFullGradient; }
+  //! Modify whether the full-gradient snapshot is computed in parallel.
+  bool& ParallelFullGradient() { return parallelFullGradient; }
+
   //! Get the update policy.
   const UpdatePolicyType& UpdatePolicy() const { return updatePolicy; }
   //! Modify the update policy.
   UpdatePolicyType& UpdatePolicy() { return updatePolicy; }
 
+  //! Get the decay policy.
+  const DecayPolicyType& DecayPolicy() const { return decayPolicy; }
+  //! Modify the decay policy.
+  DecayPolicyType& DecayPolicy() { return decayPolicy; }
+
+  //! Get the workspace holding the optimizer's internal gradient buffers.
+  const ens::Workspace& Workspace() const { return workspace; }
+  //! Modify the workspace holding the optimizer's internal gradient buffers.
+  ens::Workspace& Workspace() { return workspace; }
+
  private:
   //! The step size for each example.
   double stepSize;
@@ -179,22 +205,42 @@ class SARAHType
   //! Controls whether or not the actual Objective value is calculated.
   bool exactObjective;
 
+  //! Whether the full-gradient snapshot is computed in parallel.
+  bool parallelFullGradient;
+
   //! The update policy used to update the parameters in each iteration.
   UpdatePolicyType updatePolicy;
+
+  //! The decay policy used to adjust the step size between outer iterations.
+  DecayPolicyType decayPolicy;
+
+  //! Reusable buffers for the optimization's internal state.
+  ens::Workspace workspace;
 };
 
 // Convenience typedefs.
 
 /**
- * Standard stochastic variance reduced gradient.
+ * Standard stochastic recursive gradient.
  */
 using SARAH = SARAHType<SARAHUpdate>;
 
 /**
- * Stochastic variance reduced gradient with Barzilai-Borwein.
+ * Stochastic recursive gradient with an automatic and adaptive choice of the
+ * inner loop size (SARAH+).
  */
 using SARAH_Plus = SARAHType<SARAHPlusUpdate>;
 
+/**
+ * Stochastic recursive gradient with Barzilai-Borwein step sizes.
+ */
+using SARAH_BB = SARAHType<SARAHUpdate, BarzilaiBorweinDecay>;
+
+/**
+ * SARAH+ with Barzilai-Borwein step sizes.
+ */
+using SARAH_Plus_BB = SARAHType<SARAHPlusUpdate, BarzilaiBorweinDecay>;
+
 } // namespace ens
 
 // Include implementation.
@@ -19,8 +19,8 @@
 
 namespace ens {
 
-template<typename UpdatePolicyType>
-SARAHType<UpdatePolicyType>::SARAHType(
+template<typename UpdatePolicyType, typename DecayPolicyType>
+SARAHType<UpdatePolicyType, DecayPolicyType>::SARAHType(
     const double stepSize,
     const size_t batchSize,
     const size_t maxIterations,
@@ -28,6 +28,7 @@ SARAHType<UpdatePolicyType>::SARAHType(
     const double tolerance,
     const bool shuffle,
     const UpdatePolicyType& updatePolicy,
+    const DecayPolicyType& decayPolicy,
     const bool exactObjective) :
     stepSize(stepSize),
     batchSize(batchSize),
@@ -36,18 +37,20 @@ SARAHType<UpdatePolicyType>::SARAHType(
     tolerance(tolerance),
     shuffle(shuffle),
     exactObjective(exactObjective),
-    updatePolicy(updatePolicy)
+    parallelFullGradient(false),
+    updatePolicy(updatePolicy),
+    decayPolicy(decayPolicy)
 { /* Nothing to do. */ }
 
 //! Optimize the function (minimize).
-template<typename UpdatePolicyType>
+template<typename UpdatePolicyType, typename DecayPolicyType>
 template<typename SeparableFunctionType,
          typename MatType,
          typename GradType,
          typename... CallbackTypes>
 typename std::enable_if<IsArmaType<GradType>::value,
 typename MatType::elem_type>::type
-SARAHType<UpdatePolicyType>::Optimize(
+SARAHType<UpdatePolicyType, DecayPolicyType>::Optimize(
     SeparableFunctionType& functionIn,
     MatType& iterateIn,
     CallbackTypes&&... callbacks)
@@ -83,11 +86,27 @@ SARAHType<UpdatePolicyType>::Optimize(
   if (innerIterations == 0)
     innerIterations = numFunctions;
 
-  // Now iterate!
-  BaseGradType gradient(iterate.n_rows, iterate.n_cols);
-  BaseGradType v(iterate.n_rows, iterate.n_cols);
-  BaseGradType gradient0(iterate.n_rows, iterate.n_cols);
-  BaseMatType iterate0;
+  // Now iterate!  All internal buffers live in the workspace so that
+  // repeated Optimize() calls reuse the same allocations.
+  BaseGradType& gradient = workspace.Get<BaseGradType>(0, iterate.n_rows,
+      iterate.n_cols);
+  BaseGradType& v = workspace.Get<BaseGradType>(1, iterate.n_rows,
+      iterate.n_cols);
+  BaseGradType& gradient0 = workspace.Get<BaseGradType>(2, iterate.n_rows,
+      iterate.n_cols);
+  BaseMatType& iterate0 = workspace.Get<BaseMatType>(3, iterate.n_rows,
+      iterate.n_cols);
+  BaseMatType& snapshot = workspace.Get<BaseMatType>(4, iterate.n_rows,
+      iterate.n_cols);
+
+  // Find the number of batches.
+  size_t numBatches = numFunctions / batchSize;
+  if (numFunctions % batchSize != 0)
+    ++numBatches; // Capture last few.
+
+  // Instantiate the decay policy for this optimization.
+  typename DecayPolicyType::template Policy<BaseMatType, BaseGradType>
+      instDecayPolicy(decayPolicy);
 
   const size_t actualMaxIterations = (maxIterations == 0) ?
       std::numeric_limits<size_t>::max() : maxIterations;
@@ -129,27 +148,81 @@ SARAHType<UpdatePolicyType>::Optimize(
     lastObjective = overallObjective;
 
     // Compute the full gradient.
-    size_t effectiveBatchSize = std::min(batchSize, numFunctions);
-    function.Gradient(iterate, 0, v, effectiveBatchSize);
+    if (parallelFullGradient)
+    {
+      // Parallel snapshot: each thread accumulates a partial sum over its
+      // share of the batches, reduced into v at the end.  This requires
+      // Gradient() to be thread-safe; the Gradient callback is invoked once
+      // with the reduced full gradient.
+      v.zeros();
+      const size_t snapshotBatches = (numFunctions + batchSize - 1) /
+          batchSize;
+
+      ENS_PRAGMA_OMP_PARALLEL
+      {
+        size_t threadId = 0;
+        size_t numThreads = 1;
+        #ifdef ENS_USE_OPENMP
+          threadId = omp_get_thread_num();
+          numThreads = omp_get_num_threads();
+        #endif
+
+        BaseGradType partialGradient(iterate.n_rows, iterate.n_cols);
+        partialGradient.zeros();
+        BaseGradType batchGradient(iterate.n_rows, iterate.n_cols);
+
+        for (size_t b = threadId; b < snapshotBatches; b += numThreads)
+        {
+          const size_t begin = b * batchSize;
+          const size_t effectiveBatchSize = std::min(batchSize,
+              numFunctions - begin);
 
-    terminate |= Callback::Gradient(*this, function, iterate, v, callbacks...);
+          function.Gradient(iterate, begin, batchGradient,
+              effectiveBatchSize);
+          partialGradient += batchGradient;
+        }
 
-    for (size_t f = effectiveBatchSize; f < numFunctions;
-        /* incrementing done manually */)
+        ENS_PRAGMA_OMP_CRITICAL
+        {
+          v += partialGradient;
+        }
+      }
+
+      v /= (double) numFunctions;
+      terminate |= Callback::Gradient(*this, function, iterate, v,
+          callbacks...);
+    }
+    else
     {
-      // Find the effective batch size (the last batch may be smaller).
-      effectiveBatchSize = std::min(batchSize, numFunctions - f);
+      size_t effectiveBatchSize = std::min(batchSize, numFunctions);
+      function.Gradient(iterate, 0, v, effectiveBatchSize);
 
-      function.Gradient(iterate, f, gradient, effectiveBatchSize);
-      v += gradient;
+      terminate |= Callback::Gradient(*this, function, iterate, v,
+          callbacks...);
 
-      f += effectiveBatchSize;
+      for (size_t f = effectiveBatchSize; f < numFunctions;
+          /* incrementing done manually */)
+      {
+        // Find the effective batch size (the last batch may be smaller).
+        effectiveBatchSize = std::min(batchSize, numFunctions - f);
+
+        function.Gradient(iterate, f, gradient, effectiveBatchSize);
+        v += gradient;
+
+        f += effectiveBatchSize;
+      }
+      v /= (double) numFunctions;
     }
-    v /= (double) numFunctions;
 
     if (terminate)
       break;
 
+    // Let the decay policy adjust the step size from the snapshot points and
+    // full gradients; on the first outer iteration it only records them.
+    instDecayPolicy.Update(iterate, snapshot, gradient, v, numBatches,
+        stepSize);
+    snapshot = iterate;
+
     // Update iterate with full gradient (v).
     iterate -= stepSize * v;
 
@@ -40,18 +40,18 @@ inline void Svec(const MatAType& input, MatBType& output)
   const size_t n = iMat.n_rows;
   const size_t n2bar = n * (n + 1) / 2;
 
-  output.zeros(n2bar, 1);
+  output.set_size(n2bar, 1);
 
+  // Copy the upper-triangular segment of each row as one block, then undo
+  // the sqrt(2) scaling on the diagonal entry leading the segment.
   size_t idx = 0;
   for (size_t i = 0; i < n; i++)
   {
-    for (size_t j = i; j < n; j++)
-    {
-      if (i == j)
-        output(idx++, 0) = iMat(i, j);
-      else
-        output(idx++, 0) = arma::datum::sqrt2 * iMat(i, j);
-    }
+    const size_t len = n - i;
+    output.submat(idx, 0, idx + len - 1, 0) = arma::datum::sqrt2 *
+        iMat(arma::span(i, i), arma::span(i, n - 1)).t();
+    output(idx, 0) = iMat(i, i);
+    idx += len;
   }
 }
 
@@ -94,19 +94,21 @@ inline void Smat(const MatAType& input, MatBType& output)
   const size_t n = static_cast<size_t>
       (ceil((-1. + sqrt(1. + 8. * iMat.n_elem))/2.));
 
-  output.zeros(n, n);
+  output.set_size(n, n);
 
+  // Scatter each row's segment as one block, then fix up the diagonal entry
+  // and mirror the upper triangle.
   size_t idx = 0;
   for (size_t i = 0; i < n; i++)
   {
-    for (size_t j = i; j < n; j++)
-    {
-      if (i == j)
-        output(i, j) = iMat(idx++);
-      else
-        output(i, j) = output(j, i) = 0.5 * arma::datum::sqrt2 * iMat(idx++);
-    }
+    const size_t len = n - i;
+    output(arma::span(i, i), arma::span(i, n - 1)) =
+        (0.5 * arma::datum::sqrt2) *
+        iMat.submat(idx, 0, idx + len - 1, 0).t();
+    output(i, i) = iMat(idx, 0);
+    idx += len;
   }
+  output = arma::symmatu(output);
 }
 
 /**
@@ -150,6 +152,27 @@ inline void SymKronId(const MatAType& A, MatBType& op)
   }
 }
 
+/**
+ * Apply the SymKronId operator of A to the vector sv matrix-free:
+ *
+ *    out = svec(0.5 * (A X + X A)),  where X = smat(sv),
+ *
+ * without forming the n2bar x n2bar operator matrix.  Since A and X are
+ * symmetric, X A = (A X)^T, so only one matrix product is needed.
+ *
+ * @param A A symmetric matrix.
+ * @param sv Svec representation of a symmetric matrix X.
+ * @param out Svec representation of 0.5 * (A X + X A).
+ */
+template<typename MatAType, typename VecType, typename MatBType>
+inline void SymKronIdApply(const MatAType& A, const VecType& sv, MatBType& out)
+{
+  MatBType x;
+  Smat(sv, x);
+  const MatBType ax(A * x);
+  Svec(MatBType(0.5 * (ax + ax.t())), out);
+}
+
 } // namespace math
 } // namespace ens
 
@@ -42,11 +42,17 @@ class LRSDP
    * @param numDenseConstraints Number of dense constraints in the problem.
    * @param initialPoint Initial point of the optimization.
    * @param maxIterations Maximum number of iterations.
+   * @param warmStart If true, Optimize() reuses the Lagrange multipliers and
+   *    penalty parameter from the previous Optimize() call instead of
+   *    resetting them; pass the previous solution as the starting coordinates
+   *    to warm start the low-rank factor as well.  This is useful when
+   *    solving a sequence of closely related SDPs.
    */
   LRSDP(const size_t numSparseConstraints,
         const size_t numDenseConstraints,
         const arma::Mat<typename SDPType::ElemType>& initialPoint,
-        const size_t maxIterations = 1000);
+        const size_t maxIterations = 1000,
+        const bool warmStart = false);
 
   /**
    * Create an LRSDP object with the given SDP problem to be solved, and the
@@ -95,6 +101,29 @@ class LRSDP
   //! Modify the maximum number of iterations.
   size_t& MaxIterations() { return maxIterations; }
 
+  //! Get whether optimization warm starts from the previous solve.
+  bool WarmStart() const { return warmStart; }
+  //! Modify whether optimization warm starts from the previous solve.
+  bool& WarmStart() { return warmStart; }
+
+  //! Get whether the factor rank is adapted automatically.  When enabled,
+  //! the solve starts at the rank of the given coordinates (so a small
+  //! factor can be passed in); after each augmented Lagrangian solve the
+  //! factor is checked for rank deficiency, and while it still has full
+  //! column rank (meaning the solution may be rank limited) a small random
+  //! column is appended and the solve continues.  The Lagrange multipliers
+  //! and penalty parameter are preserved across growth steps, and growth
+  //! stops at the Barvinok-Pataki bound.
+  bool RankAdaptation() const { return rankAdaptation; }
+  //! Modify whether the factor rank is adapted automatically.
+  bool& RankAdaptation() { return rankAdaptation; }
+
+  //! Get the relative singular value threshold below which the solution
+  //! factor counts as rank deficient (and rank growth stops).
+  double RankTolerance() const { return rankTolerance; }
+  //! Modify the rank deficiency threshold.
+  double& RankTolerance() { return rankTolerance; }
+
  private:
   //! Augmented lagrangian optimizer.
   AugLagrangian augLag;
@@ -102,6 +131,12 @@ class LRSDP
   LRSDPFunction<SDPType> function;
   //! The maximum number of iterations for optimization.
   size_t maxIterations;
+  //! Whether to reuse the multipliers and penalty from the previous solve.
+  bool warmStart;
+  //! Whether the factor rank is grown automatically during the solve.
+  bool rankAdaptation;
+  //! Relative singular value threshold for the rank deficiency check.
+  double rankTolerance;
 };
 
 } // namespace ens
@@ -128,6 +128,11 @@ class LRSDPFunction
   //! Get the Any object for rrt.
   Any& RRTAny() { return rrt; }
 
+  //! Get the cached constraint values (see EvaluateImpl()).
+  const arma::vec& ConstraintValues() const { return constraintValues; }
+  //! Modify the cached constraint values.
+  arma::vec& ConstraintValues() { return constraintValues; }
+
  private:
   //! SDP object representing the problem
   SDPType sdp;
@@ -137,6 +142,11 @@ class LRSDPFunction
 
   //! Cache R*R^T matrix.
   Any rrt;
+
+  //! Cache the constraint values Tr(A_i * (R R^T)) - b_i.  Like the R*R^T
+  //! cache, these are computed by Evaluate() and reused by the Gradient()
+  //! call that follows it with the same coordinates.
+  arma::vec constraintValues;
 };
 
 // Declare specializations in lrsdp_function.cpp.
@@ -120,17 +120,15 @@ void UpdateRRT(LRSDPFunction<SDPType>& function,
   function.template RRT<MatType>() = std::move(newrrt);
 }
 
-//! Utility function for calculating part of the objective when AugLagrangian is
-//! used with an LRSDPFunction.
+//! Utility function for computing the constraint values
+//! Tr(A_i * (R R^T)) - b_i of one constraint block into the persistent cache.
 template <typename MatrixType, typename VecType, typename MatType>
 static inline void
-UpdateObjective(typename MatType::elem_type& objective,
-                const MatType& rrt,
-                const std::vector<MatrixType>& ais,
-                const VecType& bis,
-                const arma::vec& lambda,
-                const size_t lambdaOffset,
-                const double sigma)
+UpdateConstraintValues(arma::vec& constraintValues,
+                       const MatType& rrt,
+                       const std::vector<MatrixType>& ais,
+                       const VecType& bis,
+                       const size_t offset)
 {
   for (size_t i = 0; i < ais.size(); ++i)
   {
@@ -138,31 +136,26 @@ UpdateObjective(typename MatType::elem_type& objective,
     // Here taking R^T * A first is not recommended as we are already
     // using pre-computed R * R^T. Taking R^T * A first will result in increase
     // in number of computations.
-    const double constraint = arma::accu(ais[i] % rrt) - bis[i];
-    objective -= (lambda[lambdaOffset + i] * constraint);
-    objective += (sigma / 2.) * constraint * constraint;
+    constraintValues[offset + i] = arma::accu(ais[i] % rrt) - bis[i];
   }
 }
 
 //! Utility function for calculating part of the gradient when AugLagrangian is
-//! used with an LRSDPFunction.
-template <typename MatrixType, typename VecType, typename MatType>
+//! used with an LRSDPFunction.  The constraint values were already computed
+//! and cached by the preceding Evaluate() call.
+template <typename MatrixType, typename MatType>
 static inline void
 UpdateGradient(MatType& s,
-               const MatType& rrt,
                const std::vector<MatrixType>& ais,
-               const VecType& bis,
+               const arma::vec& constraintValues,
                const arma::vec& lambda,
                const size_t lambdaOffset,
                const double sigma)
 {
   for (size_t i = 0; i < ais.size(); ++i)
   {
-    // Here taking R^T * A first is not recommended as we are already
-    // using pre-computed R * R^T. Taking R^T * A first will result in increase
-    // in number of computations.
-    const double constraint = arma::accu(ais[i] % rrt) - bis[i];
-    const double y = lambda[lambdaOffset + i] - sigma * constraint;
+    const double y = lambda[lambdaOffset + i] -
+        sigma * constraintValues[lambdaOffset + i];
     s -= y * ais[i];
   }
 }
@@ -210,12 +203,19 @@ EvaluateImpl(LRSDPFunction<SDPType>& function,
   typename MatType::elem_type objective =
       trace((trans(coordinates) * function.SDP().C()) * coordinates);
 
-  // Now each constraint.
-  UpdateObjective(objective, function.template RRT<MatType>(),
-      function.SDP().SparseA(), function.SDP().SparseB(), lambda, 0, sigma);
-  UpdateObjective(objective, function.template RRT<MatType>(),
-      function.SDP().DenseA(), function.SDP().DenseB(), lambda,
-      function.SDP().NumSparseConstraints(), sigma);
+  // Now compute each constraint value into the persistent cache.  set_size()
+  // is a no-op after the first call, so the buffer is allocated only once and
+  // reused by every Evaluate() and the Gradient() calls that follow.
+  arma::vec& constraintValues = function.ConstraintValues();
+  constraintValues.set_size(function.NumConstraints());
+  UpdateConstraintValues(constraintValues, function.template RRT<MatType>(),
+      function.SDP().SparseA(), function.SDP().SparseB(), 0);
+  UpdateConstraintValues(constraintValues, function.template RRT<MatType>(),
+      function.SDP().DenseA(), function.SDP().DenseB(),
+      function.SDP().NumSparseConstraints());
+
+  objective -= arma::dot(lambda, constraintValues);
+  objective += (sigma / 2.) * arma::dot(constraintValues, constraintValues);
 
   return objective;
 }
@@ -234,16 +234,17 @@ GradientImpl(const LRSDPFunction<SDPType>& function,
   // S' = C - sum_{i = 1}^{m} y'_i A_i
   // y'_i = y_i - sigma * (Trace(A_i * (R R^T)) - b_i)
 
-  // Directly retrieve R*R^T from cache.
-  const MatType& rrt = function.template RRT<MatType>();
+  // Directly retrieve the constraint values cached by the preceding
+  // Evaluate() call; like the R*R^T cache, this relies on the optimizer
+  // calling Evaluate() before Gradient() with the same coordinates.
+  const arma::vec& constraintValues = function.ConstraintValues();
   MatType s(function.SDP().C());
 
   UpdateGradient(
-      s, rrt, function.SDP().SparseA(), function.SDP().SparseB(),
-      lambda, 0, sigma);
+      s, function.SDP().SparseA(), constraintValues, lambda, 0, sigma);
   UpdateGradient(
-      s, rrt, function.SDP().DenseA(), function.SDP().DenseB(),
-      lambda, function.SDP().NumSparseConstraints(), sigma);
+      s, function.SDP().DenseA(), constraintValues, lambda,
+      function.SDP().NumSparseConstraints(), sigma);
 
   gradient = 2 * s * coordinates;
 }
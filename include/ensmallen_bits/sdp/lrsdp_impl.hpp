@@ -21,9 +21,13 @@ template<typename SDPType>
 LRSDP<SDPType>::LRSDP(const size_t numSparseConstraints,
                       const size_t numDenseConstraints,
                       const arma::Mat<typename SDPType::ElemType>& initialPoint,
-                      const size_t maxIterations) :
+                      const size_t maxIterations,
+                      const bool warmStart) :
     function(numSparseConstraints, numDenseConstraints, initialPoint),
-    maxIterations(maxIterations)
+    maxIterations(maxIterations),
+    warmStart(warmStart),
+    rankAdaptation(false),
+    rankTolerance(1e-3)
 { }
 
 template<typename SDPType>
@@ -31,13 +35,76 @@ template<typename MatType, typename... CallbackTypes>
 typename MatType::elem_type LRSDP<SDPType>::Optimize(
     MatType& coordinates, CallbackTypes&&... callbacks)
 {
-  function.RRTAny().Clean();
-  function.RRTAny().template Set<MatType>(
-      new MatType(coordinates * coordinates.t()));
+  typedef typename MatType::elem_type ElemType;
 
-  augLag.Sigma() = 10;
+  // When warm starting, keep the Lagrange multipliers and penalty parameter
+  // the augmented Lagrangian ended the previous solve with; the low-rank
+  // factor is warm started by passing the previous solution as coordinates.
+  // If the number of constraints changed since the last solve, the old
+  // multipliers do not apply and we fall back to a cold start.
+  if (warmStart && augLag.Lambda().n_elem != SDP().NumConstraints())
+    augLag.Lambda().reset();
+  if (!warmStart || augLag.Lambda().is_empty())
+    augLag.Sigma() = 10;
   augLag.MaxIterations() = maxIterations;
-  augLag.Optimize(function, coordinates, callbacks...);
+
+  if (!rankAdaptation)
+  {
+    function.RRTAny().Clean();
+    function.RRTAny().template Set<MatType>(
+        new MatType(coordinates * coordinates.t()));
+    augLag.Optimize(function, coordinates, callbacks...);
+
+    return function.Evaluate(coordinates);
+  }
+
+  // With rank adaptation, solve at the current rank and then check whether
+  // the solution factor is rank deficient.  A deficient factor means the
+  // current rank already exceeds what the solution needs, so we are done; a
+  // factor with full column rank may be rank limited, so a small random
+  // column is appended and the solve continues.  The Lagrange multipliers
+  // and penalty parameter stay in the AugLagrangian object across growth
+  // steps, so each re-solve is a warm continuation rather than a restart.
+  //
+  // By the Barvinok-Pataki bound some optimal solution has rank r with
+  // r (r + 1) / 2 <= m, so growing past that (or past the matrix dimension)
+  // is never necessary.
+  size_t rankBound = 1;
+  while (rankBound * (rankBound + 1) / 2 < SDP().NumConstraints() &&
+      rankBound < coordinates.n_rows)
+    ++rankBound;
+
+  while (true)
+  {
+    function.RRTAny().Clean();
+    function.RRTAny().template Set<MatType>(
+        new MatType(coordinates * coordinates.t()));
+    augLag.Optimize(function, coordinates, callbacks...);
+
+    if (coordinates.n_cols >= rankBound)
+      break;
+
+    // Cheap deficiency check: the singular values of the tall, thin factor
+    // cost only O(n rank^2) to compute, negligible next to the solve.
+    arma::Col<ElemType> sv;
+    if (!arma::svd(sv, coordinates) || sv.n_elem == 0)
+      break;
+    if (sv(sv.n_elem - 1) <= (ElemType) rankTolerance * sv(0))
+      break;
+
+    Info << "LRSDP::Optimize(): factor has full column rank "
+        << coordinates.n_cols << "; growing to rank "
+        << (coordinates.n_cols + 1) << "." << std::endl;
+
+    // Append a small random column: it barely perturbs the current solution
+    // but gives the optimizer a direction to escape the rank restriction.
+    MatType newColumn(coordinates.n_rows, 1);
+    newColumn.randn();
+    const ElemType scale = std::max((ElemType) arma::norm(coordinates, "fro"),
+        (ElemType) 1) / std::sqrt((ElemType) coordinates.n_rows);
+    coordinates = arma::join_rows(coordinates,
+        MatType((ElemType) 1e-3 * scale * newColumn));
+  }
 
   return function.Evaluate(coordinates);
 }
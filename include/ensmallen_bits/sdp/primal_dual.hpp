@@ -110,6 +110,20 @@ class PrimalDualSolver
   //! Modify the dual infeasibility tolerance.
   double& DualInfeasTol() { return dualInfeasTol; }
 
+  //! Get whether the Schur complement solves run in mixed precision.  When
+  //! enabled, the LU factorization and the triangular solves are done in
+  //! float32 and the search direction is refined back to working precision
+  //! with a few iterative refinement steps against the full-precision
+  //! system, trading factorization cost for cheap residual corrections.
+  bool MixedPrecision() const { return mixedPrecision; }
+  //! Modify whether the Schur complement solves run in mixed precision.
+  bool& MixedPrecision() { return mixedPrecision; }
+
+  //! Get the maximum number of iterative refinement steps per solve.
+  size_t RefinementSteps() const { return refinementSteps; }
+  //! Modify the maximum number of iterative refinement steps per solve.
+  size_t& RefinementSteps() { return refinementSteps; }
+
  private:
   //! Maximum number of iterations to run. Set to 0 for no limit.
   size_t maxIterations;
@@ -126,6 +140,12 @@ class PrimalDualSolver
 
   //! The tolerance required on the dual constraint required before terminating.
   double dualInfeasTol;
+
+  //! Whether the Schur complement solves run in float32 with refinement.
+  bool mixedPrecision;
+
+  //! Maximum number of iterative refinement steps per mixed-precision solve.
+  size_t refinementSteps;
 };
 
 } // namespace ens
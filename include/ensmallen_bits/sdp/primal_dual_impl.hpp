@@ -42,7 +42,9 @@ inline PrimalDualSolver::PrimalDualSolver(const size_t maxIterations,
     tau(tau),
     normXzTol(normXzTol),
     primalInfeasTol(primalInfeasTol),
-    dualInfeasTol(dualInfeasTol)
+    dualInfeasTol(dualInfeasTol),
+    mixedPrecision(false),
+    refinementSteps(3)
 {
   // Nothing to do.
 }
@@ -90,18 +92,26 @@ Alpha(const MatType& a, const MatType& dA, double tau, double& alpha)
  *
  *   AX + XA = H
  *
- * where A, H are symmetric matrices.
+ * where A, H are symmetric matrices, using a precomputed eigendecomposition
+ * A = Q diag(lambda) Q^T.  By Lemma 7.2 of [AHO98], the solution is
  *
- * TODO(stephentu): Note this method current uses arma's builtin arma::syl
- * method, which is overkill for this situation. See Lemma 7.2 of [AHO98] for
- * how to solve this Lyapunov equation using an eigenvalue decomposition of A.
+ *   X = Q ( (Q^T H Q) ./ D ) Q^T,   D_{ij} = lambda_i + lambda_j.
  *
+ * Every Lyapunov solve in one interior point iteration has the same
+ * left-hand side (the dual iterate Z), so the caller computes the
+ * eigendecomposition and the denominator matrix D once per iteration and
+ * passes them here, instead of paying for a fresh Schur decomposition on
+ * every solve.
  */
-template<typename MatType, typename AType, typename BType>
+template<typename MatType, typename EigvecType, typename DenomType,
+         typename BType>
 static inline void
-SolveLyapunov(MatType& x, const AType& a, const BType& h)
+SolveLyapunov(MatType& x,
+              const EigvecType& eigvec,
+              const DenomType& denom,
+              const BType& h)
 {
-  arma::syl(x, a, a, -h);
+  x = eigvec * ((eigvec.t() * h * eigvec) / denom) * eigvec.t();
 }
 
 /**
@@ -120,6 +130,16 @@ SolveLyapunov(MatType& x, const AType& a, const BType& h)
  *     E  = Z sym I
  *     F  = X sym I
  *
+ * The eigendecomposition of Z (zEigvec, zDenom; see SolveLyapunov()) and the
+ * LU factorization of M (mL, mU, mP) are computed once per interior point
+ * iteration by the caller and reused for both the predictor and the
+ * corrector solve.  With mixed precision the caller instead provides a
+ * float32 factorization (mLF, mUF, mPF): the triangular solves run in
+ * float32 and the result is corrected with up to refinementSteps rounds of
+ * iterative refinement against the full-precision M, each costing one
+ * matrix-vector product and two cheap triangular solves.  If both sets of
+ * factors are empty (the factorization failed), the system is solved
+ * directly from m instead.
  */
 template<typename MatType,
          typename SparseConstraintType,
@@ -127,9 +147,17 @@ template<typename MatType,
 static inline void
 SolveKKTSystem(const SparseConstraintType& aSparse,
                const DenseConstraintType& aDense,
-               const MatType& dualCoordinates,
+               const MatType& zEigvec,
+               const MatType& zDenom,
                const MatType& m,
-               const MatType& fMat,
+               const MatType& mL,
+               const MatType& mU,
+               const MatType& mP,
+               const arma::fmat& mLF,
+               const arma::fmat& mUF,
+               const arma::fmat& mPF,
+               const size_t refinementSteps,
+               const MatType& x,
                const MatType& rp,
                const MatType& rd,
                const MatType& rc,
@@ -139,14 +167,17 @@ SolveKKTSystem(const SparseConstraintType& aSparse,
                MatType& dsZ)
 {
   MatType frdRcMat, eInvFrdRcMat, eInvFrdATdyRcMat, frdATdyRcMat;
-  MatType eInvFrdRc, eInvFrdATdyRc, dy;
+  MatType eInvFrdRc, eInvFrdATdyRc, dy, frd;
 
   // Note: Whenever a formula calls for E^(-1) v for some v, we solve Lyapunov
-  // equations instead of forming an explicit inverse.
+  // equations instead of forming an explicit inverse.  Likewise, F v is
+  // applied matrix-free from X (see SymKronIdApply()) instead of forming the
+  // n2bar x n2bar operator.
 
   // Compute the RHS of (2.12)
-  math::Smat(fMat * rd - rc, frdRcMat);
-  SolveLyapunov(eInvFrdRcMat, dualCoordinates, 2. * frdRcMat);
+  math::SymKronIdApply(x, rd, frd);
+  math::Smat(frd - rc, frdRcMat);
+  SolveLyapunov(eInvFrdRcMat, zEigvec, zDenom, 2. * frdRcMat);
   math::Svec(eInvFrdRcMat, eInvFrdRc);
 
   MatType rhs = rp;
@@ -156,7 +187,40 @@ SolveKKTSystem(const SparseConstraintType& aSparse,
   if (aDense.n_rows)
     rhs(arma::span(aSparse.n_rows, numConstraints - 1), 0) += aDense * eInvFrdRc;
 
-  if (!arma::solve(dy, m, rhs, arma::solve_opts::fast))
+  if (mLF.n_elem != 0)
+  {
+    typedef typename MatType::elem_type ElemType;
+
+    // Mixed precision: the triangular solves run in float32, then the
+    // direction is refined against the full-precision M.  The residual
+    // shrinks by roughly the float32 unit roundoff per step, so a few steps
+    // recover working-precision accuracy as long as M is not too badly
+    // conditioned.
+    dy = arma::conv_to<MatType>::from(arma::fmat(
+        arma::solve(arma::trimatu(mUF), arma::fmat(
+        arma::solve(arma::trimatl(mLF), arma::fmat(
+        mPF * arma::conv_to<arma::fmat>::from(rhs)))))));
+    const ElemType rhsNorm = arma::norm(rhs, 2);
+    for (size_t step = 0; step < refinementSteps; ++step)
+    {
+      const MatType residual = rhs - m * dy;
+      if (arma::norm(residual, 2) <=
+          std::numeric_limits<ElemType>::epsilon() * (1 + rhsNorm))
+        break;
+      dy += arma::conv_to<MatType>::from(arma::fmat(
+          arma::solve(arma::trimatu(mUF), arma::fmat(
+          arma::solve(arma::trimatl(mLF), arma::fmat(
+          mPF * arma::conv_to<arma::fmat>::from(residual)))))));
+    }
+  }
+  else if (mL.n_elem != 0)
+  {
+    // Reuse the LU factorization of M computed by the caller: P M = L U, so
+    // M dy = rhs reduces to two triangular solves.
+    dy = arma::solve(arma::trimatu(mU),
+        arma::solve(arma::trimatl(mL), mP * rhs));
+  }
+  else if (!arma::solve(dy, m, rhs, arma::solve_opts::fast))
   {
     throw std::logic_error("PrimalDualSolver::SolveKKTSystem(): Could not "
         "solve KKT system.");
@@ -176,9 +240,9 @@ SolveKKTSystem(const SparseConstraintType& aSparse,
   }
 
   // Compute dx from (2.13)
-  math::Smat(fMat * (rd - subTerm) - rc,
-      frdATdyRcMat);
-  SolveLyapunov(eInvFrdATdyRcMat, dualCoordinates, 2. * frdATdyRcMat);
+  math::SymKronIdApply(x, MatType(rd - subTerm), frd);
+  math::Smat(frd - rc, frdATdyRcMat);
+  SolveLyapunov(eInvFrdATdyRcMat, zEigvec, zDenom, 2. * frdATdyRcMat);
   math::Svec(eInvFrdATdyRcMat, eInvFrdATdyRc);
   dsX = -eInvFrdATdyRc;
 
@@ -296,8 +360,10 @@ typename MatType::elem_type PrimalDualSolver::Optimize(
 
   MatType rp, rd, rc, gk;
 
-  MatType rcMat, fMat, eInvFaSparseT, eInvFaDenseT, gkMat,
-      m, dualCheck;
+  MatType rcMat, eInvFaSparseT, eInvFaDenseT, gkMat,
+      m, mL, mU, mP, zEigvec, zDenom, xQ, dualCheck;
+  arma::fmat mLF, mUF, mPF;
+  arma::Col<typename MatType::elem_type> zEigval;
 
   rp.set_size(sdp.NumConstraints(), 1);
 
@@ -333,21 +399,37 @@ typename MatType::elem_type PrimalDualSolver::Optimize(
     // Rd = C - Z - smat A^T y
     rd = sc - sz - aSparse.t() * ySparse - aDense.t() * yDense;
 
-    math::SymKronId(coordinates, fMat);
+    // Every Lyapunov solve below has the same left-hand side Z, so compute
+    // its eigendecomposition once per iteration (see SolveLyapunov()).
+    if (!arma::eig_sym(zEigval, zEigvec, dualCoordinates))
+    {
+      ENS_LOG_WARN("PrimalDualSolver::Optimize(): eigendecomposition of Z "
+          << "failed!  Terminating optimization.");
+
+      Callback::EndOptimization(*this, sdp, coordinates, callbacks...);
+      return primalObj;
+    }
+    zDenom = arma::repmat(zEigval, 1, n) + arma::repmat(zEigval.t(), n, 1);
+    xQ = coordinates * zEigvec;
 
     // We compute E^(-1) F A^T by solving Lyapunov equations.
     // See (2.16).
     for (size_t i = 0; i < sdp.NumSparseConstraints(); i++)
     {
-      SolveLyapunov(gkMat, dualCoordinates, coordinates * sdp.SparseA()[i] +
-          sdp.SparseA()[i] * coordinates);
+      // With H = X Ai + Ai X and Q the eigenvector basis of Z, we have
+      // Q^T H Q = (X Q)^T (Ai Q) + (Ai Q)^T (X Q); computing Ai Q as a
+      // sparse-dense product makes the assembly cost of each column scale
+      // with the number of nonzeros in Ai.
+      const MatType aiQ(sdp.SparseA()[i] * zEigvec);
+      gkMat = zEigvec * ((xQ.t() * aiQ + aiQ.t() * xQ) / zDenom) *
+          zEigvec.t();
       math::Svec(gkMat, gk);
       eInvFaSparseT.col(i) = gk;
     }
 
     for (size_t i = 0; i < sdp.NumDenseConstraints(); i++)
     {
-      SolveLyapunov(gkMat, dualCoordinates, coordinates * sdp.DenseA()[i] +
+      SolveLyapunov(gkMat, zEigvec, zDenom, coordinates * sdp.DenseA()[i] +
           sdp.DenseA()[i] * coordinates);
       math::Svec(gkMat, gk);
       eInvFaDenseT.col(i) = gk;
@@ -387,6 +469,38 @@ typename MatType::elem_type PrimalDualSolver::Optimize(
           aDense * eInvFaDenseT;
     }
 
+    // Factorize M once: the same system matrix is used by both the predictor
+    // and the corrector solve below.  M is not symmetric in general, so we
+    // use an LU factorization; if it fails, SolveKKTSystem() falls back to a
+    // direct solve.  With mixed precision enabled, the factorization is done
+    // in float32 and the solves are refined back to working precision; if
+    // the float32 factorization fails, we fall back to the full-precision
+    // one.
+    mLF.reset();
+    mUF.reset();
+    mPF.reset();
+    mL.reset();
+    mU.reset();
+    mP.reset();
+    bool factorized = false;
+    if (mixedPrecision)
+    {
+      factorized = arma::lu(mLF, mUF, mPF,
+          arma::conv_to<arma::fmat>::from(m));
+      if (!factorized)
+      {
+        mLF.reset();
+        mUF.reset();
+        mPF.reset();
+      }
+    }
+    if (!factorized && !arma::lu(mL, mU, mP, m))
+    {
+      mL.reset();
+      mU.reset();
+      mP.reset();
+    }
+
     const typename MatType::elem_type sxdotsz = arma::dot(sx, sz);
 
     // TODO(stephentu): computing these alphahats should take advantage of
@@ -396,7 +510,8 @@ typename MatType::elem_type PrimalDualSolver::Optimize(
     // This solves step (1) of Section 7, the "predictor" step.
     rcMat = -0.5 * (coordinates * dualCoordinates + dualCoordinates * coordinates);
     math::Svec(rcMat, rc);
-    SolveKKTSystem(aSparse, aDense, dualCoordinates, m, fMat, rp, rd, rc, dsx,
+    SolveKKTSystem(aSparse, aDense, zEigvec, zDenom, m, mL, mU, mP,
+        mLF, mUF, mPF, refinementSteps, coordinates, rp, rd, rc, dsx,
         dySparse, dyDense, dsz);
     math::Smat(dsx, dX);
     math::Smat(dsz, dZ);
@@ -405,8 +520,8 @@ typename MatType::elem_type PrimalDualSolver::Optimize(
     bool success = Alpha(coordinates, dX, tau, alpha);
     if (!success)
     {
-      Warn << "PrimalDualSolver::Optimize(): cholesky decomposition of X "
-          << "failed!  Terminating optimization.";
+      ENS_LOG_WARN("PrimalDualSolver::Optimize(): cholesky decomposition of X "
+          << "failed!  Terminating optimization.");
 
       Callback::EndOptimization(*this, sdp, coordinates, callbacks...);
       return primalObj;
@@ -415,8 +530,8 @@ typename MatType::elem_type PrimalDualSolver::Optimize(
     success = Alpha(dualCoordinates, dZ, tau, beta);
     if (!success)
     {
-      Warn << "PrimalDualSolver::Optimize(): cholesky decomposition of Z "
-          << "failed!  Terminating optimization.";
+      ENS_LOG_WARN("PrimalDualSolver::Optimize(): cholesky decomposition of Z "
+          << "failed!  Terminating optimization.");
 
       Callback::EndOptimization(*this, sdp, coordinates, callbacks...);
       return primalObj;
@@ -435,22 +550,23 @@ typename MatType::elem_type PrimalDualSolver::Optimize(
          dX * dZ +
          dZ * dX);
     math::Svec(rcMat, rc);
-    SolveKKTSystem(aSparse, aDense, dualCoordinates, m, fMat, rp, rd, rc, dsx,
+    SolveKKTSystem(aSparse, aDense, zEigvec, zDenom, m, mL, mU, mP,
+        mLF, mUF, mPF, refinementSteps, coordinates, rp, rd, rc, dsx,
         dySparse, dyDense, dsz);
     math::Smat(dsx, dX);
     math::Smat(dsz, dZ);
     if (!Alpha(coordinates, dX, tau, alpha))
     {
-      Warn << "PrimalDualSolver::Optimize(): cholesky decomposition of X "
-          << "failed!  Terminating optimization.";
+      ENS_LOG_WARN("PrimalDualSolver::Optimize(): cholesky decomposition of X "
+          << "failed!  Terminating optimization.");
 
       Callback::EndOptimization(*this, sdp, coordinates, callbacks...);
       return primalObj;
     }
     if (!Alpha(dualCoordinates, dZ, tau, beta))
     {
-      Warn << "PrimalDualSolver::Optimize(): cholesky decomposition of Z "
-          << "failed!  Terminating optimization.";
+      ENS_LOG_WARN("PrimalDualSolver::Optimize(): cholesky decomposition of Z "
+          << "failed!  Terminating optimization.");
 
       Callback::EndOptimization(*this, sdp, coordinates, callbacks...);
       return primalObj;
@@ -509,8 +625,8 @@ typename MatType::elem_type PrimalDualSolver::Optimize(
       return primalObj;
   }
 
-  Warn << "PrimalDualSolver::Optimizer(): Did not converge after "
-      << maxIterations << " iterations!" << std::endl;
+  ENS_LOG_WARN("PrimalDualSolver::Optimizer(): Did not converge after "
+      << maxIterations << " iterations!" << std::endl);
 
   Callback::EndOptimization(*this, sdp, coordinates, callbacks...);
   return primalObj;
@@ -0,0 +1,164 @@
+/**
+ * @file sdp_structure.hpp
+ * @author Stephen Tu
+ *
+ * Structure analysis preprocessing for SDPs: detection of block-diagonal
+ * and chordal aggregate sparsity.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_SDP_SDP_STRUCTURE_HPP
+#define ENSMALLEN_SDP_SDP_STRUCTURE_HPP
+
+#include "sdp.hpp"
+
+namespace ens {
+
+/**
+ * Analyze the aggregate sparsity structure of an SDP in primal form.
+ *
+ * The aggregate sparsity graph of the problem has one vertex per row of the
+ * objective matrix C and an edge for every off-diagonal nonzero appearing in
+ * C or in any constraint matrix Ai.  Two kinds of structure are detected:
+ *
+ *  - Block-diagonal structure: the connected components of the aggregate
+ *    graph, after additionally merging all vertices touched by a common
+ *    constraint (a scalar constraint dot(Ai, X) = bi couples every block it
+ *    has support in).  Each resulting block is a fully independent smaller
+ *    SDP: Split() produces the sub-problems and Recombine() reassembles a
+ *    full-size primal solution from per-block solutions.  Since the
+ *    sub-cones are smaller and interior point costs grow cubically in the
+ *    cone size, solving the blocks separately can be orders of magnitude
+ *    cheaper than solving the original cone.
+ *
+ *  - Chordal structure: IsChordal() reports whether the aggregate graph is
+ *    chordal (checked with maximum cardinality search), which tells the
+ *    caller that a clique-tree decomposition of the PSD constraint exists.
+ *    The conversion itself (splitting one cone into overlapping clique
+ *    cones coupled by equality constraints) is not performed here, because
+ *    the solvers in this module operate on a single cone.
+ *
+ * A typical use with PrimalDualSolver:
+ *
+ * @code
+ * SDPStructure<SDP<arma::sp_mat>> structure(sdp);
+ * if (structure.Decomposable())
+ * {
+ *   std::vector<SDP<arma::sp_mat>> blocks = structure.Split();
+ *   // ... solve each block, collecting the primal solutions ...
+ *   structure.Recombine(blockSolutions, X);
+ * }
+ * @endcode
+ *
+ * The analyzed SDP is held by reference and must outlive this object.
+ *
+ * @tparam SDPType The SDP problem type (an instantiation of SDP<...>).
+ */
+template<typename SDPType>
+class SDPStructure
+{
+ public:
+  /**
+   * Analyze the given SDP.  The constructor performs the full structure
+   * analysis: one pass over the nonzeros of C and every constraint matrix
+   * for the block detection, and a maximum cardinality search over the
+   * aggregate graph for the chordality check.
+   *
+   * @param sdp The SDP to analyze (held by reference).
+   */
+  SDPStructure(const SDPType& sdp);
+
+  //! Return the number of independent blocks in the aggregate structure.
+  size_t NumBlocks() const { return blocks.size(); }
+
+  //! Return the vertex index sets of the blocks, in ascending order of
+  //! their smallest vertex; indices within a block are sorted.
+  const std::vector<arma::uvec>& Blocks() const { return blocks; }
+
+  //! Return whether the SDP splits into more than one independent block.
+  bool Decomposable() const { return blocks.size() > 1; }
+
+  //! Return whether the aggregate sparsity graph is chordal (always true
+  //! for dense aggregate patterns, which are complete graphs).
+  bool IsChordal() const { return chordal; }
+
+  /**
+   * Split the analyzed SDP into one independent sub-SDP per block.  Each
+   * constraint of the original problem has support inside exactly one block
+   * (this is what the block merging guarantees) and is assigned to that
+   * block's sub-problem; objective and constraint matrices are restricted
+   * to the block's rows and columns.
+   *
+   * @return One SDP per block, ordered as in Blocks().
+   */
+  std::vector<SDPType> Split() const;
+
+  /**
+   * Assemble a full-size primal solution from per-block solutions: entries
+   * inside each block are filled from the corresponding block solution, and
+   * all entries outside the blocks (which do not appear in the objective or
+   * any constraint) are zero.
+   *
+   * @param blockX Primal solutions of the sub-SDPs, ordered as in Blocks().
+   * @param X Output full-size primal matrix.
+   */
+  template<typename MatType>
+  void Recombine(const std::vector<MatType>& blockX, MatType& X) const;
+
+ private:
+  /**
+   * Apply the given functor to every structural nonzero of the matrix
+   * (sparse overload).
+   */
+  template<typename MatrixType, typename FuncType>
+  static typename std::enable_if<
+      arma::is_arma_sparse_type<MatrixType>::value, void>::type
+  ForEachNonzero(const MatrixType& m, FuncType f);
+
+  //! Dense overload of ForEachNonzero().
+  template<typename MatrixType, typename FuncType>
+  static typename std::enable_if<
+      !arma::is_arma_sparse_type<MatrixType>::value, void>::type
+  ForEachNonzero(const MatrixType& m, FuncType f);
+
+  /**
+   * Restrict a matrix to the rows and columns of the given block (sparse
+   * overload; the result is built by batch insertion).
+   */
+  template<typename MatrixType>
+  typename std::enable_if<
+      arma::is_arma_sparse_type<MatrixType>::value, MatrixType>::type
+  Extract(const MatrixType& m, const size_t block) const;
+
+  //! Dense overload of Extract().
+  template<typename MatrixType>
+  typename std::enable_if<
+      !arma::is_arma_sparse_type<MatrixType>::value, MatrixType>::type
+  Extract(const MatrixType& m, const size_t block) const;
+
+  //! Run the maximum cardinality search chordality test on the aggregate
+  //! graph given as adjacency sets.
+  static bool CheckChordal(const std::vector<std::set<size_t>>& adjacency);
+
+  //! The analyzed SDP.
+  const SDPType& sdp;
+
+  //! Vertex index sets of the detected blocks.
+  std::vector<arma::uvec> blocks;
+  //! Block index of each vertex.
+  arma::uvec blockOf;
+  //! Index of each vertex within its block.
+  arma::uvec localIndex;
+  //! Whether the aggregate sparsity graph is chordal.
+  bool chordal;
+};
+
+} // namespace ens
+
+// Include implementation.
+#include "sdp_structure_impl.hpp"
+
+#endif
@@ -0,0 +1,340 @@
+/**
+ * @file sdp_structure_impl.hpp
+ * @author Stephen Tu
+ *
+ * Implementation of the SDP structure analysis.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_SDP_SDP_STRUCTURE_IMPL_HPP
+#define ENSMALLEN_SDP_SDP_STRUCTURE_IMPL_HPP
+
+#include "sdp_structure.hpp"
+
+namespace ens {
+
+template<typename SDPType>
+SDPStructure<SDPType>::SDPStructure(const SDPType& sdp) :
+    sdp(sdp),
+    chordal(true)
+{
+  typedef typename SDPType::ElemType ElemType;
+
+  const size_t n = sdp.N();
+  blockOf.set_size(n);
+  localIndex.set_size(n);
+  if (n == 0)
+    return;
+
+  // Union-find with path halving over the vertices of the aggregate graph.
+  std::vector<size_t> parent(n);
+  for (size_t i = 0; i < n; ++i)
+    parent[i] = i;
+  auto find = [&parent](size_t v)
+  {
+    while (parent[v] != v)
+    {
+      parent[v] = parent[parent[v]];
+      v = parent[v];
+    }
+    return v;
+  };
+  auto unite = [&parent, &find](const size_t a, const size_t b)
+  {
+    parent[find(a)] = find(b);
+  };
+
+  // Adjacency sets of the aggregate sparsity graph, for the chordality
+  // check below.
+  std::vector<std::set<size_t>> adjacency(n);
+  auto addEntry = [&](const size_t r, const size_t c)
+  {
+    if (r == c)
+      return;
+    unite(r, c);
+    adjacency[r].insert(c);
+    adjacency[c].insert(r);
+  };
+
+  ForEachNonzero(sdp.C(),
+      [&](const size_t r, const size_t c, const ElemType /* value */)
+      {
+        addEntry(r, c);
+      });
+
+  // For constraints, additionally merge every touched vertex into one
+  // component: a scalar constraint dot(Ai, X) = bi couples every block it
+  // has support in, even when its pattern has no cross-block entries.
+  for (size_t i = 0; i < sdp.NumSparseConstraints(); ++i)
+  {
+    size_t anchor = n;
+    ForEachNonzero(sdp.SparseA()[i],
+        [&](const size_t r, const size_t c, const ElemType /* value */)
+        {
+          addEntry(r, c);
+          if (anchor == n)
+            anchor = r;
+          unite(anchor, r);
+          unite(anchor, c);
+        });
+  }
+  for (size_t i = 0; i < sdp.NumDenseConstraints(); ++i)
+  {
+    size_t anchor = n;
+    ForEachNonzero(sdp.DenseA()[i],
+        [&](const size_t r, const size_t c, const ElemType /* value */)
+        {
+          addEntry(r, c);
+          if (anchor == n)
+            anchor = r;
+          unite(anchor, r);
+          unite(anchor, c);
+        });
+  }
+
+  // Assign block ids in order of first appearance, so that blocks are
+  // ordered by their smallest vertex and indices within a block ascend.
+  std::vector<size_t> rootBlock(n, n);
+  size_t numBlocks = 0;
+  for (size_t v = 0; v < n; ++v)
+  {
+    const size_t root = find(v);
+    if (rootBlock[root] == n)
+      rootBlock[root] = numBlocks++;
+    blockOf(v) = rootBlock[root];
+  }
+
+  std::vector<size_t> counts(numBlocks, 0);
+  for (size_t v = 0; v < n; ++v)
+    localIndex(v) = counts[blockOf(v)]++;
+
+  blocks.resize(numBlocks);
+  for (size_t b = 0; b < numBlocks; ++b)
+    blocks[b].set_size(counts[b]);
+  for (size_t v = 0; v < n; ++v)
+    blocks[blockOf(v)](localIndex(v)) = v;
+
+  chordal = CheckChordal(adjacency);
+}
+
+template<typename SDPType>
+std::vector<SDPType> SDPStructure<SDPType>::Split() const
+{
+  typedef typename SDPType::ElemType ElemType;
+
+  // A constraint belongs to the block of its first structural nonzero (the
+  // block merging in the constructor guarantees all of its support lies in
+  // that block); constraints with no nonzeros at all go to block 0.
+  const size_t numBlocks = blocks.size();
+  std::vector<size_t> sparseCount(numBlocks, 0), denseCount(numBlocks, 0);
+  std::vector<size_t> sparseBlock(sdp.NumSparseConstraints(), 0);
+  std::vector<size_t> denseBlock(sdp.NumDenseConstraints(), 0);
+
+  for (size_t i = 0; i < sdp.NumSparseConstraints(); ++i)
+  {
+    bool found = false;
+    ForEachNonzero(sdp.SparseA()[i],
+        [&](const size_t r, const size_t /* c */, const ElemType /* value */)
+        {
+          if (!found)
+          {
+            sparseBlock[i] = blockOf(r);
+            found = true;
+          }
+        });
+    ++sparseCount[sparseBlock[i]];
+  }
+  for (size_t i = 0; i < sdp.NumDenseConstraints(); ++i)
+  {
+    bool found = false;
+    ForEachNonzero(sdp.DenseA()[i],
+        [&](const size_t r, const size_t /* c */, const ElemType /* value */)
+        {
+          if (!found)
+          {
+            denseBlock[i] = blockOf(r);
+            found = true;
+          }
+        });
+    ++denseCount[denseBlock[i]];
+  }
+
+  std::vector<SDPType> result;
+  result.reserve(numBlocks);
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    result.emplace_back(blocks[b].n_elem, sparseCount[b], denseCount[b]);
+    result[b].C() = Extract(sdp.C(), b);
+  }
+
+  std::vector<size_t> sparseCursor(numBlocks, 0), denseCursor(numBlocks, 0);
+  for (size_t i = 0; i < sdp.NumSparseConstraints(); ++i)
+  {
+    const size_t b = sparseBlock[i];
+    result[b].SparseA()[sparseCursor[b]] = Extract(sdp.SparseA()[i], b);
+    result[b].SparseB()[sparseCursor[b]] = sdp.SparseB()[i];
+    ++sparseCursor[b];
+  }
+  for (size_t i = 0; i < sdp.NumDenseConstraints(); ++i)
+  {
+    const size_t b = denseBlock[i];
+    result[b].DenseA()[denseCursor[b]] = Extract(sdp.DenseA()[i], b);
+    result[b].DenseB()[denseCursor[b]] = sdp.DenseB()[i];
+    ++denseCursor[b];
+  }
+
+  return result;
+}
+
+template<typename SDPType>
+template<typename MatType>
+void SDPStructure<SDPType>::Recombine(const std::vector<MatType>& blockX,
+                                      MatType& X) const
+{
+  X.zeros(blockOf.n_elem, blockOf.n_elem);
+  for (size_t b = 0; b < blocks.size(); ++b)
+    X.submat(blocks[b], blocks[b]) = blockX[b];
+}
+
+template<typename SDPType>
+template<typename MatrixType, typename FuncType>
+typename std::enable_if<
+    arma::is_arma_sparse_type<MatrixType>::value, void>::type
+SDPStructure<SDPType>::ForEachNonzero(const MatrixType& m, FuncType f)
+{
+  for (typename MatrixType::const_iterator it = m.begin(); it != m.end();
+      ++it)
+    f(it.row(), it.col(), *it);
+}
+
+template<typename SDPType>
+template<typename MatrixType, typename FuncType>
+typename std::enable_if<
+    !arma::is_arma_sparse_type<MatrixType>::value, void>::type
+SDPStructure<SDPType>::ForEachNonzero(const MatrixType& m, FuncType f)
+{
+  typedef typename MatrixType::elem_type ElemType;
+  for (size_t c = 0; c < m.n_cols; ++c)
+    for (size_t r = 0; r < m.n_rows; ++r)
+      if (m(r, c) != ElemType(0))
+        f(r, c, m(r, c));
+}
+
+template<typename SDPType>
+template<typename MatrixType>
+typename std::enable_if<
+    arma::is_arma_sparse_type<MatrixType>::value, MatrixType>::type
+SDPStructure<SDPType>::Extract(const MatrixType& m, const size_t block) const
+{
+  typedef typename MatrixType::elem_type ElemType;
+
+  // Count the surviving entries, then build the block by batch insertion.
+  size_t count = 0;
+  ForEachNonzero(m,
+      [&](const size_t r, const size_t c, const ElemType /* value */)
+      {
+        if (blockOf(r) == block && blockOf(c) == block)
+          ++count;
+      });
+
+  arma::umat locations(2, count);
+  arma::Col<ElemType> values(count);
+  size_t pos = 0;
+  ForEachNonzero(m,
+      [&](const size_t r, const size_t c, const ElemType value)
+      {
+        if (blockOf(r) == block && blockOf(c) == block)
+        {
+          locations(0, pos) = localIndex(r);
+          locations(1, pos) = localIndex(c);
+          values(pos) = value;
+          ++pos;
+        }
+      });
+
+  return MatrixType(locations, values, blocks[block].n_elem,
+      blocks[block].n_elem);
+}
+
+template<typename SDPType>
+template<typename MatrixType>
+typename std::enable_if<
+    !arma::is_arma_sparse_type<MatrixType>::value, MatrixType>::type
+SDPStructure<SDPType>::Extract(const MatrixType& m, const size_t block) const
+{
+  return m.submat(blocks[block], blocks[block]);
+}
+
+template<typename SDPType>
+bool SDPStructure<SDPType>::CheckChordal(
+    const std::vector<std::set<size_t>>& adjacency)
+{
+  const size_t n = adjacency.size();
+
+  // Maximum cardinality search: repeatedly number the unnumbered vertex
+  // with the most numbered neighbors.  Buckets of vertices keyed by that
+  // count keep the search linear in the number of edges.
+  std::vector<size_t> weight(n, 0);
+  std::vector<bool> numbered(n, false);
+  std::vector<std::set<size_t>> buckets(n + 1);
+  for (size_t v = 0; v < n; ++v)
+    buckets[0].insert(v);
+
+  // Elimination position of each vertex; MCS numbers from the back, and
+  // the graph is chordal iff the resulting ordering is a perfect
+  // elimination ordering.
+  std::vector<size_t> order(n);
+  size_t maxWeight = 0;
+  for (size_t step = n; step > 0; --step)
+  {
+    while (buckets[maxWeight].empty())
+      --maxWeight;
+    const size_t v = *buckets[maxWeight].begin();
+    buckets[maxWeight].erase(buckets[maxWeight].begin());
+    numbered[v] = true;
+    order[v] = step - 1;
+
+    for (const size_t u : adjacency[v])
+    {
+      if (numbered[u])
+        continue;
+      buckets[weight[u]].erase(u);
+      ++weight[u];
+      buckets[weight[u]].insert(u);
+    }
+    if (maxWeight < n)
+      ++maxWeight;
+  }
+
+  // Perfect elimination check: for every vertex, all of its later-ordered
+  // neighbors except the earliest must be adjacent to that earliest one.
+  for (size_t v = 0; v < n; ++v)
+  {
+    size_t follower = n;
+    for (const size_t u : adjacency[v])
+    {
+      if (order[u] > order[v] &&
+          (follower == n || order[u] < order[follower]))
+        follower = u;
+    }
+    if (follower == n)
+      continue;
+
+    for (const size_t u : adjacency[v])
+    {
+      if (u == follower || order[u] <= order[v])
+        continue;
+      if (adjacency[follower].count(u) == 0)
+        return false;
+    }
+  }
+
+  return true;
+}
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,152 @@
+/**
+ * @file cosine_annealing.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the cosine annealing decay policy (the schedule of SGDR,
+ * without the restarts).
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef ENSMALLEN_SGD_DECAY_POLICIES_COSINE_ANNEALING_HPP
+#define ENSMALLEN_SGD_DECAY_POLICIES_COSINE_ANNEALING_HPP
+
+namespace ens {
+
+/**
+ * Cosine annealing: the step size follows half a cosine wave from its
+ * configured value down to a minimum over a fixed number of iterations, and
+ * stays at the minimum afterwards.  This is the annealing schedule of SGDR
+ * without the warm restarts (for the restarting variant, use the SGDR
+ * optimizer).
+ *
+ * For more information, please refer to:
+ *
+ * @code
+ * @article{Loshchilov2016,
+ *   author  = {Ilya Loshchilov and Frank Hutter},
+ *   title   = {{SGDR:} Stochastic Gradient Descent with Restarts},
+ *   journal = {CoRR},
+ *   year    = {2016},
+ *   url     = {https://arxiv.org/abs/1608.03983}
+ * }
+ * @endcode
+ */
+class CosineAnnealing
+{
+ public:
+  /**
+   * Construct the cosine annealing decay policy.
+   *
+   * @param annealIterations Number of iterations to anneal over.
+   * @param minStepSize Step size reached at the end of the annealing.
+   */
+  CosineAnnealing(const size_t annealIterations,
+                  const double minStepSize = 0.0) :
+      annealIterations(annealIterations),
+      minStepSize(minStepSize)
+  { /* Nothing to do here */ }
+
+  //! Get the number of iterations to anneal over.
+  size_t AnnealIterations() const { return annealIterations; }
+  //! Modify the number of iterations to anneal over.
+  size_t& AnnealIterations() { return annealIterations; }
+
+  //! Get the final step size.
+  double MinStepSize() const { return minStepSize; }
+  //! Modify the final step size.
+  double& MinStepSize() { return minStepSize; }
+
+  /**
+   * The DecayPolicyType policy classes must contain an internal 'Policy'
+   * template class with two template arguments: MatType and GradType.  This is
+   * initialized at the start of the optimization, and holds parameters specific
+   * to an individual optimization.
+   */
+  template<typename MatType, typename GradType>
+  class Policy
+  {
+   public:
+    /**
+     * This constructor is called by the SGD Optimize() method before the start
+     * of the iteration update process.
+     */
+    Policy(CosineAnnealing& parent) :
+        parent(parent),
+        iteration(0),
+        initialStepSize(0)
+    { /* Nothing to do here */ }
+
+    /**
+     * This function is called in each iteration after the policy update.
+     *
+     * @param iterate Parameters that minimize the function.
+     * @param stepSize Step size to be used for the given iteration.
+     * @param gradient The gradient matrix.
+     */
+    void Update(MatType& /* iterate */,
+                double& stepSize,
+                const GradType& /* gradient */)
+    {
+      Anneal(stepSize);
+    }
+
+    /**
+     * This function is called in each iteration after the SVRG update step.
+     *
+     * @param iterate Parameters that minimize the function.
+     * @param iterate0 The last function parameters at time t - 1.
+     * @param gradient The current gradient matrix at time t.
+     * @param fullGradient The computed full gradient.
+     * @param stepSize Step size to be used for the given iteration.
+     */
+    void Update(const MatType& /* iterate */,
+                const MatType& /* iterate0 */,
+                const GradType& /* gradient */,
+                const GradType& /* fullGradient */,
+                const size_t /* numBatches */,
+                double& stepSize)
+    {
+      Anneal(stepSize);
+    }
+
+   private:
+    //! Apply the cosine schedule to the given step size; the schedule is
+    //! absolute against the step size captured on the first call, so it does
+    //! not compound.
+    void Anneal(double& stepSize)
+    {
+      if (iteration == 0)
+        initialStepSize = stepSize;
+
+      const double progress = std::min((double) ++iteration /
+          (double) parent.AnnealIterations(), 1.0);
+      stepSize = parent.MinStepSize() +
+          0.5 * (initialStepSize - parent.MinStepSize()) *
+          (1.0 + std::cos(arma::datum::pi * progress));
+    }
+
+    //! Reference to the parent policy, carrying the schedule parameters.
+    CosineAnnealing& parent;
+
+    //! The number of iterations performed so far.
+    size_t iteration;
+
+    //! The step size the annealing starts from.
+    double initialStepSize;
+  };
+
+ private:
+  //! The number of iterations to anneal over.
+  size_t annealIterations;
+
+  //! The final step size.
+  double minStepSize;
+};
+
+} // namespace ens
+
+#endif // ENSMALLEN_SGD_DECAY_POLICIES_COSINE_ANNEALING_HPP
@@ -0,0 +1,192 @@
+/**
+ * @file linear_warmup.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the linear warmup decay policy, optionally wrapping another
+ * decay policy that takes over once the warmup is finished.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef ENSMALLEN_SGD_DECAY_POLICIES_LINEAR_WARMUP_HPP
+#define ENSMALLEN_SGD_DECAY_POLICIES_LINEAR_WARMUP_HPP
+
+#include "no_decay.hpp"
+
+namespace ens {
+
+/**
+ * Linear step-size warmup: the step size ramps linearly from a fraction of
+ * the configured step size up to its full value over a fixed number of
+ * iterations.  After the warmup the wrapped decay policy (NoDecay by
+ * default) takes over, so warmup composes with any other schedule, e.g.
+ * LinearWarmup<CosineAnnealing>.  Warming up avoids the instability of large
+ * steps on freshly initialized parameters.
+ *
+ * For more information, please refer to:
+ *
+ * @code
+ * @article{Goyal2017,
+ *   author  = {Priya Goyal and Piotr Doll{\'a}r and Ross B. Girshick and
+ *              Pieter Noordhuis and Lukasz Wesolowski and Aapo Kyrola and
+ *              Andrew Tulloch and Yangqing Jia and Kaiming He},
+ *   title   = {Accurate, Large Minibatch {SGD:} Training ImageNet in 1 Hour},
+ *   journal = {CoRR},
+ *   year    = {2017},
+ *   url     = {https://arxiv.org/abs/1706.02677}
+ * }
+ * @endcode
+ *
+ * @tparam DecayPolicyType The decay policy applied after the warmup.
+ */
+template<typename DecayPolicyType = NoDecay>
+class LinearWarmup
+{
+ public:
+  /**
+   * Construct the linear warmup decay policy.
+   *
+   * @param warmupIterations Number of iterations to ramp over.
+   * @param startFraction Fraction of the configured step size the ramp
+   *     starts from.
+   * @param decayPolicy Instantiated decay policy applied after the warmup.
+   */
+  LinearWarmup(const size_t warmupIterations = 1000,
+               const double startFraction = 0.1,
+               const DecayPolicyType& decayPolicy = DecayPolicyType()) :
+      warmupIterations(warmupIterations),
+      startFraction(startFraction),
+      decayPolicy(decayPolicy)
+  { /* Nothing to do here */ }
+
+  //! Get the number of warmup iterations.
+  size_t WarmupIterations() const { return warmupIterations; }
+  //! Modify the number of warmup iterations.
+  size_t& WarmupIterations() { return warmupIterations; }
+
+  //! Get the fraction of the step size the ramp starts from.
+  double StartFraction() const { return startFraction; }
+  //! Modify the fraction of the step size the ramp starts from.
+  double& StartFraction() { return startFraction; }
+
+  //! Get the decay policy applied after the warmup.
+  const DecayPolicyType& DecayPolicy() const { return decayPolicy; }
+  //! Modify the decay policy applied after the warmup.
+  DecayPolicyType& DecayPolicy() { return decayPolicy; }
+
+  /**
+   * The DecayPolicyType policy classes must contain an internal 'Policy'
+   * template class with two template arguments: MatType and GradType.  This is
+   * initialized at the start of the optimization, and holds parameters specific
+   * to an individual optimization.
+   */
+  template<typename MatType, typename GradType>
+  class Policy
+  {
+   public:
+    /**
+     * This constructor is called by the SGD Optimize() method before the start
+     * of the iteration update process.
+     */
+    Policy(LinearWarmup<DecayPolicyType>& parent) :
+        parent(parent),
+        instDecayPolicy(parent.DecayPolicy()),
+        iteration(0),
+        fullStepSize(0)
+    { /* Nothing to do here */ }
+
+    /**
+     * This function is called in each iteration after the policy update.
+     *
+     * @param iterate Parameters that minimize the function.
+     * @param stepSize Step size to be used for the given iteration.
+     * @param gradient The gradient matrix.
+     */
+    void Update(MatType& iterate,
+                double& stepSize,
+                const GradType& gradient)
+    {
+      if (iteration < parent.WarmupIterations())
+      {
+        // The configured step size is captured on the first call; the ramp
+        // is computed against it so that the schedule is absolute and does
+        // not compound.
+        if (iteration == 0)
+          fullStepSize = stepSize;
+
+        const double fraction = parent.StartFraction() +
+            (1.0 - parent.StartFraction()) *
+            ((double) ++iteration / (double) parent.WarmupIterations());
+        stepSize = fraction * fullStepSize;
+      }
+      else
+      {
+        instDecayPolicy.Update(iterate, stepSize, gradient);
+      }
+    }
+
+    /**
+     * This function is called in each iteration after the SVRG update step.
+     *
+     * @param iterate Parameters that minimize the function.
+     * @param iterate0 The last function parameters at time t - 1.
+     * @param gradient The current gradient matrix at time t.
+     * @param fullGradient The computed full gradient.
+     * @param stepSize Step size to be used for the given iteration.
+     */
+    void Update(const MatType& iterate,
+                const MatType& iterate0,
+                const GradType& gradient,
+                const GradType& fullGradient,
+                const size_t numBatches,
+                double& stepSize)
+    {
+      if (iteration < parent.WarmupIterations())
+      {
+        if (iteration == 0)
+          fullStepSize = stepSize;
+
+        const double fraction = parent.StartFraction() +
+            (1.0 - parent.StartFraction()) *
+            ((double) ++iteration / (double) parent.WarmupIterations());
+        stepSize = fraction * fullStepSize;
+      }
+      else
+      {
+        instDecayPolicy.Update(iterate, iterate0, gradient, fullGradient,
+            numBatches, stepSize);
+      }
+    }
+
+   private:
+    //! Reference to the parent policy, carrying the schedule parameters.
+    LinearWarmup<DecayPolicyType>& parent;
+
+    //! The instantiated decay policy applied after the warmup.
+    typename DecayPolicyType::template Policy<MatType, GradType>
+        instDecayPolicy;
+
+    //! The number of warmup iterations performed so far.
+    size_t iteration;
+
+    //! The configured step size the ramp leads up to.
+    double fullStepSize;
+  };
+
+ private:
+  //! The number of iterations to ramp over.
+  size_t warmupIterations;
+
+  //! The fraction of the step size the ramp starts from.
+  double startFraction;
+
+  //! The decay policy applied after the warmup.
+  DecayPolicyType decayPolicy;
+};
+
+} // namespace ens
+
+#endif // ENSMALLEN_SGD_DECAY_POLICIES_LINEAR_WARMUP_HPP
@@ -0,0 +1,120 @@
+/**
+ * @file step_decay.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the step decay policy, which drops the step size by a
+ * constant factor at fixed iteration intervals.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef ENSMALLEN_SGD_DECAY_POLICIES_STEP_DECAY_HPP
+#define ENSMALLEN_SGD_DECAY_POLICIES_STEP_DECAY_HPP
+
+namespace ens {
+
+/**
+ * Step decay: every `decayInterval` iterations the step size is multiplied
+ * by `decayFactor`, producing the classic staircase schedule.  Between drops
+ * the update is a counter increment; no per-iteration coefficient is
+ * computed.
+ */
+class StepDecay
+{
+ public:
+  /**
+   * Construct the step decay policy.
+   *
+   * @param decayInterval Number of iterations between drops.
+   * @param decayFactor Factor the step size is multiplied by at each drop.
+   */
+  StepDecay(const size_t decayInterval = 10000,
+            const double decayFactor = 0.1) :
+      decayInterval(decayInterval),
+      decayFactor(decayFactor)
+  { /* Nothing to do here */ }
+
+  //! Get the number of iterations between drops.
+  size_t DecayInterval() const { return decayInterval; }
+  //! Modify the number of iterations between drops.
+  size_t& DecayInterval() { return decayInterval; }
+
+  //! Get the factor applied at each drop.
+  double DecayFactor() const { return decayFactor; }
+  //! Modify the factor applied at each drop.
+  double& DecayFactor() { return decayFactor; }
+
+  /**
+   * The DecayPolicyType policy classes must contain an internal 'Policy'
+   * template class with two template arguments: MatType and GradType.  This is
+   * initialized at the start of the optimization, and holds parameters specific
+   * to an individual optimization.
+   */
+  template<typename MatType, typename GradType>
+  class Policy
+  {
+   public:
+    /**
+     * This constructor is called by the SGD Optimize() method before the start
+     * of the iteration update process.
+     */
+    Policy(StepDecay& parent) : parent(parent), iteration(0)
+    { /* Nothing to do here */ }
+
+    /**
+     * This function is called in each iteration after the policy update.
+     *
+     * @param iterate Parameters that minimize the function.
+     * @param stepSize Step size to be used for the given iteration.
+     * @param gradient The gradient matrix.
+     */
+    void Update(MatType& /* iterate */,
+                double& stepSize,
+                const GradType& /* gradient */)
+    {
+      if (++iteration % parent.DecayInterval() == 0)
+        stepSize *= parent.DecayFactor();
+    }
+
+    /**
+     * This function is called in each iteration after the SVRG update step.
+     *
+     * @param iterate Parameters that minimize the function.
+     * @param iterate0 The last function parameters at time t - 1.
+     * @param gradient The current gradient matrix at time t.
+     * @param fullGradient The computed full gradient.
+     * @param stepSize Step size to be used for the given iteration.
+     */
+    void Update(const MatType& /* iterate */,
+                const MatType& /* iterate0 */,
+                const GradType& /* gradient */,
+                const GradType& /* fullGradient */,
+                const size_t /* numBatches */,
+                double& stepSize)
+    {
+      if (++iteration % parent.DecayInterval() == 0)
+        stepSize *= parent.DecayFactor();
+    }
+
+   private:
+    //! Reference to the parent policy, carrying the schedule parameters.
+    StepDecay& parent;
+
+    //! The number of iterations performed so far.
+    size_t iteration;
+  };
+
+ private:
+  //! The number of iterations between drops.
+  size_t decayInterval;
+
+  //! The factor applied at each drop.
+  double decayFactor;
+};
+
+} // namespace ens
+
+#endif // ENSMALLEN_SGD_DECAY_POLICIES_STEP_DECAY_HPP
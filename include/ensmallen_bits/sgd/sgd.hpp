@@ -19,7 +19,15 @@
 #include "update_policies/momentum_update.hpp"
 #include "update_policies/nesterov_momentum_update.hpp"
 #include "decay_policies/no_decay.hpp"
+#include "decay_policies/linear_warmup.hpp"
+#include "decay_policies/cosine_annealing.hpp"
+#include "decay_policies/step_decay.hpp"
+#include "decay_policies/one_cycle.hpp"
 #include "update_policies/quasi_hyperbolic_update.hpp"
+#include "update_policies/proximal_update.hpp"
+#include "visitation_policies/shuffle_visitation.hpp"
+#include "visitation_policies/stride_visitation.hpp"
+#include "visitation_policies/block_shuffle_visitation.hpp"
 
 namespace ens {
 
@@ -62,9 +70,16 @@ namespace ens {
  * @tparam DecayPolicyType Decay policy used during the iterative update
  *     process to adjust the step size. By default the step size isn't going to
  *     be adjusted (i.e. NoDecay is used).
+ * @tparam VisitationPolicyType Policy that determines the order in which
+ *     batches are visited in each epoch when shuffling is enabled.  The
+ *     default (ShuffleVisitation) calls the function's Shuffle() method at
+ *     the start of every epoch; StrideVisitation instead generates a
+ *     pseudo-random batch order on the fly without any shuffle or
+ *     permutation vector.
  */
 template<typename UpdatePolicyType = VanillaUpdate,
-         typename DecayPolicyType = NoDecay>
+         typename DecayPolicyType = NoDecay,
+         typename VisitationPolicyType = ShuffleVisitation>
 class SGD
 {
  public:
@@ -124,7 +139,8 @@ class SGD
            typename MatType,
            typename GradType,
            typename... CallbackTypes>
-  typename std::enable_if<IsArmaType<GradType>::value,
+  typename std::enable_if<
+      IsArmaType<GradType>::value || IsCootType<GradType>::value,
       typename MatType::elem_type>::type
   Optimize(SeparableFunctionType& function,
            MatType& iterate,
@@ -134,15 +150,126 @@ class SGD
   template<typename SeparableFunctionType,
            typename MatType,
            typename... CallbackTypes>
-  typename MatType::elem_type Optimize(SeparableFunctionType& function,
-                                       MatType& iterate,
-                                       CallbackTypes&&... callbacks)
+  typename std::enable_if<!IsDenseSubviewType<MatType>::value,
+      typename MatType::elem_type>::type
+  Optimize(SeparableFunctionType& function,
+           MatType& iterate,
+           CallbackTypes&&... callbacks)
   {
     return Optimize<SeparableFunctionType, MatType, MatType,
         CallbackTypes...>(function, iterate,
         std::forward<CallbackTypes>(callbacks)...);
   }
 
+  /**
+   * Optimize with the iterate stored in a dense subview of a larger matrix
+   * (e.g. one model's slice of a shared parameter block).  Contiguous views
+   * (full-height column blocks and single-column segments) are optimized
+   * fully in place through a zero-copy alias, so no element of the parameter
+   * block is ever duplicated; strided views pay one copy-in/copy-out per
+   * Optimize() call rather than one per iteration.
+   *
+   * @tparam SeparableFunctionType Type of the function to be optimized.
+   * @tparam MatType Dense Armadillo subview type (deduced).
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to optimize.
+   * @param iterate View of the starting point (updated in place).
+   * @param callbacks Callback functions.
+   * @return Objective value of the final point.
+   */
+  template<typename SeparableFunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename std::enable_if<
+      IsDenseSubviewType<typename std::remove_reference<MatType>::type>::value,
+      typename std::remove_reference<MatType>::type::elem_type>::type
+  Optimize(SeparableFunctionType& function,
+           MatType&& iterate,
+           CallbackTypes&&... callbacks)
+  {
+    typedef typename std::remove_reference<MatType>::type::elem_type ElemType;
+
+    SubviewAdapter<ElemType> adapter(iterate);
+    return Optimize<SeparableFunctionType, arma::Mat<ElemType>,
+        arma::Mat<ElemType>, CallbackTypes...>(function, adapter.Matrix(),
+        std::forward<CallbackTypes>(callbacks)...);
+  }
+
+  /**
+   * Prepare the optimizer for externally-driven stepping: run the traits
+   * checks, instantiate the update and decay policies for the given matrix
+   * type, and allocate the internal gradient buffer.  After this call,
+   * Step() performs only the bare update work, which makes it suitable for
+   * streaming systems that take one optimizer step per arriving event
+   * without re-entering Optimize().
+   *
+   * Calling Optimize() afterwards is fine; it continues from the same
+   * policy state (subject to ResetPolicy()).
+   *
+   * @tparam SeparableFunctionType Type of the function to be optimized.
+   * @tparam MatType Type of matrix to optimize with.
+   * @tparam GradType Type of matrix to use to represent function gradients.
+   * @param function Function to optimize.
+   * @param iterate Starting point (not modified by this call).
+   */
+  template<typename SeparableFunctionType,
+           typename MatType,
+           typename GradType = MatType>
+  void Initialize(SeparableFunctionType& function, MatType& iterate);
+
+  /**
+   * Take a single update step on the given batch range: evaluate the batch
+   * gradient at the iterate, apply the update policy and then the decay
+   * policy.  The caller owns the loop---no epoch bookkeeping, shuffling,
+   * tolerance checks or callbacks happen here, so the per-call cost is just
+   * the gradient evaluation plus the policy update.
+   *
+   * Initialize() should be called once beforehand; if it was not, the first
+   * Step() call transparently pays the initialization cost.
+   *
+   * @tparam SeparableFunctionType Type of the function to be optimized.
+   * @tparam MatType Type of matrix to optimize with.
+   * @tparam GradType Type of matrix to use to represent function gradients.
+   * @param function Function to optimize.
+   * @param iterate Current point (will be modified).
+   * @param begin Index of the first function of the batch.
+   * @param batchSize Number of functions in the batch.
+   * @return Objective value of the batch before the step.
+   */
+  template<typename SeparableFunctionType,
+           typename MatType,
+           typename GradType = MatType>
+  typename MatType::elem_type Step(SeparableFunctionType& function,
+                                   MatType& iterate,
+                                   const size_t begin,
+                                   const size_t batchSize);
+
+  /**
+   * Write the instantiated update-policy state to the given stream in binary
+   * format, so a later run can resume exactly where this one left off.  The
+   * update policy must provide Serialize() on its instantiated Policy class
+   * (VanillaUpdate, MomentumUpdate and AdamUpdate do).  Returns false if no
+   * policy has been instantiated for the given types yet (i.e. Optimize() has
+   * not been called).
+   *
+   * @param stream Stream which receives the serialized state.
+   */
+  template<typename MatType, typename GradType = MatType>
+  bool SaveState(std::ostream& stream);
+
+  /**
+   * Restore the instantiated update-policy state from the given stream, as
+   * written by SaveState().  The policy is instantiated for the given matrix
+   * dimensions and ResetPolicy() is set to false, so the next Optimize() call
+   * continues from the restored state instead of reinitializing it.
+   *
+   * @param stream Stream holding the serialized state.
+   * @param rows Number of rows in the parameter matrix.
+   * @param cols Number of columns in the parameter matrix.
+   */
+  template<typename MatType, typename GradType = MatType>
+  bool LoadState(std::istream& stream, const size_t rows, const size_t cols);
+
   //! Get the step size.
   double StepSize() const { return stepSize; }
   //! Modify the step size.
@@ -173,6 +300,28 @@ class SGD
   //! Modify whether or not the actual objective is calculated.
   bool& ExactObjective() { return exactObjective; }
 
+  //! Get the number of mini-batches accumulated into each update step.
+  size_t AccumulationSteps() const { return accumulationSteps; }
+  //! Modify the number of mini-batches accumulated into each update step.
+  //! Values greater than 1 enable "macro-batch" mode: that many mini-batch
+  //! gradients are summed into one update, with the callbacks and the decay
+  //! policy invoked only once per accumulated step.
+  size_t& AccumulationSteps() { return accumulationSteps; }
+
+  //! Get the fraction of the iteration budget covered by Polyak-Ruppert tail
+  //! averaging (0 disables averaging).
+  double TailFraction() const { return tailFraction; }
+  //! Modify the tail averaging fraction.  A value f in (0, 1] returns the
+  //! average of the iterates from the last f * MaxIterations() iterations
+  //! instead of the last iterate.  The average is kept implicitly in a
+  //! lazily-scaled representation (avg = alpha * w + b * iterate), so each
+  //! step only costs one scaled gradient addition and two scalar updates;
+  //! the average is materialized once when the optimization ends.  The
+  //! representation folds the gradient step into the average directly, so
+  //! it is exact for gradient-proportional updates (VanillaUpdate); it also
+  //! requires MaxIterations() > 0 to locate the tail.
+  double& TailFraction() { return tailFraction; }
+
   //! Get whether or not the update policy parameters
   //! are reset before Optimize call.
   bool ResetPolicy() const { return resetPolicy; }
@@ -197,6 +346,12 @@ class SGD
   //! Modify the step size decay policy.
   DecayPolicyType& DecayPolicy() { return decayPolicy; }
 
+  //! Get the visitation policy.
+  const VisitationPolicyType& VisitationPolicy() const
+  { return visitationPolicy; }
+  //! Modify the visitation policy.
+  VisitationPolicyType& VisitationPolicy() { return visitationPolicy; }
+
   //! Get the instantiated decay policy type.  Be sure to check its type with
   //! Has() before using!
   const Any& InstDecayPolicy() const { return instDecayPolicy; }
@@ -204,7 +359,43 @@ class SGD
   //! Has() before using!
   Any& InstDecayPolicy() { return instDecayPolicy; }
 
+  //! Get the workspace holding the optimizer's internal gradient buffers.
+  //! The buffers persist across Optimize() calls, so repeated optimizations
+  //! of same-sized problems perform no internal heap allocations.
+  const ens::Workspace& Workspace() const { return workspace; }
+  //! Modify the workspace holding the optimizer's internal gradient buffers.
+  ens::Workspace& Workspace() { return workspace; }
+
  private:
+  /**
+   * The iteration loop of Optimize(), specialized at compile time on whether
+   * every step processes exactly one sample.  When StreamingMode is true,
+   * the per-step batch bookkeeping---the effective-batch-size clamping, the
+   * batch-size scaling of the visitation index and the gradient-accumulation
+   * machinery---reduces to compile-time constants and is folded away by the
+   * compiler, which matters at the step rates of single-sample online
+   * learning.  Optimize() selects the specialization from BatchSize() and
+   * AccumulationSteps(); the two instantiations behave identically.
+   *
+   * @tparam StreamingMode If true, every step covers exactly one sample.
+   * @tparam SeparableFunctionType Type of the function to be optimized.
+   * @tparam MatType Type of matrix to optimize with.
+   * @tparam GradType Type of matrix to use to represent function gradients.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to optimize.
+   * @param iterateIn Starting point (will be modified).
+   * @param callbacks Callback functions.
+   * @return Objective value of the final point.
+   */
+  template<bool StreamingMode,
+           typename SeparableFunctionType,
+           typename MatType,
+           typename GradType,
+           typename... CallbackTypes>
+  typename MatType::elem_type OptimizeLoop(SeparableFunctionType& function,
+                                           MatType& iterateIn,
+                                           CallbackTypes&&... callbacks);
+
   //! The step size for each example.
   double stepSize;
 
@@ -224,12 +415,23 @@ class SGD
   //! Controls whether or not the actual Objective value is calculated.
   bool exactObjective;
 
+  //! Number of mini-batches folded into each update step (1 disables
+  //! accumulation).
+  size_t accumulationSteps;
+
+  //! Fraction of the iteration budget averaged by Polyak-Ruppert tail
+  //! averaging (0 disables averaging).
+  double tailFraction;
+
   //! The update policy used to update the parameters in each iteration.
   UpdatePolicyType updatePolicy;
 
   //! The decay policy used to update the step size.
   DecayPolicyType decayPolicy;
 
+  //! The policy that determines the batch visitation order in each epoch.
+  VisitationPolicyType visitationPolicy;
+
   //! Flag indicating whether update policy
   //! should be reset before running optimization.
   bool resetPolicy;
@@ -242,6 +444,9 @@ class SGD
   Any instUpdatePolicy;
   //! The initialized decay policy.
   Any instDecayPolicy;
+
+  //! Reusable buffers for the optimization's internal state.
+  ens::Workspace workspace;
 };
 
 using StandardSGD = SGD<VanillaUpdate>;
@@ -21,8 +21,10 @@
 
 namespace ens {
 
-template<typename UpdatePolicyType, typename DecayPolicyType>
-SGD<UpdatePolicyType, DecayPolicyType>::SGD(
+template<typename UpdatePolicyType,
+         typename DecayPolicyType,
+         typename VisitationPolicyType>
+SGD<UpdatePolicyType, DecayPolicyType, VisitationPolicyType>::SGD(
     const double stepSize,
     const size_t batchSize,
     const size_t maxIterations,
@@ -38,41 +40,188 @@ SGD<UpdatePolicyType, DecayPolicyType>::SGD(
     tolerance(tolerance),
     shuffle(shuffle),
     exactObjective(exactObjective),
+    accumulationSteps(1),
+    tailFraction(0.0),
     updatePolicy(updatePolicy),
     decayPolicy(decayPolicy),
     resetPolicy(resetPolicy),
     isInitialized(false)
 { /* Nothing to do. */ }
 
-template<typename UpdatePolicyType, typename DecayPolicyType>
-SGD<UpdatePolicyType, DecayPolicyType>::~SGD()
+template<typename UpdatePolicyType,
+         typename DecayPolicyType,
+         typename VisitationPolicyType>
+SGD<UpdatePolicyType, DecayPolicyType, VisitationPolicyType>::~SGD()
 {
   // Clean decay and update policies, if they were initialized.
   instDecayPolicy.Clean();
   instUpdatePolicy.Clean();
 }
 
+//! Serialize the instantiated update-policy state.
+template<typename UpdatePolicyType,
+         typename DecayPolicyType,
+         typename VisitationPolicyType>
+template<typename MatType, typename GradType>
+bool SGD<UpdatePolicyType, DecayPolicyType, VisitationPolicyType>::SaveState(
+    std::ostream& stream)
+{
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef typename MatTypeTraits<GradType>::BaseMatType BaseGradType;
+  typedef typename UpdatePolicyType::template Policy<BaseMatType, BaseGradType>
+      InstUpdatePolicyType;
+
+  if (!instUpdatePolicy.Has<InstUpdatePolicyType>())
+    return false;
+
+  instUpdatePolicy.As<InstUpdatePolicyType>().Serialize(stream);
+  return stream.good();
+}
+
+//! Restore the instantiated update-policy state.
+template<typename UpdatePolicyType,
+         typename DecayPolicyType,
+         typename VisitationPolicyType>
+template<typename MatType, typename GradType>
+bool SGD<UpdatePolicyType, DecayPolicyType, VisitationPolicyType>::LoadState(
+    std::istream& stream, const size_t rows, const size_t cols)
+{
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef typename MatTypeTraits<GradType>::BaseMatType BaseGradType;
+  typedef typename UpdatePolicyType::template Policy<BaseMatType, BaseGradType>
+      InstUpdatePolicyType;
+
+  instUpdatePolicy.Emplace<InstUpdatePolicyType>(updatePolicy, rows, cols);
+  instUpdatePolicy.As<InstUpdatePolicyType>().Deserialize(stream);
+  isInitialized = true;
+
+  // The restored state must survive the next Optimize() call.
+  resetPolicy = false;
+
+  return stream.good();
+}
+
+//! Prepare the optimizer for externally-driven stepping.
+template<typename UpdatePolicyType,
+         typename DecayPolicyType,
+         typename VisitationPolicyType>
+template<typename SeparableFunctionType,
+         typename MatType,
+         typename GradType>
+void SGD<UpdatePolicyType, DecayPolicyType, VisitationPolicyType>::Initialize(
+    SeparableFunctionType& function,
+    MatType& iterateIn)
+{
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef typename MatTypeTraits<GradType>::BaseMatType BaseGradType;
+
+  typedef Function<SeparableFunctionType, BaseMatType, BaseGradType>
+      FullFunctionType;
+  FullFunctionType& f(static_cast<FullFunctionType&>(function));
+  (void) f;
+
+  typedef typename UpdatePolicyType::template Policy<BaseMatType, BaseGradType>
+      InstUpdatePolicyType;
+  typedef typename DecayPolicyType::template Policy<BaseMatType, BaseGradType>
+      InstDecayPolicyType;
+
+  // Make sure we have all the methods that we need.
+  traits::CheckSeparableFunctionTypeAPI<FullFunctionType, BaseMatType,
+      BaseGradType>();
+  RequireFloatingPointType<BaseMatType>();
+  RequireFloatingPointType<BaseGradType>();
+  RequireSameInternalTypes<BaseMatType, BaseGradType>();
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+
+  // Initialize the decay policy if needed.
+  if (!isInitialized || !instDecayPolicy.Has<InstDecayPolicyType>())
+    instDecayPolicy.Emplace<InstDecayPolicyType>(decayPolicy);
+
+  // Initialize the update policy.
+  if (resetPolicy || !isInitialized ||
+      !instUpdatePolicy.Has<InstUpdatePolicyType>())
+  {
+    instUpdatePolicy.Emplace<InstUpdatePolicyType>(updatePolicy,
+        iterate.n_rows, iterate.n_cols);
+    isInitialized = true;
+  }
+
+  // Allocate the gradient buffer now, so Step() never allocates.
+  workspace.Get<BaseGradType>(0, iterate.n_rows, iterate.n_cols);
+}
+
+//! Take a single externally-driven update step.
+template<typename UpdatePolicyType,
+         typename DecayPolicyType,
+         typename VisitationPolicyType>
+template<typename SeparableFunctionType,
+         typename MatType,
+         typename GradType>
+typename MatType::elem_type
+SGD<UpdatePolicyType, DecayPolicyType, VisitationPolicyType>::Step(
+    SeparableFunctionType& function,
+    MatType& iterateIn,
+    const size_t begin,
+    const size_t batchSize)
+{
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef typename MatTypeTraits<GradType>::BaseMatType BaseGradType;
+
+  typedef Function<SeparableFunctionType, BaseMatType, BaseGradType>
+      FullFunctionType;
+  FullFunctionType& f(static_cast<FullFunctionType&>(function));
+
+  typedef typename UpdatePolicyType::template Policy<BaseMatType, BaseGradType>
+      InstUpdatePolicyType;
+  typedef typename DecayPolicyType::template Policy<BaseMatType, BaseGradType>
+      InstDecayPolicyType;
+
+  // Pay the setup cost on the first call if Initialize() was skipped.
+  if (!isInitialized || !instUpdatePolicy.Has<InstUpdatePolicyType>() ||
+      !instDecayPolicy.Has<InstDecayPolicyType>())
+    Initialize<SeparableFunctionType, MatType, GradType>(function, iterateIn);
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+  BaseGradType& gradient = workspace.Get<BaseGradType>(0, iterate.n_rows,
+      iterate.n_cols);
+
+  const ElemType objective = f.EvaluateWithGradient(iterate, begin, gradient,
+      batchSize);
+
+  instUpdatePolicy.As<InstUpdatePolicyType>().Update(iterate, stepSize,
+      gradient);
+  instDecayPolicy.As<InstDecayPolicyType>().Update(iterate, stepSize,
+      gradient);
+
+  return objective;
+}
+
 //! Optimize the function (minimize).
-template<typename UpdatePolicyType, typename DecayPolicyType>
+template<typename UpdatePolicyType,
+         typename DecayPolicyType,
+         typename VisitationPolicyType>
 template<typename SeparableFunctionType,
          typename MatType,
          typename GradType,
          typename... CallbackTypes>
-typename std::enable_if<IsArmaType<GradType>::value,
+typename std::enable_if<
+    IsArmaType<GradType>::value || IsCootType<GradType>::value,
 typename MatType::elem_type>::type
-SGD<UpdatePolicyType, DecayPolicyType>::Optimize(
+SGD<UpdatePolicyType, DecayPolicyType, VisitationPolicyType>::Optimize(
     SeparableFunctionType& function,
     MatType& iterateIn,
     CallbackTypes&&... callbacks)
 {
   // Convenience typedefs.
-  typedef typename MatType::elem_type ElemType;
   typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
   typedef typename MatTypeTraits<GradType>::BaseMatType BaseGradType;
 
   typedef Function<SeparableFunctionType, BaseMatType, BaseGradType>
       FullFunctionType;
   FullFunctionType& f(static_cast<FullFunctionType&>(function));
+  (void) f;
 
   // The update policy and decay policy internally use a templated class so that
   // we can know MatType and GradType only when Optimize() is called.
@@ -90,80 +239,237 @@ SGD<UpdatePolicyType, DecayPolicyType>::Optimize(
 
   BaseMatType& iterate = (BaseMatType&) iterateIn;
 
-  // Find the number of functions to use.
+  // Initialize the decay policy if needed.
+  if (!isInitialized || !instDecayPolicy.Has<InstDecayPolicyType>())
+    instDecayPolicy.Emplace<InstDecayPolicyType>(decayPolicy);
+
+  // Initialize the update policy.
+  if (resetPolicy || !isInitialized ||
+      !instUpdatePolicy.Has<InstUpdatePolicyType>())
+  {
+    instUpdatePolicy.Emplace<InstUpdatePolicyType>(updatePolicy,
+        iterate.n_rows, iterate.n_cols);
+    isInitialized = true;
+  }
+
+  // Select the loop specialization: when every step is a single sample, the
+  // batch bookkeeping in the loop reduces to compile-time constants and the
+  // compiler folds it away (see OptimizeLoop()).
+  if (batchSize == 1 && accumulationSteps == 1)
+  {
+    return OptimizeLoop<true, SeparableFunctionType, MatType, GradType>(
+        function, iterateIn, std::forward<CallbackTypes>(callbacks)...);
+  }
+
+  return OptimizeLoop<false, SeparableFunctionType, MatType, GradType>(
+      function, iterateIn, std::forward<CallbackTypes>(callbacks)...);
+}
+
+//! The compile-time-specialized iteration loop of Optimize().
+template<typename UpdatePolicyType,
+         typename DecayPolicyType,
+         typename VisitationPolicyType>
+template<bool StreamingMode,
+         typename SeparableFunctionType,
+         typename MatType,
+         typename GradType,
+         typename... CallbackTypes>
+typename MatType::elem_type
+SGD<UpdatePolicyType, DecayPolicyType, VisitationPolicyType>::OptimizeLoop(
+    SeparableFunctionType& function,
+    MatType& iterateIn,
+    CallbackTypes&&... callbacks)
+{
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef typename MatTypeTraits<GradType>::BaseMatType BaseGradType;
+
+  typedef Function<SeparableFunctionType, BaseMatType, BaseGradType>
+      FullFunctionType;
+  FullFunctionType& f(static_cast<FullFunctionType&>(function));
+
+  typedef typename UpdatePolicyType::template Policy<BaseMatType, BaseGradType>
+      InstUpdatePolicyType;
+  typedef typename DecayPolicyType::template Policy<BaseMatType, BaseGradType>
+      InstDecayPolicyType;
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+
+  // Find the number of functions to use, and the number of batches that make
+  // up one epoch.  In streaming mode every sample is its own batch.
   const size_t numFunctions = f.NumFunctions();
+  const size_t numBatches = StreamingMode ? numFunctions :
+      (numFunctions + batchSize - 1) / batchSize;
 
   // To keep track of where we are and how things are going.
-  size_t currentFunction = 0;
+  size_t currentBatch = 0;
   size_t epoch = 1;
   ElemType overallObjective = 0;
   ElemType lastObjective = DBL_MAX;
+  // The epoch objective is a sum over every batch; compensated accumulation
+  // keeps it accurate even for low-precision element types.
+  KahanAccumulator<ElemType> objectiveSum;
 
   // Controls early termination of the optimization process.
   bool terminate = false;
 
-  // Initialize the decay policy if needed.
-  if (!isInitialized || !instDecayPolicy.Has<InstDecayPolicyType>())
-  {
-    instDecayPolicy.Clean();
-    instDecayPolicy.Set<InstDecayPolicyType>(
-        new InstDecayPolicyType(decayPolicy));
-  }
+  // Resolve the concrete policy types once, so the typeid check in As<T>()
+  // stays out of the hot loop below.  (Optimize() instantiated them before
+  // dispatching here.)
+  InstUpdatePolicyType& instUpdate =
+      instUpdatePolicy.As<InstUpdatePolicyType>();
+  InstDecayPolicyType& instDecay = instDecayPolicy.As<InstDecayPolicyType>();
+
+  // Now iterate!  The gradient buffers live in the workspace so that
+  // repeated Optimize() calls reuse the same allocations.
+  BaseGradType& gradient = workspace.Get<BaseGradType>(0, iterate.n_rows,
+      iterate.n_cols);
+  // When accumulating multiple mini-batches into one step, we need a second
+  // preallocated buffer to receive each extra mini-batch gradient.  (The
+  // reference trivially aliases `gradient` when accumulation is disabled,
+  // since the buffer is never touched in that case.)
+  BaseGradType& subGradient = (accumulationSteps > 1) ?
+      workspace.Get<BaseGradType>(1, iterate.n_rows, iterate.n_cols) :
+      gradient;
+  const size_t actualMaxIterations = (maxIterations == 0) ?
+      std::numeric_limits<size_t>::max() : maxIterations;
 
-  // Initialize the update policy.
-  if (resetPolicy || !isInitialized ||
-      !instUpdatePolicy.Has<InstUpdatePolicyType>())
+  // Polyak-Ruppert tail averaging bookkeeping (see TailFraction()).  The
+  // running average is represented implicitly as
+  //
+  //   avg = avgAlpha * avgW + avgB * iterate,
+  //
+  // so folding a step into the average costs one scaled gradient addition
+  // and two scalar updates instead of a full parameter-vector pass; the
+  // average is only materialized once, when the optimization ends.
+  const size_t averagingStart = (tailFraction > 0.0 && maxIterations > 0) ?
+      (size_t) ((1.0 - tailFraction) * actualMaxIterations) :
+      std::numeric_limits<size_t>::max();
+  size_t averagedCount = 0;
+  double avgAlpha = 1.0, avgB = 1.0;
+  BaseMatType avgW;
+  auto materializeAverage = [&]()
   {
-    instUpdatePolicy.Clean();
-    instUpdatePolicy.Set<InstUpdatePolicyType>(
-        new InstUpdatePolicyType(updatePolicy, iterate.n_rows, iterate.n_cols));
-    isInitialized = true;
-  }
+    if (averagedCount > 1)
+      iterate = (ElemType) avgAlpha * avgW + (ElemType) avgB * iterate;
+  };
 
-  // Now iterate!
-  BaseGradType gradient(iterate.n_rows, iterate.n_cols);
-  const size_t actualMaxIterations = (maxIterations == 0) ?
-      std::numeric_limits<size_t>::max() : maxIterations;
   Callback::BeginOptimization(*this, f, iterate, callbacks...);
   terminate |= Callback::BeginEpoch(*this, f, iterate, epoch,
       overallObjective, callbacks...);
   for (size_t i = 0; i < actualMaxIterations && !terminate;
       /* incrementing done manually */)
   {
-    // Find the effective batch size; we have to take the minimum of three
-    // things:
-    // - the batch size can't be larger than the user-specified batch size;
-    // - the batch size can't be larger than the number of iterations left
-    //       before actualMaxIterations is hit;
-    // - the batch size can't be larger than the number of functions left.
-    const size_t effectiveBatchSize = std::min(
+    // Map the epoch-local batch counter through the visitation policy to
+    // find where this batch starts; then find the effective batch size, which
+    // can't be larger than the user-specified batch size, the number of
+    // iterations left before actualMaxIterations is hit, or the number of
+    // functions after the batch's starting point.  In streaming mode the
+    // batch index is the sample index and every step has size one, so both
+    // computations disappear at compile time.
+    const size_t begin = StreamingMode ? visitationPolicy.Batch(currentBatch) :
+        visitationPolicy.Batch(currentBatch) * batchSize;
+    const size_t effectiveBatchSize = StreamingMode ? 1 : std::min(
         std::min(batchSize, actualMaxIterations - i),
-        numFunctions - currentFunction);
+        numFunctions - begin);
+
+    // Announce the batch that will be visited after this one, so functions
+    // backed by slow storage can overlap loading it with the computation
+    // below (via the optional PrefetchBatch() method; for functions without
+    // it, this call is a no-op).  The hint is skipped at the epoch boundary,
+    // where a reshuffle makes the next range unknown.
+    if (currentBatch + 1 < numBatches)
+    {
+      const size_t nextBegin = StreamingMode ?
+          visitationPolicy.Batch(currentBatch + 1) :
+          visitationPolicy.Batch(currentBatch + 1) * batchSize;
+      f.PrefetchBatch(nextBegin, StreamingMode ? 1 :
+          std::min(batchSize, numFunctions - nextBegin));
+    }
 
     // Technically we are computing the objective before we take the step, but
     // for many FunctionTypes it may be much quicker to do it like this.
-    const ElemType objective = f.EvaluateWithGradient(iterate, currentFunction,
-        gradient, effectiveBatchSize);
-    overallObjective += objective;
+    ElemType objective = f.EvaluateWithGradient(iterate, begin, gradient,
+        effectiveBatchSize);
+    size_t stepSamples = effectiveBatchSize;
+    size_t stepBatches = 1;
+
+    // In macro-batch mode, fold additional mini-batches into this step.  We
+    // stop at the epoch boundary so that epoch bookkeeping (and the shuffle)
+    // stays intact; the per-batch callback and decay invocations are skipped
+    // and only issued once below for the whole accumulated step.  Streaming
+    // mode never accumulates, so there the loop is compiled out entirely.
+    for (size_t k = 1; !StreamingMode && k < accumulationSteps; ++k)
+    {
+      if ((currentBatch + stepBatches >= numBatches) ||
+          (i + stepSamples >= actualMaxIterations))
+        break;
+
+      const size_t subBegin =
+          visitationPolicy.Batch(currentBatch + stepBatches) * batchSize;
+      const size_t subBatchSize = std::min(
+          std::min(batchSize, actualMaxIterations - i - stepSamples),
+          numFunctions - subBegin);
+
+      // Keep the prefetch pipeline one batch ahead of the accumulation.
+      if (currentBatch + stepBatches + 1 < numBatches)
+      {
+        const size_t nextBegin =
+            visitationPolicy.Batch(currentBatch + stepBatches + 1) * batchSize;
+        f.PrefetchBatch(nextBegin, std::min(batchSize,
+            numFunctions - nextBegin));
+      }
+
+      objective += f.EvaluateWithGradient(iterate, subBegin, subGradient,
+          subBatchSize);
+      gradient += subGradient;
+      stepSamples += subBatchSize;
+      ++stepBatches;
+    }
+
+    objectiveSum.Add(objective);
+    overallObjective = objectiveSum.Sum();
 
     terminate |= Callback::EvaluateWithGradient(*this, f, iterate, objective,
         gradient, callbacks...);
 
     // Use the update policy to take a step.
-    instUpdatePolicy.As<InstUpdatePolicyType>().Update(iterate, stepSize,
-        gradient);
+    instUpdate.Update(iterate, stepSize, gradient);
+
+    // Fold the step into the lazily-scaled tail average.  The coefficient
+    // update reconstructs the pre-step iterate from the gradient, which is
+    // exact whenever the policy's step is -stepSize * gradient (the vanilla
+    // update); for other policies the average is an approximation.
+    if (i >= averagingStart)
+    {
+      if (averagedCount == 0)
+      {
+        // The average so far is just the current iterate.
+        avgW.zeros(iterate.n_rows, iterate.n_cols);
+        avgAlpha = 1.0;
+        avgB = 1.0;
+      }
+      else
+      {
+        const double mu = 1.0 / (double) (averagedCount + 1);
+        avgW += (ElemType) (avgB * stepSize / avgAlpha) * gradient;
+        avgAlpha *= (1.0 - mu);
+        avgB = (1.0 - mu) * avgB + mu;
+      }
+      ++averagedCount;
+    }
 
     terminate |= Callback::StepTaken(*this, f, iterate, callbacks...);
 
     // Now update the learning rate if requested by the user.
-    instDecayPolicy.As<InstDecayPolicyType>().Update(iterate, stepSize,
-        gradient);
+    instDecay.Update(iterate, stepSize, gradient);
 
-    i += effectiveBatchSize;
-    currentFunction += effectiveBatchSize;
+    i += stepSamples;
+    currentBatch += stepBatches;
 
     // Is this iteration the start of a sequence?
-    if ((currentFunction % numFunctions) == 0)
+    if (currentBatch == numBatches)
     {
       terminate |= Callback::EndEpoch(*this, f, iterate, epoch++,
           overallObjective / (ElemType) numFunctions, callbacks...);
@@ -186,6 +492,7 @@ SGD<UpdatePolicyType, DecayPolicyType>::Optimize(
         Info << "SGD: minimized within tolerance " << tolerance << "; "
             << "terminating optimization." << std::endl;
 
+        materializeAverage();
         Callback::EndOptimization(*this, f, iterate, callbacks...);
         return overallObjective;
       }
@@ -196,10 +503,11 @@ SGD<UpdatePolicyType, DecayPolicyType>::Optimize(
       // Reset the counter variables.
       lastObjective = overallObjective;
       overallObjective = 0;
-      currentFunction = 0;
+      objectiveSum.Reset();
+      currentBatch = 0;
 
       if (shuffle) // Determine order of visitation.
-        f.Shuffle();
+        visitationPolicy.StartEpoch(f, numBatches);
     }
   }
 
@@ -209,20 +517,26 @@ SGD<UpdatePolicyType, DecayPolicyType>::Optimize(
         << "terminating optimization." << std::endl;
   }
 
+  // Replace the final iterate with the tail average (if averaging was on).
+  materializeAverage();
+
   // Calculate final objective if exactObjective is set to true.
   if (exactObjective)
   {
-    overallObjective = 0;
+    // Hand the whole schedule to the function in one call, so functions that
+    // implement EvaluateBatch() can pipeline the pass internally.
+    std::vector<std::pair<size_t, size_t>> schedule;
+    schedule.reserve((numFunctions + batchSize - 1) / batchSize);
     for (size_t i = 0; i < numFunctions; i += batchSize)
-    {
-      const size_t effectiveBatchSize = std::min(batchSize, numFunctions - i);
-      const ElemType objective = f.Evaluate(iterate, i, effectiveBatchSize);
-      overallObjective += objective;
+      schedule.push_back(std::make_pair(i,
+          std::min(batchSize, numFunctions - i)));
 
-      // The optimization is over, so it doesn't matter what the callback
-      // returns.
-      (void) Callback::Evaluate(*this, f, iterate, objective, callbacks...);
-    }
+    overallObjective = f.EvaluateBatch(iterate, schedule);
+
+    // The optimization is over, so it doesn't matter what the callback
+    // returns.
+    (void) Callback::Evaluate(*this, f, iterate, overallObjective,
+        callbacks...);
   }
 
   Callback::EndOptimization(*this, f, iterate, callbacks...);
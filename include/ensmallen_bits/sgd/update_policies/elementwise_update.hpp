@@ -0,0 +1,83 @@
+/**
+ * @file elementwise_update.hpp
+ * @author Marcus Edel
+ *
+ * A CRTP base class that turns a per-element update rule into a single fused
+ * traversal over the parameter memory.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_SGD_UPDATE_POLICIES_ELEMENTWISE_UPDATE_HPP
+#define ENSMALLEN_SGD_UPDATE_POLICIES_ELEMENTWISE_UPDATE_HPP
+
+namespace ens {
+
+/**
+ * Many of the small adaptive update policies (AdaGrad, AdaDelta, Yogi, and
+ * friends) are purely elementwise: the new value of each parameter depends
+ * only on the old value, the gradient element, and the policy state elements
+ * at the same position.  Expressed as chained Armadillo expressions, each
+ * step performs several full passes over the parameter memory and
+ * materializes hidden temporaries, so on models whose state does not fit in
+ * cache, every pass pays the full memory bandwidth cost again.
+ *
+ * ElementwiseUpdate lets an instantiated policy express its rule once, per
+ * element, and generates the single fused loop over the iterate, the
+ * gradient, and any number of state matrices.  The derived policy defines a
+ * public Apply() method of the form
+ *
+ * @code
+ * template<typename StateElemType>
+ * double Apply(const double stepSize, const double x, const double g,
+ *              StateElemType& state1, ...);
+ * @endcode
+ *
+ * which receives the forwarded step scalar, the current parameter value x,
+ * the gradient element g, and mutable references to the corresponding state
+ * elements, and returns the new parameter value.  Per-step scalars (bias
+ * corrections, bound values, and so on) should be computed once in Update()
+ * and either folded into the forwarded step scalar or stored in the policy
+ * before calling Elementwise().
+ *
+ * @tparam DerivedType The instantiated policy class defining Apply().
+ */
+template<typename DerivedType>
+class ElementwiseUpdate
+{
+ public:
+  /**
+   * Run the derived policy's per-element rule over every parameter in a
+   * single traversal.
+   *
+   * @param iterate Parameters that minimize the function.
+   * @param stepSize Step scalar, forwarded unchanged to Apply().
+   * @param gradient The gradient matrix.
+   * @param state State matrices traversed alongside the iterate; each must
+   *     have the same number of elements as the iterate.
+   */
+  template<typename MatType, typename GradType, typename... StateTypes>
+  void Elementwise(MatType& iterate,
+                   const double stepSize,
+                   const GradType& gradient,
+                   StateTypes&... state)
+  {
+    typedef typename MatType::elem_type ElemType;
+    typedef typename GradType::elem_type GradElemType;
+
+    DerivedType& self = static_cast<DerivedType&>(*this);
+    ElemType* iterateIt = iterate.memptr();
+    const GradElemType* gradientIt = gradient.memptr();
+    for (arma::uword i = 0; i < iterate.n_elem; ++i)
+    {
+      iterateIt[i] = (ElemType) self.Apply(stepSize, (double) iterateIt[i],
+          (double) gradientIt[i], state.memptr()[i]...);
+    }
+  }
+};
+
+} // namespace ens
+
+#endif
@@ -83,7 +83,9 @@ class GradientClipping
         parent(parent),
         instPolicy(parent.UpdatePolicy(), rows, cols)
     {
-      // Nothing to do.
+      // Allocate the buffer for the clipped gradient once, so the update step
+      // below does not allocate during the optimization.
+      clippedGradient.set_size(rows, cols);
     }
 
     /**
@@ -100,8 +102,8 @@ class GradientClipping
     {
       typedef typename GradType::elem_type GradElemType;
 
-      // First, clip the gradient.
-      GradType clippedGradient = arma::clamp(gradient,
+      // First, clip the gradient into the preallocated buffer.
+      clippedGradient = arma::clamp(gradient,
           GradElemType(parent.minGradient),
           GradElemType(parent.maxGradient));
 
@@ -114,6 +116,8 @@ class GradientClipping
     const GradientClipping<UpdatePolicyType>& parent;
     // The instantiated update policy we will use.
     typename UpdatePolicyType::template Policy<MatType, GradType> instPolicy;
+    // Preallocated buffer for the clipped gradient.
+    GradType clippedGradient;
   };
 
  private:
@@ -0,0 +1,140 @@
+/**
+ * @file gradient_norm_clipping.hpp
+ * @author Marcus Edel
+ *
+ * Gradient norm clipping update wrapper.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_SGD_GRADIENT_NORM_CLIPPING_HPP
+#define ENSMALLEN_SGD_GRADIENT_NORM_CLIPPING_HPP
+
+namespace ens {
+
+/**
+ * Interface for wrapping around update policies (e.g., VanillaUpdate)
+ * and feeding a norm-clipped gradient to them instead of the normal one:
+ * if the L2-norm of the gradient exceeds 'maxNorm', the gradient is rescaled
+ * so that its norm is exactly 'maxNorm', otherwise it is passed through
+ * unchanged.
+ *
+ * This does the same rescaling as the GradClipByNorm callback, but as part of
+ * the update step itself: the gradient is read once to compute the norm and,
+ * in the common case where no clipping is needed, handed to the wrapped
+ * policy without being copied.  When clipping does trigger, the scaled
+ * gradient is written into a buffer that is allocated once per optimization,
+ * not once per step.  Prefer this wrapper over the callback when the update
+ * step dominates the iteration cost.
+ *
+ * @tparam UpdatePolicy A type of UpdatePolicy that should be wrapped around.
+ */
+template<typename UpdatePolicyType>
+class GradientNormClipping
+{
+ public:
+  /**
+   * Constructor for creating a GradientNormClipping instance.
+   *
+   * @param maxNorm Maximum allowed L2-norm of the gradient.
+   * @param updatePolicy An instance of the UpdatePolicyType
+   *                     used for actual optimization.
+   */
+  GradientNormClipping(const double maxNorm,
+                       UpdatePolicyType& updatePolicy) :
+      maxNorm(maxNorm),
+      updatePolicy(updatePolicy)
+  {
+    // Nothing to do here.
+  }
+
+  //! Get the update policy.
+  UpdatePolicyType& UpdatePolicy() const { return updatePolicy; }
+  //! Modify the update policy.
+  UpdatePolicyType& UpdatePolicy() { return updatePolicy; }
+
+  //! Get the maximum gradient norm.
+  double MaxNorm() const { return maxNorm; }
+  //! Modify the maximum gradient norm.
+  double& MaxNorm() { return maxNorm; }
+
+  /**
+   * The UpdatePolicyType policy classes must contain an internal 'Policy'
+   * template class with two template arguments: MatType and GradType.  This is
+   * instantiated at the start of the optimization, and holds parameters
+   * specific to an individual optimization.
+   */
+  template<typename MatType, typename GradType>
+  class Policy
+  {
+   public:
+    /**
+     * This is called by the optimizer method before the start of the iteration
+     * update process.
+     *
+     * @param parent Instantiated parent class.
+     * @param rows Number of rows in the gradient matrix.
+     * @param cols Number of columns in the gradient matrix.
+     */
+    Policy(const GradientNormClipping<UpdatePolicyType>& parent,
+           const size_t rows,
+           const size_t cols) :
+        parent(parent),
+        instPolicy(parent.UpdatePolicy(), rows, cols)
+    {
+      // Allocate the buffer for the rescaled gradient once, so the clipping
+      // branch below does not allocate during the optimization.
+      clippedGradient.set_size(rows, cols);
+    }
+
+    /**
+     * Update step.  If the gradient norm exceeds the maximum, the gradient is
+     * rescaled into the preallocated buffer; either way, the actual update
+     * policy then does whatever update it needs to do.
+     *
+     * @param iterate Parameters that minimize the function.
+     * @param stepSize Step size to be used for the given iteration.
+     * @param gradient The gradient matrix.
+     */
+    void Update(MatType& iterate,
+                const double stepSize,
+                const GradType& gradient)
+    {
+      typedef typename GradType::elem_type GradElemType;
+
+      const double norm = arma::norm(gradient, 2);
+      if (norm > parent.maxNorm && norm > 0.0)
+      {
+        clippedGradient = gradient *
+            GradElemType(parent.maxNorm / norm);
+        instPolicy.Update(iterate, stepSize, clippedGradient);
+      }
+      else
+      {
+        // No clipping needed; hand the gradient through without a copy.
+        instPolicy.Update(iterate, stepSize, gradient);
+      }
+    }
+
+   private:
+    // The instantiated parent class.
+    const GradientNormClipping<UpdatePolicyType>& parent;
+    // The instantiated update policy we will use.
+    typename UpdatePolicyType::template Policy<MatType, GradType> instPolicy;
+    // Preallocated buffer for the rescaled gradient.
+    GradType clippedGradient;
+  };
+
+ private:
+  //! Maximum allowed L2-norm of the gradient.
+  double maxNorm;
+
+  //! An instance of the UpdatePolicy used for actual optimization.
+  UpdatePolicyType updatePolicy;
+};
+
+} // namespace ens
+
+#endif
@@ -65,8 +65,18 @@ class MomentumUpdate
    * Construct the momentum update policy with given momentum decay parameter.
    *
    * @param momentum The momentum decay hyperparameter
+   * @param weightDecay Decoupled weight decay coefficient (SGDW); each step
+   *        additionally shrinks the parameters by stepSize * weightDecay,
+   *        applied directly to the iterate rather than through the gradient.
+   *        The decay is folded into the update traversal, so enabling it
+   *        costs no extra pass over the parameter memory.  With sparse
+   *        gradients, the decay is only applied to a coordinate when it is
+   *        visited.
    */
-  MomentumUpdate(const double momentum = 0.5) : momentum(momentum)
+  MomentumUpdate(const double momentum = 0.5,
+                 const double weightDecay = 0.0) :
+      momentum(momentum),
+      weightDecay(weightDecay)
   { /* Do nothing. */ };
 
   //! Access the momentum.
@@ -74,6 +84,11 @@ class MomentumUpdate
   //! Modify the momentum.
   double& Momentum() { return momentum; }
 
+  //! Get the decoupled weight decay coefficient (0 means no decay).
+  double WeightDecay() const { return weightDecay; }
+  //! Modify the decoupled weight decay coefficient.
+  double& WeightDecay() { return weightDecay; }
+
   /**
    * The UpdatePolicyType policy classes must contain an internal 'Policy'
    * template class with two template arguments: MatType and GradType.  This is
@@ -94,9 +109,16 @@ class MomentumUpdate
      */
     Policy(const MomentumUpdate& parent, const size_t rows, const size_t cols) :
         parent(parent),
-        velocity(arma::zeros<MatType>(rows, cols))
+        step(0)
     {
-      // Nothing to do.
+      // The velocity lives in the same memory space as the iterate, so with
+      // a GPU matrix type the state is allocated device-side.
+      velocity.zeros(rows, cols);
+
+      // The per-coordinate visit bookkeeping is only needed for the lazy
+      // sparse update path, so don't pay for it with dense gradients.
+      if (arma::is_arma_sparse_type<GradType>::value)
+        lastVisit.zeros(rows, cols);
     }
 
     /**
@@ -112,20 +134,170 @@ class MomentumUpdate
                 const double stepSize,
                 const GradType& gradient)
     {
+      ApplyUpdate(iterate, stepSize, gradient);
+    }
+
+    /**
+     * Write the optimizer state (the velocity and the sparse-update
+     * bookkeeping) to the given stream in binary format.
+     */
+    void Serialize(std::ostream& stream) const
+    {
+      stream.write(reinterpret_cast<const char*>(&step), sizeof(step));
+      velocity.save(stream, arma::arma_binary);
+      lastVisit.save(stream, arma::arma_binary);
+    }
+
+    /**
+     * Restore the optimizer state from the given stream, as written by
+     * Serialize().
+     */
+    void Deserialize(std::istream& stream)
+    {
+      stream.read(reinterpret_cast<char*>(&step), sizeof(step));
+      velocity.load(stream, arma::arma_binary);
+      lastVisit.load(stream, arma::arma_binary);
+    }
+
+   private:
+    /**
+     * Lazy update for sparse gradients: only the coordinates with nonzero
+     * gradient entries are touched.  The velocity decay (and the iterate
+     * movement it implies) for the steps a coordinate was skipped is caught
+     * up exactly, using the closed form of the geometric series, when the
+     * coordinate is next visited; coordinates never visited again simply keep
+     * their deferred movement.  Step cost is proportional to the number of
+     * nonzeros instead of the model size.
+     */
+    template<typename InGradType>
+    typename std::enable_if<arma::is_arma_sparse_type<InGradType>::value,
+        void>::type
+    ApplyUpdate(MatType& iterate,
+                const double stepSize,
+                const InGradType& gradient)
+    {
+      typedef typename MatType::elem_type ElemType;
+
+      const ElemType mu = (ElemType) parent.momentum;
+      ++step;
+
+      typename InGradType::const_iterator it = gradient.begin();
+      for (; it != gradient.end(); ++it)
+      {
+        const size_t r = it.row();
+        const size_t c = it.col();
+
+        // Catch up the decay for the steps this coordinate was skipped:
+        // in those steps the dense update would have applied v, mu * v, ...
+        // to the iterate while the velocity decayed geometrically.
+        const size_t skipped = step - lastVisit(r, c) - 1;
+        if (skipped > 0 && velocity(r, c) != ElemType(0))
+        {
+          if (mu == ElemType(1))
+          {
+            iterate(r, c) += (ElemType) skipped * velocity(r, c);
+          }
+          else
+          {
+            const ElemType decay = (ElemType) std::pow(mu, (double) skipped);
+            iterate(r, c) += velocity(r, c) * mu * (1 - decay) / (1 - mu);
+            velocity(r, c) *= decay;
+          }
+        }
+
+        // Decoupled weight decay is only applied when a coordinate is
+        // visited; decay for skipped steps is dropped, like the deferred
+        // velocity movement.
+        if (parent.weightDecay != 0)
+          iterate(r, c) *= (ElemType) (1.0 - stepSize * parent.weightDecay);
+
+        velocity(r, c) = mu * velocity(r, c) - (ElemType) stepSize * (*it);
+        iterate(r, c) += velocity(r, c);
+        lastVisit(r, c) = step;
+      }
+    }
+
+    //! Dense gradients: the usual full-matrix momentum update.  With
+    //! decoupled weight decay (SGDW) enabled, the decay is folded into a
+    //! single fused traversal alongside the velocity and iterate updates.
+    template<typename InGradType>
+    typename std::enable_if<!arma::is_arma_sparse_type<InGradType>::value,
+        void>::type
+    ApplyUpdate(MatType& iterate,
+                const double stepSize,
+                const InGradType& gradient)
+    {
+      if (parent.weightDecay == 0)
+      {
+        velocity = parent.momentum * velocity - stepSize * gradient;
+        iterate += velocity;
+        return;
+      }
+
+      DecayUpdate(iterate, stepSize, gradient);
+    }
+
+    //! Fused CPU kernel for the decoupled weight decay path: a single
+    //! traversal of the parameter memory updates the velocity, the decay,
+    //! and the iterate together.
+    template<typename InGradType>
+    typename std::enable_if<arma::is_arma_type<InGradType>::value, void>::type
+    DecayUpdate(MatType& iterate,
+                const double stepSize,
+                const InGradType& gradient)
+    {
+      typedef typename MatType::elem_type ElemType;
+
+      const ElemType mu = (ElemType) parent.momentum;
+      const ElemType step = (ElemType) stepSize;
+      const ElemType decay = (ElemType)
+          (1.0 - stepSize * parent.weightDecay);
+
+      const typename InGradType::elem_type* g = gradient.memptr();
+      ElemType* vMem = velocity.memptr();
+      ElemType* itMem = iterate.memptr();
+
+      const size_t n = iterate.n_elem;
+      for (size_t j = 0; j < n; ++j)
+      {
+        vMem[j] = mu * vMem[j] - step * (ElemType) g[j];
+        itMem[j] = decay * itMem[j] + vMem[j];
+      }
+    }
+
+    //! Matrix types without host-side memory (e.g. GPU matrices) cannot walk
+    //! a raw pointer; use device-side expressions instead, which keeps the
+    //! whole step free of host-device transfers.
+    template<typename InGradType>
+    typename std::enable_if<!arma::is_arma_type<InGradType>::value, void>::type
+    DecayUpdate(MatType& iterate,
+                const double stepSize,
+                const InGradType& gradient)
+    {
+      typedef typename MatType::elem_type ElemType;
+
       velocity = parent.momentum * velocity - stepSize * gradient;
+      iterate *= (ElemType) (1.0 - stepSize * parent.weightDecay);
       iterate += velocity;
     }
 
-   private:
     // The instantiated parent class.
     const MomentumUpdate& parent;
     // The velocity matrix.
     MatType velocity;
+    // The step at which each coordinate was last visited (lazy sparse path
+    // only).
+    arma::Mat<arma::uword> lastVisit;
+    // The number of update steps taken (lazy sparse path only).
+    arma::uword step;
   };
 
  private:
   // The momentum hyperparameter.
   double momentum;
+
+  // The decoupled weight decay coefficient (0 means no decay).
+  double weightDecay;
 };
 
 } // namespace ens
@@ -0,0 +1,252 @@
+/**
+ * @file proximal_update.hpp
+ * @author Marcus Edel
+ *
+ * Proximal update wrapper for the SGD update-policy chain: the wrapped
+ * policy's gradient step is followed by a proximal operator in the same
+ * fused pass, so composite objectives (smooth loss plus a nonsmooth
+ * regularizer such as the L1 norm) produce genuinely sparse iterates with
+ * exact zeros.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_SGD_PROXIMAL_UPDATE_HPP
+#define ENSMALLEN_SGD_PROXIMAL_UPDATE_HPP
+
+#include "vanilla_update.hpp"
+
+namespace ens {
+
+/**
+ * The proximal operator of the zero regularizer: a no-op.  Used as the
+ * default operator by optimizers that take an optional proximal operator, so
+ * purely smooth configurations pay nothing for the extension point.
+ */
+class IdentityProximal
+{
+ public:
+  /**
+   * Leave the iterate untouched.
+   *
+   * @param iterate Parameters to be shrunk in place.
+   * @param stepSize Step size used for the preceding gradient step.
+   */
+  template<typename MatType>
+  void Apply(MatType& /* iterate */, const double /* stepSize */) const
+  { /* Nothing to do here. */ }
+};
+
+/**
+ * The proximal operator of the scaled L1 norm (soft thresholding):
+ *
+ * \f[
+ * prox_{\alpha \lambda \| \cdot \|_1}(v)_i =
+ *     sign(v_i) \max(|v_i| - \alpha \lambda, 0)
+ * \f]
+ *
+ * where \f$ \alpha \f$ is the current step size.  Coordinates whose
+ * magnitude falls below the threshold become exactly zero, unlike a
+ * subgradient step which only makes them small.
+ */
+class L1Proximal
+{
+ public:
+  //! Construct the L1 proximal operator with regularization strength lambda.
+  L1Proximal(const double lambda = 0.001) : lambda(lambda)
+  { /* Nothing to do here. */ }
+
+  //! Get the regularization strength.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization strength.
+  double& Lambda() { return lambda; }
+
+  /**
+   * Apply the soft threshold to the iterate, scaled by the step size.
+   *
+   * @param iterate Parameters to be shrunk in place.
+   * @param stepSize Step size used for the preceding gradient step.
+   */
+  template<typename MatType>
+  void Apply(MatType& iterate, const double stepSize) const
+  {
+    typedef typename MatType::elem_type ElemType;
+
+    const ElemType threshold = (ElemType) (lambda * stepSize);
+    iterate = arma::sign(iterate) %
+        arma::max(arma::abs(iterate) - threshold,
+        arma::zeros<arma::Mat<ElemType>>(iterate.n_rows, iterate.n_cols));
+  }
+
+ private:
+  //! The regularization strength of the L1 term.
+  double lambda;
+};
+
+/**
+ * The proximal operator of the group lasso penalty, with the rows of the
+ * parameter matrix acting as groups: each row is shrunk toward zero by the
+ * threshold in Euclidean norm, and rows whose norm falls below the threshold
+ * are zeroed entirely.  This yields structured (whole-group) sparsity.
+ */
+class GroupL1Proximal
+{
+ public:
+  //! Construct the group proximal operator with regularization strength
+  //! lambda.
+  GroupL1Proximal(const double lambda = 0.001) : lambda(lambda)
+  { /* Nothing to do here. */ }
+
+  //! Get the regularization strength.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization strength.
+  double& Lambda() { return lambda; }
+
+  /**
+   * Apply the row-wise group shrinkage to the iterate, scaled by the step
+   * size.
+   *
+   * @param iterate Parameters to be shrunk in place.
+   * @param stepSize Step size used for the preceding gradient step.
+   */
+  template<typename MatType>
+  void Apply(MatType& iterate, const double stepSize) const
+  {
+    typedef typename MatType::elem_type ElemType;
+
+    const ElemType threshold = (ElemType) (lambda * stepSize);
+    for (size_t i = 0; i < iterate.n_rows; ++i)
+    {
+      const ElemType norm = arma::norm(iterate.row(i), 2);
+      if (norm <= threshold)
+        iterate.row(i).zeros();
+      else
+        iterate.row(i) *= (norm - threshold) / norm;
+    }
+  }
+
+ private:
+  //! The regularization strength of the group penalty.
+  double lambda;
+};
+
+/**
+ * Interface for wrapping around update policies (e.g., VanillaUpdate) and
+ * applying a proximal operator to the iterate right after the wrapped
+ * policy's gradient step.  This implements proximal stochastic gradient
+ * descent (forward-backward splitting) for composite objectives
+ * \f$ f(x) + \lambda r(x) \f$: the separable function provides the gradient
+ * of the smooth part \f$ f \f$, and the proximal operator handles the
+ * nonsmooth regularizer \f$ r \f$ exactly, producing iterates with exact
+ * zeros that subgradient steps never reach.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @article{Duchi2009,
+ *   author  = {Duchi, John and Singer, Yoram},
+ *   title   = {Efficient Online and Batch Learning Using Forward Backward
+ *              Splitting},
+ *   journal = {Journal of Machine Learning Research},
+ *   year    = {2009},
+ *   volume  = {10},
+ *   pages   = {2899--2934}
+ * }
+ * @endcode
+ *
+ * @tparam UpdatePolicyType A type of UpdatePolicy that should be wrapped
+ *     around.
+ * @tparam ProxOperatorType The proximal operator to apply after each step;
+ *     it must provide Apply(iterate, stepSize).
+ */
+template<typename UpdatePolicyType = VanillaUpdate,
+         typename ProxOperatorType = L1Proximal>
+class ProximalUpdate
+{
+ public:
+  /**
+   * Constructor for creating a ProximalUpdate instance.
+   *
+   * @param updatePolicy An instance of the UpdatePolicyType used for the
+   *     gradient step.
+   * @param proxOperator The proximal operator applied after each gradient
+   *     step.
+   */
+  ProximalUpdate(const UpdatePolicyType& updatePolicy = UpdatePolicyType(),
+                 const ProxOperatorType& proxOperator = ProxOperatorType()) :
+      updatePolicy(updatePolicy),
+      proxOperator(proxOperator)
+  { /* Nothing to do here. */ }
+
+  //! Get the update policy.
+  const UpdatePolicyType& UpdatePolicy() const { return updatePolicy; }
+  //! Modify the update policy.
+  UpdatePolicyType& UpdatePolicy() { return updatePolicy; }
+
+  //! Get the proximal operator.
+  const ProxOperatorType& ProxOperator() const { return proxOperator; }
+  //! Modify the proximal operator.
+  ProxOperatorType& ProxOperator() { return proxOperator; }
+
+  /**
+   * The UpdatePolicyType policy classes must contain an internal 'Policy'
+   * template class with two template arguments: MatType and GradType.  This
+   * is instantiated at the start of the optimization, and holds parameters
+   * specific to an individual optimization.
+   */
+  template<typename MatType, typename GradType>
+  class Policy
+  {
+   public:
+    /**
+     * This is called by the optimizer method before the start of the
+     * iteration update process.
+     *
+     * @param parent Instantiated parent class.
+     * @param rows Number of rows in the gradient matrix.
+     * @param cols Number of columns in the gradient matrix.
+     */
+    Policy(const ProximalUpdate<UpdatePolicyType, ProxOperatorType>& parent,
+           const size_t rows,
+           const size_t cols) :
+        parent(parent),
+        instPolicy(parent.UpdatePolicy(), rows, cols)
+    { /* Nothing to do here. */ }
+
+    /**
+     * Update step.  First, the wrapped policy performs its gradient step,
+     * and then the proximal operator is applied to the iterate in the same
+     * pass.
+     *
+     * @param iterate Parameters that minimize the function.
+     * @param stepSize Step size to be used for the given iteration.
+     * @param gradient The gradient matrix.
+     */
+    void Update(MatType& iterate,
+                const double stepSize,
+                const GradType& gradient)
+    {
+      instPolicy.Update(iterate, stepSize, gradient);
+      parent.ProxOperator().Apply(iterate, stepSize);
+    }
+
+   private:
+    // The instantiated parent class.
+    const ProximalUpdate<UpdatePolicyType, ProxOperatorType>& parent;
+    // The instantiated update policy we will use.
+    typename UpdatePolicyType::template Policy<MatType, GradType> instPolicy;
+  };
+
+ private:
+  //! An instance of the UpdatePolicy used for the gradient step.
+  UpdatePolicyType updatePolicy;
+
+  //! The proximal operator applied after each gradient step.
+  ProxOperatorType proxOperator;
+};
+
+} // namespace ens
+
+#endif
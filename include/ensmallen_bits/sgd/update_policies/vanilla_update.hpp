@@ -62,7 +62,40 @@ class VanillaUpdate
                 const double stepSize,
                 const GradType& gradient)
     {
-      // Perform the vanilla SGD update.
+      ApplyUpdate(iterate, stepSize, gradient);
+    }
+
+    //! The vanilla update has no state to checkpoint.
+    void Serialize(std::ostream& /* stream */) const { }
+
+    //! The vanilla update has no state to restore.
+    void Deserialize(std::istream& /* stream */) { }
+
+   private:
+    //! Sparse gradients: only the nonzero coordinates change, so walk the
+    //! nonzeros instead of the whole parameter matrix.
+    template<typename InGradType>
+    typename std::enable_if<arma::is_arma_sparse_type<InGradType>::value,
+        void>::type
+    ApplyUpdate(MatType& iterate,
+                const double stepSize,
+                const InGradType& gradient)
+    {
+      typedef typename MatType::elem_type ElemType;
+
+      typename InGradType::const_iterator it = gradient.begin();
+      for (; it != gradient.end(); ++it)
+        iterate(it.row(), it.col()) -= (ElemType) stepSize * (*it);
+    }
+
+    //! Dense gradients: perform the vanilla SGD update.
+    template<typename InGradType>
+    typename std::enable_if<!arma::is_arma_sparse_type<InGradType>::value,
+        void>::type
+    ApplyUpdate(MatType& iterate,
+                const double stepSize,
+                const InGradType& gradient)
+    {
       iterate -= stepSize * gradient;
     }
   };
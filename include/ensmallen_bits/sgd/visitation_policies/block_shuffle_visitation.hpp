@@ -0,0 +1,163 @@
+/**
+ * @file block_shuffle_visitation.hpp
+ * @author Ryan Curtin
+ *
+ * Locality-preserving visitation policy for SGD: contiguous blocks of batch
+ * slots are shuffled as units, and optionally within themselves, so that
+ * consecutive batches still touch nearby regions of the dataset.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_SGD_BLOCK_SHUFFLE_VISITATION_HPP
+#define ENSMALLEN_SGD_BLOCK_SHUFFLE_VISITATION_HPP
+
+namespace ens {
+
+/**
+ * Visitation policy that partitions the batch slots of one epoch into blocks
+ * of `blockBatches` contiguous batches, visits the blocks in a freshly
+ * shuffled order each epoch, and (optionally) permutes the batch order inside
+ * each block with a coprime-stride walk.  The function's Shuffle() method is
+ * never called and the composition of each batch never changes, so batches
+ * inside a block remain contiguous in memory: on memory-mapped or out-of-core
+ * datasets this keeps accesses sequential at the block granularity while
+ * still decorrelating the epoch order.  The trade-off is coarser
+ * randomization than a true shuffle; larger blocks mean better locality and
+ * less stochasticity.
+ *
+ * If the number of batches is not a multiple of the block size, the partial
+ * tail block is always visited last, in linear order, so that the equal-size
+ * block mapping stays O(1) per lookup.
+ */
+class BlockShuffleVisitation
+{
+ public:
+  /**
+   * Construct the block shuffle visitation policy.  Until StartEpoch() is
+   * called the batches are visited in linear order, matching the behavior of
+   * ShuffleVisitation on the first (unshuffled) epoch.
+   *
+   * Note that the block size is given in batches, not samples: a block spans
+   * `blockBatches * batchSize` consecutive samples of the dataset.
+   *
+   * @param blockBatches Number of contiguous batches per block.
+   * @param shuffleWithinBlocks If true, also permute the batch order inside
+   *     each block.
+   */
+  BlockShuffleVisitation(const size_t blockBatches = 64,
+                         const bool shuffleWithinBlocks = true) :
+      blockBatches(std::max(blockBatches, (size_t) 1)),
+      shuffleWithinBlocks(shuffleWithinBlocks),
+      numBatches(0),
+      withinStride(1)
+  { /* Nothing to do here */ }
+
+  //! Get the number of contiguous batches per block.
+  size_t BlockBatches() const { return blockBatches; }
+  //! Modify the number of contiguous batches per block.
+  size_t& BlockBatches() { return blockBatches; }
+
+  //! Get whether the batch order inside each block is also permuted.
+  bool ShuffleWithinBlocks() const { return shuffleWithinBlocks; }
+  //! Modify whether the batch order inside each block is also permuted.
+  bool& ShuffleWithinBlocks() { return shuffleWithinBlocks; }
+
+  /**
+   * Start a new epoch by drawing a fresh block permutation (and, if enabled,
+   * fresh within-block offsets and stride).  The function itself is not
+   * touched.
+   *
+   * @param function Function being optimized (unused).
+   * @param numBatchesIn Number of batches in one epoch.
+   */
+  template<typename SeparableFunctionType>
+  void StartEpoch(SeparableFunctionType& /* function */,
+                  const size_t numBatchesIn)
+  {
+    numBatches = numBatchesIn;
+
+    const size_t fullBlocks = numBatches / blockBatches;
+    if (fullBlocks <= 1)
+    {
+      // Fewer than two full blocks: there is nothing to permute at the block
+      // level, so the epoch degenerates to linear (fully sequential) order.
+      blockOrder.reset();
+      return;
+    }
+
+    blockOrder = arma::shuffle(
+        arma::regspace<arma::uvec>(0, fullBlocks - 1));
+
+    if (shuffleWithinBlocks && blockBatches > 1)
+    {
+      withinOffsets = arma::randi<arma::uvec>(fullBlocks,
+          arma::distr_param(0, (int) blockBatches - 1));
+
+      // Draw a candidate stride and advance it until it is coprime to the
+      // block size, so the walk visits every slot of a block exactly once.
+      withinStride = (size_t) arma::as_scalar(arma::randi<arma::uvec>(1,
+          arma::distr_param(1, (int) blockBatches - 1)));
+      while (GCD(withinStride, blockBatches) != 1)
+        withinStride = (withinStride % (blockBatches - 1)) + 1;
+    }
+    else
+    {
+      withinStride = 1;
+    }
+  }
+
+  /**
+   * Return the batch slot to visit at epoch-local step k.
+   *
+   * @param k Epoch-local step number.
+   */
+  size_t Batch(const size_t k) const
+  {
+    if (blockOrder.n_elem == 0)
+      return k;
+
+    const size_t block = k / blockBatches;
+    if (block >= blockOrder.n_elem)
+      return k; // The partial tail block is visited in place, last.
+
+    size_t within = k % blockBatches;
+    if (shuffleWithinBlocks && blockBatches > 1)
+      within = (withinOffsets[block] + within * withinStride) % blockBatches;
+
+    return blockOrder[block] * blockBatches + within;
+  }
+
+ private:
+  //! Compute the greatest common divisor of a and b.
+  static size_t GCD(size_t a, size_t b)
+  {
+    while (b != 0)
+    {
+      const size_t t = a % b;
+      a = b;
+      b = t;
+    }
+    return a;
+  }
+
+  //! The number of contiguous batches per block.
+  size_t blockBatches;
+  //! Whether the batch order inside each block is also permuted.
+  bool shuffleWithinBlocks;
+
+  //! Number of batches in the current epoch.
+  size_t numBatches;
+  //! Shuffled order of the full blocks for the current epoch.
+  arma::uvec blockOrder;
+  //! Per-block starting slot of the within-block walk.
+  arma::uvec withinOffsets;
+  //! Stride of the within-block walk (coprime to blockBatches).
+  size_t withinStride;
+};
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,50 @@
+/**
+ * @file shuffle_visitation.hpp
+ * @author Ryan Curtin
+ *
+ * Default visitation policy for SGD: ask the function to shuffle itself at
+ * the start of every epoch and then visit the batches in linear order.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_SGD_SHUFFLE_VISITATION_HPP
+#define ENSMALLEN_SGD_SHUFFLE_VISITATION_HPP
+
+namespace ens {
+
+/**
+ * Visitation policy that reproduces the classical SGD behavior: the function's
+ * Shuffle() method is called at the start of every epoch (which typically
+ * reorders the underlying data), and batches are then visited in linear order.
+ */
+class ShuffleVisitation
+{
+ public:
+  /**
+   * Start a new epoch by shuffling the function's data.
+   *
+   * @param function Function being optimized.
+   * @param numBatches Number of batches in one epoch (unused here).
+   */
+  template<typename SeparableFunctionType>
+  void StartEpoch(SeparableFunctionType& function,
+                  const size_t /* numBatches */)
+  {
+    function.Shuffle();
+  }
+
+  /**
+   * Return the batch slot to visit at epoch-local step k.  Since Shuffle()
+   * already reordered the data, batches are visited in linear order.
+   *
+   * @param k Epoch-local step number.
+   */
+  size_t Batch(const size_t k) const { return k; }
+};
+
+} // namespace ens
+
+#endif
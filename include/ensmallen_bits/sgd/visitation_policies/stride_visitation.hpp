@@ -0,0 +1,110 @@
+/**
+ * @file stride_visitation.hpp
+ * @author Ryan Curtin
+ *
+ * Shuffle-free visitation policy for SGD: batches are visited in a
+ * pseudo-random order generated on the fly from a coprime stride, so no O(n)
+ * shuffle or permutation vector is ever built.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_SGD_STRIDE_VISITATION_HPP
+#define ENSMALLEN_SGD_STRIDE_VISITATION_HPP
+
+namespace ens {
+
+/**
+ * Visitation policy that walks the batch slots of one epoch in the order
+ *
+ * \f[
+ * b_k = (o + k s) \bmod m
+ * \f]
+ *
+ * where \f$ m \f$ is the number of batches, \f$ s \f$ is a stride drawn
+ * coprime to \f$ m \f$, and \f$ o \f$ is a random offset; both are redrawn at
+ * every epoch.  Since \f$ \gcd(s, m) = 1 \f$, every batch is visited exactly
+ * once per epoch, but the function's Shuffle() method is never called and no
+ * permutation vector is allocated.  This is useful for huge datasets where a
+ * full shuffle at the start of each epoch is too expensive; note that the
+ * randomization is coarser than a true shuffle, since the composition of each
+ * batch never changes.
+ */
+class StrideVisitation
+{
+ public:
+  /**
+   * Construct the stride visitation policy.  Until StartEpoch() is called the
+   * batches are visited in linear order, matching the behavior of
+   * ShuffleVisitation on the first (unshuffled) epoch.
+   */
+  StrideVisitation() : numBatches(0), stride(1), offset(0) { }
+
+  /**
+   * Start a new epoch by drawing a fresh coprime stride and offset.  The
+   * function itself is not touched.
+   *
+   * @param function Function being optimized (unused).
+   * @param numBatchesIn Number of batches in one epoch.
+   */
+  template<typename SeparableFunctionType>
+  void StartEpoch(SeparableFunctionType& /* function */,
+                  const size_t numBatchesIn)
+  {
+    numBatches = numBatchesIn;
+    if (numBatches <= 1)
+    {
+      stride = 1;
+      offset = 0;
+      return;
+    }
+
+    offset = (size_t) arma::as_scalar(arma::randi<arma::uvec>(1,
+        arma::distr_param(0, (int) numBatches - 1)));
+
+    // Draw a candidate stride and advance it until it is coprime to the
+    // number of batches; for random candidates this terminates quickly.
+    stride = (size_t) arma::as_scalar(arma::randi<arma::uvec>(1,
+        arma::distr_param(1, (int) numBatches - 1)));
+    while (GCD(stride, numBatches) != 1)
+      stride = (stride % (numBatches - 1)) + 1;
+  }
+
+  /**
+   * Return the batch slot to visit at epoch-local step k.
+   *
+   * @param k Epoch-local step number.
+   */
+  size_t Batch(const size_t k) const
+  {
+    if (stride <= 1)
+      return k;
+    return (offset + k * stride) % numBatches;
+  }
+
+ private:
+  //! Compute the greatest common divisor of a and b.
+  static size_t GCD(size_t a, size_t b)
+  {
+    while (b != 0)
+    {
+      const size_t t = a % b;
+      a = b;
+      b = t;
+    }
+    return a;
+  }
+
+  //! Number of batches in the current epoch.
+  size_t numBatches;
+  //! Stride between successive batch slots (coprime to numBatches).
+  size_t stride;
+  //! Starting batch slot of the current epoch.
+  size_t offset;
+};
+
+} // namespace ens
+
+#endif
@@ -59,9 +59,59 @@ class CyclicalDecay
       nextRestart(epochRestart),
       batchRestart(0),
       epochBatches(0),
-      epoch(0)
+      epoch(0),
+      scheduleIndex(0)
   { /* Nothing to do here */ }
 
+  /**
+   * Precompute the step-size schedule for the next maxIterations update
+   * steps by simulating the restart bookkeeping once up front, so that the
+   * per-step cosine evaluation in Update() reduces to an indexed load.  The
+   * simulation starts from the current restart state and leaves it
+   * untouched; SGDR rebuilds the table at the start of every Optimize()
+   * call.  The table is exposed through Schedule(), which also makes the
+   * whole schedule auditable before the run.  With no iteration limit
+   * (maxIterations of 0) no table is built and Update() falls back to the
+   * closed form.
+   *
+   * @param maxIterations Number of update steps to precompute.
+   */
+  void PrecomputeSchedule(const size_t maxIterations)
+  {
+    schedule.clear();
+    scheduleIndex = 0;
+    if (maxIterations == 0 || epochBatches <= 0)
+      return;
+
+    size_t simEpoch = epoch;
+    size_t simEpochRestart = epochRestart;
+    size_t simNextRestart = nextRestart;
+    size_t simBatchRestart = batchRestart;
+    schedule.reserve(maxIterations);
+    for (size_t i = 0; i < maxIterations; ++i)
+    {
+      if (simEpoch >= simEpochRestart)
+      {
+        schedule.push_back(0.5 * constStepSize *
+            (1 + cos((simBatchRestart / epochBatches) * arma::datum::pi)));
+        simBatchRestart++;
+      }
+
+      if (simEpoch > simNextRestart)
+      {
+        simBatchRestart = 0;
+        simEpochRestart *= multFactor;
+        simNextRestart += simEpochRestart;
+      }
+
+      simEpoch++;
+    }
+  }
+
+  //! Get the precomputed step-size schedule (empty until
+  //! PrecomputeSchedule() is called).
+  const std::vector<double>& Schedule() const { return schedule; }
+
   //! Get the step size.
   double StepSize() const { return constStepSize; }
   //! Modify the step size.
@@ -128,9 +178,19 @@ class CyclicalDecay
       if (parent.epoch >= parent.epochRestart)
       {
         // n_t = n_min^i + 0.5(n_max^i - n_min^i)(1 + cos(T_cur/T_i * pi)).
-        stepSize = 0.5 * parent.constStepSize *
-            (1 + cos((parent.batchRestart / parent.epochBatches)
-            * arma::datum::pi));
+        // With a precomputed schedule this is an indexed load; the closed
+        // form only remains as the fallback past the table (e.g. with no
+        // iteration limit).
+        if (parent.scheduleIndex < parent.schedule.size())
+        {
+          stepSize = parent.schedule[parent.scheduleIndex++];
+        }
+        else
+        {
+          stepSize = 0.5 * parent.constStepSize *
+              (1 + cos((parent.batchRestart / parent.epochBatches)
+              * arma::datum::pi));
+        }
 
         // Keep track of the number of batches since the last restart.
         parent.batchRestart++;
@@ -177,6 +237,12 @@ class CyclicalDecay
 
   //! Locally-stored epoch.
   size_t epoch;
+
+  //! The precomputed step-size schedule (see PrecomputeSchedule()).
+  std::vector<double> schedule;
+
+  //! The next unconsumed entry of the precomputed schedule.
+  size_t scheduleIndex;
 };
 
 } // namespace ens
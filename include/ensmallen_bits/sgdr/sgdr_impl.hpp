@@ -66,6 +66,10 @@ SGDR<UpdatePolicyType>::Optimize(
   optimizer.DecayPolicy().EpochBatches() = function.NumFunctions() /
       double(optimizer.BatchSize());
 
+  // Precompute the whole step-size schedule, so the per-step decay update
+  // reduces to an indexed load.
+  optimizer.DecayPolicy().PrecomputeSchedule(optimizer.MaxIterations());
+
   // If a user changed the batch size we have to update the restart fraction
   // of the cyclical decay instantiation.
   if (optimizer.BatchSize() != batchSize)
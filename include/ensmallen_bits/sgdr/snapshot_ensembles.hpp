@@ -53,19 +53,30 @@ class SnapshotEnsembles
    * @param maxIterations Maximum number of iterations allowed (0 means no
    *        limit).
    * @param snapshots Maximum number of snapshots.
+   * @param avgSnapshots If true, only a running mean of the snapshots is
+   *        maintained instead of the individual iterates, keeping the memory
+   *        footprint constant regardless of the snapshot count.
+   * @param snapshotFile If non-empty, each snapshot is streamed to disk as
+   *        "<snapshotFile>.<index>.bin" when it is taken instead of being
+   *        kept in memory.  Ignored when avgSnapshots is set.
    */
   SnapshotEnsembles(const size_t epochRestart,
                     const double multFactor,
                     const double stepSize,
                     const size_t maxIterations,
-                    const size_t snapshots) :
+                    const size_t snapshots,
+                    const bool avgSnapshots = false,
+                    const std::string& snapshotFile = "") :
     epochRestart(epochRestart),
     multFactor(multFactor),
     constStepSize(stepSize),
+    avgSnapshots(avgSnapshots),
+    snapshotFile(snapshotFile),
     nextRestart(epochRestart),
     batchRestart(0),
     epochBatches(0),
-    epoch(0)
+    epoch(0),
+    scheduleIndex(0)
   {
     snapshotEpochs = 0;
     for (size_t i = 0, er = epochRestart, nr = nextRestart;
@@ -83,6 +94,56 @@ class SnapshotEnsembles
         snapshotEpochs - snapshots + 1);
   }
 
+  /**
+   * Precompute the step-size schedule for the next maxIterations update
+   * steps by simulating the restart bookkeeping once up front, so that the
+   * per-step cosine evaluation in Update() reduces to an indexed load.  The
+   * simulation starts from the current restart state and leaves it (and the
+   * snapshot machinery, which stays live in Update()) untouched;
+   * SnapshotSGDR rebuilds the table at the start of every Optimize() call.
+   * The table is exposed through Schedule(), which also makes the whole
+   * schedule auditable before the run.  With no iteration limit
+   * (maxIterations of 0) no table is built and Update() falls back to the
+   * closed form.
+   *
+   * @param maxIterations Number of update steps to precompute.
+   */
+  void PrecomputeSchedule(const size_t maxIterations)
+  {
+    schedule.clear();
+    scheduleIndex = 0;
+    if (maxIterations == 0 || epochBatches <= 0)
+      return;
+
+    size_t simEpoch = epoch;
+    size_t simEpochRestart = epochRestart;
+    size_t simNextRestart = nextRestart;
+    size_t simBatchRestart = batchRestart;
+    schedule.reserve(maxIterations);
+    for (size_t i = 0; i < maxIterations; ++i)
+    {
+      if (simEpoch >= simEpochRestart)
+      {
+        schedule.push_back(0.5 * constStepSize *
+            (1 + cos((simBatchRestart / epochBatches) * arma::datum::pi)));
+        simBatchRestart++;
+      }
+
+      if (simEpoch > simNextRestart)
+      {
+        simBatchRestart = 0;
+        simEpochRestart *= multFactor;
+        simNextRestart += simEpochRestart;
+      }
+
+      simEpoch++;
+    }
+  }
+
+  //! Get the precomputed step-size schedule (empty until
+  //! PrecomputeSchedule() is called).
+  const std::vector<double>& Schedule() const { return schedule; }
+
   //! Get the step size.
   double StepSize() const { return constStepSize; }
   //! Modify the step size.
@@ -123,6 +184,17 @@ class SnapshotEnsembles
   //! Modify the number of epochs needed for a new snapshot.
   size_t& SnapshotEpochs() { return snapshotEpochs; }
 
+  //! Get whether only a running mean of the snapshots is maintained.
+  bool AvgSnapshots() const { return avgSnapshots; }
+  //! Modify whether only a running mean of the snapshots is maintained.
+  bool& AvgSnapshots() { return avgSnapshots; }
+
+  //! Get the file prefix the snapshots are streamed to ("" keeps them in
+  //! memory).
+  const std::string& SnapshotFile() const { return snapshotFile; }
+  //! Modify the file prefix the snapshots are streamed to.
+  std::string& SnapshotFile() { return snapshotFile; }
+
   /**
    * The DecayPolicyType policy classes must contain an internal 'Policy'
    * template class with two template arguments: MatType and GradType.  This is
@@ -137,7 +209,7 @@ class SnapshotEnsembles
      * This constructor is called by the SGD Optimize() method before the start
      * of the iteration update process.
      */
-    Policy(SnapshotEnsembles& parent) : parent(parent) { }
+    Policy(SnapshotEnsembles& parent) : parent(parent), numSnapshots(0) { }
 
     /**
      * This function is called in each iteration after the policy update.
@@ -154,9 +226,19 @@ class SnapshotEnsembles
       if (parent.epoch >= parent.epochRestart)
       {
         // n_t = n_min^i + 0.5(n_max^i - n_min^i)(1 + cos(T_cur/T_i * pi)).
-        stepSize = 0.5 * parent.constStepSize *
-            (1 + cos((parent.batchRestart / parent.epochBatches)
-            * arma::datum::pi));
+        // With a precomputed schedule this is an indexed load; the closed
+        // form only remains as the fallback past the table (e.g. with no
+        // iteration limit).
+        if (parent.scheduleIndex < parent.schedule.size())
+        {
+          stepSize = parent.schedule[parent.scheduleIndex++];
+        }
+        else
+        {
+          stepSize = 0.5 * parent.constStepSize *
+              (1 + cos((parent.batchRestart / parent.epochBatches)
+              * arma::datum::pi));
+        }
 
         // Keep track of the number of batches since the last restart.
         parent.batchRestart++;
@@ -173,7 +255,26 @@ class SnapshotEnsembles
         // Create a new snapshot.
         if (parent.epochRestart >= parent.snapshotEpochs)
         {
-          snapshots.push_back(iterate);
+          if (parent.avgSnapshots)
+          {
+            // Only a running mean of the snapshots is maintained: constant
+            // memory regardless of the snapshot count.
+            if (numSnapshots == 0)
+              snapshotMean = iterate;
+            else
+              snapshotMean += (iterate - snapshotMean) / (numSnapshots + 1.0);
+          }
+          else if (!parent.snapshotFile.empty())
+          {
+            // Stream the snapshot to disk instead of keeping it in memory.
+            iterate.save(parent.snapshotFile + "." +
+                std::to_string(numSnapshots) + ".bin");
+          }
+          else
+          {
+            snapshots.push_back(iterate);
+          }
+          numSnapshots++;
         }
 
         // Update the time for the next restart.
@@ -188,11 +289,22 @@ class SnapshotEnsembles
     //! Modify the snapshots.
     std::vector<MatType>& Snapshots() { return snapshots; }
 
+    //! Get the running mean of the snapshots (only maintained when
+    //! AvgSnapshots() is set on the parent).
+    const MatType& SnapshotMean() const { return snapshotMean; }
+
+    //! Get the number of snapshots taken so far.
+    size_t NumSnapshots() const { return numSnapshots; }
+
    private:
     // Reference to the instantiated parent object.
     SnapshotEnsembles& parent;
     //! Locally-stored parameter snapshots.
     std::vector<MatType> snapshots;
+    //! Running mean of the snapshots, used when AvgSnapshots() is set.
+    MatType snapshotMean;
+    //! Number of snapshots taken so far.
+    size_t numSnapshots;
   };
 
  private:
@@ -205,6 +317,12 @@ class SnapshotEnsembles
   //! The step size for each example.
   double constStepSize;
 
+  //! Whether only a running mean of the snapshots is maintained.
+  bool avgSnapshots;
+
+  //! File prefix the snapshots are streamed to ("" keeps them in memory).
+  std::string snapshotFile;
+
   //! Locally-stored restart time.
   size_t nextRestart;
 
@@ -219,6 +337,12 @@ class SnapshotEnsembles
 
   //! Epochs where a new snapshot is created.
   size_t snapshotEpochs;
+
+  //! The precomputed step-size schedule (see PrecomputeSchedule()).
+  std::vector<double> schedule;
+
+  //! The next unconsumed entry of the precomputed schedule.
+  size_t scheduleIndex;
 };
 
 } // namespace ens
@@ -88,6 +88,12 @@ class SnapshotSGDR
    *        call; otherwise, their values are retained.
    * @param exactObjective Calculate the exact objective (Default: estimate the
    *        final objective obtained on the last pass over the data).
+   * @param avgSnapshots If true, only a running mean of the snapshots is
+   *        maintained instead of the individual iterates, keeping the memory
+   *        footprint constant regardless of the snapshot count.
+   * @param snapshotFile If non-empty, each snapshot is streamed to disk as
+   *        "<snapshotFile>.<index>.bin" when it is taken instead of being
+   *        kept in memory.  Ignored when avgSnapshots is set.
    */
   SnapshotSGDR(const size_t epochRestart = 50,
                const double multFactor = 2.0,
@@ -100,7 +106,9 @@ class SnapshotSGDR
                const bool accumulate = true,
                const UpdatePolicyType& updatePolicy = UpdatePolicyType(),
                const bool resetPolicy = true,
-               const bool exactObjective = false);
+               const bool exactObjective = false,
+               const bool avgSnapshots = false,
+               const std::string& snapshotFile = "");
 
   /**
    * Optimize the given function using SGDR.  The given starting point
@@ -185,6 +193,20 @@ class SnapshotSGDR
   //! Modify whether or not to accumulate the snapshots.
   bool& Accumulate() { return accumulate; }
 
+  //! Get whether only a running mean of the snapshots is maintained.
+  bool AvgSnapshots() const { return optimizer.DecayPolicy().AvgSnapshots(); }
+  //! Modify whether only a running mean of the snapshots is maintained.
+  bool& AvgSnapshots() { return optimizer.DecayPolicy().AvgSnapshots(); }
+
+  //! Get the file prefix the snapshots are streamed to ("" keeps them in
+  //! memory).
+  const std::string& SnapshotFile() const
+  {
+    return optimizer.DecayPolicy().SnapshotFile();
+  }
+  //! Modify the file prefix the snapshots are streamed to.
+  std::string& SnapshotFile() { return optimizer.DecayPolicy().SnapshotFile(); }
+
   //! Get the update policy.
   const UpdatePolicyType& UpdatePolicy() const
   {
@@ -30,7 +30,9 @@ SnapshotSGDR<UpdatePolicyType>::SnapshotSGDR(
     const bool accumulate,
     const UpdatePolicyType& updatePolicy,
     const bool resetPolicy,
-    const bool exactObjective) :
+    const bool exactObjective,
+    const bool avgSnapshots,
+    const std::string& snapshotFile) :
     batchSize(batchSize),
     accumulate(accumulate),
     exactObjective(exactObjective),
@@ -45,7 +47,9 @@ SnapshotSGDR<UpdatePolicyType>::SnapshotSGDR(
                                 multFactor,
                                 stepSize,
                                 maxIterations,
-                                snapshots),
+                                snapshots,
+                                avgSnapshots,
+                                snapshotFile),
                             resetPolicy,
                             exactObjective))
 {
@@ -74,6 +78,11 @@ SnapshotSGDR<UpdatePolicyType>::Optimize(
   optimizer.DecayPolicy().EpochBatches() = function.NumFunctions() /
       double(batchSize);
 
+  // Precompute the whole step-size schedule, so the per-step decay update
+  // reduces to an indexed load; the snapshot machinery itself stays live in
+  // the per-step update.
+  optimizer.DecayPolicy().PrecomputeSchedule(optimizer.MaxIterations());
+
   // If a user changed the batch size we have to update the restart fraction
   // of the cyclical decay instantiation.
   if (optimizer.BatchSize() != batchSize)
@@ -94,14 +103,25 @@ SnapshotSGDR<UpdatePolicyType>::Optimize(
   if (accumulate)
   {
     Any& instDecayPolicy = optimizer.InstDecayPolicy();
-    size_t numSnapshots =
-        instDecayPolicy.As<InstDecayPolicyType>().Snapshots().size();
+    InstDecayPolicyType& decay = instDecayPolicy.As<InstDecayPolicyType>();
 
-    for (size_t i = 0; i < numSnapshots; ++i)
+    if (optimizer.DecayPolicy().AvgSnapshots() && decay.NumSnapshots() > 0)
+    {
+      // Only the running mean of the snapshots was kept; fold it into the
+      // final parameters with the weight of the snapshots it represents.
+      iterate += decay.NumSnapshots() * decay.SnapshotMean();
+      iterate /= (decay.NumSnapshots() + 1);
+    }
+    else
     {
-      iterate += instDecayPolicy.As<InstDecayPolicyType>().Snapshots()[i];
+      const size_t numSnapshots = decay.Snapshots().size();
+
+      for (size_t i = 0; i < numSnapshots; ++i)
+      {
+        iterate += decay.Snapshots()[i];
+      }
+      iterate /= (numSnapshots + 1);
     }
-    iterate /= (numSnapshots + 1);
 
     // Calculate final objective.
     overallObjective = 0;
@@ -12,6 +12,8 @@
 #ifndef ENSMALLEN_SMORMS3_SMORMS3_UPDATE_HPP
 #define ENSMALLEN_SMORMS3_SMORMS3_UPDATE_HPP
 
+#include <ensmallen_bits/sgd/update_policies/elementwise_update.hpp>
+
 namespace ens {
 
 /**
@@ -54,7 +56,7 @@ class SMORMS3Update
    * instantiated at the start of the optimization.
    */
   template<typename MatType, typename GradType>
-  class Policy
+  class Policy : public ElementwiseUpdate<Policy<MatType, GradType>>
   {
    public:
     /**
@@ -85,24 +87,31 @@ class SMORMS3Update
                 const double stepSize,
                 const GradType& gradient)
     {
-      // Update the iterate.
-      MatType r = 1 / (mem + 1);
-
-      g = (1 - r) % g;
-      g += r % gradient;
+      this->Elementwise(iterate, stepSize, gradient, mem, g, g2);
+    }
 
-      g2 = (1 - r) % g2;
-      g2 += r % (gradient % gradient);
+    //! The per-element SMORMS3 rule; called by ElementwiseUpdate.
+    template<typename MemElemType, typename StateElemType>
+    double Apply(const double stepSize,
+                 const double x,
+                 const double grad,
+                 MemElemType& mem,
+                 StateElemType& g,
+                 StateElemType& g2)
+    {
+      const double r = 1.0 / (mem + 1.0);
 
-      MatType x = (g % g) / (g2 + parent.epsilon);
+      g = (StateElemType) ((1 - r) * g + r * grad);
+      g2 = (StateElemType) ((1 - r) * g2 + r * grad * grad);
 
-      x.transform( [stepSize](typename MatType::elem_type &v)
-          { return std::min(v, (typename MatType::elem_type) stepSize); } );
+      const double est = std::min((g * (double) g) / (g2 + parent.epsilon),
+          stepSize);
 
-      iterate -= gradient % x / (arma::sqrt(g2) + parent.epsilon);
+      const double result = x - grad * est /
+          (std::sqrt((double) g2) + parent.epsilon);
 
-      mem %= (1 - x);
-      mem += 1;
+      mem = (MemElemType) (mem * (1 - est) + 1);
+      return result;
     }
 
    private:
@@ -117,23 +117,23 @@ SPALeRASGD<DecayPolicyType>::Optimize(
 
   // Initialize the decay policy if needed.
   if (!isInitialized || !instDecayPolicy.Has<InstDecayPolicyType>())
-  {
-    instDecayPolicy.Clean();
-    instDecayPolicy.Set<InstDecayPolicyType>(
-        new InstDecayPolicyType(decayPolicy));
-  }
+    instDecayPolicy.Emplace<InstDecayPolicyType>(decayPolicy);
 
   // Initialize the update policy.
   if (resetPolicy || !isInitialized ||
       !instUpdatePolicy.Has<InstUpdatePolicyType>())
   {
-    instUpdatePolicy.Clean();
-    instUpdatePolicy.Set<InstUpdatePolicyType>(
-        new InstUpdatePolicyType(updatePolicy, iterate.n_rows, iterate.n_cols,
-                                 currentObjective * lambda));
+    instUpdatePolicy.Emplace<InstUpdatePolicyType>(updatePolicy,
+        iterate.n_rows, iterate.n_cols, currentObjective * lambda);
     isInitialized = true;
   }
 
+  // Resolve the concrete policy types once, so the typeid check in As<T>()
+  // stays out of the hot loop below.
+  InstUpdatePolicyType& instUpdate =
+      instUpdatePolicy.As<InstUpdatePolicyType>();
+  InstDecayPolicyType& instDecay = instDecayPolicy.As<InstDecayPolicyType>();
+
   // Now iterate!
   BaseGradType gradient(iterate.n_rows, iterate.n_cols);
   const size_t actualMaxIterations = (maxIterations == 0) ?
@@ -163,8 +163,8 @@ SPALeRASGD<DecayPolicyType>::Optimize(
       break;
 
     // Use the update policy to take a step.
-    if (!instUpdatePolicy.As<InstUpdatePolicyType>().Update(stepSize,
-        currentObjective, effectiveBatchSize, numFunctions, iterate, gradient))
+    if (!instUpdate.Update(stepSize, currentObjective, effectiveBatchSize,
+        numFunctions, iterate, gradient))
     {
       Warn << "SPALeRA SGD: converged to " << overallObjective << "; "
           << "terminating with failure.  Try a smaller step size?"
@@ -176,8 +176,7 @@ SPALeRASGD<DecayPolicyType>::Optimize(
     terminate |= Callback::StepTaken(*this, f, iterate, callbacks...);
 
     // Now update the learning rate if requested by the user.
-    instDecayPolicy.As<InstDecayPolicyType>().Update(iterate, stepSize,
-        gradient);
+    instDecay.Update(iterate, stepSize, gradient);
 
     i += effectiveBatchSize;
     currentFunction += effectiveBatchSize;
@@ -110,6 +110,7 @@ class SPALeRAStepsize
     {
       learningRates.ones(rows, cols);
       relaxedSums.zeros(rows, cols);
+      previousIterate.set_size(rows, cols);
 
       parent.lambda = lambda;
     }
@@ -183,6 +184,9 @@ class SPALeRAStepsize
       }
       else
       {
+        typedef typename MatType::elem_type ElemType;
+        typedef typename GradType::elem_type GradElemType;
+
         const double paramMean = (parent.alpha / (2 - parent.alpha) *
             (1 - std::pow(1 - parent.alpha, 2 * (eveCounter + 1)))) /
             iterate.n_elem;
@@ -190,19 +194,33 @@ class SPALeRAStepsize
         const double paramStd = (parent.alpha / std::sqrt(iterate.n_elem)) /
             std::sqrt(iterate.n_elem);
 
-        const typename MatType::elem_type normGradient =
-            std::sqrt(arma::accu(arma::pow(gradient, 2)));
-
-        relaxedSums *= (1 - parent.alpha);
-        if (normGradient > parent.epsilon)
-          relaxedSums += gradient * (parent.alpha / normGradient);
-
-        learningRates %= arma::exp((arma::pow(relaxedSums, 2) - paramMean) *
-            (parent.adaptRate / paramStd));
-
-        previousIterate = iterate;
-
-        iterate -= stepSize * (learningRates % gradient);
+        // The full gradient norm gates the relaxed-sum update below, so it
+        // has to be computed before the fused traversal.
+        const double normGradient = arma::norm(gradient, "fro");
+        const double relaxedScale = (normGradient > parent.epsilon) ?
+            parent.alpha / normGradient : 0.0;
+        const double rateScale = parent.adaptRate / paramStd;
+
+        // Fuse the relaxed-sum update, the per-parameter learning rate
+        // adaptation, the backtracking snapshot, and the iterate update into
+        // a single traversal, instead of materializing each intermediate
+        // expression in its own full-vector pass.
+        ElemType* iterateIt = iterate.memptr();
+        ElemType* previousIt = previousIterate.memptr();
+        ElemType* ratesIt = learningRates.memptr();
+        ElemType* sumsIt = relaxedSums.memptr();
+        const GradElemType* gradientIt = gradient.memptr();
+        for (arma::uword i = 0; i < iterate.n_elem; ++i)
+        {
+          const double g = (double) gradientIt[i];
+          const double sum = (1 - parent.alpha) * sumsIt[i] +
+              relaxedScale * g;
+          sumsIt[i] = (ElemType) sum;
+          ratesIt[i] *= (ElemType) std::exp((sum * sum - paramMean) *
+              rateScale);
+          previousIt[i] = iterateIt[i];
+          iterateIt[i] -= (ElemType) (stepSize * ratesIt[i] * g);
+        }
 
         // Keep track of the the number of evaluations and Page-Hinkley steps.
         eveCounter++;
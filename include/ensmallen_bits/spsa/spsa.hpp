@@ -13,6 +13,8 @@
 #ifndef ENSMALLEN_SPSA_SPSA_HPP
 #define ENSMALLEN_SPSA_SPSA_HPP
 
+#include <ensmallen_bits/utility/philox_generator.hpp>
+
 namespace ens {
 
 /**
@@ -54,13 +56,21 @@ class SPSA
    * @param maxIterations Maximum number of iterations allowed (0 means no
    *     limit).
    * @param tolerance Maximum absolute tolerance to terminate algorithm.
+   * @param numEstimates Number of perturbation pairs drawn and averaged per
+   *     iteration.  Values larger than 1 give lower-variance gradient
+   *     estimates at the cost of more function evaluations.
+   * @param parallelEvaluate If true and OpenMP is enabled, the perturbation
+   *     pairs of one iteration are evaluated in parallel; this requires
+   *     Evaluate() to be thread-safe.  Only used when numEstimates > 1.
    */
   SPSA(const double alpha = 0.602,
        const double gamma = 0.101,
        const double stepSize = 0.16,
        const double evaluationStepSize = 0.3,
        const size_t maxIterations = 100000,
-       const double tolerance = 1e-5);
+       const double tolerance = 1e-5,
+       const size_t numEstimates = 1,
+       const bool parallelEvaluate = false);
 
   /**
    * Optimize the given function, starting from the coordinates given in the
@@ -108,6 +118,21 @@ class SPSA
   //! Modify the maximum number of iterations (0 indicates no limit).
   size_t& MaxIterations() { return maxIterations; }
 
+  //! Get the number of perturbation pairs averaged per iteration.
+  size_t NumEstimates() const { return numEstimates; }
+  //! Modify the number of perturbation pairs averaged per iteration.
+  size_t& NumEstimates() { return numEstimates; }
+
+  //! Get whether the perturbation pairs are evaluated in parallel.
+  bool ParallelEvaluate() const { return parallelEvaluate; }
+  //! Modify whether the perturbation pairs are evaluated in parallel.
+  bool& ParallelEvaluate() { return parallelEvaluate; }
+
+  //! Get the random number generator.
+  const PhiloxGenerator& Generator() const { return generator; }
+  //! Modify the random number generator (e.g. to seed it for reproducibility).
+  PhiloxGenerator& Generator() { return generator; }
+
  private:
   //! Scaling exponent for the step size.
   double alpha;
@@ -129,6 +154,15 @@ class SPSA
 
   //! The tolerance for termination.
   double tolerance;
+
+  //! The number of perturbation pairs averaged per iteration.
+  size_t numEstimates;
+
+  //! Whether to evaluate the perturbation pairs of an iteration in parallel.
+  bool parallelEvaluate;
+
+  //! The random number generator used to draw the perturbations.
+  PhiloxGenerator generator;
 };
 
 } // namespace ens
@@ -26,14 +26,18 @@ inline SPSA::SPSA(const double alpha,
                   const double stepSize,
                   const double evaluationStepSize,
                   const size_t maxIterations,
-                  const double tolerance) :
+                  const double tolerance,
+                  const size_t numEstimates,
+                  const bool parallelEvaluate) :
     alpha(alpha),
     gamma(gamma),
     stepSize(stepSize),
     evaluationStepSize(evaluationStepSize),
     ak(0.001 * maxIterations),
     maxIterations(maxIterations),
-    tolerance(tolerance)
+    tolerance(tolerance),
+    numEstimates(numEstimates),
+    parallelEvaluate(parallelEvaluate)
 { /* Nothing to do. */ }
 
 template<typename ArbitraryFunctionType,
@@ -55,6 +59,21 @@ typename MatType::elem_type SPSA::Optimize(ArbitraryFunctionType& function,
   BaseMatType gradient(iterate.n_rows, iterate.n_cols);
   arma::Mat<ElemType> spVector(iterate.n_rows, iterate.n_cols);
 
+  // Buffers for the averaged mode (numEstimates > 1), preallocated once so
+  // there is no allocation in the iteration loop.
+  std::vector<arma::Mat<ElemType>> spVectors(numEstimates);
+  std::vector<arma::Mat<ElemType>> evalPoints(numEstimates);
+  arma::Col<ElemType> fPlusValues(numEstimates);
+  arma::Col<ElemType> fMinusValues(numEstimates);
+  if (numEstimates > 1)
+  {
+    for (size_t j = 0; j < numEstimates; ++j)
+    {
+      spVectors[j].set_size(iterate.n_rows, iterate.n_cols);
+      evalPoints[j].set_size(iterate.n_rows, iterate.n_cols);
+    }
+  }
+
   // To keep track of where we are and how things are going.
   ElemType overallObjective = 0;
   ElemType lastObjective = DBL_MAX;
@@ -93,26 +112,69 @@ typename MatType::elem_type SPSA::Optimize(ArbitraryFunctionType& function,
     const double akLocal = stepSize / std::pow(k + 1 + ak, alpha);
     const double ck = evaluationStepSize / std::pow(k + 1, gamma);
 
-    // Choose stochastic directions.
-    spVector = arma::conv_to<arma::Mat<ElemType>>::from(
-        arma::randi(iterate.n_rows, iterate.n_cols,
-        arma::distr_param(0, 1))) * 2 - 1;
+    if (numEstimates == 1)
+    {
+      // Choose stochastic directions.
+      generator.Rademacher(spVector);
+
+      iterate += ck * spVector;
+      const double fPlus = function.Evaluate(iterate);
+      terminate |= Callback::Evaluate(*this, function, iterate, fPlus,
+          callbacks...);
 
-    iterate += ck * spVector;
-    const double fPlus = function.Evaluate(iterate);
-    terminate |= Callback::Evaluate(*this, function, iterate, fPlus,
-        callbacks...);
+      iterate -= 2 * ck * spVector;
+      const double fMinus = function.Evaluate(iterate);
+      terminate |= Callback::Evaluate(*this, function, iterate, fMinus,
+          callbacks...);
 
-    iterate -= 2 * ck * spVector;
-    const double fMinus = function.Evaluate(iterate);
-    terminate |= Callback::Evaluate(*this, function, iterate, fMinus,
-        callbacks...);
+      iterate += ck * spVector;
+      if (terminate)
+        break;
 
-    iterate += ck * spVector;
-    if (terminate)
-      break;
+      gradient = (fPlus - fMinus) * (1 / (2 * ck * spVector));
+    }
+    else
+    {
+      // Averaged mode: draw all perturbation pairs up front, so that the
+      // stream of random numbers does not depend on the evaluation order.
+      for (size_t j = 0; j < numEstimates; ++j)
+        generator.Rademacher(spVectors[j]);
+
+      // Each perturbation pair is an independent pair of Evaluate() calls,
+      // so they can run in parallel.  Note that the objective callbacks are
+      // invoked only for the per-iteration objective below, not for every
+      // perturbation pair.
+      if (parallelEvaluate)
+      {
+        ENS_PRAGMA_OMP_PARALLEL_FOR
+        for (ptrdiff_t j = 0; j < (ptrdiff_t) numEstimates; ++j)
+        {
+          evalPoints[j] = iterate + ck * spVectors[j];
+          fPlusValues(j) = function.Evaluate(evalPoints[j]);
+          evalPoints[j] -= 2 * ck * spVectors[j];
+          fMinusValues(j) = function.Evaluate(evalPoints[j]);
+        }
+      }
+      else
+      {
+        for (size_t j = 0; j < numEstimates; ++j)
+        {
+          evalPoints[j] = iterate + ck * spVectors[j];
+          fPlusValues(j) = function.Evaluate(evalPoints[j]);
+          evalPoints[j] -= 2 * ck * spVectors[j];
+          fMinusValues(j) = function.Evaluate(evalPoints[j]);
+        }
+      }
+
+      // Average the two-point estimates.
+      gradient.zeros();
+      for (size_t j = 0; j < numEstimates; ++j)
+      {
+        gradient += (fPlusValues(j) - fMinusValues(j)) *
+            (1 / (2 * ck * numEstimates * spVectors[j]));
+      }
+    }
 
-    gradient = (fPlus - fMinus) * (1 / (2 * ck * spVector));
     iterate -= akLocal * gradient;
 
     terminate |= Callback::StepTaken(*this, function, iterate, callbacks...);
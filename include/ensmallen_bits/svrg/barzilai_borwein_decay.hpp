@@ -96,14 +96,20 @@ class BarzilaiBorweinDecay
       if (!fullGradient0.is_empty())
       {
         // Step size selection based on Barzilai-Borwein (BB).
-        stepSize = std::pow(arma::norm(iterate - iterate0), 2.0) /
+        const double stepSizeEstimate =
+            std::pow(arma::norm(iterate - iterate0), 2.0) /
             (arma::dot(iterate - iterate0, fullGradient - fullGradient0) +
              parent.epsilon) / (double) numBatches;
 
-        stepSize = std::min(stepSize, parent.maxStepSize);
+        // A non-positive or non-finite estimate means the curvature along the
+        // last snapshot difference is unusable (possible on nonconvex
+        // problems, where a negative estimate would turn the update into an
+        // ascent step); keep the current step size in that case.
+        if (std::isfinite(stepSizeEstimate) && (stepSizeEstimate > 0.0))
+          stepSize = std::min(stepSizeEstimate, parent.maxStepSize);
       }
 
-      fullGradient0 = std::move(fullGradient);
+      fullGradient0 = fullGradient;
     }
 
    private:
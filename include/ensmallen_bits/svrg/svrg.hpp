@@ -197,6 +197,12 @@ class SVRGType
   //! Modify whether or not the actual objective is calculated.
   bool& ExactObjective() { return exactObjective; }
 
+  //! Get whether the full-gradient snapshot is computed in parallel with
+  //! OpenMP (requires Gradient() to be thread-safe).
+  bool ParallelFullGradient() const { return parallelFullGradient; }
+  //! Modify whether the full-gradient snapshot is computed in parallel.
+  bool& ParallelFullGradient() { return parallelFullGradient; }
+
   //! Get whether or not the update policy parameters
   //! are reset before Optimize call.
   bool ResetPolicy() const { return resetPolicy; }
@@ -237,6 +243,9 @@ class SVRGType
   //! Controls whether or not the actual Objective value is calculated.
   bool exactObjective;
 
+  //! Whether the full-gradient snapshot is computed in parallel.
+  bool parallelFullGradient;
+
   //! The update policy used to update the parameters in each iteration.
   UpdatePolicyType updatePolicy;
 
@@ -36,6 +36,7 @@ SVRGType<UpdatePolicyType, DecayPolicyType>::SVRGType(
     tolerance(tolerance),
     shuffle(shuffle),
     exactObjective(exactObjective),
+    parallelFullGradient(false),
     updatePolicy(updatePolicy),
     decayPolicy(decayPolicy),
     resetPolicy(resetPolicy),
@@ -101,26 +102,33 @@ SVRGType<UpdatePolicyType, DecayPolicyType>::Optimize(
   // Initialize the decay policy.
   if (!isInitialized ||
       !instDecayPolicy.Has<InstDecayPolicyType>())
-  {
-    instDecayPolicy.Clean();
-    instDecayPolicy.Set<InstDecayPolicyType>(
-        new InstDecayPolicyType(decayPolicy));
-  }
+    instDecayPolicy.Emplace<InstDecayPolicyType>(decayPolicy);
 
   // Initialize the update policy.
   if (resetPolicy || !isInitialized ||
       !instUpdatePolicy.Has<InstUpdatePolicyType>())
   {
-    instUpdatePolicy.Clean();
-    instUpdatePolicy.Set<InstUpdatePolicyType>(
-        new InstUpdatePolicyType(updatePolicy, iterate.n_rows, iterate.n_cols));
+    instUpdatePolicy.Emplace<InstUpdatePolicyType>(updatePolicy,
+        iterate.n_rows, iterate.n_cols);
     isInitialized = true;
   }
 
-  // Now iterate!
-  BaseGradType gradient(iterate.n_rows, iterate.n_cols);
-  BaseGradType gradient0(iterate.n_rows, iterate.n_cols);
-  BaseMatType iterate0;
+  // Resolve the concrete policy types once, so the typeid check in As<T>()
+  // stays out of the inner loop below.
+  InstUpdatePolicyType& instUpdate =
+      instUpdatePolicy.As<InstUpdatePolicyType>();
+  InstDecayPolicyType& instDecay = instDecayPolicy.As<InstDecayPolicyType>();
+
+  // Now iterate!  All internal buffers live in the workspace so that
+  // repeated Optimize() calls reuse the same allocations.
+  BaseGradType& gradient = workspace.Get<BaseGradType>(0, iterate.n_rows,
+      iterate.n_cols);
+  BaseGradType& gradient0 = workspace.Get<BaseGradType>(1, iterate.n_rows,
+      iterate.n_cols);
+  BaseGradType& fullGradient = workspace.Get<BaseGradType>(2, iterate.n_rows,
+      iterate.n_cols);
+  BaseMatType& iterate0 = workspace.Get<BaseMatType>(3, iterate.n_rows,
+      iterate.n_cols);
 
   // Find the number of batches.
   size_t numBatches = numFunctions / batchSize;
@@ -132,8 +140,9 @@ SVRGType<UpdatePolicyType, DecayPolicyType>::Optimize(
   Callback::BeginOptimization(*this, function, iterate, callbacks...);
   for (size_t i = 0; i < actualMaxIterations && !terminate; ++i)
   {
-    // Calculate the objective function.
-    overallObjective = 0;
+    // Calculate the objective function, with compensated accumulation so
+    // that the sum stays accurate for low-precision element types.
+    KahanAccumulator<ElemType> objectiveSum;
     for (size_t f = 0; f < numFunctions; f += batchSize)
     {
       const size_t effectiveBatchSize = std::min(batchSize, numFunctions - f);
@@ -141,8 +150,9 @@ SVRGType<UpdatePolicyType, DecayPolicyType>::Optimize(
           effectiveBatchSize);
       terminate |= Callback::Evaluate(*this, function, iterate, objective,
           callbacks...);
-      overallObjective += objective;
+      objectiveSum.Add(objective);
     }
+    overallObjective = objectiveSum.Sum();
 
     if (terminate)
       break;
@@ -169,27 +179,88 @@ SVRGType<UpdatePolicyType, DecayPolicyType>::Optimize(
     lastObjective = overallObjective;
 
     // Compute the full gradient.
-    size_t effectiveBatchSize = std::min(batchSize, numFunctions);
-    BaseGradType fullGradient(iterate.n_rows, iterate.n_cols);
-    function.Gradient(iterate, 0, fullGradient, effectiveBatchSize);
+    if (parallelFullGradient)
+    {
+      // Parallel snapshot: each thread accumulates a partial sum over its
+      // share of the batches, reduced into fullGradient at the end.  This
+      // requires Gradient() to be thread-safe; the Gradient callback is
+      // invoked once with the reduced full gradient instead of per batch.
+      fullGradient.zeros();
+      const size_t snapshotBatches = (numFunctions + batchSize - 1) /
+          batchSize;
+
+      ENS_PRAGMA_OMP_PARALLEL
+      {
+        size_t threadId = 0;
+        size_t numThreads = 1;
+        #ifdef ENS_USE_OPENMP
+          threadId = omp_get_thread_num();
+          numThreads = omp_get_num_threads();
+        #endif
+
+        BaseGradType partialGradient(iterate.n_rows, iterate.n_cols);
+        partialGradient.zeros();
+        BaseGradType batchGradient(iterate.n_rows, iterate.n_cols);
+        // Elementwise Kahan compensation for the partial sum, so that the
+        // snapshot stays accurate even when the element type is float.
+        BaseGradType partialCompensation(iterate.n_rows, iterate.n_cols);
+        partialCompensation.zeros();
+
+        for (size_t b = threadId; b < snapshotBatches; b += numThreads)
+        {
+          const size_t begin = b * batchSize;
+          const size_t effectiveBatchSize = std::min(batchSize,
+              numFunctions - begin);
+
+          function.Gradient(iterate, begin, batchGradient,
+              effectiveBatchSize);
+          const BaseGradType corrected = batchGradient - partialCompensation;
+          const BaseGradType updated = partialGradient + corrected;
+          partialCompensation = (updated - partialGradient) - corrected;
+          partialGradient = updated;
+        }
+
+        ENS_PRAGMA_OMP_CRITICAL
+        {
+          fullGradient += partialGradient;
+        }
+      }
 
-    terminate |= Callback::Gradient(*this, function, iterate, fullGradient,
-        callbacks...);
-    for (size_t f = effectiveBatchSize; f < numFunctions;
-        /* incrementing done manually */)
+      fullGradient /= (double) numFunctions;
+      terminate |= Callback::Gradient(*this, function, iterate, fullGradient,
+          callbacks...);
+    }
+    else
     {
-      // Find the effective batch size (the last batch may be smaller).
-      effectiveBatchSize = std::min(batchSize, numFunctions - f);
+      size_t effectiveBatchSize = std::min(batchSize, numFunctions);
+      function.Gradient(iterate, 0, fullGradient, effectiveBatchSize);
 
-      function.Gradient(iterate, f, gradient, effectiveBatchSize);
-      terminate |= Callback::Gradient(*this, function, iterate, gradient,
-        callbacks...);
+      terminate |= Callback::Gradient(*this, function, iterate, fullGradient,
+          callbacks...);
+      // Elementwise Kahan compensation for the snapshot sum; the buffer
+      // lives in the workspace so repeated Optimize() calls reuse it.
+      BaseGradType& gradCompensation = workspace.Get<BaseGradType>(4,
+          iterate.n_rows, iterate.n_cols);
+      gradCompensation.zeros();
+      for (size_t f = effectiveBatchSize; f < numFunctions;
+          /* incrementing done manually */)
+      {
+        // Find the effective batch size (the last batch may be smaller).
+        effectiveBatchSize = std::min(batchSize, numFunctions - f);
+
+        function.Gradient(iterate, f, gradient, effectiveBatchSize);
+        terminate |= Callback::Gradient(*this, function, iterate, gradient,
+          callbacks...);
 
-      fullGradient += gradient;
+        const BaseGradType corrected = gradient - gradCompensation;
+        const BaseGradType updated = fullGradient + corrected;
+        gradCompensation = (updated - fullGradient) - corrected;
+        fullGradient = updated;
 
-      f += effectiveBatchSize;
+        f += effectiveBatchSize;
+      }
+      fullGradient /= (double) numFunctions;
     }
-    fullGradient /= (double) numFunctions;
     if (terminate)
       break;
 
@@ -228,8 +299,8 @@ SVRGType<UpdatePolicyType, DecayPolicyType>::Optimize(
         break;
 
       // Use the update policy to take a step.
-      instUpdatePolicy.As<InstUpdatePolicyType>().Update(iterate, fullGradient,
-          gradient, gradient0, effectiveBatchSize, stepSize);
+      instUpdate.Update(iterate, fullGradient, gradient, gradient0,
+          effectiveBatchSize, stepSize);
 
       terminate |= Callback::StepTaken(*this, function, iterate, callbacks...);
 
@@ -238,8 +309,8 @@ SVRGType<UpdatePolicyType, DecayPolicyType>::Optimize(
     }
 
     // Update the learning rate if requested by the user.
-    instDecayPolicy.As<InstDecayPolicyType>().Update(iterate, iterate0,
-        gradient, fullGradient, numBatches, stepSize);
+    instDecay.Update(iterate, iterate0, gradient, fullGradient, numBatches,
+        stepSize);
   }
 
   Info << "SVRG: maximum iterations (" << maxIterations << ") reached; "
@@ -248,19 +319,20 @@ SVRGType<UpdatePolicyType, DecayPolicyType>::Optimize(
   // Calculate final objective if exactObjective is set to true.
   if (exactObjective)
   {
-    overallObjective = 0;
+    // Hand the whole schedule to the function in one call, so functions that
+    // implement EvaluateBatch() can pipeline the pass internally.
+    std::vector<std::pair<size_t, size_t>> schedule;
+    schedule.reserve((numFunctions + batchSize - 1) / batchSize);
     for (size_t i = 0; i < numFunctions; i += batchSize)
-    {
-      const size_t effectiveBatchSize = std::min(batchSize, numFunctions - i);
-      const ElemType objective = function.Evaluate(iterate, i,
-          effectiveBatchSize);
-      overallObjective += objective;
+      schedule.push_back(std::make_pair(i,
+          std::min(batchSize, numFunctions - i)));
 
-      // The optimization is finished, so it doesn't matter what the callback
-      // returns.
-      (void) Callback::Evaluate(*this, function, iterate, objective,
-          callbacks...);
-    }
+    overallObjective = function.EvaluateBatch(iterate, schedule);
+
+    // The optimization is finished, so it doesn't matter what the callback
+    // returns.
+    (void) Callback::Evaluate(*this, function, iterate, overallObjective,
+        callbacks...);
   }
 
   Callback::EndOptimization(*this, function, iterate, callbacks...);
@@ -110,8 +110,6 @@ class SWATSUpdate
     {
       m.zeros(rows, cols);
       v.zeros(rows, cols);
-
-      sgdV.zeros(rows, cols);
     }
 
     /**
@@ -139,23 +137,38 @@ class SWATSUpdate
         return;
       }
 
-      m *= parent.beta1;
-      m += (1 - parent.beta1) * gradient;
-
-      v *= parent.beta2;
-      v += (1 - parent.beta2) * (gradient % gradient);
-
       const double biasCorrection1 = 1.0 - std::pow(parent.beta1, iteration);
       const double biasCorrection2 = 1.0 - std::pow(parent.beta2, iteration);
 
-      GradType delta = stepSize * m / biasCorrection1 /
-          (arma::sqrt(v / biasCorrection2) + parent.epsilon);
-      iterate -= delta;
+      // One fused pass over the buffers: update both moments, apply the
+      // step, and accumulate the two scalar sums the switching criterion
+      // needs, instead of materializing the step into a temporary and
+      // traversing it again for each dot product.
+      typedef typename GradType::elem_type GradElemType;
+      GradElemType* mIt = m.memptr();
+      GradElemType* vIt = v.memptr();
+      GradElemType* iterateIt = iterate.memptr();
+      const GradElemType* gradientIt = gradient.memptr();
+
+      double deltaGradient = 0;
+      double deltaSquared = 0;
+      for (arma::uword i = 0; i < gradient.n_elem; ++i)
+      {
+        const GradElemType g = gradientIt[i];
+        mIt[i] = parent.beta1 * mIt[i] + (1 - parent.beta1) * g;
+        vIt[i] = parent.beta2 * vIt[i] + (1 - parent.beta2) * g * g;
+
+        const double delta = stepSize * (mIt[i] / biasCorrection1) /
+            (std::sqrt(vIt[i] / biasCorrection2) + parent.epsilon);
+        iterateIt[i] -= (GradElemType) delta;
+
+        deltaGradient += delta * g;
+        deltaSquared += delta * delta;
+      }
 
-      const double deltaGradient = arma::dot(delta, gradient);
       if (deltaGradient != 0)
       {
-        const double rate = arma::dot(delta, delta) / deltaGradient;
+        const double rate = deltaSquared / deltaGradient;
         parent.sgdLambda = parent.beta2 * parent.sgdLambda +
             (1 - parent.beta2) * rate;
         parent.sgdRate = parent.sgdLambda / biasCorrection2;
@@ -163,7 +176,11 @@ class SWATSUpdate
         if (std::abs(parent.sgdRate - rate) < parent.epsilon && iteration > 1)
         {
           parent.phaseSGD = true;
+          // The SGD phase only uses v (as its momentum buffer); release the
+          // first-moment buffer so the SGD phase runs with a minimal
+          // footprint.
           v.zeros();
+          m.reset();
         }
       }
     }
@@ -175,12 +192,10 @@ class SWATSUpdate
     //! The exponential moving average of gradient values.
     GradType m;
 
-    //! The exponential moving average of squared gradient values (Adam).
+    //! The exponential moving average of squared gradient values (Adam);
+    //! reused as the momentum buffer of the SGD phase after the switch.
     GradType v;
 
-    //! The exponential moving average of squared gradient values (SGD).
-    GradType sgdV;
-
     //! The number of iterations.
     size_t iteration;
   };
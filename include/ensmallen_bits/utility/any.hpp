@@ -14,15 +14,28 @@
 #ifndef ENSMALLEN_UTILITY_ANY_HPP
 #define ENSMALLEN_UTILITY_ANY_HPP
 
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <string>
 #include <typeinfo>
 #include <typeindex>
+#include <type_traits>
+#include <utility>
 
 namespace ens {
 
 /**
- * A utility class that can hold any C++ class as a void*.  It does some very
- * basic type checking to ensure that you cast it correctly.  If you call
- * Clean(), it will properly call the destructor on the given type.
+ * A utility class that can hold any C++ class.  It does some very basic type
+ * checking to ensure that you cast it correctly.  If you call Clean(), it will
+ * properly call the destructor on the given type.
+ *
+ * Objects created with Emplace() that fit into the internal buffer are stored
+ * inline in the Any itself, so optimizers that keep their instantiated
+ * update/decay policies in an Any avoid a heap allocation and a pointer
+ * indirection; larger objects fall back to the heap transparently.  Since the
+ * typeid check in As<T>() has a cost, hot loops should call As<T>() once and
+ * keep the returned reference.
  *
  * The Any is holding nothing if Has<void>() returns true.
  */
@@ -35,11 +48,82 @@ class Any
   Any() :
       held(NULL),
       type(typeid(void)),
-      destructor([](const void*) {}) // Fake destructor.
+      destructor([](const void*) {}), // Fake destructor.
+      cloner(NULL)
   {
     // Nothing to do.
   }
 
+  /**
+   * Copy another Any; the held object (if any) is copied with its copy
+   * constructor, into this Any's buffer if it fits there.
+   */
+  Any(const Any& other) :
+      held(NULL),
+      type(other.type),
+      destructor(other.destructor),
+      cloner(other.cloner)
+  {
+    if (other.held)
+      held = other.cloner(other.held, (void*) &buffer, &destructor);
+  }
+
+  /**
+   * Replace the held object with a copy of whatever the other Any holds.
+   */
+  Any& operator=(const Any& other)
+  {
+    if (this != &other)
+    {
+      Clean();
+      type = other.type;
+      destructor = other.destructor;
+      cloner = other.cloner;
+      if (other.held)
+        held = other.cloner(other.held, (void*) &buffer, &destructor);
+    }
+    return *this;
+  }
+
+  /**
+   * Take over whatever the other Any holds, leaving it empty.  Heap objects
+   * are stolen by pointer; inline objects are copied into this Any's buffer
+   * (they are guaranteed to fit) and destroyed in the source.
+   */
+  Any(Any&& other) :
+      held(NULL),
+      type(other.type),
+      destructor(other.destructor),
+      cloner(other.cloner)
+  {
+    MoveFrom(other);
+  }
+
+  /**
+   * Replace the held object with whatever the other Any holds, leaving the
+   * other Any empty.
+   */
+  Any& operator=(Any&& other)
+  {
+    if (this != &other)
+    {
+      Clean();
+      type = other.type;
+      destructor = other.destructor;
+      cloner = other.cloner;
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  /**
+   * Destroy the held object, if any.
+   */
+  ~Any()
+  {
+    Clean();
+  }
+
   /**
    * Get the Any, cast as the thing we want.
    */
@@ -79,7 +163,33 @@ class Any
   }
 
   /**
-   * Set the Any as the given type.
+   * Construct an object of the given type in place, replacing anything held
+   * before.  If the object fits into the internal buffer it is stored inline
+   * (no heap allocation); otherwise it is allocated on the heap.  A reference
+   * to the new object is returned, so callers can resolve the concrete type
+   * once and skip the typeid check of As<T>() afterwards.
+   */
+  template<typename T, typename... Args>
+  T& Emplace(Args&&... args)
+  {
+    Clean();
+
+    // Tag dispatch keeps the unused storage branch out of the instantiation,
+    // so the compiler never sees a placement new of an oversized type.
+    T* t = Construct<T>(
+        std::integral_constant<bool, FitsBuffer<T>::value>(),
+        std::forward<Args>(args)...);
+
+    type = std::type_index(typeid(T));
+    held = (void*) t;
+    cloner = &CloneHelper<T>;
+    return *t;
+  }
+
+  /**
+   * Set the Any as the given type.  The pointer must come from 'new', and the
+   * Any takes ownership of it; the object stays on the heap (use Emplace() to
+   * get inline storage).
    */
   template<typename T>
   void Set(T* t)
@@ -87,6 +197,7 @@ class Any
     type = std::type_index(typeid(T));
     held = (void*) t;
     destructor = [](const void* x) { delete static_cast<const T*>(x); };
+    cloner = &CloneHelper<T>;
   }
 
   /**
@@ -99,9 +210,9 @@ class Any
   }
 
   /**
-   * Call delete on the thing we are holding.  Be careful with this one.  It
-   * automatically does nothing if 'held' is NULL, but that's the only guarantee
-   * you get.  Also, I hope you used 'new' to make the thing you're holding.
+   * Destroy the thing we are holding.  Inline objects have their destructor
+   * called; heap objects are deleted.  It automatically does nothing if
+   * 'held' is NULL, but that's the only guarantee you get.
    */
   void Clean()
   {
@@ -111,16 +222,109 @@ class Any
       held = NULL;
       type = std::type_index(typeid(void));
       destructor = [](const void*) { }; // Fake destructor.
+      cloner = NULL;
     }
   }
 
  private:
+  //! Shared tail of the move constructor and move assignment: this Any has
+  //! already taken the other's type/destructor/cloner and holds nothing.
+  void MoveFrom(Any& other)
+  {
+    if (other.held == (void*) &other.buffer)
+    {
+      // An inline object cannot be stolen by pointer; clone it into this
+      // Any's buffer and destroy the source's copy.
+      held = other.cloner(other.held, (void*) &buffer, &destructor);
+      other.Clean();
+    }
+    else if (other.held)
+    {
+      held = other.held;
+      other.held = NULL;
+      other.type = std::type_index(typeid(void));
+      other.destructor = [](const void*) { }; // Fake destructor.
+      other.cloner = NULL;
+    }
+  }
+
+  //! The size of the inline buffer; large enough for the instantiated
+  //! update/decay policies of the optimizers, which typically hold a couple
+  //! of matrices and a reference to their parent policy.
+  static const size_t BufferSize = 256;
+
+  //! Whether objects of the given type can live in the inline buffer.
+  template<typename T>
+  struct FitsBuffer
+  {
+    static const bool value = (sizeof(T) <= BufferSize) && (alignof(T) <=
+        alignof(typename std::aligned_storage<BufferSize>::type));
+  };
+
+  /**
+   * Copy the given object; into the given buffer if it fits there, otherwise
+   * onto the heap.  Stored as a function pointer so that the copy constructor
+   * of Any can clone a held object whose type it does not know.  The matching
+   * destructor is written to 'dtorOut', since the copy may move a heap object
+   * of the source (stored there via Set()) into the destination's buffer.
+   */
+  template<typename T>
+  static void* CloneHelper(const void* x,
+                           void* buffer,
+                           void (**dtorOut)(const void*))
+  {
+    return Clone<T>(std::integral_constant<bool, FitsBuffer<T>::value>(), x,
+        buffer, dtorOut);
+  }
+
+  //! Clone into the inline buffer of the destination.
+  template<typename T>
+  static void* Clone(std::true_type,
+                     const void* x,
+                     void* buffer,
+                     void (**dtorOut)(const void*))
+  {
+    *dtorOut = [](const void* p) { static_cast<const T*>(p)->~T(); };
+    return new (buffer) T(*static_cast<const T*>(x));
+  }
+
+  //! Clone onto the heap; the object does not fit into the inline buffer.
+  template<typename T>
+  static void* Clone(std::false_type,
+                     const void* x,
+                     void* /* buffer */,
+                     void (**dtorOut)(const void*))
+  {
+    *dtorOut = [](const void* p) { delete static_cast<const T*>(p); };
+    return new T(*static_cast<const T*>(x));
+  }
+
+  //! Construct into the inline buffer.
+  template<typename T, typename... Args>
+  T* Construct(std::true_type, Args&&... args)
+  {
+    destructor = [](const void* x) { static_cast<const T*>(x)->~T(); };
+    return new ((void*) &buffer) T(std::forward<Args>(args)...);
+  }
+
+  //! Construct on the heap; the object does not fit into the inline buffer.
+  template<typename T, typename... Args>
+  T* Construct(std::false_type, Args&&... args)
+  {
+    destructor = [](const void* x) { delete static_cast<const T*>(x); };
+    return new T(std::forward<Args>(args)...);
+  }
+
   // The thing we are holding.
   void* held;
   // The type of the thing we are holding.
   std::type_index type;
   // A pointer to the destructor.
   void (*destructor)(const void*);
+  // A pointer to the copy helper, for copying Any objects.
+  void* (*cloner)(const void*, void*, void (**)(const void*));
+  // Inline storage for small objects.
+  typename std::aligned_storage<BufferSize>::type buffer;
 };
 
 } // namespace ens
@@ -148,6 +148,42 @@ struct IsArmaType<arma::subview_cube<eT> >
 };
 
 
+/**
+ * If value == true, then MatType is a Bandicoot (GPU) matrix or vector type.
+ * Bandicoot support is optional---define ENS_USE_COOT before including
+ * ensmallen.hpp (with Bandicoot installed) to enable coot::mat iterates in
+ * the SGD family.  The unspecialized trait is always defined, so optimizers
+ * can test it without preprocessor guards.
+ */
+template<typename MatType>
+struct IsCootType
+{
+  const static bool value = false;
+};
+
+#ifdef ENS_USE_COOT
+
+template<typename eT>
+struct IsCootType<coot::Mat<eT> >
+{
+  const static bool value = true;
+};
+
+template<typename eT>
+struct IsCootType<coot::Col<eT> >
+{
+  const static bool value = true;
+};
+
+template<typename eT>
+struct IsCootType<coot::Row<eT> >
+{
+  const static bool value = true;
+};
+
+#endif
+
+
 template <int N, typename... T>
 struct tuple_element;
 
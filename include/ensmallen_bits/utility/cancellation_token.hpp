@@ -0,0 +1,54 @@
+/**
+ * @file cancellation_token.hpp
+ * @author Ryan Curtin
+ *
+ * A shared token for cooperatively cancelling running optimizations from
+ * another thread.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_UTILITY_CANCELLATION_TOKEN_HPP
+#define ENSMALLEN_UTILITY_CANCELLATION_TOKEN_HPP
+
+#include <atomic>
+#include <memory>
+
+namespace ens {
+
+/**
+ * A cooperative cancellation token: copies of a token share one atomic flag,
+ * so an external scheduler can hold a copy and call Cancel() from another
+ * thread while an optimization that polls the token (see the
+ * CancellationStop callback) shuts down at the next poll, leaving its
+ * iterate in a consistent state.  Polling is a single relaxed atomic load,
+ * so it can be done at evaluation granularity with no measurable overhead.
+ */
+class CancellationToken
+{
+ public:
+  //! Construct a token with its own (uncancelled) flag.
+  CancellationToken() :
+      cancelled(std::make_shared<std::atomic<bool>>(false))
+  { /* Nothing to do here. */ }
+
+  //! Request cancellation; every copy of the token observes it.
+  void Cancel() { cancelled->store(true, std::memory_order_relaxed); }
+
+  //! Re-arm the token so it can be used for another optimization.
+  void Reset() { cancelled->store(false, std::memory_order_relaxed); }
+
+  //! Poll the token; a single relaxed atomic load.
+  bool Cancelled() const
+  { return cancelled->load(std::memory_order_relaxed); }
+
+ private:
+  //! The flag shared by all copies of the token.
+  std::shared_ptr<std::atomic<bool>> cancelled;
+};
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,118 @@
+/**
+ * @file coarse_clock.hpp
+ * @author Marcus Edel
+ *
+ * A coarse shared tick source: a background thread periodically publishes the
+ * elapsed time into an atomic, so hot loops can read the time with one
+ * relaxed atomic load instead of a clock syscall.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_UTILITY_COARSE_CLOCK_HPP
+#define ENSMALLEN_UTILITY_COARSE_CLOCK_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace ens {
+
+/**
+ * A process-wide coarse clock.  A background thread samples the steady clock
+ * once per millisecond and publishes the elapsed nanoseconds into an atomic;
+ * Now() is then a single relaxed atomic load, which makes it cheap enough to
+ * call on every optimizer step even at very high step rates, where a clock
+ * syscall per step shows up in profiles.
+ *
+ * The price is resolution: two calls to Now() less than the tick period
+ * (one millisecond) apart may return the same value.  That is ample for
+ * duration-based stopping and ETA display; code that needs precise
+ * per-interval timing should keep using arma::wall_clock.
+ *
+ * The background thread is started lazily on the first use and joined at
+ * process exit.
+ */
+class CoarseClock
+{
+ public:
+  //! Get the process-wide clock instance, starting it on the first call.
+  static CoarseClock& Get()
+  {
+    static CoarseClock clock;
+    return clock;
+  }
+
+  //! Get the seconds elapsed since the clock was started, at tick
+  //! resolution; costs one relaxed atomic load.
+  double Now() const
+  {
+    return (double) elapsedNs.load(std::memory_order_relaxed) * 1e-9;
+  }
+
+  // The ticker thread holds a pointer to this object, so it may not move.
+  CoarseClock(const CoarseClock&) = delete;
+  CoarseClock& operator=(const CoarseClock&) = delete;
+
+ private:
+  //! Start the ticker thread.
+  CoarseClock() :
+      start(std::chrono::steady_clock::now()),
+      elapsedNs(0),
+      done(false),
+      ticker(&CoarseClock::Tick, this)
+  { /* Nothing to do here. */ }
+
+  //! Stop and join the ticker thread.
+  ~CoarseClock()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      done = true;
+    }
+    wakeup.notify_all();
+    ticker.join();
+  }
+
+  //! The ticker thread procedure: publish the elapsed time once per
+  //! millisecond until the destructor signals shutdown.
+  void Tick()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!done)
+    {
+      elapsedNs.store((uint64_t) std::chrono::duration_cast<
+          std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start).count(),
+          std::memory_order_relaxed);
+
+      wakeup.wait_for(lock, std::chrono::milliseconds(1));
+    }
+  }
+
+  //! The instant the clock was started.
+  std::chrono::steady_clock::time_point start;
+
+  //! The published elapsed time in nanoseconds.
+  std::atomic<uint64_t> elapsedNs;
+
+  //! Set by the destructor to stop the ticker thread.
+  bool done;
+
+  //! Protects `done` and carries the shutdown notification.
+  std::mutex mutex;
+
+  //! Wakes the ticker thread up early on shutdown.
+  std::condition_variable wakeup;
+
+  //! The background ticker thread.
+  std::thread ticker;
+};
+
+} // namespace ens
+
+#endif
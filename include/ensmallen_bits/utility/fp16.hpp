@@ -0,0 +1,109 @@
+/**
+ * @file fp16.hpp
+ * @author Marcus Edel
+ *
+ * Software conversion between IEEE 754 binary16 (half precision) and single
+ * precision, used for packed half-precision storage of optimizer state.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_UTILITY_FP16_HPP
+#define ENSMALLEN_UTILITY_FP16_HPP
+
+namespace ens {
+
+/**
+ * Convert a single-precision value to its IEEE 754 binary16 bit pattern,
+ * rounding to nearest even.  Values beyond the half-precision range map to
+ * +/-Inf; NaNs stay NaNs.
+ */
+inline arma::u16 ToFp16(const float value)
+{
+  arma::u32 f;
+  std::memcpy(&f, &value, sizeof(f));
+
+  const arma::u32 sign = (f >> 16) & 0x8000;
+  f &= 0x7FFFFFFF;
+
+  // Inf and NaN map to their half-precision counterparts.
+  if (f >= 0x7F800000)
+    return (arma::u16) (sign | 0x7C00 | ((f & 0x7FFFFF) ? 0x0200 : 0));
+
+  // Values that round to at least 2^16 become Inf (0x477FF000 is 65520).
+  if (f >= 0x477FF000)
+    return (arma::u16) (sign | 0x7C00);
+
+  if (f < 0x38800000)
+  {
+    // Subnormal half or zero.  Below half the smallest subnormal
+    // (2^-25, 0x33000000), everything rounds to zero.
+    if (f < 0x33000000)
+      return (arma::u16) sign;
+
+    // Shift the mantissa (with the implicit bit) into the subnormal
+    // position and round to nearest even.
+    const arma::u32 shift = 126 - (f >> 23);
+    const arma::u32 mant = (f & 0x7FFFFF) | 0x800000;
+    arma::u32 h = mant >> shift;
+    const arma::u32 rem = mant & ((1u << shift) - 1);
+    const arma::u32 halfway = 1u << (shift - 1);
+    if (rem > halfway || (rem == halfway && (h & 1)))
+      ++h;
+    return (arma::u16) (sign | h);
+  }
+
+  // Normal half: round the mantissa to 10 bits (to nearest even; the carry
+  // may ripple into the exponent, which is exactly what rounding up to the
+  // next binade requires), then re-bias the exponent.
+  const arma::u32 rounded = f + 0xFFF + ((f >> 13) & 1);
+  return (arma::u16) (sign | (((rounded - 0x38000000) >> 13) & 0x7FFF));
+}
+
+/**
+ * Convert an IEEE 754 binary16 bit pattern to the single-precision value it
+ * represents.  The conversion is exact: every half-precision value is
+ * representable in single precision.
+ */
+inline float FromFp16(const arma::u16 value)
+{
+  const arma::u32 sign = ((arma::u32) value & 0x8000) << 16;
+  const arma::u32 exp = ((arma::u32) value >> 10) & 0x1F;
+  const arma::u32 mant = (arma::u32) value & 0x3FF;
+
+  arma::u32 f;
+  if (exp == 0x1F)
+  {
+    // Inf or NaN.
+    f = sign | 0x7F800000 | (mant << 13);
+  }
+  else if (exp != 0)
+  {
+    // Normal value: re-bias the exponent.
+    f = sign | ((exp + 112) << 23) | (mant << 13);
+  }
+  else if (mant != 0)
+  {
+    // Subnormal half: normalize the mantissa into a single-precision
+    // normal value.
+    int p = 9;
+    while (!(mant & (1u << p)))
+      --p;
+    f = sign | ((arma::u32) (p + 103) << 23) | ((mant << (23 - p)) & 0x7FFFFF);
+  }
+  else
+  {
+    // Zero (possibly negative).
+    f = sign;
+  }
+
+  float result;
+  std::memcpy(&result, &f, sizeof(result));
+  return result;
+}
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,263 @@
+/**
+ * @file halton_sequence.hpp
+ * @author Marcus Edel
+ *
+ * A scrambled Halton low-discrepancy sequence for quasi-random population
+ * initialization.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_UTILITY_HALTON_SEQUENCE_HPP
+#define ENSMALLEN_UTILITY_HALTON_SEQUENCE_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "philox_generator.hpp"
+
+namespace ens {
+
+/**
+ * A scrambled Halton low-discrepancy sequence.  The d-th dimension uses the
+ * van der Corput radical inverse in the d-th prime base, so the generator
+ * works for any number of dimensions without precomputed tables; a random
+ * digital shift (Cranley-Patterson rotation) per dimension removes the
+ * correlation artifacts of the unscrambled sequence in high dimensions and
+ * makes independent, seedable replications possible.
+ *
+ * Points drawn from the sequence cover the unit cube far more evenly than
+ * pseudo-random draws, which is useful for initializing the populations of
+ * evolutionary optimizers: every region of the search space receives a
+ * candidate even with small population sizes.  Like PhiloxGenerator, the
+ * state is per-instance, and successive calls continue the sequence instead
+ * of restarting it.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @article{Halton1960,
+ *   author  = {Halton, John H.},
+ *   title   = {On the efficiency of certain quasi-random sequences of points
+ *              in evaluating multi-dimensional integrals},
+ *   journal = {Numerische Mathematik},
+ *   volume  = {2},
+ *   year    = {1960}
+ * }
+ * @endcode
+ */
+class HaltonSequence
+{
+ public:
+  /**
+   * Construct a sequence whose scrambling shifts are seeded from
+   * std::random_device.  Use the seeded constructor for reproducible runs.
+   */
+  HaltonSequence() : index(0)
+  { /* Nothing to do. */ }
+
+  /**
+   * Construct a sequence with reproducible scrambling shifts.
+   *
+   * @param seed Seed for the generator producing the per-dimension shifts.
+   */
+  HaltonSequence(const uint64_t seed) : generator(seed), index(0)
+  { /* Nothing to do. */ }
+
+  /**
+   * Fill the given matrix with points of the sequence, one point per column;
+   * the number of rows is the dimensionality.  Every element lies in [0, 1).
+   *
+   * @param sequence Matrix to fill (its size determines dimensions/points).
+   */
+  template<typename MatType>
+  void Uniform(MatType& sequence)
+  {
+    Fill(sequence.memptr(), sequence.n_rows, sequence.n_cols);
+  }
+
+  /**
+   * Fill the given cube with points of the sequence, one point per slice;
+   * the slice size is the dimensionality.  Every element lies in [0, 1).
+   *
+   * @param sequence Cube to fill (its size determines dimensions/points).
+   */
+  template<typename eT>
+  void Uniform(arma::Cube<eT>& sequence)
+  {
+    Fill(sequence.memptr(), sequence.n_rows * sequence.n_cols,
+        sequence.n_slices);
+  }
+
+  /**
+   * Fill the given matrix with quasi-random standard Gaussian variates, one
+   * point per column: uniform points of the sequence mapped through the
+   * inverse normal CDF, which preserves their low discrepancy.
+   *
+   * @param sequence Matrix to fill (its size determines dimensions/points).
+   */
+  template<typename MatType>
+  void Randn(MatType& sequence)
+  {
+    Uniform(sequence);
+    UniformToGaussian(sequence.memptr(), sequence.n_elem);
+  }
+
+  /**
+   * Fill the given cube with quasi-random standard Gaussian variates, one
+   * point per slice.
+   *
+   * @param sequence Cube to fill (its size determines dimensions/points).
+   */
+  template<typename eT>
+  void Randn(arma::Cube<eT>& sequence)
+  {
+    Uniform(sequence);
+    UniformToGaussian(sequence.memptr(), sequence.n_elem);
+  }
+
+ private:
+  /**
+   * Fill column-major storage of the given shape with the next `count`
+   * points of the sequence.
+   */
+  template<typename ElemType>
+  void Fill(ElemType* mem, const size_t dims, const size_t count)
+  {
+    EnsureDimensions(dims);
+
+    // The index is advanced before the (parallelizable) per-dimension loop;
+    // each dimension only reads the shared state.
+    const size_t start = index + 1;  // Skip the origin at index 0.
+    index += count;
+
+    ENS_PRAGMA_OMP_PARALLEL_FOR_THREADS(
+        (int) ParallelRuntime::Get().RegionThreads())
+    for (ptrdiff_t d = 0; d < (ptrdiff_t) dims; ++d)
+    {
+      const size_t base = primes[d];
+      const double shift = shifts[d];
+
+      for (size_t j = 0; j < count; ++j)
+      {
+        // Van der Corput radical inverse of (start + j) in the given base.
+        double value = 0.0, f = 1.0;
+        size_t n = start + j;
+        while (n > 0)
+        {
+          f /= base;
+          value += f * (n % base);
+          n /= base;
+        }
+
+        // Apply the random shift modulo 1.
+        value += shift;
+        mem[j * dims + d] = (ElemType) (value - std::floor(value));
+      }
+    }
+  }
+
+  /**
+   * Map uniform [0, 1) variates to standard Gaussians in place, using
+   * Acklam's rational approximation to the inverse normal CDF (relative
+   * error below 1.2e-9).
+   */
+  template<typename ElemType>
+  static void UniformToGaussian(ElemType* mem, const size_t n)
+  {
+    ENS_PRAGMA_OMP_PARALLEL_FOR_THREADS(
+        (int) ParallelRuntime::Get().RegionThreads())
+    for (ptrdiff_t i = 0; i < (ptrdiff_t) n; ++i)
+    {
+      // Keep the argument strictly inside (0, 1).
+      const double p = std::min(std::max((double) mem[i], 1e-12),
+          1.0 - 1e-12);
+      mem[i] = (ElemType) InverseNormalCDF(p);
+    }
+  }
+
+  //! Acklam's rational approximation to the inverse standard normal CDF.
+  static double InverseNormalCDF(const double p)
+  {
+    static const double a[] = { -3.969683028665376e+01, 2.209460984245205e+02,
+        -2.759285104469687e+02, 1.383577518672690e+02, -3.066479806614716e+01,
+        2.506628277459239e+00 };
+    static const double b[] = { -5.447609879822406e+01, 1.615858368580409e+02,
+        -1.556989798598866e+02, 6.680131188771972e+01,
+        -1.328068155288572e+01 };
+    static const double c[] = { -7.784894002430293e-03,
+        -3.223964580411365e-01, -2.400758277161838e+00,
+        -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00 };
+    static const double d[] = { 7.784695709041462e-03, 3.224671290700398e-01,
+        2.445134137142996e+00, 3.754408661907416e+00 };
+
+    const double pLow = 0.02425;
+    if (p < pLow)
+    {
+      // Lower tail.
+      const double q = std::sqrt(-2.0 * std::log(p));
+      return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q +
+          c[5]) / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+    else if (p <= 1.0 - pLow)
+    {
+      // Central region.
+      const double q = p - 0.5;
+      const double r = q * q;
+      return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r +
+          a[5]) * q /
+          (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+    }
+
+    // Upper tail.
+    const double q = std::sqrt(-2.0 * std::log(1.0 - p));
+    return -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q +
+        c[5]) / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+  }
+
+  //! Extend the cached prime bases and scrambling shifts to `dims` entries.
+  void EnsureDimensions(const size_t dims)
+  {
+    while (primes.size() < dims)
+    {
+      size_t candidate = primes.empty() ? 2 : primes.back() + 1;
+      for (; ; ++candidate)
+      {
+        bool isPrime = true;
+        for (size_t f = 2; f * f <= candidate; ++f)
+        {
+          if (candidate % f == 0)
+          {
+            isPrime = false;
+            break;
+          }
+        }
+
+        if (isPrime)
+          break;
+      }
+
+      primes.push_back(candidate);
+      shifts.push_back(generator.Uniform());
+    }
+  }
+
+  //! Generator for the per-dimension scrambling shifts.
+  PhiloxGenerator generator;
+
+  //! Number of points handed out so far.
+  size_t index;
+
+  //! Cached prime bases, one per dimension.
+  std::vector<size_t> primes;
+
+  //! Cached random shifts, one per dimension.
+  std::vector<double> shifts;
+};
+
+} // namespace ens
+
+#endif
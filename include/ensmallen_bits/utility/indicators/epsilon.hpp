@@ -20,11 +20,11 @@ namespace ens {
 
 /**
  * The epsilon indicator is one of the binary quality indicators that was proposed by
- * Zitzler et. al.. The indicator originally calculates a weak dominance relation 
- * between two approximation sets. It returns "epsilon" which is the factor by which 
- * the given approximation set is worse than the reference front with respect to 
+ * Zitzler et. al.. The indicator originally calculates a weak dominance relation
+ * between two approximation sets. It returns "epsilon" which is the factor by which
+ * the given approximation set is worse than the reference front with respect to
  * all the objectives.
- * 
+ *
  * \f[ I_{\epsilon}(A,B) = \max_{z^2 \in B} \
  *                \min_{z^1 \in A} \
  *                \max_{1 \leq i \leq n} \ \frac{z^1_i}{z^2_i}\
@@ -54,7 +54,8 @@ namespace ens {
 
     /**
      * Find the epsilon value of the front with respect to the given reference
-     * front.
+     * front.  The slices are packed into contiguous objectives-by-points
+     * matrices and the matrix overload below does the work.
      *
      * @tparam CubeType The cube data type of front.
      * @param front The given approximation front.
@@ -62,29 +63,128 @@ namespace ens {
      * @return The epsilon value of the front.
      */
     template<typename CubeType>
-    static typename CubeType::elem_type Evaluate(const CubeType& front,
-                                                 const CubeType& referenceFront)
+    static typename std::enable_if<!arma::is_arma_type<CubeType>::value,
+        typename CubeType::elem_type>::type
+    Evaluate(const CubeType& front, const CubeType& referenceFront)
     {
       // Convenience typedefs.
       typedef typename CubeType::elem_type ElemType;
-      ElemType eps = 0;
+
+      arma::Mat<ElemType> frontMat(front.n_rows * front.n_cols,
+          front.n_slices);
+      for (size_t j = 0; j < front.n_slices; j++)
+        frontMat.col(j) = arma::vectorise(front.slice(j));
+
+      arma::Mat<ElemType> referenceFrontMat(
+          referenceFront.n_rows * referenceFront.n_cols,
+          referenceFront.n_slices);
       for (size_t i = 0; i < referenceFront.n_slices; i++)
+        referenceFrontMat.col(i) = arma::vectorise(referenceFront.slice(i));
+
+      return Evaluate(frontMat, referenceFrontMat);
+    }
+
+    /**
+     * Find the epsilon value of the front with respect to the given reference
+     * front, both stored as contiguous matrices with one point per column.
+     * The objective ratios of the whole front against a reference point are
+     * computed as batched column operations on a reused buffer instead of
+     * scalar loops over every point pair.
+     *
+     * @tparam MatType The matrix data type of the front.
+     * @param front The given approximation front, one point per column.
+     * @param referenceFront The given reference front, one point per column.
+     * @return The epsilon value of the front.
+     */
+    template<typename MatType>
+    static typename std::enable_if<arma::is_arma_type<MatType>::value,
+        typename MatType::elem_type>::type
+    Evaluate(const MatType& front, const MatType& referenceFront)
+    {
+      // Convenience typedefs.
+      typedef typename MatType::elem_type ElemType;
+
+      ElemType eps = 0;
+      MatType ratio(front.n_rows, front.n_cols);
+      for (size_t i = 0; i < referenceFront.n_cols; i++)
       {
-        ElemType epsjMin = std::numeric_limits<ElemType>::max();
-        for (size_t j = 0; j < front.n_slices; j++)
-        {
-          arma::Mat<ElemType> frontRatio = front.slice(j) / referenceFront.slice(i);
-          frontRatio.replace(arma::datum::inf, -1.); // Handle zero division case.
-          ElemType epsj = frontRatio.max();
-          if (epsj < epsjMin)
-            epsjMin = epsj;
-        }
+        ratio = front;
+        ratio.each_col() /= referenceFront.col(i);
+        ratio.replace(arma::datum::inf, -1.); // Handle zero division case.
+        const ElemType epsjMin = arma::min(arma::max(ratio, 0));
         if (epsjMin > eps)
           eps = epsjMin;
       }
 
       return eps;
     }
+
+    /**
+     * Incrementally maintained epsilon value.  The smallest worst-objective
+     * ratio of the front against each reference point is cached, and Update()
+     * folds new or changed front members into the cache, so only the ratios
+     * involving those members are recomputed.  Removing members from the
+     * front invalidates the cached minima; call Reset() and fold the
+     * remaining front back in for that case.
+     *
+     * @tparam MatType The matrix data type of the front.
+     */
+    template<typename MatType>
+    class Incremental
+    {
+     public:
+      // Convenience typedef.
+      typedef typename MatType::elem_type ElemType;
+
+      /**
+       * Construct the incremental evaluator for the given reference front
+       * (one point per column).
+       *
+       * @param referenceFront The reference front, one point per column.
+       */
+      Incremental(const MatType& referenceFront) :
+          referenceFront(referenceFront)
+      {
+        Reset();
+      }
+
+      /**
+       * Fold new or changed front members (one point per column) into the
+       * cached per-reference ratio minima.
+       *
+       * @param members The new or changed front members.
+       */
+      void Update(const MatType& members)
+      {
+        MatType ratio(members.n_rows, members.n_cols);
+        for (size_t i = 0; i < referenceFront.n_cols; i++)
+        {
+          ratio = members;
+          ratio.each_col() /= referenceFront.col(i);
+          ratio.replace(arma::datum::inf, -1.); // Handle zero division case.
+          const ElemType epsjMin = arma::min(arma::max(ratio, 0));
+          if (epsjMin < minRatios(i))
+            minRatios(i) = epsjMin;
+        }
+      }
+
+      //! The epsilon value of the front members folded in so far.
+      ElemType Value() const { return arma::max(minRatios); }
+
+      //! Forget all folded-in front members.
+      void Reset()
+      {
+        minRatios.set_size(referenceFront.n_cols);
+        minRatios.fill(std::numeric_limits<ElemType>::max());
+      }
+
+     private:
+      //! The reference front, one point per column.
+      MatType referenceFront;
+
+      //! The smallest worst-objective ratio seen for each reference point.
+      arma::Col<ElemType> minRatios;
+    };
   };
 
 } // namespace ens
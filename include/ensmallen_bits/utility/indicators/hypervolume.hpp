@@ -0,0 +1,289 @@
+/**
+ * @file hypervolume.hpp
+ * @author Marcus Edel
+ *
+ * Hypervolume indicator using the WFG algorithm.
+ * The volume of objective space dominated by a front, measured against a
+ * reference point.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef ENSMALLEN_INDICATORS_HYPERVOLUME_HPP
+#define ENSMALLEN_INDICATORS_HYPERVOLUME_HPP
+
+namespace ens {
+
+/**
+ * The hypervolume indicator measures the volume of the objective-space
+ * region that is dominated by the front and bounded by a reference point
+ * (assuming minimization of all objectives).  It is the only widely used
+ * indicator that is strictly monotonic with respect to Pareto dominance,
+ * which makes it a common acceptance criterion.
+ *
+ * The implementation follows the WFG algorithm: the hypervolume is the sum
+ * of the exclusive contributions of the points, and each exclusive
+ * contribution is the volume of the point's own box minus the hypervolume
+ * of the remaining points limited to that box.  The recursion operates on
+ * contiguous objectives-by-points matrices throughout; the cost grows
+ * exponentially with the number of objectives, but stays acceptable for the
+ * typical up-to-six-objective fronts.
+ *
+ * For more information see:
+ *
+ * @code
+ * @article{While2012,
+ *   author  = {While, Lyndon and Bradstreet, Lucas and Barone, Luigi},
+ *   title   = {A Fast Way of Calculating Exact Hypervolumes},
+ *   journal = {IEEE Transactions on Evolutionary Computation},
+ *   year    = {2012},
+ *   volume  = {16},
+ *   number  = {1},
+ *   pages   = {86--95}
+ * }
+ * @endcode
+ */
+  class Hypervolume
+  {
+   public:
+    /**
+     * Default constructor does nothing, but is required to satisfy the
+     * Indicator policy.
+     */
+    Hypervolume() { }
+
+    /**
+     * Find the hypervolume of the front with respect to the given reference
+     * point.  The slices are packed into a contiguous objectives-by-points
+     * matrix and the matrix overload below does the work.
+     *
+     * @tparam CubeType The cube data type of front.
+     * @param front The given approximation front.
+     * @param referencePoint The reference point bounding the volume.
+     * @return The hypervolume of the front.
+     */
+    template<typename CubeType>
+    static typename std::enable_if<!arma::is_arma_type<CubeType>::value,
+        typename CubeType::elem_type>::type
+    Evaluate(const CubeType& front,
+             const arma::Col<typename CubeType::elem_type>& referencePoint)
+    {
+      // Convenience typedefs.
+      typedef typename CubeType::elem_type ElemType;
+
+      arma::Mat<ElemType> frontMat(front.n_rows * front.n_cols,
+          front.n_slices);
+      for (size_t j = 0; j < front.n_slices; j++)
+        frontMat.col(j) = arma::vectorise(front.slice(j));
+
+      return Evaluate(frontMat, referencePoint);
+    }
+
+    /**
+     * Find the hypervolume of the front, stored as a contiguous matrix with
+     * one point per column, with respect to the given reference point.
+     * Points that fall outside the reference region are clipped to it, so
+     * they contribute only the part of their box that lies inside.
+     *
+     * @tparam MatType The matrix data type of the front.
+     * @param front The given approximation front, one point per column.
+     * @param referencePoint The reference point bounding the volume.
+     * @return The hypervolume of the front.
+     */
+    template<typename MatType>
+    static typename std::enable_if<arma::is_arma_type<MatType>::value,
+        typename MatType::elem_type>::type
+    Evaluate(const MatType& front,
+             const arma::Col<typename MatType::elem_type>& referencePoint)
+    {
+      // Convenience typedefs.
+      typedef typename MatType::elem_type ElemType;
+
+      if (front.n_cols == 0)
+        return 0;
+
+      // Process the points in order of descending first objective: the
+      // limited sets of the recursion then shrink as fast as possible,
+      // which is the main constant-factor lever of the WFG scheme.
+      const arma::uvec order = arma::sort_index(
+          front.row(0).t(), "descend");
+      arma::Mat<ElemType> sorted(front.n_rows, front.n_cols);
+      for (size_t j = 0; j < front.n_cols; j++)
+        sorted.col(j) = front.col(order(j));
+
+      return WFG(sorted, referencePoint);
+    }
+
+    /**
+     * Incrementally maintained hypervolume.  The current front is kept as a
+     * contiguous matrix together with its hypervolume; Update() folds new
+     * members in by adding their exclusive contributions, and Remove()
+     * subtracts the exclusive contribution of one member.  Both operations
+     * cost a single exclusive-contribution evaluation instead of a full
+     * recomputation, which makes the indicator usable as a per-generation
+     * early-stopping signal.
+     *
+     * @tparam MatType The matrix data type of the front.
+     */
+    template<typename MatType>
+    class Incremental
+    {
+     public:
+      // Convenience typedef.
+      typedef typename MatType::elem_type ElemType;
+
+      /**
+       * Construct the incremental evaluator for the given reference point.
+       *
+       * @param referencePoint The reference point bounding the volume.
+       */
+      Incremental(const arma::Col<ElemType>& referencePoint) :
+          referencePoint(referencePoint),
+          hypervolume(0)
+      { /* Nothing to do here. */ }
+
+      /**
+       * Fold new front members (one point per column) into the maintained
+       * front and hypervolume.
+       *
+       * @param members The new front members.
+       */
+      void Update(const MatType& members)
+      {
+        for (size_t j = 0; j < members.n_cols; j++)
+        {
+          const arma::Col<ElemType> point = members.col(j);
+          hypervolume += Exclusive(point, front, referencePoint);
+          front.insert_cols(front.n_cols, point);
+        }
+      }
+
+      /**
+       * Remove the given member from the maintained front, subtracting its
+       * exclusive contribution.
+       *
+       * @param index Column index of the member to remove.
+       */
+      void Remove(const size_t index)
+      {
+        const arma::Col<ElemType> point = front.col(index);
+        arma::Mat<ElemType> others = front;
+        others.shed_col(index);
+        hypervolume -= Exclusive(point, others, referencePoint);
+        front = std::move(others);
+      }
+
+      //! The hypervolume of the front members folded in so far.
+      ElemType Value() const { return hypervolume; }
+
+      //! The maintained front, one point per column.
+      const arma::Mat<ElemType>& Front() const { return front; }
+
+      //! Forget all folded-in front members.
+      void Reset()
+      {
+        front.set_size(referencePoint.n_elem, 0);
+        hypervolume = 0;
+      }
+
+     private:
+      //! The reference point bounding the volume.
+      arma::Col<ElemType> referencePoint;
+
+      //! The maintained front, one point per column.
+      arma::Mat<ElemType> front;
+
+      //! The hypervolume of the maintained front.
+      ElemType hypervolume;
+    };
+
+   private:
+    /**
+     * The WFG recursion: the hypervolume is the sum of the exclusive
+     * contributions of the points, each taken with respect to the points
+     * after it.
+     */
+    template<typename ElemType>
+    static ElemType WFG(const arma::Mat<ElemType>& front,
+                        const arma::Col<ElemType>& referencePoint)
+    {
+      ElemType hypervolume = 0;
+      for (size_t j = 0; j < front.n_cols; j++)
+      {
+        const arma::Col<ElemType> point = front.col(j);
+        const arma::Mat<ElemType> others = (j + 1 < front.n_cols) ?
+            arma::Mat<ElemType>(front.cols(j + 1, front.n_cols - 1)) :
+            arma::Mat<ElemType>(front.n_rows, 0);
+        hypervolume += Exclusive(point, others, referencePoint);
+      }
+
+      return hypervolume;
+    }
+
+    /**
+     * The exclusive contribution of a point with respect to a set of other
+     * points: the volume of the point's own box (clipped to the reference
+     * region) minus the hypervolume of the others limited to that box.
+     */
+    template<typename ElemType>
+    static ElemType Exclusive(const arma::Col<ElemType>& point,
+                              const arma::Mat<ElemType>& others,
+                              const arma::Col<ElemType>& referencePoint)
+    {
+      // The inclusive volume of the point's box; clipping at the reference
+      // point makes points outside the reference region contribute only
+      // the part of their box inside it (or nothing at all).
+      const arma::Col<ElemType> gap = arma::max(referencePoint - point,
+          arma::zeros<arma::Col<ElemType>>(referencePoint.n_elem));
+      const ElemType inclusive = arma::prod(gap);
+
+      if (inclusive == ElemType(0) || others.n_cols == 0)
+        return inclusive;
+
+      // Limit the other points to the part of the space dominated by the
+      // point's box, and drop the limited points that became dominated (or
+      // duplicated); this is what keeps the recursion shrinking.
+      arma::Mat<ElemType> limited = others;
+      limited.each_col([&point](arma::Col<ElemType>& other)
+          { other = arma::max(other, point); });
+      limited = NonDominated(limited);
+
+      return inclusive - WFG(limited, referencePoint);
+    }
+
+    /**
+     * Keep only the non-dominated points of the given set; of identical
+     * points, the first occurrence is kept.
+     */
+    template<typename ElemType>
+    static arma::Mat<ElemType> NonDominated(const arma::Mat<ElemType>& points)
+    {
+      arma::uvec keep(points.n_cols, arma::fill::ones);
+      for (size_t j = 0; j < points.n_cols; j++)
+      {
+        for (size_t k = 0; k < points.n_cols && keep(j); k++)
+        {
+          if (k == j || !keep(k))
+            continue;
+
+          // Is point j dominated by point k (or a duplicate of an earlier
+          // point k)?
+          const bool allBetterOrEqual =
+              arma::all(points.col(k) <= points.col(j));
+          const bool equal = allBetterOrEqual &&
+              arma::all(points.col(k) >= points.col(j));
+          if (allBetterOrEqual && (!equal || k < j))
+            keep(j) = 0;
+        }
+      }
+
+      return points.cols(arma::find(keep == 1));
+    }
+  };
+
+} // namespace ens
+
+#endif
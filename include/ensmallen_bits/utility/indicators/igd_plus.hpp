@@ -50,7 +50,8 @@ namespace ens {
 
     /**
      * Find the IGD+ value of the front with respect to the given reference
-     * front.
+     * front.  The slices are packed into contiguous objectives-by-points
+     * matrices and the matrix overload below does the work.
      *
      * @tparam CubeType The cube data type of front.
      * @param front The given approximation front.
@@ -58,37 +59,133 @@ namespace ens {
      * @return The IGD value of the front.
      */
     template<typename CubeType>
-    static typename CubeType::elem_type Evaluate(const CubeType& front,
-                                                 const CubeType& referenceFront)
+    static typename std::enable_if<!arma::is_arma_type<CubeType>::value,
+        typename CubeType::elem_type>::type
+    Evaluate(const CubeType& front, const CubeType& referenceFront)
     {
       // Convenience typedefs.
       typedef typename CubeType::elem_type ElemType;
-      ElemType igd = 0;
+
+      arma::Mat<ElemType> frontMat(front.n_rows * front.n_cols,
+          front.n_slices);
+      for (size_t j = 0; j < front.n_slices; j++)
+        frontMat.col(j) = arma::vectorise(front.slice(j));
+
+      arma::Mat<ElemType> referenceFrontMat(
+          referenceFront.n_rows * referenceFront.n_cols,
+          referenceFront.n_slices);
       for (size_t i = 0; i < referenceFront.n_slices; i++)
+        referenceFrontMat.col(i) = arma::vectorise(referenceFront.slice(i));
+
+      return Evaluate(frontMat, referenceFrontMat);
+    }
+
+    /**
+     * Find the IGD+ value of the front with respect to the given reference
+     * front, both stored as contiguous matrices with one point per column.
+     * The one-sided distances from a reference point to the whole front are
+     * computed as batched column operations on a reused buffer instead of
+     * scalar loops over every point pair.
+     *
+     * @tparam MatType The matrix data type of the front.
+     * @param front The given approximation front, one point per column.
+     * @param referenceFront The given reference front, one point per column.
+     * @return The IGD value of the front.
+     */
+    template<typename MatType>
+    static typename std::enable_if<arma::is_arma_type<MatType>::value,
+        typename MatType::elem_type>::type
+    Evaluate(const MatType& front, const MatType& referenceFront)
+    {
+      // Convenience typedefs.
+      typedef typename MatType::elem_type ElemType;
+
+      ElemType igd = 0;
+      MatType diff(front.n_rows, front.n_cols);
+      for (size_t i = 0; i < referenceFront.n_cols; i++)
       {
-        ElemType min = std::numeric_limits<ElemType>::max();
-        for (size_t j = 0; j < front.n_slices; j++)
-        {
-          ElemType dist = 0;
-          for (size_t k = 0; k < front.slice(j).n_rows; k++)
-          {
-            ElemType z = referenceFront(k, 0, i);
-            ElemType a = front(k, 0, j);
-            // Assuming minimization of all objectives.
-            dist += std::pow(std::max<ElemType>(a - z, 0), 2);
-          }
-          dist = std::sqrt(dist);
-          if (dist < min)
-            min = dist;
-        }
-        igd += min;
+        diff = front;
+        diff.each_col() -= referenceFront.col(i);
+        // Assuming minimization of all objectives: components where the
+        // solution is better than the reference do not contribute.
+        diff.elem(arma::find(diff < 0)).zeros();
+        igd += std::sqrt((ElemType) arma::min(
+            arma::sum(arma::square(diff), 0)));
       }
-      igd /= referenceFront.n_slices;
+      igd /= referenceFront.n_cols;
 
       return igd;
     }
+
+    /**
+     * Incrementally maintained IGD+ value.  The nearest one-sided distance of
+     * each reference point to the front is cached, and Update() folds new or
+     * changed front members into the cache, so only the distances involving
+     * those members are recomputed.  Removing members from the front
+     * invalidates the cached minima; call Reset() and fold the remaining
+     * front back in for that case.
+     *
+     * @tparam MatType The matrix data type of the front.
+     */
+    template<typename MatType>
+    class Incremental
+    {
+     public:
+      // Convenience typedef.
+      typedef typename MatType::elem_type ElemType;
+
+      /**
+       * Construct the incremental evaluator for the given reference front
+       * (one point per column).
+       *
+       * @param referenceFront The reference front, one point per column.
+       */
+      Incremental(const MatType& referenceFront) :
+          referenceFront(referenceFront)
+      {
+        Reset();
+      }
+
+      /**
+       * Fold new or changed front members (one point per column) into the
+       * cached per-reference nearest distances.
+       *
+       * @param members The new or changed front members.
+       */
+      void Update(const MatType& members)
+      {
+        MatType diff(members.n_rows, members.n_cols);
+        for (size_t i = 0; i < referenceFront.n_cols; i++)
+        {
+          diff = members;
+          diff.each_col() -= referenceFront.col(i);
+          diff.elem(arma::find(diff < 0)).zeros();
+          const ElemType nearest = std::sqrt((ElemType) arma::min(
+              arma::sum(arma::square(diff), 0)));
+          if (nearest < minDistances(i))
+            minDistances(i) = nearest;
+        }
+      }
+
+      //! The IGD+ value of the front members folded in so far.
+      ElemType Value() const { return arma::mean(minDistances); }
+
+      //! Forget all folded-in front members.
+      void Reset()
+      {
+        minDistances.set_size(referenceFront.n_cols);
+        minDistances.fill(std::numeric_limits<ElemType>::max());
+      }
+
+     private:
+      //! The reference front, one point per column.
+      MatType referenceFront;
+
+      //! The nearest one-sided distance seen for each reference point.
+      arma::Col<ElemType> minDistances;
+    };
   };
 
 } // namespace ens
 
-#endif
\ No newline at end of file
+#endif
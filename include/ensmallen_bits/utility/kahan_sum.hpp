@@ -0,0 +1,77 @@
+/**
+ * @file kahan_sum.hpp
+ * @author Ryan Curtin
+ *
+ * A compensated (Neumaier) accumulator for long floating-point reductions,
+ * used by the SGD family to keep objective sums accurate in low precision.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_UTILITY_KAHAN_SUM_HPP
+#define ENSMALLEN_UTILITY_KAHAN_SUM_HPP
+
+#include <cmath>
+
+namespace ens {
+
+/**
+ * Compensated accumulator implementing Neumaier's variant of Kahan
+ * summation: alongside the running sum a second variable carries the
+ * rounding error of every addition, so the error of the final sum is O(1)
+ * in the number of terms instead of O(n).  This makes objective sums over
+ * millions of batches as accurate in float32 as a naive float64 sum, at the
+ * cost of a few extra scalar operations per term.
+ *
+ * Note that aggressive floating-point optimization flags (e.g.
+ * -ffast-math) may legally remove the compensation; the accumulator then
+ * degrades to a naive sum.
+ *
+ * @tparam eT Element type of the accumulated values (e.g. float or double).
+ */
+template<typename eT>
+class KahanAccumulator
+{
+ public:
+  //! Initialize the accumulator to zero.
+  KahanAccumulator() : sum(0), compensation(0) { }
+
+  /**
+   * Add a value to the running sum, carrying the rounding error of the
+   * addition in the compensation term.
+   *
+   * @param value Value to add.
+   */
+  void Add(const eT value)
+  {
+    const eT t = sum + value;
+    if (std::abs(sum) >= std::abs(value))
+      compensation += (sum - t) + value;
+    else
+      compensation += (value - t) + sum;
+    sum = t;
+  }
+
+  //! Get the compensated sum of all values added so far.
+  eT Sum() const { return sum + compensation; }
+
+  //! Reset the accumulator to zero.
+  void Reset()
+  {
+    sum = 0;
+    compensation = 0;
+  }
+
+ private:
+  //! The running (uncompensated) sum.
+  eT sum;
+
+  //! The accumulated rounding error of all additions.
+  eT compensation;
+};
+
+} // namespace ens
+
+#endif // ENSMALLEN_UTILITY_KAHAN_SUM_HPP
@@ -0,0 +1,212 @@
+/**
+ * @file mmap_matrix.hpp
+ * @author Ryan Curtin
+ *
+ * A read-only, memory-mapped view of an on-disk element matrix, so that
+ * separable functions can train on datasets larger than RAM.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_UTILITY_MMAP_MATRIX_HPP
+#define ENSMALLEN_UTILITY_MMAP_MATRIX_HPP
+
+#if !defined(_WIN32)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#else
+  #include <fstream>
+#endif
+
+namespace ens {
+
+/**
+ * MmapMatrix maps a file of raw column-major elements into memory and
+ * presents it as a read-only Armadillo matrix without ever loading the file:
+ * the view aliases the mapping directly, so a dataset larger than RAM can
+ * back a separable function, and the page cache keeps only the working set
+ * resident.
+ *
+ * Separable functions hand the view to the optimizer-facing Evaluate() and
+ * Gradient() methods like any other matrix; for the SGD family, which visits
+ * the data in batches of columns, the optional PrefetchBatch() hook lines up
+ * nicely with WillNeed():
+ *
+ * @code
+ * MmapMatrix<double> data("data.bin", dimensionality, numPoints);
+ * MyLossFunction f(data.Matrix(), responses);
+ * // Inside MyLossFunction:
+ * //   void PrefetchBatch(const size_t begin, const size_t batchSize)
+ * //   { data.WillNeed(begin, batchSize); }
+ * @endcode
+ *
+ * so the kernel reads the next batch's pages from disk while the current
+ * batch is being computed on.  For a sequential (unshuffled) visitation
+ * order, AdviseSequential() additionally enables aggressive kernel
+ * readahead over the whole mapping.
+ *
+ * The mapping is strictly read-only; writing through the view is undefined
+ * behavior.  On platforms without POSIX memory mapping the file is simply
+ * read into memory, which preserves the interface but not the out-of-core
+ * property.
+ *
+ * @tparam ElemType The element type stored in the file (and of the exposed
+ *     matrix).
+ */
+template<typename ElemType = double>
+class MmapMatrix
+{
+ public:
+  /**
+   * Map the given file as a matrix with the given shape.  The file must hold
+   * at least rows * cols elements of ElemType in column-major order, with no
+   * header.
+   *
+   * @param filename File holding the raw column-major elements.
+   * @param rows Number of rows of the matrix.
+   * @param cols Number of columns of the matrix.
+   */
+  MmapMatrix(const std::string& filename,
+             const size_t rows,
+             const size_t cols) :
+      view(NULL),
+      mapping(NULL),
+      mappingLength(rows * cols * sizeof(ElemType))
+  {
+#if !defined(_WIN32)
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      throw std::runtime_error("MmapMatrix: cannot open file '" + filename +
+          "'!");
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t) info.st_size < mappingLength)
+    {
+      close(fd);
+      throw std::runtime_error("MmapMatrix: file '" + filename + "' is "
+          "smaller than the requested matrix shape!");
+    }
+
+    mapping = mmap(NULL, mappingLength, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping keeps its own reference to the file.
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+      mapping = NULL;
+      throw std::runtime_error("MmapMatrix: cannot map file '" + filename +
+          "'!");
+    }
+
+    // The view aliases the mapping; no copy is made.  The mapping is
+    // read-only, so the const_cast is safe as long as the view is never
+    // written through (see the class comments).
+    view = new arma::Mat<ElemType>((ElemType*) mapping, rows, cols, false,
+        true);
+#else
+    // No POSIX memory mapping: fall back to reading the file into memory.
+    std::ifstream stream(filename.c_str(), std::ios::binary);
+    if (!stream.good())
+    {
+      throw std::runtime_error("MmapMatrix: cannot open file '" + filename +
+          "'!");
+    }
+
+    view = new arma::Mat<ElemType>(rows, cols);
+    stream.read((char*) view->memptr(), mappingLength);
+    if ((size_t) stream.gcount() < mappingLength)
+    {
+      delete view;
+      view = NULL;
+      throw std::runtime_error("MmapMatrix: file '" + filename + "' is "
+          "smaller than the requested matrix shape!");
+    }
+#endif
+  }
+
+  //! The view aliases the mapping, so the class is not copyable.
+  MmapMatrix(const MmapMatrix&) = delete;
+  //! The view aliases the mapping, so the class is not assignable.
+  MmapMatrix& operator=(const MmapMatrix&) = delete;
+
+  //! Unmap the file.
+  ~MmapMatrix()
+  {
+    delete view;
+#if !defined(_WIN32)
+    if (mapping != NULL)
+      munmap(mapping, mappingLength);
+#endif
+  }
+
+  //! Get the read-only matrix view of the mapped file.
+  const arma::Mat<ElemType>& Matrix() const { return *view; }
+
+  //! Get the number of rows.
+  size_t Rows() const { return view->n_rows; }
+  //! Get the number of columns.
+  size_t Cols() const { return view->n_cols; }
+
+  /**
+   * Tell the kernel the mapping will be accessed sequentially, enabling
+   * aggressive readahead over the whole file.  Appropriate when the
+   * optimizer visits the columns in order (e.g. SGD with shuffle disabled).
+   */
+  void AdviseSequential() const
+  {
+#if !defined(_WIN32)
+    if (mapping != NULL)
+      posix_madvise(mapping, mappingLength, POSIX_MADV_SEQUENTIAL);
+#endif
+  }
+
+  /**
+   * Tell the kernel the given column range will be needed soon, so its pages
+   * are read from disk in the background.  Matches the (begin, batchSize)
+   * arguments of the optional PrefetchBatch() hook of separable functions.
+   *
+   * @param beginCol First column of the range.
+   * @param numCols Number of columns in the range.
+   */
+  void WillNeed(const size_t beginCol, const size_t numCols) const
+  {
+#if !defined(_WIN32)
+    if (mapping == NULL || beginCol >= view->n_cols)
+      return;
+
+    const size_t effectiveCols = std::min(numCols, view->n_cols - beginCol);
+    size_t offset = beginCol * view->n_rows * sizeof(ElemType);
+    size_t length = effectiveCols * view->n_rows * sizeof(ElemType);
+
+    // madvise() needs a page-aligned address; widen the range downwards.
+    const size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+    const size_t misalignment = offset % pageSize;
+    offset -= misalignment;
+    length += misalignment;
+
+    posix_madvise((char*) mapping + offset, length, POSIX_MADV_WILLNEED);
+#else
+    (void) beginCol;
+    (void) numCols;
+#endif
+  }
+
+ private:
+  //! The Armadillo view aliasing the mapping.
+  arma::Mat<ElemType>* view;
+
+  //! The raw file mapping (NULL when the fallback path is used).
+  void* mapping;
+
+  //! The length of the mapping in bytes.
+  size_t mappingLength;
+};
+
+} // namespace ens
+
+#endif
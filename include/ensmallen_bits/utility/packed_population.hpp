@@ -0,0 +1,351 @@
+/**
+ * @file packed_population.hpp
+ * @author Marcus Edel
+ *
+ * A bit-packed population arena for binary genomes, with mutation and
+ * crossover as bitwise word operations and popcount-based distances.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_UTILITY_PACKED_POPULATION_HPP
+#define ENSMALLEN_UTILITY_PACKED_POPULATION_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "philox_generator.hpp"
+
+namespace ens {
+
+/**
+ * A population of binary genomes stored one bit per gene in a single
+ * contiguous arena of 64-bit words.  Compared to holding binary genes as
+ * floating-point elements, this shrinks the population memory by 64x and
+ * turns the variation operators into bitwise word operations: uniform
+ * crossover is a masked blend, rare mutation visits only the flipped bits
+ * (geometric skipping), and Hamming distances are popcounts.
+ *
+ * Genes are converted to and from the floating-point representation the
+ * objective function expects with Pack() and Unpack(); an element packs to a
+ * set bit exactly when it is >= 0.5, and a set bit unpacks to 1.  Bits past
+ * NumBits() in the last word of each genome are kept zero, so whole-word
+ * operations need no per-bit tail handling.
+ *
+ * This is the packed genome representation behind the binary genome modes of
+ * CNE and DE (see CNE::BinaryGenome() and DE::BinaryGenome()).
+ */
+class PackedPopulation
+{
+ public:
+  /**
+   * Construct an arena of zero-initialized genomes.
+   *
+   * @param numCandidates Number of genomes in the population.
+   * @param numBits Number of genes (bits) per genome.
+   */
+  PackedPopulation(const size_t numCandidates, const size_t numBits) :
+      numCandidates(numCandidates),
+      numBits(numBits),
+      wordsPerGenome((numBits + 63) / 64),
+      words(numCandidates * wordsPerGenome, 0)
+  { /* Nothing to do here. */ }
+
+  //! Get the number of genomes in the population.
+  size_t NumCandidates() const { return numCandidates; }
+  //! Get the number of genes (bits) per genome.
+  size_t NumBits() const { return numBits; }
+
+  /**
+   * Pack a floating-point genome into the given candidate slot; an element
+   * packs to a set bit exactly when it is >= 0.5.
+   *
+   * @param index Candidate slot to pack into.
+   * @param genome Genome to pack; must have NumBits() elements.
+   */
+  template<typename MatType>
+  void Pack(const size_t index, const MatType& genome)
+  {
+    uint64_t* g = Genome(index);
+    for (size_t w = 0; w < wordsPerGenome; ++w)
+      g[w] = 0;
+    for (size_t e = 0; e < numBits; ++e)
+    {
+      if (genome(e) >= 0.5)
+        g[e / 64] |= ((uint64_t) 1 << (e % 64));
+    }
+  }
+
+  /**
+   * Unpack a candidate into a floating-point genome of 0/1 elements.
+   *
+   * @param index Candidate slot to unpack.
+   * @param genome Matrix to unpack into; must have NumBits() elements.
+   */
+  template<typename MatType>
+  void Unpack(const size_t index, MatType& genome) const
+  {
+    typedef typename MatType::elem_type ElemType;
+
+    const uint64_t* g = Genome(index);
+    for (size_t e = 0; e < numBits; ++e)
+      genome(e) = (ElemType) ((g[e / 64] >> (e % 64)) & 1);
+  }
+
+  //! Copy the genome in slot src over the genome in slot dest.
+  void Copy(const size_t src, const size_t dest)
+  {
+    CopyFrom(*this, src, dest);
+  }
+
+  //! Copy a genome from another arena with the same genome length.
+  void CopyFrom(const PackedPopulation& srcArena,
+                const size_t src,
+                const size_t dest)
+  {
+    const uint64_t* a = srcArena.Genome(src);
+    uint64_t* b = Genome(dest);
+    for (size_t w = 0; w < wordsPerGenome; ++w)
+      b[w] = a[w];
+  }
+
+  //! Overwrite the given candidate with a uniformly random genome.
+  void Randomize(const size_t index, PhiloxGenerator& generator)
+  {
+    uint64_t* g = Genome(index);
+    for (size_t w = 0; w < wordsPerGenome; ++w)
+      g[w] = generator.Bits64();
+    if (wordsPerGenome > 0)
+      g[wordsPerGenome - 1] &= TailMask();
+  }
+
+  /**
+   * Flip each bit of the given candidate independently with the given
+   * probability.  Instead of drawing one variate per gene, the next flipped
+   * bit is found by geometric skipping, so the cost is proportional to the
+   * number of flips rather than the genome length.
+   *
+   * @param index Candidate to mutate.
+   * @param prob Per-bit flip probability.
+   * @param generator Random number generator to use.
+   */
+  void FlipMutate(const size_t index,
+                  const double prob,
+                  PhiloxGenerator& generator)
+  {
+    if (prob <= 0.0 || numBits == 0)
+      return;
+
+    uint64_t* g = Genome(index);
+    if (prob >= 1.0)
+    {
+      for (size_t w = 0; w < wordsPerGenome; ++w)
+        g[w] = ~g[w];
+      g[wordsPerGenome - 1] &= TailMask();
+      return;
+    }
+
+    const double denom = std::log(1.0 - prob);
+    size_t e = (size_t) std::floor(
+        std::log(1.0 - generator.Uniform()) / denom);
+    while (e < numBits)
+    {
+      g[e / 64] ^= ((uint64_t) 1 << (e % 64));
+      e += 1 + (size_t) std::floor(
+          std::log(1.0 - generator.Uniform()) / denom);
+    }
+  }
+
+  /**
+   * Uniform crossover of two parents into two children: each gene is kept or
+   * swapped between the children with equal probability, one random mask
+   * word at a time.  The children may not share slots with the parents.
+   *
+   * @param mom First parent slot.
+   * @param dad Second parent slot.
+   * @param child1 Slot for the first child.
+   * @param child2 Slot for the second child.
+   * @param generator Random number generator to use.
+   */
+  void UniformCrossover(const size_t mom,
+                        const size_t dad,
+                        const size_t child1,
+                        const size_t child2,
+                        PhiloxGenerator& generator)
+  {
+    const uint64_t* a = Genome(mom);
+    const uint64_t* b = Genome(dad);
+    uint64_t* x = Genome(child1);
+    uint64_t* y = Genome(child2);
+    for (size_t w = 0; w < wordsPerGenome; ++w)
+    {
+      const uint64_t mask = generator.Bits64();
+      x[w] = (a[w] & ~mask) | (b[w] & mask);
+      y[w] = (b[w] & ~mask) | (a[w] & mask);
+    }
+  }
+
+  /**
+   * Binary differential mutation (the bitwise analog of the /best/1/
+   * strategy): the trial genome starts from the given base and adopts each
+   * bit where the two difference genomes disagree with the given
+   * probability, i.e. trial = base ^ (mask & (a ^ b)).
+   *
+   * @param src Arena holding the base and difference genomes.
+   * @param base Base genome slot (typically the best candidate) in src.
+   * @param a First difference genome slot in src.
+   * @param b Second difference genome slot in src.
+   * @param dest Slot in this arena to write the trial genome to.
+   * @param prob Probability of adopting each disagreeing bit.
+   * @param generator Random number generator to use.
+   */
+  void DifferentialMutate(const PackedPopulation& src,
+                          const size_t base,
+                          const size_t a,
+                          const size_t b,
+                          const size_t dest,
+                          const double prob,
+                          PhiloxGenerator& generator)
+  {
+    std::vector<uint64_t> mask(wordsPerGenome, 0);
+    BernoulliMask(mask, prob, generator);
+
+    const uint64_t* p = src.Genome(base);
+    const uint64_t* q = src.Genome(a);
+    const uint64_t* r = src.Genome(b);
+    uint64_t* d = Genome(dest);
+    for (size_t w = 0; w < wordsPerGenome; ++w)
+      d[w] = p[w] ^ (mask[w] & (q[w] ^ r[w]));
+  }
+
+  /**
+   * Binomial crossover of a trial genome (already stored in this arena) with
+   * its parent: each bit keeps the trial value with probability
+   * crossoverRate and reverts to the parent's bit otherwise.
+   *
+   * @param src Arena holding the parent genome.
+   * @param parent Parent genome slot in src.
+   * @param dest Slot in this arena holding the trial genome.
+   * @param crossoverRate Probability of keeping each trial bit.
+   * @param generator Random number generator to use.
+   */
+  void BinomialCrossover(const PackedPopulation& src,
+                         const size_t parent,
+                         const size_t dest,
+                         const double crossoverRate,
+                         PhiloxGenerator& generator)
+  {
+    std::vector<uint64_t> mask(wordsPerGenome, 0);
+    BernoulliMask(mask, crossoverRate, generator);
+
+    const uint64_t* p = src.Genome(parent);
+    uint64_t* d = Genome(dest);
+    for (size_t w = 0; w < wordsPerGenome; ++w)
+      d[w] = (d[w] & mask[w]) | (p[w] & ~mask[w]);
+  }
+
+  //! Compute the Hamming distance between two candidates via popcounts.
+  size_t HammingDistance(const size_t i, const size_t j) const
+  {
+    const uint64_t* a = Genome(i);
+    const uint64_t* b = Genome(j);
+    size_t distance = 0;
+    for (size_t w = 0; w < wordsPerGenome; ++w)
+      distance += PopCount(a[w] ^ b[w]);
+    return distance;
+  }
+
+  /**
+   * Compute the population diversity as the mean pairwise Hamming distance,
+   * normalized by the genome length to lie in [0, 1]; this is the binary
+   * analog of the per-dimension standard deviation statistic of
+   * StagnationDetector::Diversity().
+   */
+  double Diversity() const
+  {
+    if (numCandidates < 2 || numBits == 0)
+      return 0.0;
+
+    size_t total = 0;
+    for (size_t i = 0; i < numCandidates; ++i)
+    {
+      for (size_t j = i + 1; j < numCandidates; ++j)
+        total += HammingDistance(i, j);
+    }
+
+    const double pairs = 0.5 * numCandidates * (numCandidates - 1);
+    return (double) total / (pairs * numBits);
+  }
+
+ private:
+  //! Get a pointer to the words of the given genome.
+  uint64_t* Genome(const size_t index)
+  { return words.data() + index * wordsPerGenome; }
+  //! Get a const pointer to the words of the given genome.
+  const uint64_t* Genome(const size_t index) const
+  { return words.data() + index * wordsPerGenome; }
+
+  //! Mask of the bits of the last word that belong to the genome.
+  uint64_t TailMask() const
+  {
+    const size_t rem = numBits % 64;
+    return (rem == 0) ? ~(uint64_t) 0 : (((uint64_t) 1 << rem) - 1);
+  }
+
+  //! Fill the given word buffer with a Bernoulli(prob) bit mask, setting the
+  //! bits by geometric skipping; bits past the genome length stay zero.
+  void BernoulliMask(std::vector<uint64_t>& mask,
+                     const double prob,
+                     PhiloxGenerator& generator) const
+  {
+    if (prob <= 0.0 || numBits == 0)
+      return;
+
+    if (prob >= 1.0)
+    {
+      for (size_t w = 0; w < wordsPerGenome; ++w)
+        mask[w] = ~(uint64_t) 0;
+      mask[wordsPerGenome - 1] &= TailMask();
+      return;
+    }
+
+    const double denom = std::log(1.0 - prob);
+    size_t e = (size_t) std::floor(
+        std::log(1.0 - generator.Uniform()) / denom);
+    while (e < numBits)
+    {
+      mask[e / 64] |= ((uint64_t) 1 << (e % 64));
+      e += 1 + (size_t) std::floor(
+          std::log(1.0 - generator.Uniform()) / denom);
+    }
+  }
+
+  //! Count the set bits of a word.
+  static size_t PopCount(uint64_t x)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t) __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return (size_t) ((x * 0x0101010101010101ull) >> 56);
+#endif
+  }
+
+  //! Number of genomes in the population.
+  size_t numCandidates;
+  //! Number of genes (bits) per genome.
+  size_t numBits;
+  //! Number of 64-bit words per genome.
+  size_t wordsPerGenome;
+  //! The packed population arena.
+  std::vector<uint64_t> words;
+};
+
+} // namespace ens
+
+#endif
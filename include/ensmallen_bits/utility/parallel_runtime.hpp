@@ -0,0 +1,77 @@
+/**
+ * @file parallel_runtime.hpp
+ * @author Marcus Edel
+ *
+ * A process-wide runtime configuration for all parallel optimizer features.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_UTILITY_PARALLEL_RUNTIME_HPP
+#define ENSMALLEN_UTILITY_PARALLEL_RUNTIME_HPP
+
+namespace ens {
+
+/**
+ * Process-wide configuration shared by every parallel feature of the library
+ * (ParallelSGD, the parallel grid search, population evaluation, and the
+ * multithreaded function wrappers).
+ *
+ * The worker threads themselves belong to the OpenMP runtime, which already
+ * keeps a persistent per-process pool (and handles core pinning via
+ * OMP_PROC_BIND / OMP_PLACES), so thread startup cost is paid once per
+ * process, not once per Optimize() call.  What this class centralizes is the
+ * sizing decision: every parallel region asks RegionThreads() how many
+ * threads to use, which honors a library-wide override set via NumThreads()
+ * and collapses to a single thread when the caller is already inside a
+ * parallel region, so nested Optimize() calls do not oversubscribe the cores.
+ *
+ * Without OpenMP, RegionThreads() is always 1 and the parallel features run
+ * serially, as before.
+ */
+class ParallelRuntime
+{
+ public:
+  //! Get the process-wide runtime instance.
+  static ParallelRuntime& Get()
+  {
+    static ParallelRuntime runtime;
+    return runtime;
+  }
+
+  //! Get the configured thread count (0 means the OpenMP default).
+  size_t NumThreads() const { return numThreads; }
+  //! Modify the configured thread count (0 means the OpenMP default).
+  size_t& NumThreads() { return numThreads; }
+
+  /**
+   * The number of threads a new parallel region should use: 1 when the
+   * caller already runs inside a parallel region (so nested parallelism does
+   * not oversubscribe the cores), otherwise the configured thread count, or
+   * the OpenMP default if none was configured.
+   */
+  size_t RegionThreads() const
+  {
+    #ifdef ENS_USE_OPENMP
+    if (omp_in_parallel())
+      return 1;
+
+    return (numThreads > 0) ? numThreads : (size_t) omp_get_max_threads();
+    #else
+    return 1;
+    #endif
+  }
+
+ private:
+  //! Only accessible through Get().
+  ParallelRuntime() : numThreads(0) { }
+
+  //! The configured thread count; 0 means the OpenMP default.
+  size_t numThreads;
+};
+
+} // namespace ens
+
+#endif
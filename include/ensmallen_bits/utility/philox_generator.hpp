@@ -0,0 +1,274 @@
+/**
+ * @file philox_generator.hpp
+ * @author Marcus Edel
+ *
+ * A counter-based pseudorandom number generator (Philox4x32-10) that gives
+ * each optimizer its own seedable random stream.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_UTILITY_PHILOX_GENERATOR_HPP
+#define ENSMALLEN_UTILITY_PHILOX_GENERATOR_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+namespace ens {
+
+/**
+ * A counter-based pseudorandom number generator using the Philox4x32-10
+ * algorithm of Salmon et al.  Unlike the global Armadillo generator, every
+ * PhiloxGenerator instance carries its own state, so each stochastic
+ * optimizer can be seeded individually and produce reproducible runs.  The
+ * state is just a 128-bit counter and a 64-bit key, so independent streams
+ * for parallel sampling are obtained by giving each thread its own stream id
+ * instead of sharing (and serializing on) one generator.
+ *
+ * The class satisfies the UniformRandomBitGenerator concept, so it can also
+ * be plugged into the <random> distributions.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @inproceedings{Salmon2011,
+ *   author    = {Salmon, John K. and Moraes, Mark A. and Dror, Ron O. and
+ *                Shaw, David E.},
+ *   title     = {Parallel Random Numbers: As Easy as 1, 2, 3},
+ *   booktitle = {Proceedings of 2011 International Conference for High
+ *                Performance Computing, Networking, Storage and Analysis},
+ *   year      = {2011}
+ * }
+ * @endcode
+ */
+class PhiloxGenerator
+{
+ public:
+  typedef uint32_t result_type;
+
+  /**
+   * Construct a generator seeded from std::random_device.  Use the seeded
+   * constructor or Seed() to get reproducible runs.
+   */
+  PhiloxGenerator()
+  {
+    std::random_device rd;
+    Seed(((uint64_t) rd() << 32) | rd(), 0);
+  }
+
+  /**
+   * Construct a generator with the given seed and stream id.  Generators
+   * with the same seed but different stream ids produce independent
+   * sequences.
+   *
+   * @param seed Seed of the generator.
+   * @param stream Stream id of the generator.
+   */
+  PhiloxGenerator(const uint64_t seed, const uint64_t stream = 0)
+  {
+    Seed(seed, stream);
+  }
+
+  /**
+   * Reseed the generator and reset its counter.
+   *
+   * @param seed Seed of the generator.
+   * @param stream Stream id of the generator.
+   */
+  void Seed(const uint64_t seed, const uint64_t stream = 0)
+  {
+    this->seed = seed;
+    this->stream = stream;
+    counterLo = 0;
+    counterHi = stream;
+    bufferPos = 4; // Force a refill on the next draw.
+    haveSpareGaussian = false;
+    spareGaussian = 0.0;
+  }
+
+  //! Get the seed of the generator.
+  uint64_t CurrentSeed() const { return seed; }
+  //! Get the stream id of the generator.
+  uint64_t Stream() const { return stream; }
+
+  /**
+   * Return a generator that produces a sequence independent of this one,
+   * e.g. for use by another thread.  The stream ids of sibling generators
+   * must differ.
+   *
+   * @param stream Stream id of the new generator.
+   */
+  PhiloxGenerator WithStream(const uint64_t stream) const
+  {
+    return PhiloxGenerator(seed, stream);
+  }
+
+  //! Smallest value operator() can return.
+  static constexpr result_type min() { return 0; }
+  //! Largest value operator() can return.
+  static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+  //! Return the next 32 random bits.
+  result_type operator()()
+  {
+    if (bufferPos == 4)
+    {
+      FillBuffer();
+      bufferPos = 0;
+    }
+
+    return buffer[bufferPos++];
+  }
+
+  //! Return the next 64 random bits.
+  uint64_t Bits64()
+  {
+    const uint64_t hi = (*this)();
+    return (hi << 32) | (*this)();
+  }
+
+  //! Return a sample from the uniform distribution on [0, 1).
+  double Uniform()
+  {
+    return (Bits64() >> 11) * (1.0 / 9007199254740992.0); // 2^-53.
+  }
+
+  //! Return a sample from the standard normal distribution.
+  double Gaussian()
+  {
+    // Marsaglia's polar method; the second sample of each pair is cached.
+    if (haveSpareGaussian)
+    {
+      haveSpareGaussian = false;
+      return spareGaussian;
+    }
+
+    double u, v, sq;
+    do
+    {
+      u = 2.0 * Uniform() - 1.0;
+      v = 2.0 * Uniform() - 1.0;
+      sq = u * u + v * v;
+    } while (sq >= 1.0 || sq == 0.0);
+
+    const double factor = std::sqrt(-2.0 * std::log(sq) / sq);
+    spareGaussian = v * factor;
+    haveSpareGaussian = true;
+    return u * factor;
+  }
+
+  /**
+   * Return an integer drawn uniformly from [0, n); n must be positive.
+   *
+   * @param n Exclusive upper bound of the draw.
+   */
+  size_t RandInt(const size_t n)
+  {
+    // Rejection sampling to avoid the modulo bias.
+    const uint64_t buckets = 0xFFFFFFFFFFFFFFFFull / (uint64_t) n;
+    const uint64_t limit = buckets * (uint64_t) n;
+
+    uint64_t r;
+    do
+    {
+      r = Bits64();
+    } while (r >= limit);
+
+    return (size_t) (r / buckets);
+  }
+
+  //! Fill the given matrix with uniform samples from [0, 1).
+  template<typename MatType>
+  void Randu(MatType& m)
+  {
+    typedef typename MatType::elem_type ElemType;
+    for (arma::uword i = 0; i < m.n_elem; ++i)
+      m(i) = ElemType(Uniform());
+  }
+
+  //! Fill the given matrix with standard normal samples.
+  template<typename MatType>
+  void Randn(MatType& m)
+  {
+    typedef typename MatType::elem_type ElemType;
+    for (arma::uword i = 0; i < m.n_elem; ++i)
+      m(i) = ElemType(Gaussian());
+  }
+
+  //! Fill the given matrix with Rademacher (+1 or -1) samples.
+  template<typename MatType>
+  void Rademacher(MatType& m)
+  {
+    typedef typename MatType::elem_type ElemType;
+    for (arma::uword i = 0; i < m.n_elem; ++i)
+      m(i) = ((*this)() & 1) ? ElemType(1) : ElemType(-1);
+  }
+
+ private:
+  //! Encrypt the current counter into the output buffer and advance it.
+  void FillBuffer()
+  {
+    uint32_t c0 = (uint32_t) counterLo;
+    uint32_t c1 = (uint32_t) (counterLo >> 32);
+    uint32_t c2 = (uint32_t) counterHi;
+    uint32_t c3 = (uint32_t) (counterHi >> 32);
+    uint32_t k0 = (uint32_t) seed;
+    uint32_t k1 = (uint32_t) (seed >> 32);
+
+    for (size_t round = 0; round < 10; ++round)
+    {
+      const uint64_t p0 = (uint64_t) 0xD2511F53u * c0;
+      const uint64_t p1 = (uint64_t) 0xCD9E8D57u * c2;
+      const uint32_t n0 = (uint32_t) (p1 >> 32) ^ c1 ^ k0;
+      const uint32_t n1 = (uint32_t) p1;
+      const uint32_t n2 = (uint32_t) (p0 >> 32) ^ c3 ^ k1;
+      const uint32_t n3 = (uint32_t) p0;
+
+      c0 = n0;
+      c1 = n1;
+      c2 = n2;
+      c3 = n3;
+      k0 += 0x9E3779B9u;
+      k1 += 0xBB67AE85u;
+    }
+
+    buffer[0] = c0;
+    buffer[1] = c1;
+    buffer[2] = c2;
+    buffer[3] = c3;
+
+    if (++counterLo == 0)
+      ++counterHi;
+  }
+
+  //! The key of the Philox block cipher.
+  uint64_t seed;
+
+  //! The stream id; it forms the high half of the initial counter.
+  uint64_t stream;
+
+  //! Low half of the 128-bit counter.
+  uint64_t counterLo;
+
+  //! High half of the 128-bit counter.
+  uint64_t counterHi;
+
+  //! The four outputs of the last counter encryption.
+  uint32_t buffer[4];
+
+  //! Position of the next unused output in the buffer.
+  size_t bufferPos;
+
+  //! Cached second output of the polar method.
+  double spareGaussian;
+
+  //! Whether spareGaussian holds an unused sample.
+  bool haveSpareGaussian;
+};
+
+} // namespace ens
+
+#endif
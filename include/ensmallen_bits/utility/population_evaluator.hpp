@@ -0,0 +1,188 @@
+/**
+ * @file population_evaluator.hpp
+ * @author Sayan Goswami
+ * @author Nanubala Gnana Sai
+ *
+ * Evaluation of a tuple of objective functions over a population of
+ * candidates, shared by the multi-objective optimizers.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_UTILITY_POPULATION_EVALUATOR_HPP
+#define ENSMALLEN_UTILITY_POPULATION_EVALUATOR_HPP
+
+namespace ens {
+
+/**
+ * The PopulationEvaluator evaluates every objective in a tuple of objective
+ * functions for the members of a candidate population, storing the results in
+ * the corresponding objective vectors.  The population members are
+ * independent of each other, so the evaluation can optionally be run in
+ * parallel across members with OpenMP; this requires the Evaluate() methods
+ * of all the objectives to be thread-safe.  Without ENS_USE_OPENMP the
+ * parallel mode falls back to the serial loop.
+ *
+ * Both NSGA2 and MOEAD dispatch their population evaluation here, and the
+ * single-objective population optimizers (DE and SHADE) use the matrix-based
+ * overload below to pick up the optional batched Evaluate() of the objective
+ * function.
+ */
+class PopulationEvaluator
+{
+ public:
+  /**
+   * Evaluate all objectives for the first numMembers members of the
+   * population.
+   *
+   * @tparam MatType Type of matrix holding a candidate.
+   * @tparam ArbitraryFunctionType The types of the objective functions.
+   * @param population The candidate population.
+   * @param objectives The set of objectives.
+   * @param calculatedObjectives Vector to store calculated objectives.
+   * @param numMembers Number of members (from the front) to evaluate.
+   * @param parallel If true, evaluate the members in parallel.
+   */
+  template<typename MatType,
+           typename... ArbitraryFunctionType>
+  static void Evaluate(
+      std::vector<MatType>& population,
+      std::tuple<ArbitraryFunctionType...>& objectives,
+      std::vector<arma::Col<typename MatType::elem_type> >&
+          calculatedObjectives,
+      const size_t numMembers,
+      const bool parallel)
+  {
+    if (parallel)
+    {
+      ENS_PRAGMA_OMP_PARALLEL_FOR_THREADS(
+          (int) ParallelRuntime::Get().RegionThreads())
+      for (ptrdiff_t i = 0; i < (ptrdiff_t) numMembers; i++)
+      {
+        EvaluateMember<0>(population[i], objectives, calculatedObjectives[i]);
+      }
+    }
+    else
+    {
+      for (size_t i = 0; i < numMembers; i++)
+      {
+        EvaluateMember<0>(population[i], objectives, calculatedObjectives[i]);
+      }
+    }
+  }
+
+  /**
+   * Evaluate a single objective function for every candidate in a population
+   * stored as the columns of a matrix.  If the function provides the optional
+   * batched overload
+   *
+   *   void Evaluate(const MatType& population, ColType& fitness);
+   *
+   * the whole population is scored in one call, so vectorized objectives pay
+   * the function-call boundary once per generation instead of once per
+   * candidate.  Otherwise, every column is reshaped to the given candidate
+   * shape and scored with one Evaluate() call.
+   *
+   * @param function The objective function.
+   * @param population Matrix with one vectorized candidate per column.
+   * @param rows Number of rows of a candidate in the function's shape.
+   * @param cols Number of columns of a candidate in the function's shape.
+   * @param fitness Vector to store the objective of every candidate into.
+   */
+  template<typename FunctionType, typename MatType, typename ColType>
+  static void Evaluate(FunctionType& function,
+                       const MatType& population,
+                       const size_t rows,
+                       const size_t cols,
+                       ColType& fitness)
+  {
+    Evaluate(function, population, rows, cols, fitness,
+        std::integral_constant<bool,
+            HasBatchEvaluate<FunctionType, MatType, ColType>::value>());
+  }
+
+ private:
+  /**
+   * Check whether FunctionType provides a batched population overload of the
+   * form void Evaluate(const MatType&, ColType&).
+   */
+  template<typename FunctionType, typename MatType, typename ColType>
+  class HasBatchEvaluate
+  {
+   private:
+    template<typename T>
+    static char& Test(
+        typename std::enable_if<std::is_void<
+            decltype(std::declval<T&>().Evaluate(
+                std::declval<const MatType&>(),
+                std::declval<ColType&>()))>::value>::type*);
+
+    template<typename T>
+    static int& Test(...);
+
+   public:
+    static const bool value = (sizeof(Test<FunctionType>(0)) == sizeof(char));
+  };
+
+  //! Score the whole population with the function's batched overload.
+  template<typename FunctionType, typename MatType, typename ColType>
+  static void Evaluate(FunctionType& function,
+                       const MatType& population,
+                       const size_t /* rows */,
+                       const size_t /* cols */,
+                       ColType& fitness,
+                       std::true_type)
+  {
+    function.Evaluate(population, fitness);
+  }
+
+  //! Score the population one reshaped candidate at a time.
+  template<typename FunctionType, typename MatType, typename ColType>
+  static void Evaluate(FunctionType& function,
+                       const MatType& population,
+                       const size_t rows,
+                       const size_t cols,
+                       ColType& fitness,
+                       std::false_type)
+  {
+    MatType candidate(rows, cols);
+    for (size_t i = 0; i < population.n_cols; ++i)
+    {
+      candidate = arma::reshape(population.col(i), rows, cols);
+      fitness[i] = function.Evaluate(candidate);
+    }
+  }
+
+  //! All objectives of this member have been evaluated.
+  template<std::size_t I,
+           typename MatType,
+           typename... ArbitraryFunctionType>
+  static typename std::enable_if<I == sizeof...(ArbitraryFunctionType),
+      void>::type
+  EvaluateMember(MatType& /* member */,
+                 std::tuple<ArbitraryFunctionType...>& /* objectives */,
+                 arma::Col<typename MatType::elem_type>& /* memberObjectives */)
+  {
+    // Nothing to do here.
+  }
+
+  //! Evaluate the I-th objective for one member, then recurse to the next.
+  template<std::size_t I,
+           typename MatType,
+           typename... ArbitraryFunctionType>
+  static typename std::enable_if<I < sizeof...(ArbitraryFunctionType),
+      void>::type
+  EvaluateMember(MatType& member,
+                 std::tuple<ArbitraryFunctionType...>& objectives,
+                 arma::Col<typename MatType::elem_type>& memberObjectives)
+  {
+    memberObjectives(I) = std::get<I>(objectives).Evaluate(member);
+    EvaluateMember<I + 1>(member, objectives, memberObjectives);
+  }
+};
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,209 @@
+/**
+ * @file progressive_subset.hpp
+ * @author Marcus Edel
+ *
+ * A wrapper that exposes a growing prefix of a separable function to any
+ * separable optimizer, so early optimization runs on a small part of the
+ * dataset and the subset is grown stage by stage.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_UTILITY_PROGRESSIVE_SUBSET_HPP
+#define ENSMALLEN_UTILITY_PROGRESSIVE_SUBSET_HPP
+
+namespace ens {
+
+/**
+ * A view onto a separable function that reports only the first numFunctions
+ * individual functions; everything else is forwarded unchanged.  Note that
+ * Shuffle() is forwarded too, so after each shuffle the visible prefix is a
+ * fresh random subset of the full dataset rather than a fixed one.
+ */
+template<typename FunctionType>
+class ProgressiveSubsetFunction
+{
+ public:
+  //! Wrap the given function, exposing only the first numFunctions functions.
+  ProgressiveSubsetFunction(FunctionType& function, const size_t numFunctions)
+      : function(function), numFunctions(numFunctions)
+  { /* Nothing to do here. */ }
+
+  //! Get the number of visible functions.
+  size_t NumFunctions() const { return numFunctions; }
+
+  //! Shuffle the underlying function (drawing a fresh visible subset).
+  template<typename T = FunctionType>
+  auto Shuffle() -> decltype(std::declval<T&>().Shuffle())
+  {
+    function.Shuffle();
+  }
+
+  //! Forward Evaluate() to the underlying function.
+  template<typename MatType>
+  auto Evaluate(const MatType& coordinates,
+                const size_t begin,
+                const size_t batchSize)
+      -> decltype(std::declval<FunctionType&>().Evaluate(coordinates, begin,
+          batchSize))
+  {
+    return function.Evaluate(coordinates, begin, batchSize);
+  }
+
+  //! Forward Gradient() to the underlying function.
+  template<typename MatType, typename GradType>
+  auto Gradient(const MatType& coordinates,
+                const size_t begin,
+                GradType& gradient,
+                const size_t batchSize)
+      -> decltype(std::declval<FunctionType&>().Gradient(coordinates, begin,
+          gradient, batchSize))
+  {
+    return function.Gradient(coordinates, begin, gradient, batchSize);
+  }
+
+  //! Forward EvaluateWithGradient() to the underlying function.
+  template<typename MatType, typename GradType>
+  auto EvaluateWithGradient(const MatType& coordinates,
+                            const size_t begin,
+                            GradType& gradient,
+                            const size_t batchSize)
+      -> decltype(std::declval<FunctionType&>().EvaluateWithGradient(
+          coordinates, begin, gradient, batchSize))
+  {
+    return function.EvaluateWithGradient(coordinates, begin, gradient,
+        batchSize);
+  }
+
+ private:
+  //! The wrapped function.
+  FunctionType& function;
+  //! The number of visible functions.
+  size_t numFunctions;
+};
+
+/**
+ * ProgressiveSubset runs any separable optimizer in stages over a growing
+ * prefix of the dataset: the first stage sees only an initialFraction of
+ * NumFunctions(), and each following stage grows the visible subset by
+ * growthFactor until the full dataset is reached.  The inner optimizer's own
+ * termination (tolerance or iteration budget) is the plateau detector: once
+ * it stops improving on the current subset, the subset grows and the
+ * optimization continues from the current iterate.
+ *
+ * The inner optimizer's MaxIterations() is interpreted relative to the full
+ * dataset and each stage receives a share proportional to its subset size,
+ * so an "epoch" keeps meaning one pass over the visible data and the total
+ * work is bounded by the unwrapped run.
+ *
+ * @tparam OptimizerType The separable optimizer to wrap; it must expose a
+ *     MaxIterations() accessor (as the SGD family does).
+ */
+template<typename OptimizerType>
+class ProgressiveSubset
+{
+ public:
+  /**
+   * Construct the progressive subset wrapper around the given optimizer.
+   *
+   * @param optimizer The inner optimizer to run in stages.
+   * @param initialFraction Fraction of the dataset visible to the first
+   *     stage.
+   * @param growthFactor Factor by which the visible subset grows between
+   *     stages.
+   */
+  ProgressiveSubset(const OptimizerType& optimizer = OptimizerType(),
+                    const double initialFraction = 0.1,
+                    const double growthFactor = 2.0) :
+      optimizer(optimizer),
+      initialFraction(initialFraction),
+      growthFactor(growthFactor)
+  { /* Nothing to do here. */ }
+
+  /**
+   * Optimize the given separable function in stages, growing the visible
+   * subset of the dataset between stages.  The final stage always runs on
+   * the full dataset, and its objective value is returned.
+   *
+   * @tparam SeparableFunctionType Type of the function to optimize.
+   * @tparam MatType Type of matrix to optimize.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to optimize.
+   * @param iterate Starting point (will be modified).
+   * @param callbacks Callback functions.
+   * @return Objective value of the final point.
+   */
+  template<typename SeparableFunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(SeparableFunctionType& function,
+                                       MatType& iterate,
+                                       CallbackTypes&&... callbacks)
+  {
+    typedef typename MatType::elem_type ElemType;
+
+    const size_t total = function.NumFunctions();
+    size_t subsetSize = std::max((size_t) 1,
+        (size_t) (initialFraction * total));
+    const size_t baseMaxIterations = optimizer.MaxIterations();
+
+    ElemType objective = 0;
+    while (true)
+    {
+      if (subsetSize > total)
+        subsetSize = total;
+
+      // Each stage receives an iteration budget proportional to its subset
+      // (unless the inner optimizer has no limit).
+      if (baseMaxIterations > 0)
+      {
+        optimizer.MaxIterations() = std::max((size_t) 1,
+            (baseMaxIterations * subsetSize) / total);
+      }
+
+      ProgressiveSubsetFunction<SeparableFunctionType> subset(function,
+          subsetSize);
+      objective = optimizer.Optimize(subset, iterate, callbacks...);
+
+      if (subsetSize == total)
+        break;
+
+      // The inner optimizer has stopped improving on the current subset, so
+      // grow the visible prefix and continue from the current iterate.
+      subsetSize = std::max(subsetSize + 1,
+          (size_t) (growthFactor * subsetSize));
+    }
+
+    optimizer.MaxIterations() = baseMaxIterations;
+    return objective;
+  }
+
+  //! Get the inner optimizer.
+  const OptimizerType& Optimizer() const { return optimizer; }
+  //! Modify the inner optimizer.
+  OptimizerType& Optimizer() { return optimizer; }
+
+  //! Get the fraction of the dataset visible to the first stage.
+  double InitialFraction() const { return initialFraction; }
+  //! Modify the fraction of the dataset visible to the first stage.
+  double& InitialFraction() { return initialFraction; }
+
+  //! Get the factor by which the visible subset grows between stages.
+  double GrowthFactor() const { return growthFactor; }
+  //! Modify the factor by which the visible subset grows between stages.
+  double& GrowthFactor() { return growthFactor; }
+
+ private:
+  //! The inner optimizer that runs on each stage.
+  OptimizerType optimizer;
+  //! Fraction of the dataset visible to the first stage.
+  double initialFraction;
+  //! Factor by which the visible subset grows between stages.
+  double growthFactor;
+};
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,177 @@
+/**
+ * @file stagnation_detector.hpp
+ * @author Marcus Edel
+ *
+ * A small shared component for stagnation-based early termination of
+ * population optimizers.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_UTILITY_STAGNATION_DETECTOR_HPP
+#define ENSMALLEN_UTILITY_STAGNATION_DETECTOR_HPP
+
+namespace ens {
+
+/**
+ * Stagnation detection for population optimizers (DE, PSO, CNE, CMA-ES).
+ * Population methods often converge long before their generation budget is
+ * exhausted and then burn the remaining budget on post-convergence
+ * evaluations; this component tracks two cheap per-generation statistics and
+ * signals when a configured termination criterion fires:
+ *
+ *  - Best-fitness improvement: Patience() is the number of consecutive
+ *    generations the best fitness may fail to improve by more than
+ *    MinImprovement() before termination.  The bookkeeping is O(1) per
+ *    generation.
+ *
+ *  - Population diversity: MinDiversity() is a floor on the population
+ *    spread (for CMA-ES, on the step size, which plays the same role).
+ *    The Diversity() helpers compute the mean per-dimension standard
+ *    deviation of a population; optimizers only compute it when the
+ *    criterion is enabled.
+ *
+ * Both criteria are disabled by default (Patience() and MinDiversity() of
+ * 0), in which case the optimizers behave exactly as before.  A typical
+ * configuration:
+ *
+ * @code
+ * DE<> opt(64, 2000);
+ * opt.Stagnation().Patience() = 50;
+ * opt.Stagnation().MinImprovement() = 1e-8;
+ * @endcode
+ */
+class StagnationDetector
+{
+ public:
+  /**
+   * Construct a stagnation detector.  With the default parameters both
+   * criteria are disabled and Stagnated() never fires.
+   *
+   * @param patience Consecutive non-improving generations tolerated before
+   *     termination (0 disables the criterion).
+   * @param minImprovement Smallest best-fitness decrease that counts as an
+   *     improvement.
+   * @param minDiversity Population diversity floor (0 disables the
+   *     criterion).
+   */
+  StagnationDetector(const size_t patience = 0,
+                     const double minImprovement = 1e-10,
+                     const double minDiversity = 0.0) :
+      patience(patience),
+      minImprovement(minImprovement),
+      minDiversity(minDiversity),
+      stagnantGenerations(0),
+      lastBest(0.0),
+      haveBest(false)
+  { /* Nothing to do. */ }
+
+  //! Return whether any stagnation criterion is configured.
+  bool Enabled() const { return (patience > 0) || (minDiversity > 0.0); }
+
+  //! Forget all recorded state (called at the start of an optimization).
+  void Reset()
+  {
+    stagnantGenerations = 0;
+    haveBest = false;
+  }
+
+  /**
+   * Record one generation and check the termination criteria.
+   *
+   * @param bestFitness Best fitness of the current generation.
+   * @param diversity Population diversity of the current generation; pass
+   *     the default when the diversity criterion is disabled.
+   * @return true if a configured stagnation criterion fired.
+   */
+  bool Stagnated(const double bestFitness,
+                 const double diversity = std::numeric_limits<double>::max())
+  {
+    if (!Enabled())
+      return false;
+
+    if (!haveBest || (lastBest - bestFitness) > minImprovement)
+      stagnantGenerations = 0;
+    else
+      ++stagnantGenerations;
+
+    if (!haveBest || bestFitness < lastBest)
+      lastBest = bestFitness;
+    haveBest = true;
+
+    if (patience > 0 && stagnantGenerations >= patience)
+      return true;
+    if (minDiversity > 0.0 && diversity < minDiversity)
+      return true;
+    return false;
+  }
+
+  /**
+   * Mean per-dimension standard deviation of a population stored with one
+   * column per member.
+   */
+  template<typename MatType>
+  static double Diversity(const MatType& population)
+  {
+    if (population.n_cols < 2)
+      return 0.0;
+    return (double) arma::mean(arma::vectorise(
+        arma::stddev(population, 0, 1)));
+  }
+
+  /**
+   * Mean per-dimension standard deviation of a population stored with one
+   * slice per member.
+   */
+  template<typename ElemType>
+  static double Diversity(const arma::Cube<ElemType>& population)
+  {
+    if (population.n_slices < 2)
+      return 0.0;
+
+    arma::Mat<ElemType> flattened(population.n_rows * population.n_cols,
+        population.n_slices);
+    for (size_t s = 0; s < population.n_slices; ++s)
+      flattened.col(s) = arma::vectorise(population.slice(s));
+    return Diversity(flattened);
+  }
+
+  //! Get the number of tolerated non-improving generations (0 disables).
+  size_t Patience() const { return patience; }
+  //! Modify the number of tolerated non-improving generations.
+  size_t& Patience() { return patience; }
+
+  //! Get the smallest decrease that counts as an improvement.
+  double MinImprovement() const { return minImprovement; }
+  //! Modify the smallest decrease that counts as an improvement.
+  double& MinImprovement() { return minImprovement; }
+
+  //! Get the population diversity floor (0 disables).
+  double MinDiversity() const { return minDiversity; }
+  //! Modify the population diversity floor.
+  double& MinDiversity() { return minDiversity; }
+
+  //! Get the current count of consecutive non-improving generations.
+  size_t StagnantGenerations() const { return stagnantGenerations; }
+
+ private:
+  //! Consecutive non-improving generations tolerated before termination.
+  size_t patience;
+  //! Smallest best-fitness decrease that counts as an improvement.
+  double minImprovement;
+  //! Population diversity floor.
+  double minDiversity;
+
+  //! Consecutive generations without sufficient improvement so far.
+  size_t stagnantGenerations;
+  //! Best fitness seen so far.
+  double lastBest;
+  //! Whether lastBest holds a recorded value.
+  bool haveBest;
+};
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,88 @@
+/**
+ * @file workspace.hpp
+ * @author Ryan Curtin
+ *
+ * A small collection of reusable, type-erased matrix buffers.  Optimizers in
+ * the SGD family hold one of these so that repeated calls to Optimize() on
+ * the same optimizer object (e.g. in a warm-start loop) perform no heap
+ * allocations for their internal gradient buffers.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_UTILITY_WORKSPACE_HPP
+#define ENSMALLEN_UTILITY_WORKSPACE_HPP
+
+#include "any.hpp"
+
+namespace ens {
+
+/**
+ * A keyed set of matrix buffers that persist for the lifetime of their owner.
+ * Since the matrix types used by an optimizer are only known once Optimize()
+ * is called, the buffers are held type-erased (via ens::Any) and materialized
+ * on first use; if a later Optimize() call uses a different matrix type, the
+ * slot is transparently re-created with the new type.
+ */
+class Workspace
+{
+ public:
+  /**
+   * Return a reference to the buffer in the given slot, typed and sized as
+   * requested.  The buffer keeps its previous contents if the type and size
+   * already match (in which case no allocation happens at all); otherwise it
+   * is (re-)allocated, with undefined contents.
+   *
+   * @tparam MatType Matrix type of the buffer.
+   * @param slot Identifier of the buffer; each distinct buffer an optimizer
+   *     needs should use a distinct slot.
+   * @param rows Required number of rows.
+   * @param cols Required number of columns.
+   */
+  template<typename MatType>
+  MatType& Get(const size_t slot, const size_t rows, const size_t cols)
+  {
+    if (slots.size() <= slot)
+      slots.resize(slot + 1);
+
+    Any& holder = slots[slot];
+    if (!holder.Has<MatType>())
+    {
+      holder.Clean();
+      holder.Set<MatType>(new MatType(rows, cols));
+    }
+
+    // set_size() is a no-op if the size already matches.
+    MatType& buffer = holder.As<MatType>();
+    buffer.set_size(rows, cols);
+    return buffer;
+  }
+
+  /**
+   * Release all held buffers.
+   */
+  void Clear()
+  {
+    for (size_t i = 0; i < slots.size(); ++i)
+      slots[i].Clean();
+    slots.clear();
+  }
+
+  /**
+   * Clean any memory associated with the workspace.
+   */
+  ~Workspace()
+  {
+    Clear();
+  }
+
+ private:
+  //! The type-erased buffers, indexed by slot.
+  std::vector<Any> slots;
+};
+
+} // namespace ens
+
+#endif
@@ -12,6 +12,8 @@
 #ifndef ENSMALLEN_WN_GRAD_WN_GRAD_UPDATE_HPP
 #define ENSMALLEN_WN_GRAD_WN_GRAD_UPDATE_HPP
 
+#include <ensmallen_bits/sgd/update_policies/elementwise_update.hpp>
+
 namespace ens {
 
 /**
@@ -53,7 +55,7 @@ class WNGradUpdate
    * instantiated at the start of the optimization.
    */
   template<typename MatType, typename GradType>
-  class Policy
+  class Policy : public ElementwiseUpdate<Policy<MatType, GradType>>
   {
    public:
     /**
@@ -85,7 +87,16 @@ class WNGradUpdate
     {
       parent.b += std::pow(stepSize, 2.0) / parent.b *
           std::pow(arma::norm(gradient), 2);
-      iterate -= stepSize * gradient / parent.b;
+      this->Elementwise(iterate, stepSize / parent.b, gradient);
+    }
+
+    //! The per-element WNGrad rule; called by ElementwiseUpdate.  The
+    //! learning rate adjustment is folded into the forwarded step scalar.
+    double Apply(const double scaledStepSize,
+                 const double x,
+                 const double g)
+    {
+      return x - scaledStepSize * g;
     }
 
    private:
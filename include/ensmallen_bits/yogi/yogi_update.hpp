@@ -13,6 +13,8 @@
 #ifndef ENSMALLEN_YOGI_YOGI_UPDATE_HPP
 #define ENSMALLEN_YOGI_YOGI_UPDATE_HPP
 
+#include <ensmallen_bits/sgd/update_policies/elementwise_update.hpp>
+
 namespace ens {
 
 /**
@@ -80,7 +82,7 @@ class YogiUpdate
    * specific to an individual optimization.
    */
   template<typename MatType, typename GradType>
-  class Policy
+  class Policy : public ElementwiseUpdate<Policy<MatType, GradType>>
   {
    public:
     /**
@@ -109,14 +111,26 @@ class YogiUpdate
                 const double stepSize,
                 const GradType& gradient)
     {
-      m *= parent.beta1;
-      m += (1 - parent.beta1) * gradient;
+      this->Elementwise(iterate, stepSize, gradient, m, v);
+    }
+
+    //! The per-element Yogi rule; called by ElementwiseUpdate.
+    template<typename StateElemType>
+    double Apply(const double stepSize,
+                 const double x,
+                 const double g,
+                 StateElemType& m,
+                 StateElemType& v)
+    {
+      m = (StateElemType) (parent.beta1 * m + (1 - parent.beta1) * g);
 
-      const MatType gSquared = arma::square(gradient);
-      v -= (1 - parent.beta2) * arma::sign(v - gSquared) % gSquared;
+      const double gSquared = g * g;
+      const double sign = (v > gSquared) ? 1.0 :
+          ((v < gSquared) ? -1.0 : 0.0);
+      v -= (StateElemType) ((1 - parent.beta2) * sign * gSquared);
 
       // Now update the iterate.
-      iterate -= stepSize * m / (arma::sqrt(v) + parent.epsilon);
+      return x - stepSize * m / (std::sqrt((double) v) + parent.epsilon);
     }
 
    private:
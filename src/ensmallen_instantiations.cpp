@@ -0,0 +1,18 @@
+/**
+ * @file ensmallen_instantiations.cpp
+ * @author Marcus Edel
+ *
+ * The single translation unit of the optional ensmallen_instantiations
+ * static library: it provides the definitions of the extern templates
+ * declared in ensmallen_bits/extern_templates.hpp, so consumers that define
+ * ENS_USE_EXTERN_TEMPLATES do not re-instantiate the common optimizer
+ * configurations in every translation unit.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#define ENS_INSTANTIATE_TEMPLATES
+
+#include <ensmallen.hpp>
@@ -69,3 +69,14 @@ TEST_CASE("AdaBeliefLogisticRegressionFMatTest", "[AdaBeliefTest]")
   LogisticRegressionFunctionTest<arma::fmat>(optimizer, 0.003, 0.006);
 }
 
+
+/**
+ * Run AdaBelief with single-precision moment storage on logistic regression
+ * and make sure the results are acceptable.
+ */
+TEST_CASE("AdaBeliefMixedPrecisionLogisticRegressionTest", "[AdaBeliefTest]")
+{
+  AdaBelief optimizer;
+  optimizer.MixedPrecision() = true;
+  LogisticRegressionFunctionTest(optimizer, 0.003, 0.006);
+}
@@ -344,3 +344,100 @@ TEST_CASE("AdamResetPolicyTest", "[AdamTest]")
 
   CheckMatrices(coordinatesA, coordinatesB);
 }
+
+/**
+ * Test the Adam optimizer with the fused single-pass update kernel on the
+ * Sphere function.
+ */
+TEST_CASE("AdamFusedUpdateSphereFunctionTest", "[AdamTest]")
+{
+  Adam optimizer(0.5, 2, 0.7, 0.999, 1e-8, 500000, 1e-3, false);
+  optimizer.Fused() = true;
+  FunctionTest<SphereFunction>(optimizer, 0.5, 0.2);
+}
+
+/**
+ * Run Adam with a sparse gradient type on the sparse test function; the lazy
+ * update path must catch up the moment decay of skipped coordinates.
+ */
+TEST_CASE("AdamSparseGradientTest", "[AdamTest]")
+{
+  SparseTestFunction f;
+  Adam optimizer(0.01, 1, 0.9, 0.999, 1e-8, 500000, 1e-9, true);
+
+  arma::mat coordinates = f.GetInitialPoint<arma::mat>();
+  optimizer.Optimize<SparseTestFunction, arma::mat, arma::sp_mat>(f,
+      coordinates);
+
+  REQUIRE(coordinates(0) == Approx(2.0).epsilon(0.01));
+  REQUIRE(coordinates(1) == Approx(1.0).epsilon(0.01));
+  REQUIRE(coordinates(2) == Approx(1.5).epsilon(0.01));
+  REQUIRE(coordinates(3) == Approx(4.0).epsilon(0.01));
+}
+
+/**
+ * Test the Adam optimizer with single-precision moment storage on the Sphere
+ * function.
+ */
+TEST_CASE("AdamMixedPrecisionSphereFunctionTest", "[AdamTest]")
+{
+  Adam optimizer(0.5, 2, 0.7, 0.999, 1e-8, 500000, 1e-3, false);
+  optimizer.MixedPrecision() = true;
+  FunctionTest<SphereFunction>(optimizer, 0.5, 0.2);
+}
+
+/**
+ * Test the Adam optimizer with decoupled weight decay (AdamW) on the Sphere
+ * function, with and without the fused update kernel.
+ */
+TEST_CASE("AdamWeightDecaySphereFunctionTest", "[AdamTest]")
+{
+  Adam optimizer(0.5, 2, 0.7, 0.999, 1e-8, 500000, 1e-3, false);
+  optimizer.WeightDecay() = 0.001;
+  FunctionTest<SphereFunction>(optimizer, 0.5, 0.2);
+
+  optimizer.Fused() = true;
+  FunctionTest<SphereFunction>(optimizer, 0.5, 0.2);
+}
+
+/**
+ * The binary16 conversion helpers must round-trip representable values
+ * exactly and stay within half-precision rounding error everywhere else.
+ */
+TEST_CASE("Fp16ConversionTest", "[AdamTest]")
+{
+  // Exactly representable values round-trip bit-for-bit.
+  REQUIRE(FromFp16(ToFp16(0.0f)) == 0.0f);
+  REQUIRE(FromFp16(ToFp16(1.0f)) == 1.0f);
+  REQUIRE(FromFp16(ToFp16(-0.5f)) == -0.5f);
+  REQUIRE(FromFp16(ToFp16(65504.0f)) == 65504.0f);
+  REQUIRE(FromFp16(ToFp16(6.103515625e-05f)) == 6.103515625e-05f);
+
+  // Other values round to within one half-precision ulp (2^-10 relative).
+  for (float x = 0.001f; x < 1000.0f; x *= 3.7f)
+  {
+    const float y = FromFp16(ToFp16(x));
+    REQUIRE(y == Approx(x).epsilon(0.001));
+  }
+
+  // Subnormal halves survive the round trip.
+  const float sub = 3.0e-07f;
+  REQUIRE(FromFp16(ToFp16(sub)) == Approx(sub).epsilon(0.2));
+
+  // Values beyond the half range saturate to infinity.
+  REQUIRE(std::isinf(FromFp16(ToFp16(1.0e06f))));
+}
+
+/**
+ * Test the Adam optimizer with packed half-precision moment storage on the
+ * Sphere function, without and with loss scaling.
+ */
+TEST_CASE("AdamHalfPrecisionSphereFunctionTest", "[AdamTest]")
+{
+  Adam optimizer(0.5, 2, 0.7, 0.999, 1e-8, 500000, 1e-3, false);
+  optimizer.HalfPrecision() = true;
+  FunctionTest<SphereFunction>(optimizer, 0.5, 0.2);
+
+  optimizer.LossScale() = 128.0;
+  FunctionTest<SphereFunction>(optimizer, 0.5, 0.2);
+}
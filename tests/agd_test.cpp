@@ -0,0 +1,42 @@
+/**
+ * @file agd_test.cpp
+ * @author Marcus Edel
+ *
+ * Test file for the Nesterov-accelerated gradient descent optimizer.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+#include "test_function_tools.hpp"
+
+using namespace ens;
+using namespace ens::test;
+
+TEST_CASE("AGDSimpleTestFunction", "[AGDTest]")
+{
+  AGD s(0.01, 5000000, 1e-9);
+  FunctionTest<GDTestFunction>(s, 0.1, 0.01);
+}
+
+/**
+ * With the same step size and iteration budget as the plain gradient descent
+ * Rosenbrock test, the accelerated variant should also reach the minimum;
+ * the adaptive restarts keep the momentum from diverging on this nonconvex
+ * valley.
+ */
+TEST_CASE("AGDRosenbrockTest", "[AGDTest]")
+{
+  AGD s(0.001, 0, 1e-15);
+  FunctionTest<RosenbrockFunction>(s, 0.01, 0.001);
+}
+
+TEST_CASE("AGDRosenbrockFMatTest", "[AGDTest]")
+{
+  AGD s(0.001, 0, 1e-15);
+  FunctionTest<RosenbrockFunction, arma::fmat>(s, 0.1, 0.01);
+}
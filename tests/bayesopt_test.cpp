@@ -0,0 +1,52 @@
+/**
+ * @file bayesopt_test.cpp
+ * @author Marcus Edel
+ *
+ * Test file for the Bayesian optimization optimizer.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+#include "test_function_tools.hpp"
+
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * Test Bayesian optimization on the Sphere function.  The evaluation budget
+ * is tiny compared to the population-based optimizers; that is the point of
+ * the method.
+ */
+TEST_CASE("BayesOptSphereFunctionTest", "[BayesOptTest]")
+{
+  SphereFunction f(2);
+  BayesianOptimization opt(10, 40, -2.0, 2.0);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  const double result = opt.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(0.1));
+  REQUIRE(coordinates(0) == Approx(0.0).margin(0.3));
+  REQUIRE(coordinates(1) == Approx(0.0).margin(0.3));
+}
+
+/**
+ * Test Bayesian optimization on the Sphere function with arma::fmat.
+ */
+TEST_CASE("BayesOptSphereFunctionFMatTest", "[BayesOptTest]")
+{
+  SphereFunction f(2);
+  BayesianOptimization opt(10, 40, -2.0, 2.0);
+
+  arma::fmat coordinates = f.GetInitialPoint<arma::fmat>();
+  const float result = opt.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0f).margin(0.1));
+  REQUIRE(coordinates(0) == Approx(0.0f).margin(0.3));
+  REQUIRE(coordinates(1) == Approx(0.0f).margin(0.3));
+}
@@ -104,3 +104,51 @@ TEST_CASE("BBSArmijoLogisticRegressionSpMatTest", "[BigBatchSGDTest]")
 }
 
 #endif
+
+/**
+ * Callback that records the variance test statistics published by
+ * BigBatchSGD at every step.
+ */
+class VarianceStatisticsCallback
+{
+ public:
+  VarianceStatisticsCallback() : steps(0), allFinite(true) { }
+
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  bool StepTaken(OptimizerType& optimizer,
+                 FunctionType& /* function */,
+                 MatType& /* coordinates */)
+  {
+    ++steps;
+    allFinite &= std::isfinite(optimizer.GradientNorm()) &&
+        std::isfinite(optimizer.SampleVariance()) &&
+        (optimizer.GradientNorm() >= 0.0) &&
+        (optimizer.SampleVariance() >= 0.0);
+    return false;
+  }
+
+  size_t steps;
+  bool allFinite;
+};
+
+/**
+ * Make sure the variance test statistics are published to callbacks during
+ * optimization.
+ */
+TEST_CASE("BBSBBVarianceStatisticsCallbackTest", "[BigBatchSGDTest]")
+{
+  arma::mat data, testData, shuffledData;
+  arma::Row<size_t> responses, testResponses, shuffledResponses;
+  LogisticRegressionTestData(data, testData, shuffledData,
+      responses, testResponses, shuffledResponses);
+  LogisticRegression<> lr(shuffledData, shuffledResponses, 0.5);
+
+  BBS_BB bbsgd(350, 0.001, 0.1, 5000, 1e-8, true, false);
+  arma::mat coordinates = lr.GetInitialPoint();
+
+  VarianceStatisticsCallback cb;
+  bbsgd.Optimize(lr, coordinates, cb);
+
+  REQUIRE(cb.steps > 0);
+  REQUIRE(cb.allFinite);
+}
@@ -628,6 +628,103 @@ TEST_CASE("EarlyStopAtMinLossCallbackTest", "[CallbacksTest]")
   REQUIRE(coordinates(2) == Approx(0.0).margin(1e-7));
 }
 
+/**
+ * Make sure a run resumed from a Checkpoint file continues exactly where the
+ * original run left off: optimize deterministically, checkpoint, restore the
+ * state into a fresh optimizer, then continue both runs and compare.
+ */
+TEST_CASE("CheckpointCallbackTest", "[CallbacksTest]")
+{
+  SGDTestFunction f;
+
+  // Unshuffled momentum SGD, so both runs take identical steps; the update
+  // policy state (the velocity) must survive the second Optimize() call.
+  MomentumSGD s(0.0003, 1, 15, 1e-15, false);
+  s.ResetPolicy() = false;
+
+  arma::mat coordinates = f.GetInitialPoint();
+  s.Optimize(f, coordinates, Checkpoint("checkpoint_test.bin", 1));
+
+  // Restore the last checkpoint into a fresh optimizer.
+  MomentumSGD resumed(0.0003, 1, 15, 1e-15, false);
+  arma::mat resumedCoordinates;
+  size_t epoch = 0;
+  double objective = 0;
+  REQUIRE(Checkpoint::Load("checkpoint_test.bin", resumed,
+      resumedCoordinates, epoch, objective) == true);
+
+  // The last checkpoint was taken at the final epoch end.
+  REQUIRE(epoch == 5);
+  REQUIRE(arma::approx_equal(resumedCoordinates, coordinates,
+      "absdiff", 0.0));
+
+  // Continue both runs; with identical coordinates and update-policy state
+  // they must stay in lockstep.
+  s.Optimize(f, coordinates);
+  resumed.Optimize(f, resumedCoordinates);
+
+  REQUIRE(arma::approx_equal(resumedCoordinates, coordinates,
+      "absdiff", 1e-12));
+
+  std::remove("checkpoint_test.bin");
+}
+
+/**
+ * Make sure the SmoothedEarlyStop callback will stop the optimization process.
+ */
+TEST_CASE("SmoothedEarlyStopCallbackTest", "[CallbacksTest]")
+{
+  SGDTestFunction f;
+  arma::mat coordinates = f.GetInitialPoint();
+
+  // Instantiate the optimizer with a number of iterations that will take a
+  // long time to finish.
+  StandardSGD s(0.0003, 1, 2000000000, -10);
+  s.ExactObjective() = true;
+
+  // The optimization process should return quickly.
+  const double result = s.Optimize(f, coordinates, SmoothedEarlyStop(100));
+
+  REQUIRE(result == Approx(-1.0).epsilon(0.0005));
+  REQUIRE(coordinates(0) == Approx(0.0).margin(1e-3));
+  REQUIRE(coordinates(1) == Approx(0.0).margin(1e-7));
+  REQUIRE(coordinates(2) == Approx(0.0).margin(1e-7));
+}
+
+/**
+ * Feed the SmoothedEarlyStop callback a fixed loss sequence and make sure the
+ * smoothing, the minimum-delta criterion and the validation schedule behave
+ * as documented.
+ */
+TEST_CASE("SmoothedEarlyStopCriterionTest", "[CallbacksTest]")
+{
+  SGDTestFunction f;
+  StandardSGD s(0.0003, 1, 5000000, 1e-9, true);
+  arma::mat coordinates(3, 1, arma::fill::zeros);
+
+  // With patience 2 and minDelta 0.5, an alternating 1.0 / 0.9 sequence never
+  // improves the smoothed loss significantly and must stop after the second
+  // non-improving epoch.
+  SmoothedEarlyStop cb(2, 0.5, 0.5);
+  REQUIRE(cb.EndEpoch(s, f, coordinates, 1, 1.0) == false);
+  REQUIRE(cb.EndEpoch(s, f, coordinates, 2, 0.9) == false);
+  REQUIRE(cb.EndEpoch(s, f, coordinates, 3, 1.0) == true);
+  REQUIRE(cb.SmoothedObjective() == Approx(0.975));
+
+  // A validation function on an interval of 2 must only be evaluated on every
+  // second epoch.
+  size_t evaluations = 0;
+  SmoothedEarlyStop cbValidation(
+      [&](const arma::mat& /* coordinates */)
+      {
+        ++evaluations;
+        return 1.0;
+      }, 10, 0.3, 0.0, 2);
+  for (size_t epoch = 1; epoch <= 6; ++epoch)
+    cbValidation.EndEpoch(s, f, coordinates, epoch, 0.0);
+  REQUIRE(evaluations == 3);
+}
+
 /**
  * Make sure the PrintLoss callback will print the loss to the specified
  * output stream.
@@ -662,6 +759,35 @@ TEST_CASE("ProgressBarCallbackTest", "[CallbacksTest]")
   REQUIRE(stream.str().length() > 0);
 }
 
+/**
+ * Make sure the AsyncLogger writes every blocking-enqueued message before it
+ * is destroyed, in order, even when many more messages are enqueued than the
+ * ring buffer holds.
+ */
+TEST_CASE("AsyncLoggerDrainTest", "[CallbacksTest]")
+{
+  std::stringstream stream;
+
+  {
+    AsyncLogger logger(stream, 8);
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      std::ostringstream line;
+      line << i << '\n';
+      logger.Enqueue(line.str());
+    }
+  }
+
+  size_t count = 0;
+  std::string line;
+  while (std::getline(stream, line))
+  {
+    REQUIRE(line == std::to_string(count));
+    ++count;
+  }
+  REQUIRE(count == 1000);
+}
+
 /**
  * Make sure the StoreBestCoordinates callback will store the best coordinates
  * and objective.
@@ -682,6 +808,55 @@ TEST_CASE("StoreBestCoordinatesCallbackTest", "[CallbacksTest]")
   REQUIRE(cb.BestCoordinates()(1) == Approx(0.0).margin(1e-7));
 }
 
+/**
+ * Make sure the StoreBestCoordinates copy policy honors the relative
+ * improvement threshold and the copy interval.
+ */
+TEST_CASE("StoreBestCoordinatesCopyPolicyTest", "[CallbacksTest]")
+{
+  SGDTestFunction f;
+  StandardSGD s(0.0003, 1, 5000000, 1e-9, true);
+
+  // Require a 10% relative improvement before the coordinates are copied.
+  StoreBestCoordinates<arma::mat> cb(0.1);
+
+  arma::mat coordinates(2, 1);
+  coordinates.fill(1.0);
+  cb.Evaluate(s, f, coordinates, 10.0);
+
+  // A 1% improvement is not significant, so the stored coordinates and
+  // objective must not change.
+  coordinates.fill(2.0);
+  cb.Evaluate(s, f, coordinates, 9.9);
+  REQUIRE(cb.BestObjective() == Approx(10.0));
+  REQUIRE(cb.BestCoordinates()(0) == Approx(1.0));
+
+  // A 50% improvement is significant and must be copied.
+  cb.Evaluate(s, f, coordinates, 5.0);
+  REQUIRE(cb.BestObjective() == Approx(5.0));
+  REQUIRE(cb.BestCoordinates()(0) == Approx(2.0));
+
+  // With a copy interval of 2 only every second significant improvement is
+  // copied.
+  StoreBestCoordinates<arma::mat> cbInterval(0.0, 2);
+  coordinates.fill(1.0);
+  cbInterval.Evaluate(s, f, coordinates, 10.0);
+
+  coordinates.fill(2.0);
+  cbInterval.Evaluate(s, f, coordinates, 9.0);
+  REQUIRE(cbInterval.BestObjective() == Approx(10.0));
+
+  coordinates.fill(3.0);
+  cbInterval.Evaluate(s, f, coordinates, 8.0);
+  REQUIRE(cbInterval.BestObjective() == Approx(8.0));
+  REQUIRE(cbInterval.BestCoordinates()(0) == Approx(3.0));
+
+  // After a Reset() the stored buffer is kept but the objective is forgotten.
+  cbInterval.Reset();
+  REQUIRE(cbInterval.BestObjective() == std::numeric_limits<double>::max());
+  REQUIRE(cbInterval.BestCoordinates().n_elem == 2);
+}
+
 /**
  * Make sure the TimerStop callback will stop the optimization process.
  */
@@ -702,6 +877,27 @@ TEST_CASE("TimerStopCallbackTest", "[CallbacksTest]")
   REQUIRE(timer.toc() < 2);
 }
 
+/**
+ * Make sure the DeadlineStop callback stops the optimization close to the
+ * wall-clock budget, without an epoch boundary ever being reached.
+ */
+TEST_CASE("DeadlineStopCallbackTest", "[CallbacksTest]")
+{
+  SGDTestFunction f;
+  arma::mat coordinates = f.GetInitialPoint();
+
+  // Instantiate the optimizer with a number of iterations that will take a
+  // long time to finish.
+  Adam opt(0.5, 2, 0.7, 0.999, 1e-8, 2000000000, -100, false);
+  arma::wall_clock timer;
+
+  timer.tic();
+  // A small check interval keeps the deadline tight.
+  opt.Optimize(f, coordinates, DeadlineStop(0.5, 0.05));
+  // Add some time to account for the function to return.
+  REQUIRE(timer.toc() < 2);
+}
+
 /**
  * Make sure the ProgressBar callback will show the progress on the specified
  * output stream if the MaxIterations parameter of the optimizer is 0.
@@ -868,3 +1064,246 @@ TEST_CASE("GradClipByValueCallbackTest", "[CallbacksTest]")
 
   REQUIRE(gradient == 0);
 }
+
+/**
+ * Make sure the compile-time callback gating traits correctly detect whether
+ * any callback in a pack implements a given event.
+ */
+TEST_CASE("CallbackStaticGatingTest", "[CallbacksTest]")
+{
+  typedef StandardSGD OptimizerType;
+  typedef SGDTestFunction FunctionType;
+
+  // An empty pack implements nothing.
+  REQUIRE(callbacks::traits::AnyHasEvaluate<
+      OptimizerType, FunctionType, arma::mat>::value == false);
+  REQUIRE(callbacks::traits::AnyHasStepTaken<
+      OptimizerType, FunctionType, arma::mat>::value == false);
+
+  // PrintLoss implements EndEpoch() but not StepTaken().
+  REQUIRE(callbacks::traits::AnyHasEndEpoch<
+      OptimizerType, FunctionType, arma::mat, PrintLoss>::value == true);
+  REQUIRE(callbacks::traits::AnyHasStepTaken<
+      OptimizerType, FunctionType, arma::mat, PrintLoss>::value == false);
+
+  // A pack with at least one interested callback is detected even if the
+  // others implement nothing.
+  REQUIRE(callbacks::traits::AnyHasEndEpoch<
+      OptimizerType, FunctionType, arma::mat, PrintLoss,
+      GradClipByValue>::value == true);
+}
+
+/**
+ * Make sure the Profiler callback records one histogram entry per event and
+ * doesn't disturb the optimization.
+ */
+TEST_CASE("ProfilerCallbackTest", "[CallbacksTest]")
+{
+  SGDTestFunction f;
+  arma::mat coordinates = f.GetInitialPoint();
+
+  StandardSGD s(0.0003, 1, 100, 1e-9, true);
+
+  Profiler profiler;
+  s.Optimize(f, coordinates, profiler);
+
+  REQUIRE(profiler.Evaluations() > 0);
+  REQUIRE(profiler.Steps() > 0);
+
+  // Every event lands in exactly one bucket.
+  arma::uword total = 0;
+  for (size_t i = 0; i < Profiler::numBuckets; ++i)
+    total += profiler.EvaluateHistogram()[i];
+  REQUIRE(total == profiler.Evaluations());
+
+  std::stringstream stream;
+  profiler.Print(stream);
+  REQUIRE(stream.str().find("evaluate") != std::string::npos);
+}
+
+/**
+ * Enabling hardware-counter sampling must never disturb the optimization:
+ * whether or not the kernel grants access to the counters (it usually does
+ * not on CI machines), the timing histograms are still collected and the
+ * summary still prints.
+ */
+TEST_CASE("ProfilerPerfCountersTest", "[CallbacksTest]")
+{
+  SGDTestFunction f;
+  arma::mat coordinates = f.GetInitialPoint();
+
+  StandardSGD s(0.0003, 1, 100, 1e-9, true);
+
+  Profiler profiler;
+  profiler.PerfCounters() = true;
+  s.Optimize(f, coordinates, profiler);
+
+  REQUIRE(profiler.Evaluations() > 0);
+  REQUIRE(profiler.Steps() > 0);
+
+  std::stringstream stream;
+  profiler.Print(stream);
+  REQUIRE(stream.str().find("evaluate") != std::string::npos);
+}
+
+/**
+ * The trajectory recorder must write one binary record per step into the
+ * ring file, readable back in chronological order, and the ring must keep
+ * only the most recent records once it wraps.
+ */
+TEST_CASE("TrajectoryRecorderCallbackTest", "[CallbacksTest]")
+{
+  SGDTestFunction f;
+  arma::mat coordinates = f.GetInitialPoint();
+
+  StandardSGD s(0.0003, 1, 100, 1e-9, true);
+
+  // A capacity smaller than the iteration count forces the ring to wrap.
+  TrajectoryRecorder recorder("trajectory_recorder_test.bin", 32);
+  s.Optimize(f, coordinates, recorder);
+
+  TrajectoryReader reader("trajectory_recorder_test.bin");
+  REQUIRE(reader.TotalWritten() > 0);
+  REQUIRE(reader.Records().size() ==
+      std::min((arma::uword) reader.TotalWritten(), (arma::uword) 32));
+
+  // The surviving records are the most recent ones, in order, and carry the
+  // optimizer's step size.
+  const size_t count = reader.Records().size();
+  for (size_t k = 0; k < count; ++k)
+  {
+    REQUIRE(reader.Records()[k].iteration ==
+        reader.TotalWritten() - count + k + 1);
+    REQUIRE(reader.Records()[k].stepSize == Approx(0.0003));
+  }
+
+  remove("trajectory_recorder_test.bin");
+}
+
+/**
+ * Make sure QueryFront publishes double-buffered front snapshots that can be
+ * read without copying, and optionally collects the queried history.
+ */
+TEST_CASE("QueryFrontSnapshotTest", "[CallbackTest]")
+{
+  arma::vec lowerBound = {-1000};
+  arma::vec upperBound = {1000};
+  NSGA2 optimizer(20, 100, 0.5, 0.5, 1e-3, 1e-6, lowerBound, upperBound);
+
+  SchafferFunctionN1<arma::mat> SCH;
+  typedef decltype(SCH.objectiveA) ObjectiveTypeA;
+  typedef decltype(SCH.objectiveB) ObjectiveTypeB;
+
+  arma::mat coordinates = SCH.GetInitialPoint();
+  std::tuple<ObjectiveTypeA, ObjectiveTypeB> objectives = SCH.GetObjectives();
+
+  std::vector<arma::cube> frontHistory;
+  QueryFront cb(10, frontHistory);
+  optimizer.Optimize(objectives, coordinates, cb);
+
+  // One snapshot per query must have been published, with the latest one
+  // available through the zero-copy accessor.
+  REQUIRE(cb.Generation() == frontHistory.size());
+  REQUIRE(cb.Generation() > 0);
+  REQUIRE(cb.Front().n_slices == frontHistory.back().n_slices);
+  REQUIRE(arma::approx_equal(cb.Front(), frontHistory.back(), "absdiff",
+      1e-12));
+}
+
+/**
+ * Make sure the Report callback produces a summary when the history capacity
+ * is much smaller than the number of iterations (the sampled history must
+ * still cover the whole run).
+ */
+TEST_CASE("ReportCallbackBoundedHistoryTest", "[CallbacksTest]")
+{
+  std::stringstream stream;
+
+  SGDTestFunction f;
+  StandardSGD s(0.0003, 1, 5000, 1e-12, true);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  s.Optimize(f, coordinates, Report(0.1, stream, 4, 16));
+
+  REQUIRE(stream.str().length() > 0);
+  // The iteration count reported must be the true number of steps, not the
+  // number of stored samples.
+  REQUIRE(stream.str().find("5000") != std::string::npos);
+}
+
+/**
+ * Make sure the coarse clock ticks forward and never runs backwards.
+ */
+TEST_CASE("CoarseClockTest", "[CallbacksTest]")
+{
+  const double before = CoarseClock::Get().Now();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  const double after = CoarseClock::Get().Now();
+
+  REQUIRE(after >= before);
+  // With a one-millisecond tick, a 50ms sleep must be visible.
+  REQUIRE(after - before > 0.005);
+}
+
+/**
+ * Copies of a CancellationToken share one flag, so cancelling any copy is
+ * observed by all of them, and Reset() re-arms the token.
+ */
+TEST_CASE("CancellationTokenSharedStateTest", "[CallbacksTest]")
+{
+  CancellationToken token;
+  CancellationToken copy = token;
+
+  REQUIRE(token.Cancelled() == false);
+  copy.Cancel();
+  REQUIRE(token.Cancelled() == true);
+  REQUIRE(copy.Cancelled() == true);
+
+  token.Reset();
+  REQUIRE(copy.Cancelled() == false);
+}
+
+/**
+ * Make sure the CancellationStop callback stops the optimization as soon as
+ * the token is cancelled: with a pre-cancelled token, the optimizer returns
+ * after only a handful of function evaluations.
+ */
+TEST_CASE("CancellationStopCallbackTest", "[CallbacksTest]")
+{
+  SGDTestFunction f;
+  arma::mat coordinates = f.GetInitialPoint();
+
+  // Instantiate the optimizer with a number of iterations that would take a
+  // very long time to finish.
+  Adam opt(0.5, 2, 0.7, 0.999, 1e-8, 2000000000, -100, false);
+
+  CancellationToken token;
+  token.Cancel();
+
+  arma::wall_clock timer;
+  timer.tic();
+  opt.Optimize(f, coordinates, CancellationStop(token));
+  // The optimization has to wind down almost immediately.
+  REQUIRE(timer.toc() < 2);
+}
+
+/**
+ * The cancellation token is also polled from the L-BFGS line search trials,
+ * so a cancelled token stops L-BFGS mid line search and leaves a usable
+ * iterate behind.
+ */
+TEST_CASE("CancellationStopLBFGSTest", "[CallbacksTest]")
+{
+  GeneralizedRosenbrockFunction f(10);
+  arma::mat coordinates = f.GetInitialPoint();
+
+  L_BFGS lbfgs;
+  lbfgs.MaxIterations() = 10000;
+
+  CancellationToken token;
+  token.Cancel();
+  lbfgs.Optimize(f, coordinates, CancellationStop(token));
+
+  // The iterate must still be finite and usable.
+  REQUIRE(coordinates.is_finite());
+}
@@ -194,7 +194,7 @@ TEST_CASE("SoftmaxRegressionFunctionPartialGradientTest", "[CDTest]")
 
   // 2 objects for 2 terms in the cost function. Each term contributes towards
   // the gradient and thus need to be checked independently.
-  SoftmaxRegressionFunction srf(data, labels, numClasses, 0);
+  SoftmaxRegressionFunction<> srf(data, labels, numClasses, 0);
 
   // Create a random set of parameters.
   arma::mat parameters;
@@ -215,3 +215,196 @@ TEST_CASE("SoftmaxRegressionFunctionPartialGradientTest", "[CDTest]")
     CheckMatrices(arma::mat(gradient.col(j)), arma::mat(fGrad.col(j)));
   }
 }
+
+/**
+ * Test that LogisticRegressionFunction gives the same objective and gradient
+ * for sparse data as for the equivalent dense data.
+ */
+TEST_CASE("LogisticRegressionFunctionSparseDataTest", "[CDTest]")
+{
+  const size_t points = 500;
+  const size_t dimension = 25;
+
+  // Initialize a random sparse dataset, with a dense copy of it.
+  arma::sp_mat sparseData;
+  sparseData.sprandu(dimension, points, 0.1);
+  arma::mat denseData(sparseData);
+
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t> >(
+      points, arma::distr_param(0, 1));
+
+  LogisticRegressionFunction<arma::mat> f(denseData, labels, 0.001);
+  LogisticRegressionFunction<arma::mat, arma::sp_mat> fSparse(sparseData,
+      labels, 0.001);
+
+  arma::mat parameters(1, f.NumFeatures(), arma::fill::randu);
+
+  REQUIRE(f.Evaluate(parameters) ==
+      Approx(fSparse.Evaluate(parameters)).epsilon(1e-10));
+
+  arma::mat gradient, sparseGradient;
+  f.Gradient(parameters, gradient);
+  fSparse.Gradient(parameters, sparseGradient);
+  CheckMatrices(gradient, sparseGradient);
+
+  for (size_t j = 0; j < f.NumFeatures(); ++j)
+  {
+    arma::sp_mat fGrad, fSparseGrad;
+    f.PartialGradient(parameters, j, fGrad);
+    fSparse.PartialGradient(parameters, j, fSparseGrad);
+    CheckMatrices(arma::mat(fGrad), arma::mat(fSparseGrad));
+  }
+}
+
+/**
+ * Test that SoftmaxRegressionFunction gives the same objective and gradient
+ * for sparse data as for the equivalent dense data.
+ */
+TEST_CASE("SoftmaxRegressionFunctionSparseDataTest", "[CDTest]")
+{
+  const size_t points = 500;
+  const size_t inputSize = 25;
+  const size_t numClasses = 5;
+
+  // Initialize a random sparse dataset, with a dense copy of it.
+  arma::sp_mat sparseData;
+  sparseData.sprandu(inputSize, points, 0.1);
+  arma::mat denseData(sparseData);
+
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t> >(
+      points, arma::distr_param(0, numClasses - 1));
+
+  SoftmaxRegressionFunction<> srf(denseData, labels, numClasses, 0.001);
+  SoftmaxRegressionFunction<arma::sp_mat> srfSparse(sparseData, labels,
+      numClasses, 0.001);
+
+  arma::mat parameters;
+  parameters.randu(numClasses, inputSize);
+
+  REQUIRE(srf.Evaluate(parameters) ==
+      Approx(srfSparse.Evaluate(parameters)).epsilon(1e-10));
+
+  arma::mat gradient, sparseGradient;
+  srf.Gradient(parameters, gradient);
+  srfSparse.Gradient(parameters, sparseGradient);
+  CheckMatrices(gradient, sparseGradient);
+}
+
+/**
+ * Test the block coordinate descent mode on a pre-calculated logistic
+ * regression problem.
+ */
+TEST_CASE("BlockCDTest", "[CDTest]")
+{
+  arma::mat predictors("0 0 0.4; 0 0 0.6; 0 0.3 0; 0.2 0 0; 0.2 -0.5 0;");
+  arma::Row<size_t> responses("1  1  0;");
+
+  LogisticRegressionFunction<arma::mat> f(predictors, responses, 0.0001);
+
+  // Update blocks of three coordinates per iteration.
+  CD<CyclicDescent> s(0.02, 20000, 1e-5, 1e3, CyclicDescent(), 3);
+  arma::mat iterate = f.InitialPoint();
+
+  double objective = s.Optimize(f, iterate);
+
+  REQUIRE(objective <= 0.055);
+}
+
+/**
+ * Test that the batched block PartialGradient() of the logistic regression
+ * function matches the per-feature partial gradients.
+ */
+TEST_CASE("LogisticRegressionFunctionBlockPartialGradientTest", "[CDTest]")
+{
+  arma::mat predictors("0 0 0.4; 0 0 0.6; 0 0.3 0; 0.2 0 0; 0.2 -0.5 0;");
+  arma::Row<size_t> responses("1  1  0;");
+
+  LogisticRegressionFunction<arma::mat> f(predictors, responses, 0.0001);
+
+  arma::mat testPoint(1, f.NumFeatures(), arma::fill::randu);
+
+  const arma::uvec features = arma::regspace<arma::uvec>(0, 1,
+      f.NumFeatures() - 1);
+  arma::sp_mat blockGrad;
+  f.PartialGradient(testPoint, features, blockGrad);
+
+  for (size_t i = 0; i < f.NumFeatures(); ++i)
+  {
+    arma::sp_mat fGrad;
+    f.PartialGradient(testPoint, i, fGrad);
+
+    CheckMatrices(arma::mat(blockGrad.col(i)), arma::mat(fGrad.col(i)));
+  }
+}
+
+/**
+ * Test the lazy greedy descent policy.
+ */
+TEST_CASE("LazyGreedyDescentTest", "[CDTest]")
+{
+  // In the sparse test function, the given point has the maximum gradient at
+  // the feature with index 2.
+  arma::mat point("1; 2; 3; 4;");
+
+  SparseTestFunction f;
+
+  LazyGreedyDescent policy;
+
+  REQUIRE(policy.DescentFeature<SparseTestFunction,
+                                arma::mat,
+                                arma::mat>(1, point, f) == 2);
+
+  // Changing the point under consideration, so that the maximum gradient is at
+  // index 1.  The estimates held by the first policy are stale, so use a fresh
+  // policy, whose first selection performs a full greedy pass.
+  point(1) = 10;
+
+  LazyGreedyDescent freshPolicy;
+
+  REQUIRE(freshPolicy.DescentFeature<SparseTestFunction,
+                                     arma::mat,
+                                     arma::mat>(1, point, f) == 1);
+}
+
+/**
+ * Test the correctness of the CD implementation with the lazy greedy descent
+ * policy by using the sparse test function.
+ */
+TEST_CASE("LazyGreedyDisjointFeatureTest", "[CDTest]")
+{
+  LazyGreedyCD s(0.4);
+  FunctionTest<SparseTestFunction>(s, 0.01, 0.001);
+}
+
+/**
+ * Test the shotgun parallel mode on the sparse test function, whose disjoint
+ * features make concurrent coordinate updates conflict-free; the result must
+ * match the sequential behavior.
+ */
+TEST_CASE("ShotgunDisjointFeatureTest", "[CDTest]")
+{
+  CD<> s(0.4);
+  s.Shotgun() = true;
+  FunctionTest<SparseTestFunction>(s, 0.01, 0.001);
+}
+
+/**
+ * Test the shotgun parallel mode on a correlated problem with an explicit
+ * round width, using the precalculated-minimum logistic regression problem.
+ */
+TEST_CASE("ShotgunPreCalcCDTest", "[CDTest]")
+{
+  arma::mat predictors("0 0 0.4; 0 0 0.6; 0 0.3 0; 0.2 0 0; 0.2 -0.5 0;");
+  arma::Row<size_t> responses("1  1  0;");
+
+  LogisticRegressionFunction<arma::mat> f(predictors, responses, 0.0001);
+
+  CD<> s(0.02, 60000, 1e-5);
+  s.Shotgun() = true;
+  s.ShotgunThreads() = 2;
+  arma::mat iterate = f.InitialPoint();
+
+  double objective = s.Optimize(f, iterate);
+
+  REQUIRE(objective <= 0.055);
+}
@@ -75,3 +75,234 @@ TEST_CASE("ApproxCMAESEmptyTransformationLogisticRegressionFMatTest",
     cmaes(0, EmptyTransformation<arma::fmat>(), 16, 500, 1e-3);
   LogisticRegressionFunctionTest<arma::fmat>(cmaes, 0.01, 0.02, 5);
 }
+
+/**
+ * Run CMA-ES with parallel population evaluation on logistic regression and
+ * make sure the results are acceptable.
+ */
+TEST_CASE("ParallelEvaluationCMAESLogisticRegressionTest", "[CMAESTest]")
+{
+  BoundaryBoxConstraint<> b(-10, 10);
+  CMAES<FullSelection, BoundaryBoxConstraint<>> cmaes(0, b, 32, 500, 1e-3);
+  cmaes.StepSize() = 0.6;
+  cmaes.ParallelEvaluation() = true;
+  LogisticRegressionFunctionTest(cmaes, 0.003, 0.006, 5);
+}
+
+/**
+ * Run CMA-ES with a lazy covariance factorization schedule on logistic
+ * regression and make sure the results are acceptable.
+ */
+TEST_CASE("LazyEigenCMAESLogisticRegressionTest", "[CMAESTest]")
+{
+  BoundaryBoxConstraint<> b(-10, 10);
+  CMAES<FullSelection, BoundaryBoxConstraint<>> cmaes(0, b, 32, 500, 1e-3);
+  cmaes.StepSize() = 0.6;
+  cmaes.EigenInterval() = 5;
+  LogisticRegressionFunctionTest(cmaes, 0.003, 0.006, 5);
+}
+
+/**
+ * Run CMA-ES with mirrored sampling and pairwise selection on logistic
+ * regression and make sure the results are acceptable.
+ */
+TEST_CASE("MirroredCMAESLogisticRegressionTest", "[CMAESTest]")
+{
+  BoundaryBoxConstraint<> b(-10, 10);
+  CMAES<FullSelection, BoundaryBoxConstraint<>> cmaes(0, b, 32, 500, 1e-3);
+  cmaes.StepSize() = 0.6;
+  cmaes.MirroredSampling() = true;
+  LogisticRegressionFunctionTest(cmaes, 0.003, 0.006, 5);
+}
+
+/**
+ * Run Cholesky-CMA-ES (triangular factor updates instead of
+ * eigendecomposition) on logistic regression and make sure the results are
+ * acceptable.
+ */
+TEST_CASE("CholeskyCMAESLogisticRegressionTest", "[CMAESTest]")
+{
+  BoundaryBoxConstraint<> b(-10, 10);
+  CholeskyCMAES<FullSelection, BoundaryBoxConstraint<>>
+      cmaes(0, b, 32, 500, 1e-3);
+  cmaes.StepSize() = 0.6;
+  LogisticRegressionFunctionTest(cmaes, 0.003, 0.006, 5);
+}
+
+/**
+ * Run Cholesky-CMA-ES on logistic regression, using arma::fmat.
+ */
+TEST_CASE("CholeskyCMAESLogisticRegressionFMatTest", "[CMAESTest]")
+{
+  BoundaryBoxConstraint<arma::fmat> b(-10, 10);
+  CholeskyCMAES<FullSelection, BoundaryBoxConstraint<arma::fmat>>
+      cmaes(0, b, 32, 500, 1e-3);
+  cmaes.StepSize() = 0.6;
+  LogisticRegressionFunctionTest<arma::fmat>(cmaes, 0.01, 0.02, 5);
+}
+
+/**
+ * Run sep-CMA-ES (diagonal covariance) on logistic regression and make sure
+ * the results are acceptable.
+ */
+TEST_CASE("SepCMAESLogisticRegressionTest", "[CMAESTest]")
+{
+  BoundaryBoxConstraint<> b(-10, 10);
+  SepCMAES<FullSelection, BoundaryBoxConstraint<>> cmaes(0, b, 32, 500, 1e-3);
+  cmaes.StepSize() = 0.6;
+  LogisticRegressionFunctionTest(cmaes, 0.003, 0.006, 5);
+}
+
+/**
+ * Run sep-CMA-ES with the random selection policy on logistic regression,
+ * using arma::fmat.
+ */
+TEST_CASE("SepCMAESLogisticRegressionFMatTest", "[CMAESTest]")
+{
+  BoundaryBoxConstraint<arma::fmat> b(-10, 10);
+  SepCMAES<FullSelection, BoundaryBoxConstraint<arma::fmat>>
+      cmaes(0, b, 32, 500, 1e-3);
+  cmaes.StepSize() = 0.6;
+  LogisticRegressionFunctionTest<arma::fmat>(cmaes, 0.01, 0.02, 5);
+}
+
+/**
+ * Drive CMA-ES through the ask/tell interface on a simple quadratic and make
+ * sure it converges to the minimum.
+ */
+TEST_CASE("CMAESAskTellTest", "[CMAESTest]")
+{
+  CMAES<> cmaes(64, EmptyTransformation<>(), 32, 500, 1e-5);
+  cmaes.StepSize() = 0.6;
+
+  arma::mat iterate(5, 1, arma::fill::ones);
+  cmaes.Initialize(iterate);
+
+  double bestObjective = std::numeric_limits<double>::max();
+  for (size_t gen = 0; gen < 300; ++gen)
+  {
+    const arma::mat population = cmaes.Ask<arma::mat>();
+    arma::mat objectives(population.n_cols, 1);
+    for (size_t j = 0; j < population.n_cols; ++j)
+      objectives(j) = arma::accu(arma::square(population.col(j)));
+
+    bestObjective = cmaes.Tell(objectives);
+  }
+
+  const arma::mat best = cmaes.Best<arma::mat>();
+  REQUIRE(best.n_rows == 5);
+  REQUIRE(best.n_cols == 1);
+  REQUIRE(bestObjective == Approx(0.0).margin(1e-6));
+  REQUIRE(arma::norm(best) == Approx(0.0).margin(1e-3));
+}
+
+/**
+ * Calling Ask() before Initialize() should throw.
+ */
+TEST_CASE("CMAESAskBeforeInitializeTest", "[CMAESTest]")
+{
+  CMAES<> cmaes;
+  REQUIRE_THROWS_AS(cmaes.Ask<arma::mat>(), std::logic_error);
+}
+
+/**
+ * Run CMA-ES with the surrogate selection policy on logistic regression,
+ * make sure the results are acceptable, and make sure the surrogate
+ * actually skipped a part of the true objective evaluations.
+ */
+TEST_CASE("SurrogateCMAESLogisticRegressionTest", "[CMAESTest]")
+{
+  BoundaryBoxConstraint<> b(-10, 10);
+  CMAES<SurrogateSelection, BoundaryBoxConstraint<>>
+      cmaes(0, b, 32, 500, 1e-3);
+  cmaes.StepSize() = 0.6;
+  LogisticRegressionFunctionTest(cmaes, 0.003, 0.006, 5);
+
+  REQUIRE(cmaes.SelectionPolicy().TrueEvaluations() <
+      cmaes.SelectionPolicy().Calls());
+}
+
+/**
+ * Run CMA-ES with the racing selection policy on logistic regression and
+ * make sure the results are acceptable.
+ */
+TEST_CASE("RacingCMAESLogisticRegressionTest", "[CMAESTest]")
+{
+  BoundaryBoxConstraint<> b(-10, 10);
+  CMAES<RacingSelection, BoundaryBoxConstraint<>> cmaes(0, b, 32, 500, 1e-3,
+      RacingSelection(0.1, 0.95));
+  cmaes.StepSize() = 0.6;
+  LogisticRegressionFunctionTest(cmaes, 0.003, 0.006, 5);
+}
+
+/**
+ * Make sure the batched boundary box transformation maps arbitrary
+ * coordinates into the box and leaves interior coordinates untouched.
+ */
+TEST_CASE("BoundaryBoxConstraintTransformTest", "[CMAESTest]")
+{
+  BoundaryBoxConstraint<> b(-1.3, 2.4);
+
+  arma::mat x(10, 7, arma::fill::randn);
+  x *= 10;
+  const arma::mat y = b.Transform(x);
+
+  REQUIRE(y.min() >= -1.3);
+  REQUIRE(y.max() <= 2.4);
+
+  // Well inside the box the transformation is the identity.
+  arma::mat interior(10, 7);
+  interior.fill(0.5);
+  const arma::mat z = b.Transform(interior);
+  REQUIRE(arma::approx_equal(z, interior, "absdiff", 1e-12));
+}
+
+/**
+ * Make sure a warm-started CMA-ES run retains its search distribution, and
+ * that the exported covariance and step size can be injected into a fresh
+ * optimizer that then stays converged on a small budget.
+ */
+TEST_CASE("CMAESWarmStartTest", "[CMAESTest]")
+{
+  SphereFunction f(4);
+  CMAES<> cmaes(0, EmptyTransformation<>(), 32, 500, 1e-8);
+  cmaes.WarmStart() = true;
+
+  arma::mat coords = f.GetInitialPoint<arma::mat>();
+  cmaes.Optimize(f, coords);
+
+  // The retained distribution is exposed for export.
+  REQUIRE(cmaes.Covariance<arma::mat>().n_rows == 4);
+  REQUIRE(cmaes.Covariance<arma::mat>().n_cols == 4);
+  REQUIRE(cmaes.DistributionStepSize<arma::mat>() > 0.0);
+
+  // Inject the exported distribution into a fresh optimizer with a small
+  // budget; it resumes from the shrunk step size and stays converged.
+  CMAES<> fresh(0, EmptyTransformation<>(), 32, 10, 1e-8);
+  fresh.SeedDistribution(cmaes.Covariance<arma::mat>(),
+      cmaes.DistributionStepSize<arma::mat>());
+  arma::mat coords2 = coords;
+  fresh.Optimize(f, coords2);
+  REQUIRE(f.Evaluate(coords2) <= 1e-3);
+}
+
+/**
+ * The in-place Transform() overloads must agree with the by-value ones;
+ * the CMA-ES generation loop relies on them to reuse its workspace
+ * buffers.
+ */
+TEST_CASE("TransformationPolicyInPlaceTest", "[CMAESTest]")
+{
+  arma::mat x(6, 1, arma::fill::randn);
+  x *= 10;
+
+  EmptyTransformation<> e;
+  arma::mat eOut(6, 1);
+  e.Transform(x, eOut);
+  REQUIRE(arma::approx_equal(eOut, e.Transform(x), "absdiff", 1e-12));
+
+  BoundaryBoxConstraint<> b(-1.3, 2.4);
+  arma::mat bOut(6, 1);
+  b.Transform(x, bOut);
+  REQUIRE(arma::approx_equal(bOut, b.Transform(x), "absdiff", 1e-12));
+}
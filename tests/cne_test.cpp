@@ -163,3 +163,173 @@ TEST_CASE("CNESchafferFunctionN2Test", "[CNETest]")
   CNE optimizer(500, 1600, 0.3, 0.3, 0.3, -1);
   FunctionTest<SchafferFunctionN2>(optimizer, 0.5, 0.1, 7);
 }
+
+/**
+ * Train and test a logistic regression function using CNE with parallel
+ * candidate evaluation enabled.
+ */
+TEST_CASE("CNEParallelEvaluationLogisticRegressionTest", "[CNETest]")
+{
+  CNE opt(300, 150, 0.2, 0.2, 0.2, -1);
+  opt.ParallelEvaluation() = true;
+  LogisticRegressionFunctionTest(opt, 0.003, 0.006);
+}
+
+/**
+ * Train and test a logistic regression function using the CNE optimizer with
+ * quasi-random population initialization.
+ */
+TEST_CASE("CNEQuasiRandomInitLogisticRegressionTest", "[CNETest]")
+{
+  CNE opt(300, 150, 0.2, 0.2, 0.2, -1);
+  opt.QuasiRandomInit() = true;
+  LogisticRegressionFunctionTest(opt, 0.003, 0.006);
+}
+
+/**
+ * A sphere objective that counts how often it is evaluated.
+ */
+struct CountingSphereFunction
+{
+  size_t evaluations = 0;
+
+  double Evaluate(const arma::mat& coordinates)
+  {
+    ++evaluations;
+    return arma::accu(arma::square(coordinates));
+  }
+};
+
+/**
+ * With fitness caching the unmodified elite candidates must not be
+ * re-evaluated: each generation after the first only costs
+ * populationSize - numElite evaluations.  Setting a re-evaluation cadence
+ * forces periodic full evaluations for noisy objectives.
+ */
+TEST_CASE("CNEEliteFitnessCachingTest", "[CNETest]")
+{
+  // populationSize = 20 and selectPercent = 0.2 give numElite = 4; a
+  // tolerance of 0 disables early termination so the count is deterministic.
+  CountingSphereFunction f;
+  CNE opt(20, 50, 0.1, 0.02, 0.2, 0.0);
+
+  arma::mat coordinates = arma::ones<arma::mat>(2, 1);
+  opt.Optimize(f, coordinates);
+
+  // One evaluation before and one after the generation loop, a full first
+  // generation, then 16 fresh candidates in each of the remaining 49.
+  REQUIRE(f.evaluations == 2 + 20 + 49 * 16);
+
+  // With a forced re-evaluation every 10 generations, 5 of those generations
+  // cost the full population again.
+  CountingSphereFunction g;
+  CNE reevalOpt(20, 50, 0.1, 0.02, 0.2, 0.0);
+  reevalOpt.ReevalInterval() = 10;
+
+  coordinates = arma::ones<arma::mat>(2, 1);
+  reevalOpt.Optimize(g, coordinates);
+
+  REQUIRE(g.evaluations == 2 + 20 + 44 * 16 + 5 * 20);
+}
+
+/**
+ * A sphere objective with the optional bound-aware Evaluate() form: the
+ * objective is accumulated one dimension at a time and the evaluation stops
+ * once the partial sum crosses the bound passed in by the optimizer.
+ */
+struct BoundAwareSphereFunction
+{
+  size_t truncated = 0;
+
+  double Evaluate(const arma::mat& coordinates)
+  {
+    return arma::accu(arma::square(coordinates));
+  }
+
+  double Evaluate(const arma::mat& coordinates, const double bound)
+  {
+    double sum = 0.0;
+    for (size_t i = 0; i < coordinates.n_elem; ++i)
+    {
+      sum += coordinates(i) * coordinates(i);
+      if (sum >= bound)
+      {
+        ++truncated;
+        return sum;
+      }
+    }
+    return sum;
+  }
+};
+
+/**
+ * CNE hands the fitness of the worst elite to functions with the bound-aware
+ * Evaluate() form, so hopeless candidates are abandoned part-way through
+ * their evaluation; the surviving candidates are still scored exactly and
+ * the optimization converges as usual.
+ */
+TEST_CASE("CNEBoundedEvaluateTest", "[CNETest]")
+{
+  BoundAwareSphereFunction f;
+  CNE opt(100, 300, 0.2, 0.2, 0.2, -1);
+
+  arma::mat coordinates = arma::ones<arma::mat>(4, 1);
+  const double result = opt.Optimize(f, coordinates);
+
+  REQUIRE(result <= 1.0);
+  REQUIRE(f.truncated > 0);
+}
+
+// A simple binary objective: the number of unset bits in the genome, so the
+// optimum is the all-ones genome with objective 0.
+struct OneMaxFunction
+{
+  double Evaluate(const arma::mat& coordinates)
+  {
+    double unset = 0;
+    for (size_t i = 0; i < coordinates.n_elem; ++i)
+      unset += (coordinates(i) < 0.5) ? 1.0 : 0.0;
+    return unset;
+  }
+};
+
+/**
+ * The packed genome arena must round-trip genomes through Pack()/Unpack()
+ * and report popcount-based Hamming distances correctly.
+ */
+TEST_CASE("PackedPopulationRoundTripTest", "[CNETest]")
+{
+  PackedPopulation packed(2, 100);
+
+  arma::mat genome(100, 1, arma::fill::zeros);
+  for (size_t i = 0; i < 100; i += 3)
+    genome(i) = 1.0;
+  packed.Pack(0, genome);
+
+  arma::mat unpacked(100, 1);
+  packed.Unpack(0, unpacked);
+  for (size_t i = 0; i < 100; ++i)
+    REQUIRE(unpacked(i) == genome(i));
+
+  // Slot 1 is all zeros, so the distance is the number of set bits.
+  REQUIRE(packed.HammingDistance(0, 1) == 34);
+  REQUIRE(packed.HammingDistance(0, 0) == 0);
+}
+
+/**
+ * With binary genomes enabled, CNE evolves the population bitwise and solves
+ * the OneMax problem.
+ */
+TEST_CASE("CNEBinaryGenomeOneMaxTest", "[CNETest]")
+{
+  OneMaxFunction f;
+  CNE opt(100, 500, 0.02, 0.02, 0.2, -1);
+  opt.BinaryGenome() = true;
+
+  arma::mat coordinates(64, 1, arma::fill::zeros);
+  const double result = opt.Optimize(f, coordinates);
+
+  REQUIRE(result <= 2.0);
+  for (size_t i = 0; i < coordinates.n_elem; ++i)
+    REQUIRE((coordinates(i) == 0.0 || coordinates(i) == 1.0));
+}
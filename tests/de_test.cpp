@@ -33,3 +33,247 @@ TEST_CASE("DELogisticRegressionFMatTest", "[DETest]")
   DE opt(200, 1000, 0.6, 0.8, 1e-5);
   LogisticRegressionFunctionTest<arma::fmat>(opt, 0.03, 0.06, 3);
 }
+
+/**
+ * Drive DE through the ask/tell interface on a simple quadratic and make
+ * sure it converges to the minimum.
+ */
+TEST_CASE("DEAskTellTest", "[DETest]")
+{
+  DE opt(100, 1000, 0.6, 0.8, 1e-5);
+
+  arma::mat iterate(5, 1, arma::fill::ones);
+  opt.Initialize(iterate);
+
+  double bestObjective = std::numeric_limits<double>::max();
+  for (size_t gen = 0; gen < 300; ++gen)
+  {
+    const arma::mat population = opt.Ask<arma::mat>();
+    arma::mat objectives(population.n_cols, 1);
+    for (size_t j = 0; j < population.n_cols; ++j)
+      objectives(j) = arma::accu(arma::square(population.col(j)));
+
+    bestObjective = opt.Tell(objectives);
+  }
+
+  const arma::mat best = opt.Best<arma::mat>();
+  REQUIRE(best.n_rows == 5);
+  REQUIRE(best.n_cols == 1);
+  REQUIRE(bestObjective == Approx(0.0).margin(0.01));
+  REQUIRE(arma::norm(best) == Approx(0.0).margin(0.1));
+}
+
+/**
+ * Train and test a logistic regression function using the SHADE optimizer.
+ */
+TEST_CASE("SHADELogisticRegressionTest", "[DETest]")
+{
+  SHADE opt(200, 1000, 50, 0.2, 1e-5);
+  LogisticRegressionFunctionTest(opt, 0.01, 0.02, 3);
+}
+
+/**
+ * Train and test a logistic regression function using the SHADE optimizer.
+ * Use arma::fmat.
+ */
+TEST_CASE("SHADELogisticRegressionFMatTest", "[DETest]")
+{
+  SHADE opt(200, 1000, 50, 0.2, 1e-5);
+  LogisticRegressionFunctionTest<arma::fmat>(opt, 0.03, 0.06, 3);
+}
+
+/**
+ * The batched population Evaluate() overloads must agree with scoring the
+ * candidates one at a time.
+ */
+TEST_CASE("BatchedPopulationEvaluateTest", "[DETest]")
+{
+  arma::vec fitness(20);
+
+  // Sphere and Rastrigin, in five dimensions.
+  SphereFunction sf(5);
+  RastriginFunction rf(5);
+  arma::mat population(5, 20, arma::fill::randn);
+  population *= 2.0;
+
+  sf.Evaluate(population, fitness);
+  for (size_t i = 0; i < population.n_cols; ++i)
+  {
+    REQUIRE(fitness[i] ==
+        Approx(sf.Evaluate(arma::mat(population.col(i)))).margin(1e-10));
+  }
+
+  rf.Evaluate(population, fitness);
+  for (size_t i = 0; i < population.n_cols; ++i)
+  {
+    REQUIRE(fitness[i] ==
+        Approx(rf.Evaluate(arma::mat(population.col(i)))).margin(1e-10));
+  }
+
+  // Ackley, in its fixed two dimensions.
+  AckleyFunction af;
+  arma::mat population2(2, 20, arma::fill::randn);
+
+  af.Evaluate(population2, fitness);
+  for (size_t i = 0; i < population2.n_cols; ++i)
+  {
+    REQUIRE(fitness[i] ==
+        Approx(af.Evaluate(arma::mat(population2.col(i)))).margin(1e-10));
+  }
+
+  // Logistic regression, with the parameter vectors as columns.
+  arma::mat data(3, 100, arma::fill::randu);
+  arma::Row<size_t> responses = arma::randi<arma::Row<size_t> >(
+      100, arma::distr_param(0, 1));
+  LogisticRegressionFunction<arma::mat> lrf(data, responses, 0.5);
+
+  arma::mat population3(4, 20, arma::fill::randn);
+  lrf.Evaluate(population3, fitness);
+  for (size_t i = 0; i < population3.n_cols; ++i)
+  {
+    const arma::mat parameters = population3.col(i).t();
+    REQUIRE(fitness[i] == Approx(lrf.Evaluate(parameters)).margin(1e-10));
+  }
+}
+
+/**
+ * Train and test a logistic regression function using the DE optimizer with
+ * quasi-random population initialization.
+ */
+TEST_CASE("DEQuasiRandomInitLogisticRegressionTest", "[DETest]")
+{
+  DE opt(200, 1000, 0.6, 0.8, 1e-5);
+  opt.QuasiRandomInit() = true;
+  LogisticRegressionFunctionTest(opt, 0.01, 0.02, 3);
+}
+
+/**
+ * Check basic properties of the scrambled Halton sequence: all points lie in
+ * [0, 1), equal seeds reproduce the same points, and successive calls
+ * continue the sequence instead of repeating it.
+ */
+TEST_CASE("HaltonSequenceTest", "[DETest]")
+{
+  HaltonSequence seqA(42), seqB(42);
+
+  arma::mat pointsA(10, 50), pointsB(10, 50);
+  seqA.Uniform(pointsA);
+  seqB.Uniform(pointsB);
+
+  REQUIRE(pointsA.min() >= 0.0);
+  REQUIRE(pointsA.max() < 1.0);
+  REQUIRE(arma::approx_equal(pointsA, pointsB, "absdiff", 1e-12));
+
+  // The next call must continue the sequence.
+  arma::mat pointsC(10, 50);
+  seqA.Uniform(pointsC);
+  REQUIRE(!arma::approx_equal(pointsA, pointsC, "absdiff", 1e-12));
+
+  // A different seed gives a different scrambling.
+  HaltonSequence seqD(43);
+  arma::mat pointsD(10, 50);
+  seqD.Uniform(pointsD);
+  REQUIRE(!arma::approx_equal(pointsA, pointsD, "absdiff", 1e-12));
+}
+
+/**
+ * Make sure a warm-started DE run resumes from the retained population: a
+ * second run with a one-generation budget from a bad starting point must
+ * still come back converged, and the retained population must be
+ * exportable and injectable into a fresh optimizer.
+ */
+TEST_CASE("DEWarmStartTest", "[DETest]")
+{
+  SphereFunction f(4);
+  DE opt(64, 1000, 0.6, 0.8, 1e-8);
+  opt.WarmStart() = true;
+
+  arma::mat coords = f.GetInitialPoint<arma::mat>();
+  opt.Optimize(f, coords);
+
+  // The retained population is exposed for export.
+  REQUIRE(opt.Population<arma::mat>().n_rows == 4);
+  REQUIRE(opt.Population<arma::mat>().n_cols == 64);
+
+  // Resume from a bad starting point with a one-generation budget; a fresh
+  // population would be sampled around the bad start, but the warm start
+  // resumes from the converged population.
+  opt.MaxGenerations() = 1;
+  arma::mat badCoords(4, 1);
+  badCoords.fill(100.0);
+  const double objective = opt.Optimize(f, badCoords);
+  REQUIRE(objective <= 1e-3);
+
+  // Inject the exported population into a fresh optimizer.
+  DE fresh(64, 1, 0.6, 0.8, 1e-8);
+  fresh.SeedPopulation(opt.Population<arma::mat>());
+  arma::mat badCoords2(4, 1);
+  badCoords2.fill(100.0);
+  const double freshObjective = fresh.Optimize(f, badCoords2);
+  REQUIRE(freshObjective <= 1e-3);
+}
+
+/**
+ * With stagnation detection enabled, DE must stop once the best fitness
+ * stops improving instead of running out its generation budget, while
+ * still reaching the optimum of the sphere function.
+ */
+TEST_CASE("DEStagnationEarlyTerminationTest", "[DETest]")
+{
+  // Behaves like the sphere function, but counts evaluations.
+  struct CountingSphere
+  {
+    size_t evaluations = 0;
+    double Evaluate(const arma::mat& x)
+    {
+      ++evaluations;
+      return arma::accu(arma::square(x));
+    }
+  };
+
+  const size_t populationSize = 64;
+  const size_t maxGenerations = 1000;
+
+  // The negative tolerance disables the built-in tolerance check, so only
+  // the stagnation detector can end the run early.  Each generation costs
+  // 2 * populationSize evaluations (parents and trials).
+  CountingSphere f;
+  DE opt(populationSize, maxGenerations, 0.6, 0.8, -1.0);
+  opt.Stagnation().Patience() = 25;
+  opt.Stagnation().MinImprovement() = 1e-8;
+
+  arma::mat coords = arma::ones(4, 1);
+  const double result = opt.Optimize(f, coords);
+
+  REQUIRE(result <= 1e-3);
+  REQUIRE(f.evaluations < maxGenerations * populationSize);
+}
+
+/**
+ * With binary genomes enabled, DE runs the bitwise /best/1/bin analog on a
+ * bit-packed population and solves the OneMax problem (the number of unset
+ * bits, minimized by the all-ones genome).
+ */
+TEST_CASE("DEBinaryGenomeOneMaxTest", "[DETest]")
+{
+  struct OneMaxFunction
+  {
+    double Evaluate(const arma::mat& coordinates)
+    {
+      double unset = 0;
+      for (size_t i = 0; i < coordinates.n_elem; ++i)
+        unset += (coordinates(i) < 0.5) ? 1.0 : 0.0;
+      return unset;
+    }
+  } f;
+
+  DE opt(64, 500, 0.6, 0.5, -1);
+  opt.BinaryGenome() = true;
+
+  arma::mat coordinates(64, 1, arma::fill::zeros);
+  const double result = opt.Optimize(f, coordinates);
+
+  REQUIRE(result <= 2.0);
+  for (size_t i = 0; i < coordinates.n_elem; ++i)
+    REQUIRE((coordinates(i) == 0.0 || coordinates(i) == 1.0));
+}
@@ -0,0 +1,72 @@
+/**
+ * @file distributed_sgd_test.cpp
+ * @author Marcus Edel
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+
+#include "test_function_tools.hpp"
+
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * With the sequential communicator there is one rank holding all functions,
+ * so distributed SGD is full-batch gradient descent; it should reach the
+ * optimum of the sphere function.
+ */
+TEST_CASE("DistributedSGDSphereFunctionTest", "[DistributedSGDTest]")
+{
+  SphereFunction f(4);
+  DistributedSGD<> s(500000, 1e-15, SequentialCommunicator(),
+      ConstantStep(0.4));
+
+  arma::mat coordinates = f.GetInitialPoint();
+  const double result = s.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(1e-4));
+  for (size_t j = 0; j < 4; ++j)
+    REQUIRE(coordinates(j) == Approx(0.0).margin(1e-3));
+}
+
+/**
+ * With one rank the overlapped mode still applies every gradient (one step
+ * late), so the result should match the non-overlapped run.
+ */
+TEST_CASE("DistributedSGDOverlapTest", "[DistributedSGDTest]")
+{
+  SphereFunction f(4);
+  DistributedSGD<> s(500000, 1e-15, SequentialCommunicator(),
+      ConstantStep(0.4));
+  s.Overlap() = true;
+
+  arma::mat coordinates = f.GetInitialPoint();
+  const double result = s.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(1e-4));
+  for (size_t j = 0; j < 4; ++j)
+    REQUIRE(coordinates(j) == Approx(0.0).margin(1e-3));
+}
+
+/**
+ * Distributed SGD should also work with float coordinates.
+ */
+TEST_CASE("DistributedSGDSphereFunctionFMatTest", "[DistributedSGDTest]")
+{
+  SphereFunction f(4);
+  DistributedSGD<> s(500000, 1e-10, SequentialCommunicator(),
+      ConstantStep(0.4));
+
+  arma::fmat coordinates = f.GetInitialPoint<arma::fmat>();
+  const float result = s.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0f).margin(1e-2));
+  for (size_t j = 0; j < 4; ++j)
+    REQUIRE(coordinates(j) == Approx(0.0f).margin(1e-1));
+}
@@ -0,0 +1,295 @@
+/**
+ * @file ensmallen_bench.cpp
+ * @author Marcus Edel
+ *
+ * Microbenchmark driver for the ensmallen_bench target.  Times a selection of
+ * optimizers on the functions in include/ensmallen_bits/problems/ across
+ * dimensions and batch sizes, and prints wall-clock time, steps per second,
+ * Evaluate()/Gradient() call counts and peak RSS as machine-readable JSON on
+ * stdout, one object per benchmark, for regression tracking.
+ *
+ * The driver deliberately has no dependency beyond ensmallen itself; build it
+ * with `make ensmallen_bench` and archive its output per commit to catch
+ * performance regressions (e.g. allocation creep in update policies, which
+ * shows up as a drop in steps per second and a rise in peak RSS).
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "test_function_tools.hpp"
+
+#include <chrono>
+#include <iostream>
+
+#if !defined(_WIN32)
+  #include <sys/resource.h>
+#endif
+
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * Return the peak resident set size of this process in bytes, or 0 if the
+ * platform does not expose it.
+ */
+inline size_t PeakRSSBytes()
+{
+#if defined(_WIN32)
+  return 0;
+#else
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  #if defined(__APPLE__)
+    // ru_maxrss is in bytes on macOS.
+    return (size_t) usage.ru_maxrss;
+  #else
+    // ru_maxrss is in kilobytes on Linux and the BSDs.
+    return (size_t) usage.ru_maxrss * 1024;
+  #endif
+#endif
+}
+
+/**
+ * Callback that counts Evaluate() and Gradient() reports and the number of
+ * steps taken, so every benchmark can report work done, not just wall-clock
+ * time.  Optimizers that report combined EvaluateWithGradient() calls are
+ * counted as one Evaluate() and one Gradient() by the callback dispatch.
+ */
+class BenchCounter
+{
+ public:
+  BenchCounter() : evaluateCalls(0), gradientCalls(0), steps(0) { }
+
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  bool Evaluate(OptimizerType& /* optimizer */,
+                FunctionType& /* function */,
+                const MatType& /* coordinates */,
+                const double /* objective */)
+  {
+    evaluateCalls++;
+    return false;
+  }
+
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  bool Gradient(OptimizerType& /* optimizer */,
+                FunctionType& /* function */,
+                const MatType& /* coordinates */,
+                const MatType& /* gradient */)
+  {
+    gradientCalls++;
+    return false;
+  }
+
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  bool StepTaken(OptimizerType& /* optimizer */,
+                 FunctionType& /* function */,
+                 const MatType& /* coordinates */)
+  {
+    steps++;
+    return false;
+  }
+
+  //! The number of Evaluate() calls reported by the optimizer.
+  size_t evaluateCalls;
+  //! The number of Gradient() calls reported by the optimizer.
+  size_t gradientCalls;
+  //! The number of steps taken by the optimizer.
+  size_t steps;
+};
+
+//! Whether a benchmark object has been printed yet (for comma placement).
+static bool benchFirst = true;
+
+/**
+ * Print one benchmark result as a JSON object.
+ */
+inline void PrintResult(const std::string& name,
+                        const double seconds,
+                        const BenchCounter& counter,
+                        const double finalObjective)
+{
+  if (!benchFirst)
+    std::cout << "," << std::endl;
+  benchFirst = false;
+
+  const double stepsPerSecond = (seconds > 0.0) ?
+      (double) counter.steps / seconds : 0.0;
+
+  std::cout << "    {\"name\": \"" << name << "\""
+      << ", \"real_time_s\": " << seconds
+      << ", \"steps\": " << counter.steps
+      << ", \"steps_per_s\": " << stepsPerSecond
+      << ", \"evaluate_calls\": " << counter.evaluateCalls
+      << ", \"gradient_calls\": " << counter.gradientCalls
+      << ", \"final_objective\": " << finalObjective
+      << ", \"peak_rss_bytes\": " << PeakRSSBytes() << "}";
+}
+
+/**
+ * Time one optimizer on one function from the given starting point and print
+ * the result.  The coordinates are taken by value so that every benchmark
+ * starts from the same point.
+ */
+template<typename OptimizerType, typename FunctionType, typename MatType>
+void RunBenchmark(const std::string& name,
+                  OptimizerType optimizer,
+                  FunctionType function,
+                  MatType coordinates)
+{
+  BenchCounter counter;
+  const auto start = std::chrono::steady_clock::now();
+  const double objective = (double) optimizer.Optimize(function, coordinates,
+      counter);
+  const double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  PrintResult(name, seconds, counter, objective);
+}
+
+/**
+ * Full-gradient optimizers on the generalized Rosenbrock function across
+ * dimensions.
+ */
+void BenchGeneralizedRosenbrock()
+{
+  const size_t dimensions[] = { 10, 50, 100 };
+  for (size_t i = 0; i < 3; ++i)
+  {
+    const size_t dim = dimensions[i];
+    GeneralizedRosenbrockFunction f(dim);
+    const std::string suffix = "/generalized_rosenbrock/d=" +
+        std::to_string(dim);
+
+    RunBenchmark("lbfgs" + suffix, L_BFGS(10, 1000), f, f.GetInitialPoint());
+    RunBenchmark("gradient_descent" + suffix,
+        GradientDescent(0.0005, 500000, 1e-10), f, f.GetInitialPoint());
+  }
+
+  // Separable optimizers across batch sizes; the generalized Rosenbrock
+  // function decomposes into dim - 1 terms.
+  const size_t batchSizes[] = { 8, 32 };
+  for (size_t i = 0; i < 2; ++i)
+  {
+    const size_t batchSize = batchSizes[i];
+    GeneralizedRosenbrockFunction f(50);
+    const std::string suffix = "/generalized_rosenbrock/d=50/b=" +
+        std::to_string(batchSize);
+
+    RunBenchmark("sgd" + suffix,
+        StandardSGD(0.0005, batchSize, 500000, 1e-10), f,
+        f.GetInitialPoint());
+    RunBenchmark("adam" + suffix,
+        Adam(0.001, batchSize, 0.9, 0.999, 1e-8, 500000, 1e-10), f,
+        f.GetInitialPoint());
+  }
+}
+
+/**
+ * Separable optimizers on a two-Gaussian logistic regression problem across
+ * batch sizes, plus a full-gradient baseline.
+ */
+void BenchLogisticRegression()
+{
+  arma::mat data, testData, shuffledData;
+  arma::Row<size_t> responses, testResponses, shuffledResponses;
+  LogisticRegressionTestData(data, testData, shuffledData, responses,
+      testResponses, shuffledResponses);
+  LogisticRegressionFunction<arma::mat> lr(shuffledData, shuffledResponses,
+      0.5);
+
+  const size_t batchSizes[] = { 32, 128 };
+  for (size_t i = 0; i < 2; ++i)
+  {
+    const size_t batchSize = batchSizes[i];
+    const std::string suffix = "/logistic_regression/b=" +
+        std::to_string(batchSize);
+
+    RunBenchmark("sgd" + suffix,
+        StandardSGD(0.01, batchSize, 50000, 1e-9), lr, lr.GetInitialPoint());
+    RunBenchmark("adam" + suffix,
+        Adam(0.01, batchSize, 0.9, 0.999, 1e-8, 50000, 1e-9), lr,
+        lr.GetInitialPoint());
+    RunBenchmark("svrg" + suffix,
+        SVRG(0.005, batchSize, 100, 0, 1e-9), lr, lr.GetInitialPoint());
+    RunBenchmark("sarah" + suffix,
+        SARAH(0.01, batchSize, 100, 0, 1e-9), lr, lr.GetInitialPoint());
+  }
+
+  RunBenchmark("lbfgs/logistic_regression", L_BFGS(10, 1000), lr,
+      lr.GetInitialPoint());
+}
+
+/**
+ * Coordinate descent and a full-gradient baseline on a random softmax
+ * regression problem.
+ */
+void BenchSoftmaxRegression()
+{
+  const size_t points = 1000;
+  const size_t inputSize = 10;
+  const size_t numClasses = 5;
+
+  arma::mat data;
+  data.randu(inputSize, points);
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(
+      points, arma::distr_param(0, numClasses - 1));
+
+  SoftmaxRegressionFunction<> srf(data, labels, numClasses, 0.001);
+
+  RunBenchmark("cd/softmax_regression", CD<>(0.01, 10000, 1e-7), srf,
+      srf.GetInitialPoint());
+  RunBenchmark("lbfgs/softmax_regression", L_BFGS(10, 1000), srf,
+      srf.GetInitialPoint());
+}
+
+/**
+ * Multi-objective optimizers on ZDT-1; the other ZDT functions exercise the
+ * same code paths, so only the first is benchmarked.
+ */
+void BenchZDT()
+{
+  ZDT1<> zdtOne(100);
+
+  typedef decltype(zdtOne.objectiveF1) ObjectiveTypeA;
+  typedef decltype(zdtOne.objectiveF2) ObjectiveTypeB;
+  std::tuple<ObjectiveTypeA, ObjectiveTypeB> objectives =
+      zdtOne.GetObjectives();
+
+  NSGA2 opt(100, 250, 0.8, 1e-2, 1e-4, 1e-6, 0, 1);
+
+  BenchCounter counter;
+  arma::mat coords = zdtOne.GetInitialPoint();
+  const auto start = std::chrono::steady_clock::now();
+  opt.Optimize(objectives, coords, counter);
+  const double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  // Report the g objective of the returned point; its optimum is 1.
+  const size_t numVariables = coords.size();
+  const double sum = arma::accu(coords(arma::span(1, numVariables - 1), 0));
+  const double g = 1.0 + 9.0 * sum / (double) (numVariables - 1);
+
+  PrintResult("nsga2/zdt1/d=30", seconds, counter, g);
+}
+
+int main()
+{
+  // Fixed seed so that runs on the same machine are comparable.
+  arma::arma_rng::set_seed(12345);
+
+  std::cout << "{" << std::endl;
+  std::cout << "  \"benchmarks\": [" << std::endl;
+
+  BenchGeneralizedRosenbrock();
+  BenchLogisticRegression();
+  BenchSoftmaxRegression();
+  BenchZDT();
+
+  std::cout << std::endl << "  ]" << std::endl << "}" << std::endl;
+
+  return 0;
+}
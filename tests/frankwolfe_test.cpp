@@ -49,6 +49,35 @@ TEST_CASE("FWOMPTest", "[FrankWolfeTest]")
   }
 }
 
+/**
+ * A larger sparse-recovery instance: the vector b is an exact combination of
+ * three dictionary atoms, so OMP must drive the residual to zero while only
+ * a handful of the 500 atoms ever become active.
+ */
+TEST_CASE("FWOMPSparseRecoveryTest", "[FrankWolfeTest]")
+{
+  mat B1 = eye(20, 20);
+  mat B2 = 0.01 * randn(20, 480);
+  mat A = join_horiz(B1, B2);
+
+  vec b = zeros<vec>(20);
+  b(3) = 1.0;
+  b(7) = -2.0;
+  b(11) = 0.5;
+
+  FuncSq f(A, b);
+  ConstrLpBallSolver linearConstrSolver(1);
+  UpdateSpan updateRule;
+
+  OMP s(linearConstrSolver, updateRule);
+
+  mat coordinates = zeros<mat>(500, 1);
+  double result = s.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(1e-10));
+  REQUIRE(norm(A * coordinates - b, 2) == Approx(0.0).margin(1e-5));
+}
+
 /**
  * Simple test of Orthogonal Matching Pursuit with regularization.
  */
@@ -223,3 +252,133 @@ TEST_CASE("FWLineSearchFMat", "[FrankWolfeTest]")
   REQUIRE(coordinates(1) - 0.2 == Approx(0.0).margin(1e-4));
   REQUIRE(coordinates(2) - 0.3 == Approx(0.0).margin(1e-4));
 }
+
+/**
+ * Test that the atom dictionary detects duplicate atoms: adding an atom the
+ * dictionary has already seen folds the coefficient into the existing atom
+ * instead of growing the dictionary.
+ */
+TEST_CASE("AtomsDuplicateDetectionTest", "[FrankWolfeTest]")
+{
+  mat A = eye(3, 3);
+  vec b = {1.0, 1.0, 0.0};
+  FuncSq f(A, b);
+
+  mat v1 = zeros<mat>(3, 1);
+  v1(0) = 1.0;
+  mat v2 = zeros<mat>(3, 1);
+  v2(1) = -1.0;
+
+  Atoms atoms;
+  atoms.AddAtom(v1, f, 0.5);
+  atoms.AddAtom(v2, f, 1.0);
+  REQUIRE(atoms.NumAtoms() == 2);
+
+  // Adding the same atoms again must not grow the dictionary.
+  atoms.AddAtom(v1, f, 0.25);
+  atoms.AddAtom(v2, f, 0.5);
+  REQUIRE(atoms.NumAtoms() == 2);
+
+  // The recovered solution reflects the folded coefficients.
+  mat x;
+  atoms.RecoverVector(x);
+  REQUIRE(x(0) == Approx(0.75).margin(1e-10));
+  REQUIRE(x(1) == Approx(-1.5).margin(1e-10));
+  REQUIRE(x(2) == Approx(0.0).margin(1e-10));
+}
+
+/**
+ * Test the away-steps Frank-Wolfe variant on an l1 ball constrained least
+ * squares problem.
+ */
+TEST_CASE("FWAwayStepsTest", "[FrankWolfeTest]")
+{
+  mat A = eye(3, 3);
+  vec b = {0.2, 0.1, 0.0};
+
+  FuncSq f(A, b);
+  ConstrLpBallSolver linearConstrSolver(1);
+  UpdateAwaySteps updateRule;
+
+  FrankWolfe<ConstrLpBallSolver, UpdateAwaySteps>
+      s(linearConstrSolver, updateRule, 1000, 1e-10);
+
+  mat coordinates = zeros<mat>(3, 1);
+  double result = s.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(1e-8));
+  REQUIRE(coordinates(0) == Approx(0.2).margin(1e-4));
+  REQUIRE(coordinates(1) == Approx(0.1).margin(1e-4));
+  REQUIRE(coordinates(2) == Approx(0.0).margin(1e-4));
+}
+
+/**
+ * Test the pairwise Frank-Wolfe variant on an l1 ball constrained least
+ * squares problem.
+ */
+TEST_CASE("FWPairwiseTest", "[FrankWolfeTest]")
+{
+  mat A = eye(3, 3);
+  vec b = {0.2, 0.1, 0.0};
+
+  FuncSq f(A, b);
+  ConstrLpBallSolver linearConstrSolver(1);
+  UpdatePairwise updateRule;
+
+  FrankWolfe<ConstrLpBallSolver, UpdatePairwise>
+      s(linearConstrSolver, updateRule, 1000, 1e-10);
+
+  mat coordinates = zeros<mat>(3, 1);
+  double result = s.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(1e-8));
+  REQUIRE(coordinates(0) == Approx(0.2).margin(1e-4));
+  REQUIRE(coordinates(1) == Approx(0.1).margin(1e-4));
+  REQUIRE(coordinates(2) == Approx(0.0).margin(1e-4));
+}
+
+/**
+ * Test the stochastic Frank-Wolfe variant on a separable function.  The
+ * sphere function's minimum (the origin) lies inside the unit l2 ball, so
+ * the iterates must converge to it; the batch starts at a single sample and
+ * grows geometrically until the method proceeds as exact Frank-Wolfe.
+ */
+TEST_CASE("StochasticFWSphereFunctionTest", "[FrankWolfeTest]")
+{
+  SphereFunction f(3);
+  double p = 2;   // Constraint set is unit lp ball.
+  ConstrLpBallSolver linearConstrSolver(p);
+  UpdateClassic updateRule;
+
+  StochasticFrankWolfe<ConstrLpBallSolver, UpdateClassic>
+      s(linearConstrSolver, updateRule, 1, 20000, 1e-10, 1.5);
+
+  mat coordinates = randu<mat>(3, 1);
+  double result = s.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(1e-4));
+  REQUIRE(coordinates(0) == Approx(0.0).margin(1e-2));
+  REQUIRE(coordinates(1) == Approx(0.0).margin(1e-2));
+  REQUIRE(coordinates(2) == Approx(0.0).margin(1e-2));
+}
+
+/**
+ * The same problem with a fixed single-sample batch (growth factor 1); the
+ * gradient estimate then stays stochastic for the whole run, so only a
+ * rough neighborhood of the minimum can be required.
+ */
+TEST_CASE("StochasticFWFixedBatchTest", "[FrankWolfeTest]")
+{
+  SphereFunction f(3);
+  double p = 2;   // Constraint set is unit lp ball.
+  ConstrLpBallSolver linearConstrSolver(p);
+  UpdateClassic updateRule;
+
+  StochasticFrankWolfe<ConstrLpBallSolver, UpdateClassic>
+      s(linearConstrSolver, updateRule, 1, 20000, 1e-10, 1.0);
+
+  mat coordinates = randu<mat>(3, 1);
+  double result = s.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(0.1));
+}
@@ -13,6 +13,7 @@
 
 #include <ensmallen.hpp>
 #include "catch.hpp"
+#include "test_function_tools.hpp"
 
 using namespace ens;
 using namespace ens::test;
@@ -721,3 +722,558 @@ TEST_CASE("ResolvableFunctionTypeCheckTest", "[FunctionTest]")
   static_assert(!CheckPartialGradient<D, arma::mat, arma::sp_mat>::value,
       "CheckPartialGradient static check failed.");
 }
+
+/**
+ * Make sure that MultithreadedEvaluate reproduces the full-batch objective
+ * and gradient of the wrapped separable function.
+ */
+TEST_CASE("MultithreadedEvaluateCorrectnessTest", "[FunctionTest]")
+{
+  arma::mat data(10, 1000, arma::fill::randu);
+  arma::Row<size_t> responses(1000);
+  for (size_t i = 0; i < 1000; ++i)
+    responses[i] = (i % 2);
+
+  LogisticRegression<> lr(data, responses, 0.5);
+  MultithreadedEvaluate<LogisticRegression<>> f(lr);
+
+  arma::mat coordinates(11, 1, arma::fill::randn);
+
+  const double directObjective = lr.Evaluate(coordinates);
+  arma::mat directGradient;
+  lr.Gradient(coordinates, directGradient);
+
+  REQUIRE(f.Evaluate(coordinates) == Approx(directObjective).epsilon(1e-7));
+
+  arma::mat gradient;
+  f.Gradient(coordinates, gradient);
+  REQUIRE(arma::norm(gradient - directGradient) ==
+      Approx(0.0).margin(1e-7));
+
+  arma::mat gradient2;
+  const double objective = f.EvaluateWithGradient(coordinates, gradient2);
+  REQUIRE(objective == Approx(directObjective).epsilon(1e-7));
+  REQUIRE(arma::norm(gradient2 - directGradient) ==
+      Approx(0.0).margin(1e-7));
+}
+
+/**
+ * Feed a wrapped separable function into L_BFGS, which takes the regular
+ * FunctionType API.
+ */
+TEST_CASE("MultithreadedEvaluateLBFGSTest", "[FunctionTest]")
+{
+  arma::mat data, testData, shuffledData;
+  arma::Row<size_t> responses, testResponses, shuffledResponses;
+  LogisticRegressionTestData(data, testData, shuffledData,
+      responses, testResponses, shuffledResponses);
+  LogisticRegression<> lr(shuffledData, shuffledResponses, 0.5);
+  MultithreadedEvaluate<LogisticRegression<>> f(lr);
+
+  L_BFGS lbfgs;
+  arma::mat coordinates = lr.GetInitialPoint();
+  lbfgs.Optimize(f, coordinates);
+
+  const double acc = lr.ComputeAccuracy(data, responses, coordinates);
+  REQUIRE(acc == Approx(100.0).epsilon(0.003));
+}
+
+/**
+ * A black-box function providing only Evaluate(); a simple shifted sphere.
+ */
+class EvaluateOnlySphereFunction
+{
+ public:
+  template<typename MatType>
+  typename MatType::elem_type Evaluate(const MatType& coordinates)
+  {
+    return arma::accu(arma::square(coordinates - 2.0));
+  }
+};
+
+/**
+ * Make sure that the central-difference gradient of FiniteDifferenceFunction
+ * matches the analytic gradient of the wrapped function.
+ */
+TEST_CASE("FiniteDifferenceGradientAccuracyTest", "[FunctionTest]")
+{
+  arma::mat data(10, 1000, arma::fill::randu);
+  arma::Row<size_t> responses(1000);
+  for (size_t i = 0; i < 1000; ++i)
+    responses[i] = (i % 2);
+
+  LogisticRegression<> lr(data, responses, 0.5);
+  FiniteDifferenceFunction<LogisticRegression<>> f(lr);
+
+  arma::mat coordinates(11, 1, arma::fill::randn);
+
+  arma::mat directGradient;
+  lr.Gradient(coordinates, directGradient);
+
+  arma::mat approxGradient;
+  f.Gradient(coordinates, approxGradient);
+  REQUIRE(arma::norm(approxGradient - directGradient) ==
+      Approx(0.0).margin(1e-6));
+
+  arma::mat approxGradient2;
+  const double objective = f.EvaluateWithGradient(coordinates,
+      approxGradient2);
+  REQUIRE(objective == Approx(lr.Evaluate(coordinates)).epsilon(1e-7));
+  REQUIRE(arma::norm(approxGradient2 - directGradient) ==
+      Approx(0.0).margin(1e-6));
+}
+
+/**
+ * Feed a wrapped Evaluate()-only black box into L_BFGS, which requires the
+ * differentiable FunctionType API.
+ */
+TEST_CASE("FiniteDifferenceLBFGSTest", "[FunctionTest]")
+{
+  EvaluateOnlySphereFunction sphere;
+  FiniteDifferenceFunction<EvaluateOnlySphereFunction> f(sphere);
+
+  L_BFGS lbfgs;
+  arma::mat coordinates(5, 1, arma::fill::zeros);
+  lbfgs.Optimize(f, coordinates);
+
+  for (size_t j = 0; j < 5; ++j)
+    REQUIRE(coordinates(j) == Approx(2.0).margin(1e-3));
+}
+
+/**
+ * Utility class with Evaluate(), Gradient(), and the optional CachedEvaluate()
+ * hook; it counts which of the two objective methods are called.
+ */
+class CachedEvaluateTestFunction
+{
+ public:
+  CachedEvaluateTestFunction() : evaluateCalls(0), cachedEvaluateCalls(0) { }
+
+  double Evaluate(const arma::mat& coordinates)
+  {
+    ++evaluateCalls;
+    return arma::accu(coordinates);
+  }
+
+  double CachedEvaluate(const arma::mat& coordinates)
+  {
+    ++cachedEvaluateCalls;
+    return arma::accu(coordinates);
+  }
+
+  void Gradient(const arma::mat& /* coordinates */, arma::mat& gradient)
+  {
+    gradient.ones(2, 1);
+  }
+
+  size_t evaluateCalls;
+  size_t cachedEvaluateCalls;
+};
+
+/**
+ * Make sure the EvaluateWithGradient() synthesized from Evaluate() and
+ * Gradient() uses the CachedEvaluate() hook when the function provides one,
+ * and does not fall back to Evaluate().
+ */
+TEST_CASE("AddEvaluateWithGradientCachedEvaluateTest", "[FunctionTest]")
+{
+  Function<CachedEvaluateTestFunction, arma::mat, arma::mat> f;
+
+  arma::mat coordinates(2, 1, arma::fill::ones);
+  arma::mat gradient;
+  const double objective = f.EvaluateWithGradient(coordinates, gradient);
+
+  REQUIRE(objective == Approx(2.0));
+  REQUIRE(f.cachedEvaluateCalls == 1);
+  REQUIRE(f.evaluateCalls == 0);
+
+  // The hook must not replace the plain Evaluate().
+  REQUIRE(f.Evaluate(coordinates) == Approx(2.0));
+  REQUIRE(f.evaluateCalls == 1);
+}
+
+/**
+ * Utility class that implements EvaluateBatch() directly, counting how the
+ * objective methods are called.
+ */
+class EvaluateBatchTestFunction
+{
+ public:
+  EvaluateBatchTestFunction() : evaluateCalls(0), evaluateBatchCalls(0) { }
+
+  double Evaluate(const arma::mat& /* coordinates */,
+                  const size_t /* begin */,
+                  const size_t batchSize)
+  {
+    ++evaluateCalls;
+    return (double) batchSize;
+  }
+
+  double EvaluateBatch(const arma::mat& /* coordinates */,
+                       const std::vector<std::pair<size_t, size_t>>& schedule)
+  {
+    ++evaluateBatchCalls;
+    double objective = 0;
+    for (size_t i = 0; i < schedule.size(); ++i)
+      objective += (double) schedule[i].second;
+    return objective;
+  }
+
+  size_t evaluateCalls;
+  size_t evaluateBatchCalls;
+};
+
+/**
+ * Make sure EvaluateBatch() is synthesized from a separable Evaluate() when
+ * the function does not provide one.
+ */
+TEST_CASE("AddEvaluateBatchSynthesizedTest", "[FunctionTest]")
+{
+  Function<EvaluateGradientTestFunction, arma::mat, arma::mat> f;
+
+  arma::mat coordinates(3, 1, arma::fill::ones);
+  std::vector<std::pair<size_t, size_t>> schedule;
+  schedule.push_back(std::make_pair(0, 5));
+  schedule.push_back(std::make_pair(5, 3));
+
+  // The separable Evaluate() of the test function returns the sum of the
+  // coordinates for any range, so two ranges give twice that sum.
+  REQUIRE(f.EvaluateBatch(coordinates, schedule) == Approx(6.0));
+}
+
+/**
+ * Make sure a function-provided EvaluateBatch() is preferred over the
+ * synthesized per-range loop.
+ */
+TEST_CASE("AddEvaluateBatchReflectionTest", "[FunctionTest]")
+{
+  Function<EvaluateBatchTestFunction, arma::mat, arma::mat> f;
+
+  arma::mat coordinates(3, 1, arma::fill::ones);
+  std::vector<std::pair<size_t, size_t>> schedule;
+  schedule.push_back(std::make_pair(0, 5));
+  schedule.push_back(std::make_pair(5, 3));
+
+  REQUIRE(f.EvaluateBatch(coordinates, schedule) == Approx(8.0));
+  REQUIRE(f.evaluateBatchCalls == 1);
+  REQUIRE(f.evaluateCalls == 0);
+}
+
+/**
+ * Utility separable function that records the prefetch hints it receives.
+ */
+class PrefetchTestFunction
+{
+ public:
+  PrefetchTestFunction() { }
+
+  size_t NumFunctions() const { return 10; }
+
+  void Shuffle() { }
+
+  double Evaluate(const arma::mat& coordinates,
+                  const size_t /* begin */,
+                  const size_t batchSize)
+  {
+    return batchSize * arma::accu(arma::square(coordinates));
+  }
+
+  void Gradient(const arma::mat& coordinates,
+                const size_t /* begin */,
+                arma::mat& gradient,
+                const size_t batchSize)
+  {
+    gradient = 2 * batchSize * coordinates;
+  }
+
+  void PrefetchBatch(const size_t begin, const size_t /* batchSize */)
+  {
+    prefetchedBegins.push_back(begin);
+  }
+
+  std::vector<size_t> prefetchedBegins;
+};
+
+/**
+ * Make sure SGD announces the next batch through PrefetchBatch() before
+ * computing the current one.  Without shuffling the batches are visited
+ * sequentially, so every hint must name one of the non-initial batch starts.
+ */
+TEST_CASE("SGDPrefetchBatchTest", "[FunctionTest]")
+{
+  PrefetchTestFunction f;
+  StandardSGD s(0.0003, 3, 100, 1e-15, false);
+
+  arma::mat coordinates(3, 1, arma::fill::ones);
+  s.Optimize(f, coordinates);
+
+  // Batches start at 0, 3, 6 and 9; the first batch of an epoch is never
+  // announced (the preceding epoch ends with a possible reshuffle).
+  REQUIRE(f.prefetchedBegins.size() > 0);
+  for (size_t i = 0; i < f.prefetchedBegins.size(); ++i)
+  {
+    REQUIRE(f.prefetchedBegins[i] > 0);
+    REQUIRE(f.prefetchedBegins[i] % 3 == 0);
+  }
+}
+
+/**
+ * Make sure PrefetchBatch() is synthesized as a no-op for functions that do
+ * not provide one.
+ */
+TEST_CASE("AddPrefetchBatchNoOpTest", "[FunctionTest]")
+{
+  Function<EvaluateGradientTestFunction, arma::mat, arma::mat> f;
+
+  // This only needs to compile and do nothing.
+  f.PrefetchBatch(0, 5);
+  REQUIRE(true);
+}
+
+/**
+ * Utility differentiable function counting how often the objective and
+ * gradient methods are actually called.
+ */
+class CountingSphereFunction
+{
+ public:
+  CountingSphereFunction() : evaluateCalls(0), gradientCalls(0) { }
+
+  double Evaluate(const arma::mat& coordinates)
+  {
+    ++evaluateCalls;
+    return arma::dot(coordinates, coordinates);
+  }
+
+  void Gradient(const arma::mat& coordinates, arma::mat& gradient)
+  {
+    ++gradientCalls;
+    gradient = 2 * coordinates;
+  }
+
+  size_t evaluateCalls;
+  size_t gradientCalls;
+};
+
+/**
+ * Make sure MemoizedFunction serves repeated same-point calls from cache and
+ * recomputes when the coordinates change.
+ */
+TEST_CASE("MemoizedFunctionDeduplicationTest", "[FunctionTest]")
+{
+  CountingSphereFunction sphere;
+  MemoizedFunction<CountingSphereFunction> f(sphere);
+
+  arma::mat a(5, 1, arma::fill::randn);
+  arma::mat b(5, 1, arma::fill::randn);
+
+  // The second same-point Evaluate() must not reach the function.
+  const double objective = f.Evaluate(a);
+  REQUIRE(f.Evaluate(a) == objective);
+  REQUIRE(sphere.evaluateCalls == 1);
+  REQUIRE(f.Hits() == 1);
+
+  // The gradient at the same point is not cached yet and must be computed;
+  // asking again serves it from cache.
+  arma::mat gradient;
+  f.Gradient(a, gradient);
+  f.Gradient(a, gradient);
+  REQUIRE(sphere.gradientCalls == 1);
+  REQUIRE(arma::norm(gradient - 2 * a) == Approx(0.0).margin(1e-12));
+
+  // A changed point invalidates the cache; only the latest point is kept,
+  // so returning to the first point recomputes.
+  REQUIRE(f.Evaluate(b) == Approx(arma::dot(b, b)));
+  REQUIRE(sphere.evaluateCalls == 2);
+  REQUIRE(f.Evaluate(a) == Approx(objective));
+  REQUIRE(sphere.evaluateCalls == 3);
+}
+
+/**
+ * L_BFGS evaluates an accepted line-search step and then asks for the
+ * gradient at the same coordinates; through MemoizedFunction this pattern
+ * must produce cache hits while reaching the same optimum.
+ */
+TEST_CASE("MemoizedFunctionLBFGSTest", "[FunctionTest]")
+{
+  CountingSphereFunction sphere;
+  MemoizedFunction<CountingSphereFunction> f(sphere);
+
+  L_BFGS lbfgs;
+  arma::mat coordinates(5, 1, arma::fill::ones);
+  lbfgs.Optimize(f, coordinates);
+
+  for (size_t j = 0; j < 5; ++j)
+    REQUIRE(coordinates(j) == Approx(0.0).margin(1e-5));
+  REQUIRE(f.Hits() > 0);
+}
+
+/**
+ * Make sure CountingFunction counts forwarded calls and can be reset.
+ */
+TEST_CASE("CountingFunctionCountersTest", "[FunctionTest]")
+{
+  CountingSphereFunction sphere;
+  CountingFunction<CountingSphereFunction> f(sphere);
+
+  arma::mat a(5, 1, arma::fill::randn);
+  arma::mat gradient;
+
+  f.Evaluate(a);
+  f.Evaluate(a);
+  f.Gradient(a, gradient);
+
+  REQUIRE(f.Evaluations() == 2);
+  REQUIRE(f.Gradients() == 1);
+  REQUIRE(f.EvaluateWithGradients() == 0);
+  REQUIRE(sphere.evaluateCalls == 2);
+  REQUIRE(sphere.gradientCalls == 1);
+
+  f.ResetCounters();
+  REQUIRE(f.Evaluations() == 0);
+  REQUIRE(f.Gradients() == 0);
+}
+
+/**
+ * Run L-BFGS through CountingFunction: the optimization must converge as
+ * usual and the counters must reflect the calls that were made.
+ */
+TEST_CASE("CountingFunctionLBFGSTest", "[FunctionTest]")
+{
+  CountingSphereFunction sphere;
+  CountingFunction<CountingSphereFunction> f(sphere);
+
+  L_BFGS lbfgs;
+  arma::mat coordinates(5, 1, arma::fill::ones);
+  lbfgs.Optimize(f, coordinates);
+
+  for (size_t j = 0; j < 5; ++j)
+    REQUIRE(coordinates(j) == Approx(0.0).margin(1e-5));
+  REQUIRE(f.Evaluations() + f.EvaluateWithGradients() > 0);
+  REQUIRE(f.Evaluations() >= sphere.evaluateCalls - sphere.gradientCalls);
+}
+
+/**
+ * Run SGD through CountingFunction on a separable function and make sure
+ * the batch overloads accumulate the sample count.
+ */
+TEST_CASE("CountingFunctionSGDSamplesTest", "[FunctionTest]")
+{
+  SGDTestFunction testFunction;
+  CountingFunction<SGDTestFunction> f(testFunction);
+
+  StandardSGD s(0.0003, 1, 1000, 1e-9, true);
+  arma::mat coordinates = testFunction.GetInitialPoint();
+  s.Optimize(f, coordinates);
+
+  // Every step touches batchSize = 1 samples.
+  REQUIRE(f.Samples() > 0);
+  REQUIRE(f.Evaluations() + f.Gradients() + f.EvaluateWithGradients() > 0);
+}
+
+/**
+ * Make sure dual-number arithmetic propagates derivatives by the chain rule.
+ */
+TEST_CASE("DualNumberChainRuleTest", "[FunctionTest]")
+{
+  // Seed the derivative part to differentiate with respect to x.
+  const Dual<double> x(0.5, 1.0);
+
+  // f(x) = exp(sin(x)); f'(x) = cos(x) * exp(sin(x)).
+  Dual<double> y = exp(sin(x));
+  REQUIRE(y.Value() == Approx(std::exp(std::sin(0.5))));
+  REQUIRE(y.Derivative() ==
+      Approx(std::cos(0.5) * std::exp(std::sin(0.5))));
+
+  // f(x) = x^3 / (1 + x * x); quotient and power rules.
+  y = pow(x, 3.0) / (1.0 + x * x);
+  const double denom = 1.0 + 0.25;
+  REQUIRE(y.Value() == Approx(0.125 / denom));
+  REQUIRE(y.Derivative() ==
+      Approx((3 * 0.25 * denom - 0.125 * 2 * 0.5) / (denom * denom)));
+
+  // f(x) = sqrt(log(2 + x)); composed chain rule.
+  y = sqrt(log(2.0 + x));
+  REQUIRE(y.Value() == Approx(std::sqrt(std::log(2.5))));
+  REQUIRE(y.Derivative() ==
+      Approx(1.0 / (2.5 * 2 * std::sqrt(std::log(2.5)))));
+}
+
+/**
+ * A scalar-generic objective for DualFunction; f = sum_i exp(x_i) * sin(x_i)
+ * with the hand-derived gradient g_i = exp(x_i) * (sin(x_i) + cos(x_i)).
+ */
+class GenericExpSinFunction
+{
+ public:
+  template<typename T>
+  T Evaluate(const std::vector<T>& x)
+  {
+    T sum(0);
+    for (size_t i = 0; i < x.size(); ++i)
+      sum += exp(x[i]) * sin(x[i]);
+    return sum;
+  }
+};
+
+/**
+ * Make sure the forward-mode gradient of DualFunction matches the analytic
+ * gradient to machine precision.
+ */
+TEST_CASE("DualGradientAccuracyTest", "[FunctionTest]")
+{
+  GenericExpSinFunction g;
+  DualFunction<GenericExpSinFunction> f(g);
+
+  arma::mat coordinates(7, 1, arma::fill::randn);
+
+  arma::mat directGradient(7, 1);
+  double directObjective = 0.0;
+  for (size_t i = 0; i < 7; ++i)
+  {
+    directGradient(i) = std::exp(coordinates(i)) *
+        (std::sin(coordinates(i)) + std::cos(coordinates(i)));
+    directObjective += std::exp(coordinates(i)) * std::sin(coordinates(i));
+  }
+
+  arma::mat dualGradient;
+  const double objective = f.EvaluateWithGradient(coordinates, dualGradient);
+  REQUIRE(objective == Approx(directObjective));
+  REQUIRE(arma::norm(dualGradient - directGradient) ==
+      Approx(0.0).margin(1e-12));
+
+  REQUIRE(f.Evaluate(coordinates) == Approx(directObjective));
+}
+
+/**
+ * A scalar-generic Evaluate()-only objective; a simple shifted sphere.
+ */
+class GenericSphereFunction
+{
+ public:
+  template<typename T>
+  T Evaluate(const std::vector<T>& x)
+  {
+    T sum(0);
+    for (size_t i = 0; i < x.size(); ++i)
+      sum += (x[i] - 2.0) * (x[i] - 2.0);
+    return sum;
+  }
+};
+
+/**
+ * Feed a wrapped scalar-generic objective into L_BFGS, which requires the
+ * differentiable FunctionType API.
+ */
+TEST_CASE("DualFunctionLBFGSTest", "[FunctionTest]")
+{
+  GenericSphereFunction sphere;
+  DualFunction<GenericSphereFunction> f(sphere);
+
+  L_BFGS lbfgs;
+  arma::mat coordinates(5, 1, arma::fill::zeros);
+  lbfgs.Optimize(f, coordinates);
+
+  for (size_t j = 0; j < 5; ++j)
+    REQUIRE(coordinates(j) == Approx(2.0).margin(1e-6));
+}
@@ -34,3 +34,37 @@ TEST_CASE("GDRosenbrockFMatTest", "[GradientDescentTest]")
   GradientDescent s(0.001, 0, 1e-15);
   FunctionTest<RosenbrockFunction, arma::fmat>(s, 0.1, 0.01);
 }
+
+/**
+ * The Barzilai-Borwein step size policy adapts to the curvature of a simple
+ * quadratic, so it should converge in far fewer iterations than a fixed
+ * conservative step; the iteration budget here is deliberately small.
+ */
+TEST_CASE("BBGradientDescentSimpleTest", "[GradientDescentTest]")
+{
+  BBGradientDescent s(0.01, 1000, 1e-9);
+  FunctionTest<GDTestFunction>(s, 0.1, 0.01);
+}
+
+/**
+ * On the nonconvex Rosenbrock function the raw Barzilai-Borwein step can
+ * oscillate, but it makes a good first trial for the strong-Wolfe line
+ * search.
+ */
+TEST_CASE("BBGradientDescentLineSearchRosenbrockTest", "[GradientDescentTest]")
+{
+  BBGradientDescent s(0.001, 0, 1e-15);
+  s.UseLineSearch() = true;
+  FunctionTest<RosenbrockFunction>(s, 0.01, 0.001);
+}
+
+/**
+ * With the strong-Wolfe line search enabled, gradient descent should solve
+ * the Rosenbrock function even when the fixed step size is a poor choice.
+ */
+TEST_CASE("GDLineSearchRosenbrockTest", "[GradientDescentTest]")
+{
+  GradientDescent s(0.001, 0, 1e-15);
+  s.UseLineSearch() = true;
+  FunctionTest<RosenbrockFunction>(s, 0.01, 0.001);
+}
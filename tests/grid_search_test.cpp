@@ -135,3 +135,138 @@ TEST_CASE("GridSearchIMatTest", "[GridSearchTest]")
   REQUIRE(params(1) == 2);
   REQUIRE(params(2) == 1);
 }
+
+TEST_CASE("GridSearchParallelEvaluationTest", "[GridSearchTest]")
+{
+  // Run the same categorical optimization with the grid points evaluated in
+  // parallel, and make sure the same optimum is found.
+  SimpleCategoricalFunction c;
+
+  std::vector<bool> categoricalDimensions;
+  categoricalDimensions.push_back(true);
+  categoricalDimensions.push_back(true);
+  categoricalDimensions.push_back(true);
+
+  arma::Row<size_t> numCategories("5 3 12");
+
+  arma::mat params("0 0 0");
+
+  GridSearch gs(true);
+  const double objective = gs.Optimize(c, params, categoricalDimensions,
+      numCategories);
+
+  REQUIRE(objective == 0.0);
+  REQUIRE(params(0) == 0);
+  REQUIRE(params(1) == 2);
+  REQUIRE(params(2) == 1);
+}
+
+// A callback that records every (configuration, objective) pair it sees.
+class ResultSinkCallback
+{
+ public:
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  bool Evaluate(OptimizerType& /* optimizer */,
+                FunctionType& /* function */,
+                const MatType& parameters,
+                const double objective)
+  {
+    configurations.push_back(parameters);
+    objectives.push_back(objective);
+    return false;
+  }
+
+  std::vector<arma::mat> configurations;
+  std::vector<double> objectives;
+};
+
+TEST_CASE("GridSearchResultSinkTest", "[GridSearchTest]")
+{
+  // Sweep the categorical function and make sure every grid point is streamed
+  // to the Evaluate() callback, not just the final best configuration.
+  SimpleCategoricalFunction c;
+
+  std::vector<bool> categoricalDimensions(3, true);
+  arma::Row<size_t> numCategories("5 3 12");
+  arma::mat params("0 0 0");
+
+  GridSearch gs;
+  ResultSinkCallback sink;
+  gs.Optimize(c, params, categoricalDimensions, numCategories, sink);
+
+  // Every grid point is reported exactly once, and exactly one configuration
+  // attains the optimum.
+  REQUIRE(sink.objectives.size() == 5 * 3 * 12);
+  size_t optima = 0;
+  for (const double objective : sink.objectives)
+    if (objective == 0.0)
+      ++optima;
+  REQUIRE(optima == 1);
+
+  // The parallel sweep streams the same number of results.
+  ResultSinkCallback parallelSink;
+  gs.ParallelEvaluation() = true;
+  gs.Optimize(c, params, categoricalDimensions, numCategories, parallelSink);
+  REQUIRE(parallelSink.objectives.size() == 5 * 3 * 12);
+}
+
+// A two-stage objective for the pruning test: the cheap first stage is a
+// lower bound on the objective, and the expensive second stage is skipped
+// whenever the bound passed in by the optimizer shows the configuration can
+// no longer beat the incumbent.
+class TwoStageCategoricalFunction
+{
+ public:
+  size_t secondStageEvaluations = 0;
+
+  template<typename MatType>
+  typename MatType::elem_type Evaluate(const MatType& x)
+  {
+    return Evaluate(x,
+        std::numeric_limits<typename MatType::elem_type>::max());
+  }
+
+  template<typename MatType>
+  typename MatType::elem_type Evaluate(
+      const MatType& x,
+      const typename MatType::elem_type incumbent)
+  {
+    typedef typename MatType::elem_type ElemType;
+
+    // First stage: a lower bound on the full objective.
+    const ElemType firstStage = std::abs(double(x(0)) - 2.0);
+    if (firstStage >= incumbent)
+      return firstStage; // Hopeless; abort before the expensive stage.
+
+    ++secondStageEvaluations;
+    return firstStage + std::abs(double(x(1)) - 1.0);
+  }
+};
+
+TEST_CASE("GridSearchPruningTest", "[GridSearchTest]")
+{
+  std::vector<bool> categoricalDimensions(2, true);
+  arma::Row<size_t> numCategories("5 4");
+
+  // Without pruning every configuration runs the expensive second stage.
+  TwoStageCategoricalFunction full;
+  arma::mat params("0 0");
+  GridSearch gs;
+  gs.Optimize(full, params, categoricalDimensions, numCategories);
+  REQUIRE(full.secondStageEvaluations == 5 * 4);
+
+  // With pruning enabled the incumbent is passed to the function, and the
+  // same optimum is found with far fewer second-stage evaluations (walking
+  // the grid in order, only two configurations per leading first stage value
+  // survive the bound until the exact optimum is hit: 6 in total).
+  TwoStageCategoricalFunction pruned;
+  params = arma::mat("0 0");
+  gs.Pruning() = true;
+  const double objective = gs.Optimize(pruned, params, categoricalDimensions,
+      numCategories);
+
+  REQUIRE(objective == 0.0);
+  REQUIRE(params(0) == 2);
+  REQUIRE(params(1) == 1);
+  REQUIRE(pruned.secondStageEvaluations == 6);
+}
@@ -0,0 +1,72 @@
+/**
+ * @file hybrid_optimizer_test.cpp
+ * @author Marcus Edel
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+#include "test_function_tools.hpp"
+
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * Chain CMA-ES and L-BFGS on logistic regression and make sure the results
+ * are acceptable.
+ */
+TEST_CASE("HybridCMAESLBFGSLogisticRegressionTest", "[HybridOptimizerTest]")
+{
+  BoundaryBoxConstraint<> b(-10, 10);
+  CMAES<FullSelection, BoundaryBoxConstraint<>> cmaes(0, b, 32, 200, 1e-3);
+  cmaes.StepSize() = 0.6;
+  L_BFGS lbfgs;
+
+  HybridOptimizer<CMAES<FullSelection, BoundaryBoxConstraint<>>, L_BFGS>
+      hybrid(cmaes, lbfgs);
+  LogisticRegressionFunctionTest(hybrid, 0.003, 0.006, 5);
+}
+
+/**
+ * Chain CMA-ES and L-BFGS on the Sphere function and check that the
+ * covariance scale of the global phase actually seeded the local phase's
+ * initial Hessian scaling.
+ */
+TEST_CASE("HybridOptimizerStateTransferTest", "[HybridOptimizerTest]")
+{
+  SphereFunction f(4);
+  CMAES<> cmaes(0, EmptyTransformation<>(), 32, 200, 1e-4);
+  L_BFGS lbfgs;
+
+  HybridOptimizer<CMAES<>, L_BFGS> hybrid(cmaes, lbfgs);
+
+  arma::mat coords = f.GetInitialPoint<arma::mat>();
+  hybrid.Optimize(f, coords);
+
+  REQUIRE(hybrid.LocalOptimizer().InitialScalingFactor() > 0.0);
+  REQUIRE(f.Evaluate(coords) <= 1e-5);
+}
+
+/**
+ * Chain PSO and GradientDescent on the Sphere function; this pairing has no
+ * distribution-state channel, so the handoff consists of the iterate alone.
+ */
+TEST_CASE("HybridPSOGradientDescentTest", "[HybridOptimizerTest]")
+{
+  SphereFunction f(4);
+  LBestPSO pso;
+  GradientDescent gd;
+
+  HybridOptimizer<LBestPSO, GradientDescent> hybrid(pso, gd);
+
+  arma::mat coords = f.GetInitialPoint<arma::mat>();
+  hybrid.Optimize(f, coords);
+
+  REQUIRE(f.Evaluate(coords) <= 1e-5);
+  for (size_t j = 0; j < 4; ++j)
+    REQUIRE(coords(j) <= 1e-3);
+}
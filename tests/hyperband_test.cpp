@@ -0,0 +1,128 @@
+/**
+ * @file hyperband_test.cpp
+ * @author Kirill Mishchenko
+ *
+ * Test file for the Hyperband optimizer.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+#include "test_function_tools.hpp"
+
+using namespace ens;
+using namespace ens::test;
+
+// A simple categorical function with a budget-parameterized objective.  The
+// true objective is |c1 - 3| + |c2 - 1|, so the optimum is found at [3, 1];
+// partial-budget evaluations see a bounded perturbation that shrinks as the
+// budget grows, imitating a model trained for fewer epochs.
+class BudgetedCategoricalFunction
+{
+ public:
+  template<typename MatType>
+  typename MatType::elem_type Evaluate(const MatType& x, const size_t budget)
+  {
+    const double trueObjective =
+        std::abs((double) x(0) - 3) + std::abs((double) x(1) - 1);
+    return trueObjective + std::cos((double) x(0) + 2 * x(1)) / budget;
+  }
+};
+
+TEST_CASE("HyperbandTest", "[HyperbandTest]")
+{
+  // Create and optimize the budgeted categorical function with the Hyperband
+  // optimizer.  We must also create a std::vector<bool> that holds the types
+  // of each dimension, and an arma::Row<size_t> that holds the number of
+  // categories in each dimension.
+  BudgetedCategoricalFunction c;
+
+  std::vector<bool> categoricalDimensions;
+  categoricalDimensions.push_back(true);
+  categoricalDimensions.push_back(true);
+
+  // The first category can take 5 values; the second can take 4.
+  arma::Row<size_t> numCategories("5 4");
+
+  arma::mat params("0 0");
+
+  Hyperband h(81, 3.0);
+  const double result = h.Optimize(c, params, categoricalDimensions,
+      numCategories);
+
+  REQUIRE(params(0) == 3);
+  REQUIRE(params(1) == 1);
+  REQUIRE(result == Approx(0.0).margin(0.05));
+}
+
+TEST_CASE("HyperbandFMatTest", "[HyperbandTest]")
+{
+  BudgetedCategoricalFunction c;
+
+  std::vector<bool> categoricalDimensions;
+  categoricalDimensions.push_back(true);
+  categoricalDimensions.push_back(true);
+
+  arma::Row<size_t> numCategories("5 4");
+
+  arma::fmat params("0 0");
+
+  Hyperband h(81, 3.0);
+  const float result = h.Optimize(c, params, categoricalDimensions,
+      numCategories);
+
+  REQUIRE(params(0) == 3);
+  REQUIRE(params(1) == 1);
+  REQUIRE(result == Approx(0.0f).margin(0.05));
+}
+
+// A budgeted categorical function that also exposes its cost model: the
+// evaluation becomes exact at fidelity 9, and the largest budget ever spent
+// is recorded so the clamping can be verified.
+class CostModelCategoricalFunction
+{
+ public:
+  size_t largestBudget = 0;
+
+  size_t MaxFidelity() const { return 9; }
+
+  template<typename MatType>
+  typename MatType::elem_type Evaluate(const MatType& x, const size_t budget)
+  {
+    largestBudget = std::max(largestBudget, budget);
+
+    const double trueObjective =
+        std::abs((double) x(0) - 3) + std::abs((double) x(1) - 1);
+    if (budget >= 9)
+      return trueObjective;
+    return trueObjective + std::cos((double) x(0) + 2 * x(1)) / budget;
+  }
+};
+
+/**
+ * Hyperband clamps its budgets to the fidelity at which the function reports
+ * its evaluation becomes exact (MaxFidelity()), so no evaluation spends more
+ * than that, and the returned objective is the exact objective of the
+ * returned configuration.
+ */
+TEST_CASE("HyperbandMaxFidelityClampTest", "[HyperbandTest]")
+{
+  CostModelCategoricalFunction c;
+
+  std::vector<bool> categoricalDimensions(2, true);
+  arma::Row<size_t> numCategories("5 4");
+
+  arma::mat params("0 0");
+
+  Hyperband h(81, 3.0);
+  const double result = h.Optimize(c, params, categoricalDimensions,
+      numCategories);
+
+  REQUIRE(c.largestBudget == 9);
+  REQUIRE(result == Approx(std::abs(params(0) - 3) +
+      std::abs(params(1) - 1)).margin(1e-12));
+}
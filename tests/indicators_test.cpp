@@ -2,7 +2,7 @@
  * @file indicators_test.cpp
  * @author Nanubala Gnana Sai
  *
- * Test file for all the indicators: Epsilon, IGD+.
+ * Test file for all the indicators: Epsilon, IGD+, Hypervolume.
  *
  * ensmallen is free software; you may redistribute it and/or modify it under
  * the terms of the 3-clause BSD license.  You should have received a copy of
@@ -95,3 +95,161 @@ TEST_CASE("IGDPlusFloatTest", "[IndicatorsTest]")
 
   REQUIRE(igdPlus == Approx(0.05329735411078149).margin(tol));
 }
+
+/**
+ * Calculates the Epsilon metric on matrix-stored fronts, with one point per
+ * column, and checks that the result matches the cube-based interface.
+ */
+TEST_CASE("EpsilonMatrixFrontTest", "[IndicatorsTest]")
+{
+  double tol = 1e-10;
+  arma::mat referenceFront{{0.01010101, 0.02020202, 0.03030303},
+                           {0.89949622, 0.85786619, 0.82592234}};
+  arma::mat front = referenceFront * 1.1;
+  double eps = Epsilon::Evaluate(front, referenceFront);
+
+  REQUIRE(eps == Approx(1.1).margin(tol));
+}
+
+/**
+ * Calculates the IGD+ metric on matrix-stored fronts, with one point per
+ * column, and checks that the result matches the cube-based interface.
+ */
+TEST_CASE("IGDPlusMatrixFrontTest", "[IndicatorsTest]")
+{
+  double tol = 1e-10;
+  arma::mat referenceFront{{0.01010101, 0.02020202, 0.03030303},
+                           {0.89949622, 0.85786619, 0.82592234}};
+  arma::mat front = referenceFront * 1.1;
+  double igdPlus = IGDPlus::Evaluate(front, referenceFront);
+
+  REQUIRE(igdPlus == Approx(0.05329735411078149).margin(tol));
+}
+
+/**
+ * Folds the front into the incremental evaluators one member at a time and
+ * checks that the final values match the batch results.
+ */
+TEST_CASE("IncrementalIndicatorsTest", "[IndicatorsTest]")
+{
+  double tol = 1e-10;
+  arma::mat referenceFront{{0.01010101, 0.02020202, 0.03030303},
+                           {0.89949622, 0.85786619, 0.82592234}};
+  arma::mat front = referenceFront * 1.1;
+
+  Epsilon::Incremental<arma::mat> eps(referenceFront);
+  IGDPlus::Incremental<arma::mat> igdPlus(referenceFront);
+  for (size_t j = 0; j < front.n_cols; j++)
+  {
+    eps.Update(front.col(j));
+    igdPlus.Update(front.col(j));
+  }
+
+  REQUIRE(eps.Value() == Approx(1.1).margin(tol));
+  REQUIRE(igdPlus.Value() == Approx(0.05329735411078149).margin(tol));
+
+  // After a Reset(), folding the whole front back in gives the same values.
+  eps.Reset();
+  igdPlus.Reset();
+  eps.Update(front);
+  igdPlus.Update(front);
+
+  REQUIRE(eps.Value() == Approx(1.1).margin(tol));
+  REQUIRE(igdPlus.Value() == Approx(0.05329735411078149).margin(tol));
+}
+
+/**
+ * Calculates the hypervolume of a front with a hand-computable box union.
+ * Tests for data of type double.  Adding a dominated point must not change
+ * the value.
+ */
+TEST_CASE("HypervolumeDoubleTest", "[IndicatorsTest]")
+{
+  double tol = 1e-10;
+  arma::cube front(2, 1, 3);
+  front.slice(0) = arma::vec{0.25, 0.75};
+  front.slice(1) = arma::vec{0.50, 0.50};
+  front.slice(2) = arma::vec{0.75, 0.25};
+  arma::vec referencePoint{1.0, 1.0};
+  double hv = Hypervolume::Evaluate(front, referencePoint);
+
+  REQUIRE(hv == Approx(0.375).margin(tol));
+
+  // A dominated point contributes nothing.
+  front.insert_slices(front.n_slices, 1);
+  front.slice(3) = arma::vec{0.80, 0.80};
+  hv = Hypervolume::Evaluate(front, referencePoint);
+
+  REQUIRE(hv == Approx(0.375).margin(tol));
+}
+
+/**
+ * Calculates the hypervolume of a front with a hand-computable box union.
+ * Tests for data of type float.
+ */
+TEST_CASE("HypervolumeFloatTest", "[IndicatorsTest]")
+{
+  float tol = 1e-6;
+  arma::fcube front(2, 1, 3);
+  front.slice(0) = arma::fvec{0.25f, 0.75f};
+  front.slice(1) = arma::fvec{0.50f, 0.50f};
+  front.slice(2) = arma::fvec{0.75f, 0.25f};
+  arma::fvec referencePoint{1.0f, 1.0f};
+  float hv = Hypervolume::Evaluate(front, referencePoint);
+
+  REQUIRE(hv == Approx(0.375).margin(tol));
+}
+
+/**
+ * Calculates the hypervolume of a three-objective front stored as a matrix
+ * with one point per column, including a dominated point and a point outside
+ * the reference region.
+ */
+TEST_CASE("HypervolumeThreeObjectiveTest", "[IndicatorsTest]")
+{
+  double tol = 1e-10;
+  arma::mat front{{0.5, 0.6, 1.5},
+                  {0.5, 0.6, 0.5},
+                  {0.5, 0.6, 0.5}};
+  arma::vec referencePoint{1.0, 1.0, 1.0};
+  double hv = Hypervolume::Evaluate(front, referencePoint);
+
+  // Only the (0.5, 0.5, 0.5) point contributes: the second point is
+  // dominated by it and the third lies outside the reference region.
+  REQUIRE(hv == Approx(0.125).margin(tol));
+}
+
+/**
+ * Folds front members into the incremental hypervolume evaluator one at a
+ * time, checks the running value against the batch result, and checks that
+ * removing a member subtracts exactly its exclusive contribution.
+ */
+TEST_CASE("IncrementalHypervolumeTest", "[IndicatorsTest]")
+{
+  double tol = 1e-10;
+  arma::mat front{{0.25, 0.50, 0.75},
+                  {0.75, 0.50, 0.25}};
+  arma::vec referencePoint{1.0, 1.0};
+
+  Hypervolume::Incremental<arma::mat> hv(referencePoint);
+  for (size_t j = 0; j < front.n_cols; j++)
+    hv.Update(front.col(j));
+
+  REQUIRE(hv.Value() == Approx(0.375).margin(tol));
+
+  // Folding in a dominated point leaves the value unchanged; removing it
+  // again does too.
+  hv.Update(arma::vec{0.80, 0.80});
+  REQUIRE(hv.Value() == Approx(0.375).margin(tol));
+  hv.Remove(3);
+  REQUIRE(hv.Value() == Approx(0.375).margin(tol));
+
+  // Removing the middle point leaves the union of the two outer boxes.
+  hv.Remove(1);
+  REQUIRE(hv.Value() == Approx(0.3125).margin(tol));
+
+  // After a Reset(), folding the whole front back in gives the batch value.
+  hv.Reset();
+  hv.Update(front);
+  REQUIRE(hv.Value() == Approx(0.375).margin(tol));
+}
@@ -0,0 +1,63 @@
+/**
+ * @file ipop_cmaes_test.cpp
+ * @author Marcus Edel
+ *
+ * Test file for the IPOP/BIPOP restart wrapper for CMA-ES.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+#include "test_function_tools.hpp"
+
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * Run IPOP-CMA-ES on the multimodal Rastrigin function and make sure the
+ * restarts find the global optimum.
+ */
+TEST_CASE("IPOPCMAESRastriginFunctionTest", "[IPOPCMAESTest]")
+{
+  BoundaryBoxConstraint<> b(-5.12, 5.12);
+  CMAES<FullSelection, BoundaryBoxConstraint<>> cmaes(0, b, 32, 200, 1e-8);
+  cmaes.StepSize() = 2.0;
+
+  IPOPCMAES<CMAES<FullSelection, BoundaryBoxConstraint<>>>
+      ipop(cmaes, 2, 5);
+  FunctionTest<RastriginFunction>(ipop, 0.1, 0.01, 3);
+}
+
+/**
+ * Run the BIPOP schedule with two raced restarts on the Rastrigin function
+ * and make sure the results are acceptable.
+ */
+TEST_CASE("BIPOPCMAESRastriginFunctionTest", "[IPOPCMAESTest]")
+{
+  BoundaryBoxConstraint<> b(-5.12, 5.12);
+  CMAES<FullSelection, BoundaryBoxConstraint<>> cmaes(0, b, 32, 200, 1e-8);
+  cmaes.StepSize() = 2.0;
+
+  IPOPCMAES<CMAES<FullSelection, BoundaryBoxConstraint<>>>
+      bipop(cmaes, 2, 5, true, 2);
+  FunctionTest<RastriginFunction>(bipop, 0.1, 0.01, 3);
+}
+
+/**
+ * Run IPOP-CMA-ES on the Rastrigin function with arma::fmat.
+ */
+TEST_CASE("IPOPCMAESRastriginFunctionFMatTest", "[IPOPCMAESTest]")
+{
+  BoundaryBoxConstraint<arma::fmat> b(-5.12, 5.12);
+  CMAES<FullSelection, BoundaryBoxConstraint<arma::fmat>>
+      cmaes(0, b, 32, 200, 1e-6);
+  cmaes.StepSize() = 2.0;
+
+  IPOPCMAES<CMAES<FullSelection, BoundaryBoxConstraint<arma::fmat>>>
+      ipop(cmaes, 2, 5);
+  FunctionTest<RastriginFunction, arma::fmat>(ipop, 0.5, 0.05, 3);
+}
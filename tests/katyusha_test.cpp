@@ -71,6 +71,39 @@ TEST_CASE("KatyushaProximalLogisticRegressionFMatTest", "[KatyushaTest]")
   }
 }
 
+/**
+ * Run composite Katyusha (with a weak L1 proximal operator) on logistic
+ * regression and make sure the results are still acceptable: the proximal
+ * path must not cost accuracy when the regularizer is negligible.
+ */
+TEST_CASE("CompositeKatyushaLogisticRegressionTest", "[KatyushaTest]")
+{
+  // Run with a couple of batch sizes.
+  for (size_t batchSize = 30; batchSize < 45; batchSize += 5)
+  {
+    ProximalKatyusha<> optimizer(1.0, 10.0, batchSize, 100, 0, 1e-10, true);
+    optimizer.ProxOperator().Lambda() = 1e-6;
+    LogisticRegressionFunctionTest(optimizer, 0.015, 0.015);
+  }
+}
+
+/**
+ * A strong L1 term on the sphere function must pull the iterate into the
+ * vicinity of zero: the proximal steps handle the regularizer exactly, so
+ * the composite optimum (which is exactly zero) is reached.
+ */
+TEST_CASE("CompositeKatyushaSphereShrinkageTest", "[KatyushaTest]")
+{
+  SphereFunction f(2);
+  ProximalKatyusha<> optimizer(1.0, 10.0, 2, 200, 0, 1e-15, true);
+  optimizer.ProxOperator().Lambda() = 0.1;
+
+  arma::mat coordinates = f.GetInitialPoint();
+  optimizer.Optimize(f, coordinates);
+
+  REQUIRE(arma::norm(coordinates, 2) < 0.1);
+}
+
 #if ARMA_VERSION_MAJOR > 9 ||\
     (ARMA_VERSION_MAJOR == 9 && ARMA_VERSION_MINOR >= 400)
 
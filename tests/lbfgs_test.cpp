@@ -125,3 +125,169 @@ TEST_CASE("RosenbrockWoodFunctionTest", "[LBFGSTest]")
   lbfgs.MaxIterations() = 10000;
   FunctionTest<RosenbrockWoodFunction>(lbfgs, 0.01, 0.001);
 }
+
+/**
+ * Tests the L-BFGS optimizer with the speculative parallel line search using
+ * the Rosenbrock function.
+ */
+TEST_CASE("RosenbrockFunctionSpeculativeLineSearchTest", "[LBFGSTest]")
+{
+  L_BFGS lbfgs;
+  lbfgs.MaxIterations() = 10000;
+  lbfgs.SpeculativeLineSearch() = true;
+  FunctionTest<RosenbrockFunction>(lbfgs, 0.01, 0.001);
+}
+
+/**
+ * Tests the L-BFGS optimizer with the strong-Wolfe cubic-interpolation line
+ * search using the Rosenbrock function.
+ */
+TEST_CASE("RosenbrockFunctionCubicLineSearchTest", "[LBFGSTest]")
+{
+  L_BFGS lbfgs;
+  lbfgs.MaxIterations() = 10000;
+  lbfgs.CubicLineSearch() = true;
+  FunctionTest<RosenbrockFunction>(lbfgs, 0.01, 0.001);
+}
+
+/**
+ * Tests the L-BFGS optimizer with the nonmonotone (Grippo-Lampariello-Lucidi)
+ * line search acceptance using the Rosenbrock function, whose narrow curved
+ * valley is exactly the geometry the nonmonotone rule is meant for.
+ */
+TEST_CASE("RosenbrockFunctionNonmonotoneLineSearchTest", "[LBFGSTest]")
+{
+  L_BFGS lbfgs;
+  lbfgs.MaxIterations() = 10000;
+  lbfgs.NonmonotoneMemory() = 10;
+  FunctionTest<RosenbrockFunction>(lbfgs, 0.01, 0.001);
+}
+
+/**
+ * The nonmonotone acceptance should not need more function evaluations than
+ * monotone Armijo back-tracking on the generalized Rosenbrock function; run
+ * both on a counting wrapper and compare.
+ */
+TEST_CASE("NonmonotoneLineSearchEvaluationsTest", "[LBFGSTest]")
+{
+  GeneralizedRosenbrockFunction f(10);
+
+  CountingFunction<GeneralizedRosenbrockFunction> monotoneF(f);
+  L_BFGS monotone;
+  monotone.MaxIterations() = 10000;
+  arma::mat monotoneCoords = f.GetInitialPoint();
+  monotone.Optimize(monotoneF, monotoneCoords);
+
+  CountingFunction<GeneralizedRosenbrockFunction> nonmonotoneF(f);
+  L_BFGS nonmonotone;
+  nonmonotone.MaxIterations() = 10000;
+  nonmonotone.NonmonotoneMemory() = 10;
+  arma::mat nonmonotoneCoords = f.GetInitialPoint();
+  nonmonotone.Optimize(nonmonotoneF, nonmonotoneCoords);
+
+  // Both runs must reach the minimum.
+  for (size_t j = 0; j < 10; ++j)
+  {
+    REQUIRE(monotoneCoords(j) == Approx(1.0).epsilon(1e-3));
+    REQUIRE(nonmonotoneCoords(j) == Approx(1.0).epsilon(1e-3));
+  }
+
+  // A generous factor guards against environment-dependent line search
+  // behavior; the point is that relaxing the acceptance cannot blow up the
+  // evaluation count.
+  REQUIRE(nonmonotoneF.EvaluateWithGradients() <=
+      2 * monotoneF.EvaluateWithGradients());
+}
+
+/**
+ * Tests L-BFGS-B on the unconstrained Rosenbrock function with inactive
+ * bounds; the solution should match plain L-BFGS.
+ */
+TEST_CASE("LBFGSBRosenbrockInactiveBoundsTest", "[LBFGSTest]")
+{
+  L_BFGS_B lbfgsb(-10.0, 10.0);
+  lbfgsb.MaxIterations() = 10000;
+  FunctionTest<RosenbrockFunction>(lbfgsb, 0.01, 0.001);
+}
+
+/**
+ * Tests L-BFGS-B with active bounds on the Rosenbrock function: the
+ * unconstrained minimum [1, 1] is outside the box, so the solver must
+ * converge to a feasible point on the boundary.
+ */
+TEST_CASE("LBFGSBRosenbrockActiveBoundsTest", "[LBFGSTest]")
+{
+  L_BFGS_B lbfgsb(-2.0, 0.5);
+  lbfgsb.MaxIterations() = 10000;
+
+  RosenbrockFunction f;
+  arma::mat coordinates = f.GetInitialPoint();
+  const double objective = lbfgsb.Optimize(f, coordinates);
+
+  // The result must be feasible.
+  REQUIRE(coordinates.max() <= 0.5 + 1e-10);
+  REQUIRE(coordinates.min() >= -2.0 - 1e-10);
+
+  // The box-constrained minimum of the Rosenbrock function with x <= 0.5 has
+  // x1 at its upper bound and x2 = x1^2.
+  REQUIRE(coordinates(0) == Approx(0.5).epsilon(0.01));
+  REQUIRE(coordinates(1) == Approx(0.25).epsilon(0.01));
+  REQUIRE(objective < f.Evaluate(f.GetInitialPoint()));
+}
+
+/**
+ * Test that L-BFGS still converges when the memory pairs are retained across
+ * Optimize() calls: a second run on the same function must reuse the stored
+ * pairs and converge, and a run on a different problem size must drop them.
+ */
+TEST_CASE("RosenbrockFunctionRetainMemoryTest", "[LBFGSTest]")
+{
+  L_BFGS lbfgs;
+  lbfgs.MaxIterations() = 10000;
+  lbfgs.RetainMemory() = true;
+
+  FunctionTest<RosenbrockFunction>(lbfgs, 0.01, 0.001);
+
+  // A second run warm-starts from the pairs stored by the first.
+  FunctionTest<RosenbrockFunction>(lbfgs, 0.01, 0.001);
+
+  // A different problem size must invalidate the retained pairs.
+  GeneralizedRosenbrockFunction f(10);
+  arma::vec coords = f.GetInitialPoint();
+  lbfgs.Optimize(f, coords);
+  REQUIRE(f.Evaluate(coords) == Approx(0.0).margin(1e-5));
+}
+
+/**
+ * Tests the L-BFGS optimizer with the vector-free (Gram-matrix) direction
+ * computation using the Rosenbrock function.  The computed direction is
+ * mathematically identical to the two-loop recursion, so convergence must
+ * match the default configuration.
+ */
+TEST_CASE("RosenbrockFunctionVectorFreeTest", "[LBFGSTest]")
+{
+  L_BFGS lbfgs;
+  lbfgs.MaxIterations() = 10000;
+  lbfgs.VectorFree() = true;
+  FunctionTest<RosenbrockFunction>(lbfgs, 0.01, 0.001);
+}
+
+/**
+ * Test the vector-free direction computation on the generalized Rosenbrock
+ * function with a full memory ring, so that the incremental Gram matrix
+ * update exercises the overwrite of old pairs.
+ */
+TEST_CASE("GeneralizedRosenbrockVectorFreeTest", "[LBFGSTest]")
+{
+  GeneralizedRosenbrockFunction f(50);
+  L_BFGS lbfgs(10);
+  lbfgs.MaxIterations() = 10000;
+  lbfgs.VectorFree() = true;
+
+  arma::vec coords = f.GetInitialPoint();
+  lbfgs.Optimize(f, coords);
+
+  REQUIRE(f.Evaluate(coords) == Approx(0.0).margin(1e-5));
+  for (size_t j = 0; j < 50; ++j)
+    REQUIRE(coords(j) == Approx(1.0).epsilon(1e-7));
+}
@@ -0,0 +1,68 @@
+/**
+ * @file local_sgd_test.cpp
+ * @author Marcus Edel
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+
+#include "test_function_tools.hpp"
+
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * Independent chains averaged every few steps should reach the optimum of
+ * the sphere function.
+ */
+TEST_CASE("LocalSGDSphereFunctionTest", "[LocalSGDTest]")
+{
+  SphereFunction f(4);
+  LocalSGD<> s(0.05, 2, 100000, 8, 1e-9);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  const double result = s.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(1e-4));
+  for (size_t j = 0; j < 4; ++j)
+    REQUIRE(coordinates(j) == Approx(0.0).margin(1e-3));
+}
+
+/**
+ * Local SGD should compose with the regular SGD policy stack; run the chains
+ * with momentum updates.
+ */
+TEST_CASE("LocalSGDMomentumUpdateTest", "[LocalSGDTest]")
+{
+  SphereFunction f(4);
+  MomentumUpdate momentumUpdate(0.7);
+  LocalSGD<MomentumUpdate> s(0.01, 2, 100000, 8, 1e-9, true, momentumUpdate);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  const double result = s.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(1e-4));
+  for (size_t j = 0; j < 4; ++j)
+    REQUIRE(coordinates(j) == Approx(0.0).margin(1e-3));
+}
+
+/**
+ * Local SGD should also work with float coordinates.
+ */
+TEST_CASE("LocalSGDSphereFunctionFMatTest", "[LocalSGDTest]")
+{
+  SphereFunction f(4);
+  LocalSGD<> s(0.05, 2, 100000, 8, 1e-7);
+
+  arma::fmat coordinates = f.GetInitialPoint<arma::fmat>();
+  const float result = s.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0f).margin(1e-2));
+  for (size_t j = 0; j < 4; ++j)
+    REQUIRE(coordinates(j) == Approx(0.0f).margin(1e-1));
+}
@@ -340,3 +340,84 @@ TEST_CASE("GaussianMatrixSensingSDP", "[LRSDPTest]")
       arma::norm(Xorig, "fro");
   REQUIRE(err == Approx(0.0).margin(0.05));
 }
+
+/**
+ * Test that a warm-started second solve of the Lovasz-Theta SDP reuses the
+ * multipliers and penalty parameter from the first solve and still reaches
+ * the optimum.
+ */
+TEST_CASE("WarmStartLovaszThetaSDP", "[LRSDPTest]")
+{
+  // Load the edges.
+  arma::mat edges;
+
+  if (edges.load("data/johnson8-4-4.csv", arma::csv_ascii) == false)
+  {
+    FAIL("couldn't load data");
+    return;
+  }
+
+  edges = edges.t();
+
+  // The LRSDP itself and the initial point.
+  arma::mat coordinates;
+
+  CreateLovaszThetaInitialPoint(edges, coordinates);
+
+  LRSDP<SDP<arma::mat>> lovasz(edges.n_cols + 1, 0, coordinates);
+  lovasz.WarmStart() = true;
+
+  SetupLovaszTheta(edges, lovasz);
+
+  double finalValue = lovasz.Optimize(coordinates);
+
+  REQUIRE(finalValue == Approx(-14.0).epsilon(1e-7));
+
+  // Now re-solve from the previous solution; the multipliers and penalty
+  // parameter of the first solve are carried over, and the optimum should be
+  // reached again.
+  const double sigma = lovasz.AugLag().Sigma();
+  finalValue = lovasz.Optimize(coordinates);
+
+  REQUIRE(lovasz.AugLag().Sigma() >= sigma);
+  REQUIRE(finalValue == Approx(-14.0).epsilon(1e-7));
+}
+
+/**
+ * Solve the Lovasz-Theta SDP starting from a deliberately small factor rank
+ * with automatic rank adaptation enabled; the solver should grow the rank
+ * only as far as needed and still reach the optimum.
+ */
+TEST_CASE("RankAdaptationLovaszThetaSDP", "[LRSDPTest]")
+{
+  // Load the edges.
+  arma::mat edges;
+
+  if (edges.load("data/johnson8-4-4.csv", arma::csv_ascii) == false)
+  {
+    FAIL("couldn't load data");
+    return;
+  }
+
+  edges = edges.t();
+
+  arma::mat coordinates;
+  CreateLovaszThetaInitialPoint(edges, coordinates);
+  const size_t fullRank = coordinates.n_cols;
+
+  // Keep only the first two columns of the usual initial point so the solve
+  // starts at rank 2.
+  coordinates = coordinates.cols(0, 1);
+
+  LRSDP<SDP<arma::mat>> lovasz(edges.n_cols + 1, 0, coordinates);
+  lovasz.RankAdaptation() = true;
+
+  SetupLovaszTheta(edges, lovasz);
+
+  const double finalValue = lovasz.Optimize(coordinates);
+
+  REQUIRE(finalValue == Approx(-14.0).epsilon(1e-5));
+  // The rank never grows past the Barvinok-Pataki bound used for the usual
+  // initial point.
+  REQUIRE(coordinates.n_cols <= fullRank);
+}
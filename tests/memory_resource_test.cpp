@@ -0,0 +1,83 @@
+/**
+ * @file memory_resource_test.cpp
+ * @author Marcus Edel
+ *
+ * Test file for the pluggable memory resource classes.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+
+using namespace ens;
+
+/**
+ * The pool hands out aligned, non-overlapping allocations, grows past its
+ * initial block, and resets on Release().
+ */
+TEST_CASE("PoolMemoryResourceTest", "[MemoryResourceTest]")
+{
+  PoolMemoryResource pool(64);
+  REQUIRE(pool.BytesAllocated() == 0);
+
+  // Fill the first block and force a second (and an oversized) one.
+  const size_t sizes[5] = { 24, 40, 8, 64, 1024 };
+  char* allocations[5];
+  for (size_t i = 0; i < 5; ++i)
+  {
+    allocations[i] = (char*) pool.Allocate(sizes[i]);
+    REQUIRE(allocations[i] != NULL);
+    REQUIRE(((size_t) allocations[i]) % alignof(std::max_align_t) == 0);
+
+    // The memory must be usable.
+    memset(allocations[i], 0xab, sizes[i]);
+  }
+
+  // No two allocations may overlap.
+  for (size_t i = 0; i < 5; ++i)
+  {
+    for (size_t j = i + 1; j < 5; ++j)
+    {
+      REQUIRE(((allocations[i] + sizes[i]) <= allocations[j] ||
+               (allocations[j] + sizes[j]) <= allocations[i]));
+    }
+  }
+
+  // Deallocate() is a no-op and the counter only counts Allocate()s.
+  const size_t used = pool.BytesAllocated();
+  REQUIRE(used >= 24 + 40 + 8 + 64 + 1024);
+  pool.Deallocate(allocations[0], sizes[0]);
+  REQUIRE(pool.BytesAllocated() == used);
+
+  // After Release() the pool is empty and reusable.
+  pool.Release();
+  REQUIRE(pool.BytesAllocated() == 0);
+  void* mem = pool.Allocate(16);
+  REQUIRE(mem != NULL);
+  REQUIRE(pool.BytesAllocated() >= 16);
+}
+
+/**
+ * ScopedMemoryResource installs a resource on the current thread and
+ * restores the previous one on scope exit, including when nested.
+ */
+TEST_CASE("ScopedMemoryResourceTest", "[MemoryResourceTest]")
+{
+  REQUIRE(CurrentMemoryResource() == NULL);
+
+  PoolMemoryResource outer, inner;
+  {
+    ScopedMemoryResource outerGuard(outer);
+    REQUIRE(CurrentMemoryResource() == &outer);
+    {
+      ScopedMemoryResource innerGuard(inner);
+      REQUIRE(CurrentMemoryResource() == &inner);
+    }
+    REQUIRE(CurrentMemoryResource() == &outer);
+  }
+  REQUIRE(CurrentMemoryResource() == NULL);
+}
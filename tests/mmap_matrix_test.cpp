@@ -0,0 +1,141 @@
+/**
+ * @file mmap_matrix_test.cpp
+ * @author Marcus Edel
+ *
+ * Test file for the memory-mapped matrix utility.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include <fstream>
+#include "catch.hpp"
+#include "test_function_tools.hpp"
+
+using namespace ens;
+using namespace ens::test;
+
+//! Write the given matrix to a raw column-major element file.
+static void WriteRawMatrix(const std::string& filename, const arma::mat& m)
+{
+  std::ofstream stream(filename.c_str(), std::ios::binary);
+  stream.write((const char*) m.memptr(),
+      m.n_elem * sizeof(arma::mat::elem_type));
+}
+
+/**
+ * A separable function over a memory-mapped dataset: the summed squared
+ * distance of the iterate to each data column.  The minimum is the mean of
+ * the columns.  The PrefetchBatch() hook forwards the upcoming batch to the
+ * readahead hint of the mapping.
+ */
+class MmapMeanFunction
+{
+ public:
+  MmapMeanFunction(const MmapMatrix<double>& source) : source(source) { }
+
+  size_t NumFunctions() const { return source.Cols(); }
+
+  void Shuffle() { }
+
+  double Evaluate(const arma::mat& coordinates,
+                  const size_t begin,
+                  const size_t batchSize)
+  {
+    double objective = 0;
+    for (size_t i = begin; i < begin + batchSize; ++i)
+    {
+      objective += arma::accu(arma::square(
+          coordinates - source.Matrix().col(i)));
+    }
+    return objective;
+  }
+
+  void Gradient(const arma::mat& coordinates,
+                const size_t begin,
+                arma::mat& gradient,
+                const size_t batchSize)
+  {
+    gradient.zeros(coordinates.n_rows, coordinates.n_cols);
+    for (size_t i = begin; i < begin + batchSize; ++i)
+      gradient += 2 * (coordinates - source.Matrix().col(i));
+  }
+
+  void PrefetchBatch(const size_t begin, const size_t batchSize)
+  {
+    source.WillNeed(begin, batchSize);
+  }
+
+ private:
+  const MmapMatrix<double>& source;
+};
+
+/**
+ * Make sure the mapped view exposes exactly the file contents, and that the
+ * readahead hints can be issued without harm.
+ */
+TEST_CASE("MmapMatrixContentsTest", "[MmapMatrixTest]")
+{
+  arma::mat m(7, 13, arma::fill::randn);
+  WriteRawMatrix("mmap_matrix_test.bin", m);
+
+  {
+    MmapMatrix<double> mapped("mmap_matrix_test.bin", 7, 13);
+
+    REQUIRE(mapped.Rows() == 7);
+    REQUIRE(mapped.Cols() == 13);
+    REQUIRE(arma::norm(mapped.Matrix() - m, "fro") ==
+        Approx(0.0).margin(1e-15));
+
+    mapped.AdviseSequential();
+    mapped.WillNeed(0, 5);
+    mapped.WillNeed(10, 100); // Clamped to the matrix shape.
+    REQUIRE(arma::norm(mapped.Matrix() - m, "fro") ==
+        Approx(0.0).margin(1e-15));
+  }
+
+  std::remove("mmap_matrix_test.bin");
+}
+
+/**
+ * A file smaller than the requested shape must be rejected.
+ */
+TEST_CASE("MmapMatrixShortFileTest", "[MmapMatrixTest]")
+{
+  arma::mat m(3, 3, arma::fill::randn);
+  WriteRawMatrix("mmap_matrix_test.bin", m);
+
+  REQUIRE_THROWS_AS(MmapMatrix<double>("mmap_matrix_test.bin", 10, 10),
+      std::runtime_error);
+
+  std::remove("mmap_matrix_test.bin");
+}
+
+/**
+ * Train a separable function backed by a memory-mapped dataset with SGD; the
+ * minimum is the mean of the data columns.
+ */
+TEST_CASE("MmapMatrixSGDTest", "[MmapMatrixTest]")
+{
+  arma::mat data(5, 100, arma::fill::randn);
+  data.each_col() += arma::vec(5, arma::fill::ones);
+  WriteRawMatrix("mmap_matrix_test.bin", data);
+
+  {
+    MmapMatrix<double> mapped("mmap_matrix_test.bin", 5, 100);
+    MmapMeanFunction f(mapped);
+
+    StandardSGD s(0.001, 10, 50000, 1e-9);
+    arma::mat coordinates(5, 1, arma::fill::zeros);
+    s.Optimize(f, coordinates);
+
+    const arma::vec mean = arma::mean(data, 1);
+    for (size_t j = 0; j < 5; ++j)
+      REQUIRE(coordinates(j) == Approx(mean(j)).margin(0.05));
+  }
+
+  std::remove("mmap_matrix_test.bin");
+}
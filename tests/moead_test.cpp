@@ -628,3 +628,292 @@ TEST_CASE("MOEADDIRICHLETZDT3Test", "[MOEADTest]")
   const arma::cube& finalPopulation = opt.ParetoSet();
   REQUIRE(VariableBoundsCheck(finalPopulation));
 }
+
+/**
+ * Optimize for the Schaffer N.1 function with parallel population evaluation
+ * enabled; the results should be in the expected range just the same.
+ */
+TEST_CASE("MOEADParallelEvaluationSchafferN1Test", "[MOEADTest]")
+{
+  SchafferFunctionN1<arma::mat> SCH;
+  const double lowerBound = -1000;
+  const double upperBound = 1000;
+  const double expectedLowerBound = 0.0;
+  const double expectedUpperBound = 2.0;
+
+  DefaultMOEAD opt(
+        300, // Population size.
+        300,  // Max generations.
+        1.0,  // Crossover probability.
+        0.9, // Probability of sampling from neighbor.
+        20, // Neighborhood size.
+        20, // Perturbation index.
+        0.5, // Differential weight.
+        2, // Max childrens to replace parents.
+        1E-10, // epsilon.
+        lowerBound, // Lower bound.
+        upperBound // Upper bound.
+      );
+  opt.ParallelEvaluation() = true;
+
+  typedef decltype(SCH.objectiveA) ObjectiveTypeA;
+  typedef decltype(SCH.objectiveB) ObjectiveTypeB;
+
+  // We allow a few trials in case of poor convergence.
+  bool success = false;
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    arma::mat coords = SCH.GetInitialPoint();
+    std::tuple<ObjectiveTypeA, ObjectiveTypeB> objectives = SCH.GetObjectives();
+
+    opt.Optimize(objectives, coords);
+    arma::cube paretoSet = opt.ParetoSet();
+
+    bool allInRange = true;
+
+    for (size_t solutionIdx = 0; solutionIdx < paretoSet.n_slices; ++solutionIdx)
+    {
+      double val = arma::as_scalar(paretoSet.slice(solutionIdx));
+      if (!IsInBounds<double>(val, expectedLowerBound, expectedUpperBound, 0.1))
+      {
+        allInRange = false;
+        break;
+      }
+    }
+
+    if (allInRange)
+    {
+      success = true;
+      break;
+    }
+  }
+
+  REQUIRE(success == true);
+}
+
+/**
+ * Optimize for the Schaffer N.1 function with the external epsilon-grid
+ * archive enabled; the archived front should lie in the expected range.
+ */
+TEST_CASE("MOEADArchiveSchafferN1Test", "[MOEADTest]")
+{
+  SchafferFunctionN1<arma::mat> SCH;
+  const double lowerBound = -1000;
+  const double upperBound = 1000;
+  const double expectedLowerBound = 0.0;
+  const double expectedUpperBound = 2.0;
+
+  DefaultMOEAD opt(
+        300, // Population size.
+        300,  // Max generations.
+        1.0,  // Crossover probability.
+        0.9, // Probability of sampling from neighbor.
+        20, // Neighborhood size.
+        20, // Perturbation index.
+        0.5, // Differential weight.
+        2, // Max childrens to replace parents.
+        1E-10, // epsilon.
+        lowerBound, // Lower bound.
+        upperBound // Upper bound.
+      );
+  opt.MaxArchiveSize() = 500;
+  opt.ArchiveEpsilon() = 0.01;
+
+  typedef decltype(SCH.objectiveA) ObjectiveTypeA;
+  typedef decltype(SCH.objectiveB) ObjectiveTypeB;
+
+  // We allow a few trials in case of poor convergence.
+  bool success = false;
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    arma::mat coords = SCH.GetInitialPoint();
+    std::tuple<ObjectiveTypeA, ObjectiveTypeB> objectives = SCH.GetObjectives();
+
+    opt.Optimize(objectives, coords);
+    arma::cube paretoSet = opt.ParetoSet();
+
+    REQUIRE(paretoSet.n_slices > 0);
+    REQUIRE(paretoSet.n_slices <= opt.MaxArchiveSize());
+
+    bool allInRange = true;
+
+    for (size_t solutionIdx = 0; solutionIdx < paretoSet.n_slices; ++solutionIdx)
+    {
+      double val = arma::as_scalar(paretoSet.slice(solutionIdx));
+      if (!IsInBounds<double>(val, expectedLowerBound, expectedUpperBound, 0.1))
+      {
+        allInRange = false;
+        break;
+      }
+    }
+
+    if (allInRange)
+    {
+      success = true;
+      break;
+    }
+  }
+
+  REQUIRE(success == true);
+}
+
+/**
+ * The Riesz energy policy must produce any requested number of well-spread
+ * weights on the simplex, including objective counts where the Das-Dennis
+ * lattice would be far larger than the population.
+ */
+TEST_CASE("RieszEnergyWeightGenerationTest", "[MOEADTest]")
+{
+  const size_t numObjectives = 8;
+  const size_t numPoints = 150;
+  const double epsilon = 1E-10;
+
+  RieszEnergy init;
+  const arma::mat weights = init.Generate<arma::mat>(numObjectives, numPoints,
+      epsilon);
+
+  REQUIRE(weights.n_rows == numObjectives);
+  REQUIRE(weights.n_cols == numPoints);
+  REQUIRE(weights.is_finite());
+  REQUIRE(weights.min() >= 0.0);
+
+  // Every column must lie on the unit simplex.
+  for (size_t i = 0; i < numPoints; ++i)
+    REQUIRE(arma::accu(weights.col(i)) == Approx(1.0).epsilon(1e-6));
+
+  // The points must be spread out: no two weights may (nearly) coincide.
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    for (size_t j = i + 1; j < numPoints; ++j)
+    {
+      REQUIRE(arma::norm(weights.col(i) - weights.col(j)) > 1e-3);
+    }
+  }
+}
+
+/**
+ * Optimize for the Schaffer N.1 function using the Riesz energy weight
+ * initialization; a population size that no Das-Dennis lattice matches.
+ */
+TEST_CASE("MOEADRieszEnergySchafferN1Test", "[MOEADTest]")
+{
+  SchafferFunctionN1<arma::mat> SCH;
+  const double lowerBound = -1000;
+  const double upperBound = 1000;
+  const double expectedLowerBound = 0.0;
+  const double expectedUpperBound = 2.0;
+
+  RieszEnergyMOEAD opt(
+        150, // Population size.
+        300,  // Max generations.
+        1.0,  // Crossover probability.
+        0.9, // Probability of sampling from neighbor.
+        20, // Neighborhood size.
+        20, // Perturbation index.
+        0.5, // Differential weight.
+        2, // Max childrens to replace parents.
+        1E-10, // epsilon.
+        lowerBound, // Lower bound.
+        upperBound // Upper bound.
+      );
+
+  typedef decltype(SCH.objectiveA) ObjectiveTypeA;
+  typedef decltype(SCH.objectiveB) ObjectiveTypeB;
+
+  // We allow a few trials in case of poor convergence.
+  bool success = false;
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    arma::mat coords = SCH.GetInitialPoint();
+    std::tuple<ObjectiveTypeA, ObjectiveTypeB> objectives = SCH.GetObjectives();
+
+    opt.Optimize(objectives, coords);
+    arma::cube paretoSet = opt.ParetoSet();
+
+    bool allInRange = true;
+
+    for (size_t solutionIdx = 0; solutionIdx < paretoSet.n_slices;
+        ++solutionIdx)
+    {
+      const double val = arma::as_scalar(paretoSet.slice(solutionIdx));
+      if (!IsInBounds<double>(val, expectedLowerBound, expectedUpperBound,
+          0.1))
+      {
+        allInRange = false;
+        break;
+      }
+    }
+
+    if (allInRange)
+    {
+      success = true;
+      break;
+    }
+  }
+
+  REQUIRE(success == true);
+}
+
+/**
+ * Optimize for the Schaffer N.1 function with the island-parallel generation
+ * loop enabled, and make sure the sharded update phase still converges to
+ * the known Pareto set.
+ */
+TEST_CASE("MOEADIslandParallelSchafferN1Test", "[MOEADTest]")
+{
+  SchafferFunctionN1<arma::mat> SCH;
+  const double lowerBound = -1000;
+  const double upperBound = 1000;
+  const double expectedLowerBound = 0.0;
+  const double expectedUpperBound = 2.0;
+
+  DefaultMOEAD opt(
+        300, // Population size.
+        300,  // Max generations.
+        1.0,  // Crossover probability.
+        0.9, // Probability of sampling from neighbor.
+        20, // Neighborhood size.
+        20, // Perturbation index.
+        0.5, // Differential weight.
+        2, // Max childrens to replace parents.
+        1E-10, // epsilon.
+        lowerBound, // Lower bound.
+        upperBound // Upper bound.
+      );
+  opt.IslandParallel() = true;
+
+  typedef decltype(SCH.objectiveA) ObjectiveTypeA;
+  typedef decltype(SCH.objectiveB) ObjectiveTypeB;
+
+  // We allow a few trials in case of poor convergence.
+  bool success = false;
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    arma::mat coords = SCH.GetInitialPoint();
+    std::tuple<ObjectiveTypeA, ObjectiveTypeB> objectives = SCH.GetObjectives();
+
+    opt.Optimize(objectives, coords);
+    arma::cube paretoSet = opt.ParetoSet();
+
+    bool allInRange = true;
+
+    for (size_t solutionIdx = 0; solutionIdx < paretoSet.n_slices;
+        ++solutionIdx)
+    {
+      double val = arma::as_scalar(paretoSet.slice(solutionIdx));
+      if (!IsInBounds<double>(val, expectedLowerBound, expectedUpperBound, 0.1))
+      {
+        allInRange = false;
+        break;
+      }
+    }
+
+    if (allInRange)
+    {
+      success = true;
+      break;
+    }
+  }
+
+  REQUIRE(success == true);
+}
@@ -108,3 +108,42 @@ TEST_CASE("MomentumSGDGeneralizedRosenbrockSpMatTest", "[MomentumSGDTest]")
       REQUIRE(coordinates(j) == Approx(1.0).epsilon(1e-5));
   }
 }
+
+/**
+ * Run momentum SGD with a sparse gradient type on the sparse test function;
+ * the lazy update path must catch up the velocity decay of the coordinates
+ * that are skipped between visits.
+ */
+TEST_CASE("MomentumSGDSparseGradientTest", "[MomentumSGDTest]")
+{
+  SparseTestFunction f;
+  MomentumUpdate momentumUpdate(0.7);
+  MomentumSGD s(0.0025, 1, 500000, 1e-9, true, momentumUpdate);
+
+  arma::mat coordinates = f.GetInitialPoint<arma::mat>();
+  s.Optimize<SparseTestFunction, arma::mat, arma::sp_mat>(f, coordinates);
+
+  REQUIRE(coordinates(0) == Approx(2.0).epsilon(0.003));
+  REQUIRE(coordinates(1) == Approx(1.0).epsilon(0.003));
+  REQUIRE(coordinates(2) == Approx(1.5).epsilon(0.003));
+  REQUIRE(coordinates(3) == Approx(4.0).epsilon(0.003));
+}
+
+/**
+ * Run momentum SGD with decoupled weight decay (SGDW) on the sphere function;
+ * the decay pulls toward the origin, which is also the optimum, so the
+ * optimizer must still converge.
+ */
+TEST_CASE("MomentumSGDWeightDecaySphereFunctionTest", "[MomentumSGDTest]")
+{
+  SphereFunction f(2);
+  MomentumUpdate momentumUpdate(0.7, 0.001);
+  MomentumSGD s(0.0003, 1, 2500000, 1e-9, true, momentumUpdate);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  double result = s.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(1e-3));
+  for (size_t j = 0; j < 2; ++j)
+    REQUIRE(coordinates(j) == Approx(0.0).margin(1e-2));
+}
@@ -0,0 +1,49 @@
+/**
+ * @file multi_start_test.cpp
+ * @author Marcus Edel
+ *
+ * Test file for the parallel multi-start meta-optimizer.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+#include "test_function_tools.hpp"
+
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * Run multi-start L-BFGS on the Rosenbrock function and make sure the best
+ * start reaches the minimum.
+ */
+TEST_CASE("MultiStartLBFGSRosenbrockTest", "[MultiStartTest]")
+{
+  L_BFGS lbfgs;
+  MultiStart<L_BFGS> optimizer(lbfgs, 8, -2.0, 2.0);
+  FunctionTest<RosenbrockFunction>(optimizer, 0.01, 0.001);
+}
+
+/**
+ * Run multi-start gradient descent on the Rosenbrock function.
+ */
+TEST_CASE("MultiStartGradientDescentRosenbrockTest", "[MultiStartTest]")
+{
+  GradientDescent gd(0.001, 0, 1e-15);
+  MultiStart<GradientDescent> optimizer(gd, 8, -2.0, 2.0);
+  FunctionTest<RosenbrockFunction>(optimizer, 0.01, 0.001);
+}
+
+/**
+ * Run multi-start L-BFGS on the Rosenbrock function with arma::fmat.
+ */
+TEST_CASE("MultiStartLBFGSRosenbrockFMatTest", "[MultiStartTest]")
+{
+  L_BFGS lbfgs;
+  MultiStart<L_BFGS> optimizer(lbfgs, 8, -2.0, 2.0);
+  FunctionTest<RosenbrockFunction, arma::fmat>(optimizer, 0.1, 0.01);
+}
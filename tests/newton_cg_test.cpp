@@ -0,0 +1,81 @@
+/**
+ * @file newton_cg_test.cpp
+ * @author Marcus Edel
+ *
+ * Test file for the trust-region Newton-CG optimizer.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+#include "test_function_tools.hpp"
+
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * A simple quadratic that provides the optional Hvp() method, so the
+ * optimizer uses exact Hessian-vector products instead of the
+ * finite-difference fallback.
+ */
+class QuadraticFunctionWithHvp
+{
+ public:
+  double Evaluate(const arma::mat& coordinates)
+  {
+    return arma::dot(coordinates, coordinates);
+  }
+
+  void Gradient(const arma::mat& coordinates, arma::mat& gradient)
+  {
+    gradient = 2 * coordinates;
+  }
+
+  void Hvp(const arma::mat& /* coordinates */,
+           const arma::mat& v,
+           arma::mat& out)
+  {
+    out = 2 * v;
+  }
+};
+
+/**
+ * Tests the trust-region Newton-CG optimizer using the Rosenbrock function;
+ * no Hvp() is available here, so the finite-difference fallback is used.
+ */
+TEST_CASE("NewtonCGRosenbrockFunctionTest", "[NewtonCGTest]")
+{
+  NewtonCG optimizer;
+  FunctionTest<RosenbrockFunction>(optimizer, 0.01, 0.001);
+}
+
+/**
+ * On a quadratic with an exact Hessian-vector product, Newton-CG should
+ * converge in a handful of outer iterations.
+ */
+TEST_CASE("NewtonCGExactHvpQuadraticTest", "[NewtonCGTest]")
+{
+  QuadraticFunctionWithHvp f;
+  NewtonCG optimizer(25);
+
+  arma::mat coordinates = arma::randu<arma::mat>(10, 1);
+  const double objective = optimizer.Optimize(f, coordinates);
+
+  REQUIRE(objective == Approx(0.0).margin(1e-8));
+  for (size_t j = 0; j < 10; ++j)
+    REQUIRE(coordinates(j) == Approx(0.0).margin(1e-4));
+}
+
+/**
+ * Tests the trust-region Newton-CG optimizer using an arma::fmat with the
+ * Rosenbrock function.
+ */
+TEST_CASE("NewtonCGRosenbrockFunctionFMatTest", "[NewtonCGTest]")
+{
+  NewtonCG optimizer;
+  FunctionTest<RosenbrockFunction, arma::fmat>(optimizer, 0.1, 0.01);
+}
@@ -0,0 +1,57 @@
+/**
+ * @file nonlinear_cg_test.cpp
+ * @author Marcus Edel
+ *
+ * Test file for the nonlinear conjugate gradient optimizer.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+#include "test_function_tools.hpp"
+
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * Tests the nonlinear CG optimizer using the Rosenbrock function.
+ */
+TEST_CASE("NonlinearCGRosenbrockFunctionTest", "[NonlinearCGTest]")
+{
+  NonlinearCG cg;
+  FunctionTest<RosenbrockFunction>(cg, 0.01, 0.001);
+}
+
+/**
+ * Tests the nonlinear CG optimizer on the higher-dimensional generalized
+ * Rosenbrock function, where the automatic restarts matter.
+ */
+TEST_CASE("NonlinearCGGeneralizedRosenbrockFunctionTest", "[NonlinearCGTest]")
+{
+  // Dimension of the problem.
+  GeneralizedRosenbrockFunction f(50);
+  NonlinearCG cg(100000);
+
+  arma::vec coordinates = f.GetInitialPoint();
+  cg.Optimize(f, coordinates);
+
+  const double finalValue = f.Evaluate(coordinates);
+
+  REQUIRE(finalValue == Approx(0.0).margin(1e-5));
+  for (size_t j = 0; j < 50; ++j)
+    REQUIRE(coordinates(j) == Approx(1.0).epsilon(1e-3));
+}
+
+/**
+ * Tests the nonlinear CG optimizer using an arma::fmat with the Rosenbrock
+ * function.
+ */
+TEST_CASE("NonlinearCGRosenbrockFunctionFMatTest", "[NonlinearCGTest]")
+{
+  NonlinearCG cg;
+  FunctionTest<RosenbrockFunction, arma::fmat>(cg, 0.1, 0.01);
+}
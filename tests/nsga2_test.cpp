@@ -483,3 +483,126 @@ TEST_CASE("NSGA2FrontTest", "[NSGA2Test]")
     CheckMatrices(paretoM, rcFront[i]);
   }
 }
+
+/**
+ * Optimize for the Schaffer N.1 function with the efficient non-dominated
+ * sort enabled; the produced fronts should match the default sort, so the
+ * result should be in the expected range just the same.
+ */
+TEST_CASE("NSGA2EfficientSortSchafferN1DoubleTest", "[NSGA2Test]")
+{
+  SchafferFunctionN1<arma::mat> SCH;
+  const double lowerBound = -1000;
+  const double upperBound = 1000;
+  const double expectedLowerBound = 0.0;
+  const double expectedUpperBound = 2.0;
+
+  NSGA2 opt(20, 300, 0.5, 0.5, 1e-3, 1e-6, lowerBound, upperBound);
+  opt.EfficientSort() = true;
+
+  typedef decltype(SCH.objectiveA) ObjectiveTypeA;
+  typedef decltype(SCH.objectiveB) ObjectiveTypeB;
+
+  // We allow a few trials in case of poor convergence.
+  bool success = false;
+  for (size_t trial = 0; trial < 3; ++trial)
+  {
+    arma::mat coords = SCH.GetInitialPoint();
+    std::tuple<ObjectiveTypeA, ObjectiveTypeB> objectives = SCH.GetObjectives();
+
+    opt.Optimize(objectives, coords);
+    arma::cube paretoSet = opt.ParetoSet();
+
+    bool allInRange = true;
+
+    for (size_t solutionIdx = 0; solutionIdx < paretoSet.n_slices; ++solutionIdx)
+    {
+      double val = arma::as_scalar(paretoSet.slice(solutionIdx));
+      if (!IsInBounds<double>(val, expectedLowerBound, expectedUpperBound))
+      {
+        allInRange = false;
+        break;
+      }
+    }
+
+    if (allInRange)
+    {
+      success = true;
+      break;
+    }
+  }
+
+  REQUIRE(success == true);
+}
+
+/**
+ * Optimize for the Schaffer N.1 function with duplicate caching enabled, and
+ * make sure that repeated genomes are served from the fingerprint table
+ * instead of being re-evaluated.
+ */
+TEST_CASE("NSGA2DuplicateCachingSchafferN1DoubleTest", "[NSGA2Test]")
+{
+  // Count every objective evaluation so the savings of the cache are
+  // observable; the objectives themselves are the Schaffer N.1 pair.
+  struct CountingObjectiveA
+  {
+    size_t* counter;
+    double Evaluate(const arma::mat& coords)
+    { ++(*counter); return std::pow(coords(0), 2); }
+  };
+  struct CountingObjectiveB
+  {
+    size_t* counter;
+    double Evaluate(const arma::mat& coords)
+    { ++(*counter); return std::pow(coords(0) - 2.0, 2); }
+  };
+
+  const size_t populationSize = 20;
+  const size_t maxGenerations = 300;
+  const double expectedLowerBound = 0.0;
+  const double expectedUpperBound = 2.0;
+
+  NSGA2 opt(populationSize, maxGenerations, 0.5, 0.5, 1e-3, 1e-6, -1000,
+      1000);
+  opt.DuplicateCaching() = true;
+
+  // We allow a few trials in case of poor convergence.
+  bool success = false;
+  for (size_t trial = 0; trial < 3; ++trial)
+  {
+    size_t evaluations = 0;
+    std::tuple<CountingObjectiveA, CountingObjectiveB> objectives =
+        std::make_tuple(CountingObjectiveA{ &evaluations },
+                        CountingObjectiveB{ &evaluations });
+
+    arma::mat coords = arma::randu<arma::mat>(1, 1);
+    opt.Optimize(objectives, coords);
+
+    // Without the cache, every generation scores populationSize members for
+    // both objectives.  The elite survivors reappear across generations, so
+    // the fingerprint table has to save part of that work.
+    REQUIRE(evaluations < 2 * populationSize * maxGenerations);
+
+    arma::cube paretoSet = opt.ParetoSet();
+
+    bool allInRange = true;
+    for (size_t solutionIdx = 0; solutionIdx < paretoSet.n_slices;
+         ++solutionIdx)
+    {
+      double val = arma::as_scalar(paretoSet.slice(solutionIdx));
+      if (!IsInBounds<double>(val, expectedLowerBound, expectedUpperBound))
+      {
+        allInRange = false;
+        break;
+      }
+    }
+
+    if (allInRange)
+    {
+      success = true;
+      break;
+    }
+  }
+
+  REQUIRE(success == true);
+}
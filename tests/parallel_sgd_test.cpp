@@ -50,6 +50,48 @@ TEST_CASE("SimpleParallelSGDTest", "[ParallelSGDTest]")
   }
 }
 
+/**
+ * Work stealing should still visit every datapoint in the iteration's work
+ * budget, so the result should match the statically-partitioned run.
+ */
+TEST_CASE("WorkStealingParallelSGDTest", "[ParallelSGDTest]")
+{
+  ConstantStep decayPolicy(0.4);
+
+  size_t threadsAvailable = omp_get_max_threads();
+
+  SparseTestFunction f;
+  for (size_t i = threadsAvailable; i > 0; --i)
+  {
+    omp_set_num_threads(i);
+
+    size_t batchSize = std::ceil((float) f.NumFunctions() / i);
+
+    ParallelSGD<ConstantStep> s(10000, batchSize, 1e-5, true, decayPolicy);
+    s.WorkStealing() = true;
+    s.StealChunkSize() = 1;
+    FunctionTest<SparseTestFunction>(s, 0.01, 0.001);
+  }
+}
+
+/**
+ * The asynchronous mode has no epoch-boundary barrier, but should still reach
+ * the optimum of the sparse test function.
+ */
+TEST_CASE("AsyncParallelSGDTest", "[ParallelSGDTest]")
+{
+  ConstantStep decayPolicy(0.4);
+
+  SparseTestFunction f;
+  size_t batchSize = std::ceil(
+      (float) f.NumFunctions() / omp_get_max_threads());
+
+  ParallelSGD<ConstantStep> s(10000, batchSize, 1e-7, true, decayPolicy);
+  s.Async() = true;
+  s.MaxStaleness() = 2;
+  FunctionTest<SparseTestFunction>(s, 0.01, 0.001);
+}
+
 /**
  * When run with a single thread, parallel SGD should be identical to normal
  * SGD.
@@ -149,3 +191,189 @@ TEST_CASE("ExponentialBackoffDecayTest", "[ParallelSGDTest]")
   // At the 211th iteration, stepsize should be changed
   REQUIRE(decayPolicy.StepSize(211) == 81);
 }
+
+/**
+ * The deterministic objective reduction must give exactly the same value on
+ * repeated evaluations at the same coordinates, and agree with the serial
+ * objective sum.
+ */
+TEST_CASE("DeterministicObjectiveTest", "[ParallelSGDTest]")
+{
+  arma::mat data, testData, shuffledData;
+  arma::Row<size_t> responses, testResponses, shuffledResponses;
+  LogisticRegressionTestData(data, testData, shuffledData,
+      responses, testResponses, shuffledResponses);
+  LogisticRegression<> lr(shuffledData, shuffledResponses, 0.5);
+
+  arma::mat coordinates(shuffledData.n_rows + 1, 1, arma::fill::randn);
+
+  const double first = DeterministicObjective(lr, coordinates);
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    // Bitwise reproducibility: the reduction shape is fixed, so repeated
+    // evaluations must match exactly.
+    REQUIRE(DeterministicObjective(lr, coordinates) == first);
+  }
+
+  // The reduction must also agree with the serial sum over all functions.
+  double serial = 0;
+  for (size_t i = 0; i < lr.NumFunctions(); ++i)
+    serial += lr.Evaluate(coordinates, i, 1);
+  REQUIRE(first == Approx(serial).epsilon(1e-10));
+}
+
+/**
+ * The shared parallel runtime must report at least one thread for a new
+ * region, honor a library-wide thread count override, and restore the
+ * default when the override is cleared.
+ */
+TEST_CASE("ParallelRuntimeThreadsTest", "[ParallelSGDTest]")
+{
+  ParallelRuntime& runtime = ParallelRuntime::Get();
+  const size_t defaultThreads = runtime.RegionThreads();
+  REQUIRE(defaultThreads >= 1);
+
+  runtime.NumThreads() = 1;
+  REQUIRE(runtime.RegionThreads() == 1);
+
+  runtime.NumThreads() = 0;
+  REQUIRE(runtime.RegionThreads() == defaultThreads);
+}
+
+/**
+ * With thread-local parameter replicas enabled, sparse updates are applied to
+ * socket-local buffers and merged on a cadence; the optimizer should still
+ * reach the optimum of the sparse test function.
+ */
+TEST_CASE("LocalReplicasParallelSGDTest", "[ParallelSGDTest]")
+{
+  ConstantStep decayPolicy(0.4);
+
+  SparseTestFunction f;
+  ParallelSGD<ConstantStep> s(10000, f.NumFunctions(), 1e-7, true,
+      decayPolicy);
+  s.LocalReplicas() = true;
+  s.MergeInterval() = 1;
+  FunctionTest<SparseTestFunction>(s, 0.01, 0.001);
+}
+
+/**
+ * Top-k sparsification holds back all but the largest pending updates each
+ * step, but error feedback keeps the held-back entries alive, so the
+ * optimizer should still reach the optimum of the sparse test function.
+ */
+TEST_CASE("TopKSparsificationParallelSGDTest", "[ParallelSGDTest]")
+{
+  ConstantStep decayPolicy(0.4);
+
+  SparseTestFunction f;
+  ParallelSGD<ConstantStep> s(10000, f.NumFunctions(), 1e-7, true,
+      decayPolicy);
+  s.TopK() = 1;
+  FunctionTest<SparseTestFunction>(s, 0.01, 0.001);
+}
+
+/**
+ * With elastic averaging, each thread optimizes a private iterate coupled to
+ * the shared center variable; the center should still reach the optimum of
+ * the sparse test function.
+ */
+TEST_CASE("ElasticAveragingParallelSGDTest", "[ParallelSGDTest]")
+{
+  ConstantStep decayPolicy(0.4);
+
+  SparseTestFunction f;
+  ParallelSGD<ConstantStep> s(10000, f.NumFunctions(), 1e-7, true,
+      decayPolicy);
+  s.ElasticAveraging() = true;
+  s.ElasticAlpha() = 0.5;
+  s.MergeInterval() = 1;
+  FunctionTest<SparseTestFunction>(s, 0.01, 0.001);
+}
+
+/**
+ * The staleness backoff policy should leave fresh updates untouched and
+ * scale stale updates down by 1 / (1 + staleness / halfLife).
+ */
+TEST_CASE("StalenessBackoffDecayTest", "[ParallelSGDTest]")
+{
+  StalenessBackoff decayPolicy(0.4, 100.0);
+
+  // Without staleness information the policy is a constant step.
+  REQUIRE(decayPolicy.StepSize(1) == Approx(0.4));
+  REQUIRE(decayPolicy.StepSize(500) == Approx(0.4));
+
+  // A fresh update takes the full step.
+  REQUIRE(decayPolicy.StepSize(1, 0) == Approx(0.4));
+  // An update at the half-life takes half the step.
+  REQUIRE(decayPolicy.StepSize(1, 100) == Approx(0.2));
+  // And three half-lives give a quarter of the step.
+  REQUIRE(decayPolicy.StepSize(1, 300) == Approx(0.1));
+}
+
+#ifdef ENS_USE_OPENMP
+
+/**
+ * Asynchronous parallel SGD with the staleness backoff policy should still
+ * reach the optimum of the sparse test function.
+ */
+TEST_CASE("AsyncStalenessBackoffParallelSGDTest", "[ParallelSGDTest]")
+{
+  StalenessBackoff decayPolicy(0.4, 10.0 * SparseTestFunction().NumFunctions());
+
+  SparseTestFunction f;
+  size_t batchSize = std::ceil(
+      (float) f.NumFunctions() / omp_get_max_threads());
+
+  ParallelSGD<StalenessBackoff> s(10000, batchSize, 1e-7, true, decayPolicy);
+  s.Async() = true;
+  s.MaxStaleness() = 2;
+  FunctionTest<SparseTestFunction>(s, 0.01, 0.001);
+}
+
+/**
+ * Striped-lock updates must reach the optimum of the sparse test function at
+ * every thread count, including a stripe count smaller than the parameter
+ * count (so samples really do contend for stripes).
+ */
+TEST_CASE("StripedLocksParallelSGDTest", "[ParallelSGDTest]")
+{
+  ConstantStep decayPolicy(0.4);
+
+  size_t threadsAvailable = omp_get_max_threads();
+
+  SparseTestFunction f;
+  for (size_t i = threadsAvailable; i > 0; --i)
+  {
+    omp_set_num_threads(i);
+
+    size_t batchSize = std::ceil((float) f.NumFunctions() / i);
+
+    ParallelSGD<ConstantStep> s(10000, batchSize, 1e-5, true, decayPolicy);
+    s.StripedLocks() = true;
+    s.NumStripes() = 2;
+    FunctionTest<SparseTestFunction>(s, 0.01, 0.001);
+  }
+}
+
+/**
+ * The autotuner must not break correctness: whatever schedule the
+ * calibration probes lock in, the optimizer still has to reach the optimum
+ * of the sparse test function.  The calibration probes perform real update
+ * steps, so they only help convergence.
+ */
+TEST_CASE("AutotuneParallelSGDTest", "[ParallelSGDTest]")
+{
+  ConstantStep decayPolicy(0.4);
+
+  SparseTestFunction f;
+  size_t batchSize = std::ceil(
+      (float) f.NumFunctions() / omp_get_max_threads());
+
+  ParallelSGD<ConstantStep> s(10000, batchSize, 1e-5, true, decayPolicy);
+  s.Autotune() = true;
+  s.AutotuneInterval() = 100;
+  FunctionTest<SparseTestFunction>(s, 0.01, 0.001);
+}
+
+#endif
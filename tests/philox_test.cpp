@@ -0,0 +1,94 @@
+/**
+ * @file philox_test.cpp
+ * @author Marcus Edel
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+#include "test_function_tools.hpp"
+
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * Two generators with the same seed must produce the same sequence, and
+ * reseeding must restart it.
+ */
+TEST_CASE("PhiloxDeterminismTest", "[PhiloxTest]")
+{
+  PhiloxGenerator genA(1337);
+  PhiloxGenerator genB(1337);
+  for (size_t i = 0; i < 1000; ++i)
+    REQUIRE(genA() == genB());
+
+  const uint32_t first = PhiloxGenerator(1337)();
+  genA.Seed(1337);
+  REQUIRE(genA() == first);
+}
+
+/**
+ * Different streams of the same seed must produce different sequences.
+ */
+TEST_CASE("PhiloxStreamIndependenceTest", "[PhiloxTest]")
+{
+  PhiloxGenerator genA(1337);
+  PhiloxGenerator genB = genA.WithStream(1);
+
+  size_t matches = 0;
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    if (genA() == genB())
+      matches++;
+  }
+  REQUIRE(matches < 5);
+}
+
+/**
+ * The uniform and Gaussian draws must have roughly the right moments.
+ */
+TEST_CASE("PhiloxMomentsTest", "[PhiloxTest]")
+{
+  PhiloxGenerator gen(42);
+
+  arma::vec uniform(100000);
+  gen.Randu(uniform);
+  REQUIRE(arma::mean(uniform) == Approx(0.5).epsilon(0.01));
+  REQUIRE(uniform.min() >= 0.0);
+  REQUIRE(uniform.max() < 1.0);
+
+  arma::vec gaussian(100000);
+  gen.Randn(gaussian);
+  REQUIRE(arma::mean(gaussian) == Approx(0.0).margin(0.02));
+  REQUIRE(arma::stddev(gaussian) == Approx(1.0).epsilon(0.02));
+
+  arma::vec counts(7, arma::fill::zeros);
+  for (size_t i = 0; i < 70000; ++i)
+    counts(gen.RandInt(7))++;
+  REQUIRE(counts.min() > 9000);
+  REQUIRE(counts.max() < 11000);
+}
+
+/**
+ * A seeded optimizer must produce bitwise identical runs.
+ */
+TEST_CASE("PhiloxReproducibleSPSATest", "[PhiloxTest]")
+{
+  SphereFunction f(2);
+
+  SPSA optimizerA(0.1, 0.102, 0.16, 0.3, 1000, 0);
+  optimizerA.Generator().Seed(1337);
+  arma::mat coordinatesA = arma::ones<arma::mat>(2, 1);
+  optimizerA.Optimize(f, coordinatesA);
+
+  SPSA optimizerB(0.1, 0.102, 0.16, 0.3, 1000, 0);
+  optimizerB.Generator().Seed(1337);
+  arma::mat coordinatesB = arma::ones<arma::mat>(2, 1);
+  optimizerB.Optimize(f, coordinatesB);
+
+  REQUIRE(arma::approx_equal(coordinatesA, coordinatesB, "absdiff", 0.0));
+}
@@ -82,3 +82,54 @@ TEST_CASE("ProjectToL0", "[ProximalTest]")
     REQUIRE(distanceNew >= distance);
   }
 }
+
+/**
+ * The batched dual-norm computation of GroupLpBall must agree with the
+ * per-group DualNorm() values, and the structure group solver must pick the
+ * group with the largest dual norm.
+ */
+TEST_CASE("GroupDualNorms", "[ProximalTest]")
+{
+  int D = 50;       // Dimension of the problem.
+  size_t G = 10;    // Number of (disjoint) groups.
+
+  // Split the support evenly into consecutive groups of 5 indices.
+  std::vector<uvec> groupIndicesList;
+  for (size_t g = 0; g < G; g++)
+    groupIndicesList.push_back(linspace<uvec>(5 * g, 5 * g + 4, 5));
+
+  mat v = randn<mat>(D, 1);
+
+  for (double p : { 1.0, 2.0, 3.0,
+      std::numeric_limits<double>::infinity() })
+  {
+    GroupLpBall groupBall(p, D, groupIndicesList);
+
+    vec norms;
+    groupBall.DualNorms(v, norms);
+    REQUIRE(norms.n_elem == G);
+
+    for (size_t g = 0; g < G; g++)
+    {
+      mat y;
+      groupBall.ProjectToGroup(v, g + 1, y);
+      REQUIRE(norms(g) ==
+          Approx(groupBall.DualNorm(y, (int) (g + 1))).margin(1e-10));
+    }
+
+    // The solver must return an atom supported on the group with the
+    // largest dual norm.
+    ConstrStructGroupSolver<GroupLpBall> solver(groupBall);
+    mat s;
+    solver.Optimize(v, s);
+
+    uword bestGroup = 0;
+    norms.max(bestGroup);
+    uvec support = find(abs(s) > 0);
+    for (size_t i = 0; i < support.n_elem; i++)
+    {
+      REQUIRE(support(i) >= 5 * bestGroup);
+      REQUIRE(support(i) <= 5 * bestGroup + 4);
+    }
+  }
+}
@@ -392,3 +392,223 @@ TEST_CASE("LBestPSOScafferFunctionN4Test", "[PSOTest]")
   REQUIRE(abs(coordinates(1)) == Approx(1.25313).margin(0.1));
 }
 */
+
+/**
+ * Test the PSO optimizer on the Sphere Function with parallel swarm
+ * evaluation enabled.
+ */
+TEST_CASE("LBestPSOParallelEvaluationSphereFunctionTest", "[PSOTest]")
+{
+  SphereFunction f(4);
+  LBestPSO s;
+  s.ParallelEvaluation() = true;
+
+  arma::mat coords = f.GetInitialPoint<arma::mat>();
+  if (!s.Optimize(f, coords))
+    FAIL("LBest PSO optimization reported failure for Sphere Function.");
+
+  double finalValue = f.Evaluate(coords);
+  REQUIRE(finalValue <= 1e-5);
+  for (size_t j = 0; j < 4; ++j)
+    REQUIRE(coords(j) <= 1e-3);
+}
+
+/**
+ * Drive PSO through the ask/tell interface on a simple quadratic and make
+ * sure it converges to the minimum.
+ */
+TEST_CASE("LBestPSOAskTellTest", "[PSOTest]")
+{
+  LBestPSO s;
+
+  arma::mat iterate(4, 1, arma::fill::ones);
+  s.Initialize(iterate);
+
+  double bestFitness = std::numeric_limits<double>::max();
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    const arma::mat positions = s.Ask<arma::mat>();
+    arma::mat objectives(positions.n_cols, 1);
+    for (size_t j = 0; j < positions.n_cols; ++j)
+      objectives(j) = arma::accu(arma::square(positions.col(j)));
+
+    bestFitness = s.Tell(objectives);
+  }
+
+  const arma::mat best = s.Best<arma::mat>();
+  REQUIRE(best.n_rows == 4);
+  REQUIRE(best.n_cols == 1);
+  REQUIRE(bestFitness <= 1e-5);
+  for (size_t j = 0; j < 4; ++j)
+    REQUIRE(best(j) <= 1e-3);
+}
+
+/**
+ * Test the PSO optimizer with quasi-random swarm initialization on the
+ * Sphere Function.
+ */
+TEST_CASE("LBestPSOQuasiRandomInitSphereFunctionTest", "[PSOTest]")
+{
+  SphereFunction f(4);
+  PSOType<LBestUpdate, QuasiRandomInit> s;
+
+  arma::mat coords = f.GetInitialPoint<arma::mat>();
+  if (!s.Optimize(f, coords))
+    FAIL("LBest PSO optimization reported failure for Sphere Function.");
+
+  double finalValue = f.Evaluate(coords);
+  REQUIRE(finalValue <= 1e-5);
+  for (size_t j = 0; j < 4; ++j)
+    REQUIRE(coords(j) <= 1e-3);
+}
+
+/**
+ * Test the PSO optimizer with a von Neumann neighborhood topology on the
+ * Sphere Function.
+ */
+TEST_CASE("LBestPSOVonNeumannTopologyTest", "[PSOTest]")
+{
+  SphereFunction f(4);
+  LBestPSO s(64, arma::ones(1, 1), arma::ones(1, 1), 3000, 350, 1e-10, 2.05,
+      2.05, LBestUpdate::VonNeumann(8, 8));
+
+  arma::mat coords = f.GetInitialPoint<arma::mat>();
+  if (!s.Optimize(f, coords))
+    FAIL("LBest PSO optimization reported failure for Sphere Function.");
+
+  double finalValue = f.Evaluate(coords);
+  REQUIRE(finalValue <= 1e-5);
+  for (size_t j = 0; j < 4; ++j)
+    REQUIRE(coords(j) <= 1e-3);
+}
+
+/**
+ * Test the PSO optimizer with a random 4-regular neighborhood topology on
+ * the Sphere Function, and check the shape of the generated adjacency.
+ */
+TEST_CASE("LBestPSORandomRegularTopologyTest", "[PSOTest]")
+{
+  const LBestUpdate topology = LBestUpdate::RandomRegular(64, 4, 42);
+  REQUIRE(topology.NeighborOffsets().n_elem == 65);
+  REQUIRE(topology.NeighborIndices().n_elem == 64 * 4);
+  for (size_t i = 0; i < 64; ++i)
+  {
+    for (size_t j = topology.NeighborOffsets()(i);
+        j < topology.NeighborOffsets()(i + 1); ++j)
+      REQUIRE(topology.NeighborIndices()(j) != i);
+  }
+
+  SphereFunction f(4);
+  LBestPSO s(64, arma::ones(1, 1), arma::ones(1, 1), 3000, 350, 1e-10, 2.05,
+      2.05, topology);
+
+  arma::mat coords = f.GetInitialPoint<arma::mat>();
+  if (!s.Optimize(f, coords))
+    FAIL("LBest PSO optimization reported failure for Sphere Function.");
+
+  double finalValue = f.Evaluate(coords);
+  REQUIRE(finalValue <= 1e-5);
+  for (size_t j = 0; j < 4; ++j)
+    REQUIRE(coords(j) <= 1e-3);
+}
+
+/**
+ * With adaptive shrinking enabled the swarm must retire particles as it
+ * concentrates, spending strictly fewer objective evaluations than a
+ * fixed-size swarm over the same iteration budget while still reaching the
+ * optimum of the sphere function.
+ */
+TEST_CASE("LBestPSOAdaptiveShrinkingTest", "[PSOTest]")
+{
+  // Behaves like the sphere function, but counts evaluations.
+  struct CountingSphere
+  {
+    size_t evaluations = 0;
+    double Evaluate(const arma::mat& x)
+    {
+      ++evaluations;
+      return arma::accu(arma::square(x));
+    }
+  };
+
+  const size_t numParticles = 64;
+  const size_t maxIterations = 1000;
+  const size_t horizonSize = 350;
+
+  CountingSphere f;
+  // The negative improvement tolerance disables horizon termination, so the
+  // run spans the full iteration budget and the evaluation count without
+  // shrinking is exactly (maxIterations + 1) * numParticles.
+  LBestPSO s(numParticles, -5.0, 5.0, maxIterations, horizonSize, -1.0);
+  s.AdaptiveShrinking() = true;
+
+  arma::mat coords = arma::ones(4, 1);
+  const double result = s.Optimize(f, coords);
+
+  REQUIRE(result <= 1e-3);
+  REQUIRE(f.evaluations < (maxIterations + 1) * numParticles);
+  // The configured swarm size is untouched for the next run.
+  REQUIRE(s.NumParticles() == numParticles);
+}
+
+/**
+ * With stagnation detection enabled, PSO must stop once the best fitness
+ * stops improving, even during the warm-up iterations in which the
+ * improvement horizon cannot yet fire.
+ */
+TEST_CASE("LBestPSOStagnationEarlyTerminationTest", "[PSOTest]")
+{
+  // Behaves like the sphere function, but counts evaluations.
+  struct CountingSphere
+  {
+    size_t evaluations = 0;
+    double Evaluate(const arma::mat& x)
+    {
+      ++evaluations;
+      return arma::accu(arma::square(x));
+    }
+  };
+
+  const size_t numParticles = 64;
+  const size_t maxIterations = 1000;
+  const size_t horizonSize = 350;
+
+  // The negative improvement tolerance disables horizon termination, so
+  // only the stagnation detector can end the run early.
+  CountingSphere f;
+  LBestPSO s(numParticles, -5.0, 5.0, maxIterations, horizonSize, -1.0);
+  s.Stagnation().Patience() = 30;
+  s.Stagnation().MinImprovement() = 1e-8;
+
+  arma::mat coords = arma::ones(4, 1);
+  const double result = s.Optimize(f, coords);
+
+  REQUIRE(result <= 1e-3);
+  REQUIRE(f.evaluations < (maxIterations + 1) * numParticles);
+}
+
+/**
+ * Make sure a warm-started PSO run resumes from the retained swarm and
+ * stays converged on the Sphere function, and that the retained swarm is
+ * exposed for export.
+ */
+TEST_CASE("LBestPSOWarmStartTest", "[PSOTest]")
+{
+  SphereFunction f(4);
+  LBestPSO s;
+  s.WarmStart() = true;
+
+  arma::mat coords = f.GetInitialPoint<arma::mat>();
+  s.Optimize(f, coords);
+
+  // The retained swarm is exposed for export.
+  REQUIRE(s.SwarmPositions<double>().n_slices == s.NumParticles());
+  REQUIRE(s.SwarmVelocities<double>().n_slices == s.NumParticles());
+
+  // The second run resumes from the converged swarm; a minimal budget
+  // suffices to stay converged.
+  s.MaxIterations() = s.HorizonSize();
+  arma::mat coords2 = f.GetInitialPoint<arma::mat>();
+  s.Optimize(f, coords2);
+  REQUIRE(f.Evaluate(coords2) <= 1e-5);
+}
@@ -49,3 +49,14 @@ TEST_CASE("RMSPropLogisticRegressionSpMatTest", "[rmsprop]")
 }
 
 #endif
+
+/**
+ * Run RMSProp with single-precision state storage on logistic regression and
+ * make sure the results are acceptable.
+ */
+TEST_CASE("RMSPropMixedPrecisionLogisticRegressionTest", "[rmsprop]")
+{
+  RMSProp optimizer;
+  optimizer.MixedPrecision() = true;
+  LogisticRegressionFunctionTest(optimizer, 0.003, 0.006);
+}
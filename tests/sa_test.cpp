@@ -78,3 +78,74 @@ TEST_CASE("RastrigrinFunctionTest", "[SATest]")
   SA<> sa(schedule, 2000000, 100, 50, 1000, 1e-12, 2, 2.0, 0.5, 0.1);
   FunctionTest<RastriginFunction>(sa, 0.01, 0.001, 4);
 }
+
+// The Rosenbrock function, optimized with a batch of trial moves per step
+// (multiple-try Metropolis).
+TEST_CASE("SABatchedProposalRosenbrockTest", "[SATest]")
+{
+  ExponentialSchedule schedule;
+  // The convergence is very sensitive to the choices of maxMove and initMove.
+  SA<> sa(schedule, 1000000, 1000., 1000, 100, 1e-11, 3, 1.5, 0.3, 0.3);
+  sa.ProposalBatchSize() = 4;
+  FunctionTest<RosenbrockFunction>(sa, 0.01, 0.001);
+}
+
+/**
+ * Replica-exchange (parallel tempering) mode should still reach the optimum
+ * of the Rosenbrock function; the cold chain carries the result.
+ */
+TEST_CASE("SAReplicaExchangeRosenbrockTest", "[SATest]")
+{
+  ExponentialSchedule schedule;
+  // The convergence is very sensitive to the choices of maxMove and initMove.
+  SA<> sa(schedule, 1000000, 1000., 1000, 100, 1e-11, 3, 1.5, 0.3, 0.3);
+  sa.NumReplicas() = 4;
+  sa.ExchangeInterval() = 100;
+  FunctionTest<RosenbrockFunction>(sa, 0.01, 0.001);
+}
+
+/**
+ * A sphere objective with the fidelity-parameterized Evaluate() form: the
+ * partial sum over the first `fidelity` dimensions is a lower bound on the
+ * objective, so screening with it can only reject moves the exact
+ * evaluation would have rejected too.
+ */
+struct FidelityScreenedSphere
+{
+  size_t screeningCalls = 0;
+
+  double Evaluate(const arma::mat& coordinates)
+  {
+    return arma::accu(arma::square(coordinates));
+  }
+
+  double Evaluate(const arma::mat& coordinates, const size_t fidelity)
+  {
+    ++screeningCalls;
+
+    const size_t used = std::min((size_t) coordinates.n_elem, fidelity);
+    double sum = 0.0;
+    for (size_t i = 0; i < used; ++i)
+      sum += coordinates(i) * coordinates(i);
+    return sum;
+  }
+};
+
+/**
+ * With a screening fidelity set, SA scores every proposal cheaply first and
+ * only spends exact evaluations on the survivors; the optimization still
+ * converges on the sphere function.
+ */
+TEST_CASE("SAScreeningFidelityTest", "[SATest]")
+{
+  ExponentialSchedule schedule;
+  SA<> sa(schedule, 1000000, 1000., 1000, 100, 1e-11, 3, 1.5, 0.3, 0.3);
+  sa.ScreeningFidelity() = 10;
+
+  FidelityScreenedSphere f;
+  arma::mat coordinates = arma::ones<arma::mat>(50, 1);
+  const double result = sa.Optimize(f, coordinates);
+
+  REQUIRE(f.screeningCalls > 0);
+  REQUIRE(result == Approx(0.0).margin(0.1));
+}
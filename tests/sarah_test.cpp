@@ -104,3 +104,42 @@ TEST_CASE("SARAHPlusLogisticRegressionSpMatTest","[SARAHTest]")
 }
 
 #endif
+
+/**
+ * Run SARAH with the parallel full-gradient snapshot on logistic regression
+ * and make sure the results are acceptable.
+ */
+TEST_CASE("SARAHParallelFullGradientLogisticRegressionTest", "[SARAHTest]")
+{
+  SARAH optimizer(0.01, 35, 250, 0, 1e-5, true);
+  optimizer.ParallelFullGradient() = true;
+  LogisticRegressionFunctionTest(optimizer, 0.015, 0.015);
+}
+
+/**
+ * Run SARAH with Barzilai-Borwein step sizes on logistic regression and make
+ * sure the results are acceptable.
+ */
+TEST_CASE("SARAHBBLogisticRegressionTest", "[SARAHTest]")
+{
+  // Run SARAH_BB with a couple of batch sizes.
+  for (size_t batchSize = 35; batchSize < 45; batchSize += 5)
+  {
+    SARAH_BB optimizer(0.01, batchSize, 250, 0, 1e-5, true);
+    LogisticRegressionFunctionTest(optimizer, 0.015, 0.015);
+  }
+}
+
+/**
+ * Run SARAH+ with Barzilai-Borwein step sizes on logistic regression and make
+ * sure the results are acceptable.
+ */
+TEST_CASE("SARAHPlusBBLogisticRegressionTest", "[SARAHTest]")
+{
+  // Run SARAH_Plus_BB with a couple of batch sizes.
+  for (size_t batchSize = 35; batchSize < 45; batchSize += 5)
+  {
+    SARAH_Plus_BB optimizer(0.01, batchSize, 250, 0, 1e-5, true);
+    LogisticRegressionFunctionTest(optimizer, 0.015, 0.015);
+  }
+}
@@ -585,3 +585,123 @@ TEST_CASE("CorrelationCoeffToySdp","[SdpPrimalDualTest]")
   REQUIRE(success == true);
   REQUIRE(obj == Approx(2 * (-0.978)).epsilon(1e-5));
 }
+
+TEST_CASE("MixedPrecisionSmallLovaszThetaSdp", "[SdpPrimalDualTest]")
+{
+  // Run the same Lovasz-Theta SDP with the Schur complement solves done in
+  // float32 plus iterative refinement; the final KKT conditions must still
+  // hold to full precision.
+  UndirectedGraph g;
+  UndirectedGraph::LoadFromEdges(g, "data/johnson8-4-4.csv", true);
+  auto sdp = ConstructLovaszThetaSDPFromGraph(g);
+
+  PrimalDualSolver solver;
+  solver.MixedPrecision() = true;
+
+  arma::mat X, Z, ysparse, ydense;
+  sdp.GetInitialPoints(X, ysparse, ydense, Z);
+  solver.Optimize(sdp, X, ysparse, ydense, Z);
+  const bool success = CheckKKT(sdp, X, ysparse, ydense, Z);
+  REQUIRE(success == true);
+}
+
+/**
+ * Structure analysis must detect the two independent blocks of a
+ * block-diagonal max cut SDP, split it losslessly, and recombine the block
+ * solutions into a full-size solution with the same objective value as
+ * solving the original cone.
+ */
+TEST_CASE("SDPStructureBlockSplitTest", "[SdpPrimalDualTest]")
+{
+  // A triangle on vertices {0, 1, 2} and a single edge {3, 4}.
+  arma::mat laplacian(5, 5, arma::fill::zeros);
+  const size_t edges[4][2] = { { 0, 1 }, { 1, 2 }, { 0, 2 }, { 3, 4 } };
+  for (size_t i = 0; i < 4; ++i)
+  {
+    laplacian(edges[i][0], edges[i][1]) = -1.0;
+    laplacian(edges[i][1], edges[i][0]) = -1.0;
+    laplacian(edges[i][0], edges[i][0]) += 1.0;
+    laplacian(edges[i][1], edges[i][1]) += 1.0;
+  }
+
+  SDP<arma::sp_mat> sdp(5, 5, 0);
+  sdp.C() = -arma::sp_mat(laplacian);
+  for (size_t i = 0; i < 5; i++)
+  {
+    sdp.SparseA()[i].zeros(5, 5);
+    sdp.SparseA()[i](i, i) = 1.;
+  }
+  sdp.SparseB().ones();
+
+  SDPStructure<SDP<arma::sp_mat>> structure(sdp);
+  REQUIRE(structure.NumBlocks() == 2);
+  REQUIRE(structure.Decomposable() == true);
+  REQUIRE(structure.Blocks()[0].n_elem == 3);
+  REQUIRE(structure.Blocks()[1].n_elem == 2);
+
+  std::vector<SDP<arma::sp_mat>> blockSdps = structure.Split();
+  REQUIRE(blockSdps.size() == 2);
+  REQUIRE(blockSdps[0].N() == 3);
+  REQUIRE(blockSdps[0].NumSparseConstraints() == 3);
+  REQUIRE(blockSdps[1].N() == 2);
+  REQUIRE(blockSdps[1].NumSparseConstraints() == 2);
+
+  // Solve the original cone.
+  arma::mat X, Z;
+  arma::mat ysparse, ydense;
+  ydense.set_size(0);
+  X = arma::eye<arma::mat>(sdp.N(), sdp.N());
+  ysparse = arma::randu<arma::vec>(sdp.NumSparseConstraints());
+  Z.eye(sdp.N(), sdp.N());
+  PrimalDualSolver solver;
+  solver.Optimize(sdp, X, ysparse, ydense, Z);
+  const double fullObjective = arma::accu(arma::mat(sdp.C()) % X);
+
+  // Solve the blocks separately and recombine.
+  std::vector<arma::mat> blockX(2);
+  for (size_t b = 0; b < 2; ++b)
+  {
+    arma::mat Xb, Zb;
+    arma::mat ysparseb, ydenseb;
+    ydenseb.set_size(0);
+    Xb = arma::eye<arma::mat>(blockSdps[b].N(), blockSdps[b].N());
+    ysparseb = arma::randu<arma::vec>(blockSdps[b].NumSparseConstraints());
+    Zb.eye(blockSdps[b].N(), blockSdps[b].N());
+    PrimalDualSolver blockSolver;
+    blockSolver.Optimize(blockSdps[b], Xb, ysparseb, ydenseb, Zb);
+    blockX[b] = Xb;
+  }
+
+  arma::mat recombined;
+  structure.Recombine(blockX, recombined);
+  REQUIRE(recombined.n_rows == 5);
+  const double blockObjective =
+      arma::accu(arma::mat(sdp.C()) % recombined);
+
+  REQUIRE(blockObjective == Approx(fullObjective).margin(1e-5));
+}
+
+/**
+ * Chordality detection on the aggregate sparsity graph: a 4-cycle is the
+ * smallest non-chordal graph, and adding one chord makes it chordal.
+ */
+TEST_CASE("SDPStructureChordalityTest", "[SdpPrimalDualTest]")
+{
+  SDP<arma::sp_mat> cycle(4, 0, 0);
+  cycle.C()(0, 1) = cycle.C()(1, 0) = 1.0;
+  cycle.C()(1, 2) = cycle.C()(2, 1) = 1.0;
+  cycle.C()(2, 3) = cycle.C()(3, 2) = 1.0;
+  cycle.C()(3, 0) = cycle.C()(0, 3) = 1.0;
+
+  SDPStructure<SDP<arma::sp_mat>> cycleStructure(cycle);
+  REQUIRE(cycleStructure.NumBlocks() == 1);
+  REQUIRE(cycleStructure.IsChordal() == false);
+
+  SDP<arma::sp_mat> chorded(4, 0, 0);
+  chorded.C() = cycle.C();
+  chorded.C()(0, 2) = chorded.C()(2, 0) = 1.0;
+
+  SDPStructure<SDP<arma::sp_mat>> chordedStructure(chorded);
+  REQUIRE(chordedStructure.NumBlocks() == 1);
+  REQUIRE(chordedStructure.IsChordal() == true);
+}
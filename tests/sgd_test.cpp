@@ -74,3 +74,527 @@ TEST_CASE("GeneralizedRosenbrockTestFloat", "[SGDTest]")
     }
   }
 }
+
+TEST_CASE("SGDAccumulationStepsTest", "[SGDTest]")
+{
+  // Make sure macro-batch mode (several mini-batches per update step) still
+  // converges on a simple problem.
+  SphereFunction f(4);
+
+  StandardSGD s(0.01, 8, 50000, 1e-9, true);
+  s.AccumulationSteps() = 4;
+
+  arma::mat coordinates = f.GetInitialPoint();
+  const double result = s.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(1e-4));
+  for (size_t j = 0; j < 4; ++j)
+    REQUIRE(coordinates(j) == Approx(0.0).margin(1e-3));
+}
+
+TEST_CASE("SGDStrideVisitationTest", "[SGDTest]")
+{
+  // The stride visitation policy should converge without ever calling
+  // Shuffle() on the function.
+  SphereFunction f(4);
+
+  SGD<VanillaUpdate, NoDecay, StrideVisitation> s(0.01, 2, 50000, 1e-9, true);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  const double result = s.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(1e-4));
+  for (size_t j = 0; j < 4; ++j)
+    REQUIRE(coordinates(j) == Approx(0.0).margin(1e-3));
+}
+
+TEST_CASE("SGDWorkspaceReuseTest", "[SGDTest]")
+{
+  // Repeated Optimize() calls on the same optimizer object reuse the internal
+  // workspace buffers; make sure results stay correct across calls.
+  SphereFunction f(4);
+  StandardSGD s(0.01, 4, 50000, 1e-9, true);
+
+  for (size_t trial = 0; trial < 3; ++trial)
+  {
+    arma::mat coordinates = f.GetInitialPoint();
+    const double result = s.Optimize(f, coordinates);
+
+    REQUIRE(result == Approx(0.0).margin(1e-4));
+  }
+}
+
+/**
+ * Run SGD with a sparse gradient type on the sparse test function; the
+ * vanilla update should only touch the nonzero coordinates.
+ */
+TEST_CASE("SGDSparseGradientTest", "[SGDTest]")
+{
+  SparseTestFunction f;
+  StandardSGD s(0.0025, 1, 500000, 1e-9, true);
+
+  arma::mat coordinates = f.GetInitialPoint<arma::mat>();
+  s.Optimize<SparseTestFunction, arma::mat, arma::sp_mat>(f, coordinates);
+
+  REQUIRE(coordinates(0) == Approx(2.0).epsilon(0.003));
+  REQUIRE(coordinates(1) == Approx(1.0).epsilon(0.003));
+  REQUIRE(coordinates(2) == Approx(1.5).epsilon(0.003));
+  REQUIRE(coordinates(3) == Approx(4.0).epsilon(0.003));
+}
+
+/**
+ * Run SGD with the norm-clipping update wrapper; with a maximum norm large
+ * enough to never trigger, the result should match plain SGD, and with a
+ * tight maximum norm the optimizer should still converge on the sphere
+ * function.
+ */
+TEST_CASE("SGDGradientNormClippingTest", "[SGDTest]")
+{
+  SphereFunction f(4);
+
+  VanillaUpdate vanillaUpdate;
+  GradientNormClipping<VanillaUpdate> normClipping(0.1, vanillaUpdate);
+  SGD<GradientNormClipping<VanillaUpdate>> s(0.01, 4, 100000, 1e-9, true,
+      normClipping);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  const double result = s.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(1e-4));
+  for (size_t j = 0; j < 4; ++j)
+    REQUIRE(coordinates(j) == Approx(0.0).margin(1e-3));
+}
+
+/**
+ * Drive SGD through the externally-owned Step() loop instead of Optimize():
+ * one update per "arriving event", with the batch schedule chosen by the
+ * caller.  The result should match a regular optimization run.
+ */
+TEST_CASE("SGDStreamingStepTest", "[SGDTest]")
+{
+  arma::mat data, testData, shuffledData;
+  arma::Row<size_t> responses, testResponses, shuffledResponses;
+  LogisticRegressionTestData(data, testData, shuffledData, responses,
+      testResponses, shuffledResponses);
+  LogisticRegression<> lr(shuffledData, shuffledResponses, 0.5);
+
+  StandardSGD s(0.0005, 32);
+  arma::mat coordinates = lr.GetInitialPoint();
+  s.Initialize(lr, coordinates);
+
+  const size_t numFunctions = lr.NumFunctions();
+  for (size_t event = 0; event < 20000; ++event)
+  {
+    const size_t begin = (event * 32) % numFunctions;
+    s.Step(lr, coordinates, begin,
+        std::min<size_t>(32, numFunctions - begin));
+  }
+
+  const double acc = lr.ComputeAccuracy(data, responses, coordinates);
+  const double testAcc = lr.ComputeAccuracy(testData, testResponses,
+      coordinates);
+  REQUIRE(acc == Approx(100.0).epsilon(0.003));
+  REQUIRE(testAcc == Approx(100.0).epsilon(0.006));
+}
+
+/**
+ * The update-policy state (here the momentum buffer) must persist between
+ * Step() calls; otherwise MomentumSGD degenerates to plain SGD and this
+ * budget does not converge.
+ */
+TEST_CASE("MomentumSGDStreamingStepTest", "[SGDTest]")
+{
+  arma::mat data, testData, shuffledData;
+  arma::Row<size_t> responses, testResponses, shuffledResponses;
+  LogisticRegressionTestData(data, testData, shuffledData, responses,
+      testResponses, shuffledResponses);
+  LogisticRegression<> lr(shuffledData, shuffledResponses, 0.5);
+
+  MomentumSGD s(0.0005, 32, 100000, 1e-5, true, MomentumUpdate(0.9));
+  arma::mat coordinates = lr.GetInitialPoint();
+  s.Initialize(lr, coordinates);
+
+  const size_t numFunctions = lr.NumFunctions();
+  for (size_t event = 0; event < 10000; ++event)
+  {
+    const size_t begin = (event * 32) % numFunctions;
+    s.Step(lr, coordinates, begin,
+        std::min<size_t>(32, numFunctions - begin));
+  }
+
+  const double acc = lr.ComputeAccuracy(data, responses, coordinates);
+  REQUIRE(acc == Approx(100.0).epsilon(0.003));
+}
+
+/**
+ * Optimize one column of a larger parameter block in place.  A single-column
+ * view is contiguous, so the optimizer works through a zero-copy alias and
+ * the neighbouring columns must come out untouched.
+ */
+TEST_CASE("SGDSubviewColumnOptimizeTest", "[SGDTest]")
+{
+  GeneralizedRosenbrockFunction f(10);
+
+  StandardSGD s(0.001, 1, 0, 1e-15, true);
+
+  arma::mat block = arma::zeros<arma::mat>(10, 3);
+  block.col(1) = f.GetInitialPoint();
+  const double result = s.Optimize(f, block.col(1));
+
+  REQUIRE(result == Approx(0.0).margin(1e-10));
+  for (size_t j = 0; j < 10; ++j)
+  {
+    REQUIRE(block(j, 1) == Approx(1.0).epsilon(1e-5));
+    REQUIRE(block(j, 0) == 0.0);
+    REQUIRE(block(j, 2) == 0.0);
+  }
+}
+
+//! A sphere function whose gradient takes the shape of the iterate, so it
+//! can be optimized over a non-vector view.
+class ShapeAgnosticSphereFunction
+{
+ public:
+  ShapeAgnosticSphereFunction(const size_t n) : n(n) { }
+
+  size_t NumFunctions() const { return n; }
+
+  void Shuffle() { }
+
+  template<typename MatType>
+  typename MatType::elem_type Evaluate(const MatType& coordinates,
+                                       const size_t begin,
+                                       const size_t batchSize) const
+  {
+    typename MatType::elem_type objective = 0;
+    for (size_t j = begin; j < begin + batchSize; ++j)
+      objective += coordinates[j] * coordinates[j];
+    return objective;
+  }
+
+  template<typename MatType, typename GradType>
+  void Gradient(const MatType& coordinates,
+                const size_t begin,
+                GradType& gradient,
+                const size_t batchSize) const
+  {
+    gradient.zeros(coordinates.n_rows, coordinates.n_cols);
+    for (size_t j = begin; j < begin + batchSize; ++j)
+      gradient[j] = 2 * coordinates[j];
+  }
+
+ private:
+  size_t n;
+};
+
+/**
+ * Optimize an interior block of a larger matrix.  The view is strided, so
+ * the optimizer falls back to one copy-in/copy-out per Optimize() call; the
+ * result must still land in the view and leave the border untouched.
+ */
+TEST_CASE("SGDStridedSubviewOptimizeTest", "[SGDTest]")
+{
+  ShapeAgnosticSphereFunction f(4);
+
+  StandardSGD s(0.01, 4, 100000, 1e-15, false);
+
+  arma::mat big = arma::ones<arma::mat>(4, 4);
+  const double result = s.Optimize(f, big.submat(1, 1, 2, 2));
+
+  REQUIRE(result == Approx(0.0).margin(1e-10));
+  for (size_t r = 0; r < 4; ++r)
+  {
+    for (size_t c = 0; c < 4; ++c)
+    {
+      if (r >= 1 && r <= 2 && c >= 1 && c <= 2)
+        REQUIRE(big(r, c) == Approx(0.0).margin(1e-5));
+      else
+        REQUIRE(big(r, c) == 1.0);
+    }
+  }
+}
+
+/**
+ * Check the schedule math of the decay policies directly: warmup ramps up to
+ * the configured step size, cosine anneals down to the minimum, step decay
+ * drops at the interval, and one-cycle peaks and then anneals below the
+ * starting value.
+ */
+TEST_CASE("SGDDecayScheduleMathTest", "[SGDTest]")
+{
+  arma::mat iterate, gradient;
+
+  LinearWarmup<> warmup(100, 0.1);
+  LinearWarmup<>::Policy<arma::mat, arma::mat> warmupPolicy(warmup);
+  double stepSize = 1.0;
+  warmupPolicy.Update(iterate, stepSize, gradient);
+  REQUIRE(stepSize == Approx(0.109));
+  for (size_t i = 1; i < 100; ++i)
+    warmupPolicy.Update(iterate, stepSize, gradient);
+  REQUIRE(stepSize == Approx(1.0));
+
+  CosineAnnealing cosine(100, 0.1);
+  CosineAnnealing::Policy<arma::mat, arma::mat> cosinePolicy(cosine);
+  stepSize = 1.0;
+  for (size_t i = 0; i < 100; ++i)
+    cosinePolicy.Update(iterate, stepSize, gradient);
+  REQUIRE(stepSize == Approx(0.1));
+
+  StepDecay stepDecay(10, 0.5);
+  StepDecay::Policy<arma::mat, arma::mat> stepPolicy(stepDecay);
+  stepSize = 1.0;
+  for (size_t i = 0; i < 10; ++i)
+    stepPolicy.Update(iterate, stepSize, gradient);
+  REQUIRE(stepSize == Approx(0.5));
+  for (size_t i = 0; i < 10; ++i)
+    stepPolicy.Update(iterate, stepSize, gradient);
+  REQUIRE(stepSize == Approx(0.25));
+
+  OneCycle cycle(100, 10.0, 0.3, 1e-3);
+  OneCycle::Policy<arma::mat, arma::mat> cyclePolicy(cycle);
+  stepSize = 1.0;
+  for (size_t i = 0; i < 30; ++i)
+    cyclePolicy.Update(iterate, stepSize, gradient);
+  REQUIRE(stepSize == Approx(10.0));
+  for (size_t i = 30; i < 100; ++i)
+    cyclePolicy.Update(iterate, stepSize, gradient);
+  REQUIRE(stepSize == Approx(1e-3));
+}
+
+/**
+ * Train logistic regression with SGD under a linear-warmup-plus-cosine
+ * schedule; the composed schedule must not hurt convergence.
+ */
+TEST_CASE("SGDWarmupCosineScheduleTest", "[SGDTest]")
+{
+  VanillaUpdate vanillaUpdate;
+  LinearWarmup<CosineAnnealing> schedule(500, 0.1,
+      CosineAnnealing(100000, 1e-5));
+  SGD<VanillaUpdate, LinearWarmup<CosineAnnealing> > s(0.0005, 32, 100000,
+      1e-9, true, vanillaUpdate, schedule, true, true);
+  LogisticRegressionFunctionTest(s, 0.003, 0.006);
+}
+
+/**
+ * The block shuffle visitation policy must produce a valid permutation of
+ * the batch slots each epoch, including when a partial tail block exists.
+ */
+TEST_CASE("BlockShuffleVisitationPermutationTest", "[SGDTest]")
+{
+  SphereFunction f(4); // Only needed to satisfy the StartEpoch() signature.
+
+  // 37 batches with blocks of 8: four full blocks and a tail of five.
+  BlockShuffleVisitation v(8, true);
+  v.StartEpoch(f, 37);
+
+  arma::uvec visited(37, arma::fill::zeros);
+  for (size_t k = 0; k < 37; ++k)
+  {
+    const size_t slot = v.Batch(k);
+    REQUIRE(slot < 37);
+    visited[slot]++;
+  }
+  for (size_t i = 0; i < 37; ++i)
+    REQUIRE(visited[i] == 1);
+
+  // The partial tail must be visited last, in place.
+  for (size_t k = 32; k < 37; ++k)
+    REQUIRE(v.Batch(k) == k);
+}
+
+/**
+ * SGD with the block shuffle visitation policy should converge without ever
+ * calling Shuffle() on the function.
+ */
+TEST_CASE("SGDBlockShuffleVisitationTest", "[SGDTest]")
+{
+  SphereFunction f(4);
+
+  SGD<VanillaUpdate, NoDecay, BlockShuffleVisitation> s(0.01, 2, 50000, 1e-9);
+  s.VisitationPolicy().BlockBatches() = 4;
+
+  arma::mat coordinates = f.GetInitialPoint();
+  const double result = s.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(1e-4));
+  for (size_t j = 0; j < 4; ++j)
+    REQUIRE(coordinates(j) == Approx(0.0).margin(1e-3));
+}
+
+/**
+ * The compensated accumulator must recover additions that a naive float sum
+ * loses entirely to rounding.
+ */
+TEST_CASE("KahanAccumulatorTest", "[SGDTest]")
+{
+  // Each 1e-4f term is far below the rounding granularity of 1e4f, so a
+  // naive float sum would never move; the compensated sum collects them.
+  KahanAccumulator<float> acc;
+  acc.Add(1e4f);
+  for (size_t i = 0; i < 10000; ++i)
+    acc.Add(1e-4f);
+  REQUIRE(acc.Sum() == Approx(10001.0f).epsilon(1e-6));
+
+  acc.Reset();
+  REQUIRE(acc.Sum() == 0.0f);
+}
+
+/**
+ * Train logistic regression with SGD wrapped in the progressive subset
+ * scheduler: early stages see only a growing prefix of the data, and the
+ * final stage runs on the full dataset, so convergence must not suffer.
+ */
+TEST_CASE("ProgressiveSubsetSGDLogisticRegressionTest", "[SGDTest]")
+{
+  StandardSGD inner(0.0005, 32, 100000, 1e-9, true);
+  ProgressiveSubset<StandardSGD> s(inner, 0.1, 2.0);
+  LogisticRegressionFunctionTest(s, 0.003, 0.006);
+}
+
+/**
+ * The progressive subset view must report the truncated function count and
+ * forward evaluations to the underlying function unchanged.
+ */
+TEST_CASE("ProgressiveSubsetFunctionViewTest", "[SGDTest]")
+{
+  SphereFunction f(2);
+  ProgressiveSubsetFunction<SphereFunction> view(f, 1);
+
+  REQUIRE(view.NumFunctions() == 1);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  REQUIRE(view.Evaluate(coordinates, 0, 1) ==
+      Approx(f.Evaluate(coordinates, 0, 1)));
+}
+
+/**
+ * Optimize the sphere function with an L1 proximal step appended to the
+ * vanilla update.  The minimum is at zero, so the soft threshold must
+ * produce exact zeros, not just small values.
+ */
+TEST_CASE("ProximalSGDSparseIterateTest", "[SGDTest]")
+{
+  SphereFunction f(4);
+  VanillaUpdate vanillaUpdate;
+  ProximalUpdate<VanillaUpdate, L1Proximal> update(vanillaUpdate,
+      L1Proximal(0.01));
+  SGD<ProximalUpdate<VanillaUpdate, L1Proximal>> s(0.01, 2, 50000, 1e-9,
+      true, update);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  s.Optimize(f, coordinates);
+
+  for (size_t i = 0; i < coordinates.n_elem; ++i)
+    REQUIRE(coordinates[i] == 0.0);
+}
+
+/**
+ * Rows act as groups for the group shrinkage operator: a row with norm below
+ * the threshold is zeroed entirely, and larger rows shrink toward zero
+ * without changing direction.
+ */
+TEST_CASE("GroupL1ProximalShrinkageTest", "[SGDTest]")
+{
+  arma::mat x("0.003 0.004; 3.0 4.0");
+  GroupL1Proximal prox(1.0);
+  prox.Apply(x, 0.01); // The threshold is lambda * stepSize = 0.01.
+
+  // The first row has norm 0.005 <= 0.01 and is zeroed; the second row has
+  // norm 5 and shrinks by the threshold.
+  REQUIRE(x(0, 0) == 0.0);
+  REQUIRE(x(0, 1) == 0.0);
+  REQUIRE(x(1, 0) == Approx(3.0 * (5.0 - 0.01) / 5.0));
+  REQUIRE(x(1, 1) == Approx(4.0 * (5.0 - 0.01) / 5.0));
+}
+
+/**
+ * Tail averaging must not hurt convergence: SGD with the last half of the
+ * iterations averaged should still solve the logistic regression problem to
+ * the usual accuracy.
+ */
+TEST_CASE("TailAveragedSGDLogisticRegressionTest", "[SGDTest]")
+{
+  StandardSGD s(0.0005, 32, 100000, 1e-9, true);
+  s.TailFraction() = 0.5;
+  LogisticRegressionFunctionTest(s, 0.003, 0.006);
+}
+
+/**
+ * The lazily-scaled tail average must match the straightforwardly computed
+ * average of the iterates.  We run SGD twice from the same starting point
+ * with shuffling disabled (so both runs see the same deterministic batch
+ * sequence), once recording every iterate through a callback and averaging
+ * the recorded tail by hand, and once with TailFraction() set.
+ */
+TEST_CASE("TailAveragingMatchesExplicitAverageTest", "[SGDTest]")
+{
+  // Records the iterate after every step.
+  class IterateRecorder
+  {
+   public:
+    template<typename OptimizerType, typename FunctionType, typename MatType>
+    bool StepTaken(OptimizerType& /* optimizer */,
+                   FunctionType& /* function */,
+                   const MatType& coordinates)
+    {
+      iterates.push_back(arma::mat(coordinates));
+      return false;
+    }
+
+    std::vector<arma::mat> iterates;
+  };
+
+  SphereFunction f(3);
+  const size_t maxIterations = 40;
+
+  // First run: record all iterates and average the tail by hand.  With a
+  // batch size of 1 every step covers one iteration, so step k corresponds
+  // to iteration counter k and averaging starts at iteration 20.
+  StandardSGD s1(0.01, 1, maxIterations, 0.0, false);
+  arma::mat reference = f.GetInitialPoint();
+  IterateRecorder recorder;
+  s1.Optimize(f, reference, recorder);
+
+  arma::mat explicitAverage(reference.n_rows, reference.n_cols,
+      arma::fill::zeros);
+  const size_t averagingStart = maxIterations / 2;
+  for (size_t k = averagingStart; k < recorder.iterates.size(); ++k)
+    explicitAverage += recorder.iterates[k];
+  explicitAverage /= (double) (recorder.iterates.size() - averagingStart);
+
+  // Second run: the lazily-scaled implementation.
+  StandardSGD s2(0.01, 1, maxIterations, 0.0, false);
+  s2.TailFraction() = 0.5;
+  arma::mat lazyAverage = f.GetInitialPoint();
+  s2.Optimize(f, lazyAverage);
+
+  REQUIRE(arma::norm(lazyAverage - explicitAverage, "inf") ==
+      Approx(0.0).margin(1e-12));
+}
+
+/**
+ * The compile-time streaming specialization of the Optimize() loop (selected
+ * when the batch size is 1) must take exactly the same steps as the general
+ * machinery.  We compare one unshuffled single-sample epoch of Optimize()
+ * against the same schedule driven externally through Step(), which shares
+ * none of the loop's bookkeeping.
+ */
+TEST_CASE("StreamingSGDMatchesManualStepsTest", "[SGDTest]")
+{
+  SphereFunction f(3);
+
+  // One epoch, in linear order, one sample per step.
+  StandardSGD s1(0.01, 1, f.NumFunctions(), 0.0, false);
+  arma::mat streamed = f.GetInitialPoint();
+  s1.Optimize(f, streamed);
+
+  // The same schedule, one Step() call per sample.
+  StandardSGD s2(0.01, 1, f.NumFunctions(), 0.0, false);
+  arma::mat manual = f.GetInitialPoint();
+  s2.Initialize(f, manual);
+  for (size_t i = 0; i < f.NumFunctions(); ++i)
+    s2.Step(f, manual, i, 1);
+
+  REQUIRE(arma::norm(streamed - manual, "inf") ==
+      Approx(0.0).margin(1e-12));
+}
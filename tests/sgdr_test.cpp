@@ -99,3 +99,36 @@ TEST_CASE("SGDRLogisticRegressionSpMatTest","[SGDRTest]")
 }
 
 #endif
+
+/**
+ * The precomputed step-size schedule must reproduce the closed-form decay
+ * exactly: drive one CyclicalDecay with a table and a twin without one
+ * through the same number of updates and compare every step size.
+ */
+TEST_CASE("SGDRPrecomputedScheduleTest","[SGDRTest]")
+{
+  const double stepSize = 0.5;
+  const size_t iterations = 1000;
+  arma::mat iterate;
+
+  CyclicalDecay tabled(50, 2.0, stepSize);
+  CyclicalDecay onTheFly(50, 2.0, stepSize);
+  tabled.EpochBatches() = (double) 1000 / 10;
+  onTheFly.EpochBatches() = (double) 1000 / 10;
+
+  tabled.PrecomputeSchedule(iterations);
+  REQUIRE(!tabled.Schedule().empty());
+
+  CyclicalDecay::Policy<arma::mat, arma::mat> pTabled(tabled);
+  CyclicalDecay::Policy<arma::mat, arma::mat> pOnTheFly(onTheFly);
+
+  for (size_t i = 0; i < iterations; ++i)
+  {
+    double tabledStepSize = stepSize;
+    double onTheFlyStepSize = stepSize;
+    pTabled.Update(iterate, tabledStepSize, iterate);
+    pOnTheFly.Update(iterate, onTheFlyStepSize, iterate);
+
+    REQUIRE(tabledStepSize == Approx(onTheFlyStepSize).margin(1e-15));
+  }
+}
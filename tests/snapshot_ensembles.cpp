@@ -85,6 +85,22 @@ TEST_CASE("SnapshotEnsemblesLogisticRegressionFMatTest","[SnapshotEnsemblesTest]
   }
 }
 
+/**
+ * Run SGDR with averaged snapshots (only a running mean of the snapshots is
+ * kept) on logistic regression and make sure the results are acceptable.
+ */
+TEST_CASE("SnapshotEnsemblesAveragedLogisticRegressionTest",
+          "[SnapshotEnsemblesTest]")
+{
+  // Run SGDR with averaged snapshot ensembles on a couple of batch sizes.
+  for (size_t batchSize = 5; batchSize < 50; batchSize += 5)
+  {
+    SnapshotSGDR<> sgdr(50, 2.0, batchSize, 0.01, 10000, 1e-3, true, 5, true,
+        MomentumUpdate(), true, false, true);
+    LogisticRegressionFunctionTest(sgdr, 0.003, 0.006);
+  }
+}
+
 #if ARMA_VERSION_MAJOR > 9 ||\
     (ARMA_VERSION_MAJOR == 9 && ARMA_VERSION_MINOR >= 400)
 
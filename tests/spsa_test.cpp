@@ -65,3 +65,12 @@ TEST_CASE("SPSALogisticRegressionTest", "[SPSATest]")
   SPSA optimizer(0.5, 0.102, 0.002, 0.3, 5000, 1e-8);
   LogisticRegressionFunctionTest(optimizer, 0.003, 0.006, 10);
 }
+
+/**
+ * Test the averaged mode of the SPSA optimizer on the Sphere function.
+ */
+TEST_CASE("SPSAAveragedSphereFunctionTest", "[SPSATest]")
+{
+  SPSA optimizer(0.1, 0.102, 0.16, 0.3, 100000, 0, 4);
+  FunctionTest<SphereFunction>(optimizer, 1.0, 0.1);
+}
@@ -105,3 +105,14 @@ TEST_CASE("SVRGBBLogisticRegressionSpMatTest", "[SVRGTest]")
 }
 
 #endif
+
+/**
+ * Run SVRG with the parallel full-gradient snapshot on logistic regression
+ * and make sure the results are acceptable.
+ */
+TEST_CASE("SVRGParallelFullGradientLogisticRegressionTest", "[SVRGTest]")
+{
+  SVRG optimizer(0.005, 35, 300, 0, 1e-5, true);
+  optimizer.ParallelFullGradient() = true;
+  LogisticRegressionFunctionTest(optimizer, 0.015, 0.015);
+}